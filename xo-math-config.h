@@ -38,6 +38,9 @@
 //      * A 16 byte aligned allocator can be provided to xo-math by advanced end users.
 //  XO_16ALIGNED_FREE(ptr)
 //      * A free method can be provided to xo-math by advanced end users.
+//  XO_HEADER_ONLY
+//      * Includes the sources in xo-math.h, so nothing else needs to be compiled or linked. Every function becomes inline, 
+//      * which lets the compiler inline the methods that otherwise live in xo-math.cpp into the loops calling them.
 //  XO_EXPORT_ALL
 //      * Not for typical end users. This prevents the undefining of internal macros such as _XOINL or XO_INTERNAL for example.
 
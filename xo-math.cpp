@@ -25,27 +25,1631 @@
 XOMATH_BEGIN_XO_NS();
 
 
+////////////////////////////////////////////////////////////////////////// Dispatch.cpp
+
+namespace xo_internal
+{
+#if defined(XO_DISPATCH)
+    _XOSRCINL void CPUID(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#   if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subleaf);
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = (unsigned)r[i];
+        }
+#   else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#   endif
+    }
+
+    // The register state the operating system saves on a context switch.
+    _XOSRCINL unsigned long long XGETBV() {
+#   if defined(_MSC_VER)
+        return _xgetbv(0);
+#   else
+        unsigned eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((unsigned long long)edx << 32) | eax;
+#   endif
+    }
+#endif
+
+#if defined(XO_SSE2)
+    // The kernels for the highest tier, no higher than tier, that this build has kernels for.
+    // The tables are function statics so that a header only build shares one of each between translation units.
+    _XOSRCINL const DispatchKernels* KernelsForTier(SIMDTier tier) {
+        static const DispatchKernels SSE2Kernels = {
+            SIMDTier::SSE2,
+            TransformVector3Array,
+            TransformVector4Array,
+            MultiplyBatch,
+            MultiplyIndexedBatch,
+            InverseBatch,
+            SinCosArray,
+            DotVector3Array,
+            NormalizeVector3Array,
+            RotateVector3Batch,
+            BlendQuaternionBatch,
+            SkinVertices,
+            SkinVerticesDualQuaternion,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3Array
+        };
+        const DispatchKernels* kernels = &SSE2Kernels;
+        (void)tier;
+#   if defined(_XO_KERNELS_AVX)
+        static const DispatchKernels AVXKernels = {
+            SIMDTier::AVX,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArray,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX) {
+            kernels = &AVXKernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX2)
+        static const DispatchKernels AVX2Kernels = {
+            SIMDTier::AVX2,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArrayAVX2,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX2) {
+            kernels = &AVX2Kernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX512)
+        static const DispatchKernels AVX512Kernels = {
+            SIMDTier::AVX512,
+            TransformVector3ArrayAVX512,
+            TransformVector4ArrayAVX512,
+            MultiplyBatchAVX512,
+            MultiplyIndexedBatchAVX512,
+            InverseBatchAVX512,
+            SinCosArrayAVX512,
+            DotVector3ArrayAVX512,
+            NormalizeVector3ArrayAVX512,
+            RotateVector3BatchAVX512,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX512) {
+            kernels = &AVX512Kernels;
+        }
+#   endif
+        return kernels;
+    }
+
+    _XOSRCINL std::atomic<const DispatchKernels*>& SelectedKernels() {
+        static std::atomic<const DispatchKernels*> selected(nullptr);
+        return selected;
+    }
+#endif
+}
+
+_XOSRCINL SIMDTier DetectSIMDTier() {
+#if defined(XO_DISPATCH)
+    unsigned regs[4];
+    xo_internal::CPUID(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return SIMDTier::None;
+    }
+    xo_internal::CPUID(1, 0, regs);
+    if (!(regs[3] & (1u << 26))) {
+        return SIMDTier::None;
+    }
+    // AVX needs the CPU to support it, and the OS to save the ymm registers (xgetbv bits 1 and 2).
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    if (!osxsave || !(regs[2] & (1u << 28)) || (xo_internal::XGETBV() & 0x6) != 0x6) {
+        return SIMDTier::SSE2;
+    }
+    // The AVX2 tier's kernels also use F16C, which every AVX2 CPU has.
+    const bool f16c = (regs[2] & (1u << 29)) != 0;
+    if (maxLeaf < 7) {
+        return SIMDTier::AVX;
+    }
+    xo_internal::CPUID(7, 0, regs);
+    if (!(regs[1] & (1u << 5)) || !f16c) {
+        return SIMDTier::AVX;
+    }
+    // AVX-512 F, DQ, BW and VL, with the OS also saving the opmask and zmm registers (xgetbv bits 5 to 7).
+    const unsigned avx512Bits = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+    if ((regs[1] & avx512Bits) != avx512Bits || (xo_internal::XGETBV() & 0xe6) != 0xe6) {
+        return SIMDTier::AVX2;
+    }
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX512)
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX2)
+    return SIMDTier::AVX2;
+#elif defined(XO_AVX)
+    return SIMDTier::AVX;
+#elif defined(XO_SSE2)
+    return SIMDTier::SSE2;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL void InitDispatch(SIMDTier maxTier) {
+#if defined(XO_SSE2)
+    const SIMDTier cpuTier = DetectSIMDTier();
+    xo_internal::SelectedKernels().store(xo_internal::KernelsForTier(cpuTier < maxTier ? cpuTier : maxTier));
+#else
+    (void)maxTier;
+#endif
+}
+
+_XOSRCINL SIMDTier GetDispatchTier() {
+#if defined(XO_SSE2)
+    return xo_internal::GetDispatchKernels().tier;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL const char* GetSIMDTierName(SIMDTier tier) {
+    switch (tier) {
+        case SIMDTier::None:    return "none";
+        case SIMDTier::SSE2:    return "sse2";
+        case SIMDTier::AVX:     return "avx";
+        case SIMDTier::AVX2:    return "avx2";
+        case SIMDTier::AVX512:  return "avx512";
+    }
+    return "unknown";
+}
+
+#if defined(XO_SSE2)
+_XOSRCINL const xo_internal::DispatchKernels& xo_internal::GetDispatchKernels() {
+    const DispatchKernels* kernels = SelectedKernels().load(std::memory_order_relaxed);
+    if (!kernels) {
+        InitDispatch();
+        kernels = SelectedKernels().load();
+    }
+    return *kernels;
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////// DualQuaternion.cpp
+
+_XOSRCDATA const DualQuaternion DualQuaternion::Identity(Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL DualQuaternion::DualQuaternion() {
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    real(real),
+    dual(dual)
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector3& translation) :
+    real(rotation)
+{
+    // q_d = t q_r / 2, with t as a quaternion with no w.
+    Quaternion d = Quaternion(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.0f) * rotation;
+    dual = d;
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix3x4& m) :
+    DualQuaternion(Quaternion(m), m.GetTranslation())
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix4x4& m) :
+    DualQuaternion(Matrix3x4(m))
+{
+}
+
+#if defined(XO_SSE)
+namespace xo_internal
+{
+    // The four component dot product of a and b, in every lane.
+    _XOINL __m128 DualQuaternionDot(__m128 a, __m128 b) {
+        __m128 p = _mm_mul_ps(a, b);
+        p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+}
+#endif
+
+_XOSRCINL DualQuaternion& DualQuaternion::Normalize() {
+#if defined(XO_SSE)
+    __m128 r = real.xmm, d = dual.xmm;
+    __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(xo_internal::DualQuaternionDot(r, r)));
+    r = _mm_mul_ps(r, inverseLength);
+    d = _mm_mul_ps(d, inverseLength);
+    // q_d's component along q_r only adds to the w of the translation 2 q_d q_r^*, so it can go.
+    real.xmm = r;
+    dual.xmm = _mm_sub_ps(d, _mm_mul_ps(r, xo_internal::DualQuaternionDot(r, d)));
+#else
+    Vector4 r(real), d(dual);
+    float inverseLength = 1.0f / Sqrt(r.MagnitudeSquared());
+    r *= inverseLength;
+    d *= inverseLength;
+    d -= r * Vector4::Dot(r, d);
+    real = Quaternion(r.x, r.y, r.z, r.w);
+    dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Normalized() const {
+    return DualQuaternion(*this).Normalize();
+}
+
+_XOSRCINL DualQuaternion& DualQuaternion::MakeInverse() {
+    real.MakeConjugate();
+    dual.MakeConjugate();
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Inverse() const {
+    return DualQuaternion(*this).MakeInverse();
+}
+
+_XOSRCINL void DualQuaternion::Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outDualQuaternion) {
+#if defined(XO_SSE)
+    // t for b takes the sign of the dot product of the rotations, without a branch.
+    __m128 ta = _mm_set1_ps(1.0f - t);
+    __m128 tb = _mm_xor_ps(_mm_set1_ps(t), _mm_and_ps(xo_internal::DualQuaternionDot(a.real.xmm, b.real.xmm), _mm_set1_ps(-0.0f)));
+    outDualQuaternion.real.xmm = _mm_add_ps(_mm_mul_ps(a.real.xmm, ta), _mm_mul_ps(b.real.xmm, tb));
+    outDualQuaternion.dual.xmm = _mm_add_ps(_mm_mul_ps(a.dual.xmm, ta), _mm_mul_ps(b.dual.xmm, tb));
+#else
+    Vector4 ar(a.real), ad(a.dual), br(b.real), bd(b.dual);
+    float tb = Vector4::Dot(ar, br) < 0.0f ? -t : t;
+    Vector4 r = ar * (1.0f - t) + br * tb;
+    Vector4 d = ad * (1.0f - t) + bd * tb;
+    outDualQuaternion.real = Quaternion(r.x, r.y, r.z, r.w);
+    outDualQuaternion.dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    outDualQuaternion.Normalize();
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four dual quaternions, one per lane, with each register holding one component of all four.
+    struct DualQuaternionLanes {
+        __m128 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Bone k of each of four vertices, one vertex per lane.
+    _XOINL void LoadBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanes& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        o.rx = b0.real.xmm; o.ry = b1.real.xmm; o.rz = b2.real.xmm; o.rw = b3.real.xmm;
+        o.dx = b0.dual.xmm; o.dy = b1.dual.xmm; o.dz = b2.dual.xmm; o.dw = b3.dual.xmm;
+        _MM_TRANSPOSE4_PS(o.rx, o.ry, o.rz, o.rw);
+        _MM_TRANSPOSE4_PS(o.dx, o.dy, o.dz, o.dw);
+    }
+
+    // Adds bone k of four vertices to sum, weighted. The weight is negated where the bone's rotation is in the
+    // other hemisphere from the first bone's, so every bone is blended the shorter way around.
+    _XOINL void AddBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m128 weight, const DualQuaternionLanes& first, DualQuaternionLanes& sum) {
+        DualQuaternionLanes b;
+        LoadBoneLanes(palette, influences, k, b);
+        __m128 cosine = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.rx, first.rx), _mm_mul_ps(b.ry, first.ry)), _mm_add_ps(_mm_mul_ps(b.rz, first.rz), _mm_mul_ps(b.rw, first.rw)));
+        weight = _mm_xor_ps(weight, _mm_and_ps(cosine, _mm_set1_ps(-0.0f)));
+        sum.rx = _mm_add_ps(sum.rx, _mm_mul_ps(b.rx, weight));
+        sum.ry = _mm_add_ps(sum.ry, _mm_mul_ps(b.ry, weight));
+        sum.rz = _mm_add_ps(sum.rz, _mm_mul_ps(b.rz, weight));
+        sum.rw = _mm_add_ps(sum.rw, _mm_mul_ps(b.rw, weight));
+        sum.dx = _mm_add_ps(sum.dx, _mm_mul_ps(b.dx, weight));
+        sum.dy = _mm_add_ps(sum.dy, _mm_mul_ps(b.dy, weight));
+        sum.dz = _mm_add_ps(sum.dz, _mm_mul_ps(b.dz, weight));
+        sum.dw = _mm_add_ps(sum.dw, _mm_mul_ps(b.dw, weight));
+    }
+
+    // sse::QuaternionRotate of x, y and z by the unit quaternion q, one per lane.
+    _XOINL void RotateLanes(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& x, __m128& y, __m128& z) {
+        __m128 tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+        __m128 ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+        __m128 tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+        x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+    }
+
+    // Dual quaternion linear blending of four vertices, one per lane. Each vertex's bones are summed by weight,
+    // then the position is transformed by the sum as DualQuaternion::Normalized then TransformPoint would, with the
+    // normalization folded into the rotation and translation rather than applied to the sum.
+    _XOINL void SkinDualQuaternionFour(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m128 w0 = _mm_loadu_ps(influences[0].weights);
+        __m128 w1 = _mm_loadu_ps(influences[1].weights);
+        __m128 w2 = _mm_loadu_ps(influences[2].weights);
+        __m128 w3 = _mm_loadu_ps(influences[3].weights);
+        _MM_TRANSPOSE4_PS(w0, w1, w2, w3);
+
+        DualQuaternionLanes first, sum;
+        LoadBoneLanes(palette, influences, 0, first);
+        sum.rx = _mm_mul_ps(first.rx, w0);
+        sum.ry = _mm_mul_ps(first.ry, w0);
+        sum.rz = _mm_mul_ps(first.rz, w0);
+        sum.rw = _mm_mul_ps(first.rw, w0);
+        sum.dx = _mm_mul_ps(first.dx, w0);
+        sum.dy = _mm_mul_ps(first.dy, w0);
+        sum.dz = _mm_mul_ps(first.dz, w0);
+        sum.dw = _mm_mul_ps(first.dw, w0);
+        AddBoneLanes(palette, influences, 1, w1, first, sum);
+        AddBoneLanes(palette, influences, 2, w2, first, sum);
+        AddBoneLanes(palette, influences, 3, w3, first, sum);
+
+        // 1 / |q_r|, from an approximate reciprocal square root and one Newton-Raphson step.
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sum.rx, sum.rx), _mm_mul_ps(sum.ry, sum.ry)), _mm_add_ps(_mm_mul_ps(sum.rz, sum.rz), _mm_mul_ps(sum.rw, sum.rw)));
+        __m128 inverseLength = _mm_rsqrt_ps(lengthSquared);
+        inverseLength = _mm_mul_ps(inverseLength, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared), _mm_mul_ps(inverseLength, inverseLength))));
+        __m128 qx = _mm_mul_ps(sum.rx, inverseLength);
+        __m128 qy = _mm_mul_ps(sum.ry, inverseLength);
+        __m128 qz = _mm_mul_ps(sum.rz, inverseLength);
+        __m128 qw = _mm_mul_ps(sum.rw, inverseLength);
+        // DualQuaternion::GetTranslation of the sum, divided by |q_r|^2 for the normalization.
+        __m128 scale = _mm_mul_ps(_mm_set1_ps(2.0f), _mm_mul_ps(inverseLength, inverseLength));
+        __m128 tx = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dx), _mm_mul_ps(sum.dw, sum.rx)), _mm_sub_ps(_mm_mul_ps(sum.ry, sum.dz), _mm_mul_ps(sum.rz, sum.dy))));
+        __m128 ty = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dy), _mm_mul_ps(sum.dw, sum.ry)), _mm_sub_ps(_mm_mul_ps(sum.rz, sum.dx), _mm_mul_ps(sum.rx, sum.dz))));
+        __m128 tz = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dz), _mm_mul_ps(sum.dw, sum.rz)), _mm_sub_ps(_mm_mul_ps(sum.rx, sum.dy), _mm_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m128 x = normals[0].xmm, y = normals[1].xmm, z = normals[2].xmm, w = normals[3].xmm;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            RotateLanes(qx, qy, qz, qw, x, y, z);
+            w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            outNormals[0].xmm = x;
+            outNormals[1].xmm = y;
+            outNormals[2].xmm = z;
+            outNormals[3].xmm = w;
+        }
+        __m128 x = positions[0].xmm, y = positions[1].xmm, z = positions[2].xmm, w = positions[3].xmm;
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        RotateLanes(qx, qy, qz, qw, x, y, z);
+        x = _mm_add_ps(x, tx);
+        y = _mm_add_ps(y, ty);
+        z = _mm_add_ps(z, tz);
+        w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        outPositions[0].xmm = x;
+        outPositions[1].xmm = y;
+        outPositions[2].xmm = z;
+        outPositions[3].xmm = w;
+    }
+#endif
+
+    _XOSRCINL void SkinVerticesDualQuaternion(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            SkinDualQuaternionFour(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        if (i < n) {
+            // The rest are padded out to four with the first bone at full weight.
+            Skinning::Influences tailInfluences[4];
+            Vector3 tailPositions[4], tailNormals[4];
+            for (size_t j = 0; j < 4; ++j) {
+                if (i + j < n) {
+                    tailInfluences[j] = influences[i + j];
+                    tailPositions[j] = positions[i + j];
+                    tailNormals[j] = normals ? normals[i + j] : Vector3::Zero;
+                }
+                else {
+                    tailInfluences[j] = influences[i];
+                    tailPositions[j] = Vector3::Zero;
+                    tailNormals[j] = Vector3::Zero;
+                }
+            }
+            SkinDualQuaternionFour(palette, tailInfluences, tailPositions, normals ? tailNormals : nullptr, tailPositions, tailNormals);
+            for (size_t j = 0; i + j < n; ++j) {
+                outPositions[i + j] = tailPositions[j];
+                if (normals) {
+                    outNormals[i + j] = tailNormals[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 first(palette[influence.bones[0]].real);
+            Vector4 r(0.0f), d(0.0f);
+            for (int k = 0; k < 4; ++k) {
+                const DualQuaternion& bone = palette[influence.bones[k]];
+                Vector4 br(bone.real);
+                float weight = Vector4::Dot(br, first) < 0.0f ? -influence.weights[k] : influence.weights[k];
+                r += br * weight;
+                d += Vector4(bone.dual) * weight;
+            }
+            DualQuaternion blended(Quaternion(r.x, r.y, r.z, r.w), Quaternion(d.x, d.y, d.z, d.w));
+            blended.Normalize();
+            if (normals) {
+                outNormals[i] = blended.TransformDirection(normals[i]);
+            }
+            outPositions[i] = blended.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // DualQuaternionLanes for eight vertices, with vertices j and j + 4 in lane j of the low and high halves.
+    struct DualQuaternionLanesAVX {
+        __m256 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Two 128 bit values, in the low and high halves.
+    _XOINL _XO_TARGET_AVX __m256 LanePair(__m128 low, __m128 high) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void LoadBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanesAVX& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        const DualQuaternion& b4 = palette[influences[4].bones[k]];
+        const DualQuaternion& b5 = palette[influences[5].bones[k]];
+        const DualQuaternion& b6 = palette[influences[6].bones[k]];
+        const DualQuaternion& b7 = palette[influences[7].bones[k]];
+        __m256 r[4] = { LanePair(b0.real.xmm, b4.real.xmm), LanePair(b1.real.xmm, b5.real.xmm), LanePair(b2.real.xmm, b6.real.xmm), LanePair(b3.real.xmm, b7.real.xmm) };
+        __m256 d[4] = { LanePair(b0.dual.xmm, b4.dual.xmm), LanePair(b1.dual.xmm, b5.dual.xmm), LanePair(b2.dual.xmm, b6.dual.xmm), LanePair(b3.dual.xmm, b7.dual.xmm) };
+        TransposeLanes4x4(r);
+        TransposeLanes4x4(d);
+        o.rx = r[0]; o.ry = r[1]; o.rz = r[2]; o.rw = r[3];
+        o.dx = d[0]; o.dy = d[1]; o.dz = d[2]; o.dw = d[3];
+    }
+
+    // AddBoneLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void AddBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m256 weight,
+                                               const DualQuaternionLanesAVX& first, DualQuaternionLanesAVX& sum) {
+        DualQuaternionLanesAVX b;
+        LoadBoneLanesAVX(palette, influences, k, b);
+        __m256 cosine = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b.rx, first.rx), _mm256_mul_ps(b.ry, first.ry)),
+                                      _mm256_add_ps(_mm256_mul_ps(b.rz, first.rz), _mm256_mul_ps(b.rw, first.rw)));
+        weight = _mm256_xor_ps(weight, _mm256_and_ps(cosine, _mm256_set1_ps(-0.0f)));
+        sum.rx = _mm256_add_ps(sum.rx, _mm256_mul_ps(b.rx, weight));
+        sum.ry = _mm256_add_ps(sum.ry, _mm256_mul_ps(b.ry, weight));
+        sum.rz = _mm256_add_ps(sum.rz, _mm256_mul_ps(b.rz, weight));
+        sum.rw = _mm256_add_ps(sum.rw, _mm256_mul_ps(b.rw, weight));
+        sum.dx = _mm256_add_ps(sum.dx, _mm256_mul_ps(b.dx, weight));
+        sum.dy = _mm256_add_ps(sum.dy, _mm256_mul_ps(b.dy, weight));
+        sum.dz = _mm256_add_ps(sum.dz, _mm256_mul_ps(b.dz, weight));
+        sum.dw = _mm256_add_ps(sum.dw, _mm256_mul_ps(b.dw, weight));
+    }
+
+    // RotateLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void RotateLanesAVX(__m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256& x, __m256& y, __m256& z) {
+        __m256 tx = _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y));
+        __m256 ty = _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z));
+        __m256 tz = _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x));
+        tx = _mm256_add_ps(tx, tx);
+        ty = _mm256_add_ps(ty, ty);
+        tz = _mm256_add_ps(tz, tz);
+        x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(qw, tx)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+        y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(qw, ty)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+        z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(qw, tz)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+    }
+
+    // SkinDualQuaternionFour for eight vertices. The vertex arrays are read and written 128 bits at a time, four
+    // apart, to match the lanes.
+    _XOINL _XO_TARGET_AVX void SkinDualQuaternionEight(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m256 w[4] = {
+            LanePair(_mm_loadu_ps(influences[0].weights), _mm_loadu_ps(influences[4].weights)),
+            LanePair(_mm_loadu_ps(influences[1].weights), _mm_loadu_ps(influences[5].weights)),
+            LanePair(_mm_loadu_ps(influences[2].weights), _mm_loadu_ps(influences[6].weights)),
+            LanePair(_mm_loadu_ps(influences[3].weights), _mm_loadu_ps(influences[7].weights))
+        };
+        TransposeLanes4x4(w);
+
+        DualQuaternionLanesAVX first, sum;
+        LoadBoneLanesAVX(palette, influences, 0, first);
+        sum.rx = _mm256_mul_ps(first.rx, w[0]);
+        sum.ry = _mm256_mul_ps(first.ry, w[0]);
+        sum.rz = _mm256_mul_ps(first.rz, w[0]);
+        sum.rw = _mm256_mul_ps(first.rw, w[0]);
+        sum.dx = _mm256_mul_ps(first.dx, w[0]);
+        sum.dy = _mm256_mul_ps(first.dy, w[0]);
+        sum.dz = _mm256_mul_ps(first.dz, w[0]);
+        sum.dw = _mm256_mul_ps(first.dw, w[0]);
+        AddBoneLanesAVX(palette, influences, 1, w[1], first, sum);
+        AddBoneLanesAVX(palette, influences, 2, w[2], first, sum);
+        AddBoneLanesAVX(palette, influences, 3, w[3], first, sum);
+
+        __m256 lengthSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sum.rx, sum.rx), _mm256_mul_ps(sum.ry, sum.ry)),
+                                             _mm256_add_ps(_mm256_mul_ps(sum.rz, sum.rz), _mm256_mul_ps(sum.rw, sum.rw)));
+        __m256 inverseLength = _mm256_rsqrt_ps(lengthSquared);
+        inverseLength = _mm256_mul_ps(inverseLength, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                      _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), lengthSquared), _mm256_mul_ps(inverseLength, inverseLength))));
+        __m256 qx = _mm256_mul_ps(sum.rx, inverseLength);
+        __m256 qy = _mm256_mul_ps(sum.ry, inverseLength);
+        __m256 qz = _mm256_mul_ps(sum.rz, inverseLength);
+        __m256 qw = _mm256_mul_ps(sum.rw, inverseLength);
+        __m256 scale = _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(inverseLength, inverseLength));
+        __m256 tx = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dx), _mm256_mul_ps(sum.dw, sum.rx)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.ry, sum.dz), _mm256_mul_ps(sum.rz, sum.dy))));
+        __m256 ty = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dy), _mm256_mul_ps(sum.dw, sum.ry)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rz, sum.dx), _mm256_mul_ps(sum.rx, sum.dz))));
+        __m256 tz = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dz), _mm256_mul_ps(sum.dw, sum.rz)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rx, sum.dy), _mm256_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m256 v[4] = {
+                LanePair(normals[0].xmm, normals[4].xmm), LanePair(normals[1].xmm, normals[5].xmm),
+                LanePair(normals[2].xmm, normals[6].xmm), LanePair(normals[3].xmm, normals[7].xmm)
+            };
+            TransposeLanes4x4(v);
+            RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+            v[3] = _mm256_setzero_ps();
+            TransposeLanes4x4(v);
+            outNormals[0].xmm = _mm256_castps256_ps128(v[0]);
+            outNormals[1].xmm = _mm256_castps256_ps128(v[1]);
+            outNormals[2].xmm = _mm256_castps256_ps128(v[2]);
+            outNormals[3].xmm = _mm256_castps256_ps128(v[3]);
+            outNormals[4].xmm = _mm256_extractf128_ps(v[0], 1);
+            outNormals[5].xmm = _mm256_extractf128_ps(v[1], 1);
+            outNormals[6].xmm = _mm256_extractf128_ps(v[2], 1);
+            outNormals[7].xmm = _mm256_extractf128_ps(v[3], 1);
+        }
+        __m256 v[4] = {
+            LanePair(positions[0].xmm, positions[4].xmm), LanePair(positions[1].xmm, positions[5].xmm),
+            LanePair(positions[2].xmm, positions[6].xmm), LanePair(positions[3].xmm, positions[7].xmm)
+        };
+        TransposeLanes4x4(v);
+        RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+        v[0] = _mm256_add_ps(v[0], tx);
+        v[1] = _mm256_add_ps(v[1], ty);
+        v[2] = _mm256_add_ps(v[2], tz);
+        v[3] = _mm256_setzero_ps();
+        TransposeLanes4x4(v);
+        outPositions[0].xmm = _mm256_castps256_ps128(v[0]);
+        outPositions[1].xmm = _mm256_castps256_ps128(v[1]);
+        outPositions[2].xmm = _mm256_castps256_ps128(v[2]);
+        outPositions[3].xmm = _mm256_castps256_ps128(v[3]);
+        outPositions[4].xmm = _mm256_extractf128_ps(v[0], 1);
+        outPositions[5].xmm = _mm256_extractf128_ps(v[1], 1);
+        outPositions[6].xmm = _mm256_extractf128_ps(v[2], 1);
+        outPositions[7].xmm = _mm256_extractf128_ps(v[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesDualQuaternionAVX(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            SkinDualQuaternionEight(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        _mm256_zeroupper();
+        if (i < n) {
+            SkinVerticesDualQuaternion(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr, n - i);
+        }
+    }
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////// FrameArena.cpp
+
+namespace xo_internal
+{
+    // Blocks start on a cache line, and so does the memory after each block's header.
+    _XOCONSTEXPR const size_t ArenaBlockAlign = 64;
+    _XOCONSTEXPR const size_t ArenaHeaderSize = 64;
+    _XOCONSTEXPR const size_t ArenaHugePageSize = 2 * 1024 * 1024;
+
+    // Returns at least size bytes for an arena block, and sets size to how many. When hugePages is true the block
+    // is asked to be backed by huge pages, and hugePages is set to whether that was done. pageAligned is set to
+    // whether the block must be freed with free rather than AlignedFree.
+    _XOSRCINL void* AllocateArenaBlock(size_t& size, bool& hugePages, bool& pageAligned) {
+        pageAligned = false;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages) {
+            // transparent huge pages only back whole, aligned huge pages, so the block is made of them. The
+            // kernel may still use ordinary pages, such as when huge pages are disabled or memory is fragmented.
+            size_t rounded = (size + ArenaHugePageSize - 1) & ~(ArenaHugePageSize - 1);
+            void* p = nullptr;
+            if (posix_memalign(&p, ArenaHugePageSize, rounded) == 0) {
+                hugePages = madvise(p, rounded, MADV_HUGEPAGE) == 0;
+                pageAligned = true;
+                size = rounded;
+                return p;
+            }
+        }
+#endif
+        hugePages = false;
+        return AlignedMalloc(size, ArenaBlockAlign);
+    }
+
+    _XOSRCINL void FreeArenaBlock(void* p, bool pageAligned) {
+        if (pageAligned) {
+            free(p);
+        }
+        else {
+            AlignedFree(p, ArenaBlockAlign);
+        }
+    }
+}
+
+_XOSRCINL FrameArena::FrameArena() :
+    FrameArena(DefaultBlockSize)
+{
+}
+
+_XOSRCINL FrameArena::FrameArena(size_t blockSize, bool hugePages) :
+    current(nullptr),
+    cursor(nullptr),
+    end(nullptr),
+    blockSize(blockSize),
+    used(0),
+    peak(0),
+    capacity(0),
+    blockCount(0),
+    allocationCount(0),
+    wantHugePages(hugePages),
+    hugePages(false)
+{
+}
+
+_XOSRCINL FrameArena::~FrameArena() {
+    FreeBlocks();
+}
+
+_XOSRCINL void* FrameArena::AllocateFromNewBlock(size_t size, size_t align) {
+    // the memory after a header is aligned to ArenaBlockAlign, so only larger alignments need room to pad.
+    size_t padding = align > xo_internal::ArenaBlockAlign ? align : 0;
+    if (size > ~(size_t)0 / 2 || !NewBlock(size + padding)) {
+        return nullptr;
+    }
+    return Allocate(size, align);
+}
+
+_XOSRCINL FrameArena::Block* FrameArena::NewBlock(size_t size) {
+    static_assert(sizeof(Block) <= xo_internal::ArenaHeaderSize, "FrameArena::Block doesn't fit its header.");
+    size_t bytes = xo_internal::ArenaHeaderSize + (size > blockSize ? size : blockSize);
+    bool huge = wantHugePages, pageAligned;
+    void* memory = xo_internal::AllocateArenaBlock(bytes, huge, pageAligned);
+    if (!memory) {
+        return nullptr;
+    }
+    Block* block = (Block*)memory;
+    block->previous = current;
+    block->size = bytes;
+    block->pageAligned = pageAligned;
+    current = block;
+    cursor = (char*)memory + xo_internal::ArenaHeaderSize;
+    end = (char*)memory + bytes;
+    capacity += bytes - xo_internal::ArenaHeaderSize;
+    ++blockCount;
+    hugePages = huge;
+    return block;
+}
+
+_XOSRCINL void FrameArena::FreeBlocks() {
+    while (current) {
+        Block* previous = current->previous;
+        xo_internal::FreeArenaBlock(current, current->pageAligned);
+        current = previous;
+    }
+    cursor = end = nullptr;
+    capacity = 0;
+    blockCount = 0;
+    hugePages = false;
+}
+
+_XOSRCINL void FrameArena::Reset() {
+    if (blockCount > 1) {
+        // one block big enough for the whole frame, so the next frame like it doesn't chain.
+        size_t total = capacity;
+        FreeBlocks();
+        NewBlock(total);
+    }
+    else if (current) {
+        cursor = (char*)current + xo_internal::ArenaHeaderSize;
+    }
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL void FrameArena::Release() {
+    FreeBlocks();
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats;
+    stats.used = used;
+    stats.peak = peak;
+    stats.capacity = capacity;
+    stats.blockCount = blockCount;
+    stats.allocationCount = allocationCount;
+    stats.hugePages = hugePages;
+    return stats;
+}
+
+_XOSRCINL FrameArena& FrameArena::ThreadArena() {
+#if defined(_XO_NO_TLS)
+    // thread local objects need a trivial constructor here, so this arena is never destroyed, and its blocks
+    // aren't freed when the thread exits. See the ThreadArena documentation.
+    static _XOTLS FrameArena* tlsArena;
+    static _XOTLS void* mem[(sizeof(FrameArena) + sizeof(void*) - 1) / sizeof(void*)];
+    if (!tlsArena) {
+        tlsArena = new(mem) FrameArena();
+    }
+    return *tlsArena;
+#else
+    static _XOTLS FrameArena tlsArena;
+    return tlsArena;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////// Half.cpp
+
+namespace xo_internal
+{
+    union FloatBits {
+        float f;
+        uint32_t u;
+    };
+}
+
+_XOSRCINL uint16_t FloatToHalf(float f) {
+    xo_internal::FloatBits bits;
+    bits.f = f;
+    const uint32_t sign = bits.u & 0x80000000u;
+    bits.u ^= sign;
+    uint16_t o;
+    if (bits.u >= 0x47800000u) {
+        // 65520 and up rounds to infinity. NaN stays NaN, as a quiet NaN.
+        o = bits.u > 0x7f800000u ? 0x7e00 : 0x7c00;
+    }
+    else if (bits.u < 0x38800000u) {
+        // Below the smallest normal half, so a denormal or zero. Adding 0.5 moves the half's mantissa to the bottom
+        // bits of the float's, and the float add does the rounding.
+        bits.f += 0.5f;
+        o = (uint16_t)(bits.u - 0x3f000000u);
+    }
+    else {
+        // Rebias the exponent from 127 to 15, then round off the low 13 bits of the mantissa with ties to even. A
+        // carry out of the mantissa correctly bumps the exponent, up to infinity.
+        const uint32_t mantissaOdd = (bits.u >> 13) & 1u;
+        bits.u += 0xc8000fffu + mantissaOdd;
+        o = (uint16_t)(bits.u >> 13);
+    }
+    return (uint16_t)(o | (sign >> 16));
+}
+
+_XOSRCINL float HalfToFloat(uint16_t h) {
+    xo_internal::FloatBits o;
+    o.u = (uint32_t)(h & 0x7fff) << 13;
+    const uint32_t exponent = o.u & 0x0f800000u;
+    o.u += 0x38000000u;
+    if (exponent == 0x0f800000u) {
+        // Infinity or NaN, which take the largest exponent.
+        o.u += 0x38000000u;
+    }
+    else if (exponent == 0) {
+        // A denormal. Given the smallest normal exponent it's 2^-14 too big, which a float subtract takes off. Both
+        // operands and the result are normal floats, so the SSE denormal modes don't change it.
+        o.u += 0x00800000u;
+        o.f -= HexFloat(0x38800000u);
+    }
+    o.u |= (uint32_t)(h & 0x8000) << 16;
+    return o.f;
+}
+
+_XOSRCINL Half2::Half2(const Vector2& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y))
+{
+}
+
+_XOSRCINL Half2::operator Vector2() const {
+    return Vector2(HalfToFloat(x), HalfToFloat(y));
+}
+
+_XOSRCINL Half3::Half3(const Vector3& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z))
+{
+}
+
+_XOSRCINL Half3::operator Vector3() const {
+    return Vector3(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z));
+}
+
+_XOSRCINL Half4::Half4(const Vector4& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z)),
+    w(FloatToHalf(v.w))
+{
+}
+
+_XOSRCINL Half4::operator Vector4() const {
+    return Vector4(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z), HalfToFloat(w));
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE2)
+    // FloatToHalf of four floats. Each lane holds its half sign extended to 32 bits, so _mm_packs_epi32 narrows
+    // two of these to eight halves without saturating.
+    _XOINL __m128i FloatToHalfSSE2(__m128 f) {
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+        __m128 sign = _mm_and_ps(f, signMask);
+        __m128 absolute = _mm_xor_ps(f, sign);
+        __m128i bits = _mm_castps_si128(absolute);
+        // Without the sign, the bits compare as signed ints in the same order as the floats.
+        __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+        __m128i isDenormal = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+        __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+        __m128i infOrNaN = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+        __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+        // -1 where bit 13 is set, which is subtracted to add it.
+        __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+        __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32((int)0xc8000fffu)), mantissaOdd), 13);
+        __m128i finite = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+        __m128i o = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN));
+        return _mm_or_si128(o, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+
+    // HalfToFloat of four halves, one zero extended in each 32 bit lane.
+    _XOINL __m128 HalfToFloatSSE2(__m128i h) {
+        __m128i magnitude = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, magnitude), 16);
+        __m128i o = _mm_slli_epi32(magnitude, 13);
+        __m128i exponent = _mm_and_si128(o, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_set1_epi32(0x38000000));
+        __m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_and_si128(isInfOrNaN, _mm_set1_epi32(0x38000000)));
+        __m128i isDenormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+        __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(0x00800000))), _mm_set1_ps(HexFloat(0x38800000u))));
+        o = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, o));
+        return _mm_castsi128_ps(_mm_or_si128(o, sign));
+    }
+#endif
+
+    // The baseline kernels behind ToHalf and FromHalf. Element i's components are in[i * inStride] onward, so
+    // a stride of 4 with 2 or 3 components is a padded Vector2 or Vector3. When the stride is the component count
+    // the arrays are one run of floats. Anything that isn't a whole vector's worth goes through FloatToHalf or
+    // HalfToFloat, which give the same bits as the vector code.
+    _XOSRCINL void FloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i a = FloatToHalfSSE2(_mm_loadu_ps(in + i));
+                __m128i b = FloatToHalfSSE2(_mm_loadu_ps(in + i + 4));
+                _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // Each element's four halves are stored 8 bytes at a time, and the fourth is overwritten by the next
+            // element. The last two elements are left to the loop below so nothing is written past the end.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_packs_epi32(FloatToHalfSSE2(_mm_loadu_ps(in + i * 4)), FloatToHalfSSE2(_mm_loadu_ps(in + i * 4 + 4)));
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm_packs_epi32(FloatToHalfSSE2(ab), FloatToHalfSSE2(cd)));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalf(in[i * inStride + k]);
+            }
+        }
+    }
+
+    // The w of a padded Vector3 is written as zero.
+    _XOSRCINL void HalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i));
+                _mm_storeu_ps(out + i, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+                _mm_storeu_ps(out + i + 4, HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero)));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // Each load takes the next element's first half as well, which is masked off to give a w of zero.
+            // The last element is left to the loop below so nothing is read past the end.
+            const __m128i xyzMask = _mm_set_epi32(0, 0, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 1 < n; ++i) {
+                __m128i h = _mm_and_si128(_mm_loadl_epi64((const __m128i*)(in + i * 3)), xyzMask);
+                _mm_storeu_ps(out + i * 4, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i * 2));
+                __m128 ab = HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero));
+                __m128 cd = HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero));
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloat(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX2)
+namespace xo_internal
+{
+    // F16C's own conversions of one value, for the elements that don't fill a register. They round the same way
+    // as the wide ones, which is the same as FloatToHalf.
+    _XOINL _XO_TARGET_AVX2 uint16_t FloatToHalfF16C(float f) {
+        return (uint16_t)_mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(f), _MM_FROUND_TO_NEAREST_INT), 0);
+    }
+
+    _XOINL _XO_TARGET_AVX2 float HalfToFloatF16C(uint16_t h) {
+        return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(h)));
+    }
+
+    // FloatToHalfArray with F16C, eight floats per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void FloatToHalfArrayF16C(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+                _mm_storeu_si128((__m128i*)(out + i + 8), _mm256_cvtps_ph(_mm256_loadu_ps(in + i + 8), _MM_FROUND_TO_NEAREST_INT));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // As FloatToHalfArray, with both elements in one conversion.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i * 4), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                __m256 f = _mm256_insertf128_ps(_mm256_castps128_ps256(ab), cd, 1);
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalfF16C(in[i * inStride + k]);
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    // HalfToFloatArray with F16C, eight halves per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void HalfToFloatArrayF16C(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+                _mm256_storeu_ps(out + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i + 8))));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // As HalfToFloatArray, two elements per conversion. The second load reads into a third element, which
+            // must exist.
+            const __m128i xyzMask = _mm_set_epi32(0x0000ffff, (int)0xffffffffu, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(in + i * 3)), _mm_loadl_epi64((const __m128i*)(in + i * 3 + 3)));
+                _mm256_storeu_ps(out + i * 4, _mm256_cvtph_ps(_mm_and_si128(h, xyzMask)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m256 f = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i * 2)));
+                __m128 ab = _mm256_castps256_ps128(f);
+                __m128 cd = _mm256_extractf128_ps(f, 1);
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloatF16C(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+namespace xo_internal
+{
+    _XOSRCINL void DispatchFloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().floatToHalfArray(in, inStride, out, components, n);
+#else
+        FloatToHalfArray(in, inStride, out, components, n);
+#endif
+    }
+
+    _XOSRCINL void DispatchHalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().halfToFloatArray(in, components, out, outStride, n);
+#else
+        HalfToFloatArray(in, components, out, outStride, n);
+#endif
+    }
+}
+
+_XOSRCINL void ToHalf(const float* in, uint16_t* out, size_t n)      { xo_internal::DispatchFloatToHalfArray(in, 1, out, 1, n); }
+_XOSRCINL void ToHalf(const Vector2* in, Half2* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector2) / sizeof(float), (uint16_t*)out, 2, n); }
+_XOSRCINL void ToHalf(const Vector3* in, Half3* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector3) / sizeof(float), (uint16_t*)out, 3, n); }
+_XOSRCINL void ToHalf(const Vector4* in, Half4* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector4) / sizeof(float), (uint16_t*)out, 4, n); }
+_XOSRCINL void FromHalf(const uint16_t* in, float* out, size_t n)    { xo_internal::DispatchHalfToFloatArray(in, 1, out, 1, n); }
+_XOSRCINL void FromHalf(const Half2* in, Vector2* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 2, (float*)out, sizeof(Vector2) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half3* in, Vector3* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 3, (float*)out, sizeof(Vector3) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half4* in, Vector4* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 4, (float*)out, sizeof(Vector4) / sizeof(float), n); }
+
+
+////////////////////////////////////////////////////////////////////////// Hierarchy.cpp
+
+namespace xo_internal
+{
+    // Holds each of count threads in Wait until all of them have called it. Levels are short enough that
+    // spinning is cheaper than sleeping on a condition variable.
+    class SpinBarrier {
+    public:
+        explicit SpinBarrier(unsigned count) : count(count), waiting(0), generation(0) {
+        }
+
+        void Wait() {
+            unsigned gen = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                waiting.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            else {
+                while (generation.load(std::memory_order_acquire) == gen) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        const unsigned count;
+        std::atomic<unsigned> waiting;
+        std::atomic<unsigned> generation;
+    };
+
+    // Fewer nodes than this in a level aren't split between threads.
+    _XOSRCINL size_t HierarchyMinNodesPerThread() {
+        return 256;
+    }
+}
+
+_XOSRCINL Hierarchy::Hierarchy() :
+    firstChangedLevel(NothingChanged),
+    sorted(true)
+{
+}
+
+_XOSRCINL void Hierarchy::Reserve(size_t nodeCount) {
+    parents.reserve(nodeCount);
+    depths.reserve(nodeCount);
+    slots.reserve(nodeCount);
+    parentSlots.reserve(nodeCount);
+    locals.reserve(nodeCount);
+    worlds.reserve(nodeCount);
+    changed.reserve(nodeCount);
+}
+
+_XOSRCINL void Hierarchy::Clear() {
+    parents.clear();
+    depths.clear();
+    slots.clear();
+    parentSlots.clear();
+    locals.clear();
+    worlds.clear();
+    changed.clear();
+    levels.clear();
+    firstChangedLevel = NothingChanged;
+    sorted = true;
+}
+
+_XOSRCINL int Hierarchy::AddNode(int parent, const Matrix4x4& local) {
+    XO_ASSERT(parent == NoParent || (parent >= 0 && (size_t)parent < parents.size()), "The parent must be added before its children.");
+    int node = (int)parents.size();
+    int depth = parent == NoParent ? 0 : depths[parent] + 1;
+    parents.push_back(parent);
+    depths.push_back(depth);
+    // Stored at the end until the next update sorts it into its level.
+    slots.push_back((int)locals.size());
+    parentSlots.push_back(NoParent);
+    locals.push_back(local);
+    worlds.push_back(local);
+    changed.push_back(1);
+    if ((size_t)depth < firstChangedLevel) {
+        firstChangedLevel = (size_t)depth;
+    }
+    sorted = false;
+    return node;
+}
+
+_XOSRCINL void Hierarchy::Sort() {
+    const size_t n = parents.size();
+
+    // The children of each node, in the order they were added.
+    std::vector<int> childStart(n + 1, 0);
+    std::vector<int> children(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] != NoParent) {
+            ++childStart[parents[i] + 1];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    {
+        std::vector<int> cursor(childStart.begin(), childStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (parents[i] != NoParent) {
+                children[cursor[parents[i]]++] = (int)i;
+            }
+        }
+    }
+
+    // Breadth first from the roots, which puts each level after the one above it, with siblings together and
+    // in the order of their parents.
+    std::vector<int> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] == NoParent) {
+            order.push_back((int)i);
+        }
+    }
+    levels.clear();
+    levels.push_back(0);
+    size_t levelEnd = order.size();
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == levelEnd) {
+            levels.push_back(i);
+            levelEnd = order.size();
+        }
+        int node = order[i];
+        for (int c = childStart[node]; c < childStart[node + 1]; ++c) {
+            order.push_back(children[c]);
+        }
+    }
+    if (n) {
+        levels.push_back(n);
+    }
+
+    std::vector<int> newParentSlots(n);
+    vector<Matrix4x4> newLocals(n);
+    vector<Matrix4x4> newWorlds(n);
+    std::vector<unsigned char> newChanged(n);
+    firstChangedLevel = NothingChanged;
+    for (size_t slot = 0; slot < n; ++slot) {
+        int node = order[slot];
+        int oldSlot = slots[node];
+        newLocals[slot] = locals[oldSlot];
+        newWorlds[slot] = worlds[oldSlot];
+        newChanged[slot] = changed[oldSlot];
+        // The parent comes earlier in the order, so its slot is already set.
+        newParentSlots[slot] = parents[node] == NoParent ? NoParent : slots[parents[node]];
+        slots[node] = (int)slot;
+        if (newChanged[slot] && (size_t)depths[node] < firstChangedLevel) {
+            firstChangedLevel = (size_t)depths[node];
+        }
+    }
+    parentSlots.swap(newParentSlots);
+    locals.swap(newLocals);
+    worlds.swap(newWorlds);
+    changed.swap(newChanged);
+    sorted = true;
+}
+
+_XOSRCINL void Hierarchy::BeginUpdate() {
+    if (!sorted) {
+        Sort();
+    }
+}
+
+_XOSRCINL void Hierarchy::GetLevelRange(size_t level, size_t& begin, size_t& end) const {
+    end = levels[level + 1];
+    begin = level < firstChangedLevel ? end : levels[level];
+}
+
+_XOSRCINL void Hierarchy::UpdateRange(size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (parentSlots[begin] == NoParent) {
+        // The first level, which is only roots.
+        for (size_t i = begin; i < end; ++i) {
+            if (changed[i]) {
+                worlds[i] = locals[i];
+            }
+        }
+        return;
+    }
+    // A node has changed when it or its parent has, and its parent's flag was settled by the level above.
+    // Each run of changed nodes is one batch.
+    size_t i = begin;
+    while (i < end) {
+        while (i < end && !(changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        size_t run = i;
+        while (i < end && (changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        if (i > run) {
+            Matrix4x4::MultiplyBatch(worlds.data(), parentSlots.data() + run, locals.data() + run, worlds.data() + run, i - run);
+        }
+    }
+}
+
+_XOSRCINL void Hierarchy::EndUpdate() {
+    if (firstChangedLevel < GetLevelCount()) {
+        std::fill(changed.begin() + levels[firstChangedLevel], changed.end(), (unsigned char)0);
+    }
+    firstChangedLevel = NothingChanged;
+}
+
+_XOSRCINL void Hierarchy::UpdateWorld(unsigned threadCount) {
+    BeginUpdate();
+    const size_t levelCount = GetLevelCount();
+    if (firstChangedLevel >= levelCount) {
+        return;
+    }
+
+    // No more threads than there are cores, or than there's work for.
+    const size_t minNodes = xo_internal::HierarchyMinNodesPerThread();
+    const size_t work = levels[levelCount] - levels[firstChangedLevel];
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (cores && threadCount > cores) {
+        threadCount = cores;
+    }
+    if (threadCount > work / minNodes) {
+        threadCount = (unsigned)(work / minNodes);
+    }
+
+    if (threadCount <= 1) {
+        for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+            size_t begin, end;
+            GetLevelRange(level, begin, end);
+            UpdateRange(begin, end);
+        }
+    }
+    else {
+        xo_internal::SpinBarrier barrier(threadCount);
+        auto run = [this, &barrier, threadCount, levelCount, minNodes](unsigned thread) {
+            for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+                size_t begin, end;
+                GetLevelRange(level, begin, end);
+                size_t count = end - begin;
+                if (count < minNodes * 2) {
+                    if (thread == 0) {
+                        UpdateRange(begin, end);
+                    }
+                }
+                else {
+                    size_t chunk = (count + threadCount - 1) / threadCount;
+                    size_t first = begin + std::min(count, chunk * thread);
+                    size_t last = begin + std::min(count, chunk * (thread + 1));
+                    UpdateRange(first, last);
+                }
+                barrier.Wait();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run, t);
+        }
+        run(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    EndUpdate();
+}
+
+
+////////////////////////////////////////////////////////////////////////// Matrix3x4.cpp
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL Matrix3x4::Matrix3x4() {
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float m) {
+    r[0].Set(m);
+    r[1].Set(m);
+    r[2].Set(m);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2) {
+    r[0].Set(a0, b0, c0, d0);
+    r[1].Set(a1, b1, c1, d1);
+    r[2].Set(a2, b2, c2, d2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2) {
+    r[0].Set(r0);
+    r[1].Set(r1);
+    r[2].Set(r2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix4x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q) {
+    // Points are transformed as column vectors, so this is the transpose of the upper left 3x3 of
+    // Matrix4x4(const Quaternion&), which is laid out for row vectors.
+    Vector4 v4(q.x, q.y, q.z, q.w);
+    Vector4 q2 = v4 + v4;
+
+    Vector4 qq2 = v4 * q2;
+    Vector4 wq2 = q2 * q.w;
+
+    float xy2 = q.x * q2.y;
+    float xz2 = q.x * q2.z;
+    float yz2 = q.y * q2.z;
+
+    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 - wq2.z,            xz2 + wq2.y,          0.0f);
+    r[1].Set( xy2 + wq2.z,           1.0f - qq2.x - qq2.z,   yz2 - wq2.x,          0.0f);
+    r[2].Set( xz2 - wq2.y,           yz2 + wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q, const Vector3& translation) :
+    Matrix3x4(q)
+{
+    SetTranslation(translation);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+    // The batch kernels take the full matrix, which costs one 64 byte copy per array.
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL float Matrix3x4::Determinant() const {
+    return Vector3::Dot(Vector3(r[0]), Vector3::Cross(Vector3(r[1]), Vector3(r[2])));
+}
+
+namespace xo_internal
+{
+    // Writes the adjugate of the upper left 3x3 of m, with the translation of the inverse scaled by the same
+    // determinant, to out, and returns the determinant. The adjugate's columns are the cross products of the rows.
+    _XOINL float AffineAdjugate(const Matrix3x4& m, Matrix3x4& out) {
+#if defined(XO_SSE)
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        // the w of each cross product is w*w - w*w, so the translations drop out as zeros.
+        auto cross = [](__m128 a, __m128 b) {
+            return _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+        };
+        __m128 c0 = cross(r1, r2);
+        __m128 c1 = cross(r2, r0);
+        __m128 c2 = cross(r0, r1);
+        // -(adj * t) is the combination of the columns weighted by the translation.
+        __m128 t = sse::LinearCombination(_mm_shuffle_ps(_mm_unpackhi_ps(r0, r1), r2, _MM_SHUFFLE(3, 3, 3, 2)), c0, c1, c2, _mm_setzero_ps());
+        __m128 c3 = _mm_sub_ps(_mm_setzero_ps(), t);
+        float det = Vector4(_mm_mul_ps(r0, c0)).Sum();
+        // the columns become the rows of the inverse, with the translation in w.
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        out.r[0].xmm = c0;
+        out.r[1].xmm = c1;
+        out.r[2].xmm = c2;
+        return det;
+#else
+        Vector3 c0, c1, c2;
+        Vector3::Cross(Vector3(m.r[1]), Vector3(m.r[2]), c0);
+        Vector3::Cross(Vector3(m.r[2]), Vector3(m.r[0]), c1);
+        Vector3::Cross(Vector3(m.r[0]), Vector3(m.r[1]), c2);
+        Vector3 c3 = -(c0 * m.m03 + c1 * m.m13 + c2 * m.m23);
+        // out may be m, so the determinant is taken before any rows are written.
+        float det = Vector3::Dot(Vector3(m.r[0]), c0);
+        out.r[0].Set(c0.x, c1.x, c2.x, c3.x);
+        out.r[1].Set(c0.y, c1.y, c2.y, c3.y);
+        out.r[2].Set(c0.z, c1.z, c2.z, c3.z);
+        return det;
+#endif
+    }
+
+    _XOINL void ScaleAffineAdjugate(Matrix3x4& m, float det) {
+        float s = 1.0f / det;
+        m.r[0] *= s;
+        m.r[1] *= s;
+        m.r[2] *= s;
+    }
+}
+
+_XOSRCINL void Matrix3x4::MakeInverse() {
+    float det = xo_internal::AffineAdjugate(*this, *this);
+    xo_internal::ScaleAffineAdjugate(*this, det);
+}
+
+_XOSRCINL bool Matrix3x4::TryMakeInverse() {
+    Matrix3x4 adj;
+    float det = xo_internal::AffineAdjugate(*this, adj);
+    if (det == 0.0f) {
+        return false;
+    }
+    xo_internal::ScaleAffineAdjugate(adj, det);
+    *this = adj;
+    return true;
+}
+
+_XOSRCINL void Matrix3x4::Scale(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(v.x, 0.0f, 0.0f, 0.0f);
+    outMatrix.r[1].Set(0.0f, v.y, 0.0f, 0.0f);
+    outMatrix.r[2].Set(0.0f, 0.0f, v.z, 0.0f);
+}
+
+_XOSRCINL void Matrix3x4::Translation(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(1.0f, 0.0f, 0.0f, v.x);
+    outMatrix.r[1].Set(0.0f, 1.0f, 0.0f, v.y);
+    outMatrix.r[2].Set(0.0f, 0.0f, 1.0f, v.z);
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Scale(const Vector3& v) {
+    Matrix3x4 m;
+    Scale(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Translation(const Vector3& v) {
+    Matrix3x4 m;
+    Translation(v, m);
+    return m;
+}
+
+
 ////////////////////////////////////////////////////////////////////////// Matrix4x4.cpp
 
-const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+#define _XO_ASSERT_MSG(msg) "xo-math Matrix4x4" msg
+
+_XOSRCDATA const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
                                     Vector4(0.0f, 1.0f, 0.0f, 0.0f),
                                     Vector4(0.0f, 0.0f, 1.0f, 0.0f),
                                     Vector4(0.0f, 0.0f, 0.0f, 1.0f));
 
-const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+_XOSRCDATA const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f));
 
-const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+_XOSRCDATA const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f));
 
-Matrix4x4::Matrix4x4() {
+_XOSRCINL Matrix4x4::Matrix4x4() {
 }
 
-Matrix4x4::Matrix4x4(float m)
+_XOSRCINL Matrix4x4::Matrix4x4(float m)
 #if defined(XO_SSE)
 { 
     r[0].xmm = r[1].xmm = r[2].xmm = r[3].xmm = _mm_set_ps1(m);
@@ -59,7 +1663,7 @@ Matrix4x4::Matrix4x4(float m)
 }
 #endif
 
-Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
+_XOSRCINL Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
 {
     r[0].Set(a0, b0, c0, d0);
     r[1].Set(a1, b1, c1, d1);
@@ -68,7 +1672,7 @@ Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1,
 }
 
 // TODO: couldn't this be faster with just a single copy?
-Matrix4x4::Matrix4x4(const Matrix4x4& m)
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix4x4& m)
 {
 	r[0].Set(m.r[0]);
 	r[1].Set(m.r[1]);
@@ -76,7 +1680,7 @@ Matrix4x4::Matrix4x4(const Matrix4x4& m)
 	r[3].Set(m.r[3]);
 }
 
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
 {
 	r[0].Set(r0);
 	r[1].Set(r1);
@@ -84,7 +1688,7 @@ Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, co
 	r[3].Set(r3);
 }
 
-Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
 {
 	r[0].Set(r0);
 	r[1].Set(r1);
@@ -92,11 +1696,20 @@ Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
 	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-Matrix4x4::Matrix4x4(const class Quaternion& q) {
-    Vector4* v4 = (Vector4*)&q;
-    Vector4 q2 = *v4 + *v4;
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix3x4& m)
+{
+	r[0].Set(m.r[0]);
+	r[1].Set(m.r[1]);
+	r[2].Set(m.r[2]);
+	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const class Quaternion& q) {
+    // A copy rather than a cast pointer, which the compiler may assume can't alias q.
+    Vector4 v4(q);
+    Vector4 q2 = v4 + v4;
 
-    Vector4 qq2 = (*v4) * q2;
+    Vector4 qq2 = v4 * q2;
     Vector4 wq2 = q2 * q.w;
 
     float xy2 = q.x * q2.y;
@@ -109,15 +1722,15 @@ Matrix4x4::Matrix4x4(const class Quaternion& q) {
     r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-const Vector4& Matrix4x4::GetRow(int i) const {
+_XOSRCINL const Vector4& Matrix4x4::GetRow(int i) const {
     return r[i];
 }
 
-Vector4 Matrix4x4::GetColumn(int i) const {
+_XOSRCINL Vector4 Matrix4x4::GetColumn(int i) const {
     return Vector4(r[0][i], r[1][i], r[2][i], r[3][i]);
 }
 
-namespace
+namespace xo_internal
 {
 #if defined(XO_SSE)
     _XOINL void EarlyInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
@@ -215,6 +1828,77 @@ namespace
         _mm_storel_pi((__m64*)(m + 12), minor3);
         _mm_storeh_pi((__m64*)(m + 14), minor3);
     }
+
+#   if defined(XO_AVX)
+    _XOINL __m256 RowPair(__m128 lo, __m128 hi) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    // The cofactor expansion of EarlyInverse, regrouped for AVX.
+    // EarlyInverse forms six products of row pairs, and builds each minor from two terms per product. Expanding 
+    // those terms, every pair of terms reduces to a row times d = swap(t) - t, where t is the product with 
+    // neighbouring elements swapped and swap exchanges the two halves of the register. With dN from the Nth 
+    // product, and rNs being rN with its halves swapped:
+    //      minor0 =  r1*d1  - r3*d2  - r2s*d3
+    //      minor1 = -r0s*d1 + r2s*d5 - r3*d6
+    //      minor2 =  r0s*d3 + r3*d4  - r1*d5
+    //      minor3 =  r0s*d2 - r2s*d4 + r1*d6
+    // Two products or minors share each 256 bit register, for 9 multiplies where EarlyInverse has 30 of half the width.
+    // Rows 0 and 1 of the inverse (before the division by the determinant) are written to minors01, and rows 2 
+    // and 3 to minors23. Returns the determinant in every element.
+    _XOINL __m128 InverseMinorsAVX(const float m[16], __m256& minors01, __m256& minors23) {
+        // Loads the transpose as EarlyInverse does, which leaves row1 and row3 with their halves swapped.
+        __m128 tmp1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m)), (const __m64*)(m + 4));
+        __m128 row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 8)), (const __m64*)(m + 12));
+        __m128 row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(m + 2)), (const __m64*)(m + 6));
+        __m128 row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 10)), (const __m64*)(m + 14));
+        __m128 row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+        __m128 row0s = _mm_shuffle_ps(row0, row0, 0x4E);
+        __m128 row1s = _mm_shuffle_ps(row1, row1, 0x4E);
+        __m128 row2s = _mm_shuffle_ps(row2, row2, 0x4E);
+
+        // products 1 and 4, 2 and 5, 3 and 6.
+        __m256 d14 = _mm256_mul_ps(RowPair(row2, row0), RowPair(row3, row1));
+        __m256 d25 = _mm256_mul_ps(RowPair(row1, row0), RowPair(row2, row3));
+        __m256 d36 = _mm256_mul_ps(RowPair(row1s, row0), RowPair(row3, row2s));
+        d14 = _mm256_shuffle_ps(d14, d14, 0xB1);
+        d25 = _mm256_shuffle_ps(d25, d25, 0xB1);
+        d36 = _mm256_shuffle_ps(d36, d36, 0xB1);
+        d14 = _mm256_sub_ps(_mm256_shuffle_ps(d14, d14, 0x4E), d14);
+        d25 = _mm256_sub_ps(_mm256_shuffle_ps(d25, d25, 0x4E), d25);
+        d36 = _mm256_sub_ps(_mm256_shuffle_ps(d36, d36, 0x4E), d36);
+
+        const __m256 negateHigh = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+        __m256 r1r0s = RowPair(row1, row0s);
+        __m256 r3r2s = RowPair(row3, row2s);
+        __m256 d11 = _mm256_permute2f128_ps(d14, d14, 0x00);
+        __m256 d44 = _mm256_permute2f128_ps(d14, d14, 0x11);
+        __m256 d52 = _mm256_permute2f128_ps(d25, d25, 0x01);
+        minors01 = _mm256_sub_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r1r0s, d11), _mm256_mul_ps(r3r2s, d25))),
+            _mm256_mul_ps(RowPair(row2s, row3), d36));
+        minors23 = _mm256_add_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r3r2s, d44), _mm256_mul_ps(r1r0s, d52))),
+            _mm256_mul_ps(RowPair(row0s, row1), d36));
+
+        __m128 det = _mm_mul_ps(row0, _mm256_castps256_ps128(minors01));
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        return _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+    }
+
+    // See LateInverse.
+    _XOINL void ScaleInverseAVX(__m128 det, __m256 minors01, __m256 minors23, float m[16]) {
+        __m128 r = _mm_rcp_ps(det);
+        r = _mm_sub_ps(_mm_add_ps(r, r), _mm_mul_ps(det, _mm_mul_ps(r, r)));
+        __m256 scale = RowPair(r, r);
+        _mm256_storeu_ps(m, _mm256_mul_ps(minors01, scale));
+        _mm256_storeu_ps(m + 8, _mm256_mul_ps(minors23, scale));
+    }
+#   endif
 #else
     _XOINL void EarlyInverse(float tmp[12], float src[16], float& det, float m[16])
     {
@@ -302,46 +1986,286 @@ namespace
 #endif
 }
 
-void Matrix4x4::MakeInverse() {
-#if defined(XO_SSE)
+_XOSRCINL void Matrix4x4::MakeInverse() {
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+#elif defined(XO_SSE)
     __m128 minor0, minor1, minor2, minor3;
     __m128 row0, row1, row2, row3;
     __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
 #else
     float tmp[12]; // temp array for pairs
     float src[16]; // array of transpose source matrix
     float det; // determinant
-    EarlyInverse(tmp, src, det, m);
-    LateInverse(det, m);
+    xo_internal::EarlyInverse(tmp, src, det, m);
+    xo_internal::LateInverse(det, m);
 #endif
 }
 
-bool Matrix4x4::TryMakeInverse()
+_XOSRCINL bool Matrix4x4::TryMakeInverse()
 {
-#if defined(XO_SSE)
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    if (_mm_cvtss_f32(det) == 0.0f)
+        return false;
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+    return true;
+#elif defined(XO_SSE)
     __m128 minor0, minor1, minor2, minor3;
     __m128 row0, row1, row2, row3;
     __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
     if (_mm_cvtss_f32(det) == 0.0f)
         return false;
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
     return true;
 #else
     float tmp[12]; // temp array for pairs
     float src[16]; // array of transpose source matrix
     float det; // determinant
-    EarlyInverse(tmp, src, det, m);
+    // EarlyInverse writes the cofactors over its matrix, so a singular matrix is only left as is by working on a copy.
+    Matrix4x4 o(*this);
+    xo_internal::EarlyInverse(tmp, src, det, o.m);
     if (det == 0.0f)
         return false;
-    LateInverse(det, m);
+    xo_internal::LateInverse(det, o.m);
+    *this = o;
+    return true;
+#endif
+}
+
+namespace xo_internal
+{
+    // Relative tolerances for Matrix4x4::ClassifyInverse. Two columns are orthogonal when the square of their dot
+    // is within InverseOrthogonalTolerance of the product of their squared lengths, which is a cosine of about 1e-5.
+    // A column is unit length when its squared length is within InverseUnitTolerance of 1.
+    _XOCONSTEXPR const float InverseOrthogonalTolerance = 1e-10f;
+    _XOCONSTEXPR const float InverseUnitTolerance = 2e-5f;
+
+    // Gets the squared lengths of the first three columns of m in lengths, and the dots c0.c1, c1.c2 and c2.c0 in
+    // dots. The w of both is zero. The columns are down the rows, so the rows are multiplied lane by lane: each
+    // row by itself for the lengths, and by itself rotated one lane for the dots.
+#if defined(XO_SSE)
+    _XOINL void ColumnGram(const Matrix4x4& m, __m128& lengths, __m128& dots) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0 = _mm_and_ps(m.r[0].xmm, xyzMask), r1 = _mm_and_ps(m.r[1].xmm, xyzMask), r2 = _mm_and_ps(m.r[2].xmm, xyzMask);
+        __m128 s0 = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s1 = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s2 = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1));
+        lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2));
+        dots = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, s0), _mm_mul_ps(r1, s1)), _mm_mul_ps(r2, s2));
+    }
+#else
+    _XOINL void ColumnGram(const Matrix4x4& m, Vector4& lengths, Vector4& dots) {
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        lengths.Set(c0.MagnitudeSquared(), c1.MagnitudeSquared(), c2.MagnitudeSquared(), 0.0f);
+        dots.Set(Vector3::Dot(c0, c1), Vector3::Dot(c1, c2), Vector3::Dot(c2, c0), 0.0f);
+    }
+#endif
+
+    // Inverts an affine matrix whose upper left 3x3 has orthogonal columns. Row i of the inverse 3x3 is column i
+    // divided by its squared length, which is 1 when scaled is false, and the translation is that 3x3 applied to
+    // the negated translation. out may be m.
+    _XOINL void InverseOrthogonal(const Matrix4x4& m, Matrix4x4& out, bool scaled) {
+#if defined(XO_SSE)
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        const __m128 wOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        __m128 tx = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 ty = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 tz = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_and_ps(r0, xyzMask);
+        r1 = _mm_and_ps(r1, xyzMask);
+        r2 = _mm_and_ps(r2, xyzMask);
+        if (scaled) {
+            // the squared lengths of all three columns at once. w is made 1 so its reciprocal stays finite.
+            __m128 lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_add_ps(_mm_mul_ps(r2, r2), wOne));
+            __m128 inv = _mm_div_ps(sse::One, lengths);
+            r0 = _mm_mul_ps(r0, inv);
+            r1 = _mm_mul_ps(r1, inv);
+            r2 = _mm_mul_ps(r2, inv);
+        }
+        // once transposed r0 to r2 are the columns of the inverse 3x3, so the translation is their combination.
+        __m128 t = _mm_sub_ps(wOne, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, tx), _mm_mul_ps(r1, ty)), _mm_mul_ps(r2, tz)));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, t);
+        out.r[0].xmm = r0;
+        out.r[1].xmm = r1;
+        out.r[2].xmm = r2;
+        out.r[3].xmm = t;
+#else
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        Vector3 t(m.m03, m.m13, m.m23);
+        if (scaled) {
+            c0 *= 1.0f / c0.MagnitudeSquared();
+            c1 *= 1.0f / c1.MagnitudeSquared();
+            c2 *= 1.0f / c2.MagnitudeSquared();
+        }
+        out.r[0].Set(c0, -Vector3::Dot(c0, t));
+        out.r[1].Set(c1, -Vector3::Dot(c1, t));
+        out.r[2].Set(c2, -Vector3::Dot(c2, t));
+        out.r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+#endif
+    }
+}
+
+_XOSRCINL bool Matrix4x4::HasOrthonormalBasis() const {
+    // CloseEnough is relative, which nothing passes against 0, so these are absolute differences.
+#if defined(XO_SSE)
+    __m128 l, d;
+    xo_internal::ColumnGram(*this, l, d);
+    Vector4 lengths(l), dots(d);
+#else
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+#endif
+    return Abs(dots.x) <= Vector4::Epsilon && Abs(dots.y) <= Vector4::Epsilon && Abs(dots.z) <= Vector4::Epsilon &&
+           Abs(lengths.x - 1.0f) <= Vector4::Epsilon && Abs(lengths.y - 1.0f) <= Vector4::Epsilon && Abs(lengths.z - 1.0f) <= Vector4::Epsilon;
+}
+
+_XOSRCINL bool Matrix4x4::IsUnitary() const {
+    // Element (i, j) of the transpose times this is the dot of columns i and j.
+    for (int i = 0; i < 4; ++i) {
+        Vector4 ci = GetColumn(i);
+        for (int j = i; j < 4; ++j) {
+            if (Abs(Vector4::Dot(ci, GetColumn(j)) - (i == j ? 1.0f : 0.0f)) > Vector4::Epsilon) {
+                return false;
+            }
+        }
+    }
     return true;
+}
+
+_XOSRCINL float Matrix4x4::Determinant() const {
+    // Laplace expansion by the 2x2 minors of the top two rows and their complements in the bottom two.
+    float s0 = m00 * m11 - m10 * m01;
+    float s1 = m00 * m12 - m10 * m02;
+    float s2 = m00 * m13 - m10 * m03;
+    float s3 = m01 * m12 - m11 * m02;
+    float s4 = m01 * m13 - m11 * m03;
+    float s5 = m02 * m13 - m12 * m03;
+    float c5 = m22 * m33 - m32 * m23;
+    float c4 = m21 * m33 - m31 * m23;
+    float c3 = m21 * m32 - m31 * m22;
+    float c2 = m20 * m33 - m30 * m23;
+    float c1 = m20 * m32 - m30 * m22;
+    float c0 = m20 * m31 - m30 * m21;
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAffine() const {
+#if defined(XO_SSE)
+    // As Matrix3x4::MakeInverse, the columns of the adjugate are the cross products of the rows. The determinant
+    // goes in the w of the translation column, so once transposed and divided by the determinant, the bottom row
+    // comes out as (0, 0, 0, 1).
+    __m128 r0 = r[0].xmm, r1 = r[1].xmm, r2 = r[2].xmm;
+    auto cross = [](__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+    };
+    __m128 c0 = cross(r1, r2);
+    __m128 c1 = cross(r2, r0);
+    __m128 c2 = cross(r0, r1);
+    // the w of each cross product is zero, so the w of r0 drops out of the determinant.
+    __m128 det = _mm_mul_ps(r0, c0);
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128 t = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3))),
+        _mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)))),
+        _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+    __m128 c3 = _mm_sub_ps(_mm_and_ps(det, _mm_set_ps(HexFloat(0xffffffff), 0.0f, 0.0f, 0.0f)), t);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 inv = _mm_div_ps(sse::One, det);
+    Matrix4x4 o;
+    o.r[0].xmm = _mm_mul_ps(c0, inv);
+    o.r[1].xmm = _mm_mul_ps(c1, inv);
+    o.r[2].xmm = _mm_mul_ps(c2, inv);
+    o.r[3].xmm = _mm_mul_ps(c3, inv);
+    return o;
+#else
+    Matrix3x4 affine(*this);
+    affine.MakeInverse();
+    return Matrix4x4(affine);
+#endif
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseRigid() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, false);
+    return o;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseScaleRotateTranslate() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, true);
+    return o;
+}
+
+_XOSRCINL Matrix4x4::InverseMethod Matrix4x4::ClassifyInverse() const {
+#if defined(XO_SSE)
+    if (_mm_movemask_ps(_mm_cmpeq_ps(r[3].xmm, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f))) != 0xf) {
+        return InverseMethod::General;
+    }
+    __m128 l, dots;
+    xo_internal::ColumnGram(*this, l, dots);
+    // the product of each length with the next lane's matches the pair in the same lane of dots.
+    __m128 limit = _mm_mul_ps(_mm_mul_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1))), _mm_set1_ps(xo_internal::InverseOrthogonalTolerance));
+    // w is zero in both, so it always passes.
+    if (_mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dots, dots), limit)) != 0xf) {
+        return InverseMethod::Affine;
+    }
+    __m128 unitError = _mm_and_ps(sse::AbsMask, _mm_sub_ps(l, sse::One));
+    if ((_mm_movemask_ps(_mm_cmple_ps(unitError, _mm_set1_ps(xo_internal::InverseUnitTolerance))) & 0x7) != 0x7) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
+#else
+    if (m30 != 0.0f || m31 != 0.0f || m32 != 0.0f || m33 != 1.0f) {
+        return InverseMethod::General;
+    }
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+    if (dots.x * dots.x > lengths.x * lengths.y * xo_internal::InverseOrthogonalTolerance ||
+        dots.y * dots.y > lengths.y * lengths.z * xo_internal::InverseOrthogonalTolerance ||
+        dots.z * dots.z > lengths.z * lengths.x * xo_internal::InverseOrthogonalTolerance) {
+        return InverseMethod::Affine;
+    }
+    if (Abs(lengths.x - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.y - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.z - 1.0f) > xo_internal::InverseUnitTolerance) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
 #endif
 }
 
-Matrix4x4& Matrix4x4::Transpose() {
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAuto(InverseStats* stats) const {
+    InverseMethod method = ClassifyInverse();
+    if (stats) {
+        stats->count[(int)method]++;
+    }
+    // every path writes to the one matrix, so it can be returned without a copy.
+    Matrix4x4 o;
+    if (method == InverseMethod::Rigid || method == InverseMethod::ScaleRotateTranslate) {
+        xo_internal::InverseOrthogonal(*this, o, method == InverseMethod::ScaleRotateTranslate);
+    }
+    else if (method == InverseMethod::Affine) {
+        o = InverseAffine();
+    }
+    else {
+        o = *this;
+        o.MakeInverse();
+    }
+    return o;
+}
+
+_XOSRCINL Matrix4x4& Matrix4x4::Transpose() {
 #if defined(XO_SSE)
     _MM_TRANSPOSE4_PS(r[0].xmm, r[1].xmm, r[2].xmm, r[3].xmm);
 #else
@@ -362,57 +2286,841 @@ Matrix4x4& Matrix4x4::Transpose() {
     return *this;
 }
 
-Matrix4x4 Matrix4x4::Transposed() const {
+_XOSRCINL Matrix4x4 Matrix4x4::Transposed() const {
     Matrix4x4 m(*this);
     return m.Transpose();
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
     v = (*this) * Vector4(v);
     return *this;
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
     v = (*this) * v;
     return *this;
 }
 
-void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
+namespace xo_internal
+{
+    // Computes out[i] = c0*x + c1*y + c2*z + c3 for each vector, where cN is the Nth column of the matrix.
+    // Rather than a horizontal dot product per row, each element of the vector is broadcast and multiplied 
+    // against a whole column. The columns are transposed out of the matrix once, before the loop.
+    // When translate is false c3 is left as zero, so the fourth column isn't applied.
+    _XOSRCINL void TransformVector3Array(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+#if defined(XO_SSE)
+        // transposing with a zero fourth row keeps the w lane of every result at zero.
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), c3));
+        }
+#else
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + tx;
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + ty;
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + tz;
+        }
+#endif
+    }
+
+    // See TransformVector3Array, this is the same with a w element and fourth column.
+    _XOSRCINL void TransformVector4Array(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+#if defined(XO_SSE)
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), _mm_mul_ps(c3, w)));
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z, w = in[i].w;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + (m.m03 * w);
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + (m.m13 * w);
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + (m.m23 * w);
+            out[i].w = (m.m30 * x) + (m.m31 * y) + (m.m32 * z) + (m.m33 * w);
+        }
+#endif
+    }
+
+    _XOSRCINL void MultiplyBatch(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i * aStep] * b[i * bStep];
+        }
+    }
+
+    _XOSRCINL void MultiplyIndexedBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[aIndices[i]] * b[i];
+        }
+    }
+
+#if defined(XO_SSE)
+    // Inverts four matrices at once, with element k of all four in a[k], so the cofactors need no shuffles, only
+    // the transposes in and out. The expansion is by the 2x2 minors of the top and bottom pairs of rows, as
+    // Matrix4x4::Determinant. A matrix with a determinant of zero is left as it was, as TryMakeInverse leaves it,
+    // and reported false in ok when ok isn't null. in may be out.
+    _XOINL void InverseFour(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m128 a[16], b[16];
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = in[0].r[r].xmm, m1 = in[1].r[r].xmm, m2 = in[2].r[r].xmm, m3 = in[3].r[r].xmm;
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            a[r * 4 + 0] = m0;
+            a[r * 4 + 1] = m1;
+            a[r * 4 + 2] = m2;
+            a[r * 4 + 3] = m3;
+        }
+        __m128 s0 = _mm_sub_ps(_mm_mul_ps(a[0], a[5]), _mm_mul_ps(a[4], a[1]));
+        __m128 s1 = _mm_sub_ps(_mm_mul_ps(a[0], a[6]), _mm_mul_ps(a[4], a[2]));
+        __m128 s2 = _mm_sub_ps(_mm_mul_ps(a[0], a[7]), _mm_mul_ps(a[4], a[3]));
+        __m128 s3 = _mm_sub_ps(_mm_mul_ps(a[1], a[6]), _mm_mul_ps(a[5], a[2]));
+        __m128 s4 = _mm_sub_ps(_mm_mul_ps(a[1], a[7]), _mm_mul_ps(a[5], a[3]));
+        __m128 s5 = _mm_sub_ps(_mm_mul_ps(a[2], a[7]), _mm_mul_ps(a[6], a[3]));
+        __m128 c5 = _mm_sub_ps(_mm_mul_ps(a[10], a[15]), _mm_mul_ps(a[14], a[11]));
+        __m128 c4 = _mm_sub_ps(_mm_mul_ps(a[9], a[15]), _mm_mul_ps(a[13], a[11]));
+        __m128 c3 = _mm_sub_ps(_mm_mul_ps(a[9], a[14]), _mm_mul_ps(a[13], a[10]));
+        __m128 c2 = _mm_sub_ps(_mm_mul_ps(a[8], a[15]), _mm_mul_ps(a[12], a[11]));
+        __m128 c1 = _mm_sub_ps(_mm_mul_ps(a[8], a[14]), _mm_mul_ps(a[12], a[10]));
+        __m128 c0 = _mm_sub_ps(_mm_mul_ps(a[8], a[13]), _mm_mul_ps(a[12], a[9]));
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(s0, c5), _mm_mul_ps(s1, c4)), _mm_mul_ps(s2, c3)), _mm_add_ps(_mm_sub_ps(_mm_mul_ps(s3, c2), _mm_mul_ps(s4, c1)), _mm_mul_ps(s5, c0)));
+        b[0] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[5], c5), _mm_mul_ps(a[6], c4)), _mm_mul_ps(a[7], c3));
+        b[1] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[2], c4), _mm_mul_ps(a[1], c5)), _mm_mul_ps(a[3], c3));
+        b[2] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[13], s5), _mm_mul_ps(a[14], s4)), _mm_mul_ps(a[15], s3));
+        b[3] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[10], s4), _mm_mul_ps(a[9], s5)), _mm_mul_ps(a[11], s3));
+        b[4] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[6], c2), _mm_mul_ps(a[4], c5)), _mm_mul_ps(a[7], c1));
+        b[5] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c5), _mm_mul_ps(a[2], c2)), _mm_mul_ps(a[3], c1));
+        b[6] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[14], s2), _mm_mul_ps(a[12], s5)), _mm_mul_ps(a[15], s1));
+        b[7] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s5), _mm_mul_ps(a[10], s2)), _mm_mul_ps(a[11], s1));
+        b[8] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[4], c4), _mm_mul_ps(a[5], c2)), _mm_mul_ps(a[7], c0));
+        b[9] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[1], c2), _mm_mul_ps(a[0], c4)), _mm_mul_ps(a[3], c0));
+        b[10] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[12], s4), _mm_mul_ps(a[13], s2)), _mm_mul_ps(a[15], s0));
+        b[11] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[9], s2), _mm_mul_ps(a[8], s4)), _mm_mul_ps(a[11], s0));
+        b[12] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[5], c1), _mm_mul_ps(a[4], c3)), _mm_mul_ps(a[6], c0));
+        b[13] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c3), _mm_mul_ps(a[1], c1)), _mm_mul_ps(a[2], c0));
+        b[14] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[13], s1), _mm_mul_ps(a[12], s3)), _mm_mul_ps(a[14], s0));
+        b[15] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s3), _mm_mul_ps(a[9], s1)), _mm_mul_ps(a[10], s0));
+        __m128 invertible = _mm_cmpneq_ps(det, _mm_setzero_ps());
+        __m128 inv = _mm_div_ps(sse::One, det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm_or_ps(_mm_and_ps(invertible, _mm_mul_ps(b[k], inv)), _mm_andnot_ps(invertible, a[k]));
+        }
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = b[r * 4 + 0], m1 = b[r * 4 + 1], m2 = b[r * 4 + 2], m3 = b[r * 4 + 3];
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            out[0].r[r].xmm = m0;
+            out[1].r[r].xmm = m1;
+            out[2].r[r].xmm = m2;
+            out[3].r[r].xmm = m3;
+        }
+        if (ok) {
+            int bits = _mm_movemask_ps(invertible);
+            for (int j = 0; j < 4; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+#endif
+
+    _XOSRCINL void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            InverseFour(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            // the last few are padded out with identities, so nothing past the end is read or written.
+            Matrix4x4 tail[4];
+            bool tailOk[4];
+            for (size_t j = 0; j < 4; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseFour(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            Matrix4x4 m = in[i];
+            bool invertible = m.TryMakeInverse();
+            out[i] = m;
+            if (ok) {
+                ok[i] = invertible;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row i of lo in the low 128 bit lane and row i of hi in the high lane.
+    _XOINL _XO_TARGET_AVX __m256 LoadRowPair(const Matrix4x4& lo, const Matrix4x4& hi, int i) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.r[i].xmm), hi.r[i].xmm, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void StoreRowPair(Matrix4x4& lo, Matrix4x4& hi, int i, __m256 v) {
+        lo.r[i].xmm = _mm256_castps256_ps128(v);
+        hi.r[i].xmm = _mm256_extractf128_ps(v, 1);
+    }
+
+    // Multiplies two matrices at once, one per 128 bit lane. aN and bN are row N of the left and right hand.
+    // All rows are passed in before any are stored, so the outputs may alias either input.
+    _XOINL _XO_TARGET_AVX void MultiplyPair(__m256 a0, __m256 a1, __m256 a2, __m256 a3, 
+                                            __m256 b0, __m256 b1, __m256 b2, __m256 b3, 
+                                            Matrix4x4& outLo, Matrix4x4& outHi) 
+    {
+        StoreRowPair(outLo, outHi, 0, sse::LinearCombination(a0, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 1, sse::LinearCombination(a1, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 2, sse::LinearCombination(a2, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 3, sse::LinearCombination(a3, b0, b1, b2, b3));
+    }
+
+    // Two vectors in v, transformed by the columns c0 to c3 of the matrix. The w of each vector is ignored and 1 is used.
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector3(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector4(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), _mm256_mul_ps(c3, w)));
+    }
+
+    // The same matrix in both lanes, for the side of MultiplyBatchAVX with a step of 0.
+    _XOINL _XO_TARGET_AVX void BroadcastRows(const Matrix4x4& m, __m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+        r0 = _mm256_broadcast_ps(&m.r[0].xmm);
+        r1 = _mm256_broadcast_ps(&m.r[1].xmm);
+        r2 = _mm256_broadcast_ps(&m.r[2].xmm);
+        r3 = _mm256_broadcast_ps(&m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Two vectors per register, one in each 128 bit lane. _mm256_shuffle_ps shuffles within each lane.
+    // Eight vectors per pass, then the last few through masked loads and stores.
+    _XOSRCINL _XO_TARGET_AVX void TransformVector3ArrayAVX(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector3(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector3(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void TransformVector4ArrayAVX(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector4(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector4(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void MultiplyBatchAVX(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        __m256 a0, a1, a2, a3, b0, b1, b2, b3;
+        if (aStep == 0) {
+            BroadcastRows(*a, a0, a1, a2, a3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(a0, a1, a2, a3,
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        else if (bStep == 0) {
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             b0, b1, b2, b3,
+                             out[i], out[i+1]);
+            }
+        }
+        else {
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        if (i < n) {
+            // The last odd product goes through the same pair kernel, with its high lane thrown away.
+            const Matrix4x4& la = a[i * aStep];
+            const Matrix4x4& lb = b[i * bStep];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(lb, lb, 0), LoadRowPair(lb, lb, 1), LoadRowPair(lb, lb, 2), LoadRowPair(lb, lb, 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // As MultiplyBatchAVX, with the left hand rows of each pair gathered from wherever the indices point.
+    _XOSRCINL _XO_TARGET_AVX void MultiplyIndexedBatchAVX(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const Matrix4x4& a0 = a[aIndices[i]];
+            const Matrix4x4& a1 = a[aIndices[i+1]];
+            MultiplyPair(LoadRowPair(a0, a1, 0), LoadRowPair(a0, a1, 1), LoadRowPair(a0, a1, 2), LoadRowPair(a0, a1, 3),
+                         LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                         LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                         out[i], out[i+1]);
+        }
+        if (i < n) {
+            const Matrix4x4& la = a[aIndices[i]];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(b[i], b[i], 0), LoadRowPair(b[i], b[i], 1), LoadRowPair(b[i], b[i], 2), LoadRowPair(b[i], b[i], 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 8x8 transpose: interleave pairs of rows, then pairs of pairs, then swap the 128 bit lanes.
+    _XOINL _XO_TARGET_AVX void Transpose8x8(__m256 v[8]) {
+        __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]), t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]), t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        __m256 t4 = _mm256_unpacklo_ps(v[4], v[5]), t5 = _mm256_unpackhi_ps(v[4], v[5]);
+        __m256 t6 = _mm256_unpacklo_ps(v[6], v[7]), t7 = _mm256_unpackhi_ps(v[6], v[7]);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        v[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+        v[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+        v[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+        v[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+        v[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+        v[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+        v[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+        v[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+    }
+
+    // See InverseFour. Each register holds two rows of a matrix, so the eight matrices are two 8x8 transposes.
+    _XOINL _XO_TARGET_AVX void InverseEight(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        // the loads and stores are written out so the arrays stay in registers rather than on the stack.
+        __m256 a[16] = {
+            _mm256_loadu_ps(in[0].m), _mm256_loadu_ps(in[1].m), _mm256_loadu_ps(in[2].m), _mm256_loadu_ps(in[3].m),
+            _mm256_loadu_ps(in[4].m), _mm256_loadu_ps(in[5].m), _mm256_loadu_ps(in[6].m), _mm256_loadu_ps(in[7].m),
+            _mm256_loadu_ps(in[0].m + 8), _mm256_loadu_ps(in[1].m + 8), _mm256_loadu_ps(in[2].m + 8), _mm256_loadu_ps(in[3].m + 8),
+            _mm256_loadu_ps(in[4].m + 8), _mm256_loadu_ps(in[5].m + 8), _mm256_loadu_ps(in[6].m + 8), _mm256_loadu_ps(in[7].m + 8)
+        };
+        __m256 b[16];
+        Transpose8x8(a);
+        Transpose8x8(a + 8);
+        __m256 s0 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[5]), _mm256_mul_ps(a[4], a[1]));
+        __m256 s1 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[6]), _mm256_mul_ps(a[4], a[2]));
+        __m256 s2 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[7]), _mm256_mul_ps(a[4], a[3]));
+        __m256 s3 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[6]), _mm256_mul_ps(a[5], a[2]));
+        __m256 s4 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[7]), _mm256_mul_ps(a[5], a[3]));
+        __m256 s5 = _mm256_sub_ps(_mm256_mul_ps(a[2], a[7]), _mm256_mul_ps(a[6], a[3]));
+        __m256 c5 = _mm256_sub_ps(_mm256_mul_ps(a[10], a[15]), _mm256_mul_ps(a[14], a[11]));
+        __m256 c4 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[15]), _mm256_mul_ps(a[13], a[11]));
+        __m256 c3 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[14]), _mm256_mul_ps(a[13], a[10]));
+        __m256 c2 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[15]), _mm256_mul_ps(a[12], a[11]));
+        __m256 c1 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[14]), _mm256_mul_ps(a[12], a[10]));
+        __m256 c0 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[13]), _mm256_mul_ps(a[12], a[9]));
+        __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s0, c5), _mm256_mul_ps(s1, c4)), _mm256_mul_ps(s2, c3)), _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s3, c2), _mm256_mul_ps(s4, c1)), _mm256_mul_ps(s5, c0)));
+        b[0] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c5), _mm256_mul_ps(a[6], c4)), _mm256_mul_ps(a[7], c3));
+        b[1] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[2], c4), _mm256_mul_ps(a[1], c5)), _mm256_mul_ps(a[3], c3));
+        b[2] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s5), _mm256_mul_ps(a[14], s4)), _mm256_mul_ps(a[15], s3));
+        b[3] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[10], s4), _mm256_mul_ps(a[9], s5)), _mm256_mul_ps(a[11], s3));
+        b[4] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[6], c2), _mm256_mul_ps(a[4], c5)), _mm256_mul_ps(a[7], c1));
+        b[5] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c5), _mm256_mul_ps(a[2], c2)), _mm256_mul_ps(a[3], c1));
+        b[6] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[14], s2), _mm256_mul_ps(a[12], s5)), _mm256_mul_ps(a[15], s1));
+        b[7] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s5), _mm256_mul_ps(a[10], s2)), _mm256_mul_ps(a[11], s1));
+        b[8] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[4], c4), _mm256_mul_ps(a[5], c2)), _mm256_mul_ps(a[7], c0));
+        b[9] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[1], c2), _mm256_mul_ps(a[0], c4)), _mm256_mul_ps(a[3], c0));
+        b[10] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[12], s4), _mm256_mul_ps(a[13], s2)), _mm256_mul_ps(a[15], s0));
+        b[11] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[9], s2), _mm256_mul_ps(a[8], s4)), _mm256_mul_ps(a[11], s0));
+        b[12] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c1), _mm256_mul_ps(a[4], c3)), _mm256_mul_ps(a[6], c0));
+        b[13] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c3), _mm256_mul_ps(a[1], c1)), _mm256_mul_ps(a[2], c0));
+        b[14] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s1), _mm256_mul_ps(a[12], s3)), _mm256_mul_ps(a[14], s0));
+        b[15] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s3), _mm256_mul_ps(a[9], s1)), _mm256_mul_ps(a[10], s0));
+        __m256 invertible = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm256_blendv_ps(a[k], _mm256_mul_ps(b[k], inv), invertible);
+        }
+        Transpose8x8(b);
+        Transpose8x8(b + 8);
+        for (int j = 0; j < 8; ++j) {
+            _mm256_storeu_ps(out[j].m, b[j]);
+            _mm256_storeu_ps(out[j].m + 8, b[j + 8]);
+        }
+        if (ok) {
+            int bits = _mm256_movemask_ps(invertible);
+            for (int j = 0; j < 8; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void InverseBatchAVX(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            InverseEight(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[8];
+            bool tailOk[8];
+            for (size_t j = 0; j < 8; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseEight(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // Four vectors in v, one per 128 bit lane, transformed by the columns c0 to c3 of the matrix.
+    // The w of each vector is ignored and c3 is added, so c3 is zero for directions.
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector3(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector4(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m512 w = _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), _mm512_mul_ps(c3, w)));
+    }
+
+    // One whole matrix per register, a row per 128 bit lane. Row i of the product is the linear combination of 
+    // the rows b0 to b3, weighted by row i of a, so each lane broadcasts its own elements of a.
+    // Grouped as sse::LinearCombination, so the results match the narrower kernels exactly.
+    _XOINL _XO_TARGET_AVX512 __m512 MultiplyWhole(__m512 a, __m512 b0, __m512 b1, __m512 b2, __m512 b3) {
+        return _mm512_add_ps(
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+
+    _XOINL _XO_TARGET_AVX512 void BroadcastRows(const Matrix4x4& m, __m512& r0, __m512& r1, __m512& r2, __m512& r3) {
+        r0 = _mm512_broadcast_f32x4(m.r[0].xmm);
+        r1 = _mm512_broadcast_f32x4(m.r[1].xmm);
+        r2 = _mm512_broadcast_f32x4(m.r[2].xmm);
+        r3 = _mm512_broadcast_f32x4(m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Four vectors per register. Sixteen vectors per pass, then four at a time, then the last few through a mask
+    // register.
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector3ArrayAVX512(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector3(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector4ArrayAVX512(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector4(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // A matrix is one register, so there's no tail. Each product is loaded before it's stored, so out may alias
+    // either input.
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyBatchAVX512(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        if (bStep == 0) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                __m512 p0 = MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3);
+                __m512 p1 = MultiplyWhole(_mm512_loadu_ps(a[i+1].m), b0, b1, b2, b3);
+                _mm512_storeu_ps(out[i].m, p0);
+                _mm512_storeu_ps(out[i+1].m, p1);
+            }
+            if (i < n) {
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3));
+            }
+        }
+        else {
+            __m512 wa = _mm512_loadu_ps(a->m);
+            for (; i < n; ++i) {
+                __m512 b0, b1, b2, b3;
+                const Matrix4x4& mb = b[i];
+                BroadcastRows(mb, b0, b1, b2, b3);
+                if (aStep != 0) {
+                    wa = _mm512_loadu_ps(a[i].m);
+                }
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(wa, b0, b1, b2, b3));
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyIndexedBatchAVX512(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(b[i], b0, b1, b2, b3);
+            _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[aIndices[i]].m), b0, b1, b2, b3));
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 16x16 transpose: interleave pairs of rows, then pairs of pairs, then two rounds of moving
+    // 128 bit lanes between registers.
+    _XOINL _XO_TARGET_AVX512 void Transpose16x16(__m512 v[16]) {
+        __m512 t[16], u[16];
+        for (int i = 0; i < 16; i += 2) {
+            t[i] = _mm512_unpacklo_ps(v[i], v[i + 1]);
+            t[i + 1] = _mm512_unpackhi_ps(v[i], v[i + 1]);
+        }
+        for (int i = 0; i < 16; i += 4) {
+            u[i] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 1] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            u[i + 2] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 3] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+        for (int i = 0; i < 16; i += 8) {
+            for (int j = 0; j < 4; ++j) {
+                t[i + j] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(2, 0, 2, 0));
+                t[i + j + 4] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(3, 1, 3, 1));
+            }
+        }
+        for (int j = 0; j < 8; ++j) {
+            v[j] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(2, 0, 2, 0));
+            v[j + 8] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(3, 1, 3, 1));
+        }
+    }
+
+    // See InverseFour. Each register holds a whole matrix, so the sixteen matrices are one 16x16 transpose.
+    _XOINL _XO_TARGET_AVX512 void InverseSixteen(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m512 a[16], b[16];
+        for (int j = 0; j < 16; ++j) {
+            a[j] = _mm512_loadu_ps(in[j].m);
+        }
+        Transpose16x16(a);
+        __m512 s0 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[5]), _mm512_mul_ps(a[4], a[1]));
+        __m512 s1 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[6]), _mm512_mul_ps(a[4], a[2]));
+        __m512 s2 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[7]), _mm512_mul_ps(a[4], a[3]));
+        __m512 s3 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[6]), _mm512_mul_ps(a[5], a[2]));
+        __m512 s4 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[7]), _mm512_mul_ps(a[5], a[3]));
+        __m512 s5 = _mm512_sub_ps(_mm512_mul_ps(a[2], a[7]), _mm512_mul_ps(a[6], a[3]));
+        __m512 c5 = _mm512_sub_ps(_mm512_mul_ps(a[10], a[15]), _mm512_mul_ps(a[14], a[11]));
+        __m512 c4 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[15]), _mm512_mul_ps(a[13], a[11]));
+        __m512 c3 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[14]), _mm512_mul_ps(a[13], a[10]));
+        __m512 c2 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[15]), _mm512_mul_ps(a[12], a[11]));
+        __m512 c1 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[14]), _mm512_mul_ps(a[12], a[10]));
+        __m512 c0 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[13]), _mm512_mul_ps(a[12], a[9]));
+        __m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s0, c5), _mm512_mul_ps(s1, c4)), _mm512_mul_ps(s2, c3)), _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s3, c2), _mm512_mul_ps(s4, c1)), _mm512_mul_ps(s5, c0)));
+        b[0] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c5), _mm512_mul_ps(a[6], c4)), _mm512_mul_ps(a[7], c3));
+        b[1] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[2], c4), _mm512_mul_ps(a[1], c5)), _mm512_mul_ps(a[3], c3));
+        b[2] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s5), _mm512_mul_ps(a[14], s4)), _mm512_mul_ps(a[15], s3));
+        b[3] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[10], s4), _mm512_mul_ps(a[9], s5)), _mm512_mul_ps(a[11], s3));
+        b[4] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[6], c2), _mm512_mul_ps(a[4], c5)), _mm512_mul_ps(a[7], c1));
+        b[5] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c5), _mm512_mul_ps(a[2], c2)), _mm512_mul_ps(a[3], c1));
+        b[6] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[14], s2), _mm512_mul_ps(a[12], s5)), _mm512_mul_ps(a[15], s1));
+        b[7] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s5), _mm512_mul_ps(a[10], s2)), _mm512_mul_ps(a[11], s1));
+        b[8] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[4], c4), _mm512_mul_ps(a[5], c2)), _mm512_mul_ps(a[7], c0));
+        b[9] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[1], c2), _mm512_mul_ps(a[0], c4)), _mm512_mul_ps(a[3], c0));
+        b[10] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[12], s4), _mm512_mul_ps(a[13], s2)), _mm512_mul_ps(a[15], s0));
+        b[11] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[9], s2), _mm512_mul_ps(a[8], s4)), _mm512_mul_ps(a[11], s0));
+        b[12] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c1), _mm512_mul_ps(a[4], c3)), _mm512_mul_ps(a[6], c0));
+        b[13] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c3), _mm512_mul_ps(a[1], c1)), _mm512_mul_ps(a[2], c0));
+        b[14] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s1), _mm512_mul_ps(a[12], s3)), _mm512_mul_ps(a[14], s0));
+        b[15] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s3), _mm512_mul_ps(a[9], s1)), _mm512_mul_ps(a[10], s0));
+        __mmask16 invertible = _mm512_cmp_ps_mask(det, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+        __m512 inv = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm512_mask_blend_ps(invertible, a[k], _mm512_mul_ps(b[k], inv));
+        }
+        Transpose16x16(b);
+        for (int j = 0; j < 16; ++j) {
+            _mm512_storeu_ps(out[j].m, b[j]);
+        }
+        if (ok) {
+            for (int j = 0; j < 16; ++j) {
+                ok[j] = ((invertible >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void InverseBatchAVX512(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            InverseSixteen(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[16];
+            bool tailOk[16];
+            for (size_t j = 0; j < 16; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseSixteen(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(const Vector4* in, Vector4* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector4Array(*this, in, out, n);
+#else
+    xo_internal::TransformVector4Array(*this, in, out, n);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(Vector4* inOut, size_t n) const {
+    return TransformVector4s(inOut, inOut, n);
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(&a, 0, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(&a, 0, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, &b, 0, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, &b, 0, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyIndexedBatch(a, aIndices, b, out, n);
+#else
+    xo_internal::MultiplyIndexedBatch(a, aIndices, b, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().inverseBatch(in, out, ok, n);
+#else
+    xo_internal::InverseBatch(in, out, ok, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
     m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, xyz,  0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, xyz,  0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
     m[0].Set(x,    0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, y,    0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, z,    0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
     m[0].Set(v.x,  0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, v.y,  0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, v.z,  0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
     m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
     m[3].Set(x,    y,    z,    1.0f);
 }
 
-void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
     m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
     m[3].Set(v,                1.0f);
 }
 
-void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
 
     SinCos(radians, sinr, cosr);
@@ -422,7 +3130,7 @@ void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
     SinCos(radians, sinr, cosr);
     m[0].Set(cosr, 0.0f,-sinr, 0.0f);
@@ -431,7 +3139,7 @@ void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
     SinCos(radians, sinr, cosr);
     m[0].Set(cosr,-sinr, 0.0f, 0.0f);
@@ -440,7 +3148,7 @@ void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
     _XOSIMDALIGN float c[4];
     _XOSIMDALIGN float s[4];
     Vector4 v(x, y, z, 0.0f);
@@ -452,7 +3160,7 @@ void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
     m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
 }
 
-void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
     _XOSIMDALIGN float c[4];
     _XOSIMDALIGN float s[4];
     SinCos_x4(v.f, s, c);
@@ -463,7 +3171,7 @@ void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
     m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
 }
 
-void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
     float s, c;
     SinCos(radians, s, c);
     float t = 1.0f - c;
@@ -478,19 +3186,19 @@ void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m)
         );
 }
 
-void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
     RotationXRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
     RotationYRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
     RotationZRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
     Matrix4x4 m0, m1, m2;
     RotationXDegrees(x, m0);
     RotationYDegrees(y, m1);
@@ -498,7 +3206,7 @@ void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
     m = m0 * m1 * m2;
 }
 
-void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
     Matrix4x4 m0, m1, m2;
     RotationXDegrees(v.x, m0);
     RotationYDegrees(v.y, m1);
@@ -507,11 +3215,11 @@ void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
 }
 
 
-void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
     AxisAngleRadians(a, degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
     XO_ASSERT(w != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Width (w) should not be zero."));
     XO_ASSERT(h != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Height (h) should not be zero."));
     m = Matrix4x4(
@@ -522,7 +3230,7 @@ void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matri
         );
 }
  
-void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
     XO_ASSERT(n != f, _XO_ASSERT_MSG("::PerspectiveProjectionRadians Near (n) and far (f) values should not be equal."));
     m = Matrix4x4(
             ATan(fovx/2.0f),   0.0f,               0.0f,               0.0f,
@@ -532,11 +3240,11 @@ void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, fl
         );
 }
 
-void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
+_XOSRCINL void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
     Matrix4x4::PerspectiveProjectionRadians(fovx * Deg2Rad, fovy * Deg2Rad, n, f, outMatrix);
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
     Vector3 zAxis = (to - from).Normalized();
     Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
     Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
@@ -548,11 +3256,11 @@ void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const
         );
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
     LookAtFromPosition(from, to, Vector3::Up, m);
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
     Vector3 zAxis = direction.Normalized();
     Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
     Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
@@ -564,170 +3272,172 @@ void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up,
         );
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
     LookAtFromDirection(direction, Vector3::Up, m);
 }
 
-Matrix4x4 Matrix4x4::Scale(float xyz) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float xyz) {
     Matrix4x4 m;
     Scale(xyz, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
     Matrix4x4 m;
     Scale(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
     Matrix4x4 m;
     Scale(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
     Matrix4x4 m;
     Translation(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
     Matrix4x4 m;
     Translation(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
     Matrix4x4 m;
     RotationXRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
     Matrix4x4 m;
     RotationYRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
     Matrix4x4 m;
     RotationZRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
     Matrix4x4 m;
     RotationRadians(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
     Matrix4x4 m;
     RotationRadians(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
     Matrix4x4 m;
     AxisAngleRadians(axis, radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
     Matrix4x4 m;
     RotationXDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
     Matrix4x4 m;
     RotationYDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
     Matrix4x4 m;
     RotationZDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
     Matrix4x4 m;
     RotationDegrees(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
     Matrix4x4 m;
     RotationDegrees(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
     Matrix4x4 m;
     AxisAngleDegrees(axis, degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
     Matrix4x4 m;
     OrthographicProjection(w, h, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
     Matrix4x4 m;
     PerspectiveProjectionRadians(fovx, fovy, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
     Matrix4x4 m;
     PerspectiveProjectionDegrees(fovx, fovy, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
     Matrix4x4 m;
     LookAtFromPosition(from, to, up, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
     Matrix4x4 m;
     LookAtFromPosition(from, to, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
     Matrix4x4 m;
     LookAtFromDirection(direction, up, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
     Matrix4x4 m;
     LookAtFromDirection(direction, m);
     return m;
 }
 
+#undef _XO_ASSERT_MSG
+
 
 ////////////////////////////////////////////////////////////////////////// Quaternion.cpp
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+_XOSRCDATA const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
 #   else
-const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
+_XOSRCDATA const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
 #   endif
 #endif
 
-const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
-const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
 
 namespace xo_internal
 {
     _XOINL float QuaternionSquareSum(const Quaternion& q)
     {
-#if defined(XO_SSE)
+#if defined(XO_SSE3)
         __m128 square = _mm_mul_ps(q.xmm, q.xmm);
         square = _mm_hadd_ps(square, square);
         square = _mm_hadd_ps(square, square);
@@ -738,11 +3448,72 @@ namespace xo_internal
     }
 }
 
-Quaternion::Quaternion()
-{
-}
-
-Quaternion::Quaternion(const Matrix4x4& mat)
+_XOSRCINL Quaternion::Quaternion()
+{
+}
+
+_XOSRCINL Quaternion::Quaternion(const Matrix3x4& mat)
+{
+    // The rotation is taken from the columns, which are the transformed axes, so a scale applied before the
+    // rotation divides out.
+    Vector3 xAxis = mat.GetColumn(0);
+    Vector3 yAxis = mat.GetColumn(1);
+    Vector3 zAxis = mat.GetColumn(2);
+
+    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
+
+    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
+    {
+        _XO_ASSIGN_QUAT(1.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    xAxis /= scale.x;
+    yAxis /= scale.y;
+    zAxis /= scale.z;
+
+    // With the axes as columns, m[r][c] is axis c's component r.
+    float trace = xAxis.x + yAxis.y + zAxis.z;
+
+    if (trace > 0.0f)
+    {
+        float s = 0.5f / Sqrt(trace + 1.0f);
+        _XO_ASSIGN_QUAT(
+            0.25f / s,
+            (yAxis.z - zAxis.y) * s,
+            (zAxis.x - xAxis.z) * s,
+            (xAxis.y - yAxis.x) * s);
+    }
+    else if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (yAxis.z - zAxis.y) * s,
+            0.25f / s,
+            (yAxis.x + xAxis.y) * s,
+            (zAxis.x + xAxis.z) * s);
+    }
+    else if (yAxis.y > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (zAxis.x - xAxis.z) * s,
+            (yAxis.x + xAxis.y) * s,
+            0.25f / s,
+            (zAxis.y + yAxis.z) * s);
+    }
+    else
+    {
+        float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+        _XO_ASSIGN_QUAT(
+            (xAxis.y - yAxis.x) * s,
+            (zAxis.x + xAxis.z) * s,
+            (zAxis.y + yAxis.z) * s,
+            0.25f / s);
+    }
+}
+
+_XOSRCINL Quaternion::Quaternion(const Matrix4x4& mat)
 {
     Vector3 xAxis(mat[0]);
     Vector3 yAxis(mat[1]);
@@ -820,7 +3591,7 @@ Quaternion::Quaternion(const Matrix4x4& mat)
     }
 }
 
-Quaternion::Quaternion(float x, float y, float z, float w) :
+_XOSRCINL Quaternion::Quaternion(float x, float y, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, y, x))
 #else
@@ -829,12 +3600,12 @@ Quaternion::Quaternion(float x, float y, float z, float w) :
 {
 }
 
-Quaternion Quaternion::Inverse() const
+_XOSRCINL Quaternion Quaternion::Inverse() const
 {
     return Quaternion(*this).MakeInverse();
 }
 
-Quaternion& Quaternion::MakeInverse()
+_XOSRCINL Quaternion& Quaternion::MakeInverse()
 {
     float magnitude = xo_internal::QuaternionSquareSum(*this);
 
@@ -852,12 +3623,12 @@ Quaternion& Quaternion::MakeInverse()
     return *this;
 }
 
-Quaternion Quaternion::Normalized() const
+_XOSRCINL Quaternion Quaternion::Normalized() const
 {
     return Quaternion(*this).Normalize();
 }
 
-Quaternion& Quaternion::Normalize()
+_XOSRCINL Quaternion& Quaternion::Normalize()
 {
     float magnitude = xo_internal::QuaternionSquareSum(*this);
     if (CloseEnough(magnitude, 1.0f, Epsilon))
@@ -875,18 +3646,18 @@ Quaternion& Quaternion::Normalize()
     return *this;
 }
 
-Quaternion Quaternion::Conjugate() const
+_XOSRCINL Quaternion Quaternion::Conjugate() const
 {
     return Quaternion(*this).MakeConjugate();
 }
 
-Quaternion& Quaternion::MakeConjugate()
+_XOSRCINL Quaternion& Quaternion::MakeConjugate()
 {
     _XO_ASSIGN_QUAT(w, -x, -y, -z);
     return *this;
 }
 
-void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
+_XOSRCINL void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
 {
     Quaternion q = Normalized();
 
@@ -902,12 +3673,12 @@ void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
     radians = (2.0f * ACos(q.w));
 }
 
-void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
+_XOSRCINL void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
 {
     RotationRadians(Vector3(x, y, z), outQuat);
 }
 
-void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
+_XOSRCINL void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
 {
     Vector3 hv = v * 0.5f;
     _XOSIMDALIGN float s[3];
@@ -921,149 +3692,846 @@ void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
                       c[0] * c[1] * s[2] - s[0] * s[1] * c[2]);
 }
 
-void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
+_XOSRCINL void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
+{
+    float sr, cr;
+    SinCos(radians * 0.5f, sr, cr);
+
+    Vector3 n = axis.Normalized();
+    n *= sr;
+    _XO_ASSIGN_QUAT_Q(outQuat, cr, n.x, n.y, n.z);
+}
+
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
+{
+    LookAtFromDirection(to - from, up, outQuat);
+}
+
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+{
+    LookAtFromPosition(from, to, Vector3::Up, outQuat);
+}
+
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+{
+    // Todo
+}
+
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
+{
+    LookAtFromDirection(direction, Vector3::Up, outQuat);
+}
+
+_XOSRCINL void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
+
+    //      Copyright 2013 BlackBerry Inc.
+    //      Licensed under the Apache License, Version 2.0 (the "License");
+    //      you may not use this file except in compliance with the License.
+    //      You may obtain a copy of the License at
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //      Unless required by applicable law or agreed to in writing, software
+    //      distributed under the License is distributed on an "AS IS" BASIS,
+    //      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //      See the License for the specific language governing permissions and
+    //      limitations under the License.
+
+    //      Original file from GamePlay3D: http://gameplay3d.org
+
+    //      Modified by Jared Thomson in 2016:
+    //        - removed assertions
+    //        - made compatable with xo-math
+
+    // Fast slerp implementation by kwhatmough:
+    // It contains no division operations, no trig, no inverse trig
+    // and no sqrt. Not only does this code tolerate small constraint
+    // errors in the input quaternions, it actually corrects for them.
+    if (CloseEnough(t, 0.0f))
+    {
+        outQuat = a;
+        return;
+    }
+    else if (CloseEnough(t, 1.0f))
+    {
+        outQuat = b;
+        return;
+    }
+    else if (a == b)
+    {
+        outQuat = a;
+    }
+    else
+    {
+        float halfY, alpha, beta;
+        float u, f1, f2a, f2b;
+        float ratio1, ratio2;
+        float halfSecHalfTheta, versHalfTheta;
+        float sqNotU, sqU;
+
+        Vector4 * va = (Vector4*)&a;
+        Vector4 * vb = (Vector4*)&b;
+
+        float cosTheta = ((*va) * (*vb)).Sum();
+
+        // As usual in all slerp implementations, we fold theta.
+        alpha = cosTheta >= 0 ? 1.0f : -1.0f;
+        halfY = 1.0f + alpha * cosTheta;
+
+        // Here we bisect the interval, so we need to fold t as well.
+        f2b = t - 0.5f;
+        u = f2b >= 0 ? f2b : -f2b;
+        f2a = u - f2b;
+        f2b += u;
+        u += u;
+        f1 = 1.0f - u;
+
+        // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
+        halfSecHalfTheta = 1.09f - (0.476537f - 0.0903321f * halfY) * halfY;
+        halfSecHalfTheta *= 1.5f - halfY * halfSecHalfTheta * halfSecHalfTheta;
+        versHalfTheta = 1.0f - halfY * halfSecHalfTheta;
+
+        // Evaluate series expansions of the coefficients.
+        sqNotU = f1 * f1;
+        ratio2 = 0.0000440917108f * versHalfTheta;
+        ratio1 = -0.00158730159f + (sqNotU - 16.0f) * ratio2;
+        ratio1 = 0.0333333333f + ratio1 * (sqNotU - 9.0f) * versHalfTheta;
+        ratio1 = -0.333333333f + ratio1 * (sqNotU - 4.0f) * versHalfTheta;
+        ratio1 = 1.0f + ratio1 * (sqNotU - 1.0f) * versHalfTheta;
+
+        sqU = u * u;
+        ratio2 = -0.00158730159f + (sqU - 16.0f) * ratio2;
+        ratio2 = 0.0333333333f + ratio2 * (sqU - 9.0f) * versHalfTheta;
+        ratio2 = -0.333333333f + ratio2 * (sqU - 4.0f) * versHalfTheta;
+        ratio2 = 1.0f + ratio2 * (sqU - 1.0f) * versHalfTheta;
+
+        // Perform the bisection and resolve the folding done earlier.
+        f1 *= ratio1 * halfSecHalfTheta;
+        f2a *= ratio2;
+        f2b *= ratio2;
+        alpha *= f1 + f2a;
+        beta = f1 + f2b;
+
+        // Apply final coefficients to a and b as usual.
+        float w = alpha * a.w + beta * b.w;
+        float x = alpha * a.x + beta * b.x;
+        float y = alpha * a.y + beta * b.y;
+        float z = alpha * a.z + beta * b.z;
+
+        // This final adjustment to the quaternion's length corrects for
+        // any small constraint error in the inputs q1 and q2 But as you
+        // can see, it comes at the cost of 9 additional multiplication
+        // operations. If this error-correcting feature is not required,
+        // the following code may be removed.
+        f1 = 1.5f - 0.5f * (w * w + x * x + y * y + z * z);
+        _XO_ASSIGN_QUAT_Q(outQuat, w * f1, x * f1, y * f1, z * f1);
+    }
+}
+
+_XOSRCINL void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    Vector4& vq = (Vector4&)outQuat;
+    const Vector4& va = a;
+    const Vector4& vb = b;
+    // Todo: give the vectors the same static 'outQuat' type interface, then just use the Vector4::Lerp for this lerp
+    vq = va + (vb - va) * t;
+}
+
+_XOSRCINL void Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // b is negated when it's in the other hemisphere from a, so the blend takes the shorter way around.
+    float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    float wa = 1.0f - t;
+    float wb = cosTheta < 0.0f ? -t : t;
+    float x = wa * a.x + wb * b.x;
+    float y = wa * a.y + wb * b.y;
+    float z = wa * a.z + wb * b.z;
+    float w = wa * a.w + wb * b.w;
+    float s = 1.0f / Sqrt(x * x + y * y + z * z + w * w);
+    _XO_ASSIGN_QUAT_Q(outQuat, w * s, x * s, y * s, z * s);
+}
+
+_XOSRCINL void Quaternion::FastSlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // Arseny Kapoulkine's onlerp: http://zeux.io/2015/07/23/approximating-slerp/
+    // Nlerp moves fastest through the middle of the arc. t is bent by a cubic whose coefficient is fit to the angle 
+    // between a and b, which evens the speed out.
+    float d = Abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+    float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float c = t - 0.5f;
+    float k = A * c * c + B;
+    Nlerp(a, b, t + t * c * (t - 1.0f) * k, outQuat);
+}
+
+_XOSRCINL void Quaternion::SlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::NlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::FastSlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#endif
+}
+
+namespace xo_internal
+{
+    _XOSRCINL void RotateVector3Batch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = q[i].Rotate(in[i]);
+        }
+    }
+
+#if defined(XO_SSE)
+    // Quaternion::Slerp, Nlerp or FastSlerp of four pairs of quaternions, one pair per lane. a and b hold the x, y, z
+    // and w of the four, and the results are written over a.
+    _XOINL void BlendFour(__m128 a[4], const __m128 b[4], __m128 t, QuaternionBlend blend)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 cosTheta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+        __m128 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m128 alpha = _mm_sub_ps(_mm_and_ps(_mm_cmpge_ps(cosTheta, _mm_setzero_ps()), _mm_set1_ps(2.0f)), one);
+            __m128 halfY = _mm_add_ps(one, _mm_mul_ps(alpha, cosTheta));
+            __m128 f2b = _mm_sub_ps(t, half);
+            __m128 u = _mm_andnot_ps(signMask, f2b);
+            __m128 f2a = _mm_sub_ps(u, f2b);
+            f2b = _mm_add_ps(f2b, u);
+            u = _mm_add_ps(u, u);
+            __m128 f1 = _mm_sub_ps(one, u);
+            __m128 halfSecHalfTheta = _mm_sub_ps(_mm_set1_ps(1.09f), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(0.476537f), _mm_mul_ps(_mm_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm_mul_ps(halfSecHalfTheta, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m128 versHalfTheta = _mm_sub_ps(one, _mm_mul_ps(halfY, halfSecHalfTheta));
+            __m128 sqNotU = _mm_mul_ps(f1, f1);
+            __m128 ratio2 = _mm_mul_ps(_mm_set1_ps(0.0000440917108f), versHalfTheta);
+            __m128 ratio1 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqNotU, _mm_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, one)), versHalfTheta));
+            __m128 sqU = _mm_mul_ps(u, u);
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqU, _mm_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm_mul_ps(f1, _mm_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm_mul_ps(alpha, _mm_add_ps(f1, _mm_mul_ps(f2a, ratio2)));
+            wb = _mm_add_ps(f1, _mm_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m128 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m128 d = _mm_andnot_ps(signMask, cosTheta);
+                __m128 A = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+                __m128 B = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+                __m128 c = _mm_sub_ps(t, half);
+                __m128 k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(A, c), c), B);
+                s = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, c), _mm_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm_sub_ps(one, s);
+            wb = _mm_xor_ps(s, _mm_and_ps(cosTheta, signMask));
+        }
+        __m128 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm_add_ps(_mm_mul_ps(wa, a[i]), _mm_mul_ps(wb, b[i]));
+        }
+        __m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_add_ps(_mm_mul_ps(r[2], r[2]), _mm_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m128 scale = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, sq));
+            const __m128 epsilon = _mm_set1_ps(sse::SSEFloatEpsilon);
+            __m128 same = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[0], b[0])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[1], b[1])), epsilon)),
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[2], b[2])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[3], b[3])), epsilon)));
+            __m128 takeB = _mm_cmpeq_ps(t, one);
+            __m128 takeA = _mm_andnot_ps(takeB, _mm_or_ps(same, _mm_cmpeq_ps(t, _mm_setzero_ps())));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m128 v = _mm_mul_ps(r[i], scale);
+                v = _mm_or_ps(_mm_and_ps(takeB, b[i]), _mm_andnot_ps(takeB, v));
+                a[i] = _mm_or_ps(_mm_and_ps(takeA, a[i]), _mm_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m128 scale = _mm_rsqrt_ps(sq);
+            scale = _mm_mul_ps(scale, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(half, sq), _mm_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Four quaternions from each of a, b and t, blended into out.
+    _XOINL void BlendQuaternionsFour(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m128 qa[4] = { a[0].xmm, a[1].xmm, a[2].xmm, a[3].xmm };
+        __m128 qb[4] = { b[0].xmm, b[1].xmm, b[2].xmm, b[3].xmm };
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        _MM_TRANSPOSE4_PS(qb[0], qb[1], qb[2], qb[3]);
+        BlendFour(qa, qb, _mm_loadu_ps(t), blend);
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        out[0].xmm = qa[0];
+        out[1].xmm = qa[1];
+        out[2].xmm = qa[2];
+        out[3].xmm = qa[3];
+    }
+#endif
+
+    _XOSRCINL void BlendQuaternionBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            BlendQuaternionsFour(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            // The last few are padded out with identities to a whole group.
+            Quaternion ta[4], tb[4], tout[4];
+            float tt[4];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsFour(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i)
+        {
+            switch (blend)
+            {
+            case QuaternionBlend::Slerp:
+                Quaternion::Slerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::Nlerp:
+                Quaternion::Nlerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::FastSlerp:
+                Quaternion::FastSlerp(a[i], b[i], t[i], out[i]);
+                break;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 CrossPair(__m256 a, __m256 b)
+    {
+        __m256 r = _mm256_sub_ps(_mm256_mul_ps(a, _mm256_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm256_mul_ps(b, _mm256_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm256_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 RotatePair(__m256 q, __m256 v)
+    {
+        __m256 t = CrossPair(q, v);
+        t = _mm256_add_ps(t, t);
+        return _mm256_add_ps(_mm256_add_ps(v, _mm256_mul_ps(t, _mm256_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossPair(q, t));
+    }
+
+    // Eight vectors per pass, then pairs, then a masked load and store for the last one.
+    _XOSRCINL _XO_TARGET_AVX void RotateVector3BatchAVX(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 v0 = RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f));
+            __m256 v1 = RotatePair(_mm256_loadu_ps(q[i+2].f), _mm256_loadu_ps(in[i+2].f));
+            __m256 v2 = RotatePair(_mm256_loadu_ps(q[i+4].f), _mm256_loadu_ps(in[i+4].f));
+            __m256 v3 = RotatePair(_mm256_loadu_ps(q[i+6].f), _mm256_loadu_ps(in[i+6].f));
+            _mm256_storeu_ps(out[i].f, v0);
+            _mm256_storeu_ps(out[i+2].f, v1);
+            _mm256_storeu_ps(out[i+4].f, v2);
+            _mm256_storeu_ps(out[i+6].f, v3);
+        }
+        for (; i + 2 <= n; i += 2)
+        {
+            _mm256_storeu_ps(out[i].f, RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n)
+        {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, RotatePair(_mm256_maskload_ps(q[i].f, mask), _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // BlendFour on eight pairs of quaternions.
+    _XOINL _XO_TARGET_AVX void BlendEight(__m256 a[4], const __m256 b[4], __m256 t, QuaternionBlend blend)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 cosTheta = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])), _mm256_add_ps(_mm256_mul_ps(a[2], b[2]), _mm256_mul_ps(a[3], b[3])));
+        __m256 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m256 alpha = _mm256_sub_ps(_mm256_and_ps(_mm256_cmp_ps(cosTheta, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_set1_ps(2.0f)), one);
+            __m256 halfY = _mm256_add_ps(one, _mm256_mul_ps(alpha, cosTheta));
+            __m256 f2b = _mm256_sub_ps(t, half);
+            __m256 u = _mm256_andnot_ps(signMask, f2b);
+            __m256 f2a = _mm256_sub_ps(u, f2b);
+            f2b = _mm256_add_ps(f2b, u);
+            u = _mm256_add_ps(u, u);
+            __m256 f1 = _mm256_sub_ps(one, u);
+            __m256 halfSecHalfTheta = _mm256_sub_ps(_mm256_set1_ps(1.09f), _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(0.476537f), _mm256_mul_ps(_mm256_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm256_mul_ps(halfSecHalfTheta, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m256 versHalfTheta = _mm256_sub_ps(one, _mm256_mul_ps(halfY, halfSecHalfTheta));
+            __m256 sqNotU = _mm256_mul_ps(f1, f1);
+            __m256 ratio2 = _mm256_mul_ps(_mm256_set1_ps(0.0000440917108f), versHalfTheta);
+            __m256 ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqNotU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, one)), versHalfTheta));
+            __m256 sqU = _mm256_mul_ps(u, u);
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm256_mul_ps(f1, _mm256_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm256_mul_ps(alpha, _mm256_add_ps(f1, _mm256_mul_ps(f2a, ratio2)));
+            wb = _mm256_add_ps(f1, _mm256_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m256 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m256 d = _mm256_andnot_ps(signMask, cosTheta);
+                __m256 A = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(d, _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(d, _mm256_set1_ps(1.43519f)))))));
+                __m256 B = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(d, _mm256_set1_ps(0.215638f)))));
+                __m256 c = _mm256_sub_ps(t, half);
+                __m256 k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(A, c), c), B);
+                s = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, c), _mm256_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm256_sub_ps(one, s);
+            wb = _mm256_xor_ps(s, _mm256_and_ps(cosTheta, signMask));
+        }
+        __m256 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm256_add_ps(_mm256_mul_ps(wa, a[i]), _mm256_mul_ps(wb, b[i]));
+        }
+        __m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], r[0]), _mm256_mul_ps(r[1], r[1])), _mm256_add_ps(_mm256_mul_ps(r[2], r[2]), _mm256_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m256 scale = _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half, sq));
+            const __m256 epsilon = _mm256_set1_ps(sse::SSEFloatEpsilon);
+            __m256 same = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[0], b[0])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[1], b[1])), epsilon, _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[2], b[2])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[3], b[3])), epsilon, _CMP_LT_OQ)));
+            __m256 takeB = _mm256_cmp_ps(t, one, _CMP_EQ_OQ);
+            __m256 takeA = _mm256_andnot_ps(takeB, _mm256_or_ps(same, _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_EQ_OQ)));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m256 v = _mm256_mul_ps(r[i], scale);
+                v = _mm256_or_ps(_mm256_and_ps(takeB, b[i]), _mm256_andnot_ps(takeB, v));
+                a[i] = _mm256_or_ps(_mm256_and_ps(takeA, a[i]), _mm256_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m256 scale = _mm256_rsqrt_ps(sq);
+            scale = _mm256_mul_ps(scale, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(half, sq), _mm256_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm256_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Register k holds quaternion k in its low lane and k + 4 in its high lane, so after the in-lane transpose the
+    // lanes of each element are in order, and line up with t.
+    _XOINL _XO_TARGET_AVX void BlendQuaternionsEight(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m256 qa[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[0].xmm), a[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[1].xmm), a[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[2].xmm), a[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[3].xmm), a[7].xmm, 1)
+        };
+        __m256 qb[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[0].xmm), b[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[1].xmm), b[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[2].xmm), b[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[3].xmm), b[7].xmm, 1)
+        };
+        TransposeLanes4x4(qa);
+        TransposeLanes4x4(qb);
+        BlendEight(qa, qb, _mm256_loadu_ps(t), blend);
+        TransposeLanes4x4(qa);
+        out[0].xmm = _mm256_castps256_ps128(qa[0]);
+        out[1].xmm = _mm256_castps256_ps128(qa[1]);
+        out[2].xmm = _mm256_castps256_ps128(qa[2]);
+        out[3].xmm = _mm256_castps256_ps128(qa[3]);
+        out[4].xmm = _mm256_extractf128_ps(qa[0], 1);
+        out[5].xmm = _mm256_extractf128_ps(qa[1], 1);
+        out[6].xmm = _mm256_extractf128_ps(qa[2], 1);
+        out[7].xmm = _mm256_extractf128_ps(qa[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void BlendQuaternionBatchAVX(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            BlendQuaternionsEight(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            Quaternion ta[8], tb[8], tout[8];
+            float tt[8];
+            for (size_t j = 0; j < 8; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsEight(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
 {
-    float hr = radians * 0.5f;
-    float sr = Sin(hr);
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX512 __m512 CrossQuad(__m512 a, __m512 b)
+    {
+        __m512 r = _mm512_sub_ps(_mm512_mul_ps(a, _mm512_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm512_mul_ps(b, _mm512_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm512_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
 
-    Vector3 n = axis.Normalized();
-    n *= sr;
-    _XO_ASSIGN_QUAT_Q(outQuat, Cos(radians), n.x, n.y, n.z);
-}
+    _XOINL _XO_TARGET_AVX512 __m512 RotateQuad(__m512 q, __m512 v)
+    {
+        __m512 t = CrossQuad(q, v);
+        t = _mm512_add_ps(t, t);
+        return _mm512_add_ps(_mm512_add_ps(v, _mm512_mul_ps(t, _mm512_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossQuad(q, t));
+    }
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
-{
-    LookAtFromDirection(to - from, up, outQuat);
+    // Sixteen vectors per pass. The last passes mask their loads and stores, so there's no scalar remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void RotateVector3BatchAVX512(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m512 v0 = RotateQuad(_mm512_loadu_ps(q[i].f), _mm512_loadu_ps(in[i].f));
+            __m512 v1 = RotateQuad(_mm512_loadu_ps(q[i+4].f), _mm512_loadu_ps(in[i+4].f));
+            __m512 v2 = RotateQuad(_mm512_loadu_ps(q[i+8].f), _mm512_loadu_ps(in[i+8].f));
+            __m512 v3 = RotateQuad(_mm512_loadu_ps(q[i+12].f), _mm512_loadu_ps(in[i+12].f));
+            _mm512_storeu_ps(out[i].f, v0);
+            _mm512_storeu_ps(out[i+4].f, v1);
+            _mm512_storeu_ps(out[i+8].f, v2);
+            _mm512_storeu_ps(out[i+12].f, v3);
+        }
+        for (; i < n; i += 4)
+        {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, RotateQuad(_mm512_maskz_loadu_ps(mask, q[i].f), _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
 }
+#endif
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+_XOSRCINL const Quaternion& Quaternion::Rotate(const Vector3* in, Vector3* out, size_t n) const
 {
-    LookAtFromPosition(from, to, Vector3::Up, outQuat);
+    // Matrix3x4(const Quaternion&) rotates column vectors, as Rotate does.
+    Matrix4x4(Matrix3x4(*this)).TransformDirections(in, out, n);
+    return *this;
 }
 
-void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+_XOSRCINL const Quaternion& Quaternion::Rotate(Vector3* inOut, size_t n) const
 {
-    // Todo
+    return Rotate(inOut, inOut, n);
 }
 
-void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
+_XOSRCINL void Quaternion::RotateBatch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
 {
-    LookAtFromDirection(direction, Vector3::Up, outQuat);
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().rotateVector3Batch(q, in, out, n);
+#else
+    xo_internal::RotateVector3Batch(q, in, out, n);
+#endif
 }
 
-void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
-{
-    //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
 
-    //      Copyright 2013 BlackBerry Inc.
-    //      Licensed under the Apache License, Version 2.0 (the "License");
-    //      you may not use this file except in compliance with the License.
-    //      You may obtain a copy of the License at
-    //      http://www.apache.org/licenses/LICENSE-2.0
-    //      Unless required by applicable law or agreed to in writing, software
-    //      distributed under the License is distributed on an "AS IS" BASIS,
-    //      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    //      See the License for the specific language governing permissions and
-    //      limitations under the License.
+////////////////////////////////////////////////////////////////////////// Random.cpp
 
-    //      Original file from GamePlay3D: http://gameplay3d.org
+_XOSRCINL Random Random::NewThreadEngine() {
+    static std::atomic<uint32_t> nextStream(0);
+    return Random(DefaultSeed, nextStream++);
+}
 
-    //      Modified by Jared Thomson in 2016:
-    //        - removed assertions
-    //        - made compatable with xo-math
 
-    // Fast slerp implementation by kwhatmough:
-    // It contains no division operations, no trig, no inverse trig
-    // and no sqrt. Not only does this code tolerate small constraint
-    // errors in the input quaternions, it actually corrects for them.
-    if (CloseEnough(t, 0.0f))
-    {
-        outQuat = a;
-        return;
-    }
-    else if (CloseEnough(t, 1.0f))
-    {
-        outQuat = b;
-        return;
+////////////////////////////////////////////////////////////////////////// Skinning.cpp
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // The rows of the four bones of influence, blended by its weights into the rows of one affine matrix.
+    _XOINL void BlendBoneRows(const Vector4* palette, size_t boneStride, const Skinning::Influences& influence, __m128& r0, __m128& r1, __m128& r2) {
+        const Vector4* b0 = palette + influence.bones[0] * boneStride;
+        const Vector4* b1 = palette + influence.bones[1] * boneStride;
+        const Vector4* b2 = palette + influence.bones[2] * boneStride;
+        const Vector4* b3 = palette + influence.bones[3] * boneStride;
+        __m128 w = _mm_loadu_ps(influence.weights);
+        __m128 w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 w3 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[0].xmm, w0), _mm_mul_ps(b1[0].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[0].xmm, w2), _mm_mul_ps(b3[0].xmm, w3)));
+        r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[1].xmm, w0), _mm_mul_ps(b1[1].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[1].xmm, w2), _mm_mul_ps(b3[1].xmm, w3)));
+        r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[2].xmm, w0), _mm_mul_ps(b1[2].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[2].xmm, w2), _mm_mul_ps(b3[2].xmm, w3)));
     }
-    else if (a == b)
-    {
-        outQuat = a;
+
+    // Skins vertex i. The position and normal are read before either output is written, so the outputs may be
+    // the inputs.
+    _XOINL void SkinVertex(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                           const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t i) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0, r1, r2;
+        BlendBoneRows(palette, boneStride, influences[i], r0, r1, r2);
+        __m128 p = _mm_or_ps(_mm_and_ps(positions[i].xmm, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+        if (normals) {
+            __m128 d = _mm_and_ps(normals[i].xmm, xyzMask);
+            outNormals[i].xmm = sse::AffineTransform(r0, r1, r2, d);
+        }
+        outPositions[i].xmm = sse::AffineTransform(r0, r1, r2, p);
     }
-    else
-    {
-        float halfY, alpha, beta;
-        float u, f1, f2a, f2b;
-        float ratio1, ratio2;
-        float halfSecHalfTheta, versHalfTheta;
-        float sqNotU, sqU;
+#endif
 
-        Vector4 * va = (Vector4*)&a;
-        Vector4 * vb = (Vector4*)&b;
+    _XOSRCINL void SkinVertices(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        for (size_t i = 0; i < n; ++i) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 r[3];
+            for (int k = 0; k < 3; ++k) {
+                r[k] = palette[influence.bones[0] * boneStride + k] * influence.weights[0] +
+                       palette[influence.bones[1] * boneStride + k] * influence.weights[1] +
+                       palette[influence.bones[2] * boneStride + k] * influence.weights[2] +
+                       palette[influence.bones[3] * boneStride + k] * influence.weights[3];
+            }
+            Matrix3x4 m(r[0], r[1], r[2]);
+            if (normals) {
+                outNormals[i] = m.TransformDirection(normals[i]);
+            }
+            outPositions[i] = m.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
 
-        float cosTheta = ((*va) * (*vb)).Sum();
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row k of bones a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX __m256 BoneRowPair(const Vector4* a, const Vector4* b, int k) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(a[k].xmm), b[k].xmm, 1);
+    }
 
-        // As usual in all slerp implementations, we fold theta.
-        alpha = cosTheta >= 0 ? 1.0f : -1.0f;
-        halfY = 1.0f + alpha * cosTheta;
+    // BlendBoneRows for vertices a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX void BlendBoneRowsPair(const Vector4* palette, size_t boneStride, const Skinning::Influences& a, const Skinning::Influences& b,
+                                                 __m256& r0, __m256& r1, __m256& r2) {
+        const Vector4* a0 = palette + a.bones[0] * boneStride;
+        const Vector4* a1 = palette + a.bones[1] * boneStride;
+        const Vector4* a2 = palette + a.bones[2] * boneStride;
+        const Vector4* a3 = palette + a.bones[3] * boneStride;
+        const Vector4* b0 = palette + b.bones[0] * boneStride;
+        const Vector4* b1 = palette + b.bones[1] * boneStride;
+        const Vector4* b2 = palette + b.bones[2] * boneStride;
+        const Vector4* b3 = palette + b.bones[3] * boneStride;
+        __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a.weights)), _mm_loadu_ps(b.weights), 1);
+        __m256 w0 = _mm256_permute_ps(w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 w1 = _mm256_permute_ps(w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 w2 = _mm256_permute_ps(w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w3 = _mm256_permute_ps(w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 0), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 0), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 0), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 0), w3)));
+        r1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 1), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 1), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 1), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 1), w3)));
+        r2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 2), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 2), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 2), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 2), w3)));
+    }
 
-        // Here we bisect the interval, so we need to fold t as well.
-        f2b = t - 0.5f;
-        u = f2b >= 0 ? f2b : -f2b;
-        f2a = u - f2b;
-        f2b += u;
-        u += u;
-        f1 = 1.0f - u;
+    // sse::AffineTransform, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 AffineTransformPair(__m256 r0, __m256 r1, __m256 r2, __m256 v) {
+        __m256 t[4] = { _mm256_mul_ps(r0, v), _mm256_mul_ps(r1, v), _mm256_mul_ps(r2, v), _mm256_setzero_ps() };
+        TransposeLanes4x4(t);
+        return _mm256_add_ps(_mm256_add_ps(t[0], t[1]), _mm256_add_ps(t[2], t[3]));
+    }
 
-        // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
-        halfSecHalfTheta = 1.09f - (0.476537f - 0.0903321f * halfY) * halfY;
-        halfSecHalfTheta *= 1.5f - halfY * halfSecHalfTheta * halfSecHalfTheta;
-        versHalfTheta = 1.0f - halfY * halfSecHalfTheta;
+    // Two vertices per pass, which are next to each other in each array, so their positions and normals are one
+    // load and store each.
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesAVX(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                                  const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        const __m256 one = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256 r0, r1, r2;
+            BlendBoneRowsPair(palette, boneStride, influences[i], influences[i + 1], r0, r1, r2);
+            // w of each position is replaced with 1, and of each normal with 0.
+            __m256 p = _mm256_blend_ps(_mm256_loadu_ps(positions[i].f), one, 0x88);
+            if (normals) {
+                __m256 d = _mm256_blend_ps(_mm256_loadu_ps(normals[i].f), _mm256_setzero_ps(), 0x88);
+                _mm256_storeu_ps(outNormals[i].f, AffineTransformPair(r0, r1, r2, d));
+            }
+            _mm256_storeu_ps(outPositions[i].f, AffineTransformPair(r0, r1, r2, p));
+        }
+        if (i < n) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
 
-        // Evaluate series expansions of the coefficients.
-        sqNotU = f1 * f1;
-        ratio2 = 0.0000440917108f * versHalfTheta;
-        ratio1 = -0.00158730159f + (sqNotU - 16.0f) * ratio2;
-        ratio1 = 0.0333333333f + ratio1 * (sqNotU - 9.0f) * versHalfTheta;
-        ratio1 = -0.333333333f + ratio1 * (sqNotU - 4.0f) * versHalfTheta;
-        ratio1 = 1.0f + ratio1 * (sqNotU - 1.0f) * versHalfTheta;
+namespace xo_internal
+{
+    // Vertices are handed to threads this many at a time.
+    _XOSRCINL size_t SkinningChunkSize() {
+        return 4096;
+    }
 
-        sqU = u * u;
-        ratio2 = -0.00158730159f + (sqU - 16.0f) * ratio2;
-        ratio2 = 0.0333333333f + ratio2 * (sqU - 9.0f) * versHalfTheta;
-        ratio2 = -0.333333333f + ratio2 * (sqU - 4.0f) * versHalfTheta;
-        ratio2 = 1.0f + ratio2 * (sqU - 1.0f) * versHalfTheta;
+    // The bones, as rows of matrices boneStride apart, or as dual quaternions when dualQuaternions isn't null.
+    struct SkinPalette {
+        const Vector4* matrices;
+        size_t boneStride;
+        const DualQuaternion* dualQuaternions;
+    };
+
+    _XOSRCINL void SkinRange(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                             const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t begin, size_t end) {
+        if (begin >= end) {
+            return;
+        }
+        const Vector3* rangeNormals = normals ? normals + begin : nullptr;
+        Vector3* rangeOutNormals = normals ? outNormals + begin : nullptr;
+#if defined(XO_SSE2)
+        const DispatchKernels& kernels = GetDispatchKernels();
+        if (palette.dualQuaternions) {
+            kernels.skinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            kernels.skinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#else
+        if (palette.dualQuaternions) {
+            SkinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            SkinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#endif
+    }
 
-        // Perform the bisection and resolve the folding done earlier.
-        f1 *= ratio1 * halfSecHalfTheta;
-        f2a *= ratio2;
-        f2b *= ratio2;
-        alpha *= f1 + f2a;
-        beta = f1 + f2b;
+    _XOSRCINL void Skin(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                        const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+        // No more threads than there are cores, or than there are chunks.
+        const size_t chunk = SkinningChunkSize();
+        const size_t chunks = (n + chunk - 1) / chunk;
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores && threadCount > cores) {
+            threadCount = cores;
+        }
+        if (threadCount > chunks) {
+            threadCount = (unsigned)chunks;
+        }
 
-        // Apply final coefficients to a and b as usual.
-        float w = alpha * a.w + beta * b.w;
-        float x = alpha * a.x + beta * b.x;
-        float y = alpha * a.y + beta * b.y;
-        float z = alpha * a.z + beta * b.z;
+        if (threadCount <= 1) {
+            SkinRange(palette, influences, positions, normals, outPositions, outNormals, 0, n);
+            return;
+        }
 
-        // This final adjustment to the quaternion's length corrects for
-        // any small constraint error in the inputs q1 and q2 But as you
-        // can see, it comes at the cost of 9 additional multiplication
-        // operations. If this error-correcting feature is not required,
-        // the following code may be removed.
-        f1 = 1.5f - 0.5f * (w * w + x * x + y * y + z * z);
-        _XO_ASSIGN_QUAT_Q(outQuat, w * f1, x * f1, y * f1, z * f1);
+        // Each thread takes the next chunk until there are none left, so a thread that gets descheduled holds up
+        // one chunk rather than a whole share of the arrays.
+        std::atomic<size_t> next(0);
+        auto run = [&]() {
+            for (size_t begin = next.fetch_add(chunk, std::memory_order_relaxed); begin < n; begin = next.fetch_add(chunk, std::memory_order_relaxed)) {
+                SkinRange(palette, influences, positions, normals, outPositions, outNormals, begin, std::min(n, begin + chunk));
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run);
+        }
+        run();
+        for (auto& worker : workers) {
+            worker.join();
+        }
     }
 }
 
-void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
-{
-    Vector4& vq = (Vector4&)outQuat;
-    const Vector4& va = a;
-    const Vector4& vb = b;
-    // Todo: give the vectors the same static 'outQuat' type interface, then just use the Vector4::Lerp for this lerp
-    vq = va + (vb - va) * t;
+_XOSRCINL void Skinning::Skin(const Matrix3x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 3, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const Matrix4x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 4, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const DualQuaternion* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { nullptr, 0, palette };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
 }
 
 
@@ -1072,29 +4540,33 @@ void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quatern
 #if defined(XO_SSE)
 namespace sse {
 
-    volatile _XOTLS unsigned LastKnownControlWord = 0;
+    // A function static so that a header only build keeps one per thread, rather than one per translation unit.
+    _XOSRCINL volatile unsigned& LastKnownControlWord() {
+        static _XOTLS volatile unsigned controlWord = 0;
+        return controlWord;
+    }
 
-    void UpdateControlWord() {
-        LastKnownControlWord = _mm_getcsr();
+    _XOSRCINL void UpdateControlWord() {
+        LastKnownControlWord() = _mm_getcsr();
     }
 
-    void SetControlWord(unsigned control) {
-        _mm_setcsr(LastKnownControlWord = control);
+    _XOSRCINL void SetControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() = control);
     }
 
-    void SetControlWordAddative(unsigned control) {
-        _mm_setcsr(LastKnownControlWord |= control);
+    _XOSRCINL void SetControlWordAddative(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() |= control);
     }
 
-    void RemoveControlWord(unsigned control) {
-        _mm_setcsr(LastKnownControlWord &= ~control);
+    _XOSRCINL void RemoveControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() &= ~control);
     }
 
-    bool HasControlFlagBeenSet(unsigned flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasControlFlagBeenSet(unsigned flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        if((LastKnownControlWord & flags) == flags) {
+        if((LastKnownControlWord() & flags) == flags) {
             if(thenFlush) {
                 RemoveControlWord(flags);
             }
@@ -1103,35 +4575,35 @@ namespace sse {
         return false;
     }
 
-    bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet((unsigned)flags, withUpdate, thenFlush);
     }
 
-    bool HasInvalidOperationExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasInvalidOperationExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::InvalidOperation, withUpdate, thenFlush);
     }
 
-    bool HasDenormalExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasDenormalExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Denormal, withUpdate, thenFlush);
     }
 
-    bool HasDivideByZeroExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasDivideByZeroExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::DivideByZero, withUpdate, thenFlush);
     }
 
-    bool HasOverflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasOverflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Overflow, withUpdate, thenFlush);
     }
 
-    bool HasUnderflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasUnderflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Underflow, withUpdate, thenFlush);
     }
 
-    bool HasPrecisionExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasPrecisionExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Precision, withUpdate, thenFlush);
     }
 
-    void SetControlMask(unsigned mask, bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetControlMask(unsigned mask, bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1143,46 +4615,46 @@ namespace sse {
         }
     }
 
-    void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate/*= false*/) {
         SetControlMask((unsigned)mask, value, withUpdate);
     }
 
-    bool GetControlMask(unsigned mask, bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetControlMask(unsigned mask, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & mask) == mask;
+        return (LastKnownControlWord() & mask) == mask;
     }
 
-    bool GetControlMask(mxcsr::Masks mask, bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetControlMask(mxcsr::Masks mask, bool withUpdate/*= false*/) {
         return GetControlMask((unsigned)mask, withUpdate);
     }
 
-    void SetInvalidOperationExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetInvalidOperationExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::InvalidOperation, value, withUpdate);
     }
 
-    void SetDenormalExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDenormalExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Denormal, value, withUpdate);
     }
 
-    void SetDivideByZeroExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDivideByZeroExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::DivideByZero, value, withUpdate);
     }
 
-    void SetOverflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetOverflowExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Overflow, value, withUpdate);
     }
 
-    void SetUnderflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetUnderflowExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Underflow, value, withUpdate);
     }
 
-    void SetPrecisionExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetPrecisionExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Precision, value, withUpdate);
     }
 
-    void ThrowAllExceptions(bool withUpdate/*= false*/) {
+    _XOSRCINL void ThrowAllExceptions(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1194,7 +4666,7 @@ namespace sse {
         SetPrecisionExceptionMask(false);
     }
 
-    void ThrowNoExceptions(bool withUpdate/*= false*/) {
+    _XOSRCINL void ThrowNoExceptions(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1206,38 +4678,38 @@ namespace sse {
         SetPrecisionExceptionMask(true);
     }
 
-    bool GetInvalidOperationExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetInvalidOperationExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::InvalidOperation, withUpdate);
     }
 
-    bool GetDenormalExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetDenormalExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Denormal, withUpdate);
     }
 
-    bool GetDivideByZeroExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetDivideByZeroExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::DivideByZero, withUpdate);
     }
 
-    bool GetOverflowExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetOverflowExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Overflow, withUpdate);
     }
 
-    bool GetUnderflowExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetUnderflowExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Underflow, withUpdate);
     }
 
-    bool GetPrecisionExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetPrecisionExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Precision, withUpdate);
     }
 
-    mxcsr::Rounding GetRoundingMode(bool withUpdate/*= false*/) {
+    _XOSRCINL mxcsr::Rounding GetRoundingMode(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (mxcsr::Rounding)(LastKnownControlWord & (unsigned)mxcsr::Rounding::Bits);
+        return (mxcsr::Rounding)(LastKnownControlWord() & (unsigned)mxcsr::Rounding::Bits);
     }
 
-    void SetRoundingMode(unsigned mode, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetRoundingMode(unsigned mode, bool withUpdate/*= false*/) {
         mode &= (unsigned)mxcsr::Rounding::Bits;
         if(withUpdate) {
             UpdateControlWord();
@@ -1245,18 +4717,18 @@ namespace sse {
         SetControlWordAddative(mode);
     }
 
-    void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate/*= false*/) {
         SetRoundingMode((unsigned)mode, withUpdate);
     }
 
-    bool HasDenormalsAreZeroSet(bool withUpdate/*= false*/) {
+    _XOSRCINL bool HasDenormalsAreZeroSet(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & (unsigned)mxcsr::DAZ::DenormalsAreZero) == (unsigned)mxcsr::DAZ::DenormalsAreZero;
+        return (LastKnownControlWord() & (unsigned)mxcsr::DAZ::DenormalsAreZero) == (unsigned)mxcsr::DAZ::DenormalsAreZero;
     }
 
-    void SetDenormalsAreZero(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDenormalsAreZero(bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1268,14 +4740,14 @@ namespace sse {
         }
     }
 
-    bool HasFlushToZeroSet(bool withUpdate/*= false*/) {
+    _XOSRCINL bool HasFlushToZeroSet(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & (unsigned)mxcsr::FZ::FlushToZero) == (unsigned)mxcsr::FZ::FlushToZero;
+        return (LastKnownControlWord() & (unsigned)mxcsr::FZ::FlushToZero) == (unsigned)mxcsr::FZ::FlushToZero;
     }
 
-    void SetFlushToZero(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetFlushToZero(bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1287,7 +4759,7 @@ namespace sse {
         }
     }
 
-    void GetAllMXCSRInfo(std::ostream& os, bool withUpdate/*= false*/) {
+    _XOSRCINL void GetAllMXCSRInfo(std::ostream& os, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -1307,83 +4779,331 @@ namespace sse {
                 os << "Zero";
                 break;
         }
-        os << "\n";
-        os << "MXCSR masks:\n";
-        os << "\t" << "InvalidOperationException: " << GetInvalidOperationExceptionMask() << "\n"; 
-        os << "\t" << "DenormalException: " << GetDenormalExceptionMask() << "\n"; 
-        os << "\t" << "DivideByZeroException: " << GetDivideByZeroExceptionMask() << "\n"; 
-        os << "\t" << "OverflowException: " << GetOverflowExceptionMask() << "\n"; 
-        os << "\t" << "UnderflowException: " << GetUnderflowExceptionMask() << "\n"; 
-        os << "\t" << "PrecisionException: " << GetPrecisionExceptionMask() << "\n"; 
-        os << "\t" << "DenormalsAreZero: " << HasDenormalsAreZeroSet() << "\n";
-        os << "\t" << "FlushToZero: " << HasFlushToZeroSet() << "\n";
-        os << "MXCSR flags:\n";
-        os << "\t" << "InvalidOperationException: " << HasInvalidOperationExceptionOccured() << "\n"; 
-        os << "\t" << "DenormalException: " << HasDenormalExceptionOccured() << "\n"; 
-        os << "\t" << "DivideByZeroException: " << HasDivideByZeroExceptionOccured() << "\n"; 
-        os << "\t" << "OverflowException: " << HasOverflowExceptionOccured() << "\n"; 
-        os << "\t" << "UnderflowException: " << HasUnderflowExceptionOccured() << "\n"; 
-        os << "\t" << "PrecisionException: " << HasPrecisionExceptionOccured() << "\n";
+        os << "\n";
+        os << "MXCSR masks:\n";
+        os << "\t" << "InvalidOperationException: " << GetInvalidOperationExceptionMask() << "\n"; 
+        os << "\t" << "DenormalException: " << GetDenormalExceptionMask() << "\n"; 
+        os << "\t" << "DivideByZeroException: " << GetDivideByZeroExceptionMask() << "\n"; 
+        os << "\t" << "OverflowException: " << GetOverflowExceptionMask() << "\n"; 
+        os << "\t" << "UnderflowException: " << GetUnderflowExceptionMask() << "\n"; 
+        os << "\t" << "PrecisionException: " << GetPrecisionExceptionMask() << "\n"; 
+        os << "\t" << "DenormalsAreZero: " << HasDenormalsAreZeroSet() << "\n";
+        os << "\t" << "FlushToZero: " << HasFlushToZeroSet() << "\n";
+        os << "MXCSR flags:\n";
+        os << "\t" << "InvalidOperationException: " << HasInvalidOperationExceptionOccured() << "\n"; 
+        os << "\t" << "DenormalException: " << HasDenormalExceptionOccured() << "\n"; 
+        os << "\t" << "DivideByZeroException: " << HasDivideByZeroExceptionOccured() << "\n"; 
+        os << "\t" << "OverflowException: " << HasOverflowExceptionOccured() << "\n"; 
+        os << "\t" << "UnderflowException: " << HasUnderflowExceptionOccured() << "\n"; 
+        os << "\t" << "PrecisionException: " << HasPrecisionExceptionOccured() << "\n";
+    }
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////// Transform.cpp
+
+_XOSRCDATA const Transform Transform::Identity;
+
+_XOSRCINL Transform::Transform() :
+    position(0.0f, 0.0f, 0.0f),
+    rotation(0.0f, 0.0f, 0.0f, 1.0f),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(0)
+{
+    // Both matrices of the identity are the identity, so they're written here rather than composed, and
+    // Transform::Identity can be read from any thread without updating anything.
+    matrix.r[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    matrix.r[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    matrix.r[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    inverseMatrix = matrix;
+}
+
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation) :
+    position(position),
+    rotation(rotation),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale) :
+    position(position),
+    rotation(rotation),
+    scale(scale),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL Transform::Transform(const Matrix3x4& m) :
+    position(m.GetTranslation()),
+    rotation(m),
+    scale(m.GetColumn(0).Magnitude(), m.GetColumn(1).Magnitude(), m.GetColumn(2).Magnitude()),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL void Transform::UpdateMatrix() const {
+    ComposeMatrix(position, rotation, scale, matrix);
+    dirty &= ~DirtyMatrix;
+}
+
+_XOSRCINL void Transform::UpdateInverseMatrix() const {
+    ComposeInverseMatrix(position, rotation, scale, inverseMatrix);
+    dirty &= ~DirtyInverse;
+}
+
+_XOSRCINL Vector3 Transform::TransformPoint(const Vector3& v) const {
+    return rotation.Rotate(v * scale) + position;
+}
+
+_XOSRCINL Vector3 Transform::TransformDirection(const Vector3& v) const {
+    return rotation.Rotate(v * scale);
+}
+
+_XOSRCINL Vector3 Transform::InverseTransformPoint(const Vector3& v) const {
+    // Vector3 division may use the approximate reciprocal, which would leave the result off in the fourth digit.
+    Vector3 inverseScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    return rotation.Conjugate().Rotate(v - position) * inverseScale;
+}
+
+_XOSRCINL Transform& Transform::MakeInverse() {
+    rotation.MakeConjugate();
+    scale.Set(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    position = -(rotation.Rotate(position) * scale);
+    dirty = DirtyAll;
+    return *this;
+}
+
+_XOSRCINL Transform Transform::Inverse() const {
+    return Transform(*this).MakeInverse();
+}
+
+_XOSRCINL void Transform::Combine(const Transform& parent, const Transform& child, Transform& outTransform) {
+    // outTransform may be either input, so nothing is written until everything is read.
+    Vector3 position = parent.TransformPoint(child.position);
+    Quaternion rotation = parent.rotation * child.rotation;
+    Vector3 scale = parent.scale * child.scale;
+    outTransform.Set(position, rotation, scale);
+}
+
+_XOSRCINL void Transform::ComposeMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    // The rotation of Matrix3x4(q), with each column multiplied by its scale.
+    outMatrix.r[0].Set((1.0f - (yy + zz)) * scale.x, (xy - wz) * scale.y,          (xz + wy) * scale.z,          position.x);
+    outMatrix.r[1].Set((xy + wz) * scale.x,          (1.0f - (xx + zz)) * scale.y, (yz - wx) * scale.z,          position.y);
+    outMatrix.r[2].Set((xz - wy) * scale.x,          (yz + wx) * scale.y,          (1.0f - (xx + yy)) * scale.z, position.z);
+}
+
+_XOSRCINL void Transform::ComposeInverseMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+    float sx = 1.0f / scale.x, sy = 1.0f / scale.y, sz = 1.0f / scale.z;
+
+    // The rows are the columns of the rotation, each divided by its scale.
+    Vector3 r0((1.0f - (yy + zz)) * sx, (xy + wz) * sx,          (xz - wy) * sx);
+    Vector3 r1((xy - wz) * sy,          (1.0f - (xx + zz)) * sy, (yz + wx) * sy);
+    Vector3 r2((xz + wy) * sz,          (yz - wx) * sz,          (1.0f - (xx + yy)) * sz);
+    outMatrix.r[0].Set(r0.x, r0.y, r0.z, -Vector3::Dot(r0, position));
+    outMatrix.r[1].Set(r1.x, r1.y, r1.z, -Vector3::Dot(r1, position));
+    outMatrix.r[2].Set(r2.x, r2.y, r2.z, -Vector3::Dot(r2, position));
+}
+
+_XOSRCINL Transform Transform::Combine(const Transform& parent, const Transform& child) {
+    Transform t;
+    Combine(parent, child, t);
+    return t;
+}
+
+
+////////////////////////////////////////////////////////////////////////// Trig.cpp
+
+namespace xo_internal
+{
+    // The baseline kernel behind the array versions. s or c may be null when that output isn't wanted.
+    // With SSE2 it goes four at a time, then the remainder is copied through a partial register so the tail gets 
+    // the exact same results as the rest.
+    _XOSRCINL void SinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+#if defined(XO_SSE2)
+        for (; i + 4 <= n; i += 4) {
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            _XOSIMDALIGN float t[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            _XOSIMDALIGN float ts[4];
+            _XOSIMDALIGN float tc[4];
+            size_t remaining = n - i;
+            for (size_t k = 0; k < remaining; ++k) {
+                t[k] = f[i + k];
+            }
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_load_ps(t), vs, vc, fast);
+            _mm_store_ps(ts, vs);
+            _mm_store_ps(tc, vc);
+            for (size_t k = 0; k < remaining; ++k) {
+                if (s) {
+                    s[i + k] = ts[k];
+                }
+                if (c) {
+                    c[i + k] = tc[k];
+                }
+            }
+        }
+#else
+        for (; i < n; ++i) {
+            float vs, vc;
+            if (fast) {
+                FastSinCos(f[i], vs, vc);
+            }
+            else {
+                SinCos(f[i], vs, vc);
+            }
+            if (s) {
+                s[i] = vs;
+            }
+            if (c) {
+                c[i] = vc;
+            }
+        }
+#endif
+    }
+
+#if defined(_XO_KERNELS_AVX2)
+    // Eight at a time, with a masked load and store for the last few.
+    _XOSRCINL _XO_TARGET_AVX2 void SinCosArrayAVX2(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm256_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm256_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            __m256i mask = TailMask(n - i);
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_maskload_ps(f + i, mask), vs, vc, fast);
+            if (s) {
+                _mm256_maskstore_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm256_maskstore_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
+    }
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+    // Sixteen at a time. The last few use a mask register, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void SinCosArrayAVX512(const float* f, float* s, float* c, size_t n, bool fast) {
+        for (size_t i = 0; i < n; i += 16) {
+            __mmask16 mask = TailMask16(n - i);
+            __m512 vs, vc;
+            sse::SinCosKernel(_mm512_maskz_loadu_ps(mask, f + i), vs, vc, fast);
+            if (s) {
+                _mm512_mask_storeu_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm512_mask_storeu_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
     }
+#endif
 }
+
+namespace xo_internal
+{
+    _XOSRCINL void DispatchSinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+#if defined(XO_SSE2)
+        xo_internal::GetDispatchKernels().sinCosArray(f, s, c, n, fast);
+#else
+        xo_internal::SinCosArray(f, s, c, n, fast);
 #endif
+    }
+}
+
+_XOSRCINL void Sin(const float* f, float* s, size_t n)                    { xo_internal::DispatchSinCosArray(f, s, nullptr, n, false); }
+_XOSRCINL void Cos(const float* f, float* c, size_t n)                    { xo_internal::DispatchSinCosArray(f, nullptr, c, n, false); }
+_XOSRCINL void SinCos(const float* f, float* s, float* c, size_t n)       { xo_internal::DispatchSinCosArray(f, s, c, n, false); }
+_XOSRCINL void FastSin(const float* f, float* s, size_t n)                { xo_internal::DispatchSinCosArray(f, s, nullptr, n, true); }
+_XOSRCINL void FastCos(const float* f, float* c, size_t n)                { xo_internal::DispatchSinCosArray(f, nullptr, c, n, true); }
+_XOSRCINL void FastSinCos(const float* f, float* s, float* c, size_t n)   { xo_internal::DispatchSinCosArray(f, s, c, n, true); }
 
 
 ////////////////////////////////////////////////////////////////////////// Vector2.cpp
 
 #if defined(_XONOCONSTEXPR)
-const float Vector2::Epsilon = FloatEpsilon * 2.0f;
+_XOSRCDATA const float Vector2::Epsilon = FloatEpsilon * 2.0f;
 #endif
 
-const Vector2 Vector2::UnitX(1.0f, 0.0f);
-const Vector2 Vector2::UnitY(0.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::UnitX(1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::UnitY(0.0f, 1.0f);
 
-const Vector2 Vector2::Up(0.0f, 1.0f);
-const Vector2 Vector2::Down(0.0f, -1.0f);
-const Vector2 Vector2::Left(-1.0f, 0.0f);
-const Vector2 Vector2::Right(1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::Up(0.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Down(0.0f, -1.0f);
+_XOSRCDATA const Vector2 Vector2::Left(-1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::Right(1.0f, 0.0f);
 
-const Vector2 Vector2::One(1.0f, 1.0f);
-const Vector2 Vector2::Zero(0.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::One(1.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Zero(0.0f, 0.0f);
 
-Vector2::Vector2(float v) : x(v), y(v) {
+_XOSRCINL Vector2::Vector2(float v) : x(v), y(v) {
 }
 
-Vector2::Vector2(float x, float y) : x(x), y(y) {
+_XOSRCINL Vector2::Vector2(float x, float y) : x(x), y(y) {
 }
 
-Vector2::Vector2(const Vector2& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const Vector2& v) : x(v.x), y(v.y) {
 }
 
-Vector2::Vector2(const class Vector3& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const class Vector3& v) : x(v.x), y(v.y) {
 }
 
-Vector2::Vector2(const class Vector4& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const class Vector4& v) : x(v.x), y(v.y) {
 }
 
-Vector2& Vector2::Set(float x, float y) {
+_XOSRCINL Vector2& Vector2::Set(float x, float y) {
     this->x = x;
     this->y = y;
     return *this;
 }
 
-Vector2& Vector2::Set(float v) {
+_XOSRCINL Vector2& Vector2::Set(float v) {
     x = v;
     y = v;
     return *this;
 }
 
-Vector2& Vector2::Set(const Vector2& v) {
+_XOSRCINL Vector2& Vector2::Set(const Vector2& v) {
     x = v.x;
     y = v.y;
     return *this;
 }
 
-void Vector2::Get(float& x, float& y) const {
+_XOSRCINL void Vector2::Get(float& x, float& y) const {
     x = this->x;
     y = this->y;
 }
-void Vector2::Get(float* f) const {
+_XOSRCINL void Vector2::Get(float* f) const {
     f[0] = this->x;
     f[1] = this->y;
 }
@@ -1395,55 +5115,55 @@ void Vector2::Get(float* f) const {
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Vector3::Epsilon = sse::SSEFloatEpsilon * 3.0f;
+_XOSRCDATA const float Vector3::Epsilon = sse::SSEFloatEpsilon * 3.0f;
 #   else
-const float Vector3::Epsilon = FloatEpsilon * 3.0f;
+_XOSRCDATA const float Vector3::Epsilon = FloatEpsilon * 3.0f;
 #   endif
 #endif
 
 #if defined(XO_SSE2)
-const __m128 Vector3::MASK = _mm_castsi128_ps(_mm_set_epi32(0, 0xffffffff, 0xffffffff, 0xffffffff));
+_XOSRCDATA const __m128 Vector3::MASK = _mm_castsi128_ps(_mm_set_epi32(0, 0xffffffff, 0xffffffff, 0xffffffff));
 #elif defined(XO_SSE)
-const __m128 Vector3::MASK = {-1, -1, -1, 0};
+_XOSRCDATA const __m128 Vector3::MASK = {-1, -1, -1, 0};
 #endif
 
-const Vector3 Vector3::Origin(0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Origin(0.0f, 0.0f, 0.0f);
 
-const Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
-const Vector3 Vector3::UnitY(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::UnitZ(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitY(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitZ(0.0f, 0.0f, 1.0f);
 
-const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
-const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
 
 #if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Up(0.0f, 0.0f, 1.0f);
-const Vector3 Vector3::Down(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, 0.0f, -1.0f);
 #elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
 #endif
 
 #if defined(XO_SPACE_LEFTHAND)
 #   if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Forward(0.0f, -1.0f, 0.0f);
-const Vector3 Vector3::Backward(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 1.0f, 0.0f);
 #   elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
-const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
 #   endif
 #elif defined(XO_SPACE_RIGHTHAND)
 #   if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Forward(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::Backward(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, -1.0f, 0.0f);
 #   elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Forward(0.0f, 0.0f, -1.0f);
-const Vector3 Vector3::Backward(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, 1.0f);
 #   endif
 #endif
 
-const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
-const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 
 #if defined(XO_SSE)
 
@@ -1465,7 +5185,7 @@ const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 
 #endif
 
-Vector3::Vector3(float f) :
+_XOSRCINL Vector3::Vector3(float f) :
 #if defined(XO_SSE)
     xmm(_mm_set1_ps(f))
 #elif defined(XO_NEON)
@@ -1476,7 +5196,7 @@ Vector3::Vector3(float f) :
 {
 }
 
-Vector3::Vector3(float x, float y, float z) :
+_XOSRCINL Vector3::Vector3(float x, float y, float z) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, z, y, x))
 #else
@@ -1485,7 +5205,7 @@ Vector3::Vector3(float x, float y, float z) :
 {
 }
 
-Vector3::Vector3(const Vector3& vec) :
+_XOSRCINL Vector3::Vector3(const Vector3& vec) :
 #if defined(XO_SSE)
     xmm(vec)
 #else
@@ -1495,13 +5215,13 @@ Vector3::Vector3(const Vector3& vec) :
 }
 
 #if defined(XO_SSE)
-Vector3::Vector3(const __m128& vec) : 
+_XOSRCINL Vector3::Vector3(const __m128& vec) : 
     xmm(vec)
 {
 }
 #endif
 
-Vector3::Vector3(const class Vector2& v) :
+_XOSRCINL Vector3::Vector3(const class Vector2& v) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, 0.0f, v.y, v.x))
 #else
@@ -1510,7 +5230,7 @@ Vector3::Vector3(const class Vector2& v) :
 {
 }
 
-Vector3::Vector3(const class Vector4& v) :
+_XOSRCINL Vector3::Vector3(const class Vector4& v) :
 #if defined(XO_SSE)
     xmm(v.xmm)
 #else
@@ -1519,7 +5239,7 @@ Vector3::Vector3(const class Vector4& v) :
 {
 }
 
-Vector3& Vector3::Set(float x, float y, float z) {
+_XOSRCINL Vector3& Vector3::Set(float x, float y, float z) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(0.0f, z, y, x);
 #else
@@ -1530,7 +5250,7 @@ Vector3& Vector3::Set(float x, float y, float z) {
     return *this;
 }
 
-Vector3& Vector3::Set(float f) {
+_XOSRCINL Vector3& Vector3::Set(float f) {
 #if defined(XO_SSE)
     xmm = _mm_set1_ps(f);
 #else
@@ -1541,7 +5261,7 @@ Vector3& Vector3::Set(float f) {
     return *this;
 }
 
-Vector3& Vector3::Set(const Vector3& vec) {
+_XOSRCINL Vector3& Vector3::Set(const Vector3& vec) {
 #if defined(XO_SSE)
     xmm = vec.xmm;
 #else
@@ -1553,19 +5273,19 @@ Vector3& Vector3::Set(const Vector3& vec) {
 }
 
 #if defined(XO_SSE)
-Vector3& Vector3::Set(const __m128& vec) {
+_XOSRCINL Vector3& Vector3::Set(const __m128& vec) {
     xmm = vec;
     return *this;
 }
 #endif
 
-void Vector3::Get(float& x, float& y, float &z) const {
+_XOSRCINL void Vector3::Get(float& x, float& y, float &z) const {
     x = this->x;
     y = this->y;
     z = this->z;
 }
 
-void Vector3::Get(float* f) const {
+_XOSRCINL void Vector3::Get(float* f) const {
 #if defined(XO_SSE)
     _mm_store_ps(f, xmm);
 #elif defined(XO_NEON)
@@ -1577,7 +5297,7 @@ void Vector3::Get(float* f) const {
 #endif
 }
 
-Vector3 Vector3::ZYX() const {
+_XOSRCINL Vector3 Vector3::ZYX() const {
 #if defined(XO_SSE)
     // todo: constexpr shuffle int
     return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_W, IDX_X, IDX_Y, IDX_Z)));
@@ -1586,7 +5306,7 @@ Vector3 Vector3::ZYX() const {
 #endif
 }
 
-float Vector3::Sum() const {
+_XOSRCINL float Vector3::Sum() const {
 #if defined(XO_SSE3)
     __m128 x = _mm_and_ps(xmm, MASK);
     x = _mm_hadd_ps(x, x);
@@ -1597,26 +5317,212 @@ float Vector3::Sum() const {
 #endif
 }
 
-Vector3& Vector3::Normalize() {
+_XOSRCINL Vector3& Vector3::Normalize() {
     return (*this) /= Magnitude();
 }
 
-Vector3& Vector3::NormalizeSafe() {
+_XOSRCINL Vector3& Vector3::NormalizeSafe() {
     float magnitude = MagnitudeSquared();
     if (magnitude == 0.0f)
         return *this;
     return *this /= Sqrt(magnitude);
 }
  
-float Vector3::Dot(const Vector3& a, const Vector3& b) {
+_XOSRCINL float Vector3::Dot(const Vector3& a, const Vector3& b) {
 #if defined(XO_SSE4_1)
     return _mm_cvtss_f32(_mm_dp_ps(a, b, 0x7f));
 #else
     return (a * b).Sum();
 #endif
 }
+
+namespace xo_internal
+{
+    _XOSRCINL void DotVector3Array(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = Vector3::Dot(a[i], b[i]);
+        }
+    }
+
+    _XOSRCINL void NormalizeVector3Array(const Vector3* in, Vector3* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = in[i].Normalized();
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // x, y and z of two vectors, with w cleared.
+    _XOINL _XO_TARGET_AVX __m256 MaskXYZPair(__m256 v) {
+        return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0)));
+    }
+
+    // p0 to p3 hold the products of eight vectors, two per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX __m256 SumXYZEight(__m256 p0, __m256 p1, __m256 p2, __m256 p3) {
+        // Each 128 bit lane sums on its own, the low lanes holding vectors 0, 2, 4 and 6 and the high lanes 1, 3, 5 
+        // and 7. Interleaving the halves puts them back in order.
+        __m256 h = _mm256_hadd_ps(_mm256_hadd_ps(MaskXYZPair(p0), MaskXYZPair(p1)), _mm256_hadd_ps(MaskXYZPair(p2), MaskXYZPair(p3)));
+        __m128 lo = _mm256_castps256_ps128(h);
+        __m128 hi = _mm256_extractf128_ps(h, 1);
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(lo, hi)), _mm_unpackhi_ps(lo, hi), 1);
+    }
+
+    // Two vectors divided by their magnitudes. The reciprocal square root is refined with a Newton-Raphson step.
+    _XOINL _XO_TARGET_AVX __m256 NormalizePair(__m256 v) {
+        __m256 sq = MaskXYZPair(_mm256_mul_ps(v, v));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m256 r = _mm256_rsqrt_ps(sq);
+        r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), sq), _mm256_mul_ps(r, r))));
+        return _mm256_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Eight vectors per pass, with masked loads and stores for the last few.
+    _XOSRCINL _XO_TARGET_AVX void DotVector3ArrayAVX(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(out + i, SumXYZEight(
+                _mm256_mul_ps(_mm256_loadu_ps(a[i].f), _mm256_loadu_ps(b[i].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+2].f), _mm256_loadu_ps(b[i+2].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+4].f), _mm256_loadu_ps(b[i+4].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+6].f), _mm256_loadu_ps(b[i+6].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m256 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 2 ? rest - k * 2 : 0;
+                __m256i mask = TailMask((count < 2 ? count : 2) * 4);
+                p[k] = _mm256_mul_ps(_mm256_maskload_ps(a[i].f + k * 8, mask), _mm256_maskload_ps(b[i].f + k * 8, mask));
+            }
+            _mm256_maskstore_ps(out + i, TailMask(rest), SumXYZEight(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void NormalizeVector3ArrayAVX(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, NormalizePair(v0));
+            _mm256_storeu_ps(out[i+2].f, NormalizePair(v1));
+            _mm256_storeu_ps(out[i+4].f, NormalizePair(v2));
+            _mm256_storeu_ps(out[i+6].f, NormalizePair(v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, NormalizePair(_mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, NormalizePair(_mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // The sum of x, y and z of each of four vectors, in all four elements of its 128 bit lane. w is ignored.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZQuad(__m512 p) {
+        p = _mm512_maskz_mov_ps(0x7777, p);
+        p = _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // p0 to p3 hold the products of sixteen vectors, four per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZSixteen(__m512 p0, __m512 p1, __m512 p2, __m512 p3) {
+        __m512 t = _mm512_mask_blend_ps(0x2222, SumXYZQuad(p0), SumXYZQuad(p1));
+        t = _mm512_mask_blend_ps(0x4444, t, SumXYZQuad(p2));
+        t = _mm512_mask_blend_ps(0x8888, t, SumXYZQuad(p3));
+        // Lane j of t now holds the sums of vectors j, 4+j, 8+j and 12+j.
+        return _mm512_permutexvar_ps(_mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15), t);
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 NormalizeQuad(__m512 v) {
+        __m512 sq = SumXYZQuad(_mm512_mul_ps(v, v));
+        __m512 r = _mm512_rsqrt14_ps(sq);
+        r = _mm512_mul_ps(r, _mm512_sub_ps(_mm512_set1_ps(1.5f), _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), sq), _mm512_mul_ps(r, r))));
+        return _mm512_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Sixteen vectors per pass. The last pass masks its loads and stores, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void DotVector3ArrayAVX512(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_ps(out + i, SumXYZSixteen(
+                _mm512_mul_ps(_mm512_loadu_ps(a[i].f), _mm512_loadu_ps(b[i].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+4].f), _mm512_loadu_ps(b[i+4].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+8].f), _mm512_loadu_ps(b[i+8].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+12].f), _mm512_loadu_ps(b[i+12].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m512 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 4 ? rest - k * 4 : 0;
+                __mmask16 mask = TailMask16(count * 4);
+                p[k] = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a[i].f + k * 16), _mm512_maskz_loadu_ps(mask, b[i].f + k * 16));
+            }
+            _mm512_mask_storeu_ps(out + i, TailMask16(rest), SumXYZSixteen(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void NormalizeVector3ArrayAVX512(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, NormalizeQuad(v0));
+            _mm512_storeu_ps(out[i+4].f, NormalizeQuad(v1));
+            _mm512_storeu_ps(out[i+8].f, NormalizeQuad(v2));
+            _mm512_storeu_ps(out[i+12].f, NormalizeQuad(v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, NormalizeQuad(_mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL void Vector3::Dot(const Vector3* a, const Vector3* b, float* outDots, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().dotVector3Array(a, b, outDots, n);
+#else
+    xo_internal::DotVector3Array(a, b, outDots, n);
+#endif
+}
+
+_XOSRCINL void Vector3::Normalize(const Vector3* in, Vector3* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().normalizeVector3Array(in, out, n);
+#else
+    xo_internal::NormalizeVector3Array(in, out, n);
+#endif
+}
+
+_XOSRCINL void Vector3::Normalize(Vector3* inOut, size_t n) {
+    Normalize(inOut, inOut, n);
+}
  
-void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
+_XOSRCINL void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
 #if defined(XO_SSE)
     // todo: multi-compiler constexpr
     constexpr int m3021 = _MM_SHUFFLE(3, 0, 2, 1);
@@ -1629,78 +5535,303 @@ void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
 #endif
 }
 
-void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
+_XOSRCINL void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
     // Rodrigues' rotation formula
     // https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
     Vector3 axv;
-    float sinAng = Sin(angle);
-    float cosAng = Cos(angle);
+    float sinAng, cosAng;
+    SinCos(angle, sinAng, cosAng);
     Vector3::Cross(axis, v, axv);
     float adv = Vector3::Dot(axis, v);
     outVec.Set(v * cosAng + axv * sinAng + axis * adv * (1.0f - cosAng));
 }
 
-float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
+_XOSRCINL float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
     Vector3 cross;
     Vector3::Cross(a, b, cross);
     cross *= cross;
     return ATan2(Sqrt(cross.Sum()), Vector3::Dot(a, b));
 }
 
-void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, RandomRange(0.0f, angle*0.5f), outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+namespace xo_internal
+{
+    // A unit vector perpendicular to v, from crossing it with preferred. fallback is used when v is (nearly) parallel 
+    // to preferred.
+    _XOSRCINL Vector3 RandomBasisPerpendicular(const Vector3& v, const Vector3& preferred, const Vector3& fallback) {
+        Vector3 cross;
+        Vector3::Cross(v, preferred, cross);
+        if (cross.MagnitudeSquared() <= Vector3::Epsilon) {
+            Vector3::Cross(v, fallback, cross);
+        }
+        return cross.Normalized();
+    }
+
+#if defined(XO_SSE2)
+    // Shared loop for the array versions of the random methods. next returns the following four vectors, the last 
+    // of which may be partially stored.
+    template <typename NextFunc>
+    _XOSRCINL void FillRandomVector3s(Vector3* outVecs, size_t n, NextFunc next) {
+        Random_x4 rng(Random::ThreadEngine());
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            next(rng).Store(outVecs + i);
+        }
+        if (i < n) {
+            next(rng).StorePartial(outVecs + i, (int)(n - i));
+        }
+    }
+
+    _XOSRCINL __m128 RandomSelect(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Four directions uniform on the unit sphere. z is uniform in [-1, 1] along with an angle around z, which is 
+    // uniform over the sphere by Archimedes' hat-box theorem and unlike Marsaglia's method doesn't need to reject.
+    _XOSRCINL Vector3x4 RandomSphereDirections(Random_x4& rng) {
+        __m128 z = rng.Range(-1.0f, 1.0f);
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 r = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sse::One, _mm_mul_ps(z, z)), sse::Zero));
+        return Vector3x4(_mm_mul_ps(r, c), _mm_mul_ps(r, s), z);
+    }
+
+    // Cube root of each lane of x >= 0. Thirds the exponent through the bit pattern for an estimate within a few 
+    // percent, then refines it with three Newton steps.
+    _XOSRCINL __m128 RandomCbrt(__m128 x) {
+        const __m128 third = _mm_set1_ps(1.0f / 3.0f);
+        __m128i bits = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), third));
+        __m128 y = _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(0x2a5137a0)));
+        for (int i = 0; i < 3; ++i) {
+            y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), third);
+        }
+        return y;
+    }
+#endif
 }
 
-void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, angle*0.5f, outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, rng.Range(0.0f, angle*0.5f), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), rng.Range(0.0f, TAU), outVec);
+}
+
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, angle*0.5f, outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
 }
 
-void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
     // Marsaglia's method: https://projecteuclid.org/download/pdf_1/euclid.aoms/1177692644
+    Random& rng = Random::ThreadEngine();
     float x1, x2, x12, x22;
-    x1 = RandomRange(-1.0f, 1.0f);
-    x2 = RandomRange(-1.0f, 1.0f);
-    x12 = Square(x1);
-    x22 = Square(x1);
+    do {
+        x1 = rng.Range(-1.0f, 1.0f);
+        x2 = rng.Range(-1.0f, 1.0f);
+        x12 = Square(x1);
+        x22 = Square(x2);
+    } while (x12 + x22 >= 1.0f);
+    float s = 2.0f * Sqrt(1.0f - x12 - x22);
     outVec.Set(
-        2.0f * x1 * Sqrt(1.0f - x12 - x22),
-        2.0f * x2 * Sqrt(1.0f - x12 - x22),
+        x1 * s,
+        x2 * s,
         1.0f - (2.0f * (x12 + x22))
         );
     outVec *= radius;
 }
 
-void Vector3::RandomOnCube(float size, Vector3& outVec) {
-    switch (RandomRange(0, 5)) {
-        case 0: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),                size);         break;
-        case 1: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),               -size);         break;
-        case 2: outVec.Set(RandomRange(-size, size),                 size,          RandomRange(-size, size));  break;
-        case 3: outVec.Set(RandomRange(-size, size),                -size,          RandomRange(-size, size));  break;
-        case 4: outVec.Set(             size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-        case 5: outVec.Set(            -size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    switch (rng.Range(0, 5)) {
+        case 0: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),                size);       break;
+        case 1: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),               -size);       break;
+        case 2: outVec.Set(rng.Range(-size, size),               size,          rng.Range(-size, size));  break;
+        case 3: outVec.Set(rng.Range(-size, size),              -size,          rng.Range(-size, size));  break;
+        case 4: outVec.Set(             size,           rng.Range(-size, size), rng.Range(-size, size));  break;
+        case 5: outVec.Set(            -size,           rng.Range(-size, size), rng.Range(-size, size));  break;
     }
 }
 
-void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
-    outVec *= Sqrt(RandomRange(0.0f, 1.0f)) * radius;
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), rng.Range(0.0f, TAU), outVec);
+    outVec *= Sqrt(rng.NextFloat()) * radius;
 }
 
-void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
     outVec *= radius;
 }
 
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // rotating a perpendicular a around up by t gives a*cos(t) + b*sin(t), where b is up cross a.
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a), b4(b);
+    const __m128 r = _mm_set1_ps(radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 scale = _mm_mul_ps(_mm_sqrt_ps(rng.NextFloat()), r);
+        return a4 * Vector4(_mm_mul_ps(c, scale)) + b4 * Vector4(_mm_mul_ps(s, scale));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a * radius), b4(b * radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        return a4 * Vector4(c) + b4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Tilting forward by a toward p, then spinning it around forward by b gives:
+    // forward*cos(a) + p*sin(a)*cos(b) + q*sin(a)*sin(b), where p and q are perpendicular to forward.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    const Vector3x4 f4(forward), p4(p), q4(q);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sa, ca, sb, cb;
+        sse::SinCos(rng.Range(0.0f, halfAngle), sa, ca);
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 * Vector4(ca) + p4 * Vector4(_mm_mul_ps(sa, cb)) + q4 * Vector4(_mm_mul_ps(sa, sb));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // The same as RandomInConeRadians, with the tilt fixed at the edge of the cone.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    float sa, ca;
+    SinCos(angle * 0.5f, sa, ca);
+    const Vector3x4 f4(forward * ca), p4(p * sa), q4(q * sa);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sb, cb;
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 + p4 * Vector4(cb) + q4 * Vector4(sb);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInFanRadians(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Rodrigues' rotation formula, split into the parts scaled by 1, cos(t) and sin(t).
+    Vector3 along = up * Vector3::Dot(up, forward), side;
+    Vector3::Cross(up, forward, side);
+    const Vector3x4 along4(along), perp4(forward - along), side4(side);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(-halfAngle, halfAngle), s, c);
+        return along4 + perp4 * Vector4(c) + side4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInFanRadians(forward, up, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 x = rng.Range(-size, size);
+        __m128 y = rng.Range(-size, size);
+        __m128 z = rng.Range(-size, size);
+        return Vector3x4(x, y, z);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCube(size, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Faces are numbered as in the single vector version: 0 and 1 are +z and -z, 2 and 3 are +y and -y, 
+    // 4 and 5 are +x and -x.
+    const __m128 sizeVec = _mm_set1_ps(size);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 face = _mm_mul_ps(rng.NextFloat(), _mm_set1_ps(6.0f));
+        __m128i faceIndex = _mm_cvttps_epi32(face);
+        __m128 side = _mm_xor_ps(sizeVec, _mm_castsi128_ps(_mm_slli_epi32(faceIndex, 31)));
+        __m128 zFace = _mm_cmplt_ps(face, _mm_set1_ps(2.0f));
+        __m128 xFace = _mm_cmpge_ps(face, _mm_set1_ps(4.0f));
+        __m128 yFace = _mm_andnot_ps(_mm_or_ps(xFace, zFace), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        __m128 u = rng.Range(-size, size);
+        __m128 v = rng.Range(-size, size);
+        return Vector3x4(
+            xo_internal::RandomSelect(xFace, side, u),
+            xo_internal::RandomSelect(yFace, side, xo_internal::RandomSelect(xFace, u, v)),
+            xo_internal::RandomSelect(zFace, side, v));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCube(size, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInSphere(float minRadius, float maxRadius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    const float minCubed = minRadius*minRadius*minRadius;
+    const float maxCubed = maxRadius*maxRadius*maxRadius;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 r = xo_internal::RandomCbrt(rng.Range(minCubed, maxCubed));
+        return xo_internal::RandomSphereDirections(rng) * Vector4(r);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInSphere(minRadius, maxRadius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        return xo_internal::RandomSphereDirections(rng) * radius;
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnSphere(radius, outVecs[i]);
+    }
+#endif
+}
 
 
 #undef IDX_X
@@ -1709,33 +5840,229 @@ void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
 #undef IDX_W
 
 
+////////////////////////////////////////////////////////////////////////// Vector3Array.cpp
+
+_XOSRCINL void Pack(const Vector3* in, Float3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each store writes the w of in[i] over out[i + 1].x, which the next store then replaces. The last element's
+    // store would write past the end of out, so it's split into 8 and 4 bytes.
+    for (; i + 1 < n; ++i) {
+        _mm_storeu_ps(&out[i].x, in[i].xmm);
+    }
+    _mm_storel_pi((__m64*)&out[i].x, in[i].xmm);
+    _mm_store_ss(&out[i].z, _mm_movehl_ps(in[i].xmm, in[i].xmm));
+#else
+    for (; i < n; ++i) {
+        out[i] = Float3(in[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Unpack(const Float3* in, Vector3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each load takes x of the next element too, which is masked off. The last element's load would read past the
+    // end of in, so it's split into 8 and 4 bytes.
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    for (; i + 1 < n; ++i) {
+        out[i].xmm = _mm_and_ps(_mm_loadu_ps(&in[i].x), xyzMask);
+    }
+    out[i].xmm = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&in[i].x), _mm_load_ss(&in[i].z));
+#else
+    for (; i < n; ++i) {
+        out[i] = in[i];
+    }
+#endif
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four packed points are exactly three registers, which shuffle into the xs, ys and zs of all four.
+    _XOINL void LoadFloat3x4(const Float3* p, __m128& x, __m128& y, __m128& z) {
+        __m128 a = _mm_loadu_ps(&p[0].x); // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(&p[1].y); // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(&p[2].z); // z2 x3 y3 z3
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x4.
+    _XOINL void StoreFloat3x4(Float3* p, __m128 x, __m128 y, __m128 z) {
+        _mm_storeu_ps(&p[0].x, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[1].y, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[2].z, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    // Transforms four points per pass, as their xs, ys and zs from LoadFloat3x4. Every element of the matrix is
+    // broadcast before the loop, so a pass is nine multiplies and nine adds, with no shuffles between them. The
+    // last few points are done one at a time, adding in the same order so they round the same way.
+    _XOSRCINL void TransformFloat3Array(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        size_t i = 0;
+#if defined(XO_SSE)
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02), m03 = _mm_set1_ps(tx);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12), m13 = _mm_set1_ps(ty);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22), m23 = _mm_set1_ps(tz);
+        for (; i + 4 <= n; i += 4) {
+            __m128 x, y, z;
+            LoadFloat3x4(in + i, x, y, z);
+            StoreFloat3x4(out + i,
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), m03)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), m13)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), m23)));
+        }
+#endif
+        for (; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = ((m.m00 * x) + (m.m01 * y)) + ((m.m02 * z) + tx);
+            out[i].y = ((m.m10 * x) + (m.m11 * y)) + ((m.m12 * z) + ty);
+            out[i].z = ((m.m20 * x) + (m.m21 * y)) + ((m.m22 * z) + tz);
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // LoadFloat3x4 for eight points, four in each 128 bit lane. Eight points are 96 bytes, loaded as three registers
+    // and permuted so each lane holds the same three registers the SSE version loads, then shuffled the same way.
+    _XOINL _XO_TARGET_AVX void LoadFloat3x8(const Float3* p, __m256& x, __m256& y, __m256& z) {
+        __m256 m0 = _mm256_loadu_ps(&p[0].x);
+        __m256 m1 = _mm256_loadu_ps(&p[2].z);
+        __m256 m2 = _mm256_loadu_ps(&p[5].y);
+        __m256 a = _mm256_permute2f128_ps(m0, m1, 0x30);
+        __m256 b = _mm256_permute2f128_ps(m0, m2, 0x21);
+        __m256 c = _mm256_permute2f128_ps(m1, m2, 0x30);
+        x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x8.
+    _XOINL _XO_TARGET_AVX void StoreFloat3x8(Float3* p, __m256 x, __m256 y, __m256 z) {
+        __m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm256_storeu_ps(&p[0].x, _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(&p[2].z, _mm256_permute2f128_ps(a, c, 0x12));
+        _mm256_storeu_ps(&p[5].y, _mm256_permute2f128_ps(b, c, 0x31));
+    }
+
+    // TransformFloat3Array eight points at a time, leaving the last few to it.
+    _XOSRCINL _XO_TARGET_AVX void TransformFloat3ArrayAVX(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+        const __m256 m03 = _mm256_set1_ps(translate ? m.m03 : 0.0f);
+        const __m256 m13 = _mm256_set1_ps(translate ? m.m13 : 0.0f);
+        const __m256 m23 = _mm256_set1_ps(translate ? m.m23 : 0.0f);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 x, y, z;
+            LoadFloat3x8(in + i, x, y, z);
+            StoreFloat3x8(out + i,
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_add_ps(_mm256_mul_ps(m02, z), m03)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_add_ps(_mm256_mul_ps(m12, z), m13)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_add_ps(_mm256_mul_ps(m22, z), m23)));
+        }
+        _mm256_zeroupper();
+        TransformFloat3Array(m, in + i, out + i, n - i, translate);
+    }
+}
+#endif
+
+_XOSRCINL Vector3Array::Vector3Array() {
+}
+
+_XOSRCINL Vector3Array::Vector3Array(size_t n) :
+    elements(n)
+{
+}
+
+_XOSRCINL Vector3Array::Vector3Array(const Vector3* v, size_t n) :
+    elements(n)
+{
+    Pack(v, elements.data(), n);
+}
+
+_XOSRCINL void Vector3Array::Reserve(size_t n) {
+    elements.reserve(n);
+}
+
+_XOSRCINL void Vector3Array::Resize(size_t n) {
+    elements.resize(n);
+}
+
+_XOSRCINL void Vector3Array::Clear() {
+    elements.clear();
+}
+
+_XOSRCINL void Vector3Array::Add(const Vector3& v) {
+    elements.push_back(Float3(v));
+}
+
+_XOSRCINL void Vector3Array::Add(const Vector3* v, size_t n) {
+    size_t first = elements.size();
+    elements.resize(first + n);
+    Pack(v, elements.data() + first, n);
+}
+
+_XOSRCINL void Vector3Array::Get(size_t first, Vector3* out, size_t n) const {
+    Unpack(elements.data() + first, out, n);
+}
+
+_XOSRCINL void Vector3Array::Set(size_t first, const Vector3* in, size_t n) {
+    Pack(in, elements.data() + first, n);
+}
+
+_XOSRCINL void Vector3Array::TransformPoints(const Matrix4x4& m) {
+    m.TransformPoints(elements.data(), elements.data(), elements.size());
+}
+
+_XOSRCINL void Vector3Array::TransformDirections(const Matrix4x4& m) {
+    m.TransformDirections(elements.data(), elements.data(), elements.size());
+}
+
+
 ////////////////////////////////////////////////////////////////////////// Vector4.cpp
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Vector4::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+_XOSRCDATA const float Vector4::Epsilon = sse::SSEFloatEpsilon * 4.0f;
 #   else
-const float Vector4::Epsilon = FloatEpsilon * 4.0f;
+_XOSRCDATA const float Vector4::Epsilon = FloatEpsilon * 4.0f;
 #   endif
 #endif
 
-const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
-const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
 
-const Vector4 Vector4::UnitX(1.0f, 0.0f, 0.0f, 0.0f);
-const Vector4 Vector4::UnitY(0.0f, 1.0f, 0.0f, 0.0f);
-const Vector4 Vector4::UnitZ(0.0f, 0.0f, 1.0f, 0.0f);
-const Vector4 Vector4::UnitW(0.0f, 0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector4 Vector4::UnitX(1.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitY(0.0f, 1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitZ(0.0f, 0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitW(0.0f, 0.0f, 0.0f, 1.0f);
 
 #define IDX_X 0
 #define IDX_Y 1
 #define IDX_Z 2
 #define IDX_W 3
 
-Vector4::Vector4() {
+_XOSRCINL Vector4::Vector4() {
 }
 
-Vector4::Vector4(float f) :
+_XOSRCINL Vector4::Vector4(float f) :
 #if defined(XO_SSE)
     xmm(_mm_set1_ps(f))
 {
@@ -1746,7 +6073,7 @@ Vector4::Vector4(float f) :
 }
 #endif
 
-Vector4::Vector4(float x, float y, float z, float w) :
+_XOSRCINL Vector4::Vector4(float x, float y, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, y, x))
 {
@@ -1756,7 +6083,7 @@ Vector4::Vector4(float x, float y, float z, float w) :
 {
 }
 #endif
-Vector4::Vector4(const Vector4& vec) :
+_XOSRCINL Vector4::Vector4(const Vector4& vec) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
@@ -1769,13 +6096,13 @@ Vector4::Vector4(const Vector4& vec) :
 
 
 #if defined(XO_SSE)
-Vector4::Vector4(const __m128& vec) : 
+_XOSRCINL Vector4::Vector4(const __m128& vec) : 
     xmm(vec)
 {
 }
 #endif
 
-Vector4::Vector4(const class Vector2& vec) :
+_XOSRCINL Vector4::Vector4(const class Vector2& vec) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, 0.0f, vec.y, vec.x)) 
 {
@@ -1786,7 +6113,7 @@ Vector4::Vector4(const class Vector2& vec) :
 }
 #endif
 
-Vector4::Vector4(const class Vector2& vec, float z, float w) :
+_XOSRCINL Vector4::Vector4(const class Vector2& vec, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, vec.y, vec.x))
 {
@@ -1797,7 +6124,7 @@ Vector4::Vector4(const class Vector2& vec, float z, float w) :
 }
 #endif
 
-Vector4::Vector4(const class Vector3& vec) :
+_XOSRCINL Vector4::Vector4(const class Vector3& vec) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
@@ -1808,12 +6135,12 @@ Vector4::Vector4(const class Vector3& vec) :
 }
 #endif
 
-Vector4::Vector4(const class Vector3& vec, float w) :
+_XOSRCINL Vector4::Vector4(const class Vector3& vec, float w) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
     //! @todo there's likely an sse way to do this.
-    w = w;
+    this->w = w;
 }
 #else
     x(vec.x), y(vec.y), z(vec.z), w(w)
@@ -1821,7 +6148,7 @@ Vector4::Vector4(const class Vector3& vec, float w) :
 }
 #endif
 
-Vector4::Vector4(const class Quaternion& q) :
+_XOSRCINL Vector4::Vector4(const class Quaternion& q) :
 #if defined(XO_SSE)
     xmm(q.xmm)
 #else
@@ -1830,7 +6157,7 @@ Vector4::Vector4(const class Quaternion& q) :
 {
 }
 
-Vector4& Vector4::Set(float x, float y, float z, float w) {
+_XOSRCINL Vector4& Vector4::Set(float x, float y, float z, float w) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(w, z, y, x);
 #else
@@ -1842,7 +6169,7 @@ Vector4& Vector4::Set(float x, float y, float z, float w) {
     return *this;
 }
 
-Vector4& Vector4::Set(float f) {
+_XOSRCINL Vector4& Vector4::Set(float f) {
 #if defined(XO_SSE)
     xmm = _mm_set1_ps(f);
 #else
@@ -1854,7 +6181,7 @@ Vector4& Vector4::Set(float f) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector4& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector4& vec) {
 #if defined(XO_SSE)
     xmm = vec.xmm;
 #else
@@ -1866,7 +6193,7 @@ Vector4& Vector4::Set(const Vector4& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector2& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(0.0f, 0.0f, vec.y, vec.x);
 #else
@@ -1878,7 +6205,7 @@ Vector4& Vector4::Set(const Vector2& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(w, z, vec.y, vec.x);
 #else
@@ -1890,7 +6217,7 @@ Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector3& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec) {
 #if defined(XO_SSE)
     // TODO: mask with xmm, don't just break out w
     this->xmm = vec.xmm;
@@ -1904,7 +6231,7 @@ Vector4& Vector4::Set(const Vector3& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector3& vec, float w) {
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec, float w) {
 #if defined(XO_SSE)
     // todo: consider masking here.
     this->xmm = vec.xmm;
@@ -1919,20 +6246,20 @@ Vector4& Vector4::Set(const Vector3& vec, float w) {
 }
 
 #if defined(XO_SSE)
-Vector4& Vector4::Set(const __m128& vec) {
+_XOSRCINL Vector4& Vector4::Set(const __m128& vec) {
     xmm = vec;
     return *this;
 }
 #endif
 
-void Vector4::Get(float& x, float& y, float& z, float& w) const {
+_XOSRCINL void Vector4::Get(float& x, float& y, float& z, float& w) const {
     x = this->x;
     y = this->y;
     z = this->z;
     w = this->w;
 }
 
-void Vector4::Get(float* f) const {
+_XOSRCINL void Vector4::Get(float* f) const {
 #if defined(XO_SSE)
     _mm_store_ps(f, xmm);
 #else
@@ -1943,8 +6270,8 @@ void Vector4::Get(float* f) const {
 #endif
 }
  
-float Vector4::Sum() const {
-#if defined(XO_SSE)
+_XOSRCINL float Vector4::Sum() const {
+#if defined(XO_SSE3)
     __m128 s = _mm_hadd_ps(xmm, xmm);
     return _mm_cvtss_f32(_mm_hadd_ps(s, s));
 #else
@@ -1952,14 +6279,14 @@ float Vector4::Sum() const {
 #endif
 }
 
-Vector4& Vector4::NormalizeSafe() {
+_XOSRCINL Vector4& Vector4::NormalizeSafe() {
     float magnitude = MagnitudeSquared();
     if (magnitude == 0.0f)
         return *this;
     return *this /= Sqrt(magnitude);
 }
 
-float Vector4::Dot(const Vector4& a, const Vector4& b) {
+_XOSRCINL float Vector4::Dot(const Vector4& a, const Vector4& b) {
 #if defined(XO_SSE4)
     return _mm_cvtss_f32(_mm_dp_ps(a.xmm, b.xmm, 0xff));
 #else
@@ -1967,5 +6294,10 @@ float Vector4::Dot(const Vector4& a, const Vector4& b) {
 #endif
 }
 
+#undef IDX_X
+#undef IDX_Y
+#undef IDX_Z
+#undef IDX_W
+
 
 XOMATH_END_XO_NS();
@@ -24,14 +24,12 @@
 // TODO:
 //  * Ensure macros are consistently named.
 //  * Support NEON (investigate http://projectne10.github.io/Ne10/ license)
-//  * Add transformation object.
 //  * Move trivial methods to headers, keep only "meaningful" code in *.cpp/*inline.h files
 //  * Use macros to generate variant functions for other classes, like in Vector3.h
 //  * Consider other simpler documentation solution. github pages?
 //  * Consider something like premake or similar for dev project files. Check out https://github.com/bkaradzic/GENie
 //  * Move CI back to travis, include more compiler versions.
 //  * Matrix: finish filling out stubs
-//  * fast sin/cos, sincos, _x2 _x2 _x3
 //  * RNG: https://blogs.unity3d.com/2015/01/07/a-primer-on-repeatable-random-numbers/
 //  * Noise:
 //  * Consider moving all randoms out of types themselves and into a separate file.
@@ -72,12 +70,17 @@
 #endif 
 
 #include <math.h>
+#include <stdlib.h>
 #ifndef XO_NO_OSTREAM
 #   include <ostream>
 #endif
-#include <random>
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
 #if defined(__arm__)
 #   if defined(__ARM_NEON__)
 #       include <arm_neon.h>
@@ -90,9 +93,23 @@
 #           include <arm_neon.h>
 #       else
 #           include <xmmintrin.h>
+#           include <intrin.h>
 #       endif
 #   else
+        // gcc 12 reports its own _mm512_undefined_ps as uninitialized wherever an AVX-512 intrinsic using it is 
+        // inlined. The warning is placed in the intrinsic headers, so it's silenced for them alone.
+#       if defined(__GNUC__) && !defined(__clang__)
+#           pragma GCC diagnostic push
+#           pragma GCC diagnostic ignored "-Wuninitialized"
+#           pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#       endif
 #       include <x86intrin.h>
+#       if defined(__GNUC__) && !defined(__clang__)
+#           pragma GCC diagnostic pop
+#       endif
+#       if defined(__x86_64__) || defined(__i386__)
+#           include <cpuid.h>
+#       endif
 #   endif
 #endif
 
@@ -127,6 +144,141 @@
 #   define _XO_MATH_STRINGIFY(x) _XO_MATH_STRINGIFY_HELPER(x)
 #endif
 
+#if defined(_MSC_VER)
+#   if defined(_M_ARM)
+        // note: directx defines _XM_ARM_NEON_INTRINSICS_ if _M_ARM is defined, 
+        // so we're assuming under msvc that it's all that's required to determine neon support...
+#       define XO_NEON 1
+#   elif defined(_M_IX86_FP)
+#       if _M_IX86_FP == 1
+#           define XO_SSE 1
+#       elif _M_IX86_FP == 2
+#           define XO_SSE 1
+#           define XO_SSE2 1
+#       endif
+#   endif
+#   if defined(__AVX__)
+#       define XO_SSE 1
+#       define XO_SSE2 1
+#       define XO_SSE3 1
+#       define XO_SSSE3 1
+#       define XO_SSE4_1 1
+#       define XO_SSE4_2 1
+#       define XO_AVX 1
+#   endif
+#   if defined(__AVX2__)
+#       define XO_SSE 1
+#       define XO_SSE2 1
+#       define XO_SSE3 1
+#       define XO_SSSE3 1
+#       define XO_SSE4_1 1
+#       define XO_SSE4_2 1
+#       define XO_AVX 1
+#       define XO_AVX2 1
+#   endif
+#   if defined(__AVX512F__)
+#       define XO_AVX512 1
+#   endif
+#elif defined(__clang__) || defined (__GNUC__)
+#   if defined(__SSE__)
+#       define XO_SSE 1
+#   endif
+#   if defined(__SSE2__)
+#       define XO_SSE2 1
+#   endif
+#   if defined(__SSE3__)
+#       define XO_SSE3 1
+#   endif
+#   if defined(__SSSE3__)
+#       define XO_SSSE3 1
+#   endif
+#   if defined(__SSE4_1__)
+#       define XO_SSE4_1 1
+#   endif
+#   if defined(__SSE4_2__)
+#       define XO_SSE4_2 1
+#   endif
+#   if defined(__AVX__)
+#       define XO_AVX 1
+#   endif
+#   if defined(__AVX2__)
+#       define XO_AVX2 1
+#   endif
+#   if defined(__AVX512__) || defined(__AVX512F__)
+#       define XO_AVX512 1
+#   endif
+#   if defined(__arm__)
+#       if defined(__ARM_NEON__)
+#           define XO_NEON 1
+#       endif
+#   endif
+#endif
+
+#if defined(XO_AVX512)
+#   define XO_MATH_HIGHEST_SIMD "avx512"
+#elif defined(XO_AVX2)
+#   define XO_MATH_HIGHEST_SIMD "avx2"
+#elif defined(XO_AVX)
+#   define XO_MATH_HIGHEST_SIMD "avx"
+#elif defined(XO_SSE4_2)
+#   define XO_MATH_HIGHEST_SIMD "sse4.2"
+#elif defined(XO_SSE4_1)
+#   define XO_MATH_HIGHEST_SIMD "sse4.1"
+#elif defined(XO_SSSE3)
+#   define XO_MATH_HIGHEST_SIMD "ssse3"
+#elif defined(XO_SSE3)
+#   define XO_MATH_HIGHEST_SIMD "sse3"
+#elif defined(XO_SSE2)
+#   define XO_MATH_HIGHEST_SIMD "sse2"
+#elif defined(XO_SSE)
+#   define XO_MATH_HIGHEST_SIMD "sse"
+#elif defined(XO_NEON)
+#   define XO_MATH_HIGHEST_SIMD "neon"
+#else
+#   define XO_MATH_HIGHEST_SIMD "none"
+#endif
+
+
+// Runtime dispatch. With XO_DISPATCH the batch kernels are also built for instruction sets above what the compiler
+// targets, and the best one the CPU supports is picked at runtime. See Dispatch.h.
+// Define XO_NO_DISPATCH to only build for what the compiler targets.
+// Define XO_NO_AVX512 to leave out the AVX-512 kernels, for hosts where running 512 bit instructions lowers the clock
+// speed by more than the wider kernels gain. InitDispatch(SIMDTier::AVX2) does the same at runtime.
+#if !defined(XO_NO_DISPATCH) && defined(XO_SSE2)
+#   if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#       define XO_DISPATCH 1
+#   endif
+#endif
+
+// _XO_KERNELS_<ISA> is defined when batch kernels for that ISA are built, either because the compiler targets it
+// or for runtime dispatch. _XO_TARGET_<ISA> marks a function as using that ISA. msvc allows any intrinsic without 
+// marking functions.
+#if defined(XO_AVX) || defined(XO_DISPATCH)
+#   define _XO_KERNELS_AVX 1
+#endif
+#if defined(XO_AVX2) || defined(XO_DISPATCH)
+#   define _XO_KERNELS_AVX2 1
+#endif
+#if (defined(XO_AVX512) || defined(XO_DISPATCH)) && !defined(XO_NO_AVX512)
+#   define _XO_KERNELS_AVX512 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   define _XO_TARGET_AVX
+#   define _XO_TARGET_AVX2
+#   define _XO_TARGET_AVX512
+#else
+#   define _XO_TARGET_AVX __attribute__((target("avx")))
+// The AVX2 tier includes F16C, see DetectSIMDTier.
+#   define _XO_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+// The AVX-512 tier needs F, DQ, BW and VL, see DetectSIMDTier.
+#   define _XO_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+#endif
+
+#if defined(_MSC_VER) && !defined(_XO_MATH_OBJ)
+#   pragma message("xo-math simd support: " XO_MATH_HIGHEST_SIMD)
+
+#endif
 
 
 
@@ -146,6 +298,23 @@
 #   define _XOINL inline
 #endif
 
+// With XO_HEADER_ONLY the sources are included at the end of this header, so everything they define has to be 
+// allowed to appear in each translation unit. Functions are made inline, and static data members are merged by the 
+// linker.
+#if defined(XO_HEADER_ONLY)
+#   define _XOSRCINL _XOINL
+#   if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#       define _XOSRCDATA inline
+#   elif defined(_MSC_VER)
+#       define _XOSRCDATA __declspec(selectany)
+#   else
+#       define _XOSRCDATA __attribute__((weak))
+#   endif
+#else
+#   define _XOSRCINL
+#   define _XOSRCDATA
+#endif
+
 
 #if (defined(__clang__) && defined(__APPLE__))
 #   define _XOTLS __thread
@@ -155,21 +324,9 @@
 #   define _XOTLS thread_local
 #endif
 
-# define _XO_NO_TLS (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
-
 // apple clang doesn't give us thread_local until xcode 8.
-#if _XO_NO_TLS
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937* tls_engline; \
-        static _XOTLS char mem[sizeof(std::mt19937)];\
-        if(!tls_engline) { \
-            tls_engline = new(mem) std::mt19937((unsigned)clock()); \
-        }
-#    define _XO_TLS_DISTRIBUTION dist(*tls_engline)
-#else
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937 tls_engline((unsigned)clock());
-#    define _XO_TLS_DISTRIBUTION dist(tls_engline)
+#if (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
+#   define _XO_NO_TLS 1
 #endif
 
 XOMATH_BEGIN_XO_NS();
@@ -247,6 +404,30 @@ namespace sse {
 #   define _XO_OVERLOAD_NEW_DELETE()
 #endif
 
+#if defined(XO_AVX)
+namespace avx {
+    static const __m256 AbsMask = _mm256_set1_ps(HexFloat(0x7fffffff));
+    static const __m256 SignMask = _mm256_set1_ps(HexFloat(0x80000000));
+
+    _XOINL __m256 Abs(__m256 v) {
+        return _mm256_and_ps(AbsMask, v);
+    }
+
+    static const __m256 Zero = _mm256_setzero_ps();
+    static const __m256 One = _mm256_set1_ps(1.0f);
+    static const __m256 Epsilon = _mm256_set1_ps(sse::SSEFloatEpsilon);
+}
+
+// AVX types need 32 byte alignment, which is more than XO_16ALIGNED_MALLOC guarantees.
+#define _XO_OVERLOAD_NEW_DELETE_32() \
+     _XOINL static void* operator new (std::size_t size)     { return _mm_malloc(size, 32); } \
+     _XOINL static void* operator new[] (std::size_t size)   { return _mm_malloc(size, 32); } \
+     _XOINL static void operator delete (void* ptr)          { _mm_free(ptr); } \
+     _XOINL static void operator delete[] (void* ptr)        { _mm_free(ptr); }
+#else
+#   define _XO_OVERLOAD_NEW_DELETE_32() _XO_OVERLOAD_NEW_DELETE()
+#endif
+
 #define _XO_MIN(a, b) (a < b ? a : b)
 #define _XO_MAX(a, b) (a > b ? a : b)
 
@@ -265,155 +446,858 @@ _XOINL float ATan(float f)              { return atanf(f); }
 _XOINL float ATan2(float y, float x)    { return atan2f(y, x); } 
 _XOINL float Difference(float x, float y) { return Abs(x-y); }
 
+_XOINL
+bool CloseEnough(float x, float y, float tolerance = FloatEpsilon) {
+    return Difference(x, y) * (1.0f/tolerance) <= Min(Abs(x), Abs(y));
+}
+
+_XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
+_XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
+_XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
+
+XOMATH_END_XO_NS();
+
+#if defined(XO_SSE)
+#define _XO_ASSIGN_QUAT(W, X, Y, Z) xmm = _mm_set_ps(W, Z, Y, X);
+#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.xmm = _mm_set_ps(W, Z, Y, X);
+#else
+#define _XO_ASSIGN_QUAT(W, X, Y, Z) this->w = W; this->x = X; this->y = Y; this->z = Z;
+#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.w = W; Q.x = X; Q.y = Y; Q.z = Z;
+#endif
+
+////////////////////////////////////////////////////////////////////////// Module Includes
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    // Returns size bytes aligned to align, which is a power of two, or null when out of memory. Up to 16 bytes go
+    // through XO_16ALIGNED_MALLOC, so a user's replacement for it is used by the containers too.
+    _XOINL void* AlignedMalloc(size_t size, size_t align) {
+#if defined(XO_16ALIGNED_MALLOC) && defined(XO_16ALIGNED_FREE)
+        if (align <= 16) {
+            return XO_16ALIGNED_MALLOC(size);
+        }
+#endif
+#if defined(XO_SSE)
+        return _mm_malloc(size, align);
+#else
+        // malloc is only aligned for the fundamental types, so this takes align more bytes, and keeps the pointer
+        // malloc returned in the word before the aligned block for AlignedFree.
+        if (align < sizeof(void*)) {
+            align = sizeof(void*);
+        }
+        void* raw = malloc(size + align);
+        if (!raw) {
+            return nullptr;
+        }
+        void* p = (void*)(((uintptr_t)raw + align) & ~(uintptr_t)(align - 1));
+        ((void**)p)[-1] = raw;
+        return p;
+#endif
+    }
+
+    // Frees p, which AlignedMalloc returned for the same align.
+    _XOINL void AlignedFree(void* p, size_t align) {
+#if defined(XO_16ALIGNED_MALLOC) && defined(XO_16ALIGNED_FREE)
+        if (align <= 16) {
+            XO_16ALIGNED_FREE(p);
+            return;
+        }
+#endif
+#if defined(XO_SSE)
+        _mm_free(p);
+#else
+        (void)align;
+        if (p) {
+            free(((void**)p)[-1]);
+        }
+#endif
+    }
+}
+
+template <typename T, size_t Align = 16>
+class AlignedAllocator {
+public:
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "AlignedAllocator alignment must be a power of two.");
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::true_type is_always_equal;
+
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Align> other;
+    };
+
+    static const size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    AlignedAllocator() {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        void* p = xo_internal::AlignedMalloc(n * sizeof(T), Alignment);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return (T*)p;
+    }
+
+    void deallocate(T* p, size_t) {
+        xo_internal::AlignedFree(p, Alignment);
+    }
+
+    size_t max_size() const {
+        return ~(size_t)0 / sizeof(T);
+    }
+};
+
+template <typename T, typename U, size_t Align>
+bool operator == (const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) {
+    return AlignedAllocator<T, Align>::Alignment == AlignedAllocator<U, Align>::Alignment;
+}
+template <typename T, typename U, size_t Align>
+bool operator != (const AlignedAllocator<T, Align>& a, const AlignedAllocator<U, Align>& b) {
+    return !(a == b);
+}
+
+template <typename T, size_t Align = 16>
+using vector = std::vector<T, AlignedAllocator<T, Align>>;
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+// Sine and cosine kernels.
+//
+// Both tiers reduce the input to an octant with a Cody-Waite reduction by pi/4, then evaluate a minimax 
+// polynomial for sine or cosine on [-pi/4, pi/4] and pick/sign the result by octant. All lanes take the 
+// same path, so there's no branching per element.
+//
+// Errors below were measured against double precision sin/cos over 20 million evenly spaced inputs.
+//
+// Precise (Sin, Cos, SinCos):
+//      The cephes sinf/cosf polynomials with a three part reduction.
+//      Max error of 2 ulp over |x| <= pi. Max absolute error of 1e-7 over |x| <= 8192, where the ulp error 
+//      grows near the zero crossings (14 ulp over |x| <= 100).
+// Fast (FastSin, FastCos, FastSinCos):
+//      Degree 5 sine and degree 4 cosine polynomials with a two part reduction.
+//      Max absolute error of 1.4e-5 over |x| <= 8192. Max error of 232 ulp over |x| <= pi/4 and 722 ulp 
+//      over |x| <= pi.
+//
+// Beyond |x| of 8192 the reduction loses precision and results should not be relied on.
+// See: http://www.netlib.org/cephes/ and http://gruntthepeon.free.fr/ssemath/
+
+namespace sse {
+#if defined(XO_SSE2)
+    _XOINL void SinCosKernel(__m128 x, __m128& s, __m128& c, bool fast) {
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+        const __m128i four = _mm_set1_epi32(4);
+
+        __m128 sinSign = _mm_and_ps(x, SignMask);
+        x = _mm_and_ps(x, AbsMask);
+
+        // j is the octant, rounded up to even so that the remainder is in [-pi/4, pi/4].
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(4.0f / PI)));
+        j = _mm_andnot_si128(one, _mm_add_epi32(j, one));
+        __m128 y = _mm_cvtepi32_ps(j);
+
+        // octants 4 to 7 flip the sign of sine, octants 2 to 5 flip the sign of cosine.
+        sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, four), 29)));
+        __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, two), four), 29));
+        // octants 2, 3, 6 and 7 swap the sine and cosine polynomials.
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), two));
+
+        __m128 z, sp, cp;
+        if (fast) {
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.41913398e-4f)));
+            z = _mm_mul_ps(x, x);
+            sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(8.18171306e-3f), z), _mm_set1_ps(-1.66647993e-1f));
+            sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, z), x), x);
+            cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(4.04584523e-2f), z), _mm_set1_ps(-4.99760557e-1f));
+            cp = _mm_add_ps(_mm_mul_ps(cp, z), One);
+        }
+        else {
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm_mul_ps(x, x);
+            sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+            sp = _mm_add_ps(_mm_mul_ps(sp, z), _mm_set1_ps(-1.6666654611e-1f));
+            sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, z), x), x);
+            cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+            cp = _mm_add_ps(_mm_mul_ps(cp, z), _mm_set1_ps(4.166664568298827e-2f));
+            cp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cp, z), z), _mm_sub_ps(One, _mm_mul_ps(z, _mm_set1_ps(0.5f))));
+        }
+
+        s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cp), _mm_andnot_ps(swap, sp)), sinSign);
+        c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sp), _mm_andnot_ps(swap, cp)), cosSign);
+    }
+
+    _XOINL void SinCos(__m128 x, __m128& s, __m128& c)      { SinCosKernel(x, s, c, false); }
+    _XOINL void FastSinCos(__m128 x, __m128& s, __m128& c)  { SinCosKernel(x, s, c, true); }
+    _XOINL __m128 Sin(__m128 x)     { __m128 s, c; SinCosKernel(x, s, c, false); return s; }
+    _XOINL __m128 Cos(__m128 x)     { __m128 s, c; SinCosKernel(x, s, c, false); return c; }
+    _XOINL __m128 FastSin(__m128 x) { __m128 s, c; SinCosKernel(x, s, c, true); return s; }
+    _XOINL __m128 FastCos(__m128 x) { __m128 s, c; SinCosKernel(x, s, c, true); return c; }
+#endif
+
+#if defined(_XO_KERNELS_AVX2)
+    _XOINL _XO_TARGET_AVX2 void SinCosKernel(__m256 x, __m256& s, __m256& c, bool fast) {
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i two = _mm256_set1_epi32(2);
+        const __m256i four = _mm256_set1_epi32(4);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 oneF = _mm256_set1_ps(1.0f);
+
+        __m256 sinSign = _mm256_and_ps(x, signMask);
+        x = _mm256_andnot_ps(signMask, x);
+
+        __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(4.0f / PI)));
+        j = _mm256_andnot_si256(one, _mm256_add_epi32(j, one));
+        __m256 y = _mm256_cvtepi32_ps(j);
+
+        sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, four), 29)));
+        __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, two), four), 29));
+        __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, two), two));
+
+        __m256 z, sp, cp;
+        if (fast) {
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-2.41913398e-4f)));
+            z = _mm256_mul_ps(x, x);
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(8.18171306e-3f), z), _mm256_set1_ps(-1.66647993e-1f));
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sp, z), x), x);
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(4.04584523e-2f), z), _mm256_set1_ps(-4.99760557e-1f));
+            cp = _mm256_add_ps(_mm256_mul_ps(cp, z), oneF);
+        }
+        else {
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm256_mul_ps(x, x);
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), z), _mm256_set1_ps(8.3321608736e-3f));
+            sp = _mm256_add_ps(_mm256_mul_ps(sp, z), _mm256_set1_ps(-1.6666654611e-1f));
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sp, z), x), x);
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), z), _mm256_set1_ps(-1.388731625493765e-3f));
+            cp = _mm256_add_ps(_mm256_mul_ps(cp, z), _mm256_set1_ps(4.166664568298827e-2f));
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(cp, z), z), _mm256_sub_ps(oneF, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))));
+        }
+
+        s = _mm256_xor_ps(_mm256_blendv_ps(sp, cp, swap), sinSign);
+        c = _mm256_xor_ps(_mm256_blendv_ps(cp, sp, swap), cosSign);
+    }
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+    _XOINL _XO_TARGET_AVX512 void SinCosKernel(__m512 x, __m512& s, __m512& c, bool fast) {
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i two = _mm512_set1_epi32(2);
+        const __m512i four = _mm512_set1_epi32(4);
+        const __m512 signMask = _mm512_set1_ps(-0.0f);
+        const __m512 oneF = _mm512_set1_ps(1.0f);
+
+        __m512 sinSign = _mm512_and_ps(x, signMask);
+        x = _mm512_andnot_ps(signMask, x);
+
+        __m512i j = _mm512_cvttps_epi32(_mm512_mul_ps(x, _mm512_set1_ps(4.0f / PI)));
+        j = _mm512_andnot_si512(one, _mm512_add_epi32(j, one));
+        __m512 y = _mm512_cvtepi32_ps(j);
+
+        sinSign = _mm512_xor_ps(sinSign, _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_and_si512(j, four), 29)));
+        __m512 cosSign = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_andnot_si512(_mm512_sub_epi32(j, two), four), 29));
+        __mmask16 swap = _mm512_test_epi32_mask(j, two);
+
+        __m512 z, sp, cp;
+        if (fast) {
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-0.78515625f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-2.41913398e-4f)));
+            z = _mm512_mul_ps(x, x);
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(8.18171306e-3f), z), _mm512_set1_ps(-1.66647993e-1f));
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(sp, z), x), x);
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(4.04584523e-2f), z), _mm512_set1_ps(-4.99760557e-1f));
+            cp = _mm512_add_ps(_mm512_mul_ps(cp, z), oneF);
+        }
+        else {
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-0.78515625f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm512_mul_ps(x, x);
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(-1.9515295891e-4f), z), _mm512_set1_ps(8.3321608736e-3f));
+            sp = _mm512_add_ps(_mm512_mul_ps(sp, z), _mm512_set1_ps(-1.6666654611e-1f));
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(sp, z), x), x);
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(2.443315711809948e-5f), z), _mm512_set1_ps(-1.388731625493765e-3f));
+            cp = _mm512_add_ps(_mm512_mul_ps(cp, z), _mm512_set1_ps(4.166664568298827e-2f));
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(cp, z), z), _mm512_sub_ps(oneF, _mm512_mul_ps(z, _mm512_set1_ps(0.5f))));
+        }
+
+        s = _mm512_xor_ps(_mm512_mask_blend_ps(swap, sp, cp), sinSign);
+        c = _mm512_xor_ps(_mm512_mask_blend_ps(swap, cp, sp), cosSign);
+    }
+#endif
+
+#if defined(XO_AVX2)
+
+    _XOINL void SinCos(__m256 x, __m256& s, __m256& c)      { SinCosKernel(x, s, c, false); }
+    _XOINL void FastSinCos(__m256 x, __m256& s, __m256& c)  { SinCosKernel(x, s, c, true); }
+    _XOINL __m256 Sin(__m256 x)     { __m256 s, c; SinCosKernel(x, s, c, false); return s; }
+    _XOINL __m256 Cos(__m256 x)     { __m256 s, c; SinCosKernel(x, s, c, false); return c; }
+    _XOINL __m256 FastSin(__m256 x) { __m256 s, c; SinCosKernel(x, s, c, true); return s; }
+    _XOINL __m256 FastCos(__m256 x) { __m256 s, c; SinCosKernel(x, s, c, true); return c; }
+#endif
+}
+
+// A single lane of the precise kernel measured no faster than the C library, so the scalar version stays there.
+_XOINL
+void SinCos(float f, float& s, float& c) { 
+    s = Sin(f);
+    c = Cos(f);
+}
+
+_XOINL
+void FastSinCos(float f, float& s, float& c) {
+    // Scalar version of the fast tier of sse::SinCosKernel.
+    float x = Abs(f);
+    int j = (int)(x * (4.0f / PI));
+    j = (j + 1) & ~1;
+    float y = (float)j;
+    x = (x + y * -0.78515625f) + y * -2.41913398e-4f;
+    float z = x * x;
+    float sp = ((8.18171306e-3f * z - 1.66647993e-1f) * z) * x + x;
+    float cp = (4.04584523e-2f * z - 4.99760557e-1f) * z + 1.0f;
+    bool swap = (j & 2) != 0;
+    s = swap ? cp : sp;
+    c = swap ? sp : cp;
+    if ((j & 4) != 0) {
+        s = -s;
+    }
+    if (f < 0.0f) {
+        s = -s;
+    }
+    if (((j - 2) & 4) == 0) {
+        c = -c;
+    }
+}
+
+_XOINL float FastSin(float f)   { float s, c; FastSinCos(f, s, c); return s; }
+_XOINL float FastCos(float f)   { float s, c; FastSinCos(f, s, c); return c; }
+
 _XOINL
 void Sin_x2(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Sin(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f)));
+    s[0] = t[0];
+    s[1] = t[1];
+#else
     s[0] = Sin(f[0]);
     s[1] = Sin(f[1]);
+#endif
 }
 
 _XOINL
 void Sin_x3(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Sin(_mm_setr_ps(f[0], f[1], f[2], 0.0f)));
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+#else
     s[0] = Sin(f[0]);
     s[1] = Sin(f[1]);
     s[2] = Sin(f[2]);
+#endif
 }
 
 _XOINL
 void Sin_x4(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    _mm_store_ps(s, sse::Sin(_mm_load_ps(f)));
+#else
     s[0] = Sin(f[0]);
     s[1] = Sin(f[1]);
     s[2] = Sin(f[2]);
     s[3] = Sin(f[3]);
+#endif
 }
 
 _XOINL
 void Cos_x2(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Cos(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f)));
+    c[0] = t[0];
+    c[1] = t[1];
+#else
     c[0] = Cos(f[0]);
     c[1] = Cos(f[1]);
+#endif
 }
 
 _XOINL
 void Cos_x3(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Cos(_mm_setr_ps(f[0], f[1], f[2], 0.0f)));
+    c[0] = t[0];
+    c[1] = t[1];
+    c[2] = t[2];
+#else
     c[0] = Cos(f[0]);
     c[1] = Cos(f[1]);
     c[2] = Cos(f[2]);
+#endif
 }
 
 _XOINL
 void Cos_x4(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    _mm_store_ps(c, sse::Cos(_mm_load_ps(f)));
+#else
     c[0] = Cos(f[0]);
     c[1] = Cos(f[1]);
     c[2] = Cos(f[2]);
     c[3] = Cos(f[3]);
-}
-
-_XOINL
-void SinCos(float f, float& s, float& c) { 
-    s = Sin(f);
-    c = Cos(f);
+#endif
 }
 
 _XOINL
 void SinCos_x2(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float ts[4];
+    _XOSIMDALIGN float tc[4];
+    __m128 vs, vc;
+    sse::SinCos(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f), vs, vc);
+    _mm_store_ps(ts, vs);
+    _mm_store_ps(tc, vc);
+    s[0] = ts[0]; c[0] = tc[0];
+    s[1] = ts[1]; c[1] = tc[1];
+#else
     Sin_x2(f, s);
     Cos_x2(f, c);
+#endif
 }
 
 _XOINL
 void SinCos_x3(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float ts[4];
+    _XOSIMDALIGN float tc[4];
+    __m128 vs, vc;
+    sse::SinCos(_mm_setr_ps(f[0], f[1], f[2], 0.0f), vs, vc);
+    _mm_store_ps(ts, vs);
+    _mm_store_ps(tc, vc);
+    s[0] = ts[0]; c[0] = tc[0];
+    s[1] = ts[1]; c[1] = tc[1];
+    s[2] = ts[2]; c[2] = tc[2];
+#else
     Sin_x3(f, s);
     Cos_x3(f, c);
+#endif
 }
 
 _XOINL
 void SinCos_x4(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    __m128 vs, vc;
+    sse::SinCos(_mm_load_ps(f), vs, vc);
+    _mm_store_ps(s, vs);
+    _mm_store_ps(c, vc);
+#else
     Sin_x4(f, s);
     Cos_x4(f, c);
+#endif
 }
 
-_XOINL
-bool CloseEnough(float x, float y, float tolerance = FloatEpsilon) {
-    return Difference(x, y) * (1.0f/tolerance) <= Min(Abs(x), Abs(y));
-}
+// Array versions. Inputs and outputs need no alignment, outputs may be the same array as the input.
+// n may be any count, the remainder that doesn't fill a register is processed as a partial register.
+void Sin(const float* f, float* s, size_t n);
+void Cos(const float* f, float* c, size_t n);
+void SinCos(const float* f, float* s, float* c, size_t n);
+void FastSin(const float* f, float* s, size_t n);
+void FastCos(const float* f, float* c, size_t n);
+void FastSinCos(const float* f, float* s, float* c, size_t n);
 
-_XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
-_XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
-_XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
+XOMATH_END_XO_NS();
 
-_XOINL 
-bool RandomBool() {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(0, 1);
-    return _XO_TLS_DISTRIBUTION == 1;
-}
+XOMATH_BEGIN_XO_NS();
 
-_XOINL 
-int RandomRange(int low, int high) {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
+class Random {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#constructors
+    _XOINL Random(); 
+    _XOINL explicit Random(uint64_t seed); 
+    _XOINL Random(uint64_t seed, uint32_t stream); 
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#methods
+    _XOINL void Seed(uint64_t seed);
+    _XOINL void Jump();
+    _XOINL uint32_t Next();
+    _XOINL float NextFloat();
+    _XOINL int Range(int low, int high);
+    _XOINL float Range(float low, float high);
+    _XOINL bool Bool();
 
-_XOINL 
-float RandomRange(float low, float high) {
-    _XO_TLS_ENGINE
-    std::uniform_real_distribution<float> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
+    ////////////////////////////////////////////////////////////////////////// Thread Engines
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#thread_engines
+    _XOINL static Random& ThreadEngine();
+    _XOINL static void SeedThread(uint64_t seed, uint32_t stream = 0);
 
-XOMATH_END_XO_NS();
+    static const uint64_t DefaultSeed = 0x9e3779b97f4a7c15ULL;
 
-#if defined(XO_SSE)
-#define _XO_ASSIGN_QUAT(W, X, Y, Z) xmm = _mm_set_ps(W, Z, Y, X);
-#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.xmm = _mm_set_ps(W, Z, Y, X);
-#else
-#define _XO_ASSIGN_QUAT(W, X, Y, Z) this->w = W; this->x = X; this->y = Y; this->z = Z;
-#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.w = W; Q.x = X; Q.y = Y; Q.z = Z;
-#endif
+    uint32_t s[4];
 
-////////////////////////////////////////////////////////////////////////// Module Includes
-XOMATH_BEGIN_XO_NS();
+private:
+    // Makes the engine for a new thread. Out of line so the stream counter is shared by everything linked.
+    static Random NewThreadEngine();
+};
 
-class _XOSIMDALIGN Vector2 {
+#if defined(XO_SSE2)
+class _XOSIMDALIGN Random_x4 {
 public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#constructors
+    _XOINL Random_x4(); 
+    _XOINL explicit Random_x4(uint64_t seed, uint32_t stream = 0); 
+    _XOINL explicit Random_x4(Random& source);
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#methods
+    _XOINL void Seed(uint64_t seed, uint32_t stream = 0);
+    _XOINL __m128i Next();
+    _XOINL __m128 NextFloat();
+    _XOINL __m128 Range(float low, float high);
+    _XOINL __m128 Range(__m128 low, __m128 high);
 
+    _XO_OVERLOAD_NEW_DELETE();
+
+    __m128i s[4];
+};
+#endif
+
+#if defined(XO_AVX2)
+class Random_x8 {
+public:
     ////////////////////////////////////////////////////////////////////////// Constructors
-    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#constructors
-    Vector2() { } 
-    Vector2(float v); 
-    Vector2(float x, float y); 
-    Vector2(const Vector2& v); 
-    Vector2(const class Vector3& v); 
-    Vector2(const class Vector4& v); 
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#constructors
+    _XOINL Random_x8(); 
+    _XOINL explicit Random_x8(uint64_t seed, uint32_t stream = 0); 
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#methods
+    _XOINL void Seed(uint64_t seed, uint32_t stream = 0);
+    _XOINL __m256i Next();
+    _XOINL __m256 NextFloat();
+    _XOINL __m256 Range(float low, float high);
+    _XOINL __m256 Range(__m256 low, __m256 high);
 
-    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
-    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#set_get_methods
-    Vector2& Set(float x, float y);
-    Vector2& Set(float f);
-    Vector2& Set(const Vector2& vec);
-    void Get(float& x, float& y) const;
-    void Get(float* f) const;
+    _XO_OVERLOAD_NEW_DELETE_32();
 
-    ////////////////////////////////////////////////////////////////////////// Special Operators
-    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#special_operators
-    _XOINL float& operator [](int i);
-    _XOINL const float& operator [](int i) const;
-    _XOINL Vector2 operator - () const;
-    _XOINL Vector2 operator ~ () const;
+    __m256i s[4];
+};
+#endif
 
+////////////////////////////////////////////////////////////////////////// Random
 
-    ////////////////////////////////////////////////////////////////////////// Math Operators
-    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#math_operators
-    _XOINL Vector2& operator += (const Vector2& v);
+Random::Random() {
+    Seed(DefaultSeed);
+}
+
+Random::Random(uint64_t seed) {
+    Seed(seed);
+}
+
+Random::Random(uint64_t seed, uint32_t stream) {
+    Seed(seed);
+    for (uint32_t i = 0; i < stream; ++i) {
+        Jump();
+    }
+}
+
+void Random::Seed(uint64_t seed) {
+    // splitmix64 spreads the seed over the whole state, and never gives the all zero state xoshiro can't leave.
+    for (int i = 0; i < 4; i += 2) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z = z ^ (z >> 31);
+        s[i] = (uint32_t)z;
+        s[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+void Random::Jump() {
+    static const uint32_t JumpPoly[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    uint32_t t[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 32; ++b) {
+            if (JumpPoly[i] & (1u << b)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            Next();
+        }
+    }
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+    s[3] = t[3];
+}
+
+uint32_t Random::Next() {
+    const uint32_t result = s[0] + s[3];
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+float Random::NextFloat() {
+    // the top 24 bits fill the mantissa exactly.
+    return (float)(Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+int Random::Range(int low, int high) {
+    XO_ASSERT(low <= high, "Random::Range expects low <= high.");
+    const uint32_t span = (uint32_t)high - (uint32_t)low + 1u;
+    if (span == 0) {
+        // low and high cover every int.
+        return (int)Next();
+    }
+    // Lemire's multiply and reject. Takes the high bits of the product, and only divides when a reject is possible.
+    // See: https://arxiv.org/abs/1805.10941
+    uint64_t m = (uint64_t)Next() * span;
+    uint32_t l = (uint32_t)m;
+    if (l < span) {
+        const uint32_t threshold = (0u - span) % span;
+        while (l < threshold) {
+            m = (uint64_t)Next() * span;
+            l = (uint32_t)m;
+        }
+    }
+    return (int)((uint32_t)low + (uint32_t)(m >> 32));
+}
+
+float Random::Range(float low, float high) {
+    return low + (high - low) * NextFloat();
+}
+
+bool Random::Bool() {
+    return (Next() >> 31) != 0;
+}
+
+Random& Random::ThreadEngine() {
+#if defined(_XO_NO_TLS)
+    // thread local objects need a trivial constructor here.
+    static _XOTLS Random* tlsEngine;
+    static _XOTLS char mem[sizeof(Random)];
+    if (!tlsEngine) {
+        tlsEngine = new(mem) Random(NewThreadEngine());
+    }
+    return *tlsEngine;
+#else
+    static _XOTLS Random tlsEngine(NewThreadEngine());
+    return tlsEngine;
+#endif
+}
+
+void Random::SeedThread(uint64_t seed, uint32_t stream) {
+    ThreadEngine() = Random(seed, stream);
+}
+
+////////////////////////////////////////////////////////////////////////// Random_x4
+
+#if defined(XO_SSE2)
+Random_x4::Random_x4() {
+    Seed(Random::DefaultSeed);
+}
+
+Random_x4::Random_x4(uint64_t seed, uint32_t stream) {
+    Seed(seed, stream);
+}
+
+Random_x4::Random_x4(Random& source) {
+    _XOSIMDALIGN uint32_t state[4][4];
+    for (int i = 0; i < 4; ++i) {
+        uint64_t seed = source.Next();
+        Random lane((seed << 32) | source.Next());
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm_load_si128((const __m128i*)state[j]);
+    }
+}
+
+void Random_x4::Seed(uint64_t seed, uint32_t stream) {
+    Random lane(seed, stream * 4);
+    _XOSIMDALIGN uint32_t state[4][4];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+        lane.Jump();
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm_load_si128((const __m128i*)state[j]);
+    }
+}
+
+__m128i Random_x4::Next() {
+    const __m128i result = _mm_add_epi32(s[0], s[3]);
+    const __m128i t = _mm_slli_epi32(s[1], 9);
+    s[2] = _mm_xor_si128(s[2], s[0]);
+    s[3] = _mm_xor_si128(s[3], s[1]);
+    s[1] = _mm_xor_si128(s[1], s[2]);
+    s[0] = _mm_xor_si128(s[0], s[3]);
+    s[2] = _mm_xor_si128(s[2], t);
+    s[3] = _mm_or_si128(_mm_slli_epi32(s[3], 11), _mm_srli_epi32(s[3], 21));
+    return result;
+}
+
+__m128 Random_x4::NextFloat() {
+    return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(Next(), 8)), _mm_set1_ps(1.0f / 16777216.0f));
+}
+
+__m128 Random_x4::Range(float low, float high) {
+    return Range(_mm_set1_ps(low), _mm_set1_ps(high));
+}
+
+__m128 Random_x4::Range(__m128 low, __m128 high) {
+    return _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), NextFloat()));
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////// Random_x8
+
+#if defined(XO_AVX2)
+Random_x8::Random_x8() {
+    Seed(Random::DefaultSeed);
+}
+
+Random_x8::Random_x8(uint64_t seed, uint32_t stream) {
+    Seed(seed, stream);
+}
+
+void Random_x8::Seed(uint64_t seed, uint32_t stream) {
+    Random lane(seed, stream * 8);
+    uint32_t state[4][8];
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+        lane.Jump();
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm256_loadu_si256((const __m256i*)state[j]);
+    }
+}
+
+__m256i Random_x8::Next() {
+    const __m256i result = _mm256_add_epi32(s[0], s[3]);
+    const __m256i t = _mm256_slli_epi32(s[1], 9);
+    s[2] = _mm256_xor_si256(s[2], s[0]);
+    s[3] = _mm256_xor_si256(s[3], s[1]);
+    s[1] = _mm256_xor_si256(s[1], s[2]);
+    s[0] = _mm256_xor_si256(s[0], s[3]);
+    s[2] = _mm256_xor_si256(s[2], t);
+    s[3] = _mm256_or_si256(_mm256_slli_epi32(s[3], 11), _mm256_srli_epi32(s[3], 21));
+    return result;
+}
+
+__m256 Random_x8::NextFloat() {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(Next(), 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+
+__m256 Random_x8::Range(float low, float high) {
+    return Range(_mm256_set1_ps(low), _mm256_set1_ps(high));
+}
+
+__m256 Random_x8::Range(__m256 low, __m256 high) {
+    return _mm256_add_ps(low, _mm256_mul_ps(_mm256_sub_ps(high, low), NextFloat()));
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////// Free functions
+
+_XOINL
+bool RandomBool() {
+    return Random::ThreadEngine().Bool();
+}
+
+_XOINL
+int RandomRange(int low, int high) {
+    return Random::ThreadEngine().Range(low, high);
+}
+
+_XOINL
+float RandomRange(float low, float high) {
+    return Random::ThreadEngine().Range(low, high);
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Vector2 {
+public:
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#constructors
+    Vector2() { } 
+    Vector2(float v); 
+    Vector2(float x, float y); 
+    Vector2(const Vector2& v); 
+    Vector2(const class Vector3& v); 
+    Vector2(const class Vector4& v); 
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#set_get_methods
+    Vector2& Set(float x, float y);
+    Vector2& Set(float f);
+    Vector2& Set(const Vector2& vec);
+    void Get(float& x, float& y) const;
+    void Get(float* f) const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#special_operators
+    _XOINL float& operator [](int i);
+    _XOINL const float& operator [](int i) const;
+    _XOINL Vector2 operator - () const;
+    _XOINL Vector2 operator ~ () const;
+
+
+    ////////////////////////////////////////////////////////////////////////// Math Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#math_operators
+    _XOINL Vector2& operator += (const Vector2& v);
     _XOINL Vector2& operator += (float v);
     _XOINL Vector2& operator += (double v);
     _XOINL Vector2& operator += (int v);
@@ -830,6 +1714,9 @@ public:
         return (b - a).MagnitudeSquared();
     }
     static float Dot(const Vector3& a, const Vector3& b);
+    static void Dot(const Vector3* a, const Vector3* b, float* outDots, size_t n);
+    static void Normalize(const Vector3* in, Vector3* out, size_t n);
+    static void Normalize(Vector3* inOut, size_t n);
     
 
     ////////////////////////////////////////////////////////////////////////// Random Methods
@@ -851,7 +1738,8 @@ public:
         outVec.Set(RandomRange(-size, size), RandomRange(-size, size), RandomRange(-size, size));
     }
     static void RandomInSphere(float minRadius, float maxRadius, Vector3& outVec) {
-        RandomOnSphere(Sqrt(RandomRange(minRadius, maxRadius)), outVec);
+        // uniform in volume, so the radius is the cube root of a uniform value between the cubed radii.
+        RandomOnSphere(Cbrt(RandomRange(minRadius*minRadius*minRadius, maxRadius*maxRadius*maxRadius)), outVec);
     }
     static void RandomInSphere(float radius, Vector3& outVec) {
         RandomInSphere(0.0f, radius, outVec);
@@ -881,6 +1769,26 @@ public:
         RandomOnSphere(1.0f, outVec);
     }
 
+    static void RandomInCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n);
+    static void RandomInConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n);
+    static void RandomInCube(float size, Vector3* outVecs, size_t n);
+    static void RandomInFanRadians(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n);
+    static void RandomInSphere(float minRadius, float maxRadius, Vector3* outVecs, size_t n);
+    static void RandomOnCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n);
+    static void RandomOnConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n);
+    static void RandomOnCube(float size, Vector3* outVecs, size_t n);
+    static void RandomOnSphere(float radius, Vector3* outVecs, size_t n);
+
+    static void RandomInConeDegrees(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+        RandomInConeRadians(forward, angle * Deg2Rad, outVecs, n);
+    }
+    static void RandomInFanDegrees(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n) {
+        RandomInFanRadians(forward, up, angle * Deg2Rad, outVecs, n);
+    }
+    static void RandomOnConeDegrees(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+        RandomOnConeRadians(forward, angle * Deg2Rad, outVecs, n);
+    }
+
 
 #define _RET_VARIANT(name) { Vector3 tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
@@ -1280,6 +2188,103 @@ public:
 
 XOMATH_END_XO_NS();
 
+XOMATH_BEGIN_XO_NS();
+
+uint16_t FloatToHalf(float f);
+float HalfToFloat(uint16_t h);
+
+struct Half2 {
+    Half2() {} 
+    explicit Half2(const class Vector2& v);
+    operator Vector2() const;
+
+    uint16_t x, y;
+};
+
+struct Half3 {
+    Half3() {} 
+    explicit Half3(const class Vector3& v);
+    operator Vector3() const;
+
+    uint16_t x, y, z;
+};
+
+struct Half4 {
+    Half4() {} 
+    explicit Half4(const class Vector4& v);
+    operator Vector4() const;
+
+    uint16_t x, y, z, w;
+};
+
+// Array versions. Inputs and outputs need no alignment, and n may be any count. Each element converts exactly as
+// FloatToHalf or HalfToFloat would. With F16C (the AVX2 dispatch tier and above) they take 8 floats per
+// instruction; otherwise they use an SSE2 version of the same rounding, 4 floats at a time.
+// An output must not overlap its input.
+void ToHalf(const float* in, uint16_t* out, size_t n);
+void ToHalf(const Vector2* in, Half2* out, size_t n);
+void ToHalf(const Vector3* in, Half3* out, size_t n);
+void ToHalf(const Vector4* in, Half4* out, size_t n);
+void FromHalf(const uint16_t* in, float* out, size_t n);
+void FromHalf(const Half2* in, Vector2* out, size_t n);
+void FromHalf(const Half3* in, Vector3* out, size_t n);
+void FromHalf(const Half4* in, Vector4* out, size_t n);
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+struct Float3 {
+    Float3() {} 
+    _XOINL Float3(float x, float y, float z);
+    _XOINL explicit Float3(const class Vector3& v);
+    _XOINL operator Vector3() const;
+
+    float x, y, z;
+};
+
+// Array versions. Inputs and outputs need no alignment, and n may be any count. Both use unaligned 16 byte loads
+// or stores that overlap the next element, except for the last element, so nothing past the end of either array is
+// read or written. An output must not overlap its input.
+
+void Pack(const Vector3* in, Float3* out, size_t n);
+void Unpack(const Float3* in, Vector3* out, size_t n);
+
+class Vector3Array {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3array.html#constructors
+    Vector3Array(); 
+    explicit Vector3Array(size_t n); 
+    Vector3Array(const Vector3* v, size_t n); 
+    _XOINL size_t GetCount() const;
+    void Reserve(size_t n);
+    void Resize(size_t n);
+    void Clear();
+    void Add(const Vector3& v);
+    void Add(const Vector3* v, size_t n);
+
+    _XOINL Vector3 Get(size_t i) const;
+    _XOINL void Set(size_t i, const Vector3& v);
+    void Get(size_t first, Vector3* out, size_t n) const;
+    void Set(size_t first, const Vector3* in, size_t n);
+    _XOINL Float3* GetData();
+    _XOINL const Float3* GetData() const;
+    _XOINL Float3& operator [](size_t i);
+    _XOINL const Float3& operator [](size_t i) const;
+
+
+    void TransformPoints(const class Matrix4x4& m);
+    void TransformDirections(const class Matrix4x4& m);
+
+private:
+    std::vector<Float3> elements;
+};
+
+XOMATH_END_XO_NS();
+
+
 XOMATH_BEGIN_XO_NS();
 
 class _XOSIMDALIGN Matrix4x4 {
@@ -1295,6 +2300,7 @@ public:
     Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3);
     Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2);
     Matrix4x4(const class Quaternion& q);
+    Matrix4x4(const class Matrix3x4& m);
 
 
     Matrix4x4& SetRow(int i, const Vector4& r);
@@ -1337,10 +2343,39 @@ public:
     bool TryMakeInverse();
     bool TryGetInverse(Matrix4x4& o) const { o = *this; return o.TryMakeInverse(); }
 
+    enum class InverseMethod {
+        Rigid,                  
+        ScaleRotateTranslate,   
+        Affine,                 
+        General                 
+    };
+    struct InverseStats {
+        size_t count[4];
+        InverseStats() { Reset(); }
+        void Reset() { count[0] = count[1] = count[2] = count[3] = 0; }
+        size_t operator [](InverseMethod m) const { return count[(int)m]; }
+        size_t Total() const { return count[0] + count[1] + count[2] + count[3]; }
+    };
+
+    Matrix4x4 InverseAffine() const;
+    Matrix4x4 InverseRigid() const;
+    Matrix4x4 InverseScaleRotateTranslate() const;
+    InverseMethod ClassifyInverse() const;
+    Matrix4x4 InverseAuto(InverseStats* stats = nullptr) const;
+
     Matrix4x4& Transpose();
     const Matrix4x4& Transform(Vector3& v) const;
     const Matrix4x4& Transform(Vector4& v) const;
 
+    const Matrix4x4& TransformPoints(const Vector3* in, Vector3* out, size_t n) const;
+    const Matrix4x4& TransformDirections(const Vector3* in, Vector3* out, size_t n) const;
+    const Matrix4x4& TransformVector4s(const Vector4* in, Vector4* out, size_t n) const;
+    const Matrix4x4& TransformPoints(const Float3* in, Float3* out, size_t n) const;
+    const Matrix4x4& TransformDirections(const Float3* in, Float3* out, size_t n) const;
+    const Matrix4x4& TransformPoints(Vector3* inOut, size_t n) const;
+    const Matrix4x4& TransformDirections(Vector3* inOut, size_t n) const;
+    const Matrix4x4& TransformVector4s(Vector4* inOut, size_t n) const;
+
     Matrix4x4 Transposed() const;
 
     ////////////////////////////////////////////////////////////////////////// Static Methods
@@ -1370,6 +2405,12 @@ public:
     static void LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& outMatrix);
     static void LookAtFromDirection(const Vector3& direction, Matrix4x4& outMatrix);
 
+    static void MultiplyBatch(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    static void MultiplyBatch(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    static void MultiplyBatch(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n);
+    static void MultiplyBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    static void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+
     static Matrix4x4 Scale(float xyz);
     static Matrix4x4 Scale(float x, float y, float z);
     static Matrix4x4 Scale(const Vector3& v);
@@ -1427,6 +2468,96 @@ public:
 };
 
 
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Matrix3x4 {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#constructors
+    Matrix3x4(); 
+    explicit Matrix3x4(float m); 
+    Matrix3x4(float m00, float m01, float m02, float m03,
+              float m10, float m11, float m12, float m13,
+              float m20, float m21, float m22, float m23);
+    Matrix3x4(const Matrix3x4& m);
+    Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2);
+    explicit Matrix3x4(const class Matrix4x4& m);
+    explicit Matrix3x4(const class Quaternion& q);
+    Matrix3x4(const class Quaternion& q, const Vector3& translation);
+
+
+    _XOINL const Vector4& GetRow(int i) const;
+    _XOINL Vector3 GetColumn(int i) const;
+    _XOINL Vector3 GetTranslation() const;
+    _XOINL Matrix3x4& SetTranslation(const Vector3& t);
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+    _XOINL operator float*() const { return (float*)this; }
+    _XOINL const Vector4& operator [](int i) const;
+    _XOINL Vector4& operator [](int i);
+    _XOINL const float& operator ()(int r, int c) const;
+    _XOINL float& operator ()(int r, int c);
+
+
+    _XOINL Matrix3x4& operator *= (const Matrix3x4& m);
+    _XOINL Matrix3x4 operator * (const Matrix3x4& m) const;
+    _XOINL Vector4 operator * (const Vector4& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#methods
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+
+    const Matrix3x4& TransformPoints(const Vector3* in, Vector3* out, size_t n) const;
+    const Matrix3x4& TransformDirections(const Vector3* in, Vector3* out, size_t n) const;
+    const Matrix3x4& TransformPoints(Vector3* inOut, size_t n) const;
+    const Matrix3x4& TransformDirections(Vector3* inOut, size_t n) const;
+    const Matrix3x4& TransformPoints(const Float3* in, Float3* out, size_t n) const;
+    const Matrix3x4& TransformDirections(const Float3* in, Float3* out, size_t n) const;
+
+    float Determinant() const;
+
+    void MakeInverse();
+    void GetInverse(Matrix3x4& o) const { o = *this; o.MakeInverse(); }
+    bool TryMakeInverse();
+    bool TryGetInverse(Matrix3x4& o) const { o = *this; return o.TryMakeInverse(); }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#static_methods
+    static void Scale(const Vector3& v, Matrix3x4& outMatrix);
+    static void Translation(const Vector3& v, Matrix3x4& outMatrix);
+
+    static Matrix3x4 Scale(const Vector3& v);
+    static Matrix3x4 Translation(const Vector3& v);
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Matrix3x4& m) {
+        os << "\nrow 0: " << m.r[0] << "\nrow 1: " << m.r[1] << "\nrow 2: " << m.r[2] << "\n";
+        return os;
+    }
+#endif
+
+    union {
+        Vector4 r[3];
+        float m[12];
+        struct {
+            float   m00, m01, m02, m03,
+                    m10, m11, m12, m13,
+                    m20, m21, m22, m23;
+        };
+    };
+
+    static const Matrix3x4
+        Identity,
+        Zero;
+};
+
 XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
@@ -1435,6 +2566,7 @@ class _XOSIMDALIGN Quaternion {
 public:
     Quaternion();
     Quaternion(const Matrix4x4& m);
+    Quaternion(const class Matrix3x4& m);
     Quaternion(float x, float y, float z, float w);
 
     _XO_OVERLOAD_NEW_DELETE();
@@ -1444,6 +2576,7 @@ public:
 
     _XOINL Quaternion& operator *= (const Quaternion& q);
     _XOINL Quaternion operator * (const Quaternion& q) const;
+    _XOINL Vector3 operator * (const Vector3& v) const;
 
     _XOINL bool operator == (const Quaternion& q) const;
     _XOINL bool operator != (const Quaternion& q) const;
@@ -1456,6 +2589,11 @@ public:
     Quaternion Normalized() const;
     void GetAxisAngleRadians(Vector3& axis, float& radians) const;
 
+    _XOINL Vector3 Rotate(const Vector3& v) const;
+    const Quaternion& Rotate(const Vector3* in, Vector3* out, size_t n) const;
+    const Quaternion& Rotate(Vector3* inOut, size_t n) const;
+    static void RotateBatch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+
     static void AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat);
     static void Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
     static void LookAtFromDirection(const Vector3& direction, const Vector3& up, Quaternion& outQuat);
@@ -1465,6 +2603,12 @@ public:
     static void RotationRadians(const Vector3& v, Quaternion& outQuat);
     static void RotationRadians(float x, float y, float z, Quaternion& outQuat);
     static void Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    static void Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    static void FastSlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+
+    static void SlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
+    static void NlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
+    static void FastSlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
 
 #define _RET_VARIANT(name) { Quaternion tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
@@ -1485,6 +2629,8 @@ public:
     static Quaternion RotationRadians(const Vector3& v)                                             _RET_VARIANT_1(RotationRadians, v)
     static Quaternion RotationRadians(float x, float y, float z)                                    _RET_VARIANT_3(RotationRadians, x, y, z)
     static Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Slerp, a, b, t)
+    static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Nlerp, a, b, t)
+    static Quaternion FastSlerp(const Quaternion& a, const Quaternion& b, float t)                  _RET_VARIANT_3(FastSlerp, a, b, t)
 
 #undef _RET_VARIANT
 #undef _RET_VARIANT_END
@@ -1531,473 +2677,9578 @@ private:
 
 XOMATH_END_XO_NS();
 
-
 XOMATH_BEGIN_XO_NS();
 
-float& Vector2::operator [](int i) { return f[i]; }
-const float& Vector2::operator [](int i) const { return f[i]; }
+class _XOSIMDALIGN DualQuaternion {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#constructors
+    DualQuaternion(); 
+    DualQuaternion(const Quaternion& real, const Quaternion& dual);
+    DualQuaternion(const Quaternion& rotation, const Vector3& translation);
+    explicit DualQuaternion(const class Matrix3x4& m);
+    explicit DualQuaternion(const class Matrix4x4& m);
 
-Vector2 Vector2::operator - () const { return Vector2(-x, -y); }
-Vector2 Vector2::operator ~ () const { return Vector2(y, x); }
 
-Vector2& Vector2::operator += (const Vector2& v) {
-    x += v.x;
-    y += v.y;
-    return *this; 
-}
-Vector2& Vector2::operator += (float v) {
-    x += v;
-    y += v;
-    return *this; 
-}
-Vector2& Vector2::operator += (double v)                  { return *this += (float)v; }
-Vector2& Vector2::operator += (int v)                     { return *this += (float)v; }
-Vector2& Vector2::operator += (const class Vector3& v)    { return *this += Vector2(v); }
-Vector2& Vector2::operator += (const class Vector4& v)    { return *this += Vector2(v); }
+    _XOINL const Quaternion& GetRotation() const;
+    _XOINL Vector3 GetTranslation() const;
 
-Vector2& Vector2::operator -= (const Vector2& v) {
-    x -= v.x;
-    y -= v.y;
-    return *this; 
-}
-Vector2& Vector2::operator -= (float v) {
-    x -= v;
-    y -= v;
-    return *this; 
-}
-Vector2& Vector2::operator -= (double v)                  { return *this -= (float)v; }
-Vector2& Vector2::operator -= (int v)                     { return *this -= (float)v; }
-Vector2& Vector2::operator -= (const class Vector3& v)    { return *this -= Vector2(v); }
-Vector2& Vector2::operator -= (const class Vector4& v)    { return *this -= Vector2(v); }
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
 
-Vector2& Vector2::operator *= (const Vector2& v) {
-    x *= v.x;
-    y *= v.y;
+
+    _XOINL DualQuaternion& operator *= (const DualQuaternion& q);
+    _XOINL DualQuaternion operator * (const DualQuaternion& q) const;
+    _XOINL bool operator == (const DualQuaternion& q) const;
+    _XOINL bool operator != (const DualQuaternion& q) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#methods
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+
+    DualQuaternion& Normalize();
+    DualQuaternion Normalized() const;
+    DualQuaternion& MakeInverse();
+    DualQuaternion Inverse() const;
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#static_methods
+    static void Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outDualQuaternion);
+
+    static DualQuaternion Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t) { DualQuaternion o; Nlerp(a, b, t, o); return o; }
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const DualQuaternion& q) {
+        os << "real: " << Vector4(q.real) << " dual: " << Vector4(q.dual);
+        return os;
+    }
+#endif
+
+    Quaternion real;
+    Quaternion dual;
+
+    static const DualQuaternion Identity;
+};
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Transform {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#constructors
+    Transform();
+    Transform(const Vector3& position, const Quaternion& rotation);
+    Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+    explicit Transform(const Matrix3x4& m);
+
+    _XOINL const Vector3& GetPosition() const;
+    _XOINL const Quaternion& GetRotation() const;
+    _XOINL const Vector3& GetScale() const;
+    _XOINL Transform& SetPosition(const Vector3& position);
+    _XOINL Transform& SetRotation(const Quaternion& rotation);
+    _XOINL Transform& SetScale(const Vector3& scale);
+    _XOINL Transform& Set(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+    _XOINL const Matrix3x4& GetMatrix() const;
+    _XOINL const Matrix3x4& GetInverseMatrix() const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#methods
+    Vector3 TransformPoint(const Vector3& v) const;
+    Vector3 TransformDirection(const Vector3& v) const;
+    Vector3 InverseTransformPoint(const Vector3& v) const;
+
+    Transform& MakeInverse();
+    Transform Inverse() const;
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#static_methods
+    static void Combine(const Transform& parent, const Transform& child, Transform& outTransform);
+
+    static void ComposeMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale, Matrix3x4& outMatrix);
+    static void ComposeInverseMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale, Matrix3x4& outMatrix);
+
+    static Transform Combine(const Transform& parent, const Transform& child);
+
+    static const Transform Identity;
+
+private:
+    enum : unsigned {
+        DirtyMatrix = 1,
+        DirtyInverse = 2,
+        DirtyAll = DirtyMatrix | DirtyInverse
+    };
+
+    // Compose the cached matrices and clear their flags. Out of line, so the checks in the getters stay small.
+
+    void UpdateMatrix() const;
+    void UpdateInverseMatrix() const;
+
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    mutable Matrix3x4 matrix;
+    mutable Matrix3x4 inverseMatrix;
+    mutable unsigned dirty;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class Hierarchy {
+public:
+    enum : int { NoParent = -1 };
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#constructors
+    Hierarchy(); 
+
+    void Reserve(size_t nodeCount);
+    void Clear();
+    int AddNode(int parent, const Matrix4x4& local);
+
+    _XOINL size_t GetNodeCount() const;
+    _XOINL int GetParent(int node) const;
+    _XOINL const Matrix4x4& GetLocal(int node) const;
+    _XOINL void SetLocal(int node, const Matrix4x4& local);
+    _XOINL const Matrix4x4& GetWorld(int node) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#methods
+    void UpdateWorld(unsigned threadCount = 1);
+
+
+    void BeginUpdate();
+    _XOINL size_t GetLevelCount() const;
+    void GetLevelRange(size_t level, size_t& begin, size_t& end) const;
+    void UpdateRange(size_t begin, size_t end);
+    void EndUpdate();
+
+private:
+    static const size_t NothingChanged = ~(size_t)0;
+
+    void Sort();
+
+    // By handle.
+    std::vector<int> parents;
+    std::vector<int> depths;
+    std::vector<int> slots;
+
+    // By slot, which is the order of the levels.
+    std::vector<int> parentSlots;
+    // aligned, for the SSE loads of the updates.
+    vector<Matrix4x4> locals;
+    vector<Matrix4x4> worlds;
+    std::vector<unsigned char> changed;
+
+    // The first slot of each level, then the node count.
+    std::vector<size_t> levels;
+    // The lowest depth with a changed node, or NothingChanged.
+    size_t firstChangedLevel;
+    bool sorted;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class Skinning {
+public:
+    struct Influences {
+        int bones[4];
+        float weights[4];
+    };
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/skinning.html#static_methods
+    static void Skin(const Matrix3x4* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+    static void Skin(const Matrix4x4* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+    static void Skin(const DualQuaternion* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+};
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+class FrameArena {
+public:
+    struct Stats {
+        size_t used;            
+        size_t peak;            
+        size_t capacity;        
+        size_t blockCount;      
+        size_t allocationCount; 
+        bool hugePages;         
+    };
+
+    static const size_t DefaultBlockSize = 1 << 20;
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/framearena.html#constructors
+    FrameArena();
+    explicit FrameArena(size_t blockSize, bool hugePages = false);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator = (const FrameArena&) = delete;
+
+
+    _XOINL void* Allocate(size_t size, size_t align = 16);
+    template <typename T>
+    _XOINL T* Allocate(size_t n);
+    _XOINL Vector3* AllocateVector3s(size_t n);
+    _XOINL Matrix4x4* AllocateMatrix4x4s(size_t n);
+
+    void Reset();
+    void Release();
+
+    Stats GetStats() const;
+
+
+    static FrameArena& ThreadArena();
+
+private:
+    // Each block starts with this header, followed by its memory.
+    struct Block {
+        Block* previous;
+        size_t size;
+        bool pageAligned;
+    };
+
+    // Chains a block with room for size bytes at align, then allocates them from it.
+    void* AllocateFromNewBlock(size_t size, size_t align);
+    Block* NewBlock(size_t size);
+    void FreeBlocks();
+
+    Block* current;
+    char* cursor;
+    char* end;
+    size_t blockSize;
+    size_t used;
+    size_t peak;
+    size_t capacity;
+    size_t blockCount;
+    size_t allocationCount;
+    bool wantHugePages;
+    bool hugePages;
+};
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Vector3x4 {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#constructors
+    Vector3x4() { } 
+    _XOINL Vector3x4(float f); 
+    _XOINL Vector3x4(const Vector3& v); 
+    _XOINL Vector3x4(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3); 
+    _XOINL Vector3x4(const Vector4& x, const Vector4& y, const Vector4& z); 
+    _XOINL Vector3x4(const Vector3x4& v); 
+#if defined(XO_SSE)
+    _XOINL Vector3x4(const __m128& x, const __m128& y, const __m128& z); 
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#set_get_methods
+    _XOINL Vector3x4& Set(const Vector3& v);
+    _XOINL Vector3x4& Set(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3);
+    _XOINL Vector3x4& Set(const Vector3x4& vec);
+    _XOINL Vector3x4& SetLane(int lane, const Vector3& v);
+    _XOINL Vector3 GetLane(int lane) const;
+    _XOINL void Get(Vector3& v0, Vector3& v1, Vector3& v2, Vector3& v3) const;
+
+    ////////////////////////////////////////////////////////////////////////// Load / Store Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#load_store_methods
+    _XOINL static Vector3x4 Load(const Vector3* v);
+    _XOINL static Vector3x4 LoadPartial(const Vector3* v, int count);
+    _XOINL static Vector3x4 LoadSoA(const float* x, const float* y, const float* z);
+    _XOINL void Store(Vector3* v) const;
+    _XOINL void StorePartial(Vector3* v, int count) const;
+    _XOINL void StoreSoA(float* x, float* y, float* z) const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+    _XOINL Vector3x4 operator -() const;
+
+    ////////////////////////////////////////////////////////////////////////// Math Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#math_operators
+    _XOINL Vector3x4& operator += (const Vector3x4& v);
+    _XOINL Vector3x4& operator += (const Vector3& v);
+    _XOINL Vector3x4& operator += (const Vector4& v);
+    _XOINL Vector3x4& operator += (float v);
+    _XOINL Vector3x4& operator += (double v);
+    _XOINL Vector3x4& operator += (int v);
+    _XOINL Vector3x4& operator -= (const Vector3x4& v);
+    _XOINL Vector3x4& operator -= (const Vector3& v);
+    _XOINL Vector3x4& operator -= (const Vector4& v);
+    _XOINL Vector3x4& operator -= (float v);
+    _XOINL Vector3x4& operator -= (double v);
+    _XOINL Vector3x4& operator -= (int v);
+    _XOINL Vector3x4& operator *= (const Vector3x4& v);
+    _XOINL Vector3x4& operator *= (const Vector3& v);
+    _XOINL Vector3x4& operator *= (const Vector4& v);
+    _XOINL Vector3x4& operator *= (float v);
+    _XOINL Vector3x4& operator *= (double v);
+    _XOINL Vector3x4& operator *= (int v);
+    _XOINL Vector3x4& operator /= (const Vector3x4& v);
+    _XOINL Vector3x4& operator /= (const Vector3& v);
+    _XOINL Vector3x4& operator /= (const Vector4& v);
+    _XOINL Vector3x4& operator /= (float v);
+    _XOINL Vector3x4& operator /= (double v);
+    _XOINL Vector3x4& operator /= (int v);
+    _XOINL Vector3x4 operator + (const Vector3x4& v) const;
+    _XOINL Vector3x4 operator + (const Vector3& v) const;
+    _XOINL Vector3x4 operator + (const Vector4& v) const;
+    _XOINL Vector3x4 operator + (float v) const;
+    _XOINL Vector3x4 operator + (double v) const;
+    _XOINL Vector3x4 operator + (int v) const;
+    _XOINL Vector3x4 operator - (const Vector3x4& v) const;
+    _XOINL Vector3x4 operator - (const Vector3& v) const;
+    _XOINL Vector3x4 operator - (const Vector4& v) const;
+    _XOINL Vector3x4 operator - (float v) const;
+    _XOINL Vector3x4 operator - (double v) const;
+    _XOINL Vector3x4 operator - (int v) const;
+    _XOINL Vector3x4 operator * (const Vector3x4& v) const;
+    _XOINL Vector3x4 operator * (const Vector3& v) const;
+    _XOINL Vector3x4 operator * (const Vector4& v) const;
+    _XOINL Vector3x4 operator * (float v) const;
+    _XOINL Vector3x4 operator * (double v) const;
+    _XOINL Vector3x4 operator * (int v) const;
+    _XOINL Vector3x4 operator / (const Vector3x4& v) const;
+    _XOINL Vector3x4 operator / (const Vector3& v) const;
+    _XOINL Vector3x4 operator / (const Vector4& v) const;
+    _XOINL Vector3x4 operator / (float v) const;
+    _XOINL Vector3x4 operator / (double v) const;
+    _XOINL Vector3x4 operator / (int v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Comparison Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#comparison_operators
+    _XOINL bool operator == (const Vector3x4& v) const;
+    _XOINL bool operator != (const Vector3x4& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#methods
+    _XOINL Vector4 Magnitude() const;
+    _XOINL Vector4 MagnitudeSquared() const {
+        return Dot(*this, *this);
+    }
+    _XOINL Vector4 Sum() const;
+    _XOINL Vector3x4& Normalize();
+    _XOINL Vector3x4& NormalizeSafe();
+    Vector3x4 Normalized() const {
+        return Vector3x4(*this).Normalize();
+    }
+    Vector3x4 NormalizedSafe() const {
+        return Vector3x4(*this).NormalizeSafe();
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#static_methods
+    _XOINL static void Cross(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec);
+    _XOINL static Vector4 Dot(const Vector3x4& a, const Vector3x4& b);
+    static void Lerp(const Vector3x4& a, const Vector3x4& b, float t, Vector3x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    static void Lerp(const Vector3x4& a, const Vector3x4& b, const Vector4& t, Vector3x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    _XOINL static void Max(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec);
+    _XOINL static void Min(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec);
+    static Vector4 Distance(const Vector3x4& a, const Vector3x4& b) {
+        return (b - a).Magnitude();
+    }
+    static Vector4 DistanceSquared(const Vector3x4& a, const Vector3x4& b) {
+        return (b - a).MagnitudeSquared();
+    }
+
+#define _RET_VARIANT(name) { Vector3x4 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    ////////////////////////////////////////////////////////////////////////// Variants
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#variants
+    Vector4 Distance(const Vector3x4& v) const                                      _THIS_VARIANT1(Distance, v)
+    Vector4 DistanceSquared(const Vector3x4& v) const                               _THIS_VARIANT1(DistanceSquared, v)
+    Vector4 Dot(const Vector3x4& v) const                                           _THIS_VARIANT1(Dot, v)
+    Vector3x4 Cross(const Vector3x4& v) const                                       _THIS_VARIANT1(Cross, v)
+    Vector3x4 Lerp(const Vector3x4& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector3x4 Lerp(const Vector3x4& v, const Vector4& t) const                      _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector3x4 Cross(const Vector3x4& a, const Vector3x4& b)                  _RET_VARIANT_2(Cross, a, b)
+    static Vector3x4 Lerp(const Vector3x4& a, const Vector3x4& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector3x4 Lerp(const Vector3x4& a, const Vector3x4& b, const Vector4& t) _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector3x4 Max(const Vector3x4& a, const Vector3x4& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector3x4 Min(const Vector3x4& a, const Vector3x4& b)                    _RET_VARIANT_2(Min, a, b)
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector3x4& v) {
+        for (int i = 0; i < 4; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x4.html#public_members
+    union {
+        struct {
+            float x[4]; 
+            float y[4]; 
+            float z[4]; 
+        };
+        float f[12]; 
+#if defined(XO_SSE)
+        struct {
+            __m128 xmmX, xmmY, xmmZ;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Vector4x4 {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#constructors
+    Vector4x4() { } 
+    _XOINL Vector4x4(float f); 
+    _XOINL explicit Vector4x4(const Vector4& v); 
+    _XOINL Vector4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3); 
+    _XOINL Vector4x4(const Vector4x4& v); 
+#if defined(XO_SSE)
+    _XOINL Vector4x4(const __m128& x, const __m128& y, const __m128& z, const __m128& w); 
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#set_get_methods
+    _XOINL Vector4x4& Set(const Vector4& v);
+    _XOINL Vector4x4& Set(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3);
+    _XOINL Vector4x4& Set(const Vector4x4& vec);
+    _XOINL Vector4x4& SetLane(int lane, const Vector4& v);
+    _XOINL Vector4 GetLane(int lane) const;
+    _XOINL void Get(Vector4& v0, Vector4& v1, Vector4& v2, Vector4& v3) const;
+
+    ////////////////////////////////////////////////////////////////////////// Load / Store Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#load_store_methods
+    _XOINL static Vector4x4 Load(const Vector4* v);
+    _XOINL static Vector4x4 LoadPartial(const Vector4* v, int count);
+    _XOINL static Vector4x4 LoadSoA(const float* x, const float* y, const float* z, const float* w);
+    _XOINL void Store(Vector4* v) const;
+    _XOINL void StorePartial(Vector4* v, int count) const;
+    _XOINL void StoreSoA(float* x, float* y, float* z, float* w) const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+    _XOINL Vector4x4 operator -() const;
+
+    ////////////////////////////////////////////////////////////////////////// Math Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#math_operators
+    _XOINL Vector4x4& operator += (const Vector4x4& v);
+    _XOINL Vector4x4& operator += (const Vector4& v);
+    _XOINL Vector4x4& operator += (float v);
+    _XOINL Vector4x4& operator += (double v);
+    _XOINL Vector4x4& operator += (int v);
+    _XOINL Vector4x4& operator -= (const Vector4x4& v);
+    _XOINL Vector4x4& operator -= (const Vector4& v);
+    _XOINL Vector4x4& operator -= (float v);
+    _XOINL Vector4x4& operator -= (double v);
+    _XOINL Vector4x4& operator -= (int v);
+    _XOINL Vector4x4& operator *= (const Vector4x4& v);
+    _XOINL Vector4x4& operator *= (const Vector4& v);
+    _XOINL Vector4x4& operator *= (float v);
+    _XOINL Vector4x4& operator *= (double v);
+    _XOINL Vector4x4& operator *= (int v);
+    _XOINL Vector4x4& operator /= (const Vector4x4& v);
+    _XOINL Vector4x4& operator /= (const Vector4& v);
+    _XOINL Vector4x4& operator /= (float v);
+    _XOINL Vector4x4& operator /= (double v);
+    _XOINL Vector4x4& operator /= (int v);
+    _XOINL Vector4x4 operator + (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator + (const Vector4& v) const;
+    _XOINL Vector4x4 operator + (float v) const;
+    _XOINL Vector4x4 operator + (double v) const;
+    _XOINL Vector4x4 operator + (int v) const;
+    _XOINL Vector4x4 operator - (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator - (const Vector4& v) const;
+    _XOINL Vector4x4 operator - (float v) const;
+    _XOINL Vector4x4 operator - (double v) const;
+    _XOINL Vector4x4 operator - (int v) const;
+    _XOINL Vector4x4 operator * (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator * (const Vector4& v) const;
+    _XOINL Vector4x4 operator * (float v) const;
+    _XOINL Vector4x4 operator * (double v) const;
+    _XOINL Vector4x4 operator * (int v) const;
+    _XOINL Vector4x4 operator / (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator / (const Vector4& v) const;
+    _XOINL Vector4x4 operator / (float v) const;
+    _XOINL Vector4x4 operator / (double v) const;
+    _XOINL Vector4x4 operator / (int v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Comparison Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#comparison_operators
+    _XOINL bool operator == (const Vector4x4& v) const;
+    _XOINL bool operator != (const Vector4x4& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#methods
+    _XOINL Vector4 Magnitude() const;
+    _XOINL Vector4 MagnitudeSquared() const {
+        return Dot(*this, *this);
+    }
+    _XOINL Vector4 Sum() const;
+    _XOINL Vector4x4& Normalize();
+    _XOINL Vector4x4& NormalizeSafe();
+    Vector4x4 Normalized() const {
+        return Vector4x4(*this).Normalize();
+    }
+    Vector4x4 NormalizedSafe() const {
+        return Vector4x4(*this).NormalizeSafe();
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#static_methods
+    _XOINL static Vector4 Dot(const Vector4x4& a, const Vector4x4& b);
+    static void Lerp(const Vector4x4& a, const Vector4x4& b, float t, Vector4x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    static void Lerp(const Vector4x4& a, const Vector4x4& b, const Vector4& t, Vector4x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    _XOINL static void Max(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec);
+    _XOINL static void Min(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec);
+    static Vector4 Distance(const Vector4x4& a, const Vector4x4& b) {
+        return (b - a).Magnitude();
+    }
+    static Vector4 DistanceSquared(const Vector4x4& a, const Vector4x4& b) {
+        return (b - a).MagnitudeSquared();
+    }
+
+#define _RET_VARIANT(name) { Vector4x4 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    ////////////////////////////////////////////////////////////////////////// Variants
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#variants
+    Vector4 Distance(const Vector4x4& v) const                                      _THIS_VARIANT1(Distance, v)
+    Vector4 DistanceSquared(const Vector4x4& v) const                               _THIS_VARIANT1(DistanceSquared, v)
+    Vector4 Dot(const Vector4x4& v) const                                           _THIS_VARIANT1(Dot, v)
+    Vector4x4 Lerp(const Vector4x4& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector4x4 Lerp(const Vector4x4& v, const Vector4& t) const                      _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector4x4 Lerp(const Vector4x4& a, const Vector4x4& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x4 Lerp(const Vector4x4& a, const Vector4x4& b, const Vector4& t) _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x4 Max(const Vector4x4& a, const Vector4x4& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector4x4 Min(const Vector4x4& a, const Vector4x4& b)                    _RET_VARIANT_2(Min, a, b)
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector4x4& v) {
+        for (int i = 0; i < 4; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ", w:" << v.w[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#public_members
+    union {
+        struct {
+            float x[4]; 
+            float y[4]; 
+            float z[4]; 
+            float w[4]; 
+        };
+        float f[16]; 
+#if defined(XO_SSE)
+        struct {
+            __m128 xmmX, xmmY, xmmZ, xmmW;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Vector3x8 {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#constructors
+    Vector3x8() { } 
+    _XOINL Vector3x8(float f); 
+    _XOINL Vector3x8(const Vector3& v); 
+    _XOINL Vector3x8(const Vector3x4& low, const Vector3x4& high); 
+    _XOINL Vector3x8(const Vector3x8& v); 
+#if defined(XO_AVX)
+    _XOINL Vector3x8(const __m256& x, const __m256& y, const __m256& z); 
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#set_get_methods
+    _XOINL Vector3x8& Set(const Vector3& v);
+    _XOINL Vector3x8& Set(const Vector3x4& low, const Vector3x4& high);
+    _XOINL Vector3x8& Set(const Vector3x8& vec);
+    _XOINL Vector3x8& SetLane(int lane, const Vector3& v);
+    _XOINL Vector3 GetLane(int lane) const;
+    _XOINL void Get(Vector3x4& low, Vector3x4& high) const;
+
+    ////////////////////////////////////////////////////////////////////////// Load / Store Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#load_store_methods
+    _XOINL static Vector3x8 Load(const Vector3* v);
+    _XOINL static Vector3x8 LoadPartial(const Vector3* v, int count);
+    _XOINL static Vector3x8 LoadSoA(const float* x, const float* y, const float* z);
+    _XOINL void Store(Vector3* v) const;
+    _XOINL void StorePartial(Vector3* v, int count) const;
+    _XOINL void StoreSoA(float* x, float* y, float* z) const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE_32();
+    _XOINL Vector3x8 operator -() const;
+
+    ////////////////////////////////////////////////////////////////////////// Math Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#math_operators
+    _XOINL Vector3x8& operator += (const Vector3x8& v);
+    _XOINL Vector3x8& operator += (const Vector3& v);
+    _XOINL Vector3x8& operator += (float v);
+    _XOINL Vector3x8& operator += (double v);
+    _XOINL Vector3x8& operator += (int v);
+    _XOINL Vector3x8& operator -= (const Vector3x8& v);
+    _XOINL Vector3x8& operator -= (const Vector3& v);
+    _XOINL Vector3x8& operator -= (float v);
+    _XOINL Vector3x8& operator -= (double v);
+    _XOINL Vector3x8& operator -= (int v);
+    _XOINL Vector3x8& operator *= (const Vector3x8& v);
+    _XOINL Vector3x8& operator *= (const Vector3& v);
+    _XOINL Vector3x8& operator *= (float v);
+    _XOINL Vector3x8& operator *= (double v);
+    _XOINL Vector3x8& operator *= (int v);
+    _XOINL Vector3x8& operator /= (const Vector3x8& v);
+    _XOINL Vector3x8& operator /= (const Vector3& v);
+    _XOINL Vector3x8& operator /= (float v);
+    _XOINL Vector3x8& operator /= (double v);
+    _XOINL Vector3x8& operator /= (int v);
+    _XOINL Vector3x8 operator + (const Vector3x8& v) const;
+    _XOINL Vector3x8 operator + (const Vector3& v) const;
+    _XOINL Vector3x8 operator + (float v) const;
+    _XOINL Vector3x8 operator + (double v) const;
+    _XOINL Vector3x8 operator + (int v) const;
+    _XOINL Vector3x8 operator - (const Vector3x8& v) const;
+    _XOINL Vector3x8 operator - (const Vector3& v) const;
+    _XOINL Vector3x8 operator - (float v) const;
+    _XOINL Vector3x8 operator - (double v) const;
+    _XOINL Vector3x8 operator - (int v) const;
+    _XOINL Vector3x8 operator * (const Vector3x8& v) const;
+    _XOINL Vector3x8 operator * (const Vector3& v) const;
+    _XOINL Vector3x8 operator * (float v) const;
+    _XOINL Vector3x8 operator * (double v) const;
+    _XOINL Vector3x8 operator * (int v) const;
+    _XOINL Vector3x8 operator / (const Vector3x8& v) const;
+    _XOINL Vector3x8 operator / (const Vector3& v) const;
+    _XOINL Vector3x8 operator / (float v) const;
+    _XOINL Vector3x8 operator / (double v) const;
+    _XOINL Vector3x8 operator / (int v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Comparison Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#comparison_operators
+    _XOINL bool operator == (const Vector3x8& v) const;
+    _XOINL bool operator != (const Vector3x8& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#methods
+    _XOINL void Magnitude(float* outMagnitudes) const;
+    _XOINL void MagnitudeSquared(float* outMagnitudes) const {
+        Dot(*this, *this, outMagnitudes);
+    }
+    _XOINL void Sum(float* outSums) const;
+    _XOINL Vector3x8& Normalize();
+    _XOINL Vector3x8& NormalizeSafe();
+    Vector3x8 Normalized() const {
+        return Vector3x8(*this).Normalize();
+    }
+    Vector3x8 NormalizedSafe() const {
+        return Vector3x8(*this).NormalizeSafe();
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#static_methods
+    _XOINL static void Cross(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec);
+    _XOINL static void Dot(const Vector3x8& a, const Vector3x8& b, float* outDots);
+    static void Lerp(const Vector3x8& a, const Vector3x8& b, float t, Vector3x8& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    _XOINL static void Lerp(const Vector3x8& a, const Vector3x8& b, const float* t, Vector3x8& outVec);
+    _XOINL static void Max(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec);
+    _XOINL static void Min(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec);
+    static void Distance(const Vector3x8& a, const Vector3x8& b, float* outDistances) {
+        (b - a).Magnitude(outDistances);
+    }
+    static void DistanceSquared(const Vector3x8& a, const Vector3x8& b, float* outDistances) {
+        (b - a).MagnitudeSquared(outDistances);
+    }
+
+#define _RET_VARIANT(name) { Vector3x8 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    ////////////////////////////////////////////////////////////////////////// Variants
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#variants
+    Vector3x8 Cross(const Vector3x8& v) const                                       _THIS_VARIANT1(Cross, v)
+    Vector3x8 Lerp(const Vector3x8& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector3x8 Lerp(const Vector3x8& v, const float* t) const                        _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector3x8 Cross(const Vector3x8& a, const Vector3x8& b)                  _RET_VARIANT_2(Cross, a, b)
+    static Vector3x8 Lerp(const Vector3x8& a, const Vector3x8& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector3x8 Lerp(const Vector3x8& a, const Vector3x8& b, const float* t)   _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector3x8 Max(const Vector3x8& a, const Vector3x8& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector3x8 Min(const Vector3x8& a, const Vector3x8& b)                    _RET_VARIANT_2(Min, a, b)
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector3x8& v) {
+        for (int i = 0; i < 8; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#public_members
+    union {
+        struct {
+            float x[8]; 
+            float y[8]; 
+            float z[8]; 
+        };
+        float f[24]; 
+#if defined(XO_AVX)
+        struct {
+            __m256 ymmX, ymmY, ymmZ;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Vector4x8 {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#constructors
+    Vector4x8() { } 
+    _XOINL Vector4x8(float f); 
+    _XOINL explicit Vector4x8(const Vector4& v); 
+    _XOINL Vector4x8(const Vector4x4& low, const Vector4x4& high); 
+    _XOINL Vector4x8(const Vector4x8& v); 
+#if defined(XO_AVX)
+    _XOINL Vector4x8(const __m256& x, const __m256& y, const __m256& z, const __m256& w); 
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#set_get_methods
+    _XOINL Vector4x8& Set(const Vector4& v);
+    _XOINL Vector4x8& Set(const Vector4x4& low, const Vector4x4& high);
+    _XOINL Vector4x8& Set(const Vector4x8& vec);
+    _XOINL Vector4x8& SetLane(int lane, const Vector4& v);
+    _XOINL Vector4 GetLane(int lane) const;
+    _XOINL void Get(Vector4x4& low, Vector4x4& high) const;
+
+    ////////////////////////////////////////////////////////////////////////// Load / Store Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#load_store_methods
+    _XOINL static Vector4x8 Load(const Vector4* v);
+    _XOINL static Vector4x8 LoadPartial(const Vector4* v, int count);
+    _XOINL static Vector4x8 LoadSoA(const float* x, const float* y, const float* z, const float* w);
+    _XOINL void Store(Vector4* v) const;
+    _XOINL void StorePartial(Vector4* v, int count) const;
+    _XOINL void StoreSoA(float* x, float* y, float* z, float* w) const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE_32();
+    _XOINL Vector4x8 operator -() const;
+
+    ////////////////////////////////////////////////////////////////////////// Math Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#math_operators
+    _XOINL Vector4x8& operator += (const Vector4x8& v);
+    _XOINL Vector4x8& operator += (const Vector4& v);
+    _XOINL Vector4x8& operator += (float v);
+    _XOINL Vector4x8& operator += (double v);
+    _XOINL Vector4x8& operator += (int v);
+    _XOINL Vector4x8& operator -= (const Vector4x8& v);
+    _XOINL Vector4x8& operator -= (const Vector4& v);
+    _XOINL Vector4x8& operator -= (float v);
+    _XOINL Vector4x8& operator -= (double v);
+    _XOINL Vector4x8& operator -= (int v);
+    _XOINL Vector4x8& operator *= (const Vector4x8& v);
+    _XOINL Vector4x8& operator *= (const Vector4& v);
+    _XOINL Vector4x8& operator *= (float v);
+    _XOINL Vector4x8& operator *= (double v);
+    _XOINL Vector4x8& operator *= (int v);
+    _XOINL Vector4x8& operator /= (const Vector4x8& v);
+    _XOINL Vector4x8& operator /= (const Vector4& v);
+    _XOINL Vector4x8& operator /= (float v);
+    _XOINL Vector4x8& operator /= (double v);
+    _XOINL Vector4x8& operator /= (int v);
+    _XOINL Vector4x8 operator + (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator + (const Vector4& v) const;
+    _XOINL Vector4x8 operator + (float v) const;
+    _XOINL Vector4x8 operator + (double v) const;
+    _XOINL Vector4x8 operator + (int v) const;
+    _XOINL Vector4x8 operator - (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator - (const Vector4& v) const;
+    _XOINL Vector4x8 operator - (float v) const;
+    _XOINL Vector4x8 operator - (double v) const;
+    _XOINL Vector4x8 operator - (int v) const;
+    _XOINL Vector4x8 operator * (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator * (const Vector4& v) const;
+    _XOINL Vector4x8 operator * (float v) const;
+    _XOINL Vector4x8 operator * (double v) const;
+    _XOINL Vector4x8 operator * (int v) const;
+    _XOINL Vector4x8 operator / (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator / (const Vector4& v) const;
+    _XOINL Vector4x8 operator / (float v) const;
+    _XOINL Vector4x8 operator / (double v) const;
+    _XOINL Vector4x8 operator / (int v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Comparison Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#comparison_operators
+    _XOINL bool operator == (const Vector4x8& v) const;
+    _XOINL bool operator != (const Vector4x8& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#methods
+    _XOINL void Magnitude(float* outMagnitudes) const;
+    _XOINL void MagnitudeSquared(float* outMagnitudes) const {
+        Dot(*this, *this, outMagnitudes);
+    }
+    _XOINL void Sum(float* outSums) const;
+    _XOINL Vector4x8& Normalize();
+    _XOINL Vector4x8& NormalizeSafe();
+    Vector4x8 Normalized() const {
+        return Vector4x8(*this).Normalize();
+    }
+    Vector4x8 NormalizedSafe() const {
+        return Vector4x8(*this).NormalizeSafe();
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#static_methods
+    _XOINL static void Dot(const Vector4x8& a, const Vector4x8& b, float* outDots);
+    static void Lerp(const Vector4x8& a, const Vector4x8& b, float t, Vector4x8& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    _XOINL static void Lerp(const Vector4x8& a, const Vector4x8& b, const float* t, Vector4x8& outVec);
+    _XOINL static void Max(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec);
+    _XOINL static void Min(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec);
+    static void Distance(const Vector4x8& a, const Vector4x8& b, float* outDistances) {
+        (b - a).Magnitude(outDistances);
+    }
+    static void DistanceSquared(const Vector4x8& a, const Vector4x8& b, float* outDistances) {
+        (b - a).MagnitudeSquared(outDistances);
+    }
+
+#define _RET_VARIANT(name) { Vector4x8 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    ////////////////////////////////////////////////////////////////////////// Variants
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#variants
+    Vector4x8 Lerp(const Vector4x8& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector4x8 Lerp(const Vector4x8& v, const float* t) const                        _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector4x8 Lerp(const Vector4x8& a, const Vector4x8& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x8 Lerp(const Vector4x8& a, const Vector4x8& b, const float* t)   _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x8 Max(const Vector4x8& a, const Vector4x8& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector4x8 Min(const Vector4x8& a, const Vector4x8& b)                    _RET_VARIANT_2(Min, a, b)
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x8.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector4x8& v) {
+        for (int i = 0; i < 8; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ", w:" << v.w[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#public_members
+    union {
+        struct {
+            float x[8]; 
+            float y[8]; 
+            float z[8]; 
+            float w[8]; 
+        };
+        float f[32]; 
+#if defined(XO_AVX)
+        struct {
+            __m256 ymmX, ymmY, ymmZ, ymmW;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+// Runtime CPU dispatch.
+//
+// The batch functions (Matrix4x4::TransformPoints, Matrix4x4::MultiplyBatch, the trig array functions and so on)
+// call through a table of kernels. The table is picked by InitDispatch, which runs automatically on the first call
+// to any batch function. A binary compiled for SSE2 will still use the AVX and AVX2 kernels when the CPU and
+// operating system support them, as long as XO_DISPATCH is defined (see DetectSIMD.h).
+//
+// The kernels compiled without XO_DISPATCH are only those the compiler targets, and InitDispatch then picks the
+// highest of them without checking the CPU.
+//
+// The AVX-512 kernels use mask registers for the ends of arrays. AVX-512 includes FMA, so the compiler may fuse 
+// their multiplies and adds, and results can differ from the other tiers in the last bit.
+
+enum class SIMDTier {
+    None,   
+    SSE2,
+    AVX,
+    AVX2,
+    AVX512,
+};
+
+SIMDTier DetectSIMDTier();
+
+void InitDispatch(SIMDTier maxTier = SIMDTier::AVX512);
+
+SIMDTier GetDispatchTier();
+
+const char* GetSIMDTierName(SIMDTier tier);
+
+namespace xo_internal
+{
+    // The blends of Quaternion::SlerpBatch, NlerpBatch and FastSlerpBatch, which share their kernels.
+    enum class QuaternionBlend {
+        Slerp,
+        Nlerp,
+        FastSlerp,
+    };
+
+    // The baseline kernels, built for what the compiler targets. Without SSE2 these are called directly.
+    void TransformVector3Array(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    void TransformVector4Array(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    void MultiplyBatch(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    void MultiplyIndexedBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    void SinCosArray(const float* f, float* s, float* c, size_t n, bool fast);
+    void DotVector3Array(const Vector3* a, const Vector3* b, float* out, size_t n);
+    void NormalizeVector3Array(const Vector3* in, Vector3* out, size_t n);
+    void RotateVector3Batch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+    void BlendQuaternionBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+    void SkinVertices(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                      const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    void SkinVerticesDualQuaternion(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                    const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    void FloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+    void HalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+    void TransformFloat3Array(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+
+#if defined(XO_SSE2)
+    // The kernels behind the batch functions. One table is built per tier, see Dispatch.cpp.
+    struct DispatchKernels {
+        SIMDTier tier;
+        void (*transformVector3Array)(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+        void (*transformVector4Array)(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+        // aStep and bStep are 1 to step through an array, or 0 to use the same matrix for every product.
+        void (*multiplyBatch)(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+        // out[i] = a[aIndices[i]] * b[i].
+        void (*multiplyIndexedBatch)(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+        // ok may be null, and in may be out.
+        void (*inverseBatch)(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+        // s or c may be null when that output isn't wanted.
+        void (*sinCosArray)(const float* f, float* s, float* c, size_t n, bool fast);
+        void (*dotVector3Array)(const Vector3* a, const Vector3* b, float* out, size_t n);
+        // in may be out.
+        void (*normalizeVector3Array)(const Vector3* in, Vector3* out, size_t n);
+        // out[i] = q[i].Rotate(in[i]). in may be out.
+        void (*rotateVector3Batch)(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+        // out may be a or b.
+        void (*blendQuaternionBatch)(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+        // The rows of bone b are palette[b * boneStride] to palette[b * boneStride + 2]. normals may be null, and
+        // the outputs may be the inputs.
+        void (*skinVertices)(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                             const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+        // As skinVertices, blending the bones as dual quaternions.
+        void (*skinVerticesDualQuaternion)(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                           const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+        // Converts the first components floats of each element, in[i * inStride] onward, to halves packed
+        // components to an element.
+        void (*floatToHalfArray)(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+        // The reverse of floatToHalfArray.
+        void (*halfToFloatArray)(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+        // transformVector3Array on packed points. in may be out.
+        void (*transformFloat3Array)(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+    };
+
+    // Returns the selected table, selecting one first if needed.
+    const DispatchKernels& GetDispatchKernels();
+
+#   if defined(_XO_KERNELS_AVX)
+    // A mask for _mm256_maskload_ps and _mm256_maskstore_ps with the first n of 8 lanes set, for the tail of an array.
+    _XOINL _XO_TARGET_AVX __m256i TailMask(size_t n) {
+        static const int lanes[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+        return _mm256_loadu_si256((const __m256i*)(lanes + 8 - n));
+    }
+
+    // In-lane _MM_TRANSPOSE4_PS, which transposes the low and high 128 bit lanes of v as two separate 4x4s.
+    _XOINL _XO_TARGET_AVX void TransposeLanes4x4(__m256 v[4]) {
+        __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]), t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]), t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        v[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        v[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        v[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        v[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    _XO_TARGET_AVX void TransformVector3ArrayAVX(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    _XO_TARGET_AVX void TransformVector4ArrayAVX(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    _XO_TARGET_AVX void MultiplyBatchAVX(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX void MultiplyIndexedBatchAVX(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX void InverseBatchAVX(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    _XO_TARGET_AVX void DotVector3ArrayAVX(const Vector3* a, const Vector3* b, float* out, size_t n);
+    _XO_TARGET_AVX void NormalizeVector3ArrayAVX(const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX void RotateVector3BatchAVX(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX void BlendQuaternionBatchAVX(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+    _XO_TARGET_AVX void SkinVerticesAVX(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                        const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    _XO_TARGET_AVX void SkinVerticesDualQuaternionAVX(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                      const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    _XO_TARGET_AVX void TransformFloat3ArrayAVX(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+#   endif
+#   if defined(_XO_KERNELS_AVX2)
+    _XO_TARGET_AVX2 void SinCosArrayAVX2(const float* f, float* s, float* c, size_t n, bool fast);
+    _XO_TARGET_AVX2 void FloatToHalfArrayF16C(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+    _XO_TARGET_AVX2 void HalfToFloatArrayF16C(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+#   endif
+#   if defined(_XO_KERNELS_AVX512)
+    // A mask register with the first n of 16 lanes set, or all of them when n is 16 or more.
+    _XOINL __mmask16 TailMask16(size_t n) {
+        return n >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << n) - 1);
+    }
+
+    _XO_TARGET_AVX512 void TransformVector3ArrayAVX512(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    _XO_TARGET_AVX512 void TransformVector4ArrayAVX512(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    _XO_TARGET_AVX512 void MultiplyBatchAVX512(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX512 void MultiplyIndexedBatchAVX512(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX512 void InverseBatchAVX512(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    _XO_TARGET_AVX512 void SinCosArrayAVX512(const float* f, float* s, float* c, size_t n, bool fast);
+    _XO_TARGET_AVX512 void DotVector3ArrayAVX512(const Vector3* a, const Vector3* b, float* out, size_t n);
+    _XO_TARGET_AVX512 void NormalizeVector3ArrayAVX512(const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX512 void RotateVector3BatchAVX512(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+#   endif
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+float& Vector2::operator [](int i) { return f[i]; }
+const float& Vector2::operator [](int i) const { return f[i]; }
+
+Vector2 Vector2::operator - () const { return Vector2(-x, -y); }
+Vector2 Vector2::operator ~ () const { return Vector2(y, x); }
+
+Vector2& Vector2::operator += (const Vector2& v) {
+    x += v.x;
+    y += v.y;
+    return *this; 
+}
+Vector2& Vector2::operator += (float v) {
+    x += v;
+    y += v;
+    return *this; 
+}
+Vector2& Vector2::operator += (double v)                  { return *this += (float)v; }
+Vector2& Vector2::operator += (int v)                     { return *this += (float)v; }
+Vector2& Vector2::operator += (const class Vector3& v)    { return *this += Vector2(v); }
+Vector2& Vector2::operator += (const class Vector4& v)    { return *this += Vector2(v); }
+
+Vector2& Vector2::operator -= (const Vector2& v) {
+    x -= v.x;
+    y -= v.y;
+    return *this; 
+}
+Vector2& Vector2::operator -= (float v) {
+    x -= v;
+    y -= v;
+    return *this; 
+}
+Vector2& Vector2::operator -= (double v)                  { return *this -= (float)v; }
+Vector2& Vector2::operator -= (int v)                     { return *this -= (float)v; }
+Vector2& Vector2::operator -= (const class Vector3& v)    { return *this -= Vector2(v); }
+Vector2& Vector2::operator -= (const class Vector4& v)    { return *this -= Vector2(v); }
+
+Vector2& Vector2::operator *= (const Vector2& v) {
+    x *= v.x;
+    y *= v.y;
     return *this; 
 }
-Vector2& Vector2::operator *= (float v) {
-    x *= v;
-    y *= v;
-    return *this;
+Vector2& Vector2::operator *= (float v) {
+    x *= v;
+    y *= v;
+    return *this;
+}
+Vector2& Vector2::operator *= (double v)                  { return *this *= (float)v; }
+Vector2& Vector2::operator *= (int v)                     { return *this *= (float)v; }
+Vector2& Vector2::operator *= (const class Vector3& v)    { return *this *= Vector2(v); }
+Vector2& Vector2::operator *= (const class Vector4& v)    { return *this *= Vector2(v); }
+
+Vector2& Vector2::operator /= (const Vector2& v) {
+    x /= v.x;
+    y /= v.y;
+    return *this;
+}
+Vector2& Vector2::operator /= (float v) {
+#if defined(XO_NO_INVERSE_DIVISION)
+    x /= v;
+    y /= v;
+    return *this;
+#else
+    return (*this) *= (1.0f/v);
+#endif
+    
+}
+Vector2& Vector2::operator /= (double v)                  { return *this /= (float)v; }
+Vector2& Vector2::operator /= (int v)                     { return *this /= (float)v; }
+Vector2& Vector2::operator /= (const class Vector3& v)    { return *this /= Vector2(v); }
+Vector2& Vector2::operator /= (const class Vector4& v)    { return *this /= Vector2(v); }
+
+Vector2 Vector2::operator + (const Vector2& v) const        { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (float v) const                 { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (double v) const                { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (int v) const                   { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (const class Vector3& v) const  { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (const class Vector4& v) const  { return Vector2(*this) += v; }
+
+Vector2 Vector2::operator - (const Vector2& v) const        { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (float v) const                 { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (double v) const                { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (int v) const                   { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (const class Vector3& v) const  { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (const class Vector4& v) const  { return Vector2(*this) -= v; }
+
+Vector2 Vector2::operator * (const Vector2& v) const        { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (float v) const                 { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (double v) const                { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (int v) const                   { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (const class Vector3& v) const  { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (const class Vector4& v) const  { return Vector2(*this) *= v; }
+
+Vector2 Vector2::operator / (const Vector2& v) const        { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (float v) const                 { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (double v) const                { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (int v) const                   { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (const class Vector3& v) const  { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (const class Vector4& v) const  { return Vector2(*this) /= v; }
+
+bool Vector2::operator < (const Vector2& v) const           { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector2::operator < (float v) const                    { return MagnitudeSquared() < (v * v); }
+bool Vector2::operator < (double v) const                   { return MagnitudeSquared() < (float)(v * v); }
+bool Vector2::operator < (int v) const                      { return MagnitudeSquared() < (float)(v * v); }
+bool Vector2::operator < (const class Vector3& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector2::operator < (const class Vector4& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector2::operator <= (const Vector2& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector2::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
+bool Vector2::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector2::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector2::operator <= (const class Vector3& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector2::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector2::operator > (const Vector2& v) const           { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector2::operator > (float v) const                    { return MagnitudeSquared() > (v * v); }
+bool Vector2::operator > (double v) const                   { return MagnitudeSquared() > (float)(v * v); }
+bool Vector2::operator > (int v) const                      { return MagnitudeSquared() > (float)(v * v); }
+bool Vector2::operator > (const class Vector3& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector2::operator > (const class Vector4& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector2::operator >= (const Vector2& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector2::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
+bool Vector2::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector2::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector2::operator >= (const class Vector3& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector2::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector2::operator == (const Vector2& v) const {
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(x, v.x, Epsilon);
+}
+bool Vector2::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon); }
+bool Vector2::operator == (double v) const                  { return *this == (float)(v*v); }
+bool Vector2::operator == (int v) const                     { return *this == (float)(v*v); }
+bool Vector2::operator == (const class Vector3& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+bool Vector2::operator == (const class Vector4& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+
+bool Vector2::operator != (const Vector2& v) const          { return !((*this) == v); }
+bool Vector2::operator != (float v) const                   { return !((*this) == v); }
+bool Vector2::operator != (double v) const                  { return !((*this) == v); }
+bool Vector2::operator != (int v) const                     { return !((*this) == v); }
+bool Vector2::operator != (const class Vector3& v) const    { return !((*this) == v); }
+bool Vector2::operator != (const class Vector4& v) const    { return !((*this) == v); }
+
+_XOINL 
+Vector2 Abs(const Vector2& v)
+{
+    return Vector2(Abs(v.x), Abs(v.y));
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+Vector3::operator __m128() const {
+    return xmm;
+}
+#endif
+
+float& Vector3::operator [](int i) {
+    return f[i];
+}
+
+const float& Vector3::operator [](int i) const {
+    return f[i];
+}
+
+Vector3 Vector3::operator -() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_mul_ps(xmm, sse::NegativeOne));
+#else
+    return Vector3(-x, -y, -z);
+#endif
+}
+
+Vector3 Vector3::operator ~() const {
+    return ZYX();
+}
+
+Vector3& Vector3::operator += (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, v);
+#else
+    x += v.x;
+    y += v.y;
+    z += v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator += (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+#else
+    x += v;
+    y += v;
+    z += v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator += (double v)                  { return (*this) += float(v); }
+Vector3& Vector3::operator += (int v)                     { return (*this) += float(v); }
+Vector3& Vector3::operator += (const class Vector2& v)    { return (*this) += Vector3(v); }
+Vector3& Vector3::operator += (const class Vector4& v)    { return (*this) += Vector3(v); }
+
+Vector3& Vector3::operator -= (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, v);
+#else
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator -= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+#else
+    x -= v;
+    y -= v;
+    z -= v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator -= (double v)                  { return (*this) -= float(v); }
+Vector3& Vector3::operator -= (int v)                     { return (*this) -= float(v); }
+Vector3& Vector3::operator -= (const class Vector2& v)    { return (*this) -= Vector3(v); }
+Vector3& Vector3::operator -= (const class Vector4& v)    { return (*this) -= Vector3(v); }
+
+Vector3& Vector3::operator *= (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, v);
+#else
+    x *= v.x;
+    y *= v.y;
+    z *= v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator *= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+#else
+    x *= v;
+    y *= v;
+    z *= v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator *= (double v)                  { return (*this) *= float(v); }
+Vector3& Vector3::operator *= (int v)                     { return (*this) *= float(v); }
+Vector3& Vector3::operator *= (const class Vector2& v)    { return (*this) *= Vector3(v); }
+Vector3& Vector3::operator *= (const class Vector4& v)    { return (*this) *= Vector3(v); }
+
+#if defined(XO_NO_INVERSE_DIVISION)
+Vector3& Vector3::operator /= (const Vector3& v) {
+#if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_div_ps
+    // -----------------------------------
+    // Architecture    Latency Throughput
+    // Haswell         13      5
+    // Ivy Bridge      13      6
+    // Sandy Bridge    14      14
+    // Westmere        14      12
+    // Nehalem         14      12
+    xmm = _mm_div_ps(xmm, v);
+#else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+#endif
+
+    return *this;
+}
+
+Vector3& Vector3::operator /= (float v) {
+#   if defined(XO_SSE)
+    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
+#   else
+    x /= v;
+    y /= v;
+    z /= v;
+#   endif
+    return *this;
+}
+#else
+
+Vector3& Vector3::operator /= (const Vector3& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_rcp_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        1
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        3        2
+    // Nehalem         3        2
+
+    // _mm_mul_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        0.5
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        4        1
+    // Nehalem         4        1
+    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v));
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+#   endif
+
+    return *this;
+}
+
+Vector3& Vector3::operator /= (float v) { 
+#   if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
+#   else
+    v = 1.0f / v;
+    x *= v;
+    y *= v;
+    z *= v;
+#   endif
+    return *this;
+}
+#endif
+Vector3& Vector3::operator /= (double v)                    { return (*this) /= float(v); }
+Vector3& Vector3::operator /= (int v)                       { return (*this) /= float(v); }
+Vector3& Vector3::operator /= (const class Vector2& v)      { return (*this) /= Vector3(v); }
+Vector3& Vector3::operator /= (const class Vector4& v)      { return (*this) /= Vector3(v); }
+
+Vector3 Vector3::operator + (const Vector3& v) const        { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (float v) const                 { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (double v) const                { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (int v) const                   { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (const class Vector2& v) const  { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (const class Vector4& v) const  { return Vector3(*this) += v; }
+
+Vector3 Vector3::operator - (const Vector3& v) const        { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (float v) const                 { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (double v) const                { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (int v) const                   { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (const class Vector2& v) const  { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (const class Vector4& v) const  { return Vector3(*this) -= v; }
+
+Vector3 Vector3::operator * (const Vector3& v) const        { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (float v) const                 { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (double v) const                { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (int v) const                   { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (const class Vector2& v) const  { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (const class Vector4& v) const  { return Vector3(*this) *= v; }
+
+Vector3 Vector3::operator / (const Vector3& v) const        { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (float v) const                 { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (double v) const                { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (int v) const                   { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (const class Vector2& v) const  { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (const class Vector4& v) const  { return Vector3(*this) /= v; }
+
+
+bool Vector3::operator < (const Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector3::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
+bool Vector3::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
+bool Vector3::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
+bool Vector3::operator < (const class Vector2& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector3::operator < (const class Vector4& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector3::operator <= (const Vector3& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector3::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
+bool Vector3::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector3::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector3::operator <= (const class Vector2& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector3::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector3::operator > (const Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector3::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
+bool Vector3::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
+bool Vector3::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
+bool Vector3::operator > (const class Vector2& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector3::operator > (const class Vector4& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector3::operator >= (const Vector3& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector3::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
+bool Vector3::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector3::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector3::operator >= (const class Vector2& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector3::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector3::operator == (const Vector3& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v, xmm)), sse::Epsilon)) & 7) == 7;
+#   elif XO_SSE
+    // TODO: find a faster way with SSE to do a 'close enough' check.
+    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
+    // what we're doing in SSE2
+    return CloseEnough(x, v.x, sse::SSEFloatEpsilon) && CloseEnough(y, v.y, sse::SSEFloatEpsilon) && CloseEnough(z, v.z, sse::SSEFloatEpsilon);
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+#   endif
+}
+bool Vector3::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon);}
+bool Vector3::operator == (double v) const                  { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
+bool Vector3::operator == (int v) const                     { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
+bool Vector3::operator == (const class Vector2& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, v.y, v.x), xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+bool Vector3::operator == (const class Vector4& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+#   endif
+}
+
+bool Vector3::operator != (const Vector3& v) const          { return !((*this) == v); }
+bool Vector3::operator != (float v) const                   { return !((*this) == v); }
+bool Vector3::operator != (double v) const                  { return !((*this) == v); }
+bool Vector3::operator != (int v) const                     { return !((*this) == v); }
+bool Vector3::operator != (const class Vector2& v) const    { return !((*this) == v); }
+bool Vector3::operator != (const class Vector4& v) const    { return !((*this) == v); }
+
+_XOINL
+Vector3 Abs(const Vector3& v)
+{
+#if defined(XO_SSE)
+    return (sse::Abs(v.xmm));
+#else
+    return Vector3(Abs(v.x), Abs(v.y), Abs(v.z));
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+
+#if !defined(IDX_X)
+#   define IDX_X 0
+#endif
+
+#if !defined(IDX_Y)
+#   define IDX_Y 1
+#endif
+
+#if !defined(IDX_Z)
+#   define IDX_Z 2
+#endif
+
+#if !defined(IDX_W)
+#   define IDX_W 3
+#endif
+
+#endif
+
+#if defined(XO_SSE)
+Vector4::operator const __m128&() const {
+    return xmm;
+}
+#endif
+
+float& Vector4::operator [](int i) {
+    return f[i];
+}
+
+const float& Vector4::operator [](int i) const {
+    return f[i];
+}
+
+Vector4 Vector4::operator -() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_mul_ps(xmm, sse::NegativeOne));
+#else
+    return Vector4(-x, -y, -z, -w);
+#endif
+}
+
+Vector4 Vector4::operator ~() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_X, IDX_Y, IDX_Z, IDX_W)));
+#else
+    return Vector4(w, z, y, x);
+#endif
+}
+
+Vector4& Vector4::operator += (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, v.xmm);
+#else
+    x += v.x;
+    y += v.y;
+    z += v.z;
+    w += v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator += (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+#else
+    x += v;
+    y += v;
+    z += v;
+    w += v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator += (double v)          { return (*this) += (float)v; }
+Vector4& Vector4::operator += (int v)             { return (*this) += (float)v; }
+Vector4& Vector4::operator += (const class Vector2& v)  { return (*this) += Vector4(v); }
+Vector4& Vector4::operator += (const class Vector3& v)  { return (*this) += Vector4(v); }
+
+Vector4& Vector4::operator -= (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, v.xmm);
+#else
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+    w -= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator -= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+#else
+    x -= v;
+    y -= v;
+    z -= v;
+    w -= v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator -= (double v)          { return (*this) -= (float)v; }
+Vector4& Vector4::operator -= (int v)             { return (*this) -= (float)v; }
+Vector4& Vector4::operator -= (const class Vector2& v)  { return (*this) -= Vector4(v); }
+Vector4& Vector4::operator -= (const class Vector3& v)  { return (*this) -= Vector4(v); }
+
+Vector4& Vector4::operator *= (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, v.xmm);
+#else
+    x *= v.x;
+    y *= v.y;
+    z *= v.z;
+    w *= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator *= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+#else
+    x *= v;
+    y *= v;
+    z *= v;
+    w *= v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator *= (double v)          { return (*this) *= (float)v; }
+Vector4& Vector4::operator *= (int v)             { return (*this) *= (float)v; }
+Vector4& Vector4::operator *= (const class Vector2& v)  { return (*this) *= Vector4(v); }
+Vector4& Vector4::operator *= (const class Vector3& v)  { return (*this) *= Vector4(v); }
+
+#if defined(XO_NO_INVERSE_DIVISION)
+Vector4& Vector4::operator /= (const Vector4& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_div_ps
+    // -----------------------------------
+    // Architecture    Latency Throughput
+    // Haswell         13      5
+    // Ivy Bridge      13      6
+    // Sandy Bridge    14      14
+    // Westmere        14      12
+    // Nehalem         14      12
+    xmm = _mm_div_ps(xmm, v.xmm);
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+    w /= v.w;
+#   endif
+    return *this;
+}
+
+Vector4& Vector4::operator /= (float v) {
+#   if defined(XO_SSE)
+    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
+#   else
+    x /= v;
+    y /= v;
+    z /= v;
+    w /= v;
+#   endif
+    return *this;
+}
+#else
+
+Vector4& Vector4::operator /= (const Vector4& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_rcp_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        1
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        3        2
+    // Nehalem         3        2
+
+    // _mm_mul_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        0.5
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        4        1
+    // Nehalem         4        1
+    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v.xmm));
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+    w /= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator /= (float v) { 
+#   if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
+#   else
+    v = 1.0f / v;
+    x *= v;
+    y *= v;
+    z *= v;
+    w *= v;
+#   endif
+    return *this;
+}
+#endif
+Vector4& Vector4::operator /= (double v)          { return (*this) /= float(v); }
+Vector4& Vector4::operator /= (int v)             { return (*this) /= float(v); }
+Vector4& Vector4::operator /= (const class Vector2& v)  { return (*this) /= Vector4(v); }
+Vector4& Vector4::operator /= (const class Vector3& v)  { return (*this) /= Vector4(v); }
+
+Vector4 Vector4::operator + (const Vector4& v) const    { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (float v) const             { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (double v) const            { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (int v) const               { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (const class Vector2& v) const    { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (const class Vector3& v) const    { return Vector4(*this) += v; }
+
+Vector4 Vector4::operator - (const Vector4& v) const    { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (float v) const             { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (double v) const            { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (int v) const               { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (const class Vector2& v) const    { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (const class Vector3& v) const    { return Vector4(*this) -= v; }
+
+Vector4 Vector4::operator * (const Vector4& v) const    { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (float v) const             { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (double v) const            { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (int v) const               { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (const class Vector2& v) const    { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (const class Vector3& v) const    { return Vector4(*this) *= v; }
+
+Vector4 Vector4::operator / (const Vector4& v) const    { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (float v) const             { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (double v) const            { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (int v) const               { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (const class Vector2& v) const    { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (const class Vector3& v) const    { return Vector4(*this) /= v; }
+
+bool Vector4::operator < (const Vector4& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector4::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
+bool Vector4::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
+bool Vector4::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
+bool Vector4::operator < (const class Vector2& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector4::operator < (const class Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector4::operator <= (const Vector4& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector4::operator <= (float v) const               { return MagnitudeSquared() <= (v * v); }
+bool Vector4::operator <= (double v) const              { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector4::operator <= (int v) const                 { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector4::operator <= (const class Vector2& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector4::operator <= (const class Vector3& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector4::operator > (const Vector4& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector4::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
+bool Vector4::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
+bool Vector4::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
+bool Vector4::operator > (const class Vector2& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector4::operator > (const class Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector4::operator >= (const Vector4& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector4::operator >= (float v) const               { return MagnitudeSquared() >= (v * v); }
+bool Vector4::operator >= (double v) const              { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector4::operator >= (int v) const                 { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector4::operator >= (const class Vector2& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector4::operator >= (const class Vector3& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector4::operator == (const Vector4& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 15) == 15;
+#   elif XO_SSE
+    // TODO: find a faster way with SSE to do a 'close enough' check.
+    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
+    // what we're doing in SSE2
+    return 
+        CloseEnough(x, v.x, sse::SSEFloatEpsilon) && 
+        CloseEnough(y, v.y, sse::SSEFloatEpsilon) && 
+        CloseEnough(z, v.z, sse::SSEFloatEpsilon) &&
+        CloseEnough(w, v.w, sse::SSEFloatEpsilon);
+#   else
+    return 
+        CloseEnough(x, v.x, Epsilon) && 
+        CloseEnough(y, v.y, Epsilon) && 
+        CloseEnough(z, v.z, Epsilon) &&
+        CloseEnough(w, v.w, Epsilon);
+#   endif
+}
+bool Vector4::operator == (float v) const           { return CloseEnough(MagnitudeSquared(), v * v, Epsilon); }
+bool Vector4::operator == (double v) const          { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
+bool Vector4::operator == (int v) const             { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
+
+bool Vector4::operator == (const class Vector2& v) const {
+#   if defined(XO_SSE)
+    // Todo: check that this is actually faster.
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(xmm, _mm_set_ps(0.0f, 0.0f, v.y, v.x))), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+
+bool Vector4::operator == (const class Vector3& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+#   endif
+}
+
+bool Vector4::operator != (const Vector4& v) const  { return !((*this) == v); }
+bool Vector4::operator != (float v) const           { return !((*this) == v); }
+bool Vector4::operator != (double v) const          { return !((*this) == v); }
+bool Vector4::operator != (int v) const             { return !((*this) == v); }
+bool Vector4::operator != (const class Vector2& v) const  { return !((*this) == v); }
+bool Vector4::operator != (const class Vector3& v) const  { return !((*this) == v); }
+
+_XOINL 
+Vector4 Abs(const Vector4& v)
+{
+#if defined(XO_SSE)
+    return (sse::Abs(v.xmm));
+#else
+    return Vector4(Abs(v.x), Abs(v.y), Abs(v.z));
+#endif
+}
+
+#undef IDX_X
+#undef IDX_Y
+#undef IDX_Z
+#undef IDX_W
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace sse {
+    _XOINL __m128 LinearCombination(__m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+
+#   if defined(_XO_KERNELS_AVX)
+    _XOINL _XO_TARGET_AVX __m256 LinearCombination(__m256 a, __m256 b0, __m256 b1, __m256 b2, __m256 b3) {
+        return _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+#   endif
+}
+#endif
+
+const Vector4& Matrix4x4::operator [](int i) const {
+    return r[i];
+}
+
+Vector4& Matrix4x4::operator [](int i) {
+    return r[i];
+}
+
+const float& Matrix4x4::operator ()(int r, int c) const {
+    return this->r[r][c];
+}
+
+float& Matrix4x4::operator ()(int r, int c) {
+    return this->r[r][c];
+}
+
+Matrix4x4 Matrix4x4::operator ~() const {
+    auto m = *this;
+    return m.Transpose();
+}
+
+Matrix4x4& Matrix4x4::operator += (const Matrix4x4& m) {
+    r[0] += m[0];
+    r[1] += m[1];
+    r[2] += m[2];
+    r[3] += m[3];
+    return *this;
+}
+
+Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
+    r[0] -= m[0];
+    r[1] -= m[1];
+    r[2] -= m[2];
+    r[3] -= m[3];
+    return *this;
+}
+
+Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
+    // Each row of the product is a linear combination of the rows of m, weighted by the same row of this.
+    // This avoids the transpose and 16 horizontal sums of the dot product form.
+    // AVX is left to Matrix4x4::MultiplyBatch. For a lone product, packing two rows into one ymm register 
+    // measured slower than this, as the 256 bit loads stall on the 128 bit row stores that usually precede them.
+#if defined(XO_SSE)
+    // m may be this, so its rows are loaded before any are written.
+    __m128 b0 = m.r[0].xmm, b1 = m.r[1].xmm, b2 = m.r[2].xmm, b3 = m.r[3].xmm;
+    r[0].xmm = sse::LinearCombination(r[0].xmm, b0, b1, b2, b3);
+    r[1].xmm = sse::LinearCombination(r[1].xmm, b0, b1, b2, b3);
+    r[2].xmm = sse::LinearCombination(r[2].xmm, b0, b1, b2, b3);
+    r[3].xmm = sse::LinearCombination(r[3].xmm, b0, b1, b2, b3);
+#else
+    Matrix4x4 b(m);
+    for (int i = 0; i < 4; ++i) {
+        Vector4 a = r[i];
+        r[i] = (b.r[0] * a.x) + (b.r[1] * a.y) + (b.r[2] * a.z) + (b.r[3] * a.w);
+    }
+#endif
+    return *this;
+}
+
+Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
+Matrix4x4 Matrix4x4::operator - (const Matrix4x4& m) const { return Matrix4x4(*this) -= m; }
+Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const { return Matrix4x4(*this) *= m; }
+
+Vector4 Matrix4x4::operator * (const Vector4& v) const {
+    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), (r[3] * v).Sum());
+}
+
+Vector3 Matrix4x4::operator * (const Vector3& v) const {
+    return Vector3((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum());
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace sse {
+    _XOINL __m128 AffineCombination(__m128 a, __m128 b0, __m128 b1, __m128 b2) {
+        const __m128 wMask = _mm_set_ps(HexFloat(0xffffffff), 0.0f, 0.0f, 0.0f);
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm_and_ps(wMask, a)));
+    }
+
+    _XOINL __m128 AffineTransform(__m128 r0, __m128 r1, __m128 r2, __m128 v) {
+        __m128 a = _mm_mul_ps(r0, v);
+        __m128 b = _mm_mul_ps(r1, v);
+        __m128 c = _mm_mul_ps(r2, v);
+        __m128 d = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        return _mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d));
+    }
+}
+#endif
+
+const Vector4& Matrix3x4::GetRow(int i) const {
+    return r[i];
+}
+
+Vector3 Matrix3x4::GetColumn(int i) const {
+    return Vector3(r[0][i], r[1][i], r[2][i]);
+}
+
+Vector3 Matrix3x4::GetTranslation() const {
+    return Vector3(m03, m13, m23);
+}
+
+Matrix3x4& Matrix3x4::SetTranslation(const Vector3& t) {
+    m03 = t.x;
+    m13 = t.y;
+    m23 = t.z;
+    return *this;
+}
+
+const Vector4& Matrix3x4::operator [](int i) const {
+    return r[i];
+}
+
+Vector4& Matrix3x4::operator [](int i) {
+    return r[i];
+}
+
+const float& Matrix3x4::operator ()(int r, int c) const {
+    return this->r[r][c];
+}
+
+float& Matrix3x4::operator ()(int r, int c) {
+    return this->r[r][c];
+}
+
+Matrix3x4& Matrix3x4::operator *= (const Matrix3x4& m) {
+    // As Matrix4x4::operator *=, each row of the product is a linear combination of the rows of m. The bottom
+    // row of m is (0, 0, 0, 1), so its term is just the w of the row of this.
+#if defined(XO_SSE)
+    // m may be this, so its rows are loaded before any are written.
+    __m128 b0 = m.r[0].xmm, b1 = m.r[1].xmm, b2 = m.r[2].xmm;
+    r[0].xmm = sse::AffineCombination(r[0].xmm, b0, b1, b2);
+    r[1].xmm = sse::AffineCombination(r[1].xmm, b0, b1, b2);
+    r[2].xmm = sse::AffineCombination(r[2].xmm, b0, b1, b2);
+#else
+    Matrix3x4 b(m);
+    for (int i = 0; i < 3; ++i) {
+        Vector4 a = r[i];
+        r[i] = (b.r[0] * a.x) + (b.r[1] * a.y) + (b.r[2] * a.z);
+        r[i].w += a.w;
+    }
+#endif
+    return *this;
+}
+
+Matrix3x4 Matrix3x4::operator * (const Matrix3x4& m) const {
+#if defined(XO_SSE)
+    Matrix3x4 o;
+    o.r[0].xmm = sse::AffineCombination(r[0].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    o.r[1].xmm = sse::AffineCombination(r[1].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    o.r[2].xmm = sse::AffineCombination(r[2].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    return o;
+#else
+    return Matrix3x4(*this) *= m;
+#endif
+}
+
+Vector4 Matrix3x4::operator * (const Vector4& v) const {
+#if defined(XO_SSE)
+    Vector4 o(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, v.xmm));
+    o.w = v.w;
+    return o;
+#else
+    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), v.w);
+#endif
+}
+
+Vector3 Matrix3x4::TransformPoint(const Vector3& v) const {
+#if defined(XO_SSE)
+    // The w of v's register is unspecified, so it's masked off and replaced with 1 in register, rather than
+    // going through a Vector4 in memory.
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    __m128 p = _mm_or_ps(_mm_and_ps(v.xmm, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+    return Vector3(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, p));
+#else
+    Vector4 p(v, 1.0f);
+    return Vector3((r[0] * p).Sum(), (r[1] * p).Sum(), (r[2] * p).Sum());
+#endif
+}
+
+Vector3 Matrix3x4::TransformDirection(const Vector3& v) const {
+#if defined(XO_SSE)
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    return Vector3(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, _mm_and_ps(v.xmm, xyzMask)));
+#else
+    Vector4 d(v, 0.0f);
+    return Vector3((r[0] * d).Sum(), (r[1] * d).Sum(), (r[2] * d).Sum());
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace sse {
+    _XOINL __m128 QuaternionMultiply(__m128 a, __m128 b) {
+        // Lanes are x, y, z, w. _mm_set_ps takes them w first.
+        __m128 bx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f));
+        __m128 by = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f));
+        __m128 bz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), bx)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), by), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), bz)));
+    }
+
+    _XOINL __m128 Cross(__m128 a, __m128 b) {
+        __m128 r = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(b, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL __m128 QuaternionRotate(__m128 q, __m128 v) {
+        __m128 t = Cross(q, v);
+        t = _mm_add_ps(t, t);
+        return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(t, _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)))), Cross(q, t));
+    }
+}
+#endif
+
+float& Quaternion::operator [](int i) { 
+  return f[i]; 
+}
+
+const float& Quaternion::operator [](int i) const { 
+  return f[i]; 
+}
+
+Quaternion& Quaternion::operator *= (const Quaternion& q) {
+#if defined(XO_SSE)
+    xmm = sse::QuaternionMultiply(xmm, q.xmm);
+#else
+    // _XO_ASSIGN_QUAT writes one member at a time, so every component is computed first.
+    float nw = w * q.w - x * q.x - y * q.y - z * q.z;
+    float nx = w * q.x + x * q.w + y * q.z - z * q.y;
+    float ny = w * q.y - x * q.z + y * q.w + z * q.x;
+    float nz = w * q.z + x * q.y - y * q.x + z * q.w;
+    _XO_ASSIGN_QUAT(nw, nx, ny, nz);
+#endif
+  return *this;
+}
+
+Quaternion Quaternion::operator * (const Quaternion& q) const {
+  return Quaternion(*this) *= q;
+}
+
+Vector3 Quaternion::operator * (const Vector3& v) const {
+    return Rotate(v);
+}
+
+Vector3 Quaternion::Rotate(const Vector3& v) const {
+#if defined(XO_SSE)
+    Vector3 o;
+    o.xmm = sse::QuaternionRotate(xmm, v.xmm);
+    return o;
+#else
+    Vector3 u(x, y, z);
+    Vector3 t = Vector3::Cross(u, v) * 2.0f;
+    return v + t * w + Vector3::Cross(u, t);
+#endif
+}
+
+bool Quaternion::operator == (const Quaternion& q) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(q.xmm, xmm)), sse::Epsilon)) & 15) == 15;
+#   else
+    return 
+        CloseEnough(x, q.x, Epsilon) && 
+        CloseEnough(y, q.y, Epsilon) && 
+        CloseEnough(z, q.z, Epsilon) &&
+        CloseEnough(w, q.w, Epsilon);
+#   endif
+}
+
+bool Quaternion::operator != (const Quaternion& q) const {
+  return !((*this) == q);
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+const Quaternion& DualQuaternion::GetRotation() const {
+    return real;
+}
+
+Vector3 DualQuaternion::GetTranslation() const {
+    // The vector part of 2 q_d q_r^*, which is 2 (r_w d - d_w r + r x d) for the vector parts r and d.
+#if defined(XO_SSE)
+    // the w lanes of both terms cancel to zero.
+    __m128 r = real.xmm, d = dual.xmm;
+    __m128 t = _mm_add_ps(
+        _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), d), _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3)), r)),
+        sse::Cross(r, d));
+    return Vector3(_mm_add_ps(t, t));
+#else
+    Vector3 r(real.x, real.y, real.z), d(dual.x, dual.y, dual.z);
+    return (d * real.w - r * dual.w + Vector3::Cross(r, d)) * 2.0f;
+#endif
+}
+
+DualQuaternion& DualQuaternion::operator *= (const DualQuaternion& q) {
+#if defined(XO_SSE)
+    // q may be this, so both products read its parts before either is written.
+    __m128 d = _mm_add_ps(sse::QuaternionMultiply(real.xmm, q.dual.xmm), sse::QuaternionMultiply(dual.xmm, q.real.xmm));
+    real.xmm = sse::QuaternionMultiply(real.xmm, q.real.xmm);
+    dual.xmm = d;
+#else
+    Quaternion a = real * q.dual;
+    Quaternion b = dual * q.real;
+    real *= q.real;
+    dual = Quaternion(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+#endif
+    return *this;
+}
+
+DualQuaternion DualQuaternion::operator * (const DualQuaternion& q) const {
+    return DualQuaternion(*this) *= q;
+}
+
+bool DualQuaternion::operator == (const DualQuaternion& q) const {
+    return real == q.real && dual == q.dual;
+}
+
+bool DualQuaternion::operator != (const DualQuaternion& q) const {
+    return !((*this) == q);
+}
+
+Vector3 DualQuaternion::TransformPoint(const Vector3& v) const {
+    return real.Rotate(v) + GetTranslation();
+}
+
+Vector3 DualQuaternion::TransformDirection(const Vector3& v) const {
+    return real.Rotate(v);
+}
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+const Vector3& Transform::GetPosition() const {
+    return position;
+}
+
+const Quaternion& Transform::GetRotation() const {
+    return rotation;
+}
+
+const Vector3& Transform::GetScale() const {
+    return scale;
+}
+
+Transform& Transform::SetPosition(const Vector3& position) {
+    this->position = position;
+    // Only the translation column depends on the position, so an up to date matrix is patched rather than
+    // composed again. The inverse's translation depends on everything.
+    if (!(dirty & DirtyMatrix)) {
+        matrix.SetTranslation(position);
+    }
+    dirty |= DirtyInverse;
+    return *this;
+}
+
+Transform& Transform::SetRotation(const Quaternion& rotation) {
+    this->rotation = rotation;
+    dirty = DirtyAll;
+    return *this;
+}
+
+Transform& Transform::SetScale(const Vector3& scale) {
+    this->scale = scale;
+    dirty = DirtyAll;
+    return *this;
+}
+
+Transform& Transform::Set(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+    this->position = position;
+    this->rotation = rotation;
+    this->scale = scale;
+    dirty = DirtyAll;
+    return *this;
+}
+
+const Matrix3x4& Transform::GetMatrix() const {
+    if (dirty & DirtyMatrix) {
+        UpdateMatrix();
+    }
+    return matrix;
+}
+
+const Matrix3x4& Transform::GetInverseMatrix() const {
+    if (dirty & DirtyInverse) {
+        UpdateInverseMatrix();
+    }
+    return inverseMatrix;
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+size_t Hierarchy::GetNodeCount() const {
+    return parents.size();
+}
+
+int Hierarchy::GetParent(int node) const {
+    return parents[node];
+}
+
+const Matrix4x4& Hierarchy::GetLocal(int node) const {
+    return locals[slots[node]];
+}
+
+void Hierarchy::SetLocal(int node, const Matrix4x4& local) {
+    int slot = slots[node];
+    locals[slot] = local;
+    changed[slot] = 1;
+    if ((size_t)depths[node] < firstChangedLevel) {
+        firstChangedLevel = (size_t)depths[node];
+    }
+}
+
+const Matrix4x4& Hierarchy::GetWorld(int node) const {
+    return worlds[slots[node]];
+}
+
+size_t Hierarchy::GetLevelCount() const {
+    return levels.empty() ? 0 : levels.size() - 1;
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3x4::Vector3x4(float f) {
+#if defined(XO_SSE)
+    xmmX = xmmY = xmmZ = _mm_set1_ps(f);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = y[i] = z[i] = f;
+    }
+#endif
+}
+
+Vector3x4::Vector3x4(const Vector3& v) {
+    Set(v);
+}
+
+Vector3x4::Vector3x4(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+    Set(v0, v1, v2, v3);
+}
+
+Vector3x4::Vector3x4(const Vector4& x, const Vector4& y, const Vector4& z) {
+#if defined(XO_SSE)
+    xmmX = x.xmm;
+    xmmY = y.xmm;
+    xmmZ = z.xmm;
+#else
+    for (int i = 0; i < 4; ++i) {
+        this->x[i] = x.f[i];
+        this->y[i] = y.f[i];
+        this->z[i] = z.f[i];
+    }
+#endif
+}
+
+Vector3x4::Vector3x4(const Vector3x4& v) {
+    Set(v);
+}
+
+#if defined(XO_SSE)
+Vector3x4::Vector3x4(const __m128& x, const __m128& y, const __m128& z) :
+    xmmX(x), xmmY(y), xmmZ(z)
+{
+}
+#endif
+
+Vector3x4& Vector3x4::Set(const Vector3& v) {
+#if defined(XO_SSE)
+    xmmX = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(0, 0, 0, 0));
+    xmmY = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(1, 1, 1, 1));
+    xmmZ = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(2, 2, 2, 2));
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::Set(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+#if defined(XO_SSE)
+    // Transpose the four xyzw registers into xxxx, yyyy, zzzz. w is discarded.
+    __m128 t0 = _mm_unpacklo_ps(v0.xmm, v1.xmm);
+    __m128 t1 = _mm_unpacklo_ps(v2.xmm, v3.xmm);
+    __m128 t2 = _mm_unpackhi_ps(v0.xmm, v1.xmm);
+    __m128 t3 = _mm_unpackhi_ps(v2.xmm, v3.xmm);
+    xmmX = _mm_movelh_ps(t0, t1);
+    xmmY = _mm_movehl_ps(t1, t0);
+    xmmZ = _mm_movelh_ps(t2, t3);
+#else
+    SetLane(0, v0);
+    SetLane(1, v1);
+    SetLane(2, v2);
+    SetLane(3, v3);
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::Set(const Vector3x4& v) {
+#if defined(XO_SSE)
+    xmmX = v.xmmX;
+    xmmY = v.xmmY;
+    xmmZ = v.xmmZ;
+#else
+    for (int i = 0; i < 12; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::SetLane(int lane, const Vector3& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    return *this;
+}
+
+Vector3 Vector3x4::GetLane(int lane) const {
+    return Vector3(x[lane], y[lane], z[lane]);
+}
+
+void Vector3x4::Get(Vector3& v0, Vector3& v1, Vector3& v2, Vector3& v3) const {
+#if defined(XO_SSE)
+    // Transpose xxxx, yyyy, zzzz back into four xyz0 registers.
+    __m128 t0 = _mm_unpacklo_ps(xmmX, xmmY);
+    __m128 t1 = _mm_unpackhi_ps(xmmX, xmmY);
+    __m128 t2 = _mm_unpacklo_ps(xmmZ, sse::Zero);
+    __m128 t3 = _mm_unpackhi_ps(xmmZ, sse::Zero);
+    v0.xmm = _mm_movelh_ps(t0, t2);
+    v1.xmm = _mm_movehl_ps(t2, t0);
+    v2.xmm = _mm_movelh_ps(t1, t3);
+    v3.xmm = _mm_movehl_ps(t3, t1);
+#else
+    v0 = GetLane(0);
+    v1 = GetLane(1);
+    v2 = GetLane(2);
+    v3 = GetLane(3);
+#endif
+}
+
+Vector3x4 Vector3x4::Load(const Vector3* v) {
+    return Vector3x4(v[0], v[1], v[2], v[3]);
+}
+
+Vector3x4 Vector3x4::LoadPartial(const Vector3* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector3x4::LoadPartial count must be between 0 and 4.");
+    switch (count) {
+        case 4:  return Vector3x4(v[0], v[1], v[2], v[3]);
+        case 3:  return Vector3x4(v[0], v[1], v[2], Vector3::Zero);
+        case 2:  return Vector3x4(v[0], v[1], Vector3::Zero, Vector3::Zero);
+        case 1:  return Vector3x4(v[0], Vector3::Zero, Vector3::Zero, Vector3::Zero);
+        default: return Vector3x4(0.0f);
+    }
+}
+
+Vector3x4 Vector3x4::LoadSoA(const float* x, const float* y, const float* z) {
+#if defined(XO_SSE)
+    return Vector3x4(_mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z));
+#else
+    Vector3x4 v;
+    for (int i = 0; i < 4; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+    }
+    return v;
+#endif
+}
+
+void Vector3x4::Store(Vector3* v) const {
+    Get(v[0], v[1], v[2], v[3]);
+}
+
+void Vector3x4::StorePartial(Vector3* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector3x4::StorePartial count must be between 0 and 4.");
+    if (count == 4) {
+        Store(v);
+        return;
+    }
+    Vector3 t[4];
+    Get(t[0], t[1], t[2], t[3]);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector3x4::StoreSoA(float* x, float* y, float* z) const {
+#if defined(XO_SSE)
+    _mm_storeu_ps(x, xmmX);
+    _mm_storeu_ps(y, xmmY);
+    _mm_storeu_ps(z, xmmZ);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+    }
+#endif
+}
+
+Vector3x4 Vector3x4::operator -() const {
+#if defined(XO_SSE)
+    return Vector3x4(_mm_xor_ps(xmmX, sse::SignMask), _mm_xor_ps(xmmY, sse::SignMask), _mm_xor_ps(xmmZ, sse::SignMask));
+#else
+    Vector3x4 v;
+    for (int i = 0; i < 12; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_SSE)
+#   define _XO_W3X4_OP_X4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector3x4& v) { \
+        xmmX = sseop(xmmX, v.xmmX); xmmY = sseop(xmmY, v.xmmY); xmmZ = sseop(xmmZ, v.xmmZ); \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_V4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector4& v) { \
+        xmmX = sseop(xmmX, v.xmm); xmmY = sseop(xmmY, v.xmm); xmmZ = sseop(xmmZ, v.xmm); \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_F(op, sseop) \
+    Vector3x4& Vector3x4::operator op (float v) { \
+        __m128 s = _mm_set1_ps(v); \
+        xmmX = sseop(xmmX, s); xmmY = sseop(xmmY, s); xmmZ = sseop(xmmZ, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W3X4_OP_X4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector3x4& v) { \
+        for (int i = 0; i < 12; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_V4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector4& v) { \
+        for (int i = 0; i < 4; ++i) { x[i] op v.f[i]; y[i] op v.f[i]; z[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_F(op, sseop) \
+    Vector3x4& Vector3x4::operator op (float v) { \
+        for (int i = 0; i < 12; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W3X4_OP_X4(+=, _mm_add_ps)
+_XO_W3X4_OP_V4(+=, _mm_add_ps)
+_XO_W3X4_OP_F(+=, _mm_add_ps)
+_XO_W3X4_OP_X4(-=, _mm_sub_ps)
+_XO_W3X4_OP_V4(-=, _mm_sub_ps)
+_XO_W3X4_OP_F(-=, _mm_sub_ps)
+_XO_W3X4_OP_X4(*=, _mm_mul_ps)
+_XO_W3X4_OP_V4(*=, _mm_mul_ps)
+_XO_W3X4_OP_F(*=, _mm_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_SSE)
+_XO_W3X4_OP_X4(/=, _mm_div_ps)
+_XO_W3X4_OP_V4(/=, _mm_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of _mm_rcp_ps vs. _mm_div_ps.
+Vector3x4& Vector3x4::operator /= (const Vector3x4& v) {
+    xmmX = _mm_mul_ps(xmmX, _mm_rcp_ps(v.xmmX));
+    xmmY = _mm_mul_ps(xmmY, _mm_rcp_ps(v.xmmY));
+    xmmZ = _mm_mul_ps(xmmZ, _mm_rcp_ps(v.xmmZ));
+    return *this;
+}
+
+Vector3x4& Vector3x4::operator /= (const Vector4& v) {
+    // one reciprocal for all three elements of each lane.
+    __m128 r = _mm_rcp_ps(v.xmm);
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    return *this;
+}
+#endif
+
+#undef _XO_W3X4_OP_X4
+#undef _XO_W3X4_OP_V4
+#undef _XO_W3X4_OP_F
+
+Vector3x4& Vector3x4::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector3x4& Vector3x4::operator += (const Vector3& v)        { return (*this) += Vector3x4(v); }
+Vector3x4& Vector3x4::operator += (double v)                { return (*this) += float(v); }
+Vector3x4& Vector3x4::operator += (int v)                   { return (*this) += float(v); }
+Vector3x4& Vector3x4::operator -= (const Vector3& v)        { return (*this) -= Vector3x4(v); }
+Vector3x4& Vector3x4::operator -= (double v)                { return (*this) -= float(v); }
+Vector3x4& Vector3x4::operator -= (int v)                   { return (*this) -= float(v); }
+Vector3x4& Vector3x4::operator *= (const Vector3& v)        { return (*this) *= Vector3x4(v); }
+Vector3x4& Vector3x4::operator *= (double v)                { return (*this) *= float(v); }
+Vector3x4& Vector3x4::operator *= (int v)                   { return (*this) *= float(v); }
+Vector3x4& Vector3x4::operator /= (const Vector3& v)        { return (*this) /= Vector3x4(v); }
+Vector3x4& Vector3x4::operator /= (double v)                { return (*this) /= float(v); }
+Vector3x4& Vector3x4::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector3x4 Vector3x4::operator + (const Vector3x4& v) const  { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (const Vector3& v) const    { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (const Vector4& v) const    { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (float v) const             { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (double v) const            { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (int v) const               { return Vector3x4(*this) += v; }
+
+Vector3x4 Vector3x4::operator - (const Vector3x4& v) const  { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (const Vector3& v) const    { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (const Vector4& v) const    { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (float v) const             { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (double v) const            { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (int v) const               { return Vector3x4(*this) -= v; }
+
+Vector3x4 Vector3x4::operator * (const Vector3x4& v) const  { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (const Vector3& v) const    { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (const Vector4& v) const    { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (float v) const             { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (double v) const            { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (int v) const               { return Vector3x4(*this) *= v; }
+
+Vector3x4 Vector3x4::operator / (const Vector3x4& v) const  { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (const Vector3& v) const    { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (const Vector4& v) const    { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (float v) const             { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (double v) const            { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (int v) const               { return Vector3x4(*this) /= v; }
+
+bool Vector3x4::operator == (const Vector3x4& v) const {
+#if defined(XO_SSE)
+    __m128 eq = _mm_and_ps(
+        _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmX, xmmX)), sse::Epsilon),
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmY, xmmY)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmZ, xmmZ)), sse::Epsilon)));
+    return _mm_movemask_ps(eq) == 15;
+#else
+    for (int i = 0; i < 12; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector3::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector3x4::operator != (const Vector3x4& v) const      { return !((*this) == v); }
+
+Vector4 Vector3x4::Magnitude() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_sqrt_ps(MagnitudeSquared().xmm));
+#else
+    Vector4 m = MagnitudeSquared();
+    return Vector4(Sqrt(m.x), Sqrt(m.y), Sqrt(m.z), Sqrt(m.w));
+#endif
+}
+
+Vector4 Vector3x4::Sum() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(xmmX, xmmY), xmmZ));
+#else
+    return Vector4(x[0] + y[0] + z[0], x[1] + y[1] + z[1], x[2] + y[2] + z[2], x[3] + y[3] + z[3]);
+#endif
+}
+
+Vector3x4& Vector3x4::Normalize() {
+#if defined(XO_SSE) && !defined(XO_NO_INVERSE_DIVISION)
+    // _mm_rsqrt_ps has a relative error of 1.5*2^-12, one newton-raphson step brings it close to full precision:
+    //      r' = r * (1.5 - 0.5 * m * r * r)
+    __m128 m = MagnitudeSquared().xmm;
+    __m128 r = _mm_rsqrt_ps(m);
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), _mm_mul_ps(r, r))));
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    return *this;
+#else
+    return (*this) /= Magnitude();
+#endif
+}
+
+Vector3x4& Vector3x4::NormalizeSafe() {
+#if defined(XO_SSE)
+    __m128 nonZero = _mm_cmpgt_ps(MagnitudeSquared().xmm, sse::Zero);
+    Vector3x4 n = Normalized();
+    xmmX = _mm_or_ps(_mm_and_ps(nonZero, n.xmmX), _mm_andnot_ps(nonZero, xmmX));
+    xmmY = _mm_or_ps(_mm_and_ps(nonZero, n.xmmY), _mm_andnot_ps(nonZero, xmmY));
+    xmmZ = _mm_or_ps(_mm_and_ps(nonZero, n.xmmZ), _mm_andnot_ps(nonZero, xmmZ));
+#else
+    Vector4 m = MagnitudeSquared();
+    for (int i = 0; i < 4; ++i) {
+        if (m.f[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m.f[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector3x4::Cross(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    // No shuffles needed in the structure of arrays layout, each element is a plain register.
+    __m128 x = _mm_sub_ps(_mm_mul_ps(a.xmmY, b.xmmZ), _mm_mul_ps(a.xmmZ, b.xmmY));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(a.xmmZ, b.xmmX), _mm_mul_ps(a.xmmX, b.xmmZ));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(a.xmmX, b.xmmY), _mm_mul_ps(a.xmmY, b.xmmX));
+    outVec.xmmX = x;
+    outVec.xmmY = y;
+    outVec.xmmZ = z;
+#else
+    Vector3x4 t;
+    for (int i = 0; i < 4; ++i) {
+        t.x[i] = (a.y[i] * b.z[i]) - (a.z[i] * b.y[i]);
+        t.y[i] = (a.z[i] * b.x[i]) - (a.x[i] * b.z[i]);
+        t.z[i] = (a.x[i] * b.y[i]) - (a.y[i] * b.x[i]);
+    }
+    outVec = t;
+#endif
+}
+
+Vector4 Vector3x4::Dot(const Vector3x4& a, const Vector3x4& b) {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.xmmX, b.xmmX), _mm_mul_ps(a.xmmY, b.xmmY)), _mm_mul_ps(a.xmmZ, b.xmmZ)));
+#else
+    Vector4 d;
+    for (int i = 0; i < 4; ++i) {
+        d.f[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+    }
+    return d;
+#endif
+}
+
+void Vector3x4::Max(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_max_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_max_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_max_ps(a.xmmZ, b.xmmZ);
+#else
+    for (int i = 0; i < 12; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector3x4::Min(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_min_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_min_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_min_ps(a.xmmZ, b.xmmZ);
+#else
+    for (int i = 0; i < 12; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+Vector4x4::Vector4x4(float f) {
+#if defined(XO_SSE)
+    xmmX = xmmY = xmmZ = xmmW = _mm_set1_ps(f);
+#else
+    for (int i = 0; i < 16; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector4x4::Vector4x4(const Vector4& v) {
+    Set(v);
+}
+
+Vector4x4::Vector4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3) {
+    Set(v0, v1, v2, v3);
+}
+
+Vector4x4::Vector4x4(const Vector4x4& v) {
+    Set(v);
+}
+
+#if defined(XO_SSE)
+Vector4x4::Vector4x4(const __m128& x, const __m128& y, const __m128& z, const __m128& w) :
+    xmmX(x), xmmY(y), xmmZ(z), xmmW(w)
+{
+}
+#endif
+
+Vector4x4& Vector4x4::Set(const Vector4& v) {
+#if defined(XO_SSE)
+    xmmX = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(0, 0, 0, 0));
+    xmmY = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(1, 1, 1, 1));
+    xmmZ = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(2, 2, 2, 2));
+    xmmW = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(3, 3, 3, 3));
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+        w[i] = v.w;
+    }
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::Set(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3) {
+#if defined(XO_SSE)
+    xmmX = v0.xmm;
+    xmmY = v1.xmm;
+    xmmZ = v2.xmm;
+    xmmW = v3.xmm;
+    _MM_TRANSPOSE4_PS(xmmX, xmmY, xmmZ, xmmW);
+#else
+    SetLane(0, v0);
+    SetLane(1, v1);
+    SetLane(2, v2);
+    SetLane(3, v3);
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::Set(const Vector4x4& v) {
+#if defined(XO_SSE)
+    xmmX = v.xmmX;
+    xmmY = v.xmmY;
+    xmmZ = v.xmmZ;
+    xmmW = v.xmmW;
+#else
+    for (int i = 0; i < 16; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::SetLane(int lane, const Vector4& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    w[lane] = v.w;
+    return *this;
+}
+
+Vector4 Vector4x4::GetLane(int lane) const {
+    return Vector4(x[lane], y[lane], z[lane], w[lane]);
+}
+
+void Vector4x4::Get(Vector4& v0, Vector4& v1, Vector4& v2, Vector4& v3) const {
+#if defined(XO_SSE)
+    __m128 r0 = xmmX, r1 = xmmY, r2 = xmmZ, r3 = xmmW;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    v0.xmm = r0;
+    v1.xmm = r1;
+    v2.xmm = r2;
+    v3.xmm = r3;
+#else
+    v0 = GetLane(0);
+    v1 = GetLane(1);
+    v2 = GetLane(2);
+    v3 = GetLane(3);
+#endif
+}
+
+Vector4x4 Vector4x4::Load(const Vector4* v) {
+    return Vector4x4(v[0], v[1], v[2], v[3]);
+}
+
+Vector4x4 Vector4x4::LoadPartial(const Vector4* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector4x4::LoadPartial count must be between 0 and 4.");
+    switch (count) {
+        case 4:  return Vector4x4(v[0], v[1], v[2], v[3]);
+        case 3:  return Vector4x4(v[0], v[1], v[2], Vector4::Zero);
+        case 2:  return Vector4x4(v[0], v[1], Vector4::Zero, Vector4::Zero);
+        case 1:  return Vector4x4(v[0], Vector4::Zero, Vector4::Zero, Vector4::Zero);
+        default: return Vector4x4(0.0f);
+    }
+}
+
+Vector4x4 Vector4x4::LoadSoA(const float* x, const float* y, const float* z, const float* w) {
+#if defined(XO_SSE)
+    return Vector4x4(_mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z), _mm_loadu_ps(w));
+#else
+    Vector4x4 v;
+    for (int i = 0; i < 4; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+        v.w[i] = w[i];
+    }
+    return v;
+#endif
+}
+
+void Vector4x4::Store(Vector4* v) const {
+    Get(v[0], v[1], v[2], v[3]);
+}
+
+void Vector4x4::StorePartial(Vector4* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector4x4::StorePartial count must be between 0 and 4.");
+    if (count == 4) {
+        Store(v);
+        return;
+    }
+    Vector4 t[4];
+    Get(t[0], t[1], t[2], t[3]);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector4x4::StoreSoA(float* x, float* y, float* z, float* w) const {
+#if defined(XO_SSE)
+    _mm_storeu_ps(x, xmmX);
+    _mm_storeu_ps(y, xmmY);
+    _mm_storeu_ps(z, xmmZ);
+    _mm_storeu_ps(w, xmmW);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+        w[i] = this->w[i];
+    }
+#endif
+}
+
+Vector4x4 Vector4x4::operator -() const {
+#if defined(XO_SSE)
+    return Vector4x4(
+        _mm_xor_ps(xmmX, sse::SignMask), 
+        _mm_xor_ps(xmmY, sse::SignMask), 
+        _mm_xor_ps(xmmZ, sse::SignMask), 
+        _mm_xor_ps(xmmW, sse::SignMask));
+#else
+    Vector4x4 v;
+    for (int i = 0; i < 16; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_SSE)
+#   define _XO_W4X4_OP_X4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4x4& v) { \
+        xmmX = sseop(xmmX, v.xmmX); xmmY = sseop(xmmY, v.xmmY); xmmZ = sseop(xmmZ, v.xmmZ); xmmW = sseop(xmmW, v.xmmW); \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_V4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4& v) { \
+        xmmX = sseop(xmmX, v.xmm); xmmY = sseop(xmmY, v.xmm); xmmZ = sseop(xmmZ, v.xmm); xmmW = sseop(xmmW, v.xmm); \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_F(op, sseop) \
+    Vector4x4& Vector4x4::operator op (float v) { \
+        __m128 s = _mm_set1_ps(v); \
+        xmmX = sseop(xmmX, s); xmmY = sseop(xmmY, s); xmmZ = sseop(xmmZ, s); xmmW = sseop(xmmW, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W4X4_OP_X4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4x4& v) { \
+        for (int i = 0; i < 16; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_V4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4& v) { \
+        for (int i = 0; i < 4; ++i) { x[i] op v.f[i]; y[i] op v.f[i]; z[i] op v.f[i]; w[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_F(op, sseop) \
+    Vector4x4& Vector4x4::operator op (float v) { \
+        for (int i = 0; i < 16; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W4X4_OP_X4(+=, _mm_add_ps)
+_XO_W4X4_OP_V4(+=, _mm_add_ps)
+_XO_W4X4_OP_F(+=, _mm_add_ps)
+_XO_W4X4_OP_X4(-=, _mm_sub_ps)
+_XO_W4X4_OP_V4(-=, _mm_sub_ps)
+_XO_W4X4_OP_F(-=, _mm_sub_ps)
+_XO_W4X4_OP_X4(*=, _mm_mul_ps)
+_XO_W4X4_OP_V4(*=, _mm_mul_ps)
+_XO_W4X4_OP_F(*=, _mm_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_SSE)
+_XO_W4X4_OP_X4(/=, _mm_div_ps)
+_XO_W4X4_OP_V4(/=, _mm_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of _mm_rcp_ps vs. _mm_div_ps.
+Vector4x4& Vector4x4::operator /= (const Vector4x4& v) {
+    xmmX = _mm_mul_ps(xmmX, _mm_rcp_ps(v.xmmX));
+    xmmY = _mm_mul_ps(xmmY, _mm_rcp_ps(v.xmmY));
+    xmmZ = _mm_mul_ps(xmmZ, _mm_rcp_ps(v.xmmZ));
+    xmmW = _mm_mul_ps(xmmW, _mm_rcp_ps(v.xmmW));
+    return *this;
+}
+
+Vector4x4& Vector4x4::operator /= (const Vector4& v) {
+    // one reciprocal for all four elements of each lane.
+    __m128 r = _mm_rcp_ps(v.xmm);
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    xmmW = _mm_mul_ps(xmmW, r);
+    return *this;
+}
+#endif
+
+#undef _XO_W4X4_OP_X4
+#undef _XO_W4X4_OP_V4
+#undef _XO_W4X4_OP_F
+
+Vector4x4& Vector4x4::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector4x4& Vector4x4::operator += (double v)                { return (*this) += float(v); }
+Vector4x4& Vector4x4::operator += (int v)                   { return (*this) += float(v); }
+Vector4x4& Vector4x4::operator -= (double v)                { return (*this) -= float(v); }
+Vector4x4& Vector4x4::operator -= (int v)                   { return (*this) -= float(v); }
+Vector4x4& Vector4x4::operator *= (double v)                { return (*this) *= float(v); }
+Vector4x4& Vector4x4::operator *= (int v)                   { return (*this) *= float(v); }
+Vector4x4& Vector4x4::operator /= (double v)                { return (*this) /= float(v); }
+Vector4x4& Vector4x4::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector4x4 Vector4x4::operator + (const Vector4x4& v) const  { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (const Vector4& v) const    { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (float v) const             { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (double v) const            { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (int v) const               { return Vector4x4(*this) += v; }
+
+Vector4x4 Vector4x4::operator - (const Vector4x4& v) const  { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (const Vector4& v) const    { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (float v) const             { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (double v) const            { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (int v) const               { return Vector4x4(*this) -= v; }
+
+Vector4x4 Vector4x4::operator * (const Vector4x4& v) const  { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (const Vector4& v) const    { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (float v) const             { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (double v) const            { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (int v) const               { return Vector4x4(*this) *= v; }
+
+Vector4x4 Vector4x4::operator / (const Vector4x4& v) const  { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (const Vector4& v) const    { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (float v) const             { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (double v) const            { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (int v) const               { return Vector4x4(*this) /= v; }
+
+bool Vector4x4::operator == (const Vector4x4& v) const {
+#if defined(XO_SSE)
+    __m128 eq = _mm_and_ps(
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmX, xmmX)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmY, xmmY)), sse::Epsilon)),
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmZ, xmmZ)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmW, xmmW)), sse::Epsilon)));
+    return _mm_movemask_ps(eq) == 15;
+#else
+    for (int i = 0; i < 16; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector4::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector4x4::operator != (const Vector4x4& v) const      { return !((*this) == v); }
+
+Vector4 Vector4x4::Magnitude() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_sqrt_ps(MagnitudeSquared().xmm));
+#else
+    Vector4 m = MagnitudeSquared();
+    return Vector4(Sqrt(m.x), Sqrt(m.y), Sqrt(m.z), Sqrt(m.w));
+#endif
+}
+
+Vector4 Vector4x4::Sum() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(xmmX, xmmY), _mm_add_ps(xmmZ, xmmW)));
+#else
+    Vector4 s;
+    for (int i = 0; i < 4; ++i) {
+        s.f[i] = x[i] + y[i] + z[i] + w[i];
+    }
+    return s;
+#endif
+}
+
+Vector4x4& Vector4x4::Normalize() {
+#if defined(XO_SSE) && !defined(XO_NO_INVERSE_DIVISION)
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m128 m = MagnitudeSquared().xmm;
+    __m128 r = _mm_rsqrt_ps(m);
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), _mm_mul_ps(r, r))));
+    return (*this) *= Vector4(r);
+#else
+    return (*this) /= Magnitude();
+#endif
+}
+
+Vector4x4& Vector4x4::NormalizeSafe() {
+#if defined(XO_SSE)
+    __m128 nonZero = _mm_cmpgt_ps(MagnitudeSquared().xmm, sse::Zero);
+    Vector4x4 n = Normalized();
+    xmmX = _mm_or_ps(_mm_and_ps(nonZero, n.xmmX), _mm_andnot_ps(nonZero, xmmX));
+    xmmY = _mm_or_ps(_mm_and_ps(nonZero, n.xmmY), _mm_andnot_ps(nonZero, xmmY));
+    xmmZ = _mm_or_ps(_mm_and_ps(nonZero, n.xmmZ), _mm_andnot_ps(nonZero, xmmZ));
+    xmmW = _mm_or_ps(_mm_and_ps(nonZero, n.xmmW), _mm_andnot_ps(nonZero, xmmW));
+#else
+    Vector4 m = MagnitudeSquared();
+    for (int i = 0; i < 4; ++i) {
+        if (m.f[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m.f[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+            w[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+Vector4 Vector4x4::Dot(const Vector4x4& a, const Vector4x4& b) {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(a.xmmX, b.xmmX), _mm_mul_ps(a.xmmY, b.xmmY)), 
+        _mm_add_ps(_mm_mul_ps(a.xmmZ, b.xmmZ), _mm_mul_ps(a.xmmW, b.xmmW))));
+#else
+    Vector4 d;
+    for (int i = 0; i < 4; ++i) {
+        d.f[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) + (a.w[i] * b.w[i]);
+    }
+    return d;
+#endif
+}
+
+void Vector4x4::Max(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_max_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_max_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_max_ps(a.xmmZ, b.xmmZ);
+    outVec.xmmW = _mm_max_ps(a.xmmW, b.xmmW);
+#else
+    for (int i = 0; i < 16; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector4x4::Min(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_min_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_min_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_min_ps(a.xmmZ, b.xmmZ);
+    outVec.xmmW = _mm_min_ps(a.xmmW, b.xmmW);
+#else
+    for (int i = 0; i < 16; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3x8::Vector3x8(float f) {
+#if defined(XO_AVX)
+    ymmX = ymmY = ymmZ = _mm256_set1_ps(f);
+#else
+    for (int i = 0; i < 24; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector3x8::Vector3x8(const Vector3& v) {
+    Set(v);
+}
+
+Vector3x8::Vector3x8(const Vector3x4& low, const Vector3x4& high) {
+    Set(low, high);
+}
+
+Vector3x8::Vector3x8(const Vector3x8& v) {
+    Set(v);
+}
+
+#if defined(XO_AVX)
+Vector3x8::Vector3x8(const __m256& x, const __m256& y, const __m256& z) :
+    ymmX(x), ymmY(y), ymmZ(z)
+{
+}
+#endif
+
+Vector3x8& Vector3x8::Set(const Vector3& v) {
+#if defined(XO_AVX)
+    ymmX = _mm256_set1_ps(v.x);
+    ymmY = _mm256_set1_ps(v.y);
+    ymmZ = _mm256_set1_ps(v.z);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::Set(const Vector3x4& low, const Vector3x4& high) {
+#if defined(XO_AVX)
+    ymmX = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmX), high.xmmX, 1);
+    ymmY = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmY), high.xmmY, 1);
+    ymmZ = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmZ), high.xmmZ, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = low.x[i];
+        y[i] = low.y[i];
+        z[i] = low.z[i];
+        x[i + 4] = high.x[i];
+        y[i + 4] = high.y[i];
+        z[i + 4] = high.z[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::Set(const Vector3x8& v) {
+#if defined(XO_AVX)
+    ymmX = v.ymmX;
+    ymmY = v.ymmY;
+    ymmZ = v.ymmZ;
+#else
+    for (int i = 0; i < 24; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::SetLane(int lane, const Vector3& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    return *this;
+}
+
+Vector3 Vector3x8::GetLane(int lane) const {
+    return Vector3(x[lane], y[lane], z[lane]);
+}
+
+void Vector3x8::Get(Vector3x4& low, Vector3x4& high) const {
+#if defined(XO_AVX)
+    low.xmmX = _mm256_castps256_ps128(ymmX);
+    low.xmmY = _mm256_castps256_ps128(ymmY);
+    low.xmmZ = _mm256_castps256_ps128(ymmZ);
+    high.xmmX = _mm256_extractf128_ps(ymmX, 1);
+    high.xmmY = _mm256_extractf128_ps(ymmY, 1);
+    high.xmmZ = _mm256_extractf128_ps(ymmZ, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        low.SetLane(i, GetLane(i));
+        high.SetLane(i, GetLane(i + 4));
+    }
+#endif
+}
+
+Vector3x8 Vector3x8::Load(const Vector3* v) {
+#if defined(XO_AVX)
+    // Vectors i and i+4 share a register, one per 128 bit lane. From there it's the same in-lane 4x4 transpose
+    // as Vector3x4::Set, which leaves vectors 0 to 3 in the low lanes and 4 to 7 in the high lanes. w is discarded.
+    __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[0].xmm), v[4].xmm, 1);
+    __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[1].xmm), v[5].xmm, 1);
+    __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[2].xmm), v[6].xmm, 1);
+    __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[3].xmm), v[7].xmm, 1);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    return Vector3x8(
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+#else
+    Vector3x8 r;
+    for (int i = 0; i < 8; ++i) {
+        r.SetLane(i, v[i]);
+    }
+    return r;
+#endif
+}
+
+Vector3x8 Vector3x8::LoadPartial(const Vector3* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector3x8::LoadPartial count must be between 0 and 8.");
+    if (count == 8) {
+        return Load(v);
+    }
+    Vector3 t[8];
+    for (int i = 0; i < 8; ++i) {
+        t[i] = i < count ? v[i] : Vector3::Zero;
+    }
+    return Load(t);
+}
+
+Vector3x8 Vector3x8::LoadSoA(const float* x, const float* y, const float* z) {
+#if defined(XO_AVX)
+    return Vector3x8(_mm256_loadu_ps(x), _mm256_loadu_ps(y), _mm256_loadu_ps(z));
+#else
+    Vector3x8 v;
+    for (int i = 0; i < 8; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+    }
+    return v;
+#endif
+}
+
+void Vector3x8::Store(Vector3* v) const {
+#if defined(XO_AVX)
+    // The reverse of Load, transposing within each 128 bit lane then splitting the lanes. w is written as zero.
+    __m256 t0 = _mm256_unpacklo_ps(ymmX, ymmY);
+    __m256 t1 = _mm256_unpackhi_ps(ymmX, ymmY);
+    __m256 t2 = _mm256_unpacklo_ps(ymmZ, avx::Zero);
+    __m256 t3 = _mm256_unpackhi_ps(ymmZ, avx::Zero);
+    __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    v[0].xmm = _mm256_castps256_ps128(r0);
+    v[1].xmm = _mm256_castps256_ps128(r1);
+    v[2].xmm = _mm256_castps256_ps128(r2);
+    v[3].xmm = _mm256_castps256_ps128(r3);
+    v[4].xmm = _mm256_extractf128_ps(r0, 1);
+    v[5].xmm = _mm256_extractf128_ps(r1, 1);
+    v[6].xmm = _mm256_extractf128_ps(r2, 1);
+    v[7].xmm = _mm256_extractf128_ps(r3, 1);
+#else
+    for (int i = 0; i < 8; ++i) {
+        v[i] = GetLane(i);
+    }
+#endif
+}
+
+void Vector3x8::StorePartial(Vector3* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector3x8::StorePartial count must be between 0 and 8.");
+    if (count == 8) {
+        Store(v);
+        return;
+    }
+    Vector3 t[8];
+    Store(t);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector3x8::StoreSoA(float* x, float* y, float* z) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(x, ymmX);
+    _mm256_storeu_ps(y, ymmY);
+    _mm256_storeu_ps(z, ymmZ);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+    }
+#endif
+}
+
+Vector3x8 Vector3x8::operator -() const {
+#if defined(XO_AVX)
+    return Vector3x8(_mm256_xor_ps(ymmX, avx::SignMask), _mm256_xor_ps(ymmY, avx::SignMask), _mm256_xor_ps(ymmZ, avx::SignMask));
+#else
+    Vector3x8 v;
+    for (int i = 0; i < 24; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_AVX)
+#   define _XO_W3X8_OP_X8(op, avxop) \
+    Vector3x8& Vector3x8::operator op (const Vector3x8& v) { \
+        ymmX = avxop(ymmX, v.ymmX); ymmY = avxop(ymmY, v.ymmY); ymmZ = avxop(ymmZ, v.ymmZ); \
+        return *this; \
+    }
+#   define _XO_W3X8_OP_F(op, avxop) \
+    Vector3x8& Vector3x8::operator op (float v) { \
+        __m256 s = _mm256_set1_ps(v); \
+        ymmX = avxop(ymmX, s); ymmY = avxop(ymmY, s); ymmZ = avxop(ymmZ, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W3X8_OP_X8(op, avxop) \
+    Vector3x8& Vector3x8::operator op (const Vector3x8& v) { \
+        for (int i = 0; i < 24; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X8_OP_F(op, avxop) \
+    Vector3x8& Vector3x8::operator op (float v) { \
+        for (int i = 0; i < 24; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W3X8_OP_X8(+=, _mm256_add_ps)
+_XO_W3X8_OP_F(+=, _mm256_add_ps)
+_XO_W3X8_OP_X8(-=, _mm256_sub_ps)
+_XO_W3X8_OP_F(-=, _mm256_sub_ps)
+_XO_W3X8_OP_X8(*=, _mm256_mul_ps)
+_XO_W3X8_OP_F(*=, _mm256_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_AVX)
+_XO_W3X8_OP_X8(/=, _mm256_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of rcp vs. div, which is much the same for the 256 bit forms.
+Vector3x8& Vector3x8::operator /= (const Vector3x8& v) {
+    ymmX = _mm256_mul_ps(ymmX, _mm256_rcp_ps(v.ymmX));
+    ymmY = _mm256_mul_ps(ymmY, _mm256_rcp_ps(v.ymmY));
+    ymmZ = _mm256_mul_ps(ymmZ, _mm256_rcp_ps(v.ymmZ));
+    return *this;
+}
+#endif
+
+#undef _XO_W3X8_OP_X8
+#undef _XO_W3X8_OP_F
+
+Vector3x8& Vector3x8::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector3x8& Vector3x8::operator += (const Vector3& v)        { return (*this) += Vector3x8(v); }
+Vector3x8& Vector3x8::operator += (double v)                { return (*this) += float(v); }
+Vector3x8& Vector3x8::operator += (int v)                   { return (*this) += float(v); }
+Vector3x8& Vector3x8::operator -= (const Vector3& v)        { return (*this) -= Vector3x8(v); }
+Vector3x8& Vector3x8::operator -= (double v)                { return (*this) -= float(v); }
+Vector3x8& Vector3x8::operator -= (int v)                   { return (*this) -= float(v); }
+Vector3x8& Vector3x8::operator *= (const Vector3& v)        { return (*this) *= Vector3x8(v); }
+Vector3x8& Vector3x8::operator *= (double v)                { return (*this) *= float(v); }
+Vector3x8& Vector3x8::operator *= (int v)                   { return (*this) *= float(v); }
+Vector3x8& Vector3x8::operator /= (const Vector3& v)        { return (*this) /= Vector3x8(v); }
+Vector3x8& Vector3x8::operator /= (double v)                { return (*this) /= float(v); }
+Vector3x8& Vector3x8::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector3x8 Vector3x8::operator + (const Vector3x8& v) const  { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (const Vector3& v) const    { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (float v) const             { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (double v) const            { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (int v) const               { return Vector3x8(*this) += v; }
+
+Vector3x8 Vector3x8::operator - (const Vector3x8& v) const  { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (const Vector3& v) const    { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (float v) const             { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (double v) const            { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (int v) const               { return Vector3x8(*this) -= v; }
+
+Vector3x8 Vector3x8::operator * (const Vector3x8& v) const  { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (const Vector3& v) const    { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (float v) const             { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (double v) const            { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (int v) const               { return Vector3x8(*this) *= v; }
+
+Vector3x8 Vector3x8::operator / (const Vector3x8& v) const  { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (const Vector3& v) const    { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (float v) const             { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (double v) const            { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (int v) const               { return Vector3x8(*this) /= v; }
+
+bool Vector3x8::operator == (const Vector3x8& v) const {
+#if defined(XO_AVX)
+    __m256 eq = _mm256_and_ps(
+        _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmX, ymmX)), avx::Epsilon, _CMP_LT_OQ),
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmY, ymmY)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmZ, ymmZ)), avx::Epsilon, _CMP_LT_OQ)));
+    return _mm256_movemask_ps(eq) == 255;
+#else
+    for (int i = 0; i < 24; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector3::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector3x8::operator != (const Vector3x8& v) const      { return !((*this) == v); }
+
+void Vector3x8::Magnitude(float* outMagnitudes) const {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+    _mm256_storeu_ps(outMagnitudes, _mm256_sqrt_ps(m));
+#else
+    MagnitudeSquared(outMagnitudes);
+    for (int i = 0; i < 8; ++i) {
+        outMagnitudes[i] = Sqrt(outMagnitudes[i]);
+    }
+#endif
+}
+
+void Vector3x8::Sum(float* outSums) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outSums, _mm256_add_ps(_mm256_add_ps(ymmX, ymmY), ymmZ));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outSums[i] = x[i] + y[i] + z[i];
+    }
+#endif
+}
+
+Vector3x8& Vector3x8::Normalize() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+#   if defined(XO_NO_INVERSE_DIVISION)
+    __m256 r = _mm256_div_ps(avx::One, _mm256_sqrt_ps(m));
+#   else
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m256 r = _mm256_rsqrt_ps(m);
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), _mm256_mul_ps(r, r))));
+#   endif
+    ymmX = _mm256_mul_ps(ymmX, r);
+    ymmY = _mm256_mul_ps(ymmY, r);
+    ymmZ = _mm256_mul_ps(ymmZ, r);
+#else
+    float m[8];
+    Magnitude(m);
+    for (int i = 0; i < 8; ++i) {
+        x[i] /= m[i];
+        y[i] /= m[i];
+        z[i] /= m[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::NormalizeSafe() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+    __m256 nonZero = _mm256_cmp_ps(m, avx::Zero, _CMP_GT_OQ);
+    Vector3x8 n = Normalized();
+    ymmX = _mm256_blendv_ps(ymmX, n.ymmX, nonZero);
+    ymmY = _mm256_blendv_ps(ymmY, n.ymmY, nonZero);
+    ymmZ = _mm256_blendv_ps(ymmZ, n.ymmZ, nonZero);
+#else
+    float m[8];
+    MagnitudeSquared(m);
+    for (int i = 0; i < 8; ++i) {
+        if (m[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector3x8::Cross(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    __m256 x = _mm256_sub_ps(_mm256_mul_ps(a.ymmY, b.ymmZ), _mm256_mul_ps(a.ymmZ, b.ymmY));
+    __m256 y = _mm256_sub_ps(_mm256_mul_ps(a.ymmZ, b.ymmX), _mm256_mul_ps(a.ymmX, b.ymmZ));
+    __m256 z = _mm256_sub_ps(_mm256_mul_ps(a.ymmX, b.ymmY), _mm256_mul_ps(a.ymmY, b.ymmX));
+    outVec.ymmX = x;
+    outVec.ymmY = y;
+    outVec.ymmZ = z;
+#else
+    Vector3x8 t;
+    for (int i = 0; i < 8; ++i) {
+        t.x[i] = (a.y[i] * b.z[i]) - (a.z[i] * b.y[i]);
+        t.y[i] = (a.z[i] * b.x[i]) - (a.x[i] * b.z[i]);
+        t.z[i] = (a.x[i] * b.y[i]) - (a.y[i] * b.x[i]);
+    }
+    outVec = t;
+#endif
+}
+
+void Vector3x8::Dot(const Vector3x8& a, const Vector3x8& b, float* outDots) {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outDots, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a.ymmX, b.ymmX), _mm256_mul_ps(a.ymmY, b.ymmY)), _mm256_mul_ps(a.ymmZ, b.ymmZ)));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outDots[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+    }
+#endif
+}
+
+void Vector3x8::Lerp(const Vector3x8& a, const Vector3x8& b, const float* t, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    __m256 vt = _mm256_loadu_ps(t);
+    outVec.ymmX = _mm256_add_ps(a.ymmX, _mm256_mul_ps(_mm256_sub_ps(b.ymmX, a.ymmX), vt));
+    outVec.ymmY = _mm256_add_ps(a.ymmY, _mm256_mul_ps(_mm256_sub_ps(b.ymmY, a.ymmY), vt));
+    outVec.ymmZ = _mm256_add_ps(a.ymmZ, _mm256_mul_ps(_mm256_sub_ps(b.ymmZ, a.ymmZ), vt));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outVec.x[i] = a.x[i] + ((b.x[i] - a.x[i]) * t[i]);
+        outVec.y[i] = a.y[i] + ((b.y[i] - a.y[i]) * t[i]);
+        outVec.z[i] = a.z[i] + ((b.z[i] - a.z[i]) * t[i]);
+    }
+#endif
+}
+
+void Vector3x8::Max(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_max_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_max_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_max_ps(a.ymmZ, b.ymmZ);
+#else
+    for (int i = 0; i < 24; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector3x8::Min(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_min_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_min_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_min_ps(a.ymmZ, b.ymmZ);
+#else
+    for (int i = 0; i < 24; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+Vector4x8::Vector4x8(float f) {
+#if defined(XO_AVX)
+    ymmX = ymmY = ymmZ = ymmW = _mm256_set1_ps(f);
+#else
+    for (int i = 0; i < 32; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector4x8::Vector4x8(const Vector4& v) {
+    Set(v);
+}
+
+Vector4x8::Vector4x8(const Vector4x4& low, const Vector4x4& high) {
+    Set(low, high);
+}
+
+Vector4x8::Vector4x8(const Vector4x8& v) {
+    Set(v);
+}
+
+#if defined(XO_AVX)
+Vector4x8::Vector4x8(const __m256& x, const __m256& y, const __m256& z, const __m256& w) :
+    ymmX(x), ymmY(y), ymmZ(z), ymmW(w)
+{
+}
+#endif
+
+Vector4x8& Vector4x8::Set(const Vector4& v) {
+#if defined(XO_AVX)
+    ymmX = _mm256_set1_ps(v.x);
+    ymmY = _mm256_set1_ps(v.y);
+    ymmZ = _mm256_set1_ps(v.z);
+    ymmW = _mm256_set1_ps(v.w);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+        w[i] = v.w;
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::Set(const Vector4x4& low, const Vector4x4& high) {
+#if defined(XO_AVX)
+    ymmX = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmX), high.xmmX, 1);
+    ymmY = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmY), high.xmmY, 1);
+    ymmZ = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmZ), high.xmmZ, 1);
+    ymmW = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmW), high.xmmW, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = low.x[i];
+        y[i] = low.y[i];
+        z[i] = low.z[i];
+        w[i] = low.w[i];
+        x[i + 4] = high.x[i];
+        y[i + 4] = high.y[i];
+        z[i + 4] = high.z[i];
+        w[i + 4] = high.w[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::Set(const Vector4x8& v) {
+#if defined(XO_AVX)
+    ymmX = v.ymmX;
+    ymmY = v.ymmY;
+    ymmZ = v.ymmZ;
+    ymmW = v.ymmW;
+#else
+    for (int i = 0; i < 32; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::SetLane(int lane, const Vector4& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    w[lane] = v.w;
+    return *this;
+}
+
+Vector4 Vector4x8::GetLane(int lane) const {
+    return Vector4(x[lane], y[lane], z[lane], w[lane]);
+}
+
+void Vector4x8::Get(Vector4x4& low, Vector4x4& high) const {
+#if defined(XO_AVX)
+    low.xmmX = _mm256_castps256_ps128(ymmX);
+    low.xmmY = _mm256_castps256_ps128(ymmY);
+    low.xmmZ = _mm256_castps256_ps128(ymmZ);
+    low.xmmW = _mm256_castps256_ps128(ymmW);
+    high.xmmX = _mm256_extractf128_ps(ymmX, 1);
+    high.xmmY = _mm256_extractf128_ps(ymmY, 1);
+    high.xmmZ = _mm256_extractf128_ps(ymmZ, 1);
+    high.xmmW = _mm256_extractf128_ps(ymmW, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        low.SetLane(i, GetLane(i));
+        high.SetLane(i, GetLane(i + 4));
+    }
+#endif
+}
+
+Vector4x8 Vector4x8::Load(const Vector4* v) {
+#if defined(XO_AVX)
+    // See Vector3x8::Load, this also keeps w.
+    __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[0].xmm), v[4].xmm, 1);
+    __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[1].xmm), v[5].xmm, 1);
+    __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[2].xmm), v[6].xmm, 1);
+    __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[3].xmm), v[7].xmm, 1);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    return Vector4x8(
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+#else
+    Vector4x8 r;
+    for (int i = 0; i < 8; ++i) {
+        r.SetLane(i, v[i]);
+    }
+    return r;
+#endif
+}
+
+Vector4x8 Vector4x8::LoadPartial(const Vector4* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector4x8::LoadPartial count must be between 0 and 8.");
+    if (count == 8) {
+        return Load(v);
+    }
+    Vector4 t[8];
+    for (int i = 0; i < 8; ++i) {
+        t[i] = i < count ? v[i] : Vector4::Zero;
+    }
+    return Load(t);
+}
+
+Vector4x8 Vector4x8::LoadSoA(const float* x, const float* y, const float* z, const float* w) {
+#if defined(XO_AVX)
+    return Vector4x8(_mm256_loadu_ps(x), _mm256_loadu_ps(y), _mm256_loadu_ps(z), _mm256_loadu_ps(w));
+#else
+    Vector4x8 v;
+    for (int i = 0; i < 8; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+        v.w[i] = w[i];
+    }
+    return v;
+#endif
+}
+
+void Vector4x8::Store(Vector4* v) const {
+#if defined(XO_AVX)
+    __m256 t0 = _mm256_unpacklo_ps(ymmX, ymmY);
+    __m256 t1 = _mm256_unpackhi_ps(ymmX, ymmY);
+    __m256 t2 = _mm256_unpacklo_ps(ymmZ, ymmW);
+    __m256 t3 = _mm256_unpackhi_ps(ymmZ, ymmW);
+    __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    v[0].xmm = _mm256_castps256_ps128(r0);
+    v[1].xmm = _mm256_castps256_ps128(r1);
+    v[2].xmm = _mm256_castps256_ps128(r2);
+    v[3].xmm = _mm256_castps256_ps128(r3);
+    v[4].xmm = _mm256_extractf128_ps(r0, 1);
+    v[5].xmm = _mm256_extractf128_ps(r1, 1);
+    v[6].xmm = _mm256_extractf128_ps(r2, 1);
+    v[7].xmm = _mm256_extractf128_ps(r3, 1);
+#else
+    for (int i = 0; i < 8; ++i) {
+        v[i] = GetLane(i);
+    }
+#endif
+}
+
+void Vector4x8::StorePartial(Vector4* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector4x8::StorePartial count must be between 0 and 8.");
+    if (count == 8) {
+        Store(v);
+        return;
+    }
+    Vector4 t[8];
+    Store(t);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector4x8::StoreSoA(float* x, float* y, float* z, float* w) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(x, ymmX);
+    _mm256_storeu_ps(y, ymmY);
+    _mm256_storeu_ps(z, ymmZ);
+    _mm256_storeu_ps(w, ymmW);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+        w[i] = this->w[i];
+    }
+#endif
+}
+
+Vector4x8 Vector4x8::operator -() const {
+#if defined(XO_AVX)
+    return Vector4x8(_mm256_xor_ps(ymmX, avx::SignMask), _mm256_xor_ps(ymmY, avx::SignMask),
+                     _mm256_xor_ps(ymmZ, avx::SignMask), _mm256_xor_ps(ymmW, avx::SignMask));
+#else
+    Vector4x8 v;
+    for (int i = 0; i < 32; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_AVX)
+#   define _XO_W4X8_OP_X8(op, avxop) \
+    Vector4x8& Vector4x8::operator op (const Vector4x8& v) { \
+        ymmX = avxop(ymmX, v.ymmX); ymmY = avxop(ymmY, v.ymmY); ymmZ = avxop(ymmZ, v.ymmZ); ymmW = avxop(ymmW, v.ymmW); \
+        return *this; \
+    }
+#   define _XO_W4X8_OP_F(op, avxop) \
+    Vector4x8& Vector4x8::operator op (float v) { \
+        __m256 s = _mm256_set1_ps(v); \
+        ymmX = avxop(ymmX, s); ymmY = avxop(ymmY, s); ymmZ = avxop(ymmZ, s); ymmW = avxop(ymmW, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W4X8_OP_X8(op, avxop) \
+    Vector4x8& Vector4x8::operator op (const Vector4x8& v) { \
+        for (int i = 0; i < 32; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X8_OP_F(op, avxop) \
+    Vector4x8& Vector4x8::operator op (float v) { \
+        for (int i = 0; i < 32; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W4X8_OP_X8(+=, _mm256_add_ps)
+_XO_W4X8_OP_F(+=, _mm256_add_ps)
+_XO_W4X8_OP_X8(-=, _mm256_sub_ps)
+_XO_W4X8_OP_F(-=, _mm256_sub_ps)
+_XO_W4X8_OP_X8(*=, _mm256_mul_ps)
+_XO_W4X8_OP_F(*=, _mm256_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_AVX)
+_XO_W4X8_OP_X8(/=, _mm256_div_ps)
+#else
+// See Vector3x8::operator/=.
+Vector4x8& Vector4x8::operator /= (const Vector4x8& v) {
+    ymmX = _mm256_mul_ps(ymmX, _mm256_rcp_ps(v.ymmX));
+    ymmY = _mm256_mul_ps(ymmY, _mm256_rcp_ps(v.ymmY));
+    ymmZ = _mm256_mul_ps(ymmZ, _mm256_rcp_ps(v.ymmZ));
+    ymmW = _mm256_mul_ps(ymmW, _mm256_rcp_ps(v.ymmW));
+    return *this;
+}
+#endif
+
+#undef _XO_W4X8_OP_X8
+#undef _XO_W4X8_OP_F
+
+Vector4x8& Vector4x8::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector4x8& Vector4x8::operator += (const Vector4& v)        { return (*this) += Vector4x8(v); }
+Vector4x8& Vector4x8::operator += (double v)                { return (*this) += float(v); }
+Vector4x8& Vector4x8::operator += (int v)                   { return (*this) += float(v); }
+Vector4x8& Vector4x8::operator -= (const Vector4& v)        { return (*this) -= Vector4x8(v); }
+Vector4x8& Vector4x8::operator -= (double v)                { return (*this) -= float(v); }
+Vector4x8& Vector4x8::operator -= (int v)                   { return (*this) -= float(v); }
+Vector4x8& Vector4x8::operator *= (const Vector4& v)        { return (*this) *= Vector4x8(v); }
+Vector4x8& Vector4x8::operator *= (double v)                { return (*this) *= float(v); }
+Vector4x8& Vector4x8::operator *= (int v)                   { return (*this) *= float(v); }
+Vector4x8& Vector4x8::operator /= (const Vector4& v)        { return (*this) /= Vector4x8(v); }
+Vector4x8& Vector4x8::operator /= (double v)                { return (*this) /= float(v); }
+Vector4x8& Vector4x8::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector4x8 Vector4x8::operator + (const Vector4x8& v) const  { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (const Vector4& v) const    { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (float v) const             { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (double v) const            { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (int v) const               { return Vector4x8(*this) += v; }
+
+Vector4x8 Vector4x8::operator - (const Vector4x8& v) const  { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (const Vector4& v) const    { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (float v) const             { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (double v) const            { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (int v) const               { return Vector4x8(*this) -= v; }
+
+Vector4x8 Vector4x8::operator * (const Vector4x8& v) const  { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (const Vector4& v) const    { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (float v) const             { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (double v) const            { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (int v) const               { return Vector4x8(*this) *= v; }
+
+Vector4x8 Vector4x8::operator / (const Vector4x8& v) const  { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (const Vector4& v) const    { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (float v) const             { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (double v) const            { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (int v) const               { return Vector4x8(*this) /= v; }
+
+bool Vector4x8::operator == (const Vector4x8& v) const {
+#if defined(XO_AVX)
+    __m256 eq = _mm256_and_ps(
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmX, ymmX)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmY, ymmY)), avx::Epsilon, _CMP_LT_OQ)),
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmZ, ymmZ)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmW, ymmW)), avx::Epsilon, _CMP_LT_OQ)));
+    return _mm256_movemask_ps(eq) == 255;
+#else
+    for (int i = 0; i < 32; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector4::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector4x8::operator != (const Vector4x8& v) const      { return !((*this) == v); }
+
+void Vector4x8::Magnitude(float* outMagnitudes) const {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+    _mm256_storeu_ps(outMagnitudes, _mm256_sqrt_ps(m));
+#else
+    MagnitudeSquared(outMagnitudes);
+    for (int i = 0; i < 8; ++i) {
+        outMagnitudes[i] = Sqrt(outMagnitudes[i]);
+    }
+#endif
+}
+
+void Vector4x8::Sum(float* outSums) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outSums, _mm256_add_ps(_mm256_add_ps(ymmX, ymmY), _mm256_add_ps(ymmZ, ymmW)));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outSums[i] = x[i] + y[i] + z[i] + w[i];
+    }
+#endif
+}
+
+Vector4x8& Vector4x8::Normalize() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+#   if defined(XO_NO_INVERSE_DIVISION)
+    __m256 r = _mm256_div_ps(avx::One, _mm256_sqrt_ps(m));
+#   else
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m256 r = _mm256_rsqrt_ps(m);
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), _mm256_mul_ps(r, r))));
+#   endif
+    ymmX = _mm256_mul_ps(ymmX, r);
+    ymmY = _mm256_mul_ps(ymmY, r);
+    ymmZ = _mm256_mul_ps(ymmZ, r);
+    ymmW = _mm256_mul_ps(ymmW, r);
+#else
+    float m[8];
+    Magnitude(m);
+    for (int i = 0; i < 8; ++i) {
+        x[i] /= m[i];
+        y[i] /= m[i];
+        z[i] /= m[i];
+        w[i] /= m[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::NormalizeSafe() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+    __m256 nonZero = _mm256_cmp_ps(m, avx::Zero, _CMP_GT_OQ);
+    Vector4x8 n = Normalized();
+    ymmX = _mm256_blendv_ps(ymmX, n.ymmX, nonZero);
+    ymmY = _mm256_blendv_ps(ymmY, n.ymmY, nonZero);
+    ymmZ = _mm256_blendv_ps(ymmZ, n.ymmZ, nonZero);
+    ymmW = _mm256_blendv_ps(ymmW, n.ymmW, nonZero);
+#else
+    float m[8];
+    MagnitudeSquared(m);
+    for (int i = 0; i < 8; ++i) {
+        if (m[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+            w[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector4x8::Dot(const Vector4x8& a, const Vector4x8& b, float* outDots) {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outDots, _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(a.ymmX, b.ymmX), _mm256_mul_ps(a.ymmY, b.ymmY)),
+        _mm256_add_ps(_mm256_mul_ps(a.ymmZ, b.ymmZ), _mm256_mul_ps(a.ymmW, b.ymmW))));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outDots[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) + (a.w[i] * b.w[i]);
+    }
+#endif
+}
+
+void Vector4x8::Lerp(const Vector4x8& a, const Vector4x8& b, const float* t, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    __m256 vt = _mm256_loadu_ps(t);
+    outVec.ymmX = _mm256_add_ps(a.ymmX, _mm256_mul_ps(_mm256_sub_ps(b.ymmX, a.ymmX), vt));
+    outVec.ymmY = _mm256_add_ps(a.ymmY, _mm256_mul_ps(_mm256_sub_ps(b.ymmY, a.ymmY), vt));
+    outVec.ymmZ = _mm256_add_ps(a.ymmZ, _mm256_mul_ps(_mm256_sub_ps(b.ymmZ, a.ymmZ), vt));
+    outVec.ymmW = _mm256_add_ps(a.ymmW, _mm256_mul_ps(_mm256_sub_ps(b.ymmW, a.ymmW), vt));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outVec.x[i] = a.x[i] + ((b.x[i] - a.x[i]) * t[i]);
+        outVec.y[i] = a.y[i] + ((b.y[i] - a.y[i]) * t[i]);
+        outVec.z[i] = a.z[i] + ((b.z[i] - a.z[i]) * t[i]);
+        outVec.w[i] = a.w[i] + ((b.w[i] - a.w[i]) * t[i]);
+    }
+#endif
+}
+
+void Vector4x8::Max(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_max_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_max_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_max_ps(a.ymmZ, b.ymmZ);
+    outVec.ymmW = _mm256_max_ps(a.ymmW, b.ymmW);
+#else
+    for (int i = 0; i < 32; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector4x8::Min(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_min_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_min_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_min_ps(a.ymmZ, b.ymmZ);
+    outVec.ymmW = _mm256_min_ps(a.ymmW, b.ymmW);
+#else
+    for (int i = 0; i < 32; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+Float3::Float3(float x, float y, float z) :
+    x(x),
+    y(y),
+    z(z)
+{
+}
+
+Float3::Float3(const Vector3& v) :
+    x(v.x),
+    y(v.y),
+    z(v.z)
+{
+}
+
+Float3::operator Vector3() const {
+    return Vector3(x, y, z);
+}
+
+size_t Vector3Array::GetCount() const {
+    return elements.size();
+}
+
+Vector3 Vector3Array::Get(size_t i) const {
+    return elements[i];
+}
+
+void Vector3Array::Set(size_t i, const Vector3& v) {
+    elements[i] = Float3(v);
+}
+
+Float3* Vector3Array::GetData() {
+    return elements.data();
+}
+
+const Float3* Vector3Array::GetData() const {
+    return elements.data();
+}
+
+Float3& Vector3Array::operator [](size_t i) {
+    return elements[i];
+}
+
+const Float3& Vector3Array::operator [](size_t i) const {
+    return elements[i];
+}
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+void* FrameArena::Allocate(size_t size, size_t align) {
+    char* p = (char*)(((uintptr_t)cursor + (align - 1)) & ~(uintptr_t)(align - 1));
+    // before the first block, cursor and end are both null, so this takes the slow path.
+    if (p > end || size > (size_t)(end - p)) {
+        return AllocateFromNewBlock(size, align);
+    }
+    used += (size_t)(p - cursor) + size;
+    peak = used > peak ? used : peak;
+    ++allocationCount;
+    cursor = p + size;
+    return p;
+}
+
+template <typename T>
+T* FrameArena::Allocate(size_t n) {
+    static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors, so T must not need one.");
+    if (n > ~(size_t)0 / sizeof(T)) {
+        return nullptr;
+    }
+    return (T*)Allocate(n * sizeof(T), alignof(T) > 16 ? alignof(T) : 16);
+}
+
+Vector3* FrameArena::AllocateVector3s(size_t n) {
+    return Allocate<Vector3>(n);
+}
+
+Matrix4x4* FrameArena::AllocateMatrix4x4s(size_t n) {
+    return Allocate<Matrix4x4>(n);
+}
+
+XOMATH_END_XO_NS();
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+
+namespace sse {
+
+    // The control of MXCSR usage is inspired by Agner Fog's use of them in vectorclasses.
+    // vectorclasses uses them to optionally speed up subnormal operations.
+    // To achieve this in xomath, call the following once per thread where xo-math is used:
+    //      sse::UpdateControlWord();       // updates the thread-local state.
+    //      sse::SetDenormalsAreZero(true); // force all denormal values to 0
+    //      sse::SetFlushToZero(true);      // underflowing operations produce 0
+    // Note: this will only produce speed gains where subnormal values are likely to occur.
+    // See http://wm.ite.pl/articles/sse-penalties-of-errors.html for more details.
+    namespace mxcsr {
+        // Flags that are set on the CPU if an exception had occured.
+        // They will remain set until manually unset.
+        enum class Flags {
+            InvalidOperation                = (1 << 0),
+            Denormal                        = (1 << 1),
+            DivideByZero                    = (1 << 2),
+            Overflow                        = (1 << 3),
+            Underflow                       = (1 << 4),
+            Precision                       = (1 << 5),
+        };
+
+        enum class DAZ {
+            DenormalsAreZero                = (1 << 6),
+        };
+
+        enum class Masks {
+            InvalidOperation                = (1 << 7),
+            Denormal                        = (1 << 8),
+            DivideByZero                    = (1 << 9),
+            Overflow                        = (1 << 10),
+            Underflow                       = (1 << 11),
+            Precision                       = (1 << 12)
+        };
+
+        enum class Rounding {
+            Nearest                         = 0,
+            Negative                        = (1 << 13),
+            Positive                        = (1 << 14),
+            Zero                            = (1 << 13) | (1 << 14),
+            
+            Bits                            = (1 << 13) | (1 << 14)
+        };
+
+        enum class FZ {
+            FlushToZero                     = (1 << 15)
+        };
+    }
+
+    bool GetControlMask(mxcsr::Masks mask, bool withUpdate = false);
+    bool GetControlMask(unsigned mask, bool withUpdate = false);
+    bool GetDenormalExceptionMask(bool withUpdate = false);
+    bool GetDivideByZeroExceptionMask(bool withUpdate = false);
+    bool GetInvalidOperationExceptionMask(bool withUpdate = false);
+    bool GetOverflowExceptionMask(bool withUpdate = false);
+    bool GetPrecisionExceptionMask(bool withUpdate = false);
+    bool GetUnderflowExceptionMask(bool withUpdate = false);
+
+    bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate = false, bool thenFlush = false);
+    bool HasControlFlagBeenSet(unsigned flags, bool withUpdate = false, bool thenFlush = false);
+    bool HasDenormalExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+    bool HasDenormalsAreZeroSet(bool withUpdate = false);
+    bool HasDivideByZeroExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+    bool HasFlushToZeroSet(bool withUpdate = false);
+    bool HasInvalidOperationExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+    bool HasOverflowExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+    bool HasPrecisionExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+    bool HasUnderflowExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+
+    mxcsr::Rounding GetRoundingMode(bool withUpdate = false);
+    void GetAllMXCSRInfo(std::ostream& os, bool withUpdate = false);
+
+    void RemoveControlWord(unsigned control);
+
+    void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate = false);
+    void SetControlMask(unsigned mask, bool value, bool withUpdate = false);
+    void SetControlWord(unsigned control);
+    void SetControlWordAddative(unsigned control);
+    void SetDenormalExceptionMask(bool value, bool withUpdate = false);
+    void SetDenormalsAreZero(bool value, bool withUpdate = false);
+    void SetDivideByZeroExceptionMask(bool value, bool withUpdate = false);
+    void SetFlushToZero(bool value, bool withUpdate = false);
+    void SetInvalidOperationExceptionMask(bool value, bool withUpdate = false);
+    void SetOverflowExceptionMask(bool value, bool withUpdate = false);
+    void SetPrecisionExceptionMask(bool value, bool withUpdate = false);
+    void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate = false);
+    void SetRoundingMode(unsigned mode, bool withUpdate = false);
+    void SetUnderflowExceptionMask(bool value, bool withUpdate = false);
+
+    void ThrowAllExceptions(bool withUpdate = false);
+    void ThrowNoExceptions(bool withUpdate = false);
+    void UpdateControlWord();
+}
+#endif
+
+XOMATH_END_XO_NS();
+
+
+#if defined(XO_HEADER_ONLY) && !defined(_XO_MATH_OBJ)
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Dispatch.cpp
+
+namespace xo_internal
+{
+#if defined(XO_DISPATCH)
+    _XOSRCINL void CPUID(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#   if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subleaf);
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = (unsigned)r[i];
+        }
+#   else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#   endif
+    }
+
+    // The register state the operating system saves on a context switch.
+    _XOSRCINL unsigned long long XGETBV() {
+#   if defined(_MSC_VER)
+        return _xgetbv(0);
+#   else
+        unsigned eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((unsigned long long)edx << 32) | eax;
+#   endif
+    }
+#endif
+
+#if defined(XO_SSE2)
+    // The kernels for the highest tier, no higher than tier, that this build has kernels for.
+    // The tables are function statics so that a header only build shares one of each between translation units.
+    _XOSRCINL const DispatchKernels* KernelsForTier(SIMDTier tier) {
+        static const DispatchKernels SSE2Kernels = {
+            SIMDTier::SSE2,
+            TransformVector3Array,
+            TransformVector4Array,
+            MultiplyBatch,
+            MultiplyIndexedBatch,
+            InverseBatch,
+            SinCosArray,
+            DotVector3Array,
+            NormalizeVector3Array,
+            RotateVector3Batch,
+            BlendQuaternionBatch,
+            SkinVertices,
+            SkinVerticesDualQuaternion,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3Array
+        };
+        const DispatchKernels* kernels = &SSE2Kernels;
+        (void)tier;
+#   if defined(_XO_KERNELS_AVX)
+        static const DispatchKernels AVXKernels = {
+            SIMDTier::AVX,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArray,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX) {
+            kernels = &AVXKernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX2)
+        static const DispatchKernels AVX2Kernels = {
+            SIMDTier::AVX2,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArrayAVX2,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX2) {
+            kernels = &AVX2Kernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX512)
+        static const DispatchKernels AVX512Kernels = {
+            SIMDTier::AVX512,
+            TransformVector3ArrayAVX512,
+            TransformVector4ArrayAVX512,
+            MultiplyBatchAVX512,
+            MultiplyIndexedBatchAVX512,
+            InverseBatchAVX512,
+            SinCosArrayAVX512,
+            DotVector3ArrayAVX512,
+            NormalizeVector3ArrayAVX512,
+            RotateVector3BatchAVX512,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX512) {
+            kernels = &AVX512Kernels;
+        }
+#   endif
+        return kernels;
+    }
+
+    _XOSRCINL std::atomic<const DispatchKernels*>& SelectedKernels() {
+        static std::atomic<const DispatchKernels*> selected(nullptr);
+        return selected;
+    }
+#endif
+}
+
+_XOSRCINL SIMDTier DetectSIMDTier() {
+#if defined(XO_DISPATCH)
+    unsigned regs[4];
+    xo_internal::CPUID(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return SIMDTier::None;
+    }
+    xo_internal::CPUID(1, 0, regs);
+    if (!(regs[3] & (1u << 26))) {
+        return SIMDTier::None;
+    }
+    // AVX needs the CPU to support it, and the OS to save the ymm registers (xgetbv bits 1 and 2).
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    if (!osxsave || !(regs[2] & (1u << 28)) || (xo_internal::XGETBV() & 0x6) != 0x6) {
+        return SIMDTier::SSE2;
+    }
+    // The AVX2 tier's kernels also use F16C, which every AVX2 CPU has.
+    const bool f16c = (regs[2] & (1u << 29)) != 0;
+    if (maxLeaf < 7) {
+        return SIMDTier::AVX;
+    }
+    xo_internal::CPUID(7, 0, regs);
+    if (!(regs[1] & (1u << 5)) || !f16c) {
+        return SIMDTier::AVX;
+    }
+    // AVX-512 F, DQ, BW and VL, with the OS also saving the opmask and zmm registers (xgetbv bits 5 to 7).
+    const unsigned avx512Bits = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+    if ((regs[1] & avx512Bits) != avx512Bits || (xo_internal::XGETBV() & 0xe6) != 0xe6) {
+        return SIMDTier::AVX2;
+    }
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX512)
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX2)
+    return SIMDTier::AVX2;
+#elif defined(XO_AVX)
+    return SIMDTier::AVX;
+#elif defined(XO_SSE2)
+    return SIMDTier::SSE2;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL void InitDispatch(SIMDTier maxTier) {
+#if defined(XO_SSE2)
+    const SIMDTier cpuTier = DetectSIMDTier();
+    xo_internal::SelectedKernels().store(xo_internal::KernelsForTier(cpuTier < maxTier ? cpuTier : maxTier));
+#else
+    (void)maxTier;
+#endif
+}
+
+_XOSRCINL SIMDTier GetDispatchTier() {
+#if defined(XO_SSE2)
+    return xo_internal::GetDispatchKernels().tier;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL const char* GetSIMDTierName(SIMDTier tier) {
+    switch (tier) {
+        case SIMDTier::None:    return "none";
+        case SIMDTier::SSE2:    return "sse2";
+        case SIMDTier::AVX:     return "avx";
+        case SIMDTier::AVX2:    return "avx2";
+        case SIMDTier::AVX512:  return "avx512";
+    }
+    return "unknown";
+}
+
+#if defined(XO_SSE2)
+_XOSRCINL const xo_internal::DispatchKernels& xo_internal::GetDispatchKernels() {
+    const DispatchKernels* kernels = SelectedKernels().load(std::memory_order_relaxed);
+    if (!kernels) {
+        InitDispatch();
+        kernels = SelectedKernels().load();
+    }
+    return *kernels;
+}
+#endif
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// DualQuaternion.cpp
+
+_XOSRCDATA const DualQuaternion DualQuaternion::Identity(Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL DualQuaternion::DualQuaternion() {
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    real(real),
+    dual(dual)
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector3& translation) :
+    real(rotation)
+{
+    // q_d = t q_r / 2, with t as a quaternion with no w.
+    Quaternion d = Quaternion(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.0f) * rotation;
+    dual = d;
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix3x4& m) :
+    DualQuaternion(Quaternion(m), m.GetTranslation())
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix4x4& m) :
+    DualQuaternion(Matrix3x4(m))
+{
+}
+
+#if defined(XO_SSE)
+namespace xo_internal
+{
+    // The four component dot product of a and b, in every lane.
+    _XOINL __m128 DualQuaternionDot(__m128 a, __m128 b) {
+        __m128 p = _mm_mul_ps(a, b);
+        p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+}
+#endif
+
+_XOSRCINL DualQuaternion& DualQuaternion::Normalize() {
+#if defined(XO_SSE)
+    __m128 r = real.xmm, d = dual.xmm;
+    __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(xo_internal::DualQuaternionDot(r, r)));
+    r = _mm_mul_ps(r, inverseLength);
+    d = _mm_mul_ps(d, inverseLength);
+    // q_d's component along q_r only adds to the w of the translation 2 q_d q_r^*, so it can go.
+    real.xmm = r;
+    dual.xmm = _mm_sub_ps(d, _mm_mul_ps(r, xo_internal::DualQuaternionDot(r, d)));
+#else
+    Vector4 r(real), d(dual);
+    float inverseLength = 1.0f / Sqrt(r.MagnitudeSquared());
+    r *= inverseLength;
+    d *= inverseLength;
+    d -= r * Vector4::Dot(r, d);
+    real = Quaternion(r.x, r.y, r.z, r.w);
+    dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Normalized() const {
+    return DualQuaternion(*this).Normalize();
+}
+
+_XOSRCINL DualQuaternion& DualQuaternion::MakeInverse() {
+    real.MakeConjugate();
+    dual.MakeConjugate();
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Inverse() const {
+    return DualQuaternion(*this).MakeInverse();
+}
+
+_XOSRCINL void DualQuaternion::Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outDualQuaternion) {
+#if defined(XO_SSE)
+    // t for b takes the sign of the dot product of the rotations, without a branch.
+    __m128 ta = _mm_set1_ps(1.0f - t);
+    __m128 tb = _mm_xor_ps(_mm_set1_ps(t), _mm_and_ps(xo_internal::DualQuaternionDot(a.real.xmm, b.real.xmm), _mm_set1_ps(-0.0f)));
+    outDualQuaternion.real.xmm = _mm_add_ps(_mm_mul_ps(a.real.xmm, ta), _mm_mul_ps(b.real.xmm, tb));
+    outDualQuaternion.dual.xmm = _mm_add_ps(_mm_mul_ps(a.dual.xmm, ta), _mm_mul_ps(b.dual.xmm, tb));
+#else
+    Vector4 ar(a.real), ad(a.dual), br(b.real), bd(b.dual);
+    float tb = Vector4::Dot(ar, br) < 0.0f ? -t : t;
+    Vector4 r = ar * (1.0f - t) + br * tb;
+    Vector4 d = ad * (1.0f - t) + bd * tb;
+    outDualQuaternion.real = Quaternion(r.x, r.y, r.z, r.w);
+    outDualQuaternion.dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    outDualQuaternion.Normalize();
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four dual quaternions, one per lane, with each register holding one component of all four.
+    struct DualQuaternionLanes {
+        __m128 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Bone k of each of four vertices, one vertex per lane.
+    _XOINL void LoadBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanes& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        o.rx = b0.real.xmm; o.ry = b1.real.xmm; o.rz = b2.real.xmm; o.rw = b3.real.xmm;
+        o.dx = b0.dual.xmm; o.dy = b1.dual.xmm; o.dz = b2.dual.xmm; o.dw = b3.dual.xmm;
+        _MM_TRANSPOSE4_PS(o.rx, o.ry, o.rz, o.rw);
+        _MM_TRANSPOSE4_PS(o.dx, o.dy, o.dz, o.dw);
+    }
+
+    // Adds bone k of four vertices to sum, weighted. The weight is negated where the bone's rotation is in the
+    // other hemisphere from the first bone's, so every bone is blended the shorter way around.
+    _XOINL void AddBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m128 weight, const DualQuaternionLanes& first, DualQuaternionLanes& sum) {
+        DualQuaternionLanes b;
+        LoadBoneLanes(palette, influences, k, b);
+        __m128 cosine = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.rx, first.rx), _mm_mul_ps(b.ry, first.ry)), _mm_add_ps(_mm_mul_ps(b.rz, first.rz), _mm_mul_ps(b.rw, first.rw)));
+        weight = _mm_xor_ps(weight, _mm_and_ps(cosine, _mm_set1_ps(-0.0f)));
+        sum.rx = _mm_add_ps(sum.rx, _mm_mul_ps(b.rx, weight));
+        sum.ry = _mm_add_ps(sum.ry, _mm_mul_ps(b.ry, weight));
+        sum.rz = _mm_add_ps(sum.rz, _mm_mul_ps(b.rz, weight));
+        sum.rw = _mm_add_ps(sum.rw, _mm_mul_ps(b.rw, weight));
+        sum.dx = _mm_add_ps(sum.dx, _mm_mul_ps(b.dx, weight));
+        sum.dy = _mm_add_ps(sum.dy, _mm_mul_ps(b.dy, weight));
+        sum.dz = _mm_add_ps(sum.dz, _mm_mul_ps(b.dz, weight));
+        sum.dw = _mm_add_ps(sum.dw, _mm_mul_ps(b.dw, weight));
+    }
+
+    // sse::QuaternionRotate of x, y and z by the unit quaternion q, one per lane.
+    _XOINL void RotateLanes(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& x, __m128& y, __m128& z) {
+        __m128 tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+        __m128 ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+        __m128 tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+        x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+    }
+
+    // Dual quaternion linear blending of four vertices, one per lane. Each vertex's bones are summed by weight,
+    // then the position is transformed by the sum as DualQuaternion::Normalized then TransformPoint would, with the
+    // normalization folded into the rotation and translation rather than applied to the sum.
+    _XOINL void SkinDualQuaternionFour(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m128 w0 = _mm_loadu_ps(influences[0].weights);
+        __m128 w1 = _mm_loadu_ps(influences[1].weights);
+        __m128 w2 = _mm_loadu_ps(influences[2].weights);
+        __m128 w3 = _mm_loadu_ps(influences[3].weights);
+        _MM_TRANSPOSE4_PS(w0, w1, w2, w3);
+
+        DualQuaternionLanes first, sum;
+        LoadBoneLanes(palette, influences, 0, first);
+        sum.rx = _mm_mul_ps(first.rx, w0);
+        sum.ry = _mm_mul_ps(first.ry, w0);
+        sum.rz = _mm_mul_ps(first.rz, w0);
+        sum.rw = _mm_mul_ps(first.rw, w0);
+        sum.dx = _mm_mul_ps(first.dx, w0);
+        sum.dy = _mm_mul_ps(first.dy, w0);
+        sum.dz = _mm_mul_ps(first.dz, w0);
+        sum.dw = _mm_mul_ps(first.dw, w0);
+        AddBoneLanes(palette, influences, 1, w1, first, sum);
+        AddBoneLanes(palette, influences, 2, w2, first, sum);
+        AddBoneLanes(palette, influences, 3, w3, first, sum);
+
+        // 1 / |q_r|, from an approximate reciprocal square root and one Newton-Raphson step.
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sum.rx, sum.rx), _mm_mul_ps(sum.ry, sum.ry)), _mm_add_ps(_mm_mul_ps(sum.rz, sum.rz), _mm_mul_ps(sum.rw, sum.rw)));
+        __m128 inverseLength = _mm_rsqrt_ps(lengthSquared);
+        inverseLength = _mm_mul_ps(inverseLength, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared), _mm_mul_ps(inverseLength, inverseLength))));
+        __m128 qx = _mm_mul_ps(sum.rx, inverseLength);
+        __m128 qy = _mm_mul_ps(sum.ry, inverseLength);
+        __m128 qz = _mm_mul_ps(sum.rz, inverseLength);
+        __m128 qw = _mm_mul_ps(sum.rw, inverseLength);
+        // DualQuaternion::GetTranslation of the sum, divided by |q_r|^2 for the normalization.
+        __m128 scale = _mm_mul_ps(_mm_set1_ps(2.0f), _mm_mul_ps(inverseLength, inverseLength));
+        __m128 tx = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dx), _mm_mul_ps(sum.dw, sum.rx)), _mm_sub_ps(_mm_mul_ps(sum.ry, sum.dz), _mm_mul_ps(sum.rz, sum.dy))));
+        __m128 ty = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dy), _mm_mul_ps(sum.dw, sum.ry)), _mm_sub_ps(_mm_mul_ps(sum.rz, sum.dx), _mm_mul_ps(sum.rx, sum.dz))));
+        __m128 tz = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dz), _mm_mul_ps(sum.dw, sum.rz)), _mm_sub_ps(_mm_mul_ps(sum.rx, sum.dy), _mm_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m128 x = normals[0].xmm, y = normals[1].xmm, z = normals[2].xmm, w = normals[3].xmm;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            RotateLanes(qx, qy, qz, qw, x, y, z);
+            w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            outNormals[0].xmm = x;
+            outNormals[1].xmm = y;
+            outNormals[2].xmm = z;
+            outNormals[3].xmm = w;
+        }
+        __m128 x = positions[0].xmm, y = positions[1].xmm, z = positions[2].xmm, w = positions[3].xmm;
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        RotateLanes(qx, qy, qz, qw, x, y, z);
+        x = _mm_add_ps(x, tx);
+        y = _mm_add_ps(y, ty);
+        z = _mm_add_ps(z, tz);
+        w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        outPositions[0].xmm = x;
+        outPositions[1].xmm = y;
+        outPositions[2].xmm = z;
+        outPositions[3].xmm = w;
+    }
+#endif
+
+    _XOSRCINL void SkinVerticesDualQuaternion(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            SkinDualQuaternionFour(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        if (i < n) {
+            // The rest are padded out to four with the first bone at full weight.
+            Skinning::Influences tailInfluences[4];
+            Vector3 tailPositions[4], tailNormals[4];
+            for (size_t j = 0; j < 4; ++j) {
+                if (i + j < n) {
+                    tailInfluences[j] = influences[i + j];
+                    tailPositions[j] = positions[i + j];
+                    tailNormals[j] = normals ? normals[i + j] : Vector3::Zero;
+                }
+                else {
+                    tailInfluences[j] = influences[i];
+                    tailPositions[j] = Vector3::Zero;
+                    tailNormals[j] = Vector3::Zero;
+                }
+            }
+            SkinDualQuaternionFour(palette, tailInfluences, tailPositions, normals ? tailNormals : nullptr, tailPositions, tailNormals);
+            for (size_t j = 0; i + j < n; ++j) {
+                outPositions[i + j] = tailPositions[j];
+                if (normals) {
+                    outNormals[i + j] = tailNormals[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 first(palette[influence.bones[0]].real);
+            Vector4 r(0.0f), d(0.0f);
+            for (int k = 0; k < 4; ++k) {
+                const DualQuaternion& bone = palette[influence.bones[k]];
+                Vector4 br(bone.real);
+                float weight = Vector4::Dot(br, first) < 0.0f ? -influence.weights[k] : influence.weights[k];
+                r += br * weight;
+                d += Vector4(bone.dual) * weight;
+            }
+            DualQuaternion blended(Quaternion(r.x, r.y, r.z, r.w), Quaternion(d.x, d.y, d.z, d.w));
+            blended.Normalize();
+            if (normals) {
+                outNormals[i] = blended.TransformDirection(normals[i]);
+            }
+            outPositions[i] = blended.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // DualQuaternionLanes for eight vertices, with vertices j and j + 4 in lane j of the low and high halves.
+    struct DualQuaternionLanesAVX {
+        __m256 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Two 128 bit values, in the low and high halves.
+    _XOINL _XO_TARGET_AVX __m256 LanePair(__m128 low, __m128 high) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void LoadBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanesAVX& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        const DualQuaternion& b4 = palette[influences[4].bones[k]];
+        const DualQuaternion& b5 = palette[influences[5].bones[k]];
+        const DualQuaternion& b6 = palette[influences[6].bones[k]];
+        const DualQuaternion& b7 = palette[influences[7].bones[k]];
+        __m256 r[4] = { LanePair(b0.real.xmm, b4.real.xmm), LanePair(b1.real.xmm, b5.real.xmm), LanePair(b2.real.xmm, b6.real.xmm), LanePair(b3.real.xmm, b7.real.xmm) };
+        __m256 d[4] = { LanePair(b0.dual.xmm, b4.dual.xmm), LanePair(b1.dual.xmm, b5.dual.xmm), LanePair(b2.dual.xmm, b6.dual.xmm), LanePair(b3.dual.xmm, b7.dual.xmm) };
+        TransposeLanes4x4(r);
+        TransposeLanes4x4(d);
+        o.rx = r[0]; o.ry = r[1]; o.rz = r[2]; o.rw = r[3];
+        o.dx = d[0]; o.dy = d[1]; o.dz = d[2]; o.dw = d[3];
+    }
+
+    // AddBoneLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void AddBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m256 weight,
+                                               const DualQuaternionLanesAVX& first, DualQuaternionLanesAVX& sum) {
+        DualQuaternionLanesAVX b;
+        LoadBoneLanesAVX(palette, influences, k, b);
+        __m256 cosine = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b.rx, first.rx), _mm256_mul_ps(b.ry, first.ry)),
+                                      _mm256_add_ps(_mm256_mul_ps(b.rz, first.rz), _mm256_mul_ps(b.rw, first.rw)));
+        weight = _mm256_xor_ps(weight, _mm256_and_ps(cosine, _mm256_set1_ps(-0.0f)));
+        sum.rx = _mm256_add_ps(sum.rx, _mm256_mul_ps(b.rx, weight));
+        sum.ry = _mm256_add_ps(sum.ry, _mm256_mul_ps(b.ry, weight));
+        sum.rz = _mm256_add_ps(sum.rz, _mm256_mul_ps(b.rz, weight));
+        sum.rw = _mm256_add_ps(sum.rw, _mm256_mul_ps(b.rw, weight));
+        sum.dx = _mm256_add_ps(sum.dx, _mm256_mul_ps(b.dx, weight));
+        sum.dy = _mm256_add_ps(sum.dy, _mm256_mul_ps(b.dy, weight));
+        sum.dz = _mm256_add_ps(sum.dz, _mm256_mul_ps(b.dz, weight));
+        sum.dw = _mm256_add_ps(sum.dw, _mm256_mul_ps(b.dw, weight));
+    }
+
+    // RotateLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void RotateLanesAVX(__m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256& x, __m256& y, __m256& z) {
+        __m256 tx = _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y));
+        __m256 ty = _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z));
+        __m256 tz = _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x));
+        tx = _mm256_add_ps(tx, tx);
+        ty = _mm256_add_ps(ty, ty);
+        tz = _mm256_add_ps(tz, tz);
+        x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(qw, tx)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+        y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(qw, ty)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+        z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(qw, tz)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+    }
+
+    // SkinDualQuaternionFour for eight vertices. The vertex arrays are read and written 128 bits at a time, four
+    // apart, to match the lanes.
+    _XOINL _XO_TARGET_AVX void SkinDualQuaternionEight(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m256 w[4] = {
+            LanePair(_mm_loadu_ps(influences[0].weights), _mm_loadu_ps(influences[4].weights)),
+            LanePair(_mm_loadu_ps(influences[1].weights), _mm_loadu_ps(influences[5].weights)),
+            LanePair(_mm_loadu_ps(influences[2].weights), _mm_loadu_ps(influences[6].weights)),
+            LanePair(_mm_loadu_ps(influences[3].weights), _mm_loadu_ps(influences[7].weights))
+        };
+        TransposeLanes4x4(w);
+
+        DualQuaternionLanesAVX first, sum;
+        LoadBoneLanesAVX(palette, influences, 0, first);
+        sum.rx = _mm256_mul_ps(first.rx, w[0]);
+        sum.ry = _mm256_mul_ps(first.ry, w[0]);
+        sum.rz = _mm256_mul_ps(first.rz, w[0]);
+        sum.rw = _mm256_mul_ps(first.rw, w[0]);
+        sum.dx = _mm256_mul_ps(first.dx, w[0]);
+        sum.dy = _mm256_mul_ps(first.dy, w[0]);
+        sum.dz = _mm256_mul_ps(first.dz, w[0]);
+        sum.dw = _mm256_mul_ps(first.dw, w[0]);
+        AddBoneLanesAVX(palette, influences, 1, w[1], first, sum);
+        AddBoneLanesAVX(palette, influences, 2, w[2], first, sum);
+        AddBoneLanesAVX(palette, influences, 3, w[3], first, sum);
+
+        __m256 lengthSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sum.rx, sum.rx), _mm256_mul_ps(sum.ry, sum.ry)),
+                                             _mm256_add_ps(_mm256_mul_ps(sum.rz, sum.rz), _mm256_mul_ps(sum.rw, sum.rw)));
+        __m256 inverseLength = _mm256_rsqrt_ps(lengthSquared);
+        inverseLength = _mm256_mul_ps(inverseLength, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                      _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), lengthSquared), _mm256_mul_ps(inverseLength, inverseLength))));
+        __m256 qx = _mm256_mul_ps(sum.rx, inverseLength);
+        __m256 qy = _mm256_mul_ps(sum.ry, inverseLength);
+        __m256 qz = _mm256_mul_ps(sum.rz, inverseLength);
+        __m256 qw = _mm256_mul_ps(sum.rw, inverseLength);
+        __m256 scale = _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(inverseLength, inverseLength));
+        __m256 tx = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dx), _mm256_mul_ps(sum.dw, sum.rx)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.ry, sum.dz), _mm256_mul_ps(sum.rz, sum.dy))));
+        __m256 ty = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dy), _mm256_mul_ps(sum.dw, sum.ry)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rz, sum.dx), _mm256_mul_ps(sum.rx, sum.dz))));
+        __m256 tz = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dz), _mm256_mul_ps(sum.dw, sum.rz)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rx, sum.dy), _mm256_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m256 v[4] = {
+                LanePair(normals[0].xmm, normals[4].xmm), LanePair(normals[1].xmm, normals[5].xmm),
+                LanePair(normals[2].xmm, normals[6].xmm), LanePair(normals[3].xmm, normals[7].xmm)
+            };
+            TransposeLanes4x4(v);
+            RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+            v[3] = _mm256_setzero_ps();
+            TransposeLanes4x4(v);
+            outNormals[0].xmm = _mm256_castps256_ps128(v[0]);
+            outNormals[1].xmm = _mm256_castps256_ps128(v[1]);
+            outNormals[2].xmm = _mm256_castps256_ps128(v[2]);
+            outNormals[3].xmm = _mm256_castps256_ps128(v[3]);
+            outNormals[4].xmm = _mm256_extractf128_ps(v[0], 1);
+            outNormals[5].xmm = _mm256_extractf128_ps(v[1], 1);
+            outNormals[6].xmm = _mm256_extractf128_ps(v[2], 1);
+            outNormals[7].xmm = _mm256_extractf128_ps(v[3], 1);
+        }
+        __m256 v[4] = {
+            LanePair(positions[0].xmm, positions[4].xmm), LanePair(positions[1].xmm, positions[5].xmm),
+            LanePair(positions[2].xmm, positions[6].xmm), LanePair(positions[3].xmm, positions[7].xmm)
+        };
+        TransposeLanes4x4(v);
+        RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+        v[0] = _mm256_add_ps(v[0], tx);
+        v[1] = _mm256_add_ps(v[1], ty);
+        v[2] = _mm256_add_ps(v[2], tz);
+        v[3] = _mm256_setzero_ps();
+        TransposeLanes4x4(v);
+        outPositions[0].xmm = _mm256_castps256_ps128(v[0]);
+        outPositions[1].xmm = _mm256_castps256_ps128(v[1]);
+        outPositions[2].xmm = _mm256_castps256_ps128(v[2]);
+        outPositions[3].xmm = _mm256_castps256_ps128(v[3]);
+        outPositions[4].xmm = _mm256_extractf128_ps(v[0], 1);
+        outPositions[5].xmm = _mm256_extractf128_ps(v[1], 1);
+        outPositions[6].xmm = _mm256_extractf128_ps(v[2], 1);
+        outPositions[7].xmm = _mm256_extractf128_ps(v[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesDualQuaternionAVX(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            SkinDualQuaternionEight(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        _mm256_zeroupper();
+        if (i < n) {
+            SkinVerticesDualQuaternion(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr, n - i);
+        }
+    }
+}
+#endif
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// FrameArena.cpp
+
+namespace xo_internal
+{
+    // Blocks start on a cache line, and so does the memory after each block's header.
+    _XOCONSTEXPR const size_t ArenaBlockAlign = 64;
+    _XOCONSTEXPR const size_t ArenaHeaderSize = 64;
+    _XOCONSTEXPR const size_t ArenaHugePageSize = 2 * 1024 * 1024;
+
+    // Returns at least size bytes for an arena block, and sets size to how many. When hugePages is true the block
+    // is asked to be backed by huge pages, and hugePages is set to whether that was done. pageAligned is set to
+    // whether the block must be freed with free rather than AlignedFree.
+    _XOSRCINL void* AllocateArenaBlock(size_t& size, bool& hugePages, bool& pageAligned) {
+        pageAligned = false;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages) {
+            // transparent huge pages only back whole, aligned huge pages, so the block is made of them. The
+            // kernel may still use ordinary pages, such as when huge pages are disabled or memory is fragmented.
+            size_t rounded = (size + ArenaHugePageSize - 1) & ~(ArenaHugePageSize - 1);
+            void* p = nullptr;
+            if (posix_memalign(&p, ArenaHugePageSize, rounded) == 0) {
+                hugePages = madvise(p, rounded, MADV_HUGEPAGE) == 0;
+                pageAligned = true;
+                size = rounded;
+                return p;
+            }
+        }
+#endif
+        hugePages = false;
+        return AlignedMalloc(size, ArenaBlockAlign);
+    }
+
+    _XOSRCINL void FreeArenaBlock(void* p, bool pageAligned) {
+        if (pageAligned) {
+            free(p);
+        }
+        else {
+            AlignedFree(p, ArenaBlockAlign);
+        }
+    }
+}
+
+_XOSRCINL FrameArena::FrameArena() :
+    FrameArena(DefaultBlockSize)
+{
+}
+
+_XOSRCINL FrameArena::FrameArena(size_t blockSize, bool hugePages) :
+    current(nullptr),
+    cursor(nullptr),
+    end(nullptr),
+    blockSize(blockSize),
+    used(0),
+    peak(0),
+    capacity(0),
+    blockCount(0),
+    allocationCount(0),
+    wantHugePages(hugePages),
+    hugePages(false)
+{
+}
+
+_XOSRCINL FrameArena::~FrameArena() {
+    FreeBlocks();
+}
+
+_XOSRCINL void* FrameArena::AllocateFromNewBlock(size_t size, size_t align) {
+    // the memory after a header is aligned to ArenaBlockAlign, so only larger alignments need room to pad.
+    size_t padding = align > xo_internal::ArenaBlockAlign ? align : 0;
+    if (size > ~(size_t)0 / 2 || !NewBlock(size + padding)) {
+        return nullptr;
+    }
+    return Allocate(size, align);
+}
+
+_XOSRCINL FrameArena::Block* FrameArena::NewBlock(size_t size) {
+    static_assert(sizeof(Block) <= xo_internal::ArenaHeaderSize, "FrameArena::Block doesn't fit its header.");
+    size_t bytes = xo_internal::ArenaHeaderSize + (size > blockSize ? size : blockSize);
+    bool huge = wantHugePages, pageAligned;
+    void* memory = xo_internal::AllocateArenaBlock(bytes, huge, pageAligned);
+    if (!memory) {
+        return nullptr;
+    }
+    Block* block = (Block*)memory;
+    block->previous = current;
+    block->size = bytes;
+    block->pageAligned = pageAligned;
+    current = block;
+    cursor = (char*)memory + xo_internal::ArenaHeaderSize;
+    end = (char*)memory + bytes;
+    capacity += bytes - xo_internal::ArenaHeaderSize;
+    ++blockCount;
+    hugePages = huge;
+    return block;
+}
+
+_XOSRCINL void FrameArena::FreeBlocks() {
+    while (current) {
+        Block* previous = current->previous;
+        xo_internal::FreeArenaBlock(current, current->pageAligned);
+        current = previous;
+    }
+    cursor = end = nullptr;
+    capacity = 0;
+    blockCount = 0;
+    hugePages = false;
+}
+
+_XOSRCINL void FrameArena::Reset() {
+    if (blockCount > 1) {
+        // one block big enough for the whole frame, so the next frame like it doesn't chain.
+        size_t total = capacity;
+        FreeBlocks();
+        NewBlock(total);
+    }
+    else if (current) {
+        cursor = (char*)current + xo_internal::ArenaHeaderSize;
+    }
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL void FrameArena::Release() {
+    FreeBlocks();
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats;
+    stats.used = used;
+    stats.peak = peak;
+    stats.capacity = capacity;
+    stats.blockCount = blockCount;
+    stats.allocationCount = allocationCount;
+    stats.hugePages = hugePages;
+    return stats;
+}
+
+_XOSRCINL FrameArena& FrameArena::ThreadArena() {
+#if defined(_XO_NO_TLS)
+    // thread local objects need a trivial constructor here, so this arena is never destroyed, and its blocks
+    // aren't freed when the thread exits. See the ThreadArena documentation.
+    static _XOTLS FrameArena* tlsArena;
+    static _XOTLS void* mem[(sizeof(FrameArena) + sizeof(void*) - 1) / sizeof(void*)];
+    if (!tlsArena) {
+        tlsArena = new(mem) FrameArena();
+    }
+    return *tlsArena;
+#else
+    static _XOTLS FrameArena tlsArena;
+    return tlsArena;
+#endif
+}
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Half.cpp
+
+namespace xo_internal
+{
+    union FloatBits {
+        float f;
+        uint32_t u;
+    };
+}
+
+_XOSRCINL uint16_t FloatToHalf(float f) {
+    xo_internal::FloatBits bits;
+    bits.f = f;
+    const uint32_t sign = bits.u & 0x80000000u;
+    bits.u ^= sign;
+    uint16_t o;
+    if (bits.u >= 0x47800000u) {
+        // 65520 and up rounds to infinity. NaN stays NaN, as a quiet NaN.
+        o = bits.u > 0x7f800000u ? 0x7e00 : 0x7c00;
+    }
+    else if (bits.u < 0x38800000u) {
+        // Below the smallest normal half, so a denormal or zero. Adding 0.5 moves the half's mantissa to the bottom
+        // bits of the float's, and the float add does the rounding.
+        bits.f += 0.5f;
+        o = (uint16_t)(bits.u - 0x3f000000u);
+    }
+    else {
+        // Rebias the exponent from 127 to 15, then round off the low 13 bits of the mantissa with ties to even. A
+        // carry out of the mantissa correctly bumps the exponent, up to infinity.
+        const uint32_t mantissaOdd = (bits.u >> 13) & 1u;
+        bits.u += 0xc8000fffu + mantissaOdd;
+        o = (uint16_t)(bits.u >> 13);
+    }
+    return (uint16_t)(o | (sign >> 16));
+}
+
+_XOSRCINL float HalfToFloat(uint16_t h) {
+    xo_internal::FloatBits o;
+    o.u = (uint32_t)(h & 0x7fff) << 13;
+    const uint32_t exponent = o.u & 0x0f800000u;
+    o.u += 0x38000000u;
+    if (exponent == 0x0f800000u) {
+        // Infinity or NaN, which take the largest exponent.
+        o.u += 0x38000000u;
+    }
+    else if (exponent == 0) {
+        // A denormal. Given the smallest normal exponent it's 2^-14 too big, which a float subtract takes off. Both
+        // operands and the result are normal floats, so the SSE denormal modes don't change it.
+        o.u += 0x00800000u;
+        o.f -= HexFloat(0x38800000u);
+    }
+    o.u |= (uint32_t)(h & 0x8000) << 16;
+    return o.f;
+}
+
+_XOSRCINL Half2::Half2(const Vector2& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y))
+{
+}
+
+_XOSRCINL Half2::operator Vector2() const {
+    return Vector2(HalfToFloat(x), HalfToFloat(y));
+}
+
+_XOSRCINL Half3::Half3(const Vector3& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z))
+{
+}
+
+_XOSRCINL Half3::operator Vector3() const {
+    return Vector3(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z));
+}
+
+_XOSRCINL Half4::Half4(const Vector4& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z)),
+    w(FloatToHalf(v.w))
+{
+}
+
+_XOSRCINL Half4::operator Vector4() const {
+    return Vector4(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z), HalfToFloat(w));
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE2)
+    // FloatToHalf of four floats. Each lane holds its half sign extended to 32 bits, so _mm_packs_epi32 narrows
+    // two of these to eight halves without saturating.
+    _XOINL __m128i FloatToHalfSSE2(__m128 f) {
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+        __m128 sign = _mm_and_ps(f, signMask);
+        __m128 absolute = _mm_xor_ps(f, sign);
+        __m128i bits = _mm_castps_si128(absolute);
+        // Without the sign, the bits compare as signed ints in the same order as the floats.
+        __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+        __m128i isDenormal = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+        __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+        __m128i infOrNaN = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+        __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+        // -1 where bit 13 is set, which is subtracted to add it.
+        __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+        __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32((int)0xc8000fffu)), mantissaOdd), 13);
+        __m128i finite = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+        __m128i o = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN));
+        return _mm_or_si128(o, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+
+    // HalfToFloat of four halves, one zero extended in each 32 bit lane.
+    _XOINL __m128 HalfToFloatSSE2(__m128i h) {
+        __m128i magnitude = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, magnitude), 16);
+        __m128i o = _mm_slli_epi32(magnitude, 13);
+        __m128i exponent = _mm_and_si128(o, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_set1_epi32(0x38000000));
+        __m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_and_si128(isInfOrNaN, _mm_set1_epi32(0x38000000)));
+        __m128i isDenormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+        __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(0x00800000))), _mm_set1_ps(HexFloat(0x38800000u))));
+        o = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, o));
+        return _mm_castsi128_ps(_mm_or_si128(o, sign));
+    }
+#endif
+
+    // The baseline kernels behind ToHalf and FromHalf. Element i's components are in[i * inStride] onward, so
+    // a stride of 4 with 2 or 3 components is a padded Vector2 or Vector3. When the stride is the component count
+    // the arrays are one run of floats. Anything that isn't a whole vector's worth goes through FloatToHalf or
+    // HalfToFloat, which give the same bits as the vector code.
+    _XOSRCINL void FloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i a = FloatToHalfSSE2(_mm_loadu_ps(in + i));
+                __m128i b = FloatToHalfSSE2(_mm_loadu_ps(in + i + 4));
+                _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // Each element's four halves are stored 8 bytes at a time, and the fourth is overwritten by the next
+            // element. The last two elements are left to the loop below so nothing is written past the end.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_packs_epi32(FloatToHalfSSE2(_mm_loadu_ps(in + i * 4)), FloatToHalfSSE2(_mm_loadu_ps(in + i * 4 + 4)));
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm_packs_epi32(FloatToHalfSSE2(ab), FloatToHalfSSE2(cd)));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalf(in[i * inStride + k]);
+            }
+        }
+    }
+
+    // The w of a padded Vector3 is written as zero.
+    _XOSRCINL void HalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i));
+                _mm_storeu_ps(out + i, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+                _mm_storeu_ps(out + i + 4, HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero)));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // Each load takes the next element's first half as well, which is masked off to give a w of zero.
+            // The last element is left to the loop below so nothing is read past the end.
+            const __m128i xyzMask = _mm_set_epi32(0, 0, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 1 < n; ++i) {
+                __m128i h = _mm_and_si128(_mm_loadl_epi64((const __m128i*)(in + i * 3)), xyzMask);
+                _mm_storeu_ps(out + i * 4, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i * 2));
+                __m128 ab = HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero));
+                __m128 cd = HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero));
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloat(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX2)
+namespace xo_internal
+{
+    // F16C's own conversions of one value, for the elements that don't fill a register. They round the same way
+    // as the wide ones, which is the same as FloatToHalf.
+    _XOINL _XO_TARGET_AVX2 uint16_t FloatToHalfF16C(float f) {
+        return (uint16_t)_mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(f), _MM_FROUND_TO_NEAREST_INT), 0);
+    }
+
+    _XOINL _XO_TARGET_AVX2 float HalfToFloatF16C(uint16_t h) {
+        return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(h)));
+    }
+
+    // FloatToHalfArray with F16C, eight floats per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void FloatToHalfArrayF16C(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+                _mm_storeu_si128((__m128i*)(out + i + 8), _mm256_cvtps_ph(_mm256_loadu_ps(in + i + 8), _MM_FROUND_TO_NEAREST_INT));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // As FloatToHalfArray, with both elements in one conversion.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i * 4), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                __m256 f = _mm256_insertf128_ps(_mm256_castps128_ps256(ab), cd, 1);
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalfF16C(in[i * inStride + k]);
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    // HalfToFloatArray with F16C, eight halves per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void HalfToFloatArrayF16C(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+                _mm256_storeu_ps(out + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i + 8))));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // As HalfToFloatArray, two elements per conversion. The second load reads into a third element, which
+            // must exist.
+            const __m128i xyzMask = _mm_set_epi32(0x0000ffff, (int)0xffffffffu, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(in + i * 3)), _mm_loadl_epi64((const __m128i*)(in + i * 3 + 3)));
+                _mm256_storeu_ps(out + i * 4, _mm256_cvtph_ps(_mm_and_si128(h, xyzMask)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m256 f = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i * 2)));
+                __m128 ab = _mm256_castps256_ps128(f);
+                __m128 cd = _mm256_extractf128_ps(f, 1);
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloatF16C(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+namespace xo_internal
+{
+    _XOSRCINL void DispatchFloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().floatToHalfArray(in, inStride, out, components, n);
+#else
+        FloatToHalfArray(in, inStride, out, components, n);
+#endif
+    }
+
+    _XOSRCINL void DispatchHalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().halfToFloatArray(in, components, out, outStride, n);
+#else
+        HalfToFloatArray(in, components, out, outStride, n);
+#endif
+    }
+}
+
+_XOSRCINL void ToHalf(const float* in, uint16_t* out, size_t n)      { xo_internal::DispatchFloatToHalfArray(in, 1, out, 1, n); }
+_XOSRCINL void ToHalf(const Vector2* in, Half2* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector2) / sizeof(float), (uint16_t*)out, 2, n); }
+_XOSRCINL void ToHalf(const Vector3* in, Half3* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector3) / sizeof(float), (uint16_t*)out, 3, n); }
+_XOSRCINL void ToHalf(const Vector4* in, Half4* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector4) / sizeof(float), (uint16_t*)out, 4, n); }
+_XOSRCINL void FromHalf(const uint16_t* in, float* out, size_t n)    { xo_internal::DispatchHalfToFloatArray(in, 1, out, 1, n); }
+_XOSRCINL void FromHalf(const Half2* in, Vector2* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 2, (float*)out, sizeof(Vector2) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half3* in, Vector3* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 3, (float*)out, sizeof(Vector3) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half4* in, Vector4* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 4, (float*)out, sizeof(Vector4) / sizeof(float), n); }
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Hierarchy.cpp
+
+namespace xo_internal
+{
+    // Holds each of count threads in Wait until all of them have called it. Levels are short enough that
+    // spinning is cheaper than sleeping on a condition variable.
+    class SpinBarrier {
+    public:
+        explicit SpinBarrier(unsigned count) : count(count), waiting(0), generation(0) {
+        }
+
+        void Wait() {
+            unsigned gen = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                waiting.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            else {
+                while (generation.load(std::memory_order_acquire) == gen) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        const unsigned count;
+        std::atomic<unsigned> waiting;
+        std::atomic<unsigned> generation;
+    };
+
+    // Fewer nodes than this in a level aren't split between threads.
+    _XOSRCINL size_t HierarchyMinNodesPerThread() {
+        return 256;
+    }
+}
+
+_XOSRCINL Hierarchy::Hierarchy() :
+    firstChangedLevel(NothingChanged),
+    sorted(true)
+{
+}
+
+_XOSRCINL void Hierarchy::Reserve(size_t nodeCount) {
+    parents.reserve(nodeCount);
+    depths.reserve(nodeCount);
+    slots.reserve(nodeCount);
+    parentSlots.reserve(nodeCount);
+    locals.reserve(nodeCount);
+    worlds.reserve(nodeCount);
+    changed.reserve(nodeCount);
+}
+
+_XOSRCINL void Hierarchy::Clear() {
+    parents.clear();
+    depths.clear();
+    slots.clear();
+    parentSlots.clear();
+    locals.clear();
+    worlds.clear();
+    changed.clear();
+    levels.clear();
+    firstChangedLevel = NothingChanged;
+    sorted = true;
+}
+
+_XOSRCINL int Hierarchy::AddNode(int parent, const Matrix4x4& local) {
+    XO_ASSERT(parent == NoParent || (parent >= 0 && (size_t)parent < parents.size()), "The parent must be added before its children.");
+    int node = (int)parents.size();
+    int depth = parent == NoParent ? 0 : depths[parent] + 1;
+    parents.push_back(parent);
+    depths.push_back(depth);
+    // Stored at the end until the next update sorts it into its level.
+    slots.push_back((int)locals.size());
+    parentSlots.push_back(NoParent);
+    locals.push_back(local);
+    worlds.push_back(local);
+    changed.push_back(1);
+    if ((size_t)depth < firstChangedLevel) {
+        firstChangedLevel = (size_t)depth;
+    }
+    sorted = false;
+    return node;
+}
+
+_XOSRCINL void Hierarchy::Sort() {
+    const size_t n = parents.size();
+
+    // The children of each node, in the order they were added.
+    std::vector<int> childStart(n + 1, 0);
+    std::vector<int> children(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] != NoParent) {
+            ++childStart[parents[i] + 1];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    {
+        std::vector<int> cursor(childStart.begin(), childStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (parents[i] != NoParent) {
+                children[cursor[parents[i]]++] = (int)i;
+            }
+        }
+    }
+
+    // Breadth first from the roots, which puts each level after the one above it, with siblings together and
+    // in the order of their parents.
+    std::vector<int> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] == NoParent) {
+            order.push_back((int)i);
+        }
+    }
+    levels.clear();
+    levels.push_back(0);
+    size_t levelEnd = order.size();
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == levelEnd) {
+            levels.push_back(i);
+            levelEnd = order.size();
+        }
+        int node = order[i];
+        for (int c = childStart[node]; c < childStart[node + 1]; ++c) {
+            order.push_back(children[c]);
+        }
+    }
+    if (n) {
+        levels.push_back(n);
+    }
+
+    std::vector<int> newParentSlots(n);
+    vector<Matrix4x4> newLocals(n);
+    vector<Matrix4x4> newWorlds(n);
+    std::vector<unsigned char> newChanged(n);
+    firstChangedLevel = NothingChanged;
+    for (size_t slot = 0; slot < n; ++slot) {
+        int node = order[slot];
+        int oldSlot = slots[node];
+        newLocals[slot] = locals[oldSlot];
+        newWorlds[slot] = worlds[oldSlot];
+        newChanged[slot] = changed[oldSlot];
+        // The parent comes earlier in the order, so its slot is already set.
+        newParentSlots[slot] = parents[node] == NoParent ? NoParent : slots[parents[node]];
+        slots[node] = (int)slot;
+        if (newChanged[slot] && (size_t)depths[node] < firstChangedLevel) {
+            firstChangedLevel = (size_t)depths[node];
+        }
+    }
+    parentSlots.swap(newParentSlots);
+    locals.swap(newLocals);
+    worlds.swap(newWorlds);
+    changed.swap(newChanged);
+    sorted = true;
+}
+
+_XOSRCINL void Hierarchy::BeginUpdate() {
+    if (!sorted) {
+        Sort();
+    }
+}
+
+_XOSRCINL void Hierarchy::GetLevelRange(size_t level, size_t& begin, size_t& end) const {
+    end = levels[level + 1];
+    begin = level < firstChangedLevel ? end : levels[level];
+}
+
+_XOSRCINL void Hierarchy::UpdateRange(size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (parentSlots[begin] == NoParent) {
+        // The first level, which is only roots.
+        for (size_t i = begin; i < end; ++i) {
+            if (changed[i]) {
+                worlds[i] = locals[i];
+            }
+        }
+        return;
+    }
+    // A node has changed when it or its parent has, and its parent's flag was settled by the level above.
+    // Each run of changed nodes is one batch.
+    size_t i = begin;
+    while (i < end) {
+        while (i < end && !(changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        size_t run = i;
+        while (i < end && (changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        if (i > run) {
+            Matrix4x4::MultiplyBatch(worlds.data(), parentSlots.data() + run, locals.data() + run, worlds.data() + run, i - run);
+        }
+    }
+}
+
+_XOSRCINL void Hierarchy::EndUpdate() {
+    if (firstChangedLevel < GetLevelCount()) {
+        std::fill(changed.begin() + levels[firstChangedLevel], changed.end(), (unsigned char)0);
+    }
+    firstChangedLevel = NothingChanged;
+}
+
+_XOSRCINL void Hierarchy::UpdateWorld(unsigned threadCount) {
+    BeginUpdate();
+    const size_t levelCount = GetLevelCount();
+    if (firstChangedLevel >= levelCount) {
+        return;
+    }
+
+    // No more threads than there are cores, or than there's work for.
+    const size_t minNodes = xo_internal::HierarchyMinNodesPerThread();
+    const size_t work = levels[levelCount] - levels[firstChangedLevel];
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (cores && threadCount > cores) {
+        threadCount = cores;
+    }
+    if (threadCount > work / minNodes) {
+        threadCount = (unsigned)(work / minNodes);
+    }
+
+    if (threadCount <= 1) {
+        for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+            size_t begin, end;
+            GetLevelRange(level, begin, end);
+            UpdateRange(begin, end);
+        }
+    }
+    else {
+        xo_internal::SpinBarrier barrier(threadCount);
+        auto run = [this, &barrier, threadCount, levelCount, minNodes](unsigned thread) {
+            for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+                size_t begin, end;
+                GetLevelRange(level, begin, end);
+                size_t count = end - begin;
+                if (count < minNodes * 2) {
+                    if (thread == 0) {
+                        UpdateRange(begin, end);
+                    }
+                }
+                else {
+                    size_t chunk = (count + threadCount - 1) / threadCount;
+                    size_t first = begin + std::min(count, chunk * thread);
+                    size_t last = begin + std::min(count, chunk * (thread + 1));
+                    UpdateRange(first, last);
+                }
+                barrier.Wait();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run, t);
+        }
+        run(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    EndUpdate();
+}
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Matrix3x4.cpp
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL Matrix3x4::Matrix3x4() {
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float m) {
+    r[0].Set(m);
+    r[1].Set(m);
+    r[2].Set(m);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2) {
+    r[0].Set(a0, b0, c0, d0);
+    r[1].Set(a1, b1, c1, d1);
+    r[2].Set(a2, b2, c2, d2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2) {
+    r[0].Set(r0);
+    r[1].Set(r1);
+    r[2].Set(r2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix4x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q) {
+    // Points are transformed as column vectors, so this is the transpose of the upper left 3x3 of
+    // Matrix4x4(const Quaternion&), which is laid out for row vectors.
+    Vector4 v4(q.x, q.y, q.z, q.w);
+    Vector4 q2 = v4 + v4;
+
+    Vector4 qq2 = v4 * q2;
+    Vector4 wq2 = q2 * q.w;
+
+    float xy2 = q.x * q2.y;
+    float xz2 = q.x * q2.z;
+    float yz2 = q.y * q2.z;
+
+    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 - wq2.z,            xz2 + wq2.y,          0.0f);
+    r[1].Set( xy2 + wq2.z,           1.0f - qq2.x - qq2.z,   yz2 - wq2.x,          0.0f);
+    r[2].Set( xz2 - wq2.y,           yz2 + wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q, const Vector3& translation) :
+    Matrix3x4(q)
+{
+    SetTranslation(translation);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+    // The batch kernels take the full matrix, which costs one 64 byte copy per array.
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL float Matrix3x4::Determinant() const {
+    return Vector3::Dot(Vector3(r[0]), Vector3::Cross(Vector3(r[1]), Vector3(r[2])));
+}
+
+namespace xo_internal
+{
+    // Writes the adjugate of the upper left 3x3 of m, with the translation of the inverse scaled by the same
+    // determinant, to out, and returns the determinant. The adjugate's columns are the cross products of the rows.
+    _XOINL float AffineAdjugate(const Matrix3x4& m, Matrix3x4& out) {
+#if defined(XO_SSE)
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        // the w of each cross product is w*w - w*w, so the translations drop out as zeros.
+        auto cross = [](__m128 a, __m128 b) {
+            return _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+        };
+        __m128 c0 = cross(r1, r2);
+        __m128 c1 = cross(r2, r0);
+        __m128 c2 = cross(r0, r1);
+        // -(adj * t) is the combination of the columns weighted by the translation.
+        __m128 t = sse::LinearCombination(_mm_shuffle_ps(_mm_unpackhi_ps(r0, r1), r2, _MM_SHUFFLE(3, 3, 3, 2)), c0, c1, c2, _mm_setzero_ps());
+        __m128 c3 = _mm_sub_ps(_mm_setzero_ps(), t);
+        float det = Vector4(_mm_mul_ps(r0, c0)).Sum();
+        // the columns become the rows of the inverse, with the translation in w.
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        out.r[0].xmm = c0;
+        out.r[1].xmm = c1;
+        out.r[2].xmm = c2;
+        return det;
+#else
+        Vector3 c0, c1, c2;
+        Vector3::Cross(Vector3(m.r[1]), Vector3(m.r[2]), c0);
+        Vector3::Cross(Vector3(m.r[2]), Vector3(m.r[0]), c1);
+        Vector3::Cross(Vector3(m.r[0]), Vector3(m.r[1]), c2);
+        Vector3 c3 = -(c0 * m.m03 + c1 * m.m13 + c2 * m.m23);
+        // out may be m, so the determinant is taken before any rows are written.
+        float det = Vector3::Dot(Vector3(m.r[0]), c0);
+        out.r[0].Set(c0.x, c1.x, c2.x, c3.x);
+        out.r[1].Set(c0.y, c1.y, c2.y, c3.y);
+        out.r[2].Set(c0.z, c1.z, c2.z, c3.z);
+        return det;
+#endif
+    }
+
+    _XOINL void ScaleAffineAdjugate(Matrix3x4& m, float det) {
+        float s = 1.0f / det;
+        m.r[0] *= s;
+        m.r[1] *= s;
+        m.r[2] *= s;
+    }
+}
+
+_XOSRCINL void Matrix3x4::MakeInverse() {
+    float det = xo_internal::AffineAdjugate(*this, *this);
+    xo_internal::ScaleAffineAdjugate(*this, det);
+}
+
+_XOSRCINL bool Matrix3x4::TryMakeInverse() {
+    Matrix3x4 adj;
+    float det = xo_internal::AffineAdjugate(*this, adj);
+    if (det == 0.0f) {
+        return false;
+    }
+    xo_internal::ScaleAffineAdjugate(adj, det);
+    *this = adj;
+    return true;
+}
+
+_XOSRCINL void Matrix3x4::Scale(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(v.x, 0.0f, 0.0f, 0.0f);
+    outMatrix.r[1].Set(0.0f, v.y, 0.0f, 0.0f);
+    outMatrix.r[2].Set(0.0f, 0.0f, v.z, 0.0f);
+}
+
+_XOSRCINL void Matrix3x4::Translation(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(1.0f, 0.0f, 0.0f, v.x);
+    outMatrix.r[1].Set(0.0f, 1.0f, 0.0f, v.y);
+    outMatrix.r[2].Set(0.0f, 0.0f, 1.0f, v.z);
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Scale(const Vector3& v) {
+    Matrix3x4 m;
+    Scale(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Translation(const Vector3& v) {
+    Matrix3x4 m;
+    Translation(v, m);
+    return m;
+}
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Matrix4x4.cpp
+
+#define _XO_ASSERT_MSG(msg) "xo-math Matrix4x4" msg
+
+_XOSRCDATA const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+
+_XOSRCDATA const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+
+_XOSRCDATA const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL Matrix4x4::Matrix4x4() {
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(float m)
+#if defined(XO_SSE)
+{ 
+    r[0].xmm = r[1].xmm = r[2].xmm = r[3].xmm = _mm_set_ps1(m);
+}
+#else
+{
+	r[0].Set(m);
+	r[1].Set(m);
+	r[2].Set(m);
+	r[3].Set(m);
+}
+#endif
+
+_XOSRCINL Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
+{
+    r[0].Set(a0, b0, c0, d0);
+    r[1].Set(a1, b1, c1, d1);
+    r[2].Set(a2, b2, c2, d2);
+    r[3].Set(a3, b3, c3, d3);
+}
+
+// TODO: couldn't this be faster with just a single copy?
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix4x4& m)
+{
+	r[0].Set(m.r[0]);
+	r[1].Set(m.r[1]);
+	r[2].Set(m.r[2]);
+	r[3].Set(m.r[3]);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
+{
+	r[0].Set(r0);
+	r[1].Set(r1);
+	r[2].Set(r2);
+	r[3].Set(r3);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
+{
+	r[0].Set(r0);
+	r[1].Set(r1);
+	r[2].Set(r2);
+	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix3x4& m)
+{
+	r[0].Set(m.r[0]);
+	r[1].Set(m.r[1]);
+	r[2].Set(m.r[2]);
+	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const class Quaternion& q) {
+    // A copy rather than a cast pointer, which the compiler may assume can't alias q.
+    Vector4 v4(q);
+    Vector4 q2 = v4 + v4;
+
+    Vector4 qq2 = v4 * q2;
+    Vector4 wq2 = q2 * q.w;
+
+    float xy2 = q.x * q2.y;
+    float xz2 = q.x * q2.z;
+    float yz2 = q.y * q2.z;
+
+    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 + wq2.z,            xz2 - wq2.y,          0.0f);
+    r[1].Set( xy2 - wq2.z,           1.0f - qq2.x - qq2.z,   yz2 + wq2.x,          0.0f);
+    r[2].Set( xz2 + wq2.y,           yz2 - wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
+    r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL const Vector4& Matrix4x4::GetRow(int i) const {
+    return r[i];
+}
+
+_XOSRCINL Vector4 Matrix4x4::GetColumn(int i) const {
+    return Vector4(r[0][i], r[1][i], r[2][i], r[3][i]);
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    _XOINL void EarlyInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
+                             __m128& row0, __m128& row1, __m128& row2, __m128& row3,
+                             __m128& det, __m128& tmp1, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // http://stackoverflow.com/questions/18743531/sse-half-loads-mm-loadh-pi-mm-loadl-pi-issue-warnings
+#   define _fake_initialization() _mm_setzero_ps()
+
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m)), (__m64*)(m + 4));
+        row1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 8)), (__m64*)(m + 12));
+        row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (__m64*)(m + 2)), (__m64*)(m + 6));
+        row3 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 10)), (__m64*)(m + 14));
+        row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row2, row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor0 = _mm_mul_ps(row1, tmp1);
+        minor1 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+        minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+        minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row1, row2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+        minor3 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+        minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+        minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+        minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+        minor2 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+        minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+        minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+        minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+        minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+        minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+        minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+        // -----------------------------------------------
+        det = _mm_mul_ps(row0, minor0);
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+#   undef _fake_initialization
+    }
+
+    _XOINL void LateInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
+                            __m128& det, __m128& tmp1, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        tmp1 = _mm_rcp_ss(det);
+        det = _mm_sub_ss(_mm_add_ss(tmp1, tmp1), _mm_mul_ss(det, _mm_mul_ss(tmp1, tmp1)));
+        det = _mm_shuffle_ps(det, det, 0x00);
+        minor0 = _mm_mul_ps(det, minor0);
+        _mm_storel_pi((__m64*)(m), minor0);
+        _mm_storeh_pi((__m64*)(m + 2), minor0);
+        minor1 = _mm_mul_ps(det, minor1);
+        _mm_storel_pi((__m64*)(m + 4), minor1);
+        _mm_storeh_pi((__m64*)(m + 6), minor1);
+        minor2 = _mm_mul_ps(det, minor2);
+        _mm_storel_pi((__m64*)(m + 8), minor2);
+        _mm_storeh_pi((__m64*)(m + 10), minor2);
+        minor3 = _mm_mul_ps(det, minor3);
+        _mm_storel_pi((__m64*)(m + 12), minor3);
+        _mm_storeh_pi((__m64*)(m + 14), minor3);
+    }
+
+#   if defined(XO_AVX)
+    _XOINL __m256 RowPair(__m128 lo, __m128 hi) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    // The cofactor expansion of EarlyInverse, regrouped for AVX.
+    // EarlyInverse forms six products of row pairs, and builds each minor from two terms per product. Expanding 
+    // those terms, every pair of terms reduces to a row times d = swap(t) - t, where t is the product with 
+    // neighbouring elements swapped and swap exchanges the two halves of the register. With dN from the Nth 
+    // product, and rNs being rN with its halves swapped:
+    //      minor0 =  r1*d1  - r3*d2  - r2s*d3
+    //      minor1 = -r0s*d1 + r2s*d5 - r3*d6
+    //      minor2 =  r0s*d3 + r3*d4  - r1*d5
+    //      minor3 =  r0s*d2 - r2s*d4 + r1*d6
+    // Two products or minors share each 256 bit register, for 9 multiplies where EarlyInverse has 30 of half the width.
+    // Rows 0 and 1 of the inverse (before the division by the determinant) are written to minors01, and rows 2 
+    // and 3 to minors23. Returns the determinant in every element.
+    _XOINL __m128 InverseMinorsAVX(const float m[16], __m256& minors01, __m256& minors23) {
+        // Loads the transpose as EarlyInverse does, which leaves row1 and row3 with their halves swapped.
+        __m128 tmp1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m)), (const __m64*)(m + 4));
+        __m128 row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 8)), (const __m64*)(m + 12));
+        __m128 row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(m + 2)), (const __m64*)(m + 6));
+        __m128 row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 10)), (const __m64*)(m + 14));
+        __m128 row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+        __m128 row0s = _mm_shuffle_ps(row0, row0, 0x4E);
+        __m128 row1s = _mm_shuffle_ps(row1, row1, 0x4E);
+        __m128 row2s = _mm_shuffle_ps(row2, row2, 0x4E);
+
+        // products 1 and 4, 2 and 5, 3 and 6.
+        __m256 d14 = _mm256_mul_ps(RowPair(row2, row0), RowPair(row3, row1));
+        __m256 d25 = _mm256_mul_ps(RowPair(row1, row0), RowPair(row2, row3));
+        __m256 d36 = _mm256_mul_ps(RowPair(row1s, row0), RowPair(row3, row2s));
+        d14 = _mm256_shuffle_ps(d14, d14, 0xB1);
+        d25 = _mm256_shuffle_ps(d25, d25, 0xB1);
+        d36 = _mm256_shuffle_ps(d36, d36, 0xB1);
+        d14 = _mm256_sub_ps(_mm256_shuffle_ps(d14, d14, 0x4E), d14);
+        d25 = _mm256_sub_ps(_mm256_shuffle_ps(d25, d25, 0x4E), d25);
+        d36 = _mm256_sub_ps(_mm256_shuffle_ps(d36, d36, 0x4E), d36);
+
+        const __m256 negateHigh = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+        __m256 r1r0s = RowPair(row1, row0s);
+        __m256 r3r2s = RowPair(row3, row2s);
+        __m256 d11 = _mm256_permute2f128_ps(d14, d14, 0x00);
+        __m256 d44 = _mm256_permute2f128_ps(d14, d14, 0x11);
+        __m256 d52 = _mm256_permute2f128_ps(d25, d25, 0x01);
+        minors01 = _mm256_sub_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r1r0s, d11), _mm256_mul_ps(r3r2s, d25))),
+            _mm256_mul_ps(RowPair(row2s, row3), d36));
+        minors23 = _mm256_add_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r3r2s, d44), _mm256_mul_ps(r1r0s, d52))),
+            _mm256_mul_ps(RowPair(row0s, row1), d36));
+
+        __m128 det = _mm_mul_ps(row0, _mm256_castps256_ps128(minors01));
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        return _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+    }
+
+    // See LateInverse.
+    _XOINL void ScaleInverseAVX(__m128 det, __m256 minors01, __m256 minors23, float m[16]) {
+        __m128 r = _mm_rcp_ps(det);
+        r = _mm_sub_ps(_mm_add_ps(r, r), _mm_mul_ps(det, _mm_mul_ps(r, r)));
+        __m256 scale = RowPair(r, r);
+        _mm256_storeu_ps(m, _mm256_mul_ps(minors01, scale));
+        _mm256_storeu_ps(m + 8, _mm256_mul_ps(minors23, scale));
+    }
+#   endif
+#else
+    _XOINL void EarlyInverse(float tmp[12], float src[16], float& det, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // transpose matrix
+        for (int i = 0; i < 4; i++)
+        {
+            src[i] = m[i * 4];
+            src[i + 4] = m[i * 4 + 1];
+            src[i + 8] = m[i * 4 + 2];
+            src[i + 12] = m[i * 4 + 3];
+        }
+        // calculate pairs for first 8 elements (cofactors)
+        tmp[0] = src[10] * src[15];
+        tmp[1] = src[11] * src[14];
+        tmp[2] = src[9] * src[15];
+        tmp[3] = src[11] * src[13];
+        tmp[4] = src[9] * src[14];
+        tmp[5] = src[10] * src[13];
+        tmp[6] = src[8] * src[15];
+        tmp[7] = src[11] * src[12];
+        tmp[8] = src[8] * src[14];
+        tmp[9] = src[10] * src[12];
+        tmp[10] = src[8] * src[13];
+        tmp[11] = src[9] * src[12];
+        // calculate first 8 elements (cofactors)
+        m[0] = tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7];
+        m[0] -= tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7];
+        m[1] = tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7];
+        m[1] -= tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7];
+        m[2] = tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7];
+        m[2] -= tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7];
+        m[3] = tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6];
+        m[3] -= tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6];
+        m[4] = tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3];
+        m[4] -= tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3];
+        m[5] = tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3];
+        m[5] -= tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3];
+        m[6] = tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3];
+        m[6] -= tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3];
+        m[7] = tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2];
+        m[7] -= tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2];
+        // calculate pairs for second 8 elements (cofactors)
+        tmp[0] = src[2] * src[7];
+        tmp[1] = src[3] * src[6];
+        tmp[2] = src[1] * src[7];
+        tmp[3] = src[3] * src[5];
+        tmp[4] = src[1] * src[6];
+        tmp[5] = src[2] * src[5];
+        tmp[6] = src[0] * src[7];
+        tmp[7] = src[3] * src[4];
+        tmp[8] = src[0] * src[6];
+        tmp[9] = src[2] * src[4];
+        tmp[10] = src[0] * src[5];
+        tmp[11] = src[1] * src[4];
+        // calculate second 8 elements (cofactors)
+        m[8] = tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15];
+        m[8] -= tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15];
+        m[9] = tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15];
+        m[9] -= tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15];
+        m[10] = tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15];
+        m[10] -= tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15];
+        m[11] = tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14];
+        m[11] -= tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14];
+        m[12] = tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9];
+        m[12] -= tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10];
+        m[13] = tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10];
+        m[13] -= tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8];
+        m[14] = tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8];
+        m[14] -= tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9];
+        m[15] = tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9];
+        m[15] -= tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8];
+        // calculate determinant
+        det = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + src[3] * m[3];
+    }
+
+    _XOINL void LateInverse(float &det, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // calculate matrix inverse 
+        det = 1 / det;
+        for (int j = 0; j < 16; j++)
+            m[j] *= det;
+    }
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MakeInverse() {
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+#elif defined(XO_SSE)
+    __m128 minor0, minor1, minor2, minor3;
+    __m128 row0, row1, row2, row3;
+    __m128 det, tmp1;
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+#else
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    xo_internal::EarlyInverse(tmp, src, det, m);
+    xo_internal::LateInverse(det, m);
+#endif
+}
+
+_XOSRCINL bool Matrix4x4::TryMakeInverse()
+{
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    if (_mm_cvtss_f32(det) == 0.0f)
+        return false;
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+    return true;
+#elif defined(XO_SSE)
+    __m128 minor0, minor1, minor2, minor3;
+    __m128 row0, row1, row2, row3;
+    __m128 det, tmp1;
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    if (_mm_cvtss_f32(det) == 0.0f)
+        return false;
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    return true;
+#else
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    // EarlyInverse writes the cofactors over its matrix, so a singular matrix is only left as is by working on a copy.
+    Matrix4x4 o(*this);
+    xo_internal::EarlyInverse(tmp, src, det, o.m);
+    if (det == 0.0f)
+        return false;
+    xo_internal::LateInverse(det, o.m);
+    *this = o;
+    return true;
+#endif
+}
+
+namespace xo_internal
+{
+    // Relative tolerances for Matrix4x4::ClassifyInverse. Two columns are orthogonal when the square of their dot
+    // is within InverseOrthogonalTolerance of the product of their squared lengths, which is a cosine of about 1e-5.
+    // A column is unit length when its squared length is within InverseUnitTolerance of 1.
+    _XOCONSTEXPR const float InverseOrthogonalTolerance = 1e-10f;
+    _XOCONSTEXPR const float InverseUnitTolerance = 2e-5f;
+
+    // Gets the squared lengths of the first three columns of m in lengths, and the dots c0.c1, c1.c2 and c2.c0 in
+    // dots. The w of both is zero. The columns are down the rows, so the rows are multiplied lane by lane: each
+    // row by itself for the lengths, and by itself rotated one lane for the dots.
+#if defined(XO_SSE)
+    _XOINL void ColumnGram(const Matrix4x4& m, __m128& lengths, __m128& dots) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0 = _mm_and_ps(m.r[0].xmm, xyzMask), r1 = _mm_and_ps(m.r[1].xmm, xyzMask), r2 = _mm_and_ps(m.r[2].xmm, xyzMask);
+        __m128 s0 = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s1 = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s2 = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1));
+        lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2));
+        dots = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, s0), _mm_mul_ps(r1, s1)), _mm_mul_ps(r2, s2));
+    }
+#else
+    _XOINL void ColumnGram(const Matrix4x4& m, Vector4& lengths, Vector4& dots) {
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        lengths.Set(c0.MagnitudeSquared(), c1.MagnitudeSquared(), c2.MagnitudeSquared(), 0.0f);
+        dots.Set(Vector3::Dot(c0, c1), Vector3::Dot(c1, c2), Vector3::Dot(c2, c0), 0.0f);
+    }
+#endif
+
+    // Inverts an affine matrix whose upper left 3x3 has orthogonal columns. Row i of the inverse 3x3 is column i
+    // divided by its squared length, which is 1 when scaled is false, and the translation is that 3x3 applied to
+    // the negated translation. out may be m.
+    _XOINL void InverseOrthogonal(const Matrix4x4& m, Matrix4x4& out, bool scaled) {
+#if defined(XO_SSE)
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        const __m128 wOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        __m128 tx = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 ty = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 tz = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_and_ps(r0, xyzMask);
+        r1 = _mm_and_ps(r1, xyzMask);
+        r2 = _mm_and_ps(r2, xyzMask);
+        if (scaled) {
+            // the squared lengths of all three columns at once. w is made 1 so its reciprocal stays finite.
+            __m128 lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_add_ps(_mm_mul_ps(r2, r2), wOne));
+            __m128 inv = _mm_div_ps(sse::One, lengths);
+            r0 = _mm_mul_ps(r0, inv);
+            r1 = _mm_mul_ps(r1, inv);
+            r2 = _mm_mul_ps(r2, inv);
+        }
+        // once transposed r0 to r2 are the columns of the inverse 3x3, so the translation is their combination.
+        __m128 t = _mm_sub_ps(wOne, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, tx), _mm_mul_ps(r1, ty)), _mm_mul_ps(r2, tz)));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, t);
+        out.r[0].xmm = r0;
+        out.r[1].xmm = r1;
+        out.r[2].xmm = r2;
+        out.r[3].xmm = t;
+#else
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        Vector3 t(m.m03, m.m13, m.m23);
+        if (scaled) {
+            c0 *= 1.0f / c0.MagnitudeSquared();
+            c1 *= 1.0f / c1.MagnitudeSquared();
+            c2 *= 1.0f / c2.MagnitudeSquared();
+        }
+        out.r[0].Set(c0, -Vector3::Dot(c0, t));
+        out.r[1].Set(c1, -Vector3::Dot(c1, t));
+        out.r[2].Set(c2, -Vector3::Dot(c2, t));
+        out.r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+#endif
+    }
+}
+
+_XOSRCINL bool Matrix4x4::HasOrthonormalBasis() const {
+    // CloseEnough is relative, which nothing passes against 0, so these are absolute differences.
+#if defined(XO_SSE)
+    __m128 l, d;
+    xo_internal::ColumnGram(*this, l, d);
+    Vector4 lengths(l), dots(d);
+#else
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+#endif
+    return Abs(dots.x) <= Vector4::Epsilon && Abs(dots.y) <= Vector4::Epsilon && Abs(dots.z) <= Vector4::Epsilon &&
+           Abs(lengths.x - 1.0f) <= Vector4::Epsilon && Abs(lengths.y - 1.0f) <= Vector4::Epsilon && Abs(lengths.z - 1.0f) <= Vector4::Epsilon;
+}
+
+_XOSRCINL bool Matrix4x4::IsUnitary() const {
+    // Element (i, j) of the transpose times this is the dot of columns i and j.
+    for (int i = 0; i < 4; ++i) {
+        Vector4 ci = GetColumn(i);
+        for (int j = i; j < 4; ++j) {
+            if (Abs(Vector4::Dot(ci, GetColumn(j)) - (i == j ? 1.0f : 0.0f)) > Vector4::Epsilon) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+_XOSRCINL float Matrix4x4::Determinant() const {
+    // Laplace expansion by the 2x2 minors of the top two rows and their complements in the bottom two.
+    float s0 = m00 * m11 - m10 * m01;
+    float s1 = m00 * m12 - m10 * m02;
+    float s2 = m00 * m13 - m10 * m03;
+    float s3 = m01 * m12 - m11 * m02;
+    float s4 = m01 * m13 - m11 * m03;
+    float s5 = m02 * m13 - m12 * m03;
+    float c5 = m22 * m33 - m32 * m23;
+    float c4 = m21 * m33 - m31 * m23;
+    float c3 = m21 * m32 - m31 * m22;
+    float c2 = m20 * m33 - m30 * m23;
+    float c1 = m20 * m32 - m30 * m22;
+    float c0 = m20 * m31 - m30 * m21;
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAffine() const {
+#if defined(XO_SSE)
+    // As Matrix3x4::MakeInverse, the columns of the adjugate are the cross products of the rows. The determinant
+    // goes in the w of the translation column, so once transposed and divided by the determinant, the bottom row
+    // comes out as (0, 0, 0, 1).
+    __m128 r0 = r[0].xmm, r1 = r[1].xmm, r2 = r[2].xmm;
+    auto cross = [](__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+    };
+    __m128 c0 = cross(r1, r2);
+    __m128 c1 = cross(r2, r0);
+    __m128 c2 = cross(r0, r1);
+    // the w of each cross product is zero, so the w of r0 drops out of the determinant.
+    __m128 det = _mm_mul_ps(r0, c0);
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128 t = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3))),
+        _mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)))),
+        _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+    __m128 c3 = _mm_sub_ps(_mm_and_ps(det, _mm_set_ps(HexFloat(0xffffffff), 0.0f, 0.0f, 0.0f)), t);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 inv = _mm_div_ps(sse::One, det);
+    Matrix4x4 o;
+    o.r[0].xmm = _mm_mul_ps(c0, inv);
+    o.r[1].xmm = _mm_mul_ps(c1, inv);
+    o.r[2].xmm = _mm_mul_ps(c2, inv);
+    o.r[3].xmm = _mm_mul_ps(c3, inv);
+    return o;
+#else
+    Matrix3x4 affine(*this);
+    affine.MakeInverse();
+    return Matrix4x4(affine);
+#endif
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseRigid() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, false);
+    return o;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseScaleRotateTranslate() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, true);
+    return o;
+}
+
+_XOSRCINL Matrix4x4::InverseMethod Matrix4x4::ClassifyInverse() const {
+#if defined(XO_SSE)
+    if (_mm_movemask_ps(_mm_cmpeq_ps(r[3].xmm, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f))) != 0xf) {
+        return InverseMethod::General;
+    }
+    __m128 l, dots;
+    xo_internal::ColumnGram(*this, l, dots);
+    // the product of each length with the next lane's matches the pair in the same lane of dots.
+    __m128 limit = _mm_mul_ps(_mm_mul_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1))), _mm_set1_ps(xo_internal::InverseOrthogonalTolerance));
+    // w is zero in both, so it always passes.
+    if (_mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dots, dots), limit)) != 0xf) {
+        return InverseMethod::Affine;
+    }
+    __m128 unitError = _mm_and_ps(sse::AbsMask, _mm_sub_ps(l, sse::One));
+    if ((_mm_movemask_ps(_mm_cmple_ps(unitError, _mm_set1_ps(xo_internal::InverseUnitTolerance))) & 0x7) != 0x7) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
+#else
+    if (m30 != 0.0f || m31 != 0.0f || m32 != 0.0f || m33 != 1.0f) {
+        return InverseMethod::General;
+    }
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+    if (dots.x * dots.x > lengths.x * lengths.y * xo_internal::InverseOrthogonalTolerance ||
+        dots.y * dots.y > lengths.y * lengths.z * xo_internal::InverseOrthogonalTolerance ||
+        dots.z * dots.z > lengths.z * lengths.x * xo_internal::InverseOrthogonalTolerance) {
+        return InverseMethod::Affine;
+    }
+    if (Abs(lengths.x - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.y - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.z - 1.0f) > xo_internal::InverseUnitTolerance) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
+#endif
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAuto(InverseStats* stats) const {
+    InverseMethod method = ClassifyInverse();
+    if (stats) {
+        stats->count[(int)method]++;
+    }
+    // every path writes to the one matrix, so it can be returned without a copy.
+    Matrix4x4 o;
+    if (method == InverseMethod::Rigid || method == InverseMethod::ScaleRotateTranslate) {
+        xo_internal::InverseOrthogonal(*this, o, method == InverseMethod::ScaleRotateTranslate);
+    }
+    else if (method == InverseMethod::Affine) {
+        o = InverseAffine();
+    }
+    else {
+        o = *this;
+        o.MakeInverse();
+    }
+    return o;
+}
+
+_XOSRCINL Matrix4x4& Matrix4x4::Transpose() {
+#if defined(XO_SSE)
+    _MM_TRANSPOSE4_PS(r[0].xmm, r[1].xmm, r[2].xmm, r[3].xmm);
+#else
+    float t;
+#   define _XO_TRANSPOSE_SWAP(i,j) t = r[i][j]; r[i][j] = r[j][i]; r[j][i] = t;
+    // The number of swaps should be:
+    //      (((n*n)-n)/2) = 6
+    //      (((4*4)-4)/2) = 6
+    //      (((all elements)-identity)/(two elements processed per swap)) = 6
+    _XO_TRANSPOSE_SWAP(0, 1);
+    _XO_TRANSPOSE_SWAP(0, 2);
+    _XO_TRANSPOSE_SWAP(0, 3);
+    _XO_TRANSPOSE_SWAP(1, 2);
+    _XO_TRANSPOSE_SWAP(1, 3);
+    _XO_TRANSPOSE_SWAP(2, 3);
+#   undef _XO_TRANSPOSE_SWAP
+#endif
+    return *this;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Transposed() const {
+    Matrix4x4 m(*this);
+    return m.Transpose();
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
+    v = (*this) * Vector4(v);
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
+    v = (*this) * v;
+    return *this;
+}
+
+namespace xo_internal
+{
+    // Computes out[i] = c0*x + c1*y + c2*z + c3 for each vector, where cN is the Nth column of the matrix.
+    // Rather than a horizontal dot product per row, each element of the vector is broadcast and multiplied 
+    // against a whole column. The columns are transposed out of the matrix once, before the loop.
+    // When translate is false c3 is left as zero, so the fourth column isn't applied.
+    _XOSRCINL void TransformVector3Array(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+#if defined(XO_SSE)
+        // transposing with a zero fourth row keeps the w lane of every result at zero.
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), c3));
+        }
+#else
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + tx;
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + ty;
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + tz;
+        }
+#endif
+    }
+
+    // See TransformVector3Array, this is the same with a w element and fourth column.
+    _XOSRCINL void TransformVector4Array(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+#if defined(XO_SSE)
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), _mm_mul_ps(c3, w)));
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z, w = in[i].w;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + (m.m03 * w);
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + (m.m13 * w);
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + (m.m23 * w);
+            out[i].w = (m.m30 * x) + (m.m31 * y) + (m.m32 * z) + (m.m33 * w);
+        }
+#endif
+    }
+
+    _XOSRCINL void MultiplyBatch(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i * aStep] * b[i * bStep];
+        }
+    }
+
+    _XOSRCINL void MultiplyIndexedBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[aIndices[i]] * b[i];
+        }
+    }
+
+#if defined(XO_SSE)
+    // Inverts four matrices at once, with element k of all four in a[k], so the cofactors need no shuffles, only
+    // the transposes in and out. The expansion is by the 2x2 minors of the top and bottom pairs of rows, as
+    // Matrix4x4::Determinant. A matrix with a determinant of zero is left as it was, as TryMakeInverse leaves it,
+    // and reported false in ok when ok isn't null. in may be out.
+    _XOINL void InverseFour(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m128 a[16], b[16];
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = in[0].r[r].xmm, m1 = in[1].r[r].xmm, m2 = in[2].r[r].xmm, m3 = in[3].r[r].xmm;
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            a[r * 4 + 0] = m0;
+            a[r * 4 + 1] = m1;
+            a[r * 4 + 2] = m2;
+            a[r * 4 + 3] = m3;
+        }
+        __m128 s0 = _mm_sub_ps(_mm_mul_ps(a[0], a[5]), _mm_mul_ps(a[4], a[1]));
+        __m128 s1 = _mm_sub_ps(_mm_mul_ps(a[0], a[6]), _mm_mul_ps(a[4], a[2]));
+        __m128 s2 = _mm_sub_ps(_mm_mul_ps(a[0], a[7]), _mm_mul_ps(a[4], a[3]));
+        __m128 s3 = _mm_sub_ps(_mm_mul_ps(a[1], a[6]), _mm_mul_ps(a[5], a[2]));
+        __m128 s4 = _mm_sub_ps(_mm_mul_ps(a[1], a[7]), _mm_mul_ps(a[5], a[3]));
+        __m128 s5 = _mm_sub_ps(_mm_mul_ps(a[2], a[7]), _mm_mul_ps(a[6], a[3]));
+        __m128 c5 = _mm_sub_ps(_mm_mul_ps(a[10], a[15]), _mm_mul_ps(a[14], a[11]));
+        __m128 c4 = _mm_sub_ps(_mm_mul_ps(a[9], a[15]), _mm_mul_ps(a[13], a[11]));
+        __m128 c3 = _mm_sub_ps(_mm_mul_ps(a[9], a[14]), _mm_mul_ps(a[13], a[10]));
+        __m128 c2 = _mm_sub_ps(_mm_mul_ps(a[8], a[15]), _mm_mul_ps(a[12], a[11]));
+        __m128 c1 = _mm_sub_ps(_mm_mul_ps(a[8], a[14]), _mm_mul_ps(a[12], a[10]));
+        __m128 c0 = _mm_sub_ps(_mm_mul_ps(a[8], a[13]), _mm_mul_ps(a[12], a[9]));
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(s0, c5), _mm_mul_ps(s1, c4)), _mm_mul_ps(s2, c3)), _mm_add_ps(_mm_sub_ps(_mm_mul_ps(s3, c2), _mm_mul_ps(s4, c1)), _mm_mul_ps(s5, c0)));
+        b[0] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[5], c5), _mm_mul_ps(a[6], c4)), _mm_mul_ps(a[7], c3));
+        b[1] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[2], c4), _mm_mul_ps(a[1], c5)), _mm_mul_ps(a[3], c3));
+        b[2] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[13], s5), _mm_mul_ps(a[14], s4)), _mm_mul_ps(a[15], s3));
+        b[3] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[10], s4), _mm_mul_ps(a[9], s5)), _mm_mul_ps(a[11], s3));
+        b[4] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[6], c2), _mm_mul_ps(a[4], c5)), _mm_mul_ps(a[7], c1));
+        b[5] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c5), _mm_mul_ps(a[2], c2)), _mm_mul_ps(a[3], c1));
+        b[6] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[14], s2), _mm_mul_ps(a[12], s5)), _mm_mul_ps(a[15], s1));
+        b[7] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s5), _mm_mul_ps(a[10], s2)), _mm_mul_ps(a[11], s1));
+        b[8] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[4], c4), _mm_mul_ps(a[5], c2)), _mm_mul_ps(a[7], c0));
+        b[9] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[1], c2), _mm_mul_ps(a[0], c4)), _mm_mul_ps(a[3], c0));
+        b[10] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[12], s4), _mm_mul_ps(a[13], s2)), _mm_mul_ps(a[15], s0));
+        b[11] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[9], s2), _mm_mul_ps(a[8], s4)), _mm_mul_ps(a[11], s0));
+        b[12] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[5], c1), _mm_mul_ps(a[4], c3)), _mm_mul_ps(a[6], c0));
+        b[13] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c3), _mm_mul_ps(a[1], c1)), _mm_mul_ps(a[2], c0));
+        b[14] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[13], s1), _mm_mul_ps(a[12], s3)), _mm_mul_ps(a[14], s0));
+        b[15] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s3), _mm_mul_ps(a[9], s1)), _mm_mul_ps(a[10], s0));
+        __m128 invertible = _mm_cmpneq_ps(det, _mm_setzero_ps());
+        __m128 inv = _mm_div_ps(sse::One, det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm_or_ps(_mm_and_ps(invertible, _mm_mul_ps(b[k], inv)), _mm_andnot_ps(invertible, a[k]));
+        }
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = b[r * 4 + 0], m1 = b[r * 4 + 1], m2 = b[r * 4 + 2], m3 = b[r * 4 + 3];
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            out[0].r[r].xmm = m0;
+            out[1].r[r].xmm = m1;
+            out[2].r[r].xmm = m2;
+            out[3].r[r].xmm = m3;
+        }
+        if (ok) {
+            int bits = _mm_movemask_ps(invertible);
+            for (int j = 0; j < 4; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+#endif
+
+    _XOSRCINL void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            InverseFour(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            // the last few are padded out with identities, so nothing past the end is read or written.
+            Matrix4x4 tail[4];
+            bool tailOk[4];
+            for (size_t j = 0; j < 4; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseFour(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            Matrix4x4 m = in[i];
+            bool invertible = m.TryMakeInverse();
+            out[i] = m;
+            if (ok) {
+                ok[i] = invertible;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row i of lo in the low 128 bit lane and row i of hi in the high lane.
+    _XOINL _XO_TARGET_AVX __m256 LoadRowPair(const Matrix4x4& lo, const Matrix4x4& hi, int i) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.r[i].xmm), hi.r[i].xmm, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void StoreRowPair(Matrix4x4& lo, Matrix4x4& hi, int i, __m256 v) {
+        lo.r[i].xmm = _mm256_castps256_ps128(v);
+        hi.r[i].xmm = _mm256_extractf128_ps(v, 1);
+    }
+
+    // Multiplies two matrices at once, one per 128 bit lane. aN and bN are row N of the left and right hand.
+    // All rows are passed in before any are stored, so the outputs may alias either input.
+    _XOINL _XO_TARGET_AVX void MultiplyPair(__m256 a0, __m256 a1, __m256 a2, __m256 a3, 
+                                            __m256 b0, __m256 b1, __m256 b2, __m256 b3, 
+                                            Matrix4x4& outLo, Matrix4x4& outHi) 
+    {
+        StoreRowPair(outLo, outHi, 0, sse::LinearCombination(a0, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 1, sse::LinearCombination(a1, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 2, sse::LinearCombination(a2, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 3, sse::LinearCombination(a3, b0, b1, b2, b3));
+    }
+
+    // Two vectors in v, transformed by the columns c0 to c3 of the matrix. The w of each vector is ignored and 1 is used.
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector3(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector4(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), _mm256_mul_ps(c3, w)));
+    }
+
+    // The same matrix in both lanes, for the side of MultiplyBatchAVX with a step of 0.
+    _XOINL _XO_TARGET_AVX void BroadcastRows(const Matrix4x4& m, __m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+        r0 = _mm256_broadcast_ps(&m.r[0].xmm);
+        r1 = _mm256_broadcast_ps(&m.r[1].xmm);
+        r2 = _mm256_broadcast_ps(&m.r[2].xmm);
+        r3 = _mm256_broadcast_ps(&m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Two vectors per register, one in each 128 bit lane. _mm256_shuffle_ps shuffles within each lane.
+    // Eight vectors per pass, then the last few through masked loads and stores.
+    _XOSRCINL _XO_TARGET_AVX void TransformVector3ArrayAVX(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector3(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector3(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void TransformVector4ArrayAVX(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector4(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector4(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void MultiplyBatchAVX(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        __m256 a0, a1, a2, a3, b0, b1, b2, b3;
+        if (aStep == 0) {
+            BroadcastRows(*a, a0, a1, a2, a3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(a0, a1, a2, a3,
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        else if (bStep == 0) {
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             b0, b1, b2, b3,
+                             out[i], out[i+1]);
+            }
+        }
+        else {
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        if (i < n) {
+            // The last odd product goes through the same pair kernel, with its high lane thrown away.
+            const Matrix4x4& la = a[i * aStep];
+            const Matrix4x4& lb = b[i * bStep];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(lb, lb, 0), LoadRowPair(lb, lb, 1), LoadRowPair(lb, lb, 2), LoadRowPair(lb, lb, 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // As MultiplyBatchAVX, with the left hand rows of each pair gathered from wherever the indices point.
+    _XOSRCINL _XO_TARGET_AVX void MultiplyIndexedBatchAVX(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const Matrix4x4& a0 = a[aIndices[i]];
+            const Matrix4x4& a1 = a[aIndices[i+1]];
+            MultiplyPair(LoadRowPair(a0, a1, 0), LoadRowPair(a0, a1, 1), LoadRowPair(a0, a1, 2), LoadRowPair(a0, a1, 3),
+                         LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                         LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                         out[i], out[i+1]);
+        }
+        if (i < n) {
+            const Matrix4x4& la = a[aIndices[i]];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(b[i], b[i], 0), LoadRowPair(b[i], b[i], 1), LoadRowPair(b[i], b[i], 2), LoadRowPair(b[i], b[i], 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 8x8 transpose: interleave pairs of rows, then pairs of pairs, then swap the 128 bit lanes.
+    _XOINL _XO_TARGET_AVX void Transpose8x8(__m256 v[8]) {
+        __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]), t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]), t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        __m256 t4 = _mm256_unpacklo_ps(v[4], v[5]), t5 = _mm256_unpackhi_ps(v[4], v[5]);
+        __m256 t6 = _mm256_unpacklo_ps(v[6], v[7]), t7 = _mm256_unpackhi_ps(v[6], v[7]);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        v[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+        v[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+        v[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+        v[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+        v[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+        v[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+        v[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+        v[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+    }
+
+    // See InverseFour. Each register holds two rows of a matrix, so the eight matrices are two 8x8 transposes.
+    _XOINL _XO_TARGET_AVX void InverseEight(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        // the loads and stores are written out so the arrays stay in registers rather than on the stack.
+        __m256 a[16] = {
+            _mm256_loadu_ps(in[0].m), _mm256_loadu_ps(in[1].m), _mm256_loadu_ps(in[2].m), _mm256_loadu_ps(in[3].m),
+            _mm256_loadu_ps(in[4].m), _mm256_loadu_ps(in[5].m), _mm256_loadu_ps(in[6].m), _mm256_loadu_ps(in[7].m),
+            _mm256_loadu_ps(in[0].m + 8), _mm256_loadu_ps(in[1].m + 8), _mm256_loadu_ps(in[2].m + 8), _mm256_loadu_ps(in[3].m + 8),
+            _mm256_loadu_ps(in[4].m + 8), _mm256_loadu_ps(in[5].m + 8), _mm256_loadu_ps(in[6].m + 8), _mm256_loadu_ps(in[7].m + 8)
+        };
+        __m256 b[16];
+        Transpose8x8(a);
+        Transpose8x8(a + 8);
+        __m256 s0 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[5]), _mm256_mul_ps(a[4], a[1]));
+        __m256 s1 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[6]), _mm256_mul_ps(a[4], a[2]));
+        __m256 s2 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[7]), _mm256_mul_ps(a[4], a[3]));
+        __m256 s3 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[6]), _mm256_mul_ps(a[5], a[2]));
+        __m256 s4 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[7]), _mm256_mul_ps(a[5], a[3]));
+        __m256 s5 = _mm256_sub_ps(_mm256_mul_ps(a[2], a[7]), _mm256_mul_ps(a[6], a[3]));
+        __m256 c5 = _mm256_sub_ps(_mm256_mul_ps(a[10], a[15]), _mm256_mul_ps(a[14], a[11]));
+        __m256 c4 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[15]), _mm256_mul_ps(a[13], a[11]));
+        __m256 c3 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[14]), _mm256_mul_ps(a[13], a[10]));
+        __m256 c2 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[15]), _mm256_mul_ps(a[12], a[11]));
+        __m256 c1 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[14]), _mm256_mul_ps(a[12], a[10]));
+        __m256 c0 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[13]), _mm256_mul_ps(a[12], a[9]));
+        __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s0, c5), _mm256_mul_ps(s1, c4)), _mm256_mul_ps(s2, c3)), _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s3, c2), _mm256_mul_ps(s4, c1)), _mm256_mul_ps(s5, c0)));
+        b[0] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c5), _mm256_mul_ps(a[6], c4)), _mm256_mul_ps(a[7], c3));
+        b[1] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[2], c4), _mm256_mul_ps(a[1], c5)), _mm256_mul_ps(a[3], c3));
+        b[2] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s5), _mm256_mul_ps(a[14], s4)), _mm256_mul_ps(a[15], s3));
+        b[3] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[10], s4), _mm256_mul_ps(a[9], s5)), _mm256_mul_ps(a[11], s3));
+        b[4] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[6], c2), _mm256_mul_ps(a[4], c5)), _mm256_mul_ps(a[7], c1));
+        b[5] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c5), _mm256_mul_ps(a[2], c2)), _mm256_mul_ps(a[3], c1));
+        b[6] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[14], s2), _mm256_mul_ps(a[12], s5)), _mm256_mul_ps(a[15], s1));
+        b[7] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s5), _mm256_mul_ps(a[10], s2)), _mm256_mul_ps(a[11], s1));
+        b[8] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[4], c4), _mm256_mul_ps(a[5], c2)), _mm256_mul_ps(a[7], c0));
+        b[9] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[1], c2), _mm256_mul_ps(a[0], c4)), _mm256_mul_ps(a[3], c0));
+        b[10] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[12], s4), _mm256_mul_ps(a[13], s2)), _mm256_mul_ps(a[15], s0));
+        b[11] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[9], s2), _mm256_mul_ps(a[8], s4)), _mm256_mul_ps(a[11], s0));
+        b[12] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c1), _mm256_mul_ps(a[4], c3)), _mm256_mul_ps(a[6], c0));
+        b[13] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c3), _mm256_mul_ps(a[1], c1)), _mm256_mul_ps(a[2], c0));
+        b[14] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s1), _mm256_mul_ps(a[12], s3)), _mm256_mul_ps(a[14], s0));
+        b[15] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s3), _mm256_mul_ps(a[9], s1)), _mm256_mul_ps(a[10], s0));
+        __m256 invertible = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm256_blendv_ps(a[k], _mm256_mul_ps(b[k], inv), invertible);
+        }
+        Transpose8x8(b);
+        Transpose8x8(b + 8);
+        for (int j = 0; j < 8; ++j) {
+            _mm256_storeu_ps(out[j].m, b[j]);
+            _mm256_storeu_ps(out[j].m + 8, b[j + 8]);
+        }
+        if (ok) {
+            int bits = _mm256_movemask_ps(invertible);
+            for (int j = 0; j < 8; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void InverseBatchAVX(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            InverseEight(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[8];
+            bool tailOk[8];
+            for (size_t j = 0; j < 8; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseEight(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // Four vectors in v, one per 128 bit lane, transformed by the columns c0 to c3 of the matrix.
+    // The w of each vector is ignored and c3 is added, so c3 is zero for directions.
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector3(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector4(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m512 w = _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), _mm512_mul_ps(c3, w)));
+    }
+
+    // One whole matrix per register, a row per 128 bit lane. Row i of the product is the linear combination of 
+    // the rows b0 to b3, weighted by row i of a, so each lane broadcasts its own elements of a.
+    // Grouped as sse::LinearCombination, so the results match the narrower kernels exactly.
+    _XOINL _XO_TARGET_AVX512 __m512 MultiplyWhole(__m512 a, __m512 b0, __m512 b1, __m512 b2, __m512 b3) {
+        return _mm512_add_ps(
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+
+    _XOINL _XO_TARGET_AVX512 void BroadcastRows(const Matrix4x4& m, __m512& r0, __m512& r1, __m512& r2, __m512& r3) {
+        r0 = _mm512_broadcast_f32x4(m.r[0].xmm);
+        r1 = _mm512_broadcast_f32x4(m.r[1].xmm);
+        r2 = _mm512_broadcast_f32x4(m.r[2].xmm);
+        r3 = _mm512_broadcast_f32x4(m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Four vectors per register. Sixteen vectors per pass, then four at a time, then the last few through a mask
+    // register.
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector3ArrayAVX512(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector3(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector4ArrayAVX512(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector4(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // A matrix is one register, so there's no tail. Each product is loaded before it's stored, so out may alias
+    // either input.
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyBatchAVX512(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        if (bStep == 0) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                __m512 p0 = MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3);
+                __m512 p1 = MultiplyWhole(_mm512_loadu_ps(a[i+1].m), b0, b1, b2, b3);
+                _mm512_storeu_ps(out[i].m, p0);
+                _mm512_storeu_ps(out[i+1].m, p1);
+            }
+            if (i < n) {
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3));
+            }
+        }
+        else {
+            __m512 wa = _mm512_loadu_ps(a->m);
+            for (; i < n; ++i) {
+                __m512 b0, b1, b2, b3;
+                const Matrix4x4& mb = b[i];
+                BroadcastRows(mb, b0, b1, b2, b3);
+                if (aStep != 0) {
+                    wa = _mm512_loadu_ps(a[i].m);
+                }
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(wa, b0, b1, b2, b3));
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyIndexedBatchAVX512(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(b[i], b0, b1, b2, b3);
+            _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[aIndices[i]].m), b0, b1, b2, b3));
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 16x16 transpose: interleave pairs of rows, then pairs of pairs, then two rounds of moving
+    // 128 bit lanes between registers.
+    _XOINL _XO_TARGET_AVX512 void Transpose16x16(__m512 v[16]) {
+        __m512 t[16], u[16];
+        for (int i = 0; i < 16; i += 2) {
+            t[i] = _mm512_unpacklo_ps(v[i], v[i + 1]);
+            t[i + 1] = _mm512_unpackhi_ps(v[i], v[i + 1]);
+        }
+        for (int i = 0; i < 16; i += 4) {
+            u[i] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 1] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            u[i + 2] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 3] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+        for (int i = 0; i < 16; i += 8) {
+            for (int j = 0; j < 4; ++j) {
+                t[i + j] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(2, 0, 2, 0));
+                t[i + j + 4] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(3, 1, 3, 1));
+            }
+        }
+        for (int j = 0; j < 8; ++j) {
+            v[j] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(2, 0, 2, 0));
+            v[j + 8] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(3, 1, 3, 1));
+        }
+    }
+
+    // See InverseFour. Each register holds a whole matrix, so the sixteen matrices are one 16x16 transpose.
+    _XOINL _XO_TARGET_AVX512 void InverseSixteen(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m512 a[16], b[16];
+        for (int j = 0; j < 16; ++j) {
+            a[j] = _mm512_loadu_ps(in[j].m);
+        }
+        Transpose16x16(a);
+        __m512 s0 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[5]), _mm512_mul_ps(a[4], a[1]));
+        __m512 s1 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[6]), _mm512_mul_ps(a[4], a[2]));
+        __m512 s2 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[7]), _mm512_mul_ps(a[4], a[3]));
+        __m512 s3 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[6]), _mm512_mul_ps(a[5], a[2]));
+        __m512 s4 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[7]), _mm512_mul_ps(a[5], a[3]));
+        __m512 s5 = _mm512_sub_ps(_mm512_mul_ps(a[2], a[7]), _mm512_mul_ps(a[6], a[3]));
+        __m512 c5 = _mm512_sub_ps(_mm512_mul_ps(a[10], a[15]), _mm512_mul_ps(a[14], a[11]));
+        __m512 c4 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[15]), _mm512_mul_ps(a[13], a[11]));
+        __m512 c3 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[14]), _mm512_mul_ps(a[13], a[10]));
+        __m512 c2 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[15]), _mm512_mul_ps(a[12], a[11]));
+        __m512 c1 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[14]), _mm512_mul_ps(a[12], a[10]));
+        __m512 c0 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[13]), _mm512_mul_ps(a[12], a[9]));
+        __m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s0, c5), _mm512_mul_ps(s1, c4)), _mm512_mul_ps(s2, c3)), _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s3, c2), _mm512_mul_ps(s4, c1)), _mm512_mul_ps(s5, c0)));
+        b[0] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c5), _mm512_mul_ps(a[6], c4)), _mm512_mul_ps(a[7], c3));
+        b[1] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[2], c4), _mm512_mul_ps(a[1], c5)), _mm512_mul_ps(a[3], c3));
+        b[2] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s5), _mm512_mul_ps(a[14], s4)), _mm512_mul_ps(a[15], s3));
+        b[3] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[10], s4), _mm512_mul_ps(a[9], s5)), _mm512_mul_ps(a[11], s3));
+        b[4] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[6], c2), _mm512_mul_ps(a[4], c5)), _mm512_mul_ps(a[7], c1));
+        b[5] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c5), _mm512_mul_ps(a[2], c2)), _mm512_mul_ps(a[3], c1));
+        b[6] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[14], s2), _mm512_mul_ps(a[12], s5)), _mm512_mul_ps(a[15], s1));
+        b[7] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s5), _mm512_mul_ps(a[10], s2)), _mm512_mul_ps(a[11], s1));
+        b[8] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[4], c4), _mm512_mul_ps(a[5], c2)), _mm512_mul_ps(a[7], c0));
+        b[9] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[1], c2), _mm512_mul_ps(a[0], c4)), _mm512_mul_ps(a[3], c0));
+        b[10] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[12], s4), _mm512_mul_ps(a[13], s2)), _mm512_mul_ps(a[15], s0));
+        b[11] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[9], s2), _mm512_mul_ps(a[8], s4)), _mm512_mul_ps(a[11], s0));
+        b[12] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c1), _mm512_mul_ps(a[4], c3)), _mm512_mul_ps(a[6], c0));
+        b[13] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c3), _mm512_mul_ps(a[1], c1)), _mm512_mul_ps(a[2], c0));
+        b[14] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s1), _mm512_mul_ps(a[12], s3)), _mm512_mul_ps(a[14], s0));
+        b[15] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s3), _mm512_mul_ps(a[9], s1)), _mm512_mul_ps(a[10], s0));
+        __mmask16 invertible = _mm512_cmp_ps_mask(det, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+        __m512 inv = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm512_mask_blend_ps(invertible, a[k], _mm512_mul_ps(b[k], inv));
+        }
+        Transpose16x16(b);
+        for (int j = 0; j < 16; ++j) {
+            _mm512_storeu_ps(out[j].m, b[j]);
+        }
+        if (ok) {
+            for (int j = 0; j < 16; ++j) {
+                ok[j] = ((invertible >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void InverseBatchAVX512(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            InverseSixteen(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[16];
+            bool tailOk[16];
+            for (size_t j = 0; j < 16; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseSixteen(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(const Vector4* in, Vector4* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector4Array(*this, in, out, n);
+#else
+    xo_internal::TransformVector4Array(*this, in, out, n);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(Vector4* inOut, size_t n) const {
+    return TransformVector4s(inOut, inOut, n);
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(&a, 0, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(&a, 0, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, &b, 0, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, &b, 0, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyIndexedBatch(a, aIndices, b, out, n);
+#else
+    xo_internal::MultiplyIndexedBatch(a, aIndices, b, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().inverseBatch(in, out, ok, n);
+#else
+    xo_internal::InverseBatch(in, out, ok, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
+    m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, xyz,  0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, xyz,  0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+_XOSRCINL void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
+    m[0].Set(x,    0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, y,    0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, z,    0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
+    m[0].Set(v.x,  0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, v.y,  0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, v.z,  0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+_XOSRCINL void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(x,    y,    z,    1.0f);
+}
+
+_XOSRCINL void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(v,                1.0f);
+}
+
+_XOSRCINL void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+
+    SinCos(radians, sinr, cosr);
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, cosr,-sinr, 0.0f);
+    m[2].Set(0.0f, sinr, cosr, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+_XOSRCINL void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+    SinCos(radians, sinr, cosr);
+    m[0].Set(cosr, 0.0f,-sinr, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(sinr, 0.0f, cosr, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+    SinCos(radians, sinr, cosr);
+    m[0].Set(cosr,-sinr, 0.0f, 0.0f);
+    m[1].Set(sinr, cosr, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
+    _XOSIMDALIGN float c[4];
+    _XOSIMDALIGN float s[4];
+    Vector4 v(x, y, z, 0.0f);
+    SinCos_x4(v.f, s, c);
+
+    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
+    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
+    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
+    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+}
+
+_XOSRCINL void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
+    _XOSIMDALIGN float c[4];
+    _XOSIMDALIGN float s[4];
+    SinCos_x4(v.f, s, c);
+
+    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
+    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
+    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
+    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+}
+
+_XOSRCINL void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
+    float s, c;
+    SinCos(radians, s, c);
+    float t = 1.0f - c;
+    const float& x = a.x;
+    const float& y = a.y;
+    const float& z = a.z;
+    m = Matrix4x4(
+             t*x*x+c  ,    t*x*y-z*s,  t*x*z+y*s,  0.0f,
+             t*x*y+z*s,    t*y*y+c  ,  t*y*z-x*s,  0.0f,
+             t*x*z-y*s,    t*y*z+x*s,  t*z*z+c  ,  0.0f,
+             0.0f,         0.0f,       0.0f,       1.0f
+        );
+}
+
+_XOSRCINL void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
+    RotationXRadians(degrees * Deg2Rad, m);
+}
+
+_XOSRCINL void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
+    RotationYRadians(degrees * Deg2Rad, m);
+}
+
+_XOSRCINL void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
+    RotationZRadians(degrees * Deg2Rad, m);
+}
+
+_XOSRCINL void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
+    Matrix4x4 m0, m1, m2;
+    RotationXDegrees(x, m0);
+    RotationYDegrees(y, m1);
+    RotationZDegrees(z, m2);
+    m = m0 * m1 * m2;
+}
+
+_XOSRCINL void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
+    Matrix4x4 m0, m1, m2;
+    RotationXDegrees(v.x, m0);
+    RotationYDegrees(v.y, m1);
+    RotationZDegrees(v.z, m2);
+    m = m0 * m1 * m2;
+}
+
+
+_XOSRCINL void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
+    AxisAngleRadians(a, degrees * Deg2Rad, m);
+}
+
+_XOSRCINL void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
+    XO_ASSERT(w != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Width (w) should not be zero."));
+    XO_ASSERT(h != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Height (h) should not be zero."));
+    m = Matrix4x4(
+            1.0f/w,    0.0f,       0.0f,    0.0f,
+            0.0f,      1.0f/h,     0.0f,    0.0f,
+            0.0f,      0.0f,       f-n,     0.0f,
+            0.0f,      0.0f,       n*(f-n), 1.0f
+        );
+}
+ 
+_XOSRCINL void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
+    XO_ASSERT(n != f, _XO_ASSERT_MSG("::PerspectiveProjectionRadians Near (n) and far (f) values should not be equal."));
+    m = Matrix4x4(
+            ATan(fovx/2.0f),   0.0f,               0.0f,               0.0f,
+            0.0f,              ATan(fovy/2.0f),    0.0f,               0.0f,
+            0.0f,              0.0f,               f/(f-n),            1.0f,
+            0.0f,              0.0f,               -n*(f/-n),          1.0f
+        );
+}
+
+_XOSRCINL void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
+    Matrix4x4::PerspectiveProjectionRadians(fovx * Deg2Rad, fovy * Deg2Rad, n, f, outMatrix);
+}
+
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
+    Vector3 zAxis = (to - from).Normalized();
+    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
+    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
+    m = Matrix4x4(
+            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
+            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
+            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
+            -xAxis.Dot(from),  -yAxis.Dot(from),   -zAxis.Dot(from),   1.0f
+        );
+}
+
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
+    LookAtFromPosition(from, to, Vector3::Up, m);
+}
+
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
+    Vector3 zAxis = direction.Normalized();
+    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
+    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
+    m = Matrix4x4(
+            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
+            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
+            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
+            0.0f,              0.0f,               0.0f,               1.0f
+        );
+}
+
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
+    LookAtFromDirection(direction, Vector3::Up, m);
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float xyz) {
+    Matrix4x4 m;
+    Scale(xyz, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
+    Matrix4x4 m;
+    Scale(x, y, z, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
+    Matrix4x4 m;
+    Scale(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
+    Matrix4x4 m;
+    Translation(x, y, z, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
+    Matrix4x4 m;
+    Translation(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
+    Matrix4x4 m;
+    RotationXRadians(radians, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
+    Matrix4x4 m;
+    RotationYRadians(radians, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
+    Matrix4x4 m;
+    RotationZRadians(radians, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
+    Matrix4x4 m;
+    RotationRadians(x, y, z, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
+    Matrix4x4 m;
+    RotationRadians(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
+    Matrix4x4 m;
+    AxisAngleRadians(axis, radians, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationXDegrees(degrees, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationYDegrees(degrees, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationZDegrees(degrees, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
+    Matrix4x4 m;
+    RotationDegrees(x, y, z, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
+    Matrix4x4 m;
+    RotationDegrees(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
+    Matrix4x4 m;
+    AxisAngleDegrees(axis, degrees, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
+    Matrix4x4 m;
+    OrthographicProjection(w, h, n, f, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
+    Matrix4x4 m;
+    PerspectiveProjectionRadians(fovx, fovy, n, f, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
+    Matrix4x4 m;
+    PerspectiveProjectionDegrees(fovx, fovy, n, f, m);
+    return m;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
+    Matrix4x4 m;
+    LookAtFromPosition(from, to, up, m);
+    return m;
+}
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
+    Matrix4x4 m;
+    LookAtFromPosition(from, to, m);
+    return m;
+}
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
+    Matrix4x4 m;
+    LookAtFromDirection(direction, up, m);
+    return m;
+}
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
+    Matrix4x4 m;
+    LookAtFromDirection(direction, m);
+    return m;
+}
+
+#undef _XO_ASSERT_MSG
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Quaternion.cpp
+
+#if defined(_XONOCONSTEXPR)
+#   if defined(XO_SSE)
+_XOSRCDATA const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+#   else
+_XOSRCDATA const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
+#   endif
+#endif
+
+_XOSRCDATA const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+
+namespace xo_internal
+{
+    _XOINL float QuaternionSquareSum(const Quaternion& q)
+    {
+#if defined(XO_SSE3)
+        __m128 square = _mm_mul_ps(q.xmm, q.xmm);
+        square = _mm_hadd_ps(square, square);
+        square = _mm_hadd_ps(square, square);
+        return _mm_cvtss_f32(square);
+#else
+        return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+#endif
+    }
+}
+
+_XOSRCINL Quaternion::Quaternion()
+{
+}
+
+_XOSRCINL Quaternion::Quaternion(const Matrix3x4& mat)
+{
+    // The rotation is taken from the columns, which are the transformed axes, so a scale applied before the
+    // rotation divides out.
+    Vector3 xAxis = mat.GetColumn(0);
+    Vector3 yAxis = mat.GetColumn(1);
+    Vector3 zAxis = mat.GetColumn(2);
+
+    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
+
+    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
+    {
+        _XO_ASSIGN_QUAT(1.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    xAxis /= scale.x;
+    yAxis /= scale.y;
+    zAxis /= scale.z;
+
+    // With the axes as columns, m[r][c] is axis c's component r.
+    float trace = xAxis.x + yAxis.y + zAxis.z;
+
+    if (trace > 0.0f)
+    {
+        float s = 0.5f / Sqrt(trace + 1.0f);
+        _XO_ASSIGN_QUAT(
+            0.25f / s,
+            (yAxis.z - zAxis.y) * s,
+            (zAxis.x - xAxis.z) * s,
+            (xAxis.y - yAxis.x) * s);
+    }
+    else if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (yAxis.z - zAxis.y) * s,
+            0.25f / s,
+            (yAxis.x + xAxis.y) * s,
+            (zAxis.x + xAxis.z) * s);
+    }
+    else if (yAxis.y > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (zAxis.x - xAxis.z) * s,
+            (yAxis.x + xAxis.y) * s,
+            0.25f / s,
+            (zAxis.y + yAxis.z) * s);
+    }
+    else
+    {
+        float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+        _XO_ASSIGN_QUAT(
+            (xAxis.y - yAxis.x) * s,
+            (zAxis.x + xAxis.z) * s,
+            (zAxis.y + yAxis.z) * s,
+            0.25f / s);
+    }
+}
+
+_XOSRCINL Quaternion::Quaternion(const Matrix4x4& mat)
+{
+    Vector3 xAxis(mat[0]);
+    Vector3 yAxis(mat[1]);
+    Vector3 zAxis(mat[2]);
+
+    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
+
+    // don't use close enough, skip the abs since we're all positive value.
+    // todo: do we actually care about near-zero?
+    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
+    {
+#if defined(XO_SSE)
+
+#else
+        w = 1.0f;
+        x = y = z = 0.0f;
+#endif
+        return; // too close.
+    }
+
+#if defined(XO_SSE)
+#   if defined(XO_NO_INVERSE_DIVISION)
+    Vector3 recipScale = Vector3(_mm_div_ps(Vector4::One.xmm, scale.xmm));
+#   else
+    Vector3 recipScale = Vector3(_mm_rcp_ps(scale.xmm));
+#   endif
+#else
+    Vector3 recipScale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+#endif
+    xAxis *= recipScale.x;
+    yAxis *= recipScale.y;
+    zAxis *= recipScale.z;
+
+    // Now calculate the rotation from the resulting matrix (axes).
+    float trace = xAxis.x + yAxis.y + zAxis.z + 1.0f;
+
+    if (trace > 1.0f)
+    {
+        float s = 0.5f / Sqrt(trace);
+        _XO_ASSIGN_QUAT(
+            0.25f / s,
+            (yAxis.z - zAxis.y) * s,
+            (xAxis.y - yAxis.x) * s,
+            (zAxis.x - xAxis.z) * s);
+    }
+    else
+    {
+        if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+        {
+            float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+            _XO_ASSIGN_QUAT(
+                (yAxis.z - zAxis.y) * s,
+                0.25f / s,
+                (zAxis.x + xAxis.z) * s,
+                (yAxis.x + xAxis.y) * s);
+        }
+        else if (yAxis.y > zAxis.z)
+        {
+            float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+            _XO_ASSIGN_QUAT(
+                (zAxis.x - xAxis.z) * s,
+                (yAxis.x + xAxis.y) * s,
+                (zAxis.y + yAxis.z) * s,
+                0.25f / s);
+        }
+        else
+        {
+            float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+            _XO_ASSIGN_QUAT(
+                (xAxis.y - yAxis.x) * s,
+                (zAxis.x + xAxis.z) * s,
+                0.25f / s,
+                (zAxis.y + yAxis.z) * s);
+        }
+    }
+}
+
+_XOSRCINL Quaternion::Quaternion(float x, float y, float z, float w) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(w, z, y, x))
+#else
+    x(x), y(y), z(z), w(w)
+#endif
+{
+}
+
+_XOSRCINL Quaternion Quaternion::Inverse() const
+{
+    return Quaternion(*this).MakeInverse();
+}
+
+_XOSRCINL Quaternion& Quaternion::MakeInverse()
+{
+    float magnitude = xo_internal::QuaternionSquareSum(*this);
+
+    if (CloseEnough(magnitude, 1.0f, Epsilon))
+    {
+        return MakeConjugate();
+    }
+    if (CloseEnough(magnitude, 0.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    MakeConjugate();
+    (*(Vector4*)this) /= magnitude;
+    return *this;
+}
+
+_XOSRCINL Quaternion Quaternion::Normalized() const
+{
+    return Quaternion(*this).Normalize();
+}
+
+_XOSRCINL Quaternion& Quaternion::Normalize()
+{
+    float magnitude = xo_internal::QuaternionSquareSum(*this);
+    if (CloseEnough(magnitude, 1.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    magnitude = Sqrt(magnitude);
+    if (CloseEnough(magnitude, 0.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    (*(Vector4*)this) /= magnitude;
+    return *this;
+}
+
+_XOSRCINL Quaternion Quaternion::Conjugate() const
+{
+    return Quaternion(*this).MakeConjugate();
+}
+
+_XOSRCINL Quaternion& Quaternion::MakeConjugate()
+{
+    _XO_ASSIGN_QUAT(w, -x, -y, -z);
+    return *this;
+}
+
+_XOSRCINL void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
+{
+    Quaternion q = Normalized();
+
+#if defined(XO_SSE)
+    // todo: don't we need to normalize axis in sse too?
+    axis.xmm = q.xmm;
+#else
+    axis.x = q.x;
+    axis.y = q.y;
+    axis.z = q.z;
+    axis.Normalize();
+#endif
+    radians = (2.0f * ACos(q.w));
+}
+
+_XOSRCINL void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
+{
+    RotationRadians(Vector3(x, y, z), outQuat);
+}
+
+_XOSRCINL void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
+{
+    Vector3 hv = v * 0.5f;
+    _XOSIMDALIGN float s[3];
+    _XOSIMDALIGN float c[3];
+    SinCos_x3(hv.f, s, c);
+
+    _XO_ASSIGN_QUAT_Q(outQuat,
+                      c[0] * c[1] * c[2] + s[0] * s[1] * s[2],
+                      s[0] * c[1] * c[2] - c[0] * s[1] * s[2],
+                      c[0] * s[1] * c[2] + s[0] * c[1] * s[2],
+                      c[0] * c[1] * s[2] - s[0] * s[1] * c[2]);
+}
+
+_XOSRCINL void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
+{
+    float sr, cr;
+    SinCos(radians * 0.5f, sr, cr);
+
+    Vector3 n = axis.Normalized();
+    n *= sr;
+    _XO_ASSIGN_QUAT_Q(outQuat, cr, n.x, n.y, n.z);
+}
+
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
+{
+    LookAtFromDirection(to - from, up, outQuat);
+}
+
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+{
+    LookAtFromPosition(from, to, Vector3::Up, outQuat);
+}
+
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+{
+    // Todo
+}
+
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
+{
+    LookAtFromDirection(direction, Vector3::Up, outQuat);
+}
+
+_XOSRCINL void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
+
+    //      Copyright 2013 BlackBerry Inc.
+    //      Licensed under the Apache License, Version 2.0 (the "License");
+    //      you may not use this file except in compliance with the License.
+    //      You may obtain a copy of the License at
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //      Unless required by applicable law or agreed to in writing, software
+    //      distributed under the License is distributed on an "AS IS" BASIS,
+    //      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //      See the License for the specific language governing permissions and
+    //      limitations under the License.
+
+    //      Original file from GamePlay3D: http://gameplay3d.org
+
+    //      Modified by Jared Thomson in 2016:
+    //        - removed assertions
+    //        - made compatable with xo-math
+
+    // Fast slerp implementation by kwhatmough:
+    // It contains no division operations, no trig, no inverse trig
+    // and no sqrt. Not only does this code tolerate small constraint
+    // errors in the input quaternions, it actually corrects for them.
+    if (CloseEnough(t, 0.0f))
+    {
+        outQuat = a;
+        return;
+    }
+    else if (CloseEnough(t, 1.0f))
+    {
+        outQuat = b;
+        return;
+    }
+    else if (a == b)
+    {
+        outQuat = a;
+    }
+    else
+    {
+        float halfY, alpha, beta;
+        float u, f1, f2a, f2b;
+        float ratio1, ratio2;
+        float halfSecHalfTheta, versHalfTheta;
+        float sqNotU, sqU;
+
+        Vector4 * va = (Vector4*)&a;
+        Vector4 * vb = (Vector4*)&b;
+
+        float cosTheta = ((*va) * (*vb)).Sum();
+
+        // As usual in all slerp implementations, we fold theta.
+        alpha = cosTheta >= 0 ? 1.0f : -1.0f;
+        halfY = 1.0f + alpha * cosTheta;
+
+        // Here we bisect the interval, so we need to fold t as well.
+        f2b = t - 0.5f;
+        u = f2b >= 0 ? f2b : -f2b;
+        f2a = u - f2b;
+        f2b += u;
+        u += u;
+        f1 = 1.0f - u;
+
+        // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
+        halfSecHalfTheta = 1.09f - (0.476537f - 0.0903321f * halfY) * halfY;
+        halfSecHalfTheta *= 1.5f - halfY * halfSecHalfTheta * halfSecHalfTheta;
+        versHalfTheta = 1.0f - halfY * halfSecHalfTheta;
+
+        // Evaluate series expansions of the coefficients.
+        sqNotU = f1 * f1;
+        ratio2 = 0.0000440917108f * versHalfTheta;
+        ratio1 = -0.00158730159f + (sqNotU - 16.0f) * ratio2;
+        ratio1 = 0.0333333333f + ratio1 * (sqNotU - 9.0f) * versHalfTheta;
+        ratio1 = -0.333333333f + ratio1 * (sqNotU - 4.0f) * versHalfTheta;
+        ratio1 = 1.0f + ratio1 * (sqNotU - 1.0f) * versHalfTheta;
+
+        sqU = u * u;
+        ratio2 = -0.00158730159f + (sqU - 16.0f) * ratio2;
+        ratio2 = 0.0333333333f + ratio2 * (sqU - 9.0f) * versHalfTheta;
+        ratio2 = -0.333333333f + ratio2 * (sqU - 4.0f) * versHalfTheta;
+        ratio2 = 1.0f + ratio2 * (sqU - 1.0f) * versHalfTheta;
+
+        // Perform the bisection and resolve the folding done earlier.
+        f1 *= ratio1 * halfSecHalfTheta;
+        f2a *= ratio2;
+        f2b *= ratio2;
+        alpha *= f1 + f2a;
+        beta = f1 + f2b;
+
+        // Apply final coefficients to a and b as usual.
+        float w = alpha * a.w + beta * b.w;
+        float x = alpha * a.x + beta * b.x;
+        float y = alpha * a.y + beta * b.y;
+        float z = alpha * a.z + beta * b.z;
+
+        // This final adjustment to the quaternion's length corrects for
+        // any small constraint error in the inputs q1 and q2 But as you
+        // can see, it comes at the cost of 9 additional multiplication
+        // operations. If this error-correcting feature is not required,
+        // the following code may be removed.
+        f1 = 1.5f - 0.5f * (w * w + x * x + y * y + z * z);
+        _XO_ASSIGN_QUAT_Q(outQuat, w * f1, x * f1, y * f1, z * f1);
+    }
+}
+
+_XOSRCINL void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    Vector4& vq = (Vector4&)outQuat;
+    const Vector4& va = a;
+    const Vector4& vb = b;
+    // Todo: give the vectors the same static 'outQuat' type interface, then just use the Vector4::Lerp for this lerp
+    vq = va + (vb - va) * t;
+}
+
+_XOSRCINL void Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // b is negated when it's in the other hemisphere from a, so the blend takes the shorter way around.
+    float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    float wa = 1.0f - t;
+    float wb = cosTheta < 0.0f ? -t : t;
+    float x = wa * a.x + wb * b.x;
+    float y = wa * a.y + wb * b.y;
+    float z = wa * a.z + wb * b.z;
+    float w = wa * a.w + wb * b.w;
+    float s = 1.0f / Sqrt(x * x + y * y + z * z + w * w);
+    _XO_ASSIGN_QUAT_Q(outQuat, w * s, x * s, y * s, z * s);
+}
+
+_XOSRCINL void Quaternion::FastSlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // Arseny Kapoulkine's onlerp: http://zeux.io/2015/07/23/approximating-slerp/
+    // Nlerp moves fastest through the middle of the arc. t is bent by a cubic whose coefficient is fit to the angle 
+    // between a and b, which evens the speed out.
+    float d = Abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+    float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float c = t - 0.5f;
+    float k = A * c * c + B;
+    Nlerp(a, b, t + t * c * (t - 1.0f) * k, outQuat);
+}
+
+_XOSRCINL void Quaternion::SlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::NlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::FastSlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#endif
+}
+
+namespace xo_internal
+{
+    _XOSRCINL void RotateVector3Batch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = q[i].Rotate(in[i]);
+        }
+    }
+
+#if defined(XO_SSE)
+    // Quaternion::Slerp, Nlerp or FastSlerp of four pairs of quaternions, one pair per lane. a and b hold the x, y, z
+    // and w of the four, and the results are written over a.
+    _XOINL void BlendFour(__m128 a[4], const __m128 b[4], __m128 t, QuaternionBlend blend)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 cosTheta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+        __m128 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m128 alpha = _mm_sub_ps(_mm_and_ps(_mm_cmpge_ps(cosTheta, _mm_setzero_ps()), _mm_set1_ps(2.0f)), one);
+            __m128 halfY = _mm_add_ps(one, _mm_mul_ps(alpha, cosTheta));
+            __m128 f2b = _mm_sub_ps(t, half);
+            __m128 u = _mm_andnot_ps(signMask, f2b);
+            __m128 f2a = _mm_sub_ps(u, f2b);
+            f2b = _mm_add_ps(f2b, u);
+            u = _mm_add_ps(u, u);
+            __m128 f1 = _mm_sub_ps(one, u);
+            __m128 halfSecHalfTheta = _mm_sub_ps(_mm_set1_ps(1.09f), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(0.476537f), _mm_mul_ps(_mm_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm_mul_ps(halfSecHalfTheta, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m128 versHalfTheta = _mm_sub_ps(one, _mm_mul_ps(halfY, halfSecHalfTheta));
+            __m128 sqNotU = _mm_mul_ps(f1, f1);
+            __m128 ratio2 = _mm_mul_ps(_mm_set1_ps(0.0000440917108f), versHalfTheta);
+            __m128 ratio1 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqNotU, _mm_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, one)), versHalfTheta));
+            __m128 sqU = _mm_mul_ps(u, u);
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqU, _mm_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm_mul_ps(f1, _mm_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm_mul_ps(alpha, _mm_add_ps(f1, _mm_mul_ps(f2a, ratio2)));
+            wb = _mm_add_ps(f1, _mm_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m128 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m128 d = _mm_andnot_ps(signMask, cosTheta);
+                __m128 A = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+                __m128 B = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+                __m128 c = _mm_sub_ps(t, half);
+                __m128 k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(A, c), c), B);
+                s = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, c), _mm_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm_sub_ps(one, s);
+            wb = _mm_xor_ps(s, _mm_and_ps(cosTheta, signMask));
+        }
+        __m128 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm_add_ps(_mm_mul_ps(wa, a[i]), _mm_mul_ps(wb, b[i]));
+        }
+        __m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_add_ps(_mm_mul_ps(r[2], r[2]), _mm_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m128 scale = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, sq));
+            const __m128 epsilon = _mm_set1_ps(sse::SSEFloatEpsilon);
+            __m128 same = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[0], b[0])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[1], b[1])), epsilon)),
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[2], b[2])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[3], b[3])), epsilon)));
+            __m128 takeB = _mm_cmpeq_ps(t, one);
+            __m128 takeA = _mm_andnot_ps(takeB, _mm_or_ps(same, _mm_cmpeq_ps(t, _mm_setzero_ps())));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m128 v = _mm_mul_ps(r[i], scale);
+                v = _mm_or_ps(_mm_and_ps(takeB, b[i]), _mm_andnot_ps(takeB, v));
+                a[i] = _mm_or_ps(_mm_and_ps(takeA, a[i]), _mm_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m128 scale = _mm_rsqrt_ps(sq);
+            scale = _mm_mul_ps(scale, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(half, sq), _mm_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Four quaternions from each of a, b and t, blended into out.
+    _XOINL void BlendQuaternionsFour(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m128 qa[4] = { a[0].xmm, a[1].xmm, a[2].xmm, a[3].xmm };
+        __m128 qb[4] = { b[0].xmm, b[1].xmm, b[2].xmm, b[3].xmm };
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        _MM_TRANSPOSE4_PS(qb[0], qb[1], qb[2], qb[3]);
+        BlendFour(qa, qb, _mm_loadu_ps(t), blend);
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        out[0].xmm = qa[0];
+        out[1].xmm = qa[1];
+        out[2].xmm = qa[2];
+        out[3].xmm = qa[3];
+    }
+#endif
+
+    _XOSRCINL void BlendQuaternionBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            BlendQuaternionsFour(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            // The last few are padded out with identities to a whole group.
+            Quaternion ta[4], tb[4], tout[4];
+            float tt[4];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsFour(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i)
+        {
+            switch (blend)
+            {
+            case QuaternionBlend::Slerp:
+                Quaternion::Slerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::Nlerp:
+                Quaternion::Nlerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::FastSlerp:
+                Quaternion::FastSlerp(a[i], b[i], t[i], out[i]);
+                break;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 CrossPair(__m256 a, __m256 b)
+    {
+        __m256 r = _mm256_sub_ps(_mm256_mul_ps(a, _mm256_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm256_mul_ps(b, _mm256_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm256_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 RotatePair(__m256 q, __m256 v)
+    {
+        __m256 t = CrossPair(q, v);
+        t = _mm256_add_ps(t, t);
+        return _mm256_add_ps(_mm256_add_ps(v, _mm256_mul_ps(t, _mm256_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossPair(q, t));
+    }
+
+    // Eight vectors per pass, then pairs, then a masked load and store for the last one.
+    _XOSRCINL _XO_TARGET_AVX void RotateVector3BatchAVX(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 v0 = RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f));
+            __m256 v1 = RotatePair(_mm256_loadu_ps(q[i+2].f), _mm256_loadu_ps(in[i+2].f));
+            __m256 v2 = RotatePair(_mm256_loadu_ps(q[i+4].f), _mm256_loadu_ps(in[i+4].f));
+            __m256 v3 = RotatePair(_mm256_loadu_ps(q[i+6].f), _mm256_loadu_ps(in[i+6].f));
+            _mm256_storeu_ps(out[i].f, v0);
+            _mm256_storeu_ps(out[i+2].f, v1);
+            _mm256_storeu_ps(out[i+4].f, v2);
+            _mm256_storeu_ps(out[i+6].f, v3);
+        }
+        for (; i + 2 <= n; i += 2)
+        {
+            _mm256_storeu_ps(out[i].f, RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n)
+        {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, RotatePair(_mm256_maskload_ps(q[i].f, mask), _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // BlendFour on eight pairs of quaternions.
+    _XOINL _XO_TARGET_AVX void BlendEight(__m256 a[4], const __m256 b[4], __m256 t, QuaternionBlend blend)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 cosTheta = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])), _mm256_add_ps(_mm256_mul_ps(a[2], b[2]), _mm256_mul_ps(a[3], b[3])));
+        __m256 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m256 alpha = _mm256_sub_ps(_mm256_and_ps(_mm256_cmp_ps(cosTheta, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_set1_ps(2.0f)), one);
+            __m256 halfY = _mm256_add_ps(one, _mm256_mul_ps(alpha, cosTheta));
+            __m256 f2b = _mm256_sub_ps(t, half);
+            __m256 u = _mm256_andnot_ps(signMask, f2b);
+            __m256 f2a = _mm256_sub_ps(u, f2b);
+            f2b = _mm256_add_ps(f2b, u);
+            u = _mm256_add_ps(u, u);
+            __m256 f1 = _mm256_sub_ps(one, u);
+            __m256 halfSecHalfTheta = _mm256_sub_ps(_mm256_set1_ps(1.09f), _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(0.476537f), _mm256_mul_ps(_mm256_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm256_mul_ps(halfSecHalfTheta, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m256 versHalfTheta = _mm256_sub_ps(one, _mm256_mul_ps(halfY, halfSecHalfTheta));
+            __m256 sqNotU = _mm256_mul_ps(f1, f1);
+            __m256 ratio2 = _mm256_mul_ps(_mm256_set1_ps(0.0000440917108f), versHalfTheta);
+            __m256 ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqNotU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, one)), versHalfTheta));
+            __m256 sqU = _mm256_mul_ps(u, u);
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm256_mul_ps(f1, _mm256_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm256_mul_ps(alpha, _mm256_add_ps(f1, _mm256_mul_ps(f2a, ratio2)));
+            wb = _mm256_add_ps(f1, _mm256_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m256 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m256 d = _mm256_andnot_ps(signMask, cosTheta);
+                __m256 A = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(d, _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(d, _mm256_set1_ps(1.43519f)))))));
+                __m256 B = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(d, _mm256_set1_ps(0.215638f)))));
+                __m256 c = _mm256_sub_ps(t, half);
+                __m256 k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(A, c), c), B);
+                s = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, c), _mm256_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm256_sub_ps(one, s);
+            wb = _mm256_xor_ps(s, _mm256_and_ps(cosTheta, signMask));
+        }
+        __m256 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm256_add_ps(_mm256_mul_ps(wa, a[i]), _mm256_mul_ps(wb, b[i]));
+        }
+        __m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], r[0]), _mm256_mul_ps(r[1], r[1])), _mm256_add_ps(_mm256_mul_ps(r[2], r[2]), _mm256_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m256 scale = _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half, sq));
+            const __m256 epsilon = _mm256_set1_ps(sse::SSEFloatEpsilon);
+            __m256 same = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[0], b[0])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[1], b[1])), epsilon, _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[2], b[2])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[3], b[3])), epsilon, _CMP_LT_OQ)));
+            __m256 takeB = _mm256_cmp_ps(t, one, _CMP_EQ_OQ);
+            __m256 takeA = _mm256_andnot_ps(takeB, _mm256_or_ps(same, _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_EQ_OQ)));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m256 v = _mm256_mul_ps(r[i], scale);
+                v = _mm256_or_ps(_mm256_and_ps(takeB, b[i]), _mm256_andnot_ps(takeB, v));
+                a[i] = _mm256_or_ps(_mm256_and_ps(takeA, a[i]), _mm256_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m256 scale = _mm256_rsqrt_ps(sq);
+            scale = _mm256_mul_ps(scale, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(half, sq), _mm256_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm256_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Register k holds quaternion k in its low lane and k + 4 in its high lane, so after the in-lane transpose the
+    // lanes of each element are in order, and line up with t.
+    _XOINL _XO_TARGET_AVX void BlendQuaternionsEight(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m256 qa[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[0].xmm), a[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[1].xmm), a[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[2].xmm), a[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[3].xmm), a[7].xmm, 1)
+        };
+        __m256 qb[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[0].xmm), b[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[1].xmm), b[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[2].xmm), b[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[3].xmm), b[7].xmm, 1)
+        };
+        TransposeLanes4x4(qa);
+        TransposeLanes4x4(qb);
+        BlendEight(qa, qb, _mm256_loadu_ps(t), blend);
+        TransposeLanes4x4(qa);
+        out[0].xmm = _mm256_castps256_ps128(qa[0]);
+        out[1].xmm = _mm256_castps256_ps128(qa[1]);
+        out[2].xmm = _mm256_castps256_ps128(qa[2]);
+        out[3].xmm = _mm256_castps256_ps128(qa[3]);
+        out[4].xmm = _mm256_extractf128_ps(qa[0], 1);
+        out[5].xmm = _mm256_extractf128_ps(qa[1], 1);
+        out[6].xmm = _mm256_extractf128_ps(qa[2], 1);
+        out[7].xmm = _mm256_extractf128_ps(qa[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void BlendQuaternionBatchAVX(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            BlendQuaternionsEight(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            Quaternion ta[8], tb[8], tout[8];
+            float tt[8];
+            for (size_t j = 0; j < 8; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsEight(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX512 __m512 CrossQuad(__m512 a, __m512 b)
+    {
+        __m512 r = _mm512_sub_ps(_mm512_mul_ps(a, _mm512_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm512_mul_ps(b, _mm512_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm512_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 RotateQuad(__m512 q, __m512 v)
+    {
+        __m512 t = CrossQuad(q, v);
+        t = _mm512_add_ps(t, t);
+        return _mm512_add_ps(_mm512_add_ps(v, _mm512_mul_ps(t, _mm512_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossQuad(q, t));
+    }
+
+    // Sixteen vectors per pass. The last passes mask their loads and stores, so there's no scalar remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void RotateVector3BatchAVX512(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m512 v0 = RotateQuad(_mm512_loadu_ps(q[i].f), _mm512_loadu_ps(in[i].f));
+            __m512 v1 = RotateQuad(_mm512_loadu_ps(q[i+4].f), _mm512_loadu_ps(in[i+4].f));
+            __m512 v2 = RotateQuad(_mm512_loadu_ps(q[i+8].f), _mm512_loadu_ps(in[i+8].f));
+            __m512 v3 = RotateQuad(_mm512_loadu_ps(q[i+12].f), _mm512_loadu_ps(in[i+12].f));
+            _mm512_storeu_ps(out[i].f, v0);
+            _mm512_storeu_ps(out[i+4].f, v1);
+            _mm512_storeu_ps(out[i+8].f, v2);
+            _mm512_storeu_ps(out[i+12].f, v3);
+        }
+        for (; i < n; i += 4)
+        {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, RotateQuad(_mm512_maskz_loadu_ps(mask, q[i].f), _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
 }
-Vector2& Vector2::operator *= (double v)                  { return *this *= (float)v; }
-Vector2& Vector2::operator *= (int v)                     { return *this *= (float)v; }
-Vector2& Vector2::operator *= (const class Vector3& v)    { return *this *= Vector2(v); }
-Vector2& Vector2::operator *= (const class Vector4& v)    { return *this *= Vector2(v); }
+#endif
 
-Vector2& Vector2::operator /= (const Vector2& v) {
-    x /= v.x;
-    y /= v.y;
+_XOSRCINL const Quaternion& Quaternion::Rotate(const Vector3* in, Vector3* out, size_t n) const
+{
+    // Matrix3x4(const Quaternion&) rotates column vectors, as Rotate does.
+    Matrix4x4(Matrix3x4(*this)).TransformDirections(in, out, n);
     return *this;
 }
-Vector2& Vector2::operator /= (float v) {
-#if defined(XO_NO_INVERSE_DIVISION)
-    x /= v;
-    y /= v;
-    return *this;
+
+_XOSRCINL const Quaternion& Quaternion::Rotate(Vector3* inOut, size_t n) const
+{
+    return Rotate(inOut, inOut, n);
+}
+
+_XOSRCINL void Quaternion::RotateBatch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().rotateVector3Batch(q, in, out, n);
 #else
-    return (*this) *= (1.0f/v);
+    xo_internal::RotateVector3Batch(q, in, out, n);
 #endif
-    
 }
-Vector2& Vector2::operator /= (double v)                  { return *this /= (float)v; }
-Vector2& Vector2::operator /= (int v)                     { return *this /= (float)v; }
-Vector2& Vector2::operator /= (const class Vector3& v)    { return *this /= Vector2(v); }
-Vector2& Vector2::operator /= (const class Vector4& v)    { return *this /= Vector2(v); }
 
-Vector2 Vector2::operator + (const Vector2& v) const        { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (float v) const                 { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (double v) const                { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (int v) const                   { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (const class Vector3& v) const  { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (const class Vector4& v) const  { return Vector2(*this) += v; }
 
-Vector2 Vector2::operator - (const Vector2& v) const        { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (float v) const                 { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (double v) const                { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (int v) const                   { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (const class Vector3& v) const  { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (const class Vector4& v) const  { return Vector2(*this) -= v; }
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Random.cpp
 
-Vector2 Vector2::operator * (const Vector2& v) const        { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (float v) const                 { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (double v) const                { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (int v) const                   { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (const class Vector3& v) const  { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (const class Vector4& v) const  { return Vector2(*this) *= v; }
+_XOSRCINL Random Random::NewThreadEngine() {
+    static std::atomic<uint32_t> nextStream(0);
+    return Random(DefaultSeed, nextStream++);
+}
 
-Vector2 Vector2::operator / (const Vector2& v) const        { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (float v) const                 { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (double v) const                { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (int v) const                   { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (const class Vector3& v) const  { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (const class Vector4& v) const  { return Vector2(*this) /= v; }
 
-bool Vector2::operator < (const Vector2& v) const           { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector2::operator < (float v) const                    { return MagnitudeSquared() < (v * v); }
-bool Vector2::operator < (double v) const                   { return MagnitudeSquared() < (float)(v * v); }
-bool Vector2::operator < (int v) const                      { return MagnitudeSquared() < (float)(v * v); }
-bool Vector2::operator < (const class Vector3& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector2::operator < (const class Vector4& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Skinning.cpp
 
-bool Vector2::operator <= (const Vector2& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector2::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
-bool Vector2::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector2::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector2::operator <= (const class Vector3& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector2::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // The rows of the four bones of influence, blended by its weights into the rows of one affine matrix.
+    _XOINL void BlendBoneRows(const Vector4* palette, size_t boneStride, const Skinning::Influences& influence, __m128& r0, __m128& r1, __m128& r2) {
+        const Vector4* b0 = palette + influence.bones[0] * boneStride;
+        const Vector4* b1 = palette + influence.bones[1] * boneStride;
+        const Vector4* b2 = palette + influence.bones[2] * boneStride;
+        const Vector4* b3 = palette + influence.bones[3] * boneStride;
+        __m128 w = _mm_loadu_ps(influence.weights);
+        __m128 w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 w3 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[0].xmm, w0), _mm_mul_ps(b1[0].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[0].xmm, w2), _mm_mul_ps(b3[0].xmm, w3)));
+        r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[1].xmm, w0), _mm_mul_ps(b1[1].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[1].xmm, w2), _mm_mul_ps(b3[1].xmm, w3)));
+        r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[2].xmm, w0), _mm_mul_ps(b1[2].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[2].xmm, w2), _mm_mul_ps(b3[2].xmm, w3)));
+    }
+
+    // Skins vertex i. The position and normal are read before either output is written, so the outputs may be
+    // the inputs.
+    _XOINL void SkinVertex(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                           const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t i) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0, r1, r2;
+        BlendBoneRows(palette, boneStride, influences[i], r0, r1, r2);
+        __m128 p = _mm_or_ps(_mm_and_ps(positions[i].xmm, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+        if (normals) {
+            __m128 d = _mm_and_ps(normals[i].xmm, xyzMask);
+            outNormals[i].xmm = sse::AffineTransform(r0, r1, r2, d);
+        }
+        outPositions[i].xmm = sse::AffineTransform(r0, r1, r2, p);
+    }
+#endif
+
+    _XOSRCINL void SkinVertices(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        for (size_t i = 0; i < n; ++i) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 r[3];
+            for (int k = 0; k < 3; ++k) {
+                r[k] = palette[influence.bones[0] * boneStride + k] * influence.weights[0] +
+                       palette[influence.bones[1] * boneStride + k] * influence.weights[1] +
+                       palette[influence.bones[2] * boneStride + k] * influence.weights[2] +
+                       palette[influence.bones[3] * boneStride + k] * influence.weights[3];
+            }
+            Matrix3x4 m(r[0], r[1], r[2]);
+            if (normals) {
+                outNormals[i] = m.TransformDirection(normals[i]);
+            }
+            outPositions[i] = m.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row k of bones a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX __m256 BoneRowPair(const Vector4* a, const Vector4* b, int k) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(a[k].xmm), b[k].xmm, 1);
+    }
+
+    // BlendBoneRows for vertices a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX void BlendBoneRowsPair(const Vector4* palette, size_t boneStride, const Skinning::Influences& a, const Skinning::Influences& b,
+                                                 __m256& r0, __m256& r1, __m256& r2) {
+        const Vector4* a0 = palette + a.bones[0] * boneStride;
+        const Vector4* a1 = palette + a.bones[1] * boneStride;
+        const Vector4* a2 = palette + a.bones[2] * boneStride;
+        const Vector4* a3 = palette + a.bones[3] * boneStride;
+        const Vector4* b0 = palette + b.bones[0] * boneStride;
+        const Vector4* b1 = palette + b.bones[1] * boneStride;
+        const Vector4* b2 = palette + b.bones[2] * boneStride;
+        const Vector4* b3 = palette + b.bones[3] * boneStride;
+        __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a.weights)), _mm_loadu_ps(b.weights), 1);
+        __m256 w0 = _mm256_permute_ps(w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 w1 = _mm256_permute_ps(w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 w2 = _mm256_permute_ps(w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w3 = _mm256_permute_ps(w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 0), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 0), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 0), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 0), w3)));
+        r1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 1), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 1), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 1), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 1), w3)));
+        r2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 2), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 2), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 2), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 2), w3)));
+    }
+
+    // sse::AffineTransform, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 AffineTransformPair(__m256 r0, __m256 r1, __m256 r2, __m256 v) {
+        __m256 t[4] = { _mm256_mul_ps(r0, v), _mm256_mul_ps(r1, v), _mm256_mul_ps(r2, v), _mm256_setzero_ps() };
+        TransposeLanes4x4(t);
+        return _mm256_add_ps(_mm256_add_ps(t[0], t[1]), _mm256_add_ps(t[2], t[3]));
+    }
+
+    // Two vertices per pass, which are next to each other in each array, so their positions and normals are one
+    // load and store each.
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesAVX(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                                  const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        const __m256 one = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256 r0, r1, r2;
+            BlendBoneRowsPair(palette, boneStride, influences[i], influences[i + 1], r0, r1, r2);
+            // w of each position is replaced with 1, and of each normal with 0.
+            __m256 p = _mm256_blend_ps(_mm256_loadu_ps(positions[i].f), one, 0x88);
+            if (normals) {
+                __m256 d = _mm256_blend_ps(_mm256_loadu_ps(normals[i].f), _mm256_setzero_ps(), 0x88);
+                _mm256_storeu_ps(outNormals[i].f, AffineTransformPair(r0, r1, r2, d));
+            }
+            _mm256_storeu_ps(outPositions[i].f, AffineTransformPair(r0, r1, r2, p));
+        }
+        if (i < n) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+namespace xo_internal
+{
+    // Vertices are handed to threads this many at a time.
+    _XOSRCINL size_t SkinningChunkSize() {
+        return 4096;
+    }
+
+    // The bones, as rows of matrices boneStride apart, or as dual quaternions when dualQuaternions isn't null.
+    struct SkinPalette {
+        const Vector4* matrices;
+        size_t boneStride;
+        const DualQuaternion* dualQuaternions;
+    };
+
+    _XOSRCINL void SkinRange(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                             const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t begin, size_t end) {
+        if (begin >= end) {
+            return;
+        }
+        const Vector3* rangeNormals = normals ? normals + begin : nullptr;
+        Vector3* rangeOutNormals = normals ? outNormals + begin : nullptr;
+#if defined(XO_SSE2)
+        const DispatchKernels& kernels = GetDispatchKernels();
+        if (palette.dualQuaternions) {
+            kernels.skinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            kernels.skinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#else
+        if (palette.dualQuaternions) {
+            SkinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            SkinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#endif
+    }
+
+    _XOSRCINL void Skin(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                        const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+        // No more threads than there are cores, or than there are chunks.
+        const size_t chunk = SkinningChunkSize();
+        const size_t chunks = (n + chunk - 1) / chunk;
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores && threadCount > cores) {
+            threadCount = cores;
+        }
+        if (threadCount > chunks) {
+            threadCount = (unsigned)chunks;
+        }
+
+        if (threadCount <= 1) {
+            SkinRange(palette, influences, positions, normals, outPositions, outNormals, 0, n);
+            return;
+        }
+
+        // Each thread takes the next chunk until there are none left, so a thread that gets descheduled holds up
+        // one chunk rather than a whole share of the arrays.
+        std::atomic<size_t> next(0);
+        auto run = [&]() {
+            for (size_t begin = next.fetch_add(chunk, std::memory_order_relaxed); begin < n; begin = next.fetch_add(chunk, std::memory_order_relaxed)) {
+                SkinRange(palette, influences, positions, normals, outPositions, outNormals, begin, std::min(n, begin + chunk));
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run);
+        }
+        run();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+_XOSRCINL void Skinning::Skin(const Matrix3x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 3, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const Matrix4x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 4, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const DualQuaternion* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { nullptr, 0, palette };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// SSE.cpp
+
+#if defined(XO_SSE)
+namespace sse {
+
+    // A function static so that a header only build keeps one per thread, rather than one per translation unit.
+    _XOSRCINL volatile unsigned& LastKnownControlWord() {
+        static _XOTLS volatile unsigned controlWord = 0;
+        return controlWord;
+    }
+
+    _XOSRCINL void UpdateControlWord() {
+        LastKnownControlWord() = _mm_getcsr();
+    }
+
+    _XOSRCINL void SetControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() = control);
+    }
+
+    _XOSRCINL void SetControlWordAddative(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() |= control);
+    }
+
+    _XOSRCINL void RemoveControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() &= ~control);
+    }
+
+    _XOSRCINL bool HasControlFlagBeenSet(unsigned flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        if((LastKnownControlWord() & flags) == flags) {
+            if(thenFlush) {
+                RemoveControlWord(flags);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    _XOSRCINL bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet((unsigned)flags, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasInvalidOperationExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::InvalidOperation, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasDenormalExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::Denormal, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasDivideByZeroExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::DivideByZero, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasOverflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::Overflow, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasUnderflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::Underflow, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL bool HasPrecisionExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+        return HasControlFlagBeenSet(mxcsr::Flags::Precision, withUpdate, thenFlush);
+    }
+
+    _XOSRCINL void SetControlMask(unsigned mask, bool value, bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        if(value) {
+            SetControlWordAddative(mask);
+        }
+        else {
+            RemoveControlWord(mask);
+        }
+    }
+
+    _XOSRCINL void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate/*= false*/) {
+        SetControlMask((unsigned)mask, value, withUpdate);
+    }
+
+    _XOSRCINL bool GetControlMask(unsigned mask, bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        return (LastKnownControlWord() & mask) == mask;
+    }
+
+    _XOSRCINL bool GetControlMask(mxcsr::Masks mask, bool withUpdate/*= false*/) {
+        return GetControlMask((unsigned)mask, withUpdate);
+    }
+
+    _XOSRCINL void SetInvalidOperationExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::InvalidOperation, value, withUpdate);
+    }
+
+    _XOSRCINL void SetDenormalExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::Denormal, value, withUpdate);
+    }
+
+    _XOSRCINL void SetDivideByZeroExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::DivideByZero, value, withUpdate);
+    }
+
+    _XOSRCINL void SetOverflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::Overflow, value, withUpdate);
+    }
+
+    _XOSRCINL void SetUnderflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::Underflow, value, withUpdate);
+    }
+
+    _XOSRCINL void SetPrecisionExceptionMask(bool value, bool withUpdate/*= false*/) {
+        SetControlMask(mxcsr::Masks::Precision, value, withUpdate);
+    }
+
+    _XOSRCINL void ThrowAllExceptions(bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        SetInvalidOperationExceptionMask(false);
+        SetDenormalExceptionMask(false);
+        SetDivideByZeroExceptionMask(false);
+        SetOverflowExceptionMask(false);
+        SetUnderflowExceptionMask(false);
+        SetPrecisionExceptionMask(false);
+    }
+
+    _XOSRCINL void ThrowNoExceptions(bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        SetInvalidOperationExceptionMask(true);
+        SetDenormalExceptionMask(true);
+        SetDivideByZeroExceptionMask(true);
+        SetOverflowExceptionMask(true);
+        SetUnderflowExceptionMask(true);
+        SetPrecisionExceptionMask(true);
+    }
+
+    _XOSRCINL bool GetInvalidOperationExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::InvalidOperation, withUpdate);
+    }
+
+    _XOSRCINL bool GetDenormalExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::Denormal, withUpdate);
+    }
+
+    _XOSRCINL bool GetDivideByZeroExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::DivideByZero, withUpdate);
+    }
+
+    _XOSRCINL bool GetOverflowExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::Overflow, withUpdate);
+    }
+
+    _XOSRCINL bool GetUnderflowExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::Underflow, withUpdate);
+    }
+
+    _XOSRCINL bool GetPrecisionExceptionMask(bool withUpdate/*= false*/) {
+        return GetControlMask(mxcsr::Masks::Precision, withUpdate);
+    }
+
+    _XOSRCINL mxcsr::Rounding GetRoundingMode(bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        return (mxcsr::Rounding)(LastKnownControlWord() & (unsigned)mxcsr::Rounding::Bits);
+    }
+
+    _XOSRCINL void SetRoundingMode(unsigned mode, bool withUpdate/*= false*/) {
+        mode &= (unsigned)mxcsr::Rounding::Bits;
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        SetControlWordAddative(mode);
+    }
+
+    _XOSRCINL void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate/*= false*/) {
+        SetRoundingMode((unsigned)mode, withUpdate);
+    }
+
+    _XOSRCINL bool HasDenormalsAreZeroSet(bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        return (LastKnownControlWord() & (unsigned)mxcsr::DAZ::DenormalsAreZero) == (unsigned)mxcsr::DAZ::DenormalsAreZero;
+    }
+
+    _XOSRCINL void SetDenormalsAreZero(bool value, bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        if(value) {
+            SetControlWordAddative((unsigned)mxcsr::DAZ::DenormalsAreZero);
+        }
+        else {
+            RemoveControlWord((unsigned)mxcsr::DAZ::DenormalsAreZero);
+        }
+    }
+
+    _XOSRCINL bool HasFlushToZeroSet(bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        return (LastKnownControlWord() & (unsigned)mxcsr::FZ::FlushToZero) == (unsigned)mxcsr::FZ::FlushToZero;
+    }
+
+    _XOSRCINL void SetFlushToZero(bool value, bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        if(value) {
+            SetControlWordAddative((unsigned)mxcsr::FZ::FlushToZero);
+        }
+        else {
+            RemoveControlWord((unsigned)mxcsr::FZ::FlushToZero);
+        }
+    }
+
+    _XOSRCINL void GetAllMXCSRInfo(std::ostream& os, bool withUpdate/*= false*/) {
+        if(withUpdate) {
+            UpdateControlWord();
+        }
+        os << "MXCSR rounding:\n";
+        os << "\t";
+        switch(GetRoundingMode()) {
+            case mxcsr::Rounding::Nearest:
+                os << "Nearest";
+                break;
+            case mxcsr::Rounding::Positive:
+                os << "Positive";
+                break;
+            case mxcsr::Rounding::Negative:
+                os << "Negative";
+                break;
+            case mxcsr::Rounding::Zero:
+                os << "Zero";
+                break;
+        }
+        os << "\n";
+        os << "MXCSR masks:\n";
+        os << "\t" << "InvalidOperationException: " << GetInvalidOperationExceptionMask() << "\n"; 
+        os << "\t" << "DenormalException: " << GetDenormalExceptionMask() << "\n"; 
+        os << "\t" << "DivideByZeroException: " << GetDivideByZeroExceptionMask() << "\n"; 
+        os << "\t" << "OverflowException: " << GetOverflowExceptionMask() << "\n"; 
+        os << "\t" << "UnderflowException: " << GetUnderflowExceptionMask() << "\n"; 
+        os << "\t" << "PrecisionException: " << GetPrecisionExceptionMask() << "\n"; 
+        os << "\t" << "DenormalsAreZero: " << HasDenormalsAreZeroSet() << "\n";
+        os << "\t" << "FlushToZero: " << HasFlushToZeroSet() << "\n";
+        os << "MXCSR flags:\n";
+        os << "\t" << "InvalidOperationException: " << HasInvalidOperationExceptionOccured() << "\n"; 
+        os << "\t" << "DenormalException: " << HasDenormalExceptionOccured() << "\n"; 
+        os << "\t" << "DivideByZeroException: " << HasDivideByZeroExceptionOccured() << "\n"; 
+        os << "\t" << "OverflowException: " << HasOverflowExceptionOccured() << "\n"; 
+        os << "\t" << "UnderflowException: " << HasUnderflowExceptionOccured() << "\n"; 
+        os << "\t" << "PrecisionException: " << HasPrecisionExceptionOccured() << "\n";
+    }
+}
+#endif
 
-bool Vector2::operator > (const Vector2& v) const           { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector2::operator > (float v) const                    { return MagnitudeSquared() > (v * v); }
-bool Vector2::operator > (double v) const                   { return MagnitudeSquared() > (float)(v * v); }
-bool Vector2::operator > (int v) const                      { return MagnitudeSquared() > (float)(v * v); }
-bool Vector2::operator > (const class Vector3& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector2::operator > (const class Vector4& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
 
-bool Vector2::operator >= (const Vector2& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector2::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
-bool Vector2::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector2::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector2::operator >= (const class Vector3& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector2::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Transform.cpp
 
-bool Vector2::operator == (const Vector2& v) const {
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(x, v.x, Epsilon);
-}
-bool Vector2::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon); }
-bool Vector2::operator == (double v) const                  { return *this == (float)(v*v); }
-bool Vector2::operator == (int v) const                     { return *this == (float)(v*v); }
-bool Vector2::operator == (const class Vector3& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+_XOSRCDATA const Transform Transform::Identity;
+
+_XOSRCINL Transform::Transform() :
+    position(0.0f, 0.0f, 0.0f),
+    rotation(0.0f, 0.0f, 0.0f, 1.0f),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(0)
+{
+    // Both matrices of the identity are the identity, so they're written here rather than composed, and
+    // Transform::Identity can be read from any thread without updating anything.
+    matrix.r[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    matrix.r[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    matrix.r[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    inverseMatrix = matrix;
 }
-bool Vector2::operator == (const class Vector4& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation) :
+    position(position),
+    rotation(rotation),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(DirtyAll)
+{
 }
 
-bool Vector2::operator != (const Vector2& v) const          { return !((*this) == v); }
-bool Vector2::operator != (float v) const                   { return !((*this) == v); }
-bool Vector2::operator != (double v) const                  { return !((*this) == v); }
-bool Vector2::operator != (int v) const                     { return !((*this) == v); }
-bool Vector2::operator != (const class Vector3& v) const    { return !((*this) == v); }
-bool Vector2::operator != (const class Vector4& v) const    { return !((*this) == v); }
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale) :
+    position(position),
+    rotation(rotation),
+    scale(scale),
+    dirty(DirtyAll)
+{
+}
 
-_XOINL 
-Vector2 Abs(const Vector2& v)
+_XOSRCINL Transform::Transform(const Matrix3x4& m) :
+    position(m.GetTranslation()),
+    rotation(m),
+    scale(m.GetColumn(0).Magnitude(), m.GetColumn(1).Magnitude(), m.GetColumn(2).Magnitude()),
+    dirty(DirtyAll)
 {
-    return Vector2(Abs(v.x), Abs(v.y));
 }
 
-XOMATH_END_XO_NS();
+_XOSRCINL void Transform::UpdateMatrix() const {
+    ComposeMatrix(position, rotation, scale, matrix);
+    dirty &= ~DirtyMatrix;
+}
 
-XOMATH_BEGIN_XO_NS();
+_XOSRCINL void Transform::UpdateInverseMatrix() const {
+    ComposeInverseMatrix(position, rotation, scale, inverseMatrix);
+    dirty &= ~DirtyInverse;
+}
 
-#if defined(XO_SSE)
-Vector3::operator __m128() const {
-    return xmm;
+_XOSRCINL Vector3 Transform::TransformPoint(const Vector3& v) const {
+    return rotation.Rotate(v * scale) + position;
 }
-#endif
 
-float& Vector3::operator [](int i) {
-    return f[i];
+_XOSRCINL Vector3 Transform::TransformDirection(const Vector3& v) const {
+    return rotation.Rotate(v * scale);
 }
 
-const float& Vector3::operator [](int i) const {
-    return f[i];
+_XOSRCINL Vector3 Transform::InverseTransformPoint(const Vector3& v) const {
+    // Vector3 division may use the approximate reciprocal, which would leave the result off in the fourth digit.
+    Vector3 inverseScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    return rotation.Conjugate().Rotate(v - position) * inverseScale;
 }
 
-Vector3 Vector3::operator -() const {
-#if defined(XO_SSE)
-    return Vector3(_mm_mul_ps(xmm, sse::NegativeOne));
-#else
-    return Vector3(-x, -y, -z);
-#endif
+_XOSRCINL Transform& Transform::MakeInverse() {
+    rotation.MakeConjugate();
+    scale.Set(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    position = -(rotation.Rotate(position) * scale);
+    dirty = DirtyAll;
+    return *this;
 }
 
-Vector3 Vector3::operator ~() const {
-    return ZYX();
+_XOSRCINL Transform Transform::Inverse() const {
+    return Transform(*this).MakeInverse();
 }
 
-Vector3& Vector3::operator += (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, v);
-#else
-    x += v.x;
-    y += v.y;
-    z += v.z;
-#endif
-    return *this;
+_XOSRCINL void Transform::Combine(const Transform& parent, const Transform& child, Transform& outTransform) {
+    // outTransform may be either input, so nothing is written until everything is read.
+    Vector3 position = parent.TransformPoint(child.position);
+    Quaternion rotation = parent.rotation * child.rotation;
+    Vector3 scale = parent.scale * child.scale;
+    outTransform.Set(position, rotation, scale);
 }
 
-Vector3& Vector3::operator += (float v) {
-#if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
-#else
-    x += v;
-    y += v;
-    z += v;
-#endif
-    return *this;
+_XOSRCINL void Transform::ComposeMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    // The rotation of Matrix3x4(q), with each column multiplied by its scale.
+    outMatrix.r[0].Set((1.0f - (yy + zz)) * scale.x, (xy - wz) * scale.y,          (xz + wy) * scale.z,          position.x);
+    outMatrix.r[1].Set((xy + wz) * scale.x,          (1.0f - (xx + zz)) * scale.y, (yz - wx) * scale.z,          position.y);
+    outMatrix.r[2].Set((xz - wy) * scale.x,          (yz + wx) * scale.y,          (1.0f - (xx + yy)) * scale.z, position.z);
 }
 
-Vector3& Vector3::operator += (double v)                  { return (*this) += float(v); }
-Vector3& Vector3::operator += (int v)                     { return (*this) += float(v); }
-Vector3& Vector3::operator += (const class Vector2& v)    { return (*this) += Vector3(v); }
-Vector3& Vector3::operator += (const class Vector4& v)    { return (*this) += Vector3(v); }
+_XOSRCINL void Transform::ComposeInverseMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+    float sx = 1.0f / scale.x, sy = 1.0f / scale.y, sz = 1.0f / scale.z;
+
+    // The rows are the columns of the rotation, each divided by its scale.
+    Vector3 r0((1.0f - (yy + zz)) * sx, (xy + wz) * sx,          (xz - wy) * sx);
+    Vector3 r1((xy - wz) * sy,          (1.0f - (xx + zz)) * sy, (yz + wx) * sy);
+    Vector3 r2((xz + wy) * sz,          (yz - wx) * sz,          (1.0f - (xx + yy)) * sz);
+    outMatrix.r[0].Set(r0.x, r0.y, r0.z, -Vector3::Dot(r0, position));
+    outMatrix.r[1].Set(r1.x, r1.y, r1.z, -Vector3::Dot(r1, position));
+    outMatrix.r[2].Set(r2.x, r2.y, r2.z, -Vector3::Dot(r2, position));
+}
 
-Vector3& Vector3::operator -= (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, v);
-#else
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
-#endif
-    return *this;
+_XOSRCINL Transform Transform::Combine(const Transform& parent, const Transform& child) {
+    Transform t;
+    Combine(parent, child, t);
+    return t;
 }
 
-Vector3& Vector3::operator -= (float v) {
-#if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Trig.cpp
+
+namespace xo_internal
+{
+    // The baseline kernel behind the array versions. s or c may be null when that output isn't wanted.
+    // With SSE2 it goes four at a time, then the remainder is copied through a partial register so the tail gets 
+    // the exact same results as the rest.
+    _XOSRCINL void SinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+#if defined(XO_SSE2)
+        for (; i + 4 <= n; i += 4) {
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            _XOSIMDALIGN float t[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            _XOSIMDALIGN float ts[4];
+            _XOSIMDALIGN float tc[4];
+            size_t remaining = n - i;
+            for (size_t k = 0; k < remaining; ++k) {
+                t[k] = f[i + k];
+            }
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_load_ps(t), vs, vc, fast);
+            _mm_store_ps(ts, vs);
+            _mm_store_ps(tc, vc);
+            for (size_t k = 0; k < remaining; ++k) {
+                if (s) {
+                    s[i + k] = ts[k];
+                }
+                if (c) {
+                    c[i + k] = tc[k];
+                }
+            }
+        }
 #else
-    x -= v;
-    y -= v;
-    z -= v;
+        for (; i < n; ++i) {
+            float vs, vc;
+            if (fast) {
+                FastSinCos(f[i], vs, vc);
+            }
+            else {
+                SinCos(f[i], vs, vc);
+            }
+            if (s) {
+                s[i] = vs;
+            }
+            if (c) {
+                c[i] = vc;
+            }
+        }
 #endif
-    return *this;
-}
+    }
 
-Vector3& Vector3::operator -= (double v)                  { return (*this) -= float(v); }
-Vector3& Vector3::operator -= (int v)                     { return (*this) -= float(v); }
-Vector3& Vector3::operator -= (const class Vector2& v)    { return (*this) -= Vector3(v); }
-Vector3& Vector3::operator -= (const class Vector4& v)    { return (*this) -= Vector3(v); }
+#if defined(_XO_KERNELS_AVX2)
+    // Eight at a time, with a masked load and store for the last few.
+    _XOSRCINL _XO_TARGET_AVX2 void SinCosArrayAVX2(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm256_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm256_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            __m256i mask = TailMask(n - i);
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_maskload_ps(f + i, mask), vs, vc, fast);
+            if (s) {
+                _mm256_maskstore_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm256_maskstore_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
+    }
+#endif
 
-Vector3& Vector3::operator *= (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, v);
-#else
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
+#if defined(_XO_KERNELS_AVX512)
+    // Sixteen at a time. The last few use a mask register, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void SinCosArrayAVX512(const float* f, float* s, float* c, size_t n, bool fast) {
+        for (size_t i = 0; i < n; i += 16) {
+            __mmask16 mask = TailMask16(n - i);
+            __m512 vs, vc;
+            sse::SinCosKernel(_mm512_maskz_loadu_ps(mask, f + i), vs, vc, fast);
+            if (s) {
+                _mm512_mask_storeu_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm512_mask_storeu_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
+    }
 #endif
-    return *this;
 }
 
-Vector3& Vector3::operator *= (float v) {
-#if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+namespace xo_internal
+{
+    _XOSRCINL void DispatchSinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+#if defined(XO_SSE2)
+        xo_internal::GetDispatchKernels().sinCosArray(f, s, c, n, fast);
 #else
-    x *= v;
-    y *= v;
-    z *= v;
+        xo_internal::SinCosArray(f, s, c, n, fast);
 #endif
-    return *this;
+    }
 }
 
-Vector3& Vector3::operator *= (double v)                  { return (*this) *= float(v); }
-Vector3& Vector3::operator *= (int v)                     { return (*this) *= float(v); }
-Vector3& Vector3::operator *= (const class Vector2& v)    { return (*this) *= Vector3(v); }
-Vector3& Vector3::operator *= (const class Vector4& v)    { return (*this) *= Vector3(v); }
-
-#if defined(XO_NO_INVERSE_DIVISION)
-Vector3& Vector3::operator /= (const Vector3& v) {
-#if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+_XOSRCINL void Sin(const float* f, float* s, size_t n)                    { xo_internal::DispatchSinCosArray(f, s, nullptr, n, false); }
+_XOSRCINL void Cos(const float* f, float* c, size_t n)                    { xo_internal::DispatchSinCosArray(f, nullptr, c, n, false); }
+_XOSRCINL void SinCos(const float* f, float* s, float* c, size_t n)       { xo_internal::DispatchSinCosArray(f, s, c, n, false); }
+_XOSRCINL void FastSin(const float* f, float* s, size_t n)                { xo_internal::DispatchSinCosArray(f, s, nullptr, n, true); }
+_XOSRCINL void FastCos(const float* f, float* c, size_t n)                { xo_internal::DispatchSinCosArray(f, nullptr, c, n, true); }
+_XOSRCINL void FastSinCos(const float* f, float* s, float* c, size_t n)   { xo_internal::DispatchSinCosArray(f, s, c, n, true); }
 
-    // _mm_div_ps
-    // -----------------------------------
-    // Architecture    Latency Throughput
-    // Haswell         13      5
-    // Ivy Bridge      13      6
-    // Sandy Bridge    14      14
-    // Westmere        14      12
-    // Nehalem         14      12
-    xmm = _mm_div_ps(xmm, v);
-#else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-#endif
 
-    return *this;
-}
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Vector2.cpp
 
-Vector3& Vector3::operator /= (float v) {
-#   if defined(XO_SSE)
-    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
-#   else
-    x /= v;
-    y /= v;
-    z /= v;
-#   endif
-    return *this;
-}
-#else
+#if defined(_XONOCONSTEXPR)
+_XOSRCDATA const float Vector2::Epsilon = FloatEpsilon * 2.0f;
+#endif
 
-Vector3& Vector3::operator /= (const Vector3& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+_XOSRCDATA const Vector2 Vector2::UnitX(1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::UnitY(0.0f, 1.0f);
 
-    // _mm_rcp_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        1
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        3        2
-    // Nehalem         3        2
+_XOSRCDATA const Vector2 Vector2::Up(0.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Down(0.0f, -1.0f);
+_XOSRCDATA const Vector2 Vector2::Left(-1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::Right(1.0f, 0.0f);
 
-    // _mm_mul_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        0.5
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        4        1
-    // Nehalem         4        1
-    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v));
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-#   endif
+_XOSRCDATA const Vector2 Vector2::One(1.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Zero(0.0f, 0.0f);
 
-    return *this;
+_XOSRCINL Vector2::Vector2(float v) : x(v), y(v) {
 }
 
-Vector3& Vector3::operator /= (float v) { 
-#   if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
-#   else
-    v = 1.0f / v;
-    x *= v;
-    y *= v;
-    z *= v;
-#   endif
-    return *this;
+_XOSRCINL Vector2::Vector2(float x, float y) : x(x), y(y) {
 }
-#endif
-Vector3& Vector3::operator /= (double v)                    { return (*this) /= float(v); }
-Vector3& Vector3::operator /= (int v)                       { return (*this) /= float(v); }
-Vector3& Vector3::operator /= (const class Vector2& v)      { return (*this) /= Vector3(v); }
-Vector3& Vector3::operator /= (const class Vector4& v)      { return (*this) /= Vector3(v); }
-
-Vector3 Vector3::operator + (const Vector3& v) const        { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (float v) const                 { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (double v) const                { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (int v) const                   { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (const class Vector2& v) const  { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (const class Vector4& v) const  { return Vector3(*this) += v; }
-
-Vector3 Vector3::operator - (const Vector3& v) const        { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (float v) const                 { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (double v) const                { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (int v) const                   { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (const class Vector2& v) const  { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (const class Vector4& v) const  { return Vector3(*this) -= v; }
-
-Vector3 Vector3::operator * (const Vector3& v) const        { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (float v) const                 { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (double v) const                { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (int v) const                   { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (const class Vector2& v) const  { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (const class Vector4& v) const  { return Vector3(*this) *= v; }
 
-Vector3 Vector3::operator / (const Vector3& v) const        { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (float v) const                 { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (double v) const                { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (int v) const                   { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (const class Vector2& v) const  { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (const class Vector4& v) const  { return Vector3(*this) /= v; }
+_XOSRCINL Vector2::Vector2(const Vector2& v) : x(v.x), y(v.y) {
+}
 
+_XOSRCINL Vector2::Vector2(const class Vector3& v) : x(v.x), y(v.y) {
+}
 
-bool Vector3::operator < (const Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector3::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
-bool Vector3::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
-bool Vector3::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
-bool Vector3::operator < (const class Vector2& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector3::operator < (const class Vector4& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+_XOSRCINL Vector2::Vector2(const class Vector4& v) : x(v.x), y(v.y) {
+}
 
-bool Vector3::operator <= (const Vector3& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector3::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
-bool Vector3::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector3::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector3::operator <= (const class Vector2& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector3::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+_XOSRCINL Vector2& Vector2::Set(float x, float y) {
+    this->x = x;
+    this->y = y;
+    return *this;
+}
 
-bool Vector3::operator > (const Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector3::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
-bool Vector3::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
-bool Vector3::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
-bool Vector3::operator > (const class Vector2& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector3::operator > (const class Vector4& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+_XOSRCINL Vector2& Vector2::Set(float v) {
+    x = v;
+    y = v;
+    return *this;
+}
 
-bool Vector3::operator >= (const Vector3& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector3::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
-bool Vector3::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector3::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector3::operator >= (const class Vector2& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector3::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+_XOSRCINL Vector2& Vector2::Set(const Vector2& v) {
+    x = v.x;
+    y = v.y;
+    return *this;
+}
 
-bool Vector3::operator == (const Vector3& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v, xmm)), sse::Epsilon)) & 7) == 7;
-#   elif XO_SSE
-    // TODO: find a faster way with SSE to do a 'close enough' check.
-    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
-    // what we're doing in SSE2
-    return CloseEnough(x, v.x, sse::SSEFloatEpsilon) && CloseEnough(y, v.y, sse::SSEFloatEpsilon) && CloseEnough(z, v.z, sse::SSEFloatEpsilon);
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
-#   endif
+_XOSRCINL void Vector2::Get(float& x, float& y) const {
+    x = this->x;
+    y = this->y;
 }
-bool Vector3::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon);}
-bool Vector3::operator == (double v) const                  { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
-bool Vector3::operator == (int v) const                     { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
-bool Vector3::operator == (const class Vector2& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, v.y, v.x), xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+_XOSRCINL void Vector2::Get(float* f) const {
+    f[0] = this->x;
+    f[1] = this->y;
 }
-bool Vector3::operator == (const class Vector4& v) const {
+
+
+
+
+XOMATH_END_XO_NS();
+XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Vector3.cpp
+
+#if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+_XOSRCDATA const float Vector3::Epsilon = sse::SSEFloatEpsilon * 3.0f;
 #   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+_XOSRCDATA const float Vector3::Epsilon = FloatEpsilon * 3.0f;
 #   endif
-}
+#endif
 
-bool Vector3::operator != (const Vector3& v) const          { return !((*this) == v); }
-bool Vector3::operator != (float v) const                   { return !((*this) == v); }
-bool Vector3::operator != (double v) const                  { return !((*this) == v); }
-bool Vector3::operator != (int v) const                     { return !((*this) == v); }
-bool Vector3::operator != (const class Vector2& v) const    { return !((*this) == v); }
-bool Vector3::operator != (const class Vector4& v) const    { return !((*this) == v); }
+#if defined(XO_SSE2)
+_XOSRCDATA const __m128 Vector3::MASK = _mm_castsi128_ps(_mm_set_epi32(0, 0xffffffff, 0xffffffff, 0xffffffff));
+#elif defined(XO_SSE)
+_XOSRCDATA const __m128 Vector3::MASK = {-1, -1, -1, 0};
+#endif
 
-_XOINL
-Vector3 Abs(const Vector3& v)
-{
-#if defined(XO_SSE)
-    return (sse::Abs(v.xmm));
-#else
-    return Vector3(Abs(v.x), Abs(v.y), Abs(v.z));
+_XOSRCDATA const Vector3 Vector3::Origin(0.0f, 0.0f, 0.0f);
+
+_XOSRCDATA const Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitY(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitZ(0.0f, 0.0f, 1.0f);
+
+_XOSRCDATA const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
+
+#if defined(XO_SPACE_ZUP)
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, 0.0f, -1.0f);
+#elif defined(XO_SPACE_YUP)
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
 #endif
-}
 
-XOMATH_END_XO_NS();
+#if defined(XO_SPACE_LEFTHAND)
+#   if defined(XO_SPACE_ZUP)
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 1.0f, 0.0f);
+#   elif defined(XO_SPACE_YUP)
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
+#   endif
+#elif defined(XO_SPACE_RIGHTHAND)
+#   if defined(XO_SPACE_ZUP)
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, -1.0f, 0.0f);
+#   elif defined(XO_SPACE_YUP)
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, 1.0f);
+#   endif
+#endif
 
-XOMATH_BEGIN_XO_NS();
+_XOSRCDATA const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 
 #if defined(XO_SSE)
 
@@ -2019,539 +12270,1130 @@ XOMATH_BEGIN_XO_NS();
 
 #endif
 
+_XOSRCINL Vector3::Vector3(float f) :
 #if defined(XO_SSE)
-Vector4::operator const __m128&() const {
-    return xmm;
+    xmm(_mm_set1_ps(f))
+#elif defined(XO_NEON)
+    n(vdupq_n_f32(f))
+#else
+    x(f), y(f), z(f)
+#endif
+{
 }
+
+_XOSRCINL Vector3::Vector3(float x, float y, float z) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(0.0f, z, y, x))
+#else
+    x(x), y(y), z(z)
 #endif
+{
+}
 
-float& Vector4::operator [](int i) {
-    return f[i];
+_XOSRCINL Vector3::Vector3(const Vector3& vec) :
+#if defined(XO_SSE)
+    xmm(vec)
+#else
+    x(vec.x), y(vec.y), z(vec.z) 
+#endif
+{
 }
 
-const float& Vector4::operator [](int i) const {
-    return f[i];
+#if defined(XO_SSE)
+_XOSRCINL Vector3::Vector3(const __m128& vec) : 
+    xmm(vec)
+{
 }
+#endif
 
-Vector4 Vector4::operator -() const {
+_XOSRCINL Vector3::Vector3(const class Vector2& v) :
 #if defined(XO_SSE)
-    return Vector4(_mm_mul_ps(xmm, sse::NegativeOne));
+    xmm(_mm_set_ps(0.0f, 0.0f, v.y, v.x))
 #else
-    return Vector4(-x, -y, -z, -w);
+    x(v.x), y(v.y), z(0.0f)
 #endif
+{
 }
 
-Vector4 Vector4::operator ~() const {
+_XOSRCINL Vector3::Vector3(const class Vector4& v) :
 #if defined(XO_SSE)
-    return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_X, IDX_Y, IDX_Z, IDX_W)));
+    xmm(v.xmm)
 #else
-    return Vector4(w, z, y, x);
+    x(v.x), y(v.y), z(v.z)
 #endif
+{
 }
 
-Vector4& Vector4::operator += (const Vector4& v) {
+_XOSRCINL Vector3& Vector3::Set(float x, float y, float z) {
 #if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, v.xmm);
+    xmm = _mm_set_ps(0.0f, z, y, x);
 #else
-    x += v.x;
-    y += v.y;
-    z += v.z;
-    w += v.w;
+    this->x = x;
+    this->y = y;
+    this->z = z;
 #endif
     return *this;
 }
 
-Vector4& Vector4::operator += (float v) {
+_XOSRCINL Vector3& Vector3::Set(float f) {
 #if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+    xmm = _mm_set1_ps(f);
 #else
-    x += v;
-    y += v;
-    z += v;
-    w += v;
+    this->x = f;
+    this->y = f;
+    this->z = f;
 #endif
     return *this;
 }
 
-Vector4& Vector4::operator += (double v)          { return (*this) += (float)v; }
-Vector4& Vector4::operator += (int v)             { return (*this) += (float)v; }
-Vector4& Vector4::operator += (const class Vector2& v)  { return (*this) += Vector4(v); }
-Vector4& Vector4::operator += (const class Vector3& v)  { return (*this) += Vector4(v); }
-
-Vector4& Vector4::operator -= (const Vector4& v) {
+_XOSRCINL Vector3& Vector3::Set(const Vector3& vec) {
 #if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, v.xmm);
+    xmm = vec.xmm;
 #else
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
-    w -= v.w;
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = vec.z;
 #endif
     return *this;
 }
 
-Vector4& Vector4::operator -= (float v) {
 #if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
-#else
-    x -= v;
-    y -= v;
-    z -= v;
-    w -= v;
-#endif
+_XOSRCINL Vector3& Vector3::Set(const __m128& vec) {
+    xmm = vec;
     return *this;
 }
+#endif
 
-Vector4& Vector4::operator -= (double v)          { return (*this) -= (float)v; }
-Vector4& Vector4::operator -= (int v)             { return (*this) -= (float)v; }
-Vector4& Vector4::operator -= (const class Vector2& v)  { return (*this) -= Vector4(v); }
-Vector4& Vector4::operator -= (const class Vector3& v)  { return (*this) -= Vector4(v); }
+_XOSRCINL void Vector3::Get(float& x, float& y, float &z) const {
+    x = this->x;
+    y = this->y;
+    z = this->z;
+}
 
-Vector4& Vector4::operator *= (const Vector4& v) {
+_XOSRCINL void Vector3::Get(float* f) const {
 #if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, v.xmm);
+    _mm_store_ps(f, xmm);
+#elif defined(XO_NEON)
+    vst1q_f32(f, n);
 #else
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
-    w *= v.w;
+    f[0] = this->x;
+    f[1] = this->y;
+    f[2] = this->z;
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator *= (float v) {
+_XOSRCINL Vector3 Vector3::ZYX() const {
 #if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+    // todo: constexpr shuffle int
+    return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_W, IDX_X, IDX_Y, IDX_Z)));
 #else
-    x *= v;
-    y *= v;
-    z *= v;
-    w *= v;
+    return Vector3(z, y, x);
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator *= (double v)          { return (*this) *= (float)v; }
-Vector4& Vector4::operator *= (int v)             { return (*this) *= (float)v; }
-Vector4& Vector4::operator *= (const class Vector2& v)  { return (*this) *= Vector4(v); }
-Vector4& Vector4::operator *= (const class Vector3& v)  { return (*this) *= Vector4(v); }
+_XOSRCINL float Vector3::Sum() const {
+#if defined(XO_SSE3)
+    __m128 x = _mm_and_ps(xmm, MASK);
+    x = _mm_hadd_ps(x, x);
+    x = _mm_hadd_ps(x, x);
+    return _mm_cvtss_f32(x);
+#else
+    return x+y+z;
+#endif
+}
 
-#if defined(XO_NO_INVERSE_DIVISION)
-Vector4& Vector4::operator /= (const Vector4& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+_XOSRCINL Vector3& Vector3::Normalize() {
+    return (*this) /= Magnitude();
+}
 
-    // _mm_div_ps
-    // -----------------------------------
-    // Architecture    Latency Throughput
-    // Haswell         13      5
-    // Ivy Bridge      13      6
-    // Sandy Bridge    14      14
-    // Westmere        14      12
-    // Nehalem         14      12
-    xmm = _mm_div_ps(xmm, v.xmm);
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-    w /= v.w;
-#   endif
-    return *this;
+_XOSRCINL Vector3& Vector3::NormalizeSafe() {
+    float magnitude = MagnitudeSquared();
+    if (magnitude == 0.0f)
+        return *this;
+    return *this /= Sqrt(magnitude);
+}
+ 
+_XOSRCINL float Vector3::Dot(const Vector3& a, const Vector3& b) {
+#if defined(XO_SSE4_1)
+    return _mm_cvtss_f32(_mm_dp_ps(a, b, 0x7f));
+#else
+    return (a * b).Sum();
+#endif
+}
+
+namespace xo_internal
+{
+    _XOSRCINL void DotVector3Array(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = Vector3::Dot(a[i], b[i]);
+        }
+    }
+
+    _XOSRCINL void NormalizeVector3Array(const Vector3* in, Vector3* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = in[i].Normalized();
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // x, y and z of two vectors, with w cleared.
+    _XOINL _XO_TARGET_AVX __m256 MaskXYZPair(__m256 v) {
+        return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0)));
+    }
+
+    // p0 to p3 hold the products of eight vectors, two per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX __m256 SumXYZEight(__m256 p0, __m256 p1, __m256 p2, __m256 p3) {
+        // Each 128 bit lane sums on its own, the low lanes holding vectors 0, 2, 4 and 6 and the high lanes 1, 3, 5 
+        // and 7. Interleaving the halves puts them back in order.
+        __m256 h = _mm256_hadd_ps(_mm256_hadd_ps(MaskXYZPair(p0), MaskXYZPair(p1)), _mm256_hadd_ps(MaskXYZPair(p2), MaskXYZPair(p3)));
+        __m128 lo = _mm256_castps256_ps128(h);
+        __m128 hi = _mm256_extractf128_ps(h, 1);
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(lo, hi)), _mm_unpackhi_ps(lo, hi), 1);
+    }
+
+    // Two vectors divided by their magnitudes. The reciprocal square root is refined with a Newton-Raphson step.
+    _XOINL _XO_TARGET_AVX __m256 NormalizePair(__m256 v) {
+        __m256 sq = MaskXYZPair(_mm256_mul_ps(v, v));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m256 r = _mm256_rsqrt_ps(sq);
+        r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), sq), _mm256_mul_ps(r, r))));
+        return _mm256_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Eight vectors per pass, with masked loads and stores for the last few.
+    _XOSRCINL _XO_TARGET_AVX void DotVector3ArrayAVX(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(out + i, SumXYZEight(
+                _mm256_mul_ps(_mm256_loadu_ps(a[i].f), _mm256_loadu_ps(b[i].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+2].f), _mm256_loadu_ps(b[i+2].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+4].f), _mm256_loadu_ps(b[i+4].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+6].f), _mm256_loadu_ps(b[i+6].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m256 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 2 ? rest - k * 2 : 0;
+                __m256i mask = TailMask((count < 2 ? count : 2) * 4);
+                p[k] = _mm256_mul_ps(_mm256_maskload_ps(a[i].f + k * 8, mask), _mm256_maskload_ps(b[i].f + k * 8, mask));
+            }
+            _mm256_maskstore_ps(out + i, TailMask(rest), SumXYZEight(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void NormalizeVector3ArrayAVX(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, NormalizePair(v0));
+            _mm256_storeu_ps(out[i+2].f, NormalizePair(v1));
+            _mm256_storeu_ps(out[i+4].f, NormalizePair(v2));
+            _mm256_storeu_ps(out[i+6].f, NormalizePair(v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, NormalizePair(_mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, NormalizePair(_mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // The sum of x, y and z of each of four vectors, in all four elements of its 128 bit lane. w is ignored.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZQuad(__m512 p) {
+        p = _mm512_maskz_mov_ps(0x7777, p);
+        p = _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // p0 to p3 hold the products of sixteen vectors, four per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZSixteen(__m512 p0, __m512 p1, __m512 p2, __m512 p3) {
+        __m512 t = _mm512_mask_blend_ps(0x2222, SumXYZQuad(p0), SumXYZQuad(p1));
+        t = _mm512_mask_blend_ps(0x4444, t, SumXYZQuad(p2));
+        t = _mm512_mask_blend_ps(0x8888, t, SumXYZQuad(p3));
+        // Lane j of t now holds the sums of vectors j, 4+j, 8+j and 12+j.
+        return _mm512_permutexvar_ps(_mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15), t);
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 NormalizeQuad(__m512 v) {
+        __m512 sq = SumXYZQuad(_mm512_mul_ps(v, v));
+        __m512 r = _mm512_rsqrt14_ps(sq);
+        r = _mm512_mul_ps(r, _mm512_sub_ps(_mm512_set1_ps(1.5f), _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), sq), _mm512_mul_ps(r, r))));
+        return _mm512_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Sixteen vectors per pass. The last pass masks its loads and stores, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void DotVector3ArrayAVX512(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_ps(out + i, SumXYZSixteen(
+                _mm512_mul_ps(_mm512_loadu_ps(a[i].f), _mm512_loadu_ps(b[i].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+4].f), _mm512_loadu_ps(b[i+4].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+8].f), _mm512_loadu_ps(b[i+8].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+12].f), _mm512_loadu_ps(b[i+12].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m512 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 4 ? rest - k * 4 : 0;
+                __mmask16 mask = TailMask16(count * 4);
+                p[k] = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a[i].f + k * 16), _mm512_maskz_loadu_ps(mask, b[i].f + k * 16));
+            }
+            _mm512_mask_storeu_ps(out + i, TailMask16(rest), SumXYZSixteen(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void NormalizeVector3ArrayAVX512(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, NormalizeQuad(v0));
+            _mm512_storeu_ps(out[i+4].f, NormalizeQuad(v1));
+            _mm512_storeu_ps(out[i+8].f, NormalizeQuad(v2));
+            _mm512_storeu_ps(out[i+12].f, NormalizeQuad(v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, NormalizeQuad(_mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL void Vector3::Dot(const Vector3* a, const Vector3* b, float* outDots, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().dotVector3Array(a, b, outDots, n);
+#else
+    xo_internal::DotVector3Array(a, b, outDots, n);
+#endif
+}
+
+_XOSRCINL void Vector3::Normalize(const Vector3* in, Vector3* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().normalizeVector3Array(in, out, n);
+#else
+    xo_internal::NormalizeVector3Array(in, out, n);
+#endif
 }
 
-Vector4& Vector4::operator /= (float v) {
-#   if defined(XO_SSE)
-    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
-#   else
-    x /= v;
-    y /= v;
-    z /= v;
-    w /= v;
-#   endif
-    return *this;
+_XOSRCINL void Vector3::Normalize(Vector3* inOut, size_t n) {
+    Normalize(inOut, inOut, n);
 }
+ 
+_XOSRCINL void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
+#if defined(XO_SSE)
+    // todo: multi-compiler constexpr
+    constexpr int m3021 = _MM_SHUFFLE(3, 0, 2, 1);
+    __m128 result = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, m3021)), _mm_mul_ps(b, _mm_shuffle_ps(a, a, m3021)));
+    outVec.xmm = _mm_shuffle_ps(result, result, m3021);
 #else
+    outVec.x = (a.y*b.z)-(a.z*b.y);
+    outVec.y = (a.z*b.x)-(a.x*b.z);
+    outVec.z = (a.x*b.y)-(a.y*b.x);
+#endif
+}
 
-Vector4& Vector4::operator /= (const Vector4& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+_XOSRCINL void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
+    // Rodrigues' rotation formula
+    // https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
+    Vector3 axv;
+    float sinAng, cosAng;
+    SinCos(angle, sinAng, cosAng);
+    Vector3::Cross(axis, v, axv);
+    float adv = Vector3::Dot(axis, v);
+    outVec.Set(v * cosAng + axv * sinAng + axis * adv * (1.0f - cosAng));
+}
 
-    // _mm_rcp_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        1
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        3        2
-    // Nehalem         3        2
+_XOSRCINL float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
+    Vector3 cross;
+    Vector3::Cross(a, b, cross);
+    cross *= cross;
+    return ATan2(Sqrt(cross.Sum()), Vector3::Dot(a, b));
+}
 
-    // _mm_mul_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        0.5
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        4        1
-    // Nehalem         4        1
-    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v.xmm));
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-    w /= v.w;
+namespace xo_internal
+{
+    // A unit vector perpendicular to v, from crossing it with preferred. fallback is used when v is (nearly) parallel 
+    // to preferred.
+    _XOSRCINL Vector3 RandomBasisPerpendicular(const Vector3& v, const Vector3& preferred, const Vector3& fallback) {
+        Vector3 cross;
+        Vector3::Cross(v, preferred, cross);
+        if (cross.MagnitudeSquared() <= Vector3::Epsilon) {
+            Vector3::Cross(v, fallback, cross);
+        }
+        return cross.Normalized();
+    }
+
+#if defined(XO_SSE2)
+    // Shared loop for the array versions of the random methods. next returns the following four vectors, the last 
+    // of which may be partially stored.
+    template <typename NextFunc>
+    _XOSRCINL void FillRandomVector3s(Vector3* outVecs, size_t n, NextFunc next) {
+        Random_x4 rng(Random::ThreadEngine());
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            next(rng).Store(outVecs + i);
+        }
+        if (i < n) {
+            next(rng).StorePartial(outVecs + i, (int)(n - i));
+        }
+    }
+
+    _XOSRCINL __m128 RandomSelect(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Four directions uniform on the unit sphere. z is uniform in [-1, 1] along with an angle around z, which is 
+    // uniform over the sphere by Archimedes' hat-box theorem and unlike Marsaglia's method doesn't need to reject.
+    _XOSRCINL Vector3x4 RandomSphereDirections(Random_x4& rng) {
+        __m128 z = rng.Range(-1.0f, 1.0f);
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 r = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sse::One, _mm_mul_ps(z, z)), sse::Zero));
+        return Vector3x4(_mm_mul_ps(r, c), _mm_mul_ps(r, s), z);
+    }
+
+    // Cube root of each lane of x >= 0. Thirds the exponent through the bit pattern for an estimate within a few 
+    // percent, then refines it with three Newton steps.
+    _XOSRCINL __m128 RandomCbrt(__m128 x) {
+        const __m128 third = _mm_set1_ps(1.0f / 3.0f);
+        __m128i bits = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), third));
+        __m128 y = _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(0x2a5137a0)));
+        for (int i = 0; i < 3; ++i) {
+            y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), third);
+        }
+        return y;
+    }
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator /= (float v) { 
-#   if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
-#   else
-    v = 1.0f / v;
-    x *= v;
-    y *= v;
-    z *= v;
-    w *= v;
-#   endif
-    return *this;
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, rng.Range(0.0f, angle*0.5f), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), rng.Range(0.0f, TAU), outVec);
 }
-#endif
-Vector4& Vector4::operator /= (double v)          { return (*this) /= float(v); }
-Vector4& Vector4::operator /= (int v)             { return (*this) /= float(v); }
-Vector4& Vector4::operator /= (const class Vector2& v)  { return (*this) /= Vector4(v); }
-Vector4& Vector4::operator /= (const class Vector3& v)  { return (*this) /= Vector4(v); }
 
-Vector4 Vector4::operator + (const Vector4& v) const    { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (float v) const             { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (double v) const            { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (int v) const               { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (const class Vector2& v) const    { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (const class Vector3& v) const    { return Vector4(*this) += v; }
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, angle*0.5f, outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
+}
 
-Vector4 Vector4::operator - (const Vector4& v) const    { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (float v) const             { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (double v) const            { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (int v) const               { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (const class Vector2& v) const    { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (const class Vector3& v) const    { return Vector4(*this) -= v; }
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
+    // Marsaglia's method: https://projecteuclid.org/download/pdf_1/euclid.aoms/1177692644
+    Random& rng = Random::ThreadEngine();
+    float x1, x2, x12, x22;
+    do {
+        x1 = rng.Range(-1.0f, 1.0f);
+        x2 = rng.Range(-1.0f, 1.0f);
+        x12 = Square(x1);
+        x22 = Square(x2);
+    } while (x12 + x22 >= 1.0f);
+    float s = 2.0f * Sqrt(1.0f - x12 - x22);
+    outVec.Set(
+        x1 * s,
+        x2 * s,
+        1.0f - (2.0f * (x12 + x22))
+        );
+    outVec *= radius;
+}
 
-Vector4 Vector4::operator * (const Vector4& v) const    { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (float v) const             { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (double v) const            { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (int v) const               { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (const class Vector2& v) const    { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (const class Vector3& v) const    { return Vector4(*this) *= v; }
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    switch (rng.Range(0, 5)) {
+        case 0: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),                size);       break;
+        case 1: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),               -size);       break;
+        case 2: outVec.Set(rng.Range(-size, size),               size,          rng.Range(-size, size));  break;
+        case 3: outVec.Set(rng.Range(-size, size),              -size,          rng.Range(-size, size));  break;
+        case 4: outVec.Set(             size,           rng.Range(-size, size), rng.Range(-size, size));  break;
+        case 5: outVec.Set(            -size,           rng.Range(-size, size), rng.Range(-size, size));  break;
+    }
+}
 
-Vector4 Vector4::operator / (const Vector4& v) const    { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (float v) const             { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (double v) const            { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (int v) const               { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (const class Vector2& v) const    { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (const class Vector3& v) const    { return Vector4(*this) /= v; }
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), rng.Range(0.0f, TAU), outVec);
+    outVec *= Sqrt(rng.NextFloat()) * radius;
+}
 
-bool Vector4::operator < (const Vector4& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector4::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
-bool Vector4::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
-bool Vector4::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
-bool Vector4::operator < (const class Vector2& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector4::operator < (const class Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
+    outVec *= radius;
+}
 
-bool Vector4::operator <= (const Vector4& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector4::operator <= (float v) const               { return MagnitudeSquared() <= (v * v); }
-bool Vector4::operator <= (double v) const              { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector4::operator <= (int v) const                 { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector4::operator <= (const class Vector2& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector4::operator <= (const class Vector3& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // rotating a perpendicular a around up by t gives a*cos(t) + b*sin(t), where b is up cross a.
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a), b4(b);
+    const __m128 r = _mm_set1_ps(radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 scale = _mm_mul_ps(_mm_sqrt_ps(rng.NextFloat()), r);
+        return a4 * Vector4(_mm_mul_ps(c, scale)) + b4 * Vector4(_mm_mul_ps(s, scale));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
 
-bool Vector4::operator > (const Vector4& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector4::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
-bool Vector4::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
-bool Vector4::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
-bool Vector4::operator > (const class Vector2& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector4::operator > (const class Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a * radius), b4(b * radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        return a4 * Vector4(c) + b4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
 
-bool Vector4::operator >= (const Vector4& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector4::operator >= (float v) const               { return MagnitudeSquared() >= (v * v); }
-bool Vector4::operator >= (double v) const              { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector4::operator >= (int v) const                 { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector4::operator >= (const class Vector2& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector4::operator >= (const class Vector3& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Tilting forward by a toward p, then spinning it around forward by b gives:
+    // forward*cos(a) + p*sin(a)*cos(b) + q*sin(a)*sin(b), where p and q are perpendicular to forward.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    const Vector3x4 f4(forward), p4(p), q4(q);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sa, ca, sb, cb;
+        sse::SinCos(rng.Range(0.0f, halfAngle), sa, ca);
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 * Vector4(ca) + p4 * Vector4(_mm_mul_ps(sa, cb)) + q4 * Vector4(_mm_mul_ps(sa, sb));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
+}
 
-bool Vector4::operator == (const Vector4& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 15) == 15;
-#   elif XO_SSE
-    // TODO: find a faster way with SSE to do a 'close enough' check.
-    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
-    // what we're doing in SSE2
-    return 
-        CloseEnough(x, v.x, sse::SSEFloatEpsilon) && 
-        CloseEnough(y, v.y, sse::SSEFloatEpsilon) && 
-        CloseEnough(z, v.z, sse::SSEFloatEpsilon) &&
-        CloseEnough(w, v.w, sse::SSEFloatEpsilon);
-#   else
-    return 
-        CloseEnough(x, v.x, Epsilon) && 
-        CloseEnough(y, v.y, Epsilon) && 
-        CloseEnough(z, v.z, Epsilon) &&
-        CloseEnough(w, v.w, Epsilon);
-#   endif
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // The same as RandomInConeRadians, with the tilt fixed at the edge of the cone.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    float sa, ca;
+    SinCos(angle * 0.5f, sa, ca);
+    const Vector3x4 f4(forward * ca), p4(p * sa), q4(q * sa);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sb, cb;
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 + p4 * Vector4(cb) + q4 * Vector4(sb);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
 }
-bool Vector4::operator == (float v) const           { return CloseEnough(MagnitudeSquared(), v * v, Epsilon); }
-bool Vector4::operator == (double v) const          { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
-bool Vector4::operator == (int v) const             { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
 
-bool Vector4::operator == (const class Vector2& v) const {
-#   if defined(XO_SSE)
-    // Todo: check that this is actually faster.
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(xmm, _mm_set_ps(0.0f, 0.0f, v.y, v.x))), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+_XOSRCINL void Vector3::RandomInFanRadians(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Rodrigues' rotation formula, split into the parts scaled by 1, cos(t) and sin(t).
+    Vector3 along = up * Vector3::Dot(up, forward), side;
+    Vector3::Cross(up, forward, side);
+    const Vector3x4 along4(along), perp4(forward - along), side4(side);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(-halfAngle, halfAngle), s, c);
+        return along4 + perp4 * Vector4(c) + side4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInFanRadians(forward, up, angle, outVecs[i]);
+    }
+#endif
 }
 
-bool Vector4::operator == (const class Vector3& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
-#   endif
+_XOSRCINL void Vector3::RandomInCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 x = rng.Range(-size, size);
+        __m128 y = rng.Range(-size, size);
+        __m128 z = rng.Range(-size, size);
+        return Vector3x4(x, y, z);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCube(size, outVecs[i]);
+    }
+#endif
 }
 
-bool Vector4::operator != (const Vector4& v) const  { return !((*this) == v); }
-bool Vector4::operator != (float v) const           { return !((*this) == v); }
-bool Vector4::operator != (double v) const          { return !((*this) == v); }
-bool Vector4::operator != (int v) const             { return !((*this) == v); }
-bool Vector4::operator != (const class Vector2& v) const  { return !((*this) == v); }
-bool Vector4::operator != (const class Vector3& v) const  { return !((*this) == v); }
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Faces are numbered as in the single vector version: 0 and 1 are +z and -z, 2 and 3 are +y and -y, 
+    // 4 and 5 are +x and -x.
+    const __m128 sizeVec = _mm_set1_ps(size);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 face = _mm_mul_ps(rng.NextFloat(), _mm_set1_ps(6.0f));
+        __m128i faceIndex = _mm_cvttps_epi32(face);
+        __m128 side = _mm_xor_ps(sizeVec, _mm_castsi128_ps(_mm_slli_epi32(faceIndex, 31)));
+        __m128 zFace = _mm_cmplt_ps(face, _mm_set1_ps(2.0f));
+        __m128 xFace = _mm_cmpge_ps(face, _mm_set1_ps(4.0f));
+        __m128 yFace = _mm_andnot_ps(_mm_or_ps(xFace, zFace), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        __m128 u = rng.Range(-size, size);
+        __m128 v = rng.Range(-size, size);
+        return Vector3x4(
+            xo_internal::RandomSelect(xFace, side, u),
+            xo_internal::RandomSelect(yFace, side, xo_internal::RandomSelect(xFace, u, v)),
+            xo_internal::RandomSelect(zFace, side, v));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCube(size, outVecs[i]);
+    }
+#endif
+}
 
-_XOINL 
-Vector4 Abs(const Vector4& v)
-{
-#if defined(XO_SSE)
-    return (sse::Abs(v.xmm));
+_XOSRCINL void Vector3::RandomInSphere(float minRadius, float maxRadius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    const float minCubed = minRadius*minRadius*minRadius;
+    const float maxCubed = maxRadius*maxRadius*maxRadius;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 r = xo_internal::RandomCbrt(rng.Range(minCubed, maxCubed));
+        return xo_internal::RandomSphereDirections(rng) * Vector4(r);
+    });
 #else
-    return Vector4(Abs(v.x), Abs(v.y), Abs(v.z));
+    for (size_t i = 0; i < n; ++i) {
+        RandomInSphere(minRadius, maxRadius, outVecs[i]);
+    }
 #endif
 }
 
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        return xo_internal::RandomSphereDirections(rng) * radius;
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnSphere(radius, outVecs[i]);
+    }
+#endif
+}
+
+
 #undef IDX_X
 #undef IDX_Y
 #undef IDX_Z
 #undef IDX_W
 
-XOMATH_END_XO_NS();
 
+XOMATH_END_XO_NS();
 XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Vector3Array.cpp
 
-const Vector4& Matrix4x4::operator [](int i) const {
-    return r[i];
+_XOSRCINL void Pack(const Vector3* in, Float3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each store writes the w of in[i] over out[i + 1].x, which the next store then replaces. The last element's
+    // store would write past the end of out, so it's split into 8 and 4 bytes.
+    for (; i + 1 < n; ++i) {
+        _mm_storeu_ps(&out[i].x, in[i].xmm);
+    }
+    _mm_storel_pi((__m64*)&out[i].x, in[i].xmm);
+    _mm_store_ss(&out[i].z, _mm_movehl_ps(in[i].xmm, in[i].xmm));
+#else
+    for (; i < n; ++i) {
+        out[i] = Float3(in[i]);
+    }
+#endif
 }
 
-Vector4& Matrix4x4::operator [](int i) {
-    return r[i];
+_XOSRCINL void Unpack(const Float3* in, Vector3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each load takes x of the next element too, which is masked off. The last element's load would read past the
+    // end of in, so it's split into 8 and 4 bytes.
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    for (; i + 1 < n; ++i) {
+        out[i].xmm = _mm_and_ps(_mm_loadu_ps(&in[i].x), xyzMask);
+    }
+    out[i].xmm = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&in[i].x), _mm_load_ss(&in[i].z));
+#else
+    for (; i < n; ++i) {
+        out[i] = in[i];
+    }
+#endif
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four packed points are exactly three registers, which shuffle into the xs, ys and zs of all four.
+    _XOINL void LoadFloat3x4(const Float3* p, __m128& x, __m128& y, __m128& z) {
+        __m128 a = _mm_loadu_ps(&p[0].x); // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(&p[1].y); // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(&p[2].z); // z2 x3 y3 z3
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x4.
+    _XOINL void StoreFloat3x4(Float3* p, __m128 x, __m128 y, __m128 z) {
+        _mm_storeu_ps(&p[0].x, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[1].y, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[2].z, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    // Transforms four points per pass, as their xs, ys and zs from LoadFloat3x4. Every element of the matrix is
+    // broadcast before the loop, so a pass is nine multiplies and nine adds, with no shuffles between them. The
+    // last few points are done one at a time, adding in the same order so they round the same way.
+    _XOSRCINL void TransformFloat3Array(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        size_t i = 0;
+#if defined(XO_SSE)
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02), m03 = _mm_set1_ps(tx);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12), m13 = _mm_set1_ps(ty);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22), m23 = _mm_set1_ps(tz);
+        for (; i + 4 <= n; i += 4) {
+            __m128 x, y, z;
+            LoadFloat3x4(in + i, x, y, z);
+            StoreFloat3x4(out + i,
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), m03)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), m13)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), m23)));
+        }
+#endif
+        for (; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = ((m.m00 * x) + (m.m01 * y)) + ((m.m02 * z) + tx);
+            out[i].y = ((m.m10 * x) + (m.m11 * y)) + ((m.m12 * z) + ty);
+            out[i].z = ((m.m20 * x) + (m.m21 * y)) + ((m.m22 * z) + tz);
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // LoadFloat3x4 for eight points, four in each 128 bit lane. Eight points are 96 bytes, loaded as three registers
+    // and permuted so each lane holds the same three registers the SSE version loads, then shuffled the same way.
+    _XOINL _XO_TARGET_AVX void LoadFloat3x8(const Float3* p, __m256& x, __m256& y, __m256& z) {
+        __m256 m0 = _mm256_loadu_ps(&p[0].x);
+        __m256 m1 = _mm256_loadu_ps(&p[2].z);
+        __m256 m2 = _mm256_loadu_ps(&p[5].y);
+        __m256 a = _mm256_permute2f128_ps(m0, m1, 0x30);
+        __m256 b = _mm256_permute2f128_ps(m0, m2, 0x21);
+        __m256 c = _mm256_permute2f128_ps(m1, m2, 0x30);
+        x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x8.
+    _XOINL _XO_TARGET_AVX void StoreFloat3x8(Float3* p, __m256 x, __m256 y, __m256 z) {
+        __m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm256_storeu_ps(&p[0].x, _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(&p[2].z, _mm256_permute2f128_ps(a, c, 0x12));
+        _mm256_storeu_ps(&p[5].y, _mm256_permute2f128_ps(b, c, 0x31));
+    }
+
+    // TransformFloat3Array eight points at a time, leaving the last few to it.
+    _XOSRCINL _XO_TARGET_AVX void TransformFloat3ArrayAVX(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+        const __m256 m03 = _mm256_set1_ps(translate ? m.m03 : 0.0f);
+        const __m256 m13 = _mm256_set1_ps(translate ? m.m13 : 0.0f);
+        const __m256 m23 = _mm256_set1_ps(translate ? m.m23 : 0.0f);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 x, y, z;
+            LoadFloat3x8(in + i, x, y, z);
+            StoreFloat3x8(out + i,
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_add_ps(_mm256_mul_ps(m02, z), m03)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_add_ps(_mm256_mul_ps(m12, z), m13)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_add_ps(_mm256_mul_ps(m22, z), m23)));
+        }
+        _mm256_zeroupper();
+        TransformFloat3Array(m, in + i, out + i, n - i, translate);
+    }
+}
+#endif
+
+_XOSRCINL Vector3Array::Vector3Array() {
+}
+
+_XOSRCINL Vector3Array::Vector3Array(size_t n) :
+    elements(n)
+{
+}
+
+_XOSRCINL Vector3Array::Vector3Array(const Vector3* v, size_t n) :
+    elements(n)
+{
+    Pack(v, elements.data(), n);
 }
 
-const float& Matrix4x4::operator ()(int r, int c) const {
-    return this->r[r][c];
+_XOSRCINL void Vector3Array::Reserve(size_t n) {
+    elements.reserve(n);
 }
 
-float& Matrix4x4::operator ()(int r, int c) {
-    return this->r[r][c];
+_XOSRCINL void Vector3Array::Resize(size_t n) {
+    elements.resize(n);
 }
 
-Matrix4x4 Matrix4x4::operator ~() const {
-    auto m = *this;
-    return m.Transpose();
+_XOSRCINL void Vector3Array::Clear() {
+    elements.clear();
 }
 
-Matrix4x4& Matrix4x4::operator += (const Matrix4x4& m) {
-    r[0] += m[0];
-    r[1] += m[1];
-    r[2] += m[2];
-    r[3] += m[3];
-    return *this;
+_XOSRCINL void Vector3Array::Add(const Vector3& v) {
+    elements.push_back(Float3(v));
 }
 
-Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
-    r[0] -= m[0];
-    r[1] -= m[1];
-    r[2] -= m[2];
-    r[3] -= m[3];
-    return *this;
+_XOSRCINL void Vector3Array::Add(const Vector3* v, size_t n) {
+    size_t first = elements.size();
+    elements.resize(first + n);
+    Pack(v, elements.data() + first, n);
 }
 
-Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
-    auto t = m.Transposed();
-    return (*this) = Matrix4x4(
-        (r[0] * t[0]).Sum(), (r[0] * t[1]).Sum(), (r[0] * t[2]).Sum(), (r[0] * t[3]).Sum(),
-        (r[1] * t[0]).Sum(), (r[1] * t[1]).Sum(), (r[1] * t[2]).Sum(), (r[1] * t[3]).Sum(),
-        (r[2] * t[0]).Sum(), (r[2] * t[1]).Sum(), (r[2] * t[2]).Sum(), (r[2] * t[3]).Sum(),
-        (r[3] * t[0]).Sum(), (r[3] * t[1]).Sum(), (r[3] * t[2]).Sum(), (r[3] * t[3]).Sum()
-    );
+_XOSRCINL void Vector3Array::Get(size_t first, Vector3* out, size_t n) const {
+    Unpack(elements.data() + first, out, n);
 }
 
-Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
-Matrix4x4 Matrix4x4::operator - (const Matrix4x4& m) const { return Matrix4x4(*this) -= m; }
-Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const { return Matrix4x4(*this) *= m; }
+_XOSRCINL void Vector3Array::Set(size_t first, const Vector3* in, size_t n) {
+    Pack(in, elements.data() + first, n);
+}
 
-Vector4 Matrix4x4::operator * (const Vector4& v) const {
-    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), (r[3] * v).Sum());
+_XOSRCINL void Vector3Array::TransformPoints(const Matrix4x4& m) {
+    m.TransformPoints(elements.data(), elements.data(), elements.size());
 }
 
-Vector3 Matrix4x4::operator * (const Vector3& v) const {
-    return Vector3((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum());
+_XOSRCINL void Vector3Array::TransformDirections(const Matrix4x4& m) {
+    m.TransformDirections(elements.data(), elements.data(), elements.size());
 }
 
-XOMATH_END_XO_NS();
 
+XOMATH_END_XO_NS();
 XOMATH_BEGIN_XO_NS();
+////////////////////////////////////////////////////////////////////////// Vector4.cpp
 
-float& Quaternion::operator [](int i) { 
-  return f[i]; 
-}
+#if defined(_XONOCONSTEXPR)
+#   if defined(XO_SSE)
+_XOSRCDATA const float Vector4::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+#   else
+_XOSRCDATA const float Vector4::Epsilon = FloatEpsilon * 4.0f;
+#   endif
+#endif
 
-const float& Quaternion::operator [](int i) const { 
-  return f[i]; 
-}
+_XOSRCDATA const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
 
-Quaternion& Quaternion::operator *= (const Quaternion& q) {
-    // TODO: see if there's a cute intrinsic way to do this.
-    _XO_ASSIGN_QUAT(
-      w * q.x + x * q.w + y * q.z - z * q.y,
-      w * q.y - x * q.z + y * q.w + z * q.x,
-      w * q.z + x * q.y - y * q.x + z * q.w,
-      w * q.w - x * q.x - y * q.y - z * q.z);
-  return *this;
+_XOSRCDATA const Vector4 Vector4::UnitX(1.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitY(0.0f, 1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitZ(0.0f, 0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitW(0.0f, 0.0f, 0.0f, 1.0f);
+
+#define IDX_X 0
+#define IDX_Y 1
+#define IDX_Z 2
+#define IDX_W 3
+
+_XOSRCINL Vector4::Vector4() {
 }
 
-Quaternion Quaternion::operator * (const Quaternion& q) const {
-  return Quaternion(*this) *= q;
+_XOSRCINL Vector4::Vector4(float f) :
+#if defined(XO_SSE)
+    xmm(_mm_set1_ps(f))
+{
+}
+#else
+    x(f), y(f), z(f), w(f)
+{
 }
+#endif
 
-bool Quaternion::operator == (const Quaternion& q) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(q.xmm, xmm)), sse::Epsilon)) & 15) == 15;
-#   else
-    return 
-        CloseEnough(x, q.x, Epsilon) && 
-        CloseEnough(y, q.y, Epsilon) && 
-        CloseEnough(z, q.z, Epsilon) &&
-        CloseEnough(w, q.w, Epsilon);
-#   endif
+_XOSRCINL Vector4::Vector4(float x, float y, float z, float w) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(w, z, y, x))
+{
+}
+#else
+    x(x), y(y), z(z), w(w)
+{
+}
+#endif
+_XOSRCINL Vector4::Vector4(const Vector4& vec) :
+#if defined(XO_SSE)
+    xmm(vec.xmm)
+{
 }
+#else
+    x(vec.x), y(vec.y), z(vec.z), w(vec.w)
+{
+}
+#endif
 
-bool Quaternion::operator != (const Quaternion& q) const {
-  return !((*this) == q);
+
+#if defined(XO_SSE)
+_XOSRCINL Vector4::Vector4(const __m128& vec) : 
+    xmm(vec)
+{
 }
+#endif
 
-XOMATH_END_XO_NS();
+_XOSRCINL Vector4::Vector4(const class Vector2& vec) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(0.0f, 0.0f, vec.y, vec.x)) 
+{
+}
+#else
+    x(vec.x), y(vec.y), z(0.0f), w(0.0f)
+{
+}
+#endif
 
+_XOSRCINL Vector4::Vector4(const class Vector2& vec, float z, float w) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(w, z, vec.y, vec.x))
+{
+}
+#else
+    x(vec.x), y(vec.y), z(z), w(w)
+{
+}
+#endif
 
-XOMATH_BEGIN_XO_NS();
+_XOSRCINL Vector4::Vector4(const class Vector3& vec) :
+#if defined(XO_SSE)
+    xmm(vec.xmm)
+{
+}
+#else
+    x(vec.x), y(vec.y), z(vec.z), w(0.0f)
+{
+}
+#endif
 
+_XOSRCINL Vector4::Vector4(const class Vector3& vec, float w) :
 #if defined(XO_SSE)
+    xmm(vec.xmm)
+{
+    //! @todo there's likely an sse way to do this.
+    this->w = w;
+}
+#else
+    x(vec.x), y(vec.y), z(vec.z), w(w)
+{
+}
+#endif
 
-namespace sse {
+_XOSRCINL Vector4::Vector4(const class Quaternion& q) :
+#if defined(XO_SSE)
+    xmm(q.xmm)
+#else
+    x(q.x), y(q.y), z(q.z), w(q.w)
+#endif
+{
+}
 
-    // The control of MXCSR usage is inspired by Agner Fog's use of them in vectorclasses.
-    // vectorclasses uses them to optionally speed up subnormal operations.
-    // To achieve this in xomath, call the following once per thread where xo-math is used:
-    //      sse::UpdateControlWord();       // updates the thread-local state.
-    //      sse::SetDenormalsAreZero(true); // force all denormal values to 0
-    //      sse::SetFlushToZero(true);      // underflowing operations produce 0
-    // Note: this will only produce speed gains where subnormal values are likely to occur.
-    // See http://wm.ite.pl/articles/sse-penalties-of-errors.html for more details.
-    namespace mxcsr {
-        // Flags that are set on the CPU if an exception had occured.
-        // They will remain set until manually unset.
-        enum class Flags {
-            InvalidOperation                = (1 << 0),
-            Denormal                        = (1 << 1),
-            DivideByZero                    = (1 << 2),
-            Overflow                        = (1 << 3),
-            Underflow                       = (1 << 4),
-            Precision                       = (1 << 5),
-        };
+_XOSRCINL Vector4& Vector4::Set(float x, float y, float z, float w) {
+#if defined(XO_SSE)
+    xmm = _mm_set_ps(w, z, y, x);
+#else
+    this->x = x;
+    this->y = y;
+    this->z = z;
+    this->w = w;
+#endif
+    return *this;
+}
 
-        enum class DAZ {
-            DenormalsAreZero                = (1 << 6),
-        };
+_XOSRCINL Vector4& Vector4::Set(float f) {
+#if defined(XO_SSE)
+    xmm = _mm_set1_ps(f);
+#else
+    this->x = f;
+    this->y = f;
+    this->z = f;
+    this->w = w;
+#endif
+    return *this;
+}
 
-        enum class Masks {
-            InvalidOperation                = (1 << 7),
-            Denormal                        = (1 << 8),
-            DivideByZero                    = (1 << 9),
-            Overflow                        = (1 << 10),
-            Underflow                       = (1 << 11),
-            Precision                       = (1 << 12)
-        };
+_XOSRCINL Vector4& Vector4::Set(const Vector4& vec) {
+#if defined(XO_SSE)
+    xmm = vec.xmm;
+#else
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = vec.z;
+    this->w = vec.w;
+#endif
+    return *this;
+}
 
-        enum class Rounding {
-            Nearest                         = 0,
-            Negative                        = (1 << 13),
-            Positive                        = (1 << 14),
-            Zero                            = (1 << 13) | (1 << 14),
-            
-            Bits                            = (1 << 13) | (1 << 14)
-        };
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec) {
+#if defined(XO_SSE)
+    xmm = _mm_set_ps(0.0f, 0.0f, vec.y, vec.x);
+#else
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = 0.0f;
+    this->w = 0.0f;
+#endif
+    return *this;
+}
 
-        enum class FZ {
-            FlushToZero                     = (1 << 15)
-        };
-    }
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
+#if defined(XO_SSE)
+    xmm = _mm_set_ps(w, z, vec.y, vec.x);
+#else
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = z;
+    this->w = w;
+#endif
+    return *this;
+}
 
-    bool GetControlMask(mxcsr::Masks mask, bool withUpdate = false);
-    bool GetControlMask(unsigned mask, bool withUpdate = false);
-    bool GetDenormalExceptionMask(bool withUpdate = false);
-    bool GetDivideByZeroExceptionMask(bool withUpdate = false);
-    bool GetInvalidOperationExceptionMask(bool withUpdate = false);
-    bool GetOverflowExceptionMask(bool withUpdate = false);
-    bool GetPrecisionExceptionMask(bool withUpdate = false);
-    bool GetUnderflowExceptionMask(bool withUpdate = false);
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec) {
+#if defined(XO_SSE)
+    // TODO: mask with xmm, don't just break out w
+    this->xmm = vec.xmm;
+    this->w = 0.0f;
+#else
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = vec.z;
+    this->w = 0.0f;
+#endif
+    return *this;
+}
 
-    bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate = false, bool thenFlush = false);
-    bool HasControlFlagBeenSet(unsigned flags, bool withUpdate = false, bool thenFlush = false);
-    bool HasDenormalExceptionOccured(bool withUpdate = false, bool thenFlush = false);
-    bool HasDenormalsAreZeroSet(bool withUpdate = false);
-    bool HasDivideByZeroExceptionOccured(bool withUpdate = false, bool thenFlush = false);
-    bool HasFlushToZeroSet(bool withUpdate = false);
-    bool HasInvalidOperationExceptionOccured(bool withUpdate = false, bool thenFlush = false);
-    bool HasOverflowExceptionOccured(bool withUpdate = false, bool thenFlush = false);
-    bool HasPrecisionExceptionOccured(bool withUpdate = false, bool thenFlush = false);
-    bool HasUnderflowExceptionOccured(bool withUpdate = false, bool thenFlush = false);
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec, float w) {
+#if defined(XO_SSE)
+    // todo: consider masking here.
+    this->xmm = vec.xmm;
+    this->w = w;
+#else
+    this->x = vec.x;
+    this->y = vec.y;
+    this->z = vec.z;
+    this->w = w;
+#endif
+    return *this;
+}
 
-    mxcsr::Rounding GetRoundingMode(bool withUpdate = false);
-    void GetAllMXCSRInfo(std::ostream& os, bool withUpdate = false);
+#if defined(XO_SSE)
+_XOSRCINL Vector4& Vector4::Set(const __m128& vec) {
+    xmm = vec;
+    return *this;
+}
+#endif
 
-    void RemoveControlWord(unsigned control);
+_XOSRCINL void Vector4::Get(float& x, float& y, float& z, float& w) const {
+    x = this->x;
+    y = this->y;
+    z = this->z;
+    w = this->w;
+}
 
-    void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate = false);
-    void SetControlMask(unsigned mask, bool value, bool withUpdate = false);
-    void SetControlWord(unsigned control);
-    void SetControlWordAddative(unsigned control);
-    void SetDenormalExceptionMask(bool value, bool withUpdate = false);
-    void SetDenormalsAreZero(bool value, bool withUpdate = false);
-    void SetDivideByZeroExceptionMask(bool value, bool withUpdate = false);
-    void SetFlushToZero(bool value, bool withUpdate = false);
-    void SetInvalidOperationExceptionMask(bool value, bool withUpdate = false);
-    void SetOverflowExceptionMask(bool value, bool withUpdate = false);
-    void SetPrecisionExceptionMask(bool value, bool withUpdate = false);
-    void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate = false);
-    void SetRoundingMode(unsigned mode, bool withUpdate = false);
-    void SetUnderflowExceptionMask(bool value, bool withUpdate = false);
+_XOSRCINL void Vector4::Get(float* f) const {
+#if defined(XO_SSE)
+    _mm_store_ps(f, xmm);
+#else
+    f[0] = this->x;
+    f[1] = this->y;
+    f[2] = this->z;
+    f[3] = this->w;
+#endif
+}
+ 
+_XOSRCINL float Vector4::Sum() const {
+#if defined(XO_SSE3)
+    __m128 s = _mm_hadd_ps(xmm, xmm);
+    return _mm_cvtss_f32(_mm_hadd_ps(s, s));
+#else
+    return x+y+z+w;
+#endif
+}
 
-    void ThrowAllExceptions(bool withUpdate = false);
-    void ThrowNoExceptions(bool withUpdate = false);
-    void UpdateControlWord();
+_XOSRCINL Vector4& Vector4::NormalizeSafe() {
+    float magnitude = MagnitudeSquared();
+    if (magnitude == 0.0f)
+        return *this;
+    return *this /= Sqrt(magnitude);
 }
+
+_XOSRCINL float Vector4::Dot(const Vector4& a, const Vector4& b) {
+#if defined(XO_SSE4)
+    return _mm_cvtss_f32(_mm_dp_ps(a.xmm, b.xmm, 0xff));
+#else
+    return (a * b).Sum();
 #endif
+}
 
-XOMATH_END_XO_NS();
+#undef IDX_X
+#undef IDX_Y
+#undef IDX_Z
+#undef IDX_W
 
 
+XOMATH_END_XO_NS();
+// each source defines this for itself.
+#   undef _XO_MATH_OBJ
+#endif
+
 ////////////////////////////////////////////////////////////////////////// Remove internal macros
 
 #if defined(XO_REDEFINABLE)
@@ -2570,12 +13412,21 @@ XOMATH_END_XO_NS();
 
 #   undef _XOCONSTEXPR
 #   undef _XOINL
+#   undef _XOSRCINL
+#   undef _XOSRCDATA
 #   undef _XOTLS
 
-#   undef _XO_TLS_ENGINE
-#   undef _XO_TLS_DISTRIBUTION
+#   undef _XO_NO_TLS
+
+#   undef _XO_KERNELS_AVX
+#   undef _XO_KERNELS_AVX2
+#   undef _XO_KERNELS_AVX512
+#   undef _XO_TARGET_AVX
+#   undef _XO_TARGET_AVX2
+#   undef _XO_TARGET_AVX512
 
 #   undef _XO_OVERLOAD_NEW_DELETE
+#   undef _XO_OVERLOAD_NEW_DELETE_32
 
 #   undef _XO_MIN
 #   undef _XO_MAX
@@ -0,0 +1,617 @@
+// xo-bench: micro-benchmarks for the whole xo-math api.
+//
+// Build it like the test harness, with whatever simd level you want to measure:
+//   g++ -std=c++11 -O3 -Iinclude Bench.cpp src/*.cpp -o xo-bench -lpthread -msse4.2
+//   g++ -std=c++11 -O3 -Iinclude Bench.cpp src/*.cpp -o xo-bench -lpthread -mavx2 -mfma
+//   g++ -std=c++11 -O3 -Iinclude Bench.cpp src/*.cpp -o xo-bench -lpthread -U__SSE__ -U__SSE2__ -U__SSE3__ -U__SSSE3__ -U__SSE4_1__ -U__SSE4_2__
+// The last line builds the scalar fallback on x86-64, where the compiler can't be told to leave out sse.
+//
+// Usage:
+//   xo-bench [--filter text] [--json path] [--reps n] [--warmup n] [--ops n] [--max-tier sse2|avx|avx2|avx512]
+//   xo-bench --compare base.json current.json [--threshold 0.05]
+// The exit code is 1 when --compare finds a regression, so it can gate a build.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+using std::cout;
+using std::endl;
+
+#include "include/xo-math.h" // the development version of xo-math
+//#include "../xo-math.h" // the distribution version of xo-math
+
+using namespace xo;
+
+#include "xo-bench.h"
+
+// Inputs are filled once before any case runs. Every case reads element i of these, where i cycles through
+// the array, so results can't be folded into constants. The count is small enough to stay in L1 for most types.
+#define INPUT_COUNT 1024
+// Array cases process this many elements per call, and report per element.
+#define BATCH_COUNT 256
+// Hierarchy cases update this many nodes per call, and report per node.
+#define HIERARCHY_COUNT 4096
+// Skinning cases skin a mesh of this many vertices per call, and report per vertex. The mesh is far bigger than
+// the caches, like a real one, so these also measure streaming the vertices through memory.
+#define SKIN_VERTEX_COUNT 100000
+#define SKIN_BONE_COUNT 64
+
+namespace {
+    float float_a[INPUT_COUNT], float_b[INPUT_COUNT];
+    double double_a[INPUT_COUNT];
+    int int_a[INPUT_COUNT];
+    Vector2 Vector2_a[INPUT_COUNT], Vector2_b[INPUT_COUNT];
+    Vector3 Vector3_a[INPUT_COUNT], Vector3_b[INPUT_COUNT], Vector3_n[INPUT_COUNT];
+    Vector4 Vector4_a[INPUT_COUNT], Vector4_b[INPUT_COUNT];
+    Quaternion Quaternion_a[INPUT_COUNT], Quaternion_b[INPUT_COUNT];
+    DualQuaternion DualQuaternion_a[INPUT_COUNT], DualQuaternion_b[INPUT_COUNT];
+    Matrix4x4 Matrix4x4_a[INPUT_COUNT], Matrix4x4_b[INPUT_COUNT];
+    // affine, with the translation in the fourth column, for the structured inverses.
+    Matrix4x4 Matrix4x4_rigid[INPUT_COUNT], Matrix4x4_srt[INPUT_COUNT];
+    Matrix3x4 Matrix3x4_a[INPUT_COUNT], Matrix3x4_b[INPUT_COUNT];
+    Transform Transform_a[INPUT_COUNT], Transform_b[INPUT_COUNT];
+
+    Vector3 batchVector3[BATCH_COUNT], batchVector3Out[BATCH_COUNT];
+    Vector4 batchVector4[BATCH_COUNT], batchVector4Out[BATCH_COUNT];
+    Matrix4x4 batchMatrix[BATCH_COUNT], batchMatrixOut[BATCH_COUNT];
+    Quaternion batchQuaternionOut[BATCH_COUNT];
+    bool batchOk[BATCH_COUNT];
+    float batchFloat[BATCH_COUNT], batchT[BATCH_COUNT], batchSin[BATCH_COUNT], batchCos[BATCH_COUNT];
+    int batchIndices[BATCH_COUNT];
+
+    Hierarchy hierarchy;
+    int hierarchyLeaf;
+
+    Matrix3x4 skinPalette[SKIN_BONE_COUNT];
+    Matrix4x4 skinPalette4[SKIN_BONE_COUNT];
+    DualQuaternion skinPaletteDual[SKIN_BONE_COUNT];
+    std::vector<Skinning::Influences> skinInfluences;
+    xo::vector<Vector3> skinPositions, skinNormals, skinPositionsOut, skinNormalsOut;
+    // the skinned mesh's positions, stored at half precision.
+    std::vector<Half3> halfPositions;
+    std::vector<uint16_t> halfFloats;
+    // and packed as Float3s.
+    Vector3Array packedPositions;
+    std::vector<Float3> packedPositionsOut;
+
+    void FillInputs() {
+        Random random(1234);
+        for (int i = 0; i < INPUT_COUNT; ++i) {
+            // Away from zero, so the division and normalization cases don't hit denormals or infinities.
+            float_a[i] = random.Range(0.5f, 4.0f);
+            float_b[i] = random.Range(-4.0f, 4.0f);
+            double_a[i] = (double)random.Range(0.5f, 4.0f);
+            int_a[i] = random.Range(1, 8);
+            Vector2_a[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Vector2_b[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Vector3_a[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Vector3_b[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Vector3_n[i] = Vector3_a[i].Normalized();
+            Vector4_a[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Vector4_b[i].Set(random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f), random.Range(0.5f, 4.0f));
+            Quaternion_a[i] = Quaternion::AxisAngleRadians(Vector3_n[i], random.Range(-PI, PI));
+            Quaternion_b[i] = Quaternion::AxisAngleRadians(Vector3_b[i].Normalized(), random.Range(-PI, PI));
+            Matrix4x4_a[i] = Matrix4x4::RotationRadians(Vector3_a[i]) * Matrix4x4::Translation(Vector3_b[i]);
+            Matrix4x4_b[i] = Matrix4x4::Scale(Vector3_b[i]) * Matrix4x4::RotationRadians(Vector3_b[i]);
+            Matrix3x4_a[i] = Matrix3x4(Quaternion_a[i], Vector3_b[i]);
+            Matrix3x4_b[i] = Matrix3x4::Scale(Vector3_b[i]) * Matrix3x4(Quaternion_b[i], Vector3_a[i]);
+            Matrix4x4_rigid[i] = Matrix4x4(Matrix3x4_a[i]);
+            Matrix4x4_srt[i] = Matrix4x4(Matrix3x4_b[i]);
+            Transform_a[i].Set(Vector3_a[i], Quaternion_a[i], Vector3_b[i]);
+            Transform_b[i].Set(Vector3_b[i], Quaternion_b[i], Vector3(float_a[i]));
+            DualQuaternion_a[i] = DualQuaternion(Quaternion_a[i], Vector3_b[i]);
+            DualQuaternion_b[i] = DualQuaternion(Quaternion_b[i], Vector3_a[i]);
+        }
+        for (int i = 0; i < BATCH_COUNT; ++i) {
+            batchVector3[i] = Vector3_a[i];
+            batchVector4[i] = Vector4_a[i];
+            batchMatrix[i] = Matrix4x4_b[i];
+            batchFloat[i] = float_b[i];
+            batchT[i] = (float_a[i] - 0.5f) / 3.5f;
+            batchIndices[i] = random.Range(0, BATCH_COUNT - 1);
+        }
+        // Each node's parent is any node before it, which gives a bushy tree around ten levels deep.
+        hierarchy.Reserve(HIERARCHY_COUNT);
+        hierarchy.AddNode(Hierarchy::NoParent, Matrix4x4_a[0]);
+        for (int i = 1; i < HIERARCHY_COUNT; ++i) {
+            hierarchyLeaf = hierarchy.AddNode(random.Range(0, i - 1), Matrix4x4_a[i % INPUT_COUNT]);
+        }
+        for (int i = 0; i < SKIN_BONE_COUNT; ++i) {
+            skinPalette[i] = Matrix3x4_a[i];
+            skinPalette4[i] = Matrix4x4(Matrix3x4_a[i]);
+            skinPaletteDual[i] = DualQuaternion_a[i];
+        }
+        // Two to four bones per vertex, near each other in the palette as a real skeleton's would be.
+        skinInfluences.resize(SKIN_VERTEX_COUNT);
+        skinPositions.resize(SKIN_VERTEX_COUNT);
+        skinNormals.resize(SKIN_VERTEX_COUNT);
+        skinPositionsOut.resize(SKIN_VERTEX_COUNT);
+        skinNormalsOut.resize(SKIN_VERTEX_COUNT);
+        for (int i = 0; i < SKIN_VERTEX_COUNT; ++i) {
+            Skinning::Influences& influence = skinInfluences[i];
+            int bones = random.Range(2, 4);
+            int first = random.Range(0, SKIN_BONE_COUNT - 4);
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                influence.bones[k] = first + k;
+                influence.weights[k] = k < bones ? random.Range(0.1f, 1.0f) : 0.0f;
+                sum += influence.weights[k];
+            }
+            for (int k = 0; k < 4; ++k) {
+                influence.weights[k] /= sum;
+            }
+            skinPositions[i] = Vector3_a[i % INPUT_COUNT];
+            skinNormals[i] = Vector3_n[i % INPUT_COUNT];
+        }
+        halfPositions.resize(SKIN_VERTEX_COUNT);
+        halfFloats.resize(SKIN_VERTEX_COUNT * 4);
+        packedPositions.Add(skinPositions.data(), SKIN_VERTEX_COUNT);
+        packedPositionsOut.resize(SKIN_VERTEX_COUNT);
+    }
+}
+
+// Binary operators of T against each type it has an overload for.
+#define BENCH_OPERATOR(T, op, O1, O2) \
+    bench(#T " " #op " " #T,      [](size_t i) { return T##_a[i] op T##_b[i]; }); \
+    bench(#T " " #op " float",    [](size_t i) { return T##_a[i] op float_a[i]; }); \
+    bench(#T " " #op " double",   [](size_t i) { return T##_a[i] op double_a[i]; }); \
+    bench(#T " " #op " int",      [](size_t i) { return T##_a[i] op int_a[i]; }); \
+    bench(#T " " #op " " #O1,     [](size_t i) { return T##_a[i] op O1##_b[i]; }); \
+    bench(#T " " #op " " #O2,     [](size_t i) { return T##_a[i] op O2##_b[i]; })
+
+// Assignment operators, on a copy so the inputs stay the same from one repetition to the next.
+#define BENCH_ASSIGN(T, op, O1, O2) \
+    bench(#T " " #op " " #T,      [](size_t i) { T v = T##_a[i]; v op T##_b[i]; return v; }); \
+    bench(#T " " #op " float",    [](size_t i) { T v = T##_a[i]; v op float_a[i]; return v; }); \
+    bench(#T " " #op " double",   [](size_t i) { T v = T##_a[i]; v op double_a[i]; return v; }); \
+    bench(#T " " #op " int",      [](size_t i) { T v = T##_a[i]; v op int_a[i]; return v; }); \
+    bench(#T " " #op " " #O1,     [](size_t i) { T v = T##_a[i]; v op O1##_b[i]; return v; }); \
+    bench(#T " " #op " " #O2,     [](size_t i) { T v = T##_a[i]; v op O2##_b[i]; return v; })
+
+#define BENCH_VECTOR_OPERATORS(T, O1, O2) \
+    bench(#T " []",              [](size_t i) { return T##_a[i][int(i & 1)]; }); \
+    bench("-" #T,                 [](size_t i) { return -T##_a[i]; }); \
+    bench("~" #T,                 [](size_t i) { return ~T##_a[i]; }); \
+    BENCH_ASSIGN(T, +=, O1, O2); \
+    BENCH_ASSIGN(T, -=, O1, O2); \
+    BENCH_ASSIGN(T, *=, O1, O2); \
+    BENCH_ASSIGN(T, /=, O1, O2); \
+    BENCH_OPERATOR(T, +, O1, O2); \
+    BENCH_OPERATOR(T, -, O1, O2); \
+    BENCH_OPERATOR(T, *, O1, O2); \
+    BENCH_OPERATOR(T, /, O1, O2); \
+    BENCH_OPERATOR(T, <, O1, O2); \
+    BENCH_OPERATOR(T, <=, O1, O2); \
+    BENCH_OPERATOR(T, >, O1, O2); \
+    BENCH_OPERATOR(T, >=, O1, O2); \
+    BENCH_OPERATOR(T, ==, O1, O2); \
+    BENCH_OPERATOR(T, !=, O1, O2)
+
+// Static methods that write to an out parameter.
+#define BENCH_OUT(name, T, call) \
+    bench(name, [](size_t i) { T out; call; return out; })
+
+void BenchBaseline(Bench& bench) {
+    // The cost of the harness itself. Every other case includes about this much.
+    bench("(loop overhead)",                        [](size_t i) { return float_a[i]; });
+    bench("float * float",                          [](size_t i) { return float_a[i] * float_b[i]; });
+    bench("Sqrt",                                   [](size_t i) { return Sqrt(float_a[i]); });
+    bench("Sin",                                    [](size_t i) { return Sin(float_b[i]); });
+    bench("Cos",                                    [](size_t i) { return Cos(float_b[i]); });
+    bench("FastSin",                                [](size_t i) { return FastSin(float_b[i]); });
+    bench("RandomRange",                            [](size_t i) { return RandomRange(0.0f, float_a[i]); });
+}
+
+void BenchVector2(Bench& bench) {
+    BENCH_VECTOR_OPERATORS(Vector2, Vector3, Vector4);
+    bench("Vector2::Set",                           [](size_t i) { Vector2 v; return v.Set(float_a[i], float_b[i]); });
+    bench("Vector2::Get",                           [](size_t i) { float x, y; Vector2_a[i].Get(x, y); return x + y; });
+    bench("Vector2::IsNormalized",                  [](size_t i) { return Vector2_a[i].IsNormalized(); });
+    bench("Vector2::IsZero",                        [](size_t i) { return Vector2_a[i].IsZero(); });
+    bench("Vector2::Magnitude",                     [](size_t i) { return Vector2_a[i].Magnitude(); });
+    bench("Vector2::MagnitudeSquared",              [](size_t i) { return Vector2_a[i].MagnitudeSquared(); });
+    bench("Vector2::Sum",                           [](size_t i) { return Vector2_a[i].Sum(); });
+    bench("Vector2::Normalize",                     [](size_t i) { Vector2 v = Vector2_a[i]; return v.Normalize(); });
+    bench("Vector2::Normalized",                    [](size_t i) { return Vector2_a[i].Normalized(); });
+    bench("Vector2::Lerp",                          [](size_t i) { return Vector2::Lerp(Vector2_a[i], Vector2_b[i], 0.25f); });
+    bench("Vector2::Max",                           [](size_t i) { return Vector2::Max(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::Min",                           [](size_t i) { return Vector2::Min(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::Midpoint",                      [](size_t i) { return Vector2::Midpoint(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::OrthogonalCCW",                 [](size_t i) { return Vector2::OrthogonalCCW(Vector2_a[i]); });
+    bench("Vector2::OrthogonalCW",                  [](size_t i) { return Vector2::OrthogonalCW(Vector2_a[i]); });
+    bench("Vector2::AngleRadians",                  [](size_t i) { return Vector2::AngleRadians(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::Cross",                         [](size_t i) { return Vector2::Cross(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::Distance",                      [](size_t i) { return Vector2::Distance(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::DistanceSquared",               [](size_t i) { return Vector2::DistanceSquared(Vector2_a[i], Vector2_b[i]); });
+    bench("Vector2::Dot",                           [](size_t i) { return Vector2::Dot(Vector2_a[i], Vector2_b[i]); });
+}
+
+void BenchVector3(Bench& bench) {
+    BENCH_VECTOR_OPERATORS(Vector3, Vector2, Vector4);
+    bench("Vector3::Set",                           [](size_t i) { Vector3 v; return v.Set(float_a[i], float_b[i], float_a[i]); });
+    bench("Vector3::Get",                           [](size_t i) { float x, y, z; Vector3_a[i].Get(x, y, z); return x + y + z; });
+    bench("Vector3::IsNormalized",                  [](size_t i) { return Vector3_a[i].IsNormalized(); });
+    bench("Vector3::IsZero",                        [](size_t i) { return Vector3_a[i].IsZero(); });
+    bench("Vector3::Magnitude",                     [](size_t i) { return Vector3_a[i].Magnitude(); });
+    bench("Vector3::MagnitudeSquared",              [](size_t i) { return Vector3_a[i].MagnitudeSquared(); });
+    bench("Vector3::Sum",                           [](size_t i) { return Vector3_a[i].Sum(); });
+    bench("Vector3::Normalize",                     [](size_t i) { Vector3 v = Vector3_a[i]; return v.Normalize(); });
+    bench("Vector3::NormalizeSafe",                 [](size_t i) { Vector3 v = Vector3_a[i]; return v.NormalizeSafe(); });
+    bench("Vector3::Normalized",                    [](size_t i) { return Vector3_a[i].Normalized(); });
+    bench("Vector3::ZYX",                           [](size_t i) { return Vector3_a[i].ZYX(); });
+    bench("Vector3::Cross",                         [](size_t i) { return Vector3::Cross(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::Lerp",                          [](size_t i) { return Vector3::Lerp(Vector3_a[i], Vector3_b[i], 0.25f); });
+    bench("Vector3::Max",                           [](size_t i) { return Vector3::Max(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::Min",                           [](size_t i) { return Vector3::Min(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::RotateRadians",                 [](size_t i) { return Vector3::RotateRadians(Vector3_a[i], Vector3_n[i], float_b[i]); });
+    bench("Vector3::AngleRadians",                  [](size_t i) { return Vector3::AngleRadians(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::Distance",                      [](size_t i) { return Vector3::Distance(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::DistanceSquared",               [](size_t i) { return Vector3::DistanceSquared(Vector3_a[i], Vector3_b[i]); });
+    bench("Vector3::Dot",                           [](size_t i) { return Vector3::Dot(Vector3_a[i], Vector3_b[i]); });
+    BENCH_OUT("Vector3::RandomInCircle",            Vector3, Vector3::RandomInCircle(Vector3_n[i], 1.0f, out));
+    BENCH_OUT("Vector3::RandomInConeRadians",       Vector3, Vector3::RandomInConeRadians(Vector3_n[i], 0.5f, out));
+    BENCH_OUT("Vector3::RandomInCube",              Vector3, Vector3::RandomInCube(float_a[i], out));
+    BENCH_OUT("Vector3::RandomInFanRadians",        Vector3, Vector3::RandomInFanRadians(Vector3_n[i], Vector3::Up, 0.5f, out));
+    BENCH_OUT("Vector3::RandomInSphere",            Vector3, Vector3::RandomInSphere(0.5f, float_a[i], out));
+    BENCH_OUT("Vector3::RandomOnCircle",            Vector3, Vector3::RandomOnCircle(Vector3_n[i], 1.0f, out));
+    BENCH_OUT("Vector3::RandomOnConeRadians",       Vector3, Vector3::RandomOnConeRadians(Vector3_n[i], 0.5f, out));
+    BENCH_OUT("Vector3::RandomOnCube",              Vector3, Vector3::RandomOnCube(float_a[i], out));
+    BENCH_OUT("Vector3::RandomOnSphere",            Vector3, Vector3::RandomOnSphere(float_a[i], out));
+}
+
+void BenchVector4(Bench& bench) {
+    BENCH_VECTOR_OPERATORS(Vector4, Vector2, Vector3);
+    bench("Vector4::Set",                           [](size_t i) { Vector4 v; return v.Set(float_a[i], float_b[i], float_a[i], float_b[i]); });
+    bench("Vector4::Get",                           [](size_t i) { float x, y, z, w; Vector4_a[i].Get(x, y, z, w); return x + y + z + w; });
+    bench("Vector4::IsNormalized",                  [](size_t i) { return Vector4_a[i].IsNormalized(); });
+    bench("Vector4::IsZero",                        [](size_t i) { return Vector4_a[i].IsZero(); });
+    bench("Vector4::Magnitude",                     [](size_t i) { return Vector4_a[i].Magnitude(); });
+    bench("Vector4::MagnitudeSquared",              [](size_t i) { return Vector4_a[i].MagnitudeSquared(); });
+    bench("Vector4::Sum",                           [](size_t i) { return Vector4_a[i].Sum(); });
+    bench("Vector4::Normalize",                     [](size_t i) { Vector4 v = Vector4_a[i]; return v.Normalize(); });
+    bench("Vector4::NormalizeSafe",                 [](size_t i) { Vector4 v = Vector4_a[i]; return v.NormalizeSafe(); });
+    bench("Vector4::Normalized",                    [](size_t i) { return Vector4_a[i].Normalized(); });
+    bench("Vector4::Lerp",                          [](size_t i) { return Vector4::Lerp(Vector4_a[i], Vector4_b[i], 0.25f); });
+    bench("Vector4::Max",                           [](size_t i) { return Vector4::Max(Vector4_a[i], Vector4_b[i]); });
+    bench("Vector4::Min",                           [](size_t i) { return Vector4::Min(Vector4_a[i], Vector4_b[i]); });
+    bench("Vector4::Distance",                      [](size_t i) { return Vector4::Distance(Vector4_a[i], Vector4_b[i]); });
+    bench("Vector4::DistanceSquared",               [](size_t i) { return Vector4::DistanceSquared(Vector4_a[i], Vector4_b[i]); });
+    bench("Vector4::Dot",                           [](size_t i) { return Vector4::Dot(Vector4_a[i], Vector4_b[i]); });
+}
+
+void BenchQuaternion(Bench& bench) {
+    bench("Quaternion []",                         [](size_t i) { return Quaternion_a[i][int(i & 3)]; });
+    bench("Quaternion *= Quaternion",               [](size_t i) { Quaternion q = Quaternion_a[i]; q *= Quaternion_b[i]; return q; });
+    bench("Quaternion * Quaternion",                [](size_t i) { return Quaternion_a[i] * Quaternion_b[i]; });
+    bench("Quaternion == Quaternion",               [](size_t i) { return Quaternion_a[i] == Quaternion_b[i]; });
+    bench("Quaternion != Quaternion",               [](size_t i) { return Quaternion_a[i] != Quaternion_b[i]; });
+    bench("Quaternion(Matrix4x4)",                  [](size_t i) { return Quaternion(Matrix4x4_a[i]); });
+    bench("Quaternion::MakeConjugate",              [](size_t i) { Quaternion q = Quaternion_a[i]; return q.MakeConjugate(); });
+    bench("Quaternion::MakeInverse",                [](size_t i) { Quaternion q = Quaternion_a[i]; return q.MakeInverse(); });
+    bench("Quaternion::Normalize",                  [](size_t i) { Quaternion q = Quaternion_a[i]; return q.Normalize(); });
+    bench("Quaternion::Conjugate",                  [](size_t i) { return Quaternion_a[i].Conjugate(); });
+    bench("Quaternion::Inverse",                    [](size_t i) { return Quaternion_a[i].Inverse(); });
+    bench("Quaternion::Normalized",                 [](size_t i) { return Quaternion_a[i].Normalized(); });
+    bench("Quaternion::GetAxisAngleRadians",        [](size_t i) { Vector3 axis; float r; Quaternion_a[i].GetAxisAngleRadians(axis, r); return axis * r; });
+    bench("Quaternion::AxisAngleRadians",           [](size_t i) { return Quaternion::AxisAngleRadians(Vector3_n[i], float_b[i]); });
+    bench("Quaternion::Lerp",                       [](size_t i) { return Quaternion::Lerp(Quaternion_a[i], Quaternion_b[i], 0.25f); });
+    bench("Quaternion::Slerp",                      [](size_t i) { return Quaternion::Slerp(Quaternion_a[i], Quaternion_b[i], 0.25f); });
+    bench("Quaternion::Nlerp",                      [](size_t i) { return Quaternion::Nlerp(Quaternion_a[i], Quaternion_b[i], 0.25f); });
+    bench("Quaternion::FastSlerp",                  [](size_t i) { return Quaternion::FastSlerp(Quaternion_a[i], Quaternion_b[i], 0.25f); });
+    bench("Quaternion::LookAtFromDirection",        [](size_t i) { return Quaternion::LookAtFromDirection(Vector3_n[i], Vector3::Up); });
+    bench("Quaternion::LookAtFromPosition",         [](size_t i) { return Quaternion::LookAtFromPosition(Vector3_a[i], Vector3_b[i], Vector3::Up); });
+    bench("Quaternion::RotationRadians",            [](size_t i) { return Quaternion::RotationRadians(Vector3_a[i]); });
+    bench("Quaternion::Rotate",                     [](size_t i) { return Quaternion_a[i].Rotate(Vector3_b[i]); });
+    bench("Matrix3x4(Quaternion)::TransformDirection", [](size_t i) { return Matrix3x4(Quaternion_a[i]).TransformDirection(Vector3_b[i]); });
+}
+
+void BenchDualQuaternion(Bench& bench) {
+    bench("DualQuaternion(Quaternion, Vector3)",    [](size_t i) { return DualQuaternion(Quaternion_a[i], Vector3_b[i]).dual; });
+    bench("DualQuaternion(Matrix3x4)",              [](size_t i) { return DualQuaternion(Matrix3x4_a[i]).dual; });
+    bench("DualQuaternion * DualQuaternion",        [](size_t i) { return (DualQuaternion_a[i] * DualQuaternion_b[i]).dual; });
+    bench("Matrix3x4 * Matrix3x4 (rigid)",          [](size_t i) { return Matrix3x4_a[i] * Matrix3x4_a[(i + 1) % INPUT_COUNT]; });
+    bench("DualQuaternion::GetTranslation",         [](size_t i) { return DualQuaternion_a[i].GetTranslation(); });
+    bench("DualQuaternion::TransformPoint",         [](size_t i) { return DualQuaternion_a[i].TransformPoint(Vector3_b[i]); });
+    bench("DualQuaternion::Normalized",             [](size_t i) { return DualQuaternion_a[i].Normalized().dual; });
+    bench("DualQuaternion::Nlerp",                  [](size_t i) { return DualQuaternion::Nlerp(DualQuaternion_a[i], DualQuaternion_b[i], 0.25f).dual; });
+}
+
+void BenchMatrix4x4(Bench& bench) {
+    // SetRow and SetColumn are declared but not implemented yet.
+    bench("Matrix4x4 []",                          [](size_t i) { return Matrix4x4_a[i][int(i & 3)]; });
+    bench("Matrix4x4 ()",                          [](size_t i) { return Matrix4x4_a[i](int(i & 3), 2); });
+    bench("~Matrix4x4",                             [](size_t i) { return ~Matrix4x4_a[i]; });
+    bench("Matrix4x4 += Matrix4x4",                 [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; m += Matrix4x4_b[i]; return m; });
+    bench("Matrix4x4 -= Matrix4x4",                 [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; m -= Matrix4x4_b[i]; return m; });
+    bench("Matrix4x4 *= Matrix4x4",                 [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; m *= Matrix4x4_b[i]; return m; });
+    bench("Matrix4x4 + Matrix4x4",                  [](size_t i) { return Matrix4x4_a[i] + Matrix4x4_b[i]; });
+    bench("Matrix4x4 - Matrix4x4",                  [](size_t i) { return Matrix4x4_a[i] - Matrix4x4_b[i]; });
+    bench("Matrix4x4 * Matrix4x4",                  [](size_t i) { return Matrix4x4_a[i] * Matrix4x4_b[i]; });
+    bench("Matrix4x4 * Vector4",                    [](size_t i) { return Matrix4x4_a[i] * Vector4_a[i]; });
+    bench("Matrix4x4 * Vector3",                    [](size_t i) { return Matrix4x4_a[i] * Vector3_a[i]; });
+    bench("Matrix4x4(Quaternion)",                  [](size_t i) { return Matrix4x4(Quaternion_a[i]); });
+    bench("Matrix4x4::GetRow",                      [](size_t i) { return Matrix4x4_a[i].GetRow(int(i & 3)); });
+    bench("Matrix4x4::GetColumn",                   [](size_t i) { return Matrix4x4_a[i].GetColumn(int(i & 3)); });
+    bench("Matrix4x4::MakeInverse",                 [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; m.MakeInverse(); return m; });
+    bench("Matrix4x4::TryMakeInverse",              [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; return m.TryMakeInverse(); });
+    bench("Matrix4x4::MakeInverse (rigid)",         [](size_t i) { Matrix4x4 m = Matrix4x4_rigid[i]; m.MakeInverse(); return m; });
+    bench("Matrix4x4::InverseAffine",               [](size_t i) { return Matrix4x4_srt[i].InverseAffine(); });
+    bench("Matrix4x4::InverseScaleRotateTranslate", [](size_t i) { return Matrix4x4_srt[i].InverseScaleRotateTranslate(); });
+    bench("Matrix4x4::InverseRigid",                [](size_t i) { return Matrix4x4_rigid[i].InverseRigid(); });
+    bench("Matrix4x4::ClassifyInverse",             [](size_t i) { return Matrix4x4_srt[i].ClassifyInverse(); });
+    bench("Matrix4x4::ClassifyInverse (general)",   [](size_t i) { return Matrix4x4_a[i].ClassifyInverse(); });
+    bench("Matrix4x4::InverseAuto (rigid)",         [](size_t i) { return Matrix4x4_rigid[i].InverseAuto(); });
+    bench("Matrix4x4::InverseAuto (general)",       [](size_t i) { return Matrix4x4_a[i].InverseAuto(); });
+    bench("Matrix4x4::HasOrthonormalBasis",         [](size_t i) { return Matrix4x4_a[i].HasOrthonormalBasis(); });
+    bench("Matrix4x4::IsUnitary",                   [](size_t i) { return Matrix4x4_a[i].IsUnitary(); });
+    bench("Matrix4x4::Determinant",                 [](size_t i) { return Matrix4x4_a[i].Determinant(); });
+    bench("Matrix4x4::Transpose",                   [](size_t i) { Matrix4x4 m = Matrix4x4_a[i]; return m.Transpose(); });
+    bench("Matrix4x4::Transposed",                  [](size_t i) { return Matrix4x4_a[i].Transposed(); });
+    bench("Matrix4x4::Transform(Vector3)",          [](size_t i) { Vector3 v = Vector3_a[i]; Matrix4x4_a[i].Transform(v); return v; });
+    bench("Matrix4x4::Transform(Vector4)",          [](size_t i) { Vector4 v = Vector4_a[i]; Matrix4x4_a[i].Transform(v); return v; });
+    bench("Matrix4x4::Scale",                       [](size_t i) { return Matrix4x4::Scale(Vector3_a[i]); });
+    bench("Matrix4x4::Translation",                 [](size_t i) { return Matrix4x4::Translation(Vector3_a[i]); });
+    bench("Matrix4x4::RotationXRadians",            [](size_t i) { return Matrix4x4::RotationXRadians(float_b[i]); });
+    bench("Matrix4x4::RotationYRadians",            [](size_t i) { return Matrix4x4::RotationYRadians(float_b[i]); });
+    bench("Matrix4x4::RotationZRadians",            [](size_t i) { return Matrix4x4::RotationZRadians(float_b[i]); });
+    bench("Matrix4x4::RotationRadians",             [](size_t i) { return Matrix4x4::RotationRadians(Vector3_a[i]); });
+    bench("Matrix4x4::AxisAngleRadians",            [](size_t i) { return Matrix4x4::AxisAngleRadians(Vector3_n[i], float_b[i]); });
+    bench("Matrix4x4::OrthographicProjection",      [](size_t i) { return Matrix4x4::OrthographicProjection(float_a[i], float_a[i], 0.1f, 100.0f); });
+    bench("Matrix4x4::PerspectiveProjectionRadians",[](size_t i) { return Matrix4x4::PerspectiveProjectionRadians(float_a[i], float_a[i], 0.1f, 100.0f); });
+    bench("Matrix4x4::LookAtFromPosition",          [](size_t i) { return Matrix4x4::LookAtFromPosition(Vector3_a[i], Vector3_b[i], Vector3::Up); });
+    bench("Matrix4x4::LookAtFromDirection",         [](size_t i) { return Matrix4x4::LookAtFromDirection(Vector3_n[i], Vector3::Up); });
+}
+
+void BenchMatrix3x4(Bench& bench) {
+    // The affine counterparts of the Matrix4x4 cases above, to compare the two directly.
+    bench("Matrix3x4 *= Matrix3x4",                 [](size_t i) { Matrix3x4 m = Matrix3x4_a[i]; m *= Matrix3x4_b[i]; return m; });
+    bench("Matrix3x4 * Matrix3x4",                  [](size_t i) { return Matrix3x4_a[i] * Matrix3x4_b[i]; });
+    bench("Matrix3x4 * Vector4",                    [](size_t i) { return Matrix3x4_a[i] * Vector4_a[i]; });
+    bench("Matrix3x4(Quaternion)",                  [](size_t i) { return Matrix3x4(Quaternion_a[i]); });
+    bench("Matrix3x4(Matrix4x4)",                   [](size_t i) { return Matrix3x4(Matrix4x4_a[i]); });
+    bench("Quaternion(Matrix3x4)",                  [](size_t i) { return Quaternion(Matrix3x4_a[i]); });
+    bench("Matrix3x4::TransformPoint",              [](size_t i) { return Matrix3x4_a[i].TransformPoint(Vector3_a[i]); });
+    bench("Matrix3x4::TransformDirection",          [](size_t i) { return Matrix3x4_a[i].TransformDirection(Vector3_a[i]); });
+    bench("Matrix3x4::Determinant",                 [](size_t i) { return Matrix3x4_a[i].Determinant(); });
+    bench("Matrix3x4::MakeInverse",                 [](size_t i) { Matrix3x4 m = Matrix3x4_b[i]; m.MakeInverse(); return m; });
+    bench("Matrix3x4::TryMakeInverse",              [](size_t i) { Matrix3x4 m = Matrix3x4_b[i]; return m.TryMakeInverse(); });
+}
+
+void BenchTransform(Bench& bench) {
+    // The first case is what Transform replaces: three matrices built and multiplied every time.
+    bench("Matrix4x4 T * R * S",                    [](size_t i) { return Matrix4x4::Translation(Vector3_a[i]) * Matrix4x4(Quaternion_a[i]) * Matrix4x4::Scale(Vector3_b[i]); });
+    bench("Transform::ComposeMatrix",               [](size_t i) { Matrix3x4 m; Transform::ComposeMatrix(Vector3_a[i], Quaternion_a[i], Vector3_b[i], m); return m; });
+    bench("Transform::ComposeInverseMatrix",        [](size_t i) { Matrix3x4 m; Transform::ComposeInverseMatrix(Vector3_a[i], Quaternion_a[i], Vector3_b[i], m); return m; });
+    bench("Transform::GetMatrix (clean)",           [](size_t i) { return Transform_a[i].GetMatrix(); });
+    bench("Transform::SetPosition, GetMatrix",      [](size_t i) { return Transform_a[i].SetPosition(Vector3_b[i]).GetMatrix(); });
+    bench("Transform::SetRotation, GetMatrix",      [](size_t i) { return Transform_a[i].SetRotation(Quaternion_b[i]).GetMatrix(); });
+    bench("Transform::TransformPoint",              [](size_t i) { return Transform_a[i].TransformPoint(Vector3_b[i]); });
+    bench("Transform::Combine",                     [](size_t i) { return Transform::Combine(Transform_b[i], Transform_a[i]); });
+    bench("Transform::Inverse",                     [](size_t i) { return Transform_b[i].Inverse(); });
+}
+
+void BenchArrays(Bench& bench) {
+    // Each call runs the whole batch, so these report per element.
+    bench("[] Vector3::Dot",                        [](size_t) { Vector3::Dot(batchVector3, batchVector3Out, batchSin, BATCH_COUNT); return batchSin[0]; }, BATCH_COUNT);
+    bench("[] Vector3::Normalize",                  [](size_t) { Vector3::Normalize(batchVector3, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Vector3::RandomOnSphere",             [](size_t) { Vector3::RandomOnSphere(1.0f, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Vector3::RandomInConeRadians",        [](size_t) { Vector3::RandomInConeRadians(Vector3::Up, 0.5f, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::TransformPoints",          [](size_t i) { Matrix4x4_a[i].TransformPoints(batchVector3, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::TransformDirections",      [](size_t i) { Matrix4x4_a[i].TransformDirections(batchVector3, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::Rotate",                  [](size_t i) { Quaternion_a[i].Rotate(batchVector3, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::RotateBatch",             [](size_t) { Quaternion::RotateBatch(Quaternion_a, batchVector3, batchVector3Out, BATCH_COUNT); return batchVector3Out[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::Slerp",                   [](size_t) { for (int j = 0; j < BATCH_COUNT; ++j) { batchQuaternionOut[j] = Quaternion::Slerp(Quaternion_a[j], Quaternion_b[j], batchT[j]); } return batchQuaternionOut[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::SlerpBatch",              [](size_t) { Quaternion::SlerpBatch(Quaternion_a, Quaternion_b, batchT, batchQuaternionOut, BATCH_COUNT); return batchQuaternionOut[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::NlerpBatch",              [](size_t) { Quaternion::NlerpBatch(Quaternion_a, Quaternion_b, batchT, batchQuaternionOut, BATCH_COUNT); return batchQuaternionOut[0]; }, BATCH_COUNT);
+    bench("[] Quaternion::FastSlerpBatch",          [](size_t) { Quaternion::FastSlerpBatch(Quaternion_a, Quaternion_b, batchT, batchQuaternionOut, BATCH_COUNT); return batchQuaternionOut[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::TransformVector4s",        [](size_t i) { Matrix4x4_a[i].TransformVector4s(batchVector4, batchVector4Out, BATCH_COUNT); return batchVector4Out[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::MultiplyBatch",            [](size_t) { Matrix4x4::MultiplyBatch(Matrix4x4_a, batchMatrix, batchMatrixOut, BATCH_COUNT); return batchMatrixOut[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::MakeInverse",              [](size_t) { for (int j = 0; j < BATCH_COUNT; ++j) { batchMatrixOut[j] = batchMatrix[j]; batchMatrixOut[j].MakeInverse(); } return batchMatrixOut[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::InverseBatch",             [](size_t) { Matrix4x4::InverseBatch(batchMatrix, batchMatrixOut, batchOk, BATCH_COUNT); return batchMatrixOut[0]; }, BATCH_COUNT);
+    bench("[] Matrix4x4::MultiplyBatch indexed",    [](size_t) { Matrix4x4::MultiplyBatch(Matrix4x4_a, batchIndices, batchMatrix, batchMatrixOut, BATCH_COUNT); return batchMatrixOut[0]; }, BATCH_COUNT);
+    bench("[] Sin",                                 [](size_t) { Sin(batchFloat, batchSin, BATCH_COUNT); return batchSin[0]; }, BATCH_COUNT);
+    bench("[] SinCos",                              [](size_t) { SinCos(batchFloat, batchSin, batchCos, BATCH_COUNT); return batchSin[0]; }, BATCH_COUNT);
+    bench("[] FastSinCos",                          [](size_t) { FastSinCos(batchFloat, batchSin, batchCos, BATCH_COUNT); return batchSin[0]; }, BATCH_COUNT);
+}
+
+void BenchHierarchy(Bench& bench) {
+    // The full cases change the root, so every node is recomputed. The leaf case is the incremental update, which
+    // reports per call rather than per node.
+    bench("[] Hierarchy::UpdateWorld (all)",        [](size_t i) { hierarchy.SetLocal(0, Matrix4x4_a[i]); hierarchy.UpdateWorld(); return hierarchy.GetWorld(0); }, HIERARCHY_COUNT);
+    bench("[] Hierarchy::UpdateWorld (all, threads)", [](size_t i) { hierarchy.SetLocal(0, Matrix4x4_a[i]); hierarchy.UpdateWorld(std::thread::hardware_concurrency()); return hierarchy.GetWorld(0); }, HIERARCHY_COUNT);
+    bench("Hierarchy::UpdateWorld (one leaf)",      [](size_t i) { hierarchy.SetLocal(hierarchyLeaf, Matrix4x4_a[i]); hierarchy.UpdateWorld(); return hierarchy.GetWorld(hierarchyLeaf); });
+}
+
+void BenchSkinning(Bench& bench) {
+    // A call skins the whole mesh, so far fewer calls are needed for a steady time.
+    Bench::Options& options = bench.GetOptions();
+    const size_t ops = options.opsPerRepetition;
+    options.opsPerRepetition = std::max<size_t>(1, ops / 512);
+    // How skinning is often written: each bone's Matrix4x4 transforms the vertex, and the results are weighted.
+    bench("[] Matrix4x4 * Vector4 per bone (skin)", [](size_t) {
+        for (int i = 0; i < SKIN_VERTEX_COUNT; ++i) {
+            const Skinning::Influences& influence = skinInfluences[i];
+            Vector4 p(skinPositions[i], 1.0f), n(skinNormals[i], 0.0f);
+            Vector4 sp(0.0f), sn(0.0f);
+            for (int k = 0; k < 4; ++k) {
+                sp += (skinPalette4[influence.bones[k]] * p) * influence.weights[k];
+                sn += (skinPalette4[influence.bones[k]] * n) * influence.weights[k];
+            }
+            skinPositionsOut[i] = Vector3(sp);
+            skinNormalsOut[i] = Vector3(sn);
+        }
+        return skinPositionsOut[0];
+    }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin",                      [](size_t) { Skinning::Skin(skinPalette, skinInfluences.data(), skinPositions.data(), skinNormals.data(), skinPositionsOut.data(), skinNormalsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin (Matrix4x4)",          [](size_t) { Skinning::Skin(skinPalette4, skinInfluences.data(), skinPositions.data(), skinNormals.data(), skinPositionsOut.data(), skinNormalsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin (positions)",          [](size_t) { Skinning::Skin(skinPalette, skinInfluences.data(), skinPositions.data(), nullptr, skinPositionsOut.data(), nullptr, SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin (DualQuaternion)",     [](size_t) { Skinning::Skin(skinPaletteDual, skinInfluences.data(), skinPositions.data(), skinNormals.data(), skinPositionsOut.data(), skinNormalsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin (DualQuaternion positions)", [](size_t) { Skinning::Skin(skinPaletteDual, skinInfluences.data(), skinPositions.data(), nullptr, skinPositionsOut.data(), nullptr, SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Skinning::Skin (threads)",            [](size_t) { Skinning::Skin(skinPalette, skinInfluences.data(), skinPositions.data(), skinNormals.data(), skinPositionsOut.data(), skinNormalsOut.data(), SKIN_VERTEX_COUNT, std::thread::hardware_concurrency()); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    options.opsPerRepetition = ops;
+}
+
+void BenchHalf(Bench& bench) {
+    // These stream the skinned mesh, which is far bigger than the caches, so they're bound by memory as much as
+    // by the conversions. The copy is the baseline a Half3 array, at 6 bytes rather than 16, is measured against.
+    Bench::Options& options = bench.GetOptions();
+    const size_t ops = options.opsPerRepetition;
+    options.opsPerRepetition = std::max<size_t>(1, ops / 512);
+    bench("[] Vector3 copy",                        [](size_t) { std::copy(skinPositions.begin(), skinPositions.end(), skinPositionsOut.begin()); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] ToHalf (Vector3)",                    [](size_t) { ToHalf(skinPositions.data(), halfPositions.data(), SKIN_VERTEX_COUNT); return halfPositions[0].x; }, SKIN_VERTEX_COUNT);
+    bench("[] FromHalf (Half3)",                    [](size_t) { FromHalf(halfPositions.data(), skinPositionsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] ToHalf (float)",                      [](size_t) { ToHalf((const float*)skinPositions.data(), halfFloats.data(), SKIN_VERTEX_COUNT * 4); return halfFloats[0]; }, SKIN_VERTEX_COUNT * 4);
+    bench("[] FromHalf (float)",                    [](size_t) { FromHalf(halfFloats.data(), (float*)skinPositionsOut.data(), SKIN_VERTEX_COUNT * 4); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT * 4);
+    options.opsPerRepetition = ops;
+}
+
+void BenchVector3Array(Bench& bench) {
+    // The skinned mesh again, as Vector3s and packed, to compare the memory each layout streams.
+    Bench::Options& options = bench.GetOptions();
+    const size_t ops = options.opsPerRepetition;
+    options.opsPerRepetition = std::max<size_t>(1, ops / 512);
+    bench("[] Matrix4x4::TransformPoints (mesh)",   [](size_t i) { Matrix4x4_a[i].TransformPoints(skinPositions.data(), skinPositionsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    bench("[] Matrix4x4::TransformPoints (Float3 mesh)", [](size_t i) { Matrix4x4_a[i].TransformPoints(packedPositions.GetData(), packedPositionsOut.data(), SKIN_VERTEX_COUNT); return packedPositionsOut[0].x; }, SKIN_VERTEX_COUNT);
+    bench("[] Pack",                                [](size_t) { Pack(skinPositions.data(), packedPositionsOut.data(), SKIN_VERTEX_COUNT); return packedPositionsOut[0].x; }, SKIN_VERTEX_COUNT);
+    bench("[] Unpack",                              [](size_t) { Unpack(packedPositions.GetData(), skinPositionsOut.data(), SKIN_VERTEX_COUNT); return skinPositionsOut[0]; }, SKIN_VERTEX_COUNT);
+    options.opsPerRepetition = ops;
+}
+
+void BenchFrameArena(Bench& bench) {
+    // A frame's worth of scratch arrays: allocate 16, then free them all. Reported per array.
+    bench("[] XO_16ALIGNED_MALLOC Vector3[256]",     [](size_t) {
+        Vector3* arrays[16];
+        for (int j = 0; j < 16; ++j) {
+            arrays[j] = (Vector3*)XO_16ALIGNED_MALLOC(sizeof(Vector3) * BATCH_COUNT);
+            arrays[j][0] = Vector3_a[j];
+        }
+        Vector3 sum = arrays[15][0];
+        for (int j = 0; j < 16; ++j) {
+            XO_16ALIGNED_FREE(arrays[j]);
+        }
+        return sum;
+    }, 16);
+    bench("[] FrameArena Vector3[256]",              [](size_t) {
+        FrameArena& arena = FrameArena::ThreadArena();
+        Vector3* arrays[16];
+        for (int j = 0; j < 16; ++j) {
+            arrays[j] = arena.AllocateVector3s(BATCH_COUNT);
+            arrays[j][0] = Vector3_a[j];
+        }
+        Vector3 sum = arrays[15][0];
+        arena.Reset();
+        return sum;
+    }, 16);
+}
+
+std::string CompilerName() {
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("g++ ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+int main(int argc, char** argv) {
+    Bench::Options options;
+    options.inputCount = INPUT_COUNT;
+    const char* jsonPath = nullptr;
+    const char* comparePaths[2] = { nullptr, nullptr };
+    double threshold = 0.05;
+    SIMDTier maxTier = SIMDTier::AVX512;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--filter") && hasValue) {
+            options.filter = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--json") && hasValue) {
+            jsonPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--reps") && hasValue) {
+            options.repetitions = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--warmup") && hasValue) {
+            options.warmup = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--ops") && hasValue) {
+            options.opsPerRepetition = (size_t)atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--max-tier") && hasValue) {
+            const char* name = argv[++i];
+            maxTier = SIMDTier::None;
+            for (SIMDTier t : { SIMDTier::SSE2, SIMDTier::AVX, SIMDTier::AVX2, SIMDTier::AVX512 }) {
+                if (!strcmp(name, GetSIMDTierName(t))) {
+                    maxTier = t;
+                }
+            }
+        }
+        else if (!strcmp(argv[i], "--compare") && i + 2 < argc) {
+            comparePaths[0] = argv[++i];
+            comparePaths[1] = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--threshold") && hasValue) {
+            threshold = atof(argv[++i]);
+        }
+        else {
+            cout << "usage: xo-bench [--filter text] [--json path] [--reps n] [--warmup n] [--ops n] [--max-tier sse2|avx|avx2|avx512]\n"
+                 << "       xo-bench --compare base.json current.json [--threshold 0.05]" << endl;
+            return 2;
+        }
+    }
+
+    if (comparePaths[0]) {
+        std::vector<Bench::Result> base, current;
+        for (int i = 0; i < 2; ++i) {
+            if (!Bench::ReadJSON(comparePaths[i], i ? current : base)) {
+                cout << "couldn't read " << comparePaths[i] << endl;
+                return 2;
+            }
+        }
+        return Bench::Compare(base, current, threshold, cout) > 0 ? 1 : 0;
+    }
+
+    InitDispatch(maxTier);
+    Bench bench(options);
+    bench.SetConfig("compiler", CompilerName());
+    bench.SetConfig("simd", XO_MATH_HIGHEST_SIMD);
+    bench.SetConfig("dispatch", GetSIMDTierName(GetDispatchTier()));
+    bench.SetConfig("perf_counters", bench.GetCounters().Status());
+    cout << "xo-bench. simd: " << XO_MATH_HIGHEST_SIMD << ", dispatch: " << GetSIMDTierName(GetDispatchTier()) << "\n"
+         << "perf counters: " << bench.GetCounters().Status() << "\n" << endl;
+
+    FillInputs();
+    BenchBaseline(bench);
+    BenchVector2(bench);
+    BenchVector3(bench);
+    BenchVector4(bench);
+    BenchQuaternion(bench);
+    BenchDualQuaternion(bench);
+    BenchMatrix4x4(bench);
+    BenchMatrix3x4(bench);
+    BenchTransform(bench);
+    BenchArrays(bench);
+    BenchHierarchy(bench);
+    BenchSkinning(bench);
+    BenchHalf(bench);
+    BenchVector3Array(bench);
+    BenchFrameArena(bench);
+
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            cout << "couldn't write " << jsonPath << endl;
+            return 2;
+        }
+        bench.WriteJSON(file);
+        cout << "\nwrote " << bench.GetResults().size() << " results to " << jsonPath << endl;
+    }
+    return 0;
+}
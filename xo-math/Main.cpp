@@ -21,6 +21,50 @@ Test test;
 
 #define TEST_MSG(x)  "Main.cpp(" _XO_MATH_STRINGIFY(__LINE__) ") " x
 
+void TestTrig() {
+    test("Trig", []{
+        // Sweep well past a few periods, including negative inputs. The bounds are the documented absolute errors.
+        const int count = 1001;
+        static float f[count], s[count], c[count], fs[count], fc[count];
+        for (int i = 0; i < count; ++i) {
+            f[i] = (float(i) - float(count / 2)) * 0.0731f;
+        }
+        xo::SinCos(f, s, c, count);
+        xo::FastSinCos(f, fs, fc, count);
+        float maxError = 0.0f, maxFastError = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            float rs = float(std::sin(double(f[i]))), rc = float(std::cos(double(f[i])));
+            maxError = xo::Max(maxError, xo::Max(xo::Abs(s[i] - rs), xo::Abs(c[i] - rc)));
+            maxFastError = xo::Max(maxFastError, xo::Max(xo::Abs(fs[i] - rs), xo::Abs(fc[i] - rc)));
+        }
+        test.ReportSuccessIf(maxError <= 1.0e-7f, TEST_MSG("SinCos exceeded its documented error."));
+        test.ReportSuccessIf(maxFastError <= 1.4e-5f, TEST_MSG("FastSinCos exceeded its documented error."));
+
+        // the array tail goes through a partial register, its results should match the full registers.
+        float tail[3];
+        xo::Sin(f + 10, tail, 3);
+        test.ReportSuccessIf(tail[0], s[10], TEST_MSG("Sin array tail did not match."));
+        test.ReportSuccessIf(tail[2], s[12], TEST_MSG("Sin array tail did not match."));
+        xo::FastCos(f + 20, tail, 3);
+        test.ReportSuccessIf(tail[1], fc[21], TEST_MSG("FastCos array tail did not match."));
+
+        float sc, cc;
+        xo::SinCos(f[100], sc, cc);
+        test.ReportSuccessIf(sc, s[100], TEST_MSG("scalar SinCos did not match the array version."));
+        test.ReportSuccessIf(cc, c[100], TEST_MSG("scalar SinCos did not match the array version."));
+        test.ReportSuccessIf(xo::FastSin(f[100]), fs[100], TEST_MSG("scalar FastSin did not match the array version."));
+
+        _XOSIMDALIGN float in[4] = { -HalfPI, 0.5f, PI, 2.0f };
+        _XOSIMDALIGN float s3[4] = { 0.0f, 0.0f, 0.0f, 7.0f };
+        _XOSIMDALIGN float c3[4] = { 0.0f, 0.0f, 0.0f, 7.0f };
+        xo::SinCos_x3(in, s3, c3);
+        test.ReportSuccessIf(s3[0], -1.0f, TEST_MSG("SinCos_x3 sin of -pi/2 should be -1."));
+        test.ReportSuccessIf(c3[1], xo::Cos(0.5f), TEST_MSG("SinCos_x3 did not match Cos."));
+        test.ReportSuccessIf(c3[2], -1.0f, TEST_MSG("SinCos_x3 cos of pi should be -1."));
+        test.ReportSuccessIf(s3[3] == 7.0f && c3[3] == 7.0f, TEST_MSG("SinCos_x3 wrote a fourth element."));
+    });
+}
+
 void TestVector2Operators() {
     test("Vector2 Operators", []{
         using xo::Vector2;
@@ -633,12 +677,1584 @@ void TestVector4Methods() {
     });  
 }
 
+void TestVector3x4() {
+    test("Vector3x4", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Vector3x4;
+        Vector3 v[4] = {
+            Vector3(1.1f, 2.2f, 3.3f),
+            Vector3(-4.4f, 5.5f, -6.6f),
+            Vector3(7.7f, -8.8f, 9.9f),
+            Vector3(0.5f, 0.25f, -0.125f)
+        };
+        Vector3 u[4] = {
+            Vector3(-1.0f, 0.5f, 2.0f),
+            Vector3(3.0f, -2.5f, 1.5f),
+            Vector3(0.0f, 4.0f, -1.0f),
+            Vector3(2.0f, 2.0f, 2.0f)
+        };
+
+        auto a = Vector3x4::Load(v);
+        auto b = Vector3x4::Load(u);
+        for (int i = 0; i < 4; ++i) {
+            test.ReportSuccessIf(a.GetLane(i), v[i], TEST_MSG("Load did not transpose the lanes as expected."));
+        }
+        test.ReportSuccessIf(Vector3x4(v[0], v[1], v[2], v[3]), a, TEST_MSG("Constructor (v0, v1, v2, v3) did not match Load."));
+        test.ReportSuccessIf(Vector3x4(Vector3::One).GetLane(2), Vector3::One, TEST_MSG("Constructor (Vector3) did not set every lane."));
+
+        Vector3 out[4];
+        a.Store(out);
+        for (int i = 0; i < 4; ++i) {
+            test.ReportSuccessIf(out[i], v[i], TEST_MSG("Store did not transpose the lanes as expected."));
+        }
+
+        out[2] = out[3] = Vector3::One;
+        Vector3x4::LoadPartial(v, 2).StorePartial(out, 2);
+        test.ReportSuccessIf(out[1], v[1], TEST_MSG("StorePartial did not write the loaded lanes."));
+        test.ReportSuccessIf(out[2], Vector3::One, TEST_MSG("StorePartial wrote beyond count."));
+        test.ReportSuccessIf(Vector3x4::LoadPartial(v, 3).GetLane(3), Vector3::Zero, TEST_MSG("LoadPartial lanes beyond count should be zero."));
+
+        float xs[4], ys[4], zs[4];
+        a.StoreSoA(xs, ys, zs);
+        test.ReportSuccessIf(ys[1], v[1].y, TEST_MSG("StoreSoA did not write the y array."));
+        test.ReportSuccessIf(Vector3x4::LoadSoA(xs, ys, zs), a, TEST_MSG("LoadSoA did not match StoreSoA."));
+
+        auto dot = Vector3x4::Dot(a, b);
+        auto mag = a.Magnitude();
+        auto sum = a.Sum();
+        auto cross = Vector3x4::Cross(a, b);
+        auto lerp = Vector3x4::Lerp(a, b, 0.25f);
+        auto scale = Vector4(1.0f, 2.0f, -3.0f, 0.5f);
+        auto scaled = a * scale;
+        auto divided = a / scale;
+        for (int i = 0; i < 4; ++i) {
+            test.ReportSuccessIf((a + b).GetLane(i), v[i] + u[i], TEST_MSG("operator + did not match Vector3."));
+            test.ReportSuccessIf((a - b).GetLane(i), v[i] - u[i], TEST_MSG("operator - did not match Vector3."));
+            test.ReportSuccessIf((a * b).GetLane(i), v[i] * u[i], TEST_MSG("operator * did not match Vector3."));
+            test.ReportSuccessIf((a * 2.0f).GetLane(i), v[i] * 2.0f, TEST_MSG("operator * (float) did not match Vector3."));
+            test.ReportSuccessIf((a + u[3]).GetLane(i), v[i] + u[3], TEST_MSG("operator + (Vector3) did not match Vector3."));
+            test.ReportSuccessIf((-a).GetLane(i), -v[i], TEST_MSG("negate did not match Vector3."));
+            test.ReportSuccessIf(scaled.GetLane(i), v[i] * scale[i], TEST_MSG("operator * (Vector4) did not scale per lane."));
+            test.ReportSuccessIf(divided.GetLane(i), v[i] / scale[i], TEST_MSG("operator / (Vector4) did not divide per lane."));
+            test.ReportSuccessIf(dot[i], Vector3::Dot(v[i], u[i]), TEST_MSG("Dot did not match Vector3."));
+            test.ReportSuccessIf(mag[i], v[i].Magnitude(), TEST_MSG("Magnitude did not match Vector3."));
+            test.ReportSuccessIf(sum[i], v[i].Sum(), TEST_MSG("Sum did not match Vector3."));
+            test.ReportSuccessIf(cross.GetLane(i), Vector3::Cross(v[i], u[i]), TEST_MSG("Cross did not match Vector3."));
+            test.ReportSuccessIf(lerp.GetLane(i), Vector3::Lerp(v[i], u[i], 0.25f), TEST_MSG("Lerp did not match Vector3."));
+            test.ReportSuccessIf(Vector3x4::Max(a, b).GetLane(i), Vector3::Max(v[i], u[i]), TEST_MSG("Max did not match Vector3."));
+            test.ReportSuccessIf(Vector3x4::Min(a, b).GetLane(i), Vector3::Min(v[i], u[i]), TEST_MSG("Min did not match Vector3."));
+            test.ReportSuccessIf(a.Normalized().GetLane(i).Magnitude(), 1.0f, TEST_MSG("Magnitude of lane was not 1 after normalized."));
+        }
+
+        auto safe = Vector3x4(v[0], Vector3::Zero, v[2], Vector3::Zero).NormalizeSafe();
+        test.ReportSuccessIf(safe.GetLane(0).Magnitude(), 1.0f, TEST_MSG("NormalizeSafe did not normalize a non zero lane."));
+        test.ReportSuccessIf(safe.GetLane(1), Vector3::Zero, TEST_MSG("NormalizeSafe changed a zero lane."));
+
+        test.ReportSuccessIf(a != b, TEST_MSG("different vectors compared equal."));
+    });
+}
+
+void TestVector4x4() {
+    test("Vector4x4", []{
+        using xo::Vector4;
+        using xo::Vector4x4;
+        Vector4 v[4] = {
+            Vector4(1.1f, 2.2f, 3.3f, 4.4f),
+            Vector4(-4.4f, 5.5f, -6.6f, 0.5f),
+            Vector4(7.7f, -8.8f, 9.9f, -1.0f),
+            Vector4(0.5f, 0.25f, -0.125f, 2.0f)
+        };
+        Vector4 u[4] = {
+            Vector4(-1.0f, 0.5f, 2.0f, 1.0f),
+            Vector4(3.0f, -2.5f, 1.5f, -2.0f),
+            Vector4(0.0f, 4.0f, -1.0f, 0.5f),
+            Vector4(2.0f, 2.0f, 2.0f, 2.0f)
+        };
+
+        auto a = Vector4x4::Load(v);
+        auto b = Vector4x4::Load(u);
+        Vector4 out[4];
+        a.Store(out);
+        for (int i = 0; i < 4; ++i) {
+            test.ReportSuccessIf(a.GetLane(i), v[i], TEST_MSG("Load did not transpose the lanes as expected."));
+            test.ReportSuccessIf(out[i], v[i], TEST_MSG("Store did not transpose the lanes as expected."));
+        }
+        test.ReportSuccessIf(Vector4x4::LoadPartial(v, 1).GetLane(1), Vector4::Zero, TEST_MSG("LoadPartial lanes beyond count should be zero."));
+
+        float xs[4], ys[4], zs[4], ws[4];
+        a.StoreSoA(xs, ys, zs, ws);
+        test.ReportSuccessIf(ws[2], v[2].w, TEST_MSG("StoreSoA did not write the w array."));
+        test.ReportSuccessIf(Vector4x4::LoadSoA(xs, ys, zs, ws), a, TEST_MSG("LoadSoA did not match StoreSoA."));
+
+        auto dot = Vector4x4::Dot(a, b);
+        auto mag = a.Magnitude();
+        auto sum = a.Sum();
+        auto lerp = Vector4x4::Lerp(a, b, 0.75f);
+        for (int i = 0; i < 4; ++i) {
+            test.ReportSuccessIf((a + b).GetLane(i), v[i] + u[i], TEST_MSG("operator + did not match Vector4."));
+            test.ReportSuccessIf((a - b).GetLane(i), v[i] - u[i], TEST_MSG("operator - did not match Vector4."));
+            test.ReportSuccessIf((a * b).GetLane(i), v[i] * u[i], TEST_MSG("operator * did not match Vector4."));
+            test.ReportSuccessIf((a / 2.0f).GetLane(i), v[i] / 2.0f, TEST_MSG("operator / (float) did not match Vector4."));
+            test.ReportSuccessIf((-a).GetLane(i), -v[i], TEST_MSG("negate did not match Vector4."));
+            test.ReportSuccessIf(dot[i], Vector4::Dot(v[i], u[i]), TEST_MSG("Dot did not match Vector4."));
+            test.ReportSuccessIf(mag[i], v[i].Magnitude(), TEST_MSG("Magnitude did not match Vector4."));
+            test.ReportSuccessIf(sum[i], v[i].Sum(), TEST_MSG("Sum did not match Vector4."));
+            test.ReportSuccessIf(lerp.GetLane(i), Vector4::Lerp(v[i], u[i], 0.75f), TEST_MSG("Lerp did not match Vector4."));
+            test.ReportSuccessIf(Vector4x4::Max(a, b).GetLane(i), Vector4::Max(v[i], u[i]), TEST_MSG("Max did not match Vector4."));
+            test.ReportSuccessIf(a.Normalized().GetLane(i).Magnitude(), 1.0f, TEST_MSG("Magnitude of lane was not 1 after normalized."));
+        }
+
+        auto safe = Vector4x4(Vector4::Zero, v[1], v[2], v[3]).NormalizeSafe();
+        test.ReportSuccessIf(safe.GetLane(0), Vector4::Zero, TEST_MSG("NormalizeSafe changed a zero lane."));
+        test.ReportSuccessIf(safe.GetLane(3).Magnitude(), 1.0f, TEST_MSG("NormalizeSafe did not normalize a non zero lane."));
+    });
+}
+
+void TestMatrix4x4Transform() {
+    test("Matrix4x4 Transform", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        Matrix4x4 m(
+            1.0f, 2.0f, 3.0f, 4.0f,
+            -5.0f, 6.0f, 7.0f, 8.0f,
+            9.0f, -10.0f, 11.0f, 12.0f,
+            0.5f, 0.25f, -0.125f, 1.0f);
+
+        // an odd count exercises the tail of the wide kernels.
+        const int count = 7;
+        Vector3 v3[count];
+        Vector4 v4[count];
+        for (int i = 0; i < count; ++i) {
+            v3[i].Set(float(i) - 2.5f, float(i * i) * 0.5f, 1.0f - float(i));
+            v4[i].Set(v3[i], float(i) * 0.25f);
+        }
+
+        Vector3 points[count], directions[count];
+        Vector4 vectors[count];
+        m.TransformPoints(v3, points, count);
+        m.TransformDirections(v3, directions, count);
+        m.TransformVector4s(v4, vectors, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(points[i], Vector3(m * Vector4(v3[i], 1.0f)), TEST_MSG("TransformPoints did not match the matrix vector product."));
+            test.ReportSuccessIf(directions[i], m * v3[i], TEST_MSG("TransformDirections did not match the matrix vector product."));
+            test.ReportSuccessIf(vectors[i], m * v4[i], TEST_MSG("TransformVector4s did not match the matrix vector product."));
+        }
+
+        Vector3 inPlace[count];
+        Vector4 inPlace4[count];
+        for (int i = 0; i < count; ++i) {
+            inPlace[i] = v3[i];
+            inPlace4[i] = v4[i];
+        }
+        m.TransformPoints(inPlace, count);
+        m.TransformVector4s(inPlace4, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(inPlace[i], points[i], TEST_MSG("in place TransformPoints did not match."));
+            test.ReportSuccessIf(inPlace4[i], vectors[i], TEST_MSG("in place TransformVector4s did not match."));
+        }
+        m.TransformDirections(inPlace, 0);
+        test.ReportSuccessIf(inPlace[0], points[0], TEST_MSG("a zero count should not write anything."));
+    });
+}
+
+void TestMatrix4x4Multiply() {
+    test("Matrix4x4 Multiply", []{
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        // the reference product, computed one element at a time.
+        auto reference = [](const Matrix4x4& a, const Matrix4x4& b) {
+            Matrix4x4 m;
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    m(i, j) = a(i, 0) * b(0, j) + a(i, 1) * b(1, j) + a(i, 2) * b(2, j) + a(i, 3) * b(3, j);
+                }
+            }
+            return m;
+        };
+        auto equal = [](const Matrix4x4& a, const Matrix4x4& b) {
+            return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+        };
+
+        const int count = 5;
+        Matrix4x4 a[count], b[count], out[count];
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                a[i].m[j] = float((i * 7 + j * 3) % 11) * 0.25f - 1.0f;
+                b[i].m[j] = float((i * 5 + j * 13) % 9) * 0.5f - 2.0f;
+            }
+        }
+
+        test.ReportSuccessIf(equal(a[0] * b[0], reference(a[0], b[0])), TEST_MSG("operator * did not match the reference product."));
+        Matrix4x4 self = a[1];
+        self *= self;
+        test.ReportSuccessIf(equal(self, reference(a[1], a[1])), TEST_MSG("operator *= with itself did not match the reference product."));
+        test.ReportSuccessIf(equal(a[2] * Matrix4x4::Identity, a[2]), TEST_MSG("multiplying by identity changed the matrix."));
+
+        Matrix4x4::MultiplyBatch(a, b, out, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(equal(out[i], reference(a[i], b[i])), TEST_MSG("MultiplyBatch(a*, b*) did not match the reference product."));
+        }
+        Matrix4x4::MultiplyBatch(a[0], b, out, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(equal(out[i], reference(a[0], b[i])), TEST_MSG("MultiplyBatch(a, b*) did not match the reference product."));
+        }
+        Matrix4x4::MultiplyBatch(a, b[0], out, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(equal(out[i], reference(a[i], b[0])), TEST_MSG("MultiplyBatch(a*, b) did not match the reference product."));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            out[i] = a[i];
+        }
+        Matrix4x4::MultiplyBatch(out, b, out, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(equal(out[i], reference(a[i], b[i])), TEST_MSG("MultiplyBatch in place did not match the reference product."));
+        }
+    });
+}
+
+void TestRandom() {
+    test("Random", []{
+        // reference values from xoshiro128+ with the same splitmix64 seeding.
+        xo::Random a(1234);
+        test.ReportSuccessIf(a.Next() == 0xc6dfbe11u, TEST_MSG("Random did not match the reference sequence."));
+        test.ReportSuccessIf(a.Next() == 0x5e8cb55cu, TEST_MSG("Random did not match the reference sequence."));
+        test.ReportSuccessIf(a.Next() == 0x6fc2c18eu, TEST_MSG("Random did not match the reference sequence."));
+
+        xo::Random b(99), c(99);
+        bool same = true, inRange = true, sawLow = false, sawHigh = false;
+        for (int i = 0; i < 1000; ++i) {
+            same = same && b.Next() == c.Next();
+        }
+        for (int i = 0; i < 1000; ++i) {
+            float f = b.NextFloat();
+            int n = b.Range(-3, 3);
+            inRange = inRange && f >= 0.0f && f < 1.0f && n >= -3 && n <= 3;
+            sawLow = sawLow || n == -3;
+            sawHigh = sawHigh || n == 3;
+        }
+        test.ReportSuccessIf(same, TEST_MSG("Random with equal seeds diverged."));
+        test.ReportSuccessIf(inRange, TEST_MSG("Random produced a value out of range."));
+        test.ReportSuccessIf(sawLow && sawHigh, TEST_MSG("Random::Range(int) never hit its inclusive bounds."));
+        test.ReportSuccessIf(b.Range(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()) != b.Range(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()), TEST_MSG("Random::Range over every int failed."));
+
+        xo::Random d(99, 2), e(99);
+        e.Jump();
+        e.Jump();
+        test.ReportSuccessIf(d.Next() == e.Next(), TEST_MSG("Random stream did not match jumping."));
+
+        xo::Random::SeedThread(7, 1);
+        float r0 = xo::RandomRange(0.0f, 1.0f);
+        xo::Random::SeedThread(7, 1);
+        test.ReportSuccessIf(r0, xo::RandomRange(0.0f, 1.0f), TEST_MSG("SeedThread was not reproducible."));
+
+#if defined(XO_SSE2)
+        // lane i of stream 1 is the scalar engine jumped 4 + i times.
+        xo::Random_x4 x4(99, 1);
+        _XOSIMDALIGN uint32_t lanes[4];
+        _mm_store_si128((__m128i*)lanes, x4.Next());
+        bool lanesMatch = true;
+        for (int i = 0; i < 4; ++i) {
+            lanesMatch = lanesMatch && lanes[i] == xo::Random(99, 4 + i).Next();
+        }
+        test.ReportSuccessIf(lanesMatch, TEST_MSG("Random_x4 lanes did not match the scalar streams."));
+#endif
+#if defined(XO_AVX2)
+        xo::Random_x8 x8(99);
+        uint32_t lanes8[8];
+        _mm256_storeu_si256((__m256i*)lanes8, x8.Next());
+        bool lanes8Match = true;
+        for (int i = 0; i < 8; ++i) {
+            lanes8Match = lanes8Match && lanes8[i] == xo::Random(99, i).Next();
+        }
+        test.ReportSuccessIf(lanes8Match, TEST_MSG("Random_x8 lanes did not match the scalar streams."));
+#endif
+    });
+}
+
+void TestVector3Random() {
+    test("Vector3 Random", []{
+        using xo::Vector3;
+        // odd count so the array versions finish with a partial register.
+        const size_t count = 1003;
+        static Vector3 v[count];
+        const float tolerance = 0.001f;
+        bool ok;
+        Vector3 forward = Vector3(0.6f, 0.8f, 0.0f), up = Vector3::Up;
+
+        Vector3::RandomOnSphere(2.0f, v, count);
+        Vector3 sum = Vector3::Zero;
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(v[i].Magnitude() - 2.0f) <= tolerance;
+            sum += v[i];
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnSphere array gave a point off the sphere."));
+        test.ReportSuccessIf((sum / float(count)).Magnitude() < 0.2f, TEST_MSG("RandomOnSphere array was lopsided."));
+
+        ok = true;
+        for (size_t i = 0; i < 100; ++i) {
+            ok = ok && xo::Abs(Vector3::RandomOnSphere().Magnitude() - 1.0f) <= tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnSphere gave a point off the sphere."));
+
+        // uniform in volume: about (1.5^3 - 1) / (2^3 - 1) of the shell is inside a radius of 1.5.
+        Vector3::RandomInSphere(1.0f, 2.0f, v, count);
+        int inner = 0;
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            float m = v[i].Magnitude();
+            ok = ok && m >= 1.0f - tolerance && m <= 2.0f + tolerance;
+            inner += m < 1.5f ? 1 : 0;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomInSphere array gave a point outside the shell."));
+        test.ReportSuccessIf(xo::Abs(float(inner) / float(count) - 2.375f / 7.0f) < 0.06f, TEST_MSG("RandomInSphere array was not uniform in volume."));
+
+        const float halfCone = 30.0f * xo::Deg2Rad;
+        Vector3::RandomInConeDegrees(forward, 60.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(v[i].Magnitude() - 1.0f) <= tolerance && Vector3::AngleRadians(v[i], forward) <= halfCone + tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomInConeDegrees array left the cone."));
+
+        Vector3::RandomOnConeDegrees(forward, 60.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(v[i].Magnitude() - 1.0f) <= tolerance && xo::Abs(Vector3::AngleRadians(v[i], forward) - halfCone) <= tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnConeDegrees array was off the edge of the cone."));
+
+        ok = true;
+        for (size_t i = 0; i < 100; ++i) {
+            ok = ok && xo::Abs(Vector3::AngleRadians(Vector3::RandomOnConeDegrees(forward, 60.0f), forward) - halfCone) <= tolerance;
+            ok = ok && xo::Abs(Vector3::RandomInConeDegrees(Vector3::Down, 60.0f).Magnitude() - 1.0f) <= tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnConeDegrees was off the edge of the cone."));
+
+        Vector3::RandomInFanDegrees(Vector3::Forward, up, 90.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(Vector3::Dot(v[i], up)) <= tolerance && Vector3::AngleRadians(v[i], Vector3::Forward) <= 45.0f * xo::Deg2Rad + tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomInFanDegrees array left the fan."));
+
+        Vector3::RandomInCircle(forward, 3.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(Vector3::Dot(v[i], forward)) <= tolerance && v[i].Magnitude() <= 3.0f + tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomInCircle array left the circle."));
+
+        Vector3::RandomOnCircle(forward, 3.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(Vector3::Dot(v[i], forward)) <= tolerance && xo::Abs(v[i].Magnitude() - 3.0f) <= tolerance;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnCircle array was off the circle."));
+
+        Vector3::RandomInCube(2.0f, v, count);
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            ok = ok && xo::Abs(v[i].x) <= 2.0f && xo::Abs(v[i].y) <= 2.0f && xo::Abs(v[i].z) <= 2.0f;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomInCube array left the cube."));
+
+        Vector3::RandomOnCube(2.0f, v, count);
+        int faces[6] = { 0, 0, 0, 0, 0, 0 };
+        ok = true;
+        for (size_t i = 0; i < count; ++i) {
+            int onFaces = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                float f = v[i][axis];
+                ok = ok && xo::Abs(f) <= 2.0f;
+                if (xo::Abs(f) == 2.0f) {
+                    ++onFaces;
+                    ++faces[axis * 2 + (f < 0.0f ? 1 : 0)];
+                }
+            }
+            ok = ok && onFaces >= 1;
+        }
+        for (int i = 0; i < 6; ++i) {
+            ok = ok && faces[i] > 0;
+        }
+        test.ReportSuccessIf(ok, TEST_MSG("RandomOnCube array missed the cube's faces."));
+    });
+}
+
+void TestDispatch() {
+    test("Dispatch", []{
+        using xo::SIMDTier;
+        using xo::Matrix4x4;
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Quaternion;
+        auto equal = [](const Matrix4x4& a, const Matrix4x4& b) {
+            return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+        };
+        test.ReportSuccessIf(xo::GetSIMDTierName(xo::GetDispatchTier()) != nullptr, TEST_MSG("dispatch tier has no name."));
+
+        // Every tier's kernels should give the same results as the baseline. 37 covers the unrolled loops of each,
+        // plus a tail.
+        const int count = 37;
+        Matrix4x4 m = Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f) * Matrix4x4::Translation(1.0f, -2.0f, 3.0f);
+        Vector3 v3[count];
+        Vector4 v4[count];
+        Matrix4x4 mats[count];
+        Quaternion quats[count];
+        xo::DualQuaternion dualQuats[count];
+        float f[count];
+        int indices[count];
+        xo::Skinning::Influences influences[count];
+        for (int i = 0; i < count; ++i) {
+            indices[i] = (i * 11) % count;
+            for (int k = 0; k < 4; ++k) {
+                influences[i].bones[k] = (i + k * 5) % count;
+                influences[i].weights[k] = float(k + 1) * 0.1f;
+            }
+            v3[i] = Vector3(float(i), 1.0f - float(i), 0.5f * float(i));
+            v4[i] = Vector4(v3[i], float(i % 3));
+            mats[i] = Matrix4x4::RotationDegrees(float(i), 2.0f * float(i), 3.0f * float(i));
+            quats[i] = Quaternion::AxisAngleRadians(Vector3(1.0f, float(i), 2.0f).Normalized(), float(i) * 0.3f);
+            dualQuats[i] = xo::DualQuaternion(quats[i], v3[i]);
+            f[i] = float(i) * 0.7f - 4.0f;
+        }
+
+        xo::InitDispatch(SIMDTier::SSE2);
+        Vector3 points[count], dirs[count];
+        Vector4 v4s[count];
+        Matrix4x4 products[count], left[count], right[count], indexed[count], inverses[count];
+        bool ok[count];
+        float s[count], c[count], dots[count];
+        Vector3 normals[count], rotations[count];
+        Quaternion slerps[count], fastSlerps[count];
+        Vector3 skinned[count], skinnedNormals[count], dualSkinned[count], dualSkinnedNormals[count];
+        xo::Half3 halves[count];
+        uint16_t fHalves[count];
+        Vector3 widened[count];
+        xo::Float3 packed[count], packedPoints[count];
+        xo::Pack(v3, packed, count);
+        m.TransformPoints(v3, points, count);
+        m.TransformDirections(v3, dirs, count);
+        m.TransformVector4s(v4, v4s, count);
+        Matrix4x4::MultiplyBatch(mats, mats, products, count);
+        Matrix4x4::MultiplyBatch(m, mats, left, count);
+        Matrix4x4::MultiplyBatch(mats, m, right, count);
+        Matrix4x4::MultiplyBatch(mats, indices, mats, indexed, count);
+        Matrix4x4::InverseBatch(products, inverses, ok, count);
+        xo::SinCos(f, s, c, count);
+        Vector3::Dot(v3, dirs, dots, count);
+        Vector3::Normalize(points, normals, count);
+        Quaternion::RotateBatch(quats, v3, rotations, count);
+        Quaternion::SlerpBatch(quats, quats + 1, f, slerps, count - 1);
+        Quaternion::FastSlerpBatch(quats, quats + 1, f, fastSlerps, count - 1);
+        xo::Skinning::Skin(mats, influences, v3, dirs, skinned, skinnedNormals, count);
+        xo::Skinning::Skin(dualQuats, influences, v3, dirs, dualSkinned, dualSkinnedNormals, count);
+        xo::ToHalf(points, halves, count);
+        xo::ToHalf(f, fHalves, count);
+        xo::FromHalf(halves, widened, count);
+        m.TransformPoints(packed, packedPoints, count);
+        bool indexedSame = true;
+        for (int i = 0; i < count; ++i) {
+            indexedSame = indexedSame && equal(indexed[i], mats[indices[i]] * mats[i]);
+        }
+        test.ReportSuccessIf(indexedSame, TEST_MSG("MultiplyBatch with indices did not match operator *."));
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(dots[i], Vector3::Dot(v3[i], dirs[i]), TEST_MSG("Dot of arrays did not match Vector3::Dot."));
+            test.ReportSuccessIf(normals[i], points[i].Normalized(), TEST_MSG("Normalize of arrays did not match Vector3::Normalized."));
+        }
+
+        const SIMDTier tiers[] = { SIMDTier::AVX, SIMDTier::AVX2, SIMDTier::AVX512 };
+        for (SIMDTier tier : tiers) {
+            xo::InitDispatch(tier);
+            Vector3 tPoints[count], tDirs[count];
+            Vector4 tV4s[count];
+            Matrix4x4 tProducts[count], tLeft[count], tRight[count], tIndexed[count], tInverses[count];
+            bool tOk[count];
+            float ts[count], tc[count], tDots[count];
+            Vector3 tNormals[count], tRotations[count];
+            Quaternion tSlerps[count], tFastSlerps[count];
+            Vector3 tSkinned[count], tSkinnedNormals[count], tDualSkinned[count], tDualSkinnedNormals[count];
+            xo::Half3 tHalves[count];
+            uint16_t tFHalves[count];
+            Vector3 tWidened[count];
+            xo::Float3 tPackedPoints[count];
+            m.TransformPoints(v3, tPoints, count);
+            m.TransformDirections(v3, tDirs, count);
+            m.TransformVector4s(v4, tV4s, count);
+            Matrix4x4::MultiplyBatch(mats, mats, tProducts, count);
+            Matrix4x4::MultiplyBatch(m, mats, tLeft, count);
+            Matrix4x4::MultiplyBatch(mats, m, tRight, count);
+            Matrix4x4::MultiplyBatch(mats, indices, mats, tIndexed, count);
+            Matrix4x4::InverseBatch(products, tInverses, tOk, count);
+            xo::SinCos(f, ts, tc, count);
+            Vector3::Dot(v3, dirs, tDots, count);
+            Vector3::Normalize(points, tNormals, count);
+            Quaternion::RotateBatch(quats, v3, tRotations, count);
+            Quaternion::SlerpBatch(quats, quats + 1, f, tSlerps, count - 1);
+            Quaternion::FastSlerpBatch(quats, quats + 1, f, tFastSlerps, count - 1);
+            xo::Skinning::Skin(mats, influences, v3, dirs, tSkinned, tSkinnedNormals, count);
+            xo::Skinning::Skin(dualQuats, influences, v3, dirs, tDualSkinned, tDualSkinnedNormals, count);
+            xo::ToHalf(points, tHalves, count);
+            xo::ToHalf(f, tFHalves, count);
+            xo::FromHalf(halves, tWidened, count);
+            m.TransformPoints(packed, tPackedPoints, count);
+            bool same = true;
+            for (int i = 0; i < count; ++i) {
+                same = same && tPoints[i] == points[i] && tDirs[i] == dirs[i] && tV4s[i] == v4s[i];
+                same = same && equal(tProducts[i], products[i]) && equal(tLeft[i], left[i]) && equal(tRight[i], right[i]) && equal(tIndexed[i], indexed[i]);
+                same = same && tOk[i] == ok[i] && tRotations[i] == rotations[i];
+                same = same && tSkinned[i] == skinned[i] && tSkinnedNormals[i] == skinnedNormals[i];
+                same = same && tDualSkinned[i] == dualSkinned[i] && tDualSkinnedNormals[i] == dualSkinnedNormals[i];
+                same = same && tHalves[i].x == halves[i].x && tHalves[i].y == halves[i].y && tHalves[i].z == halves[i].z;
+                same = same && tFHalves[i] == fHalves[i] && tWidened[i] == widened[i];
+                same = same && Vector3(tPackedPoints[i]) == Vector3(packedPoints[i]);
+                if (i + 1 < count) {
+                    same = same && tSlerps[i] == slerps[i] && tFastSlerps[i] == fastSlerps[i];
+                }
+                for (int j = 0; j < 16; ++j) {
+                    same = same && xo::Abs(tInverses[i].m[j] - inverses[i].m[j]) <= 1e-5f;
+                }
+                if (tier == SIMDTier::AVX512) {
+                    // AVX-512 implies FMA, which the compiler may fuse the polynomial's multiplies and adds into.
+                    same = same && xo::Abs(ts[i] - s[i]) <= 1e-6f && xo::Abs(tc[i] - c[i]) <= 1e-6f;
+                }
+                else {
+                    same = same && ts[i] == s[i] && tc[i] == c[i];
+                }
+                // the wide normalize uses an approximate reciprocal square root, and the dots sum in another order.
+                same = same && xo::Abs(tDots[i] - dots[i]) <= xo::Abs(dots[i]) * 1e-6f && tNormals[i] == normals[i];
+            }
+            test.ReportSuccessIf(same, TEST_MSG("a dispatch tier did not match the baseline kernels."));
+        }
+        xo::InitDispatch();
+    });
+}
+
+void TestVector3x8() {
+    test("Vector3x8", []{
+        using xo::Vector3;
+        using xo::Vector3x4;
+        using xo::Vector3x8;
+        Vector3 v[8], u[8];
+        for (int i = 0; i < 8; ++i) {
+            v[i].Set(float(i) * 1.1f - 3.0f, 2.2f - float(i) * 0.5f, float(i % 3) + 0.25f);
+            u[i].Set(0.5f * float(i), float(7 - i) * 0.25f, -1.5f + float(i % 2));
+        }
+
+        auto a = Vector3x8::Load(v);
+        auto b = Vector3x8::Load(u);
+        Vector3 out[8];
+        a.Store(out);
+        for (int i = 0; i < 8; ++i) {
+            test.ReportSuccessIf(a.GetLane(i), v[i], TEST_MSG("Load did not transpose the lanes as expected."));
+            test.ReportSuccessIf(out[i], v[i], TEST_MSG("Store did not transpose the lanes as expected."));
+        }
+        test.ReportSuccessIf(Vector3x8(Vector3x4::Load(v), Vector3x4::Load(v + 4)), a, TEST_MSG("Constructor (low, high) did not match Load."));
+        test.ReportSuccessIf(Vector3x8(Vector3::One).GetLane(6), Vector3::One, TEST_MSG("Constructor (Vector3) did not set every lane."));
+
+        out[5] = out[6] = Vector3::One;
+        Vector3x8::LoadPartial(v, 5).StorePartial(out, 5);
+        test.ReportSuccessIf(out[4], v[4], TEST_MSG("StorePartial did not write the loaded lanes."));
+        test.ReportSuccessIf(out[5], Vector3::One, TEST_MSG("StorePartial wrote beyond count."));
+        test.ReportSuccessIf(Vector3x8::LoadPartial(v, 7).GetLane(7), Vector3::Zero, TEST_MSG("LoadPartial lanes beyond count should be zero."));
+
+        float xs[8], ys[8], zs[8];
+        a.StoreSoA(xs, ys, zs);
+        test.ReportSuccessIf(zs[6], v[6].z, TEST_MSG("StoreSoA did not write the z array."));
+        test.ReportSuccessIf(Vector3x8::LoadSoA(xs, ys, zs), a, TEST_MSG("LoadSoA did not match StoreSoA."));
+
+        float dot[8], mag[8], sum[8], dist[8];
+        Vector3x8::Dot(a, b, dot);
+        a.Magnitude(mag);
+        a.Sum(sum);
+        Vector3x8::Distance(a, b, dist);
+        auto cross = Vector3x8::Cross(a, b);
+        auto lerp = Vector3x8::Lerp(a, b, 0.25f);
+        for (int i = 0; i < 8; ++i) {
+            test.ReportSuccessIf((a + b).GetLane(i), v[i] + u[i], TEST_MSG("operator + did not match Vector3."));
+            test.ReportSuccessIf((a - b).GetLane(i), v[i] - u[i], TEST_MSG("operator - did not match Vector3."));
+            test.ReportSuccessIf((a * b).GetLane(i), v[i] * u[i], TEST_MSG("operator * did not match Vector3."));
+            test.ReportSuccessIf((a * 2.0f).GetLane(i), v[i] * 2.0f, TEST_MSG("operator * (float) did not match Vector3."));
+            test.ReportSuccessIf((a / 4.0f).GetLane(i), v[i] / 4.0f, TEST_MSG("operator / (float) did not match Vector3."));
+            test.ReportSuccessIf((a + u[3]).GetLane(i), v[i] + u[3], TEST_MSG("operator + (Vector3) did not match Vector3."));
+            test.ReportSuccessIf((-a).GetLane(i), -v[i], TEST_MSG("negate did not match Vector3."));
+            test.ReportSuccessIf(dot[i], Vector3::Dot(v[i], u[i]), TEST_MSG("Dot did not match Vector3."));
+            test.ReportSuccessIf(mag[i], v[i].Magnitude(), TEST_MSG("Magnitude did not match Vector3."));
+            test.ReportSuccessIf(sum[i], v[i].Sum(), TEST_MSG("Sum did not match Vector3."));
+            test.ReportSuccessIf(dist[i], Vector3::Distance(v[i], u[i]), TEST_MSG("Distance did not match Vector3."));
+            test.ReportSuccessIf(cross.GetLane(i), Vector3::Cross(v[i], u[i]), TEST_MSG("Cross did not match Vector3."));
+            test.ReportSuccessIf(lerp.GetLane(i), Vector3::Lerp(v[i], u[i], 0.25f), TEST_MSG("Lerp did not match Vector3."));
+            test.ReportSuccessIf(Vector3x8::Max(a, b).GetLane(i), Vector3::Max(v[i], u[i]), TEST_MSG("Max did not match Vector3."));
+            test.ReportSuccessIf(Vector3x8::Min(a, b).GetLane(i), Vector3::Min(v[i], u[i]), TEST_MSG("Min did not match Vector3."));
+            test.ReportSuccessIf(a.Normalized().GetLane(i).Magnitude(), 1.0f, TEST_MSG("Magnitude of lane was not 1 after normalized."));
+        }
+
+        auto safe = a;
+        safe.SetLane(3, Vector3::Zero).NormalizeSafe();
+        test.ReportSuccessIf(safe.GetLane(2).Magnitude(), 1.0f, TEST_MSG("NormalizeSafe did not normalize a non zero lane."));
+        test.ReportSuccessIf(safe.GetLane(3), Vector3::Zero, TEST_MSG("NormalizeSafe changed a zero lane."));
+
+        test.ReportSuccessIf(a != b, TEST_MSG("different vectors compared equal."));
+    });
+}
+
+void TestVector4x8() {
+    test("Vector4x8", []{
+        using xo::Vector4;
+        using xo::Vector4x8;
+        Vector4 v[8], u[8];
+        for (int i = 0; i < 8; ++i) {
+            v[i].Set(float(i) * 1.1f - 3.0f, 2.2f - float(i) * 0.5f, float(i % 3) + 0.25f, 0.5f * float(i) - 1.0f);
+            u[i].Set(0.5f * float(i), float(7 - i) * 0.25f, -1.5f + float(i % 2), 2.0f);
+        }
+
+        auto a = Vector4x8::Load(v);
+        auto b = Vector4x8::Load(u);
+        Vector4 out[8];
+        a.Store(out);
+        for (int i = 0; i < 8; ++i) {
+            test.ReportSuccessIf(a.GetLane(i), v[i], TEST_MSG("Load did not transpose the lanes as expected."));
+            test.ReportSuccessIf(out[i], v[i], TEST_MSG("Store did not transpose the lanes as expected."));
+        }
+        test.ReportSuccessIf(Vector4x8::LoadPartial(v, 6).GetLane(6), Vector4::Zero, TEST_MSG("LoadPartial lanes beyond count should be zero."));
+
+        float xs[8], ys[8], zs[8], ws[8];
+        a.StoreSoA(xs, ys, zs, ws);
+        test.ReportSuccessIf(ws[5], v[5].w, TEST_MSG("StoreSoA did not write the w array."));
+        test.ReportSuccessIf(Vector4x8::LoadSoA(xs, ys, zs, ws), a, TEST_MSG("LoadSoA did not match StoreSoA."));
+
+        float dot[8], mag[8], sum[8];
+        Vector4x8::Dot(a, b, dot);
+        a.Magnitude(mag);
+        a.Sum(sum);
+        auto lerp = Vector4x8::Lerp(a, b, 0.75f);
+        for (int i = 0; i < 8; ++i) {
+            test.ReportSuccessIf((a + b).GetLane(i), v[i] + u[i], TEST_MSG("operator + did not match Vector4."));
+            test.ReportSuccessIf((a - b).GetLane(i), v[i] - u[i], TEST_MSG("operator - did not match Vector4."));
+            test.ReportSuccessIf((a * b).GetLane(i), v[i] * u[i], TEST_MSG("operator * did not match Vector4."));
+            test.ReportSuccessIf((a / 2.0f).GetLane(i), v[i] / 2.0f, TEST_MSG("operator / (float) did not match Vector4."));
+            test.ReportSuccessIf((-a).GetLane(i), -v[i], TEST_MSG("negate did not match Vector4."));
+            test.ReportSuccessIf(dot[i], Vector4::Dot(v[i], u[i]), TEST_MSG("Dot did not match Vector4."));
+            test.ReportSuccessIf(mag[i], v[i].Magnitude(), TEST_MSG("Magnitude did not match Vector4."));
+            test.ReportSuccessIf(sum[i], v[i].Sum(), TEST_MSG("Sum did not match Vector4."));
+            test.ReportSuccessIf(lerp.GetLane(i), Vector4::Lerp(v[i], u[i], 0.75f), TEST_MSG("Lerp did not match Vector4."));
+            test.ReportSuccessIf(Vector4x8::Max(a, b).GetLane(i), Vector4::Max(v[i], u[i]), TEST_MSG("Max did not match Vector4."));
+            test.ReportSuccessIf(a.Normalized().GetLane(i).Magnitude(), 1.0f, TEST_MSG("Magnitude of lane was not 1 after normalized."));
+        }
+
+        auto safe = a;
+        safe.SetLane(0, Vector4::Zero).NormalizeSafe();
+        test.ReportSuccessIf(safe.GetLane(0), Vector4::Zero, TEST_MSG("NormalizeSafe changed a zero lane."));
+        test.ReportSuccessIf(safe.GetLane(7).Magnitude(), 1.0f, TEST_MSG("NormalizeSafe did not normalize a non zero lane."));
+    });
+}
+
+void TestMatrix4x4Inverse() {
+    test("Matrix4x4 Inverse", []{
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        auto closeToIdentity = [](const Matrix4x4& m) {
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    if (xo::Abs(m(i, j) - (i == j ? 1.0f : 0.0f)) > 0.001f) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        Matrix4x4 m = Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f) * Matrix4x4::Translation(1.0f, -2.0f, 3.0f) * Matrix4x4::Scale(2.0f);
+        Matrix4x4 inv = m;
+        inv.MakeInverse();
+        test.ReportSuccessIf(closeToIdentity(m * inv), TEST_MSG("a matrix times its inverse was not identity."));
+        test.ReportSuccessIf(closeToIdentity(inv * m), TEST_MSG("an inverse times its matrix was not identity."));
+
+        Matrix4x4 general(
+            2.0f, 1.0f, 0.0f, 3.0f,
+            -1.0f, 4.0f, 2.0f, 0.5f,
+            0.0f, -2.0f, 5.0f, 1.0f,
+            1.0f, 0.0f, -1.0f, 2.0f);
+        Matrix4x4 generalInv = general;
+        test.ReportSuccessIf(generalInv.TryMakeInverse(), TEST_MSG("TryMakeInverse failed on an invertible matrix."));
+        test.ReportSuccessIf(closeToIdentity(general * generalInv), TEST_MSG("TryMakeInverse did not give the inverse."));
+
+        Matrix4x4 singular(
+            1.0f, 2.0f, 3.0f, 4.0f,
+            2.0f, 4.0f, 6.0f, 8.0f,
+            0.0f, 1.0f, 0.0f, 1.0f,
+            1.0f, 0.0f, 1.0f, 0.0f);
+        test.ReportSuccessIf(!singular.TryMakeInverse(), TEST_MSG("TryMakeInverse succeeded on a singular matrix."));
+
+        // 21 covers whole groups at every lane width and a tail, with singular matrices in both.
+        const int count = 21;
+        Matrix4x4 mats[count], inverses[count];
+        bool ok[count];
+        for (int i = 0; i < count; ++i) {
+            mats[i] = Matrix4x4::RotationDegrees(float(i) * 10.0f, 20.0f, float(i) * -7.0f) * Matrix4x4::Scale(1.0f + float(i) * 0.1f);
+            mats[i].m[3] = float(i) * 0.01f; // not affine, so the whole 4x4 is inverted.
+            mats[i].m[13] = 1.0f - float(i) * 0.25f;
+        }
+        mats[3] = singular;
+        mats[18] = Matrix4x4::Zero;
+        Matrix4x4::InverseBatch(mats, inverses, ok, count);
+        bool batchOk = true, flagsOk = true;
+        for (int i = 0; i < count; ++i) {
+            bool isSingular = i == 3 || i == 18;
+            flagsOk = flagsOk && ok[i] == !isSingular;
+            if (isSingular) {
+                for (int j = 0; j < 16; ++j) {
+                    batchOk = batchOk && inverses[i].m[j] == mats[i].m[j];
+                }
+            }
+            else {
+                batchOk = batchOk && closeToIdentity(mats[i] * inverses[i]);
+            }
+        }
+        test.ReportSuccessIf(batchOk, TEST_MSG("InverseBatch did not give the inverses, or changed a singular matrix."));
+        test.ReportSuccessIf(flagsOk, TEST_MSG("InverseBatch did not report which matrices were singular."));
+        Matrix4x4::InverseBatch(inverses, inverses, nullptr, count);
+        bool inPlace = true;
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                inPlace = inPlace && xo::Abs(inverses[i].m[j] - mats[i].m[j]) <= 0.001f;
+            }
+        }
+        test.ReportSuccessIf(inPlace, TEST_MSG("InverseBatch in place, of the inverses, did not give the matrices back."));
+    });
+
+    test("Matrix4x4 Structured Inverse", []{
+        using xo::Vector3;
+        using xo::Matrix4x4;
+        using xo::Matrix3x4;
+        using xo::Quaternion;
+        typedef Matrix4x4::InverseMethod Method;
+        auto close = [](const Matrix4x4& a, const Matrix4x4& b) {
+            for (int i = 0; i < 16; ++i) {
+                if (xo::Abs(a.m[i] - b.m[i]) > 0.0001f) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto general = [](const Matrix4x4& m) { Matrix4x4 o = m; o.MakeInverse(); return o; };
+
+        // Affine matrices have their translation in the fourth column, as Matrix3x4 does.
+        Matrix4x4 rigid(Matrix3x4(Quaternion::AxisAngleRadians(Vector3(1.0f, 2.0f, -0.5f).Normalized(), 1.2f), Vector3(1.0f, -2.0f, 3.0f)));
+        Matrix4x4 srt = rigid * Matrix4x4::Scale(2.0f, 3.0f, 0.5f);
+        Matrix4x4 affine = rigid * Matrix4x4(Matrix3x4(1.0f, 0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f));
+        Matrix4x4 projection = Matrix4x4::PerspectiveProjectionDegrees(90.0f, 60.0f, 0.1f, 100.0f);
+
+        test.ReportSuccessIf(rigid.ClassifyInverse() == Method::Rigid, TEST_MSG("a rotation and translation should classify as Rigid."));
+        test.ReportSuccessIf(srt.ClassifyInverse() == Method::ScaleRotateTranslate, TEST_MSG("a scaled rotation should classify as ScaleRotateTranslate."));
+        test.ReportSuccessIf(affine.ClassifyInverse() == Method::Affine, TEST_MSG("a sheared matrix should classify as Affine."));
+        test.ReportSuccessIf(projection.ClassifyInverse() == Method::General, TEST_MSG("a projection should classify as General."));
+        test.ReportSuccessIf(Matrix4x4::Translation(1.0f, 2.0f, 3.0f).ClassifyInverse() == Method::General, TEST_MSG("a translation in the bottom row isn't affine."));
+
+        test.ReportSuccessIf(close(rigid.InverseRigid(), general(rigid)), TEST_MSG("InverseRigid did not match MakeInverse."));
+        test.ReportSuccessIf(close(srt.InverseScaleRotateTranslate(), general(srt)), TEST_MSG("InverseScaleRotateTranslate did not match MakeInverse."));
+        test.ReportSuccessIf(close(rigid.InverseScaleRotateTranslate(), general(rigid)), TEST_MSG("InverseScaleRotateTranslate of a rigid matrix did not match MakeInverse."));
+        test.ReportSuccessIf(close(affine.InverseAffine(), general(affine)), TEST_MSG("InverseAffine did not match MakeInverse."));
+        test.ReportSuccessIf(close(srt.InverseAffine(), general(srt)), TEST_MSG("InverseAffine of a scaled rotation did not match MakeInverse."));
+
+        Matrix4x4::InverseStats stats;
+        const Matrix4x4 all[] = { rigid, srt, affine, projection, srt };
+        bool autoSame = true;
+        for (const Matrix4x4& m : all) {
+            autoSame = autoSame && close(m.InverseAuto(&stats), general(m));
+        }
+        test.ReportSuccessIf(autoSame, TEST_MSG("InverseAuto did not match MakeInverse."));
+        test.ReportSuccessIf(stats[Method::Rigid] == 1 && stats[Method::ScaleRotateTranslate] == 2 && stats[Method::Affine] == 1 && stats[Method::General] == 1, TEST_MSG("InverseStats did not count each method."));
+        test.ReportSuccessIf(stats.Total() == 5, TEST_MSG("InverseStats did not count every inverse."));
+
+        test.ReportSuccessIf(rigid.HasOrthonormalBasis(), TEST_MSG("a rotation should have an orthonormal basis."));
+        test.ReportSuccessIf(!srt.HasOrthonormalBasis(), TEST_MSG("a scaled rotation shouldn't have an orthonormal basis."));
+        test.ReportSuccessIf(Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f).IsUnitary(), TEST_MSG("a rotation should be unitary."));
+        test.ReportSuccessIf(!rigid.IsUnitary(), TEST_MSG("a translation shouldn't be unitary."));
+        test.ReportSuccessIf(srt.Determinant(), 3.0f, TEST_MSG("the determinant of a scaled rotation should be the product of its scale."));
+        test.ReportSuccessIf(Matrix4x4(2.0f, 1.0f, 0.0f, 3.0f, -1.0f, 4.0f, 2.0f, 0.5f, 0.0f, -2.0f, 5.0f, 1.0f, 1.0f, 0.0f, -1.0f, 2.0f).Determinant(), 51.5f, TEST_MSG("the determinant did not match the cofactor expansion."));
+    });
+}
+
+void TestMatrix3x4() {
+    test("Matrix3x4", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::Quaternion;
+        auto close = [](const Matrix4x4& a, const Matrix4x4& b) {
+            for (int i = 0; i < 16; ++i) {
+                if (xo::Abs(a.m[i] - b.m[i]) > 0.001f) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        test.ReportSuccessIf(sizeof(Matrix3x4) == 48, TEST_MSG("Matrix3x4 should take 48 bytes."));
+
+        // Matrix4x4::Translation fills the bottom row, so the translations are set in the fourth column directly.
+        Matrix4x4 full = Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f) * Matrix4x4::Scale(2.0f, 0.5f, 1.5f);
+        full.m03 = 1.0f;
+        full.m13 = -2.0f;
+        full.m23 = 3.0f;
+        Matrix3x4 affine(full);
+        Matrix4x4 back(affine);
+        test.ReportSuccessIf(back[0] == full[0] && back[1] == full[1] && back[2] == full[2] && back[3] == full[3], TEST_MSG("converting to Matrix3x4 and back lost an element."));
+        test.ReportSuccessIf(affine.GetTranslation(), Vector3(full.m03, full.m13, full.m23), TEST_MSG("GetTranslation did not return the fourth column."));
+
+        Matrix4x4 other = Matrix4x4::RotationDegrees(-50.0f, 10.0f, 5.0f);
+        other.m03 = 0.5f;
+        other.m13 = 4.0f;
+        other.m23 = -1.0f;
+        test.ReportSuccessIf(close(Matrix4x4(affine * Matrix3x4(other)), full * other), TEST_MSG("the affine product did not match the Matrix4x4 product."));
+        Matrix3x4 self = affine;
+        self *= self;
+        test.ReportSuccessIf(close(Matrix4x4(self), full * full), TEST_MSG("operator *= with itself did not match the Matrix4x4 product."));
+
+        const int count = 5;
+        Vector3 v[count], points[count], directions[count];
+        for (int i = 0; i < count; ++i) {
+            v[i].Set(float(i) - 1.5f, float(i * i) * 0.25f, 2.0f - float(i));
+        }
+        affine.TransformPoints(v, points, count);
+        affine.TransformDirections(v, directions, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(affine.TransformPoint(v[i]), Vector3(full * Vector4(v[i], 1.0f)), TEST_MSG("TransformPoint did not match the Matrix4x4 product."));
+            test.ReportSuccessIf(affine.TransformDirection(v[i]), full * v[i], TEST_MSG("TransformDirection did not match the Matrix4x4 product."));
+            test.ReportSuccessIf(points[i], affine.TransformPoint(v[i]), TEST_MSG("TransformPoints did not match TransformPoint."));
+            test.ReportSuccessIf(directions[i], affine.TransformDirection(v[i]), TEST_MSG("TransformDirections did not match TransformDirection."));
+        }
+
+        Matrix3x4 inv = affine;
+        inv.MakeInverse();
+        test.ReportSuccessIf(close(Matrix4x4(affine * inv), Matrix4x4::Identity), TEST_MSG("a matrix times its inverse was not identity."));
+        test.ReportSuccessIf(close(Matrix4x4(inv), [&]{ Matrix4x4 m = full; m.MakeInverse(); return m; }()), TEST_MSG("the affine inverse did not match Matrix4x4::MakeInverse."));
+        test.ReportSuccessIf(xo::Abs(affine.Determinant() - 1.5f) < 0.001f, TEST_MSG("the determinant should be the product of the scales."));
+        Matrix3x4 singular = Matrix3x4::Scale(Vector3(1.0f, 0.0f, 1.0f));
+        test.ReportSuccessIf(!singular.TryMakeInverse(), TEST_MSG("TryMakeInverse succeeded on a singular matrix."));
+
+        Matrix4x4 rotation4 = Matrix4x4::RotationDegrees(15.0f, -70.0f, 120.0f);
+        Quaternion q = Quaternion(Matrix3x4(rotation4));
+        test.ReportSuccessIf(close(Matrix4x4(Matrix3x4(q)), rotation4), TEST_MSG("Matrix3x4 to Quaternion and back did not keep the rotation."));
+        test.ReportSuccessIf(close(Matrix4x4(Matrix3x4(q)).Transposed(), Matrix4x4(q)), TEST_MSG("Matrix3x4(Quaternion) should be the transpose of Matrix4x4(Quaternion)."));
+        Matrix3x4 rotation(q, Vector3(3.0f, 2.0f, 1.0f));
+        test.ReportSuccessIf(rotation.GetTranslation(), Vector3(3.0f, 2.0f, 1.0f), TEST_MSG("the translation was not set."));
+        Quaternion roundTrip(rotation * Matrix3x4::Scale(Vector3(2.0f, 3.0f, 0.5f)));
+        test.ReportSuccessIf(xo::Abs(roundTrip.x - q.x) < 0.001f && xo::Abs(roundTrip.y - q.y) < 0.001f && xo::Abs(roundTrip.z - q.z) < 0.001f && xo::Abs(roundTrip.w - q.w) < 0.001f, TEST_MSG("Quaternion to Matrix3x4 and back did not keep the rotation."));
+    });
+}
+
+void TestQuaternion() {
+    test("Quaternion", []{
+        using xo::Vector3;
+        using xo::Matrix3x4;
+        using xo::Quaternion;
+        // the two sides round differently, and Vector3 == is tighter than that without SSE.
+        auto close = [](const Vector3& a, const Vector3& b) {
+            return xo::Abs(a.x - b.x) <= 1e-5f && xo::Abs(a.y - b.y) <= 1e-5f && xo::Abs(a.z - b.z) <= 1e-5f;
+        };
+
+        Quaternion a = Quaternion::AxisAngleRadians(Vector3(1.0f, 2.0f, 3.0f).Normalized(), 0.7f);
+        Quaternion b = Quaternion::AxisAngleRadians(Vector3(-1.0f, 0.5f, 2.0f).Normalized(), 1.9f);
+        Quaternion ab = a * b;
+        Quaternion expected(
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+        test.ReportSuccessIf(ab == expected, TEST_MSG("operator * did not give the Hamilton product."));
+        Quaternion self = a;
+        self *= self;
+        test.ReportSuccessIf(self == a * a, TEST_MSG("operator *= with itself did not match operator *."));
+
+        Vector3 v(0.25f, -1.5f, 2.0f);
+        test.ReportSuccessIf(close(a.Rotate(v), Matrix3x4(a).TransformDirection(v)), TEST_MSG("Rotate did not match the rotation matrix."));
+        test.ReportSuccessIf(a * v, a.Rotate(v), TEST_MSG("operator * did not match Rotate."));
+        test.ReportSuccessIf(close(ab.Rotate(v), a.Rotate(b.Rotate(v))), TEST_MSG("rotating by a product should rotate by each in turn."));
+        test.ReportSuccessIf(Quaternion::Identity.Rotate(v), v, TEST_MSG("the identity should not rotate."));
+
+        // 11 covers whole passes at every lane width and a tail.
+        const int count = 11;
+        Quaternion qs[count];
+        Vector3 in[count], rotated[count], batch[count];
+        for (int i = 0; i < count; ++i) {
+            qs[i] = Quaternion::AxisAngleRadians(Vector3(float(i), 1.0f, -0.5f * float(i)).Normalized(), float(i) * 0.6f - 3.0f);
+            in[i].Set(float(i) - 1.5f, float(i * i) * 0.25f, 2.0f - float(i));
+        }
+        a.Rotate(in, rotated, count);
+        Quaternion::RotateBatch(qs, in, batch, count);
+        for (int i = 0; i < count; ++i) {
+            test.ReportSuccessIf(close(rotated[i], a.Rotate(in[i])), TEST_MSG("Rotate of an array did not match Rotate."));
+            test.ReportSuccessIf(batch[i], qs[i].Rotate(in[i]), TEST_MSG("RotateBatch did not match Rotate."));
+        }
+        Quaternion::RotateBatch(qs, in, in, count);
+        bool inPlace = true;
+        for (int i = 0; i < count; ++i) {
+            inPlace = inPlace && in[i] == batch[i];
+        }
+        test.ReportSuccessIf(inPlace, TEST_MSG("RotateBatch in place did not match."));
+
+        // the angle of the rotation between two unit quaternions, which for small angles is twice the distance
+        // between them. ACos of their dot product can't resolve angles this small in floats.
+        auto angle = [](const Quaternion& a, const Quaternion& b) {
+            xo::Vector4 d(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w), s(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+            return 2.0f * xo::Min(d.Magnitude(), s.Magnitude());
+        };
+        auto same = [](const Quaternion& a, const Quaternion& b) {
+            return xo::Abs(a.x - b.x) <= 1e-5f && xo::Abs(a.y - b.y) <= 1e-5f && xo::Abs(a.z - b.z) <= 1e-5f && xo::Abs(a.w - b.w) <= 1e-5f;
+        };
+        test.ReportSuccessIf(same(Quaternion::Nlerp(a, b, 0.0f), a) && same(Quaternion::Nlerp(a, b, 1.0f), b), TEST_MSG("Nlerp should give a at 0 and b at 1."));
+        Quaternion negated(-b.x, -b.y, -b.z, -b.w);
+        test.ReportSuccessIf(same(Quaternion::Nlerp(a, negated, 0.3f), Quaternion::Nlerp(a, b, 0.3f)), TEST_MSG("Nlerp should take the shorter way around."));
+        float worst = 0.0f;
+        for (int i = 0; i <= 20; ++i) {
+            // up to half a turn apart, which is as far as the shorter way around goes.
+            Quaternion to = Quaternion::AxisAngleRadians(Vector3(1.0f, -2.0f, 0.5f).Normalized(), float(i) * 0.157f);
+            for (int j = 0; j <= 10; ++j) {
+                float t = float(j) * 0.1f;
+                worst = xo::Max(worst, angle(Quaternion::FastSlerp(a * to, a, t), Quaternion::Slerp(a * to, a, t)));
+            }
+        }
+        test.ReportSuccessIf(worst < 0.001f, TEST_MSG("FastSlerp strayed too far from Slerp."));
+
+        // t of exactly 0 and 1, a equal to b, and b in the other hemisphere from a, all through the wide kernels.
+        Quaternion from[count], to[count], slerps[count], nlerps[count], fastSlerps[count];
+        float t[count];
+        for (int i = 0; i < count; ++i) {
+            from[i] = qs[i];
+            to[i] = qs[(i + 3) % count];
+            t[i] = float(i) / float(count - 1);
+        }
+        to[4] = Quaternion(-from[4].x, -from[4].y, -from[4].z, -from[4].w) * b;
+        to[6] = from[6];
+        Quaternion::SlerpBatch(from, to, t, slerps, count);
+        Quaternion::NlerpBatch(from, to, t, nlerps, count);
+        Quaternion::FastSlerpBatch(from, to, t, fastSlerps, count);
+        bool slerpSame = true, nlerpSame = true, fastSame = true;
+        for (int i = 0; i < count; ++i) {
+            slerpSame = slerpSame && same(slerps[i], Quaternion::Slerp(from[i], to[i], t[i]));
+            nlerpSame = nlerpSame && same(nlerps[i], Quaternion::Nlerp(from[i], to[i], t[i]));
+            fastSame = fastSame && same(fastSlerps[i], Quaternion::FastSlerp(from[i], to[i], t[i]));
+        }
+        test.ReportSuccessIf(slerpSame, TEST_MSG("SlerpBatch did not match Slerp."));
+        test.ReportSuccessIf(nlerpSame, TEST_MSG("NlerpBatch did not match Nlerp."));
+        test.ReportSuccessIf(fastSame, TEST_MSG("FastSlerpBatch did not match FastSlerp."));
+        Quaternion::SlerpBatch(from, to, t, from, count);
+        bool slerpInPlace = true;
+        for (int i = 0; i < count; ++i) {
+            slerpInPlace = slerpInPlace && same(from[i], slerps[i]);
+        }
+        test.ReportSuccessIf(slerpInPlace, TEST_MSG("SlerpBatch in place did not match."));
+    });
+}
+
+void TestTransform() {
+    test("Transform", []{
+        using xo::Vector3;
+        using xo::Quaternion;
+        using xo::Matrix3x4;
+        using xo::Transform;
+        auto close = [](const Matrix3x4& a, const Matrix3x4& b) {
+            for (int i = 0; i < 12; ++i) {
+                if (xo::Abs(a.m[i] - b.m[i]) > 0.001f) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        Quaternion a = Quaternion::AxisAngleRadians(Vector3(1.0f, 2.0f, 3.0f).Normalized(), 0.7f);
+        Quaternion b = Quaternion::AxisAngleRadians(Vector3(-1.0f, 0.5f, 2.0f).Normalized(), 1.9f);
+        test.ReportSuccessIf(close(Matrix3x4(a * b), Matrix3x4(a) * Matrix3x4(b)), TEST_MSG("a quaternion product should compose like the matrix product."));
+
+        test.ReportSuccessIf(close(Transform().GetMatrix(), Matrix3x4::Identity), TEST_MSG("the default transform should be the identity."));
+        test.ReportSuccessIf(close(Transform::Identity.GetInverseMatrix(), Matrix3x4::Identity), TEST_MSG("the identity's inverse should be the identity."));
+
+        Vector3 position(1.0f, -2.0f, 3.0f), scale(2.0f, 0.5f, 1.5f);
+        Transform t(position, a, scale);
+        Matrix3x4 expected = Matrix3x4::Translation(position) * Matrix3x4(a) * Matrix3x4::Scale(scale);
+        test.ReportSuccessIf(close(t.GetMatrix(), expected), TEST_MSG("the composed matrix should be T * R * S."));
+        test.ReportSuccessIf(close(t.GetInverseMatrix(), [&]{ Matrix3x4 m = expected; m.MakeInverse(); return m; }()), TEST_MSG("the composed inverse should match Matrix3x4::MakeInverse."));
+
+        Vector3 v(0.25f, -1.5f, 2.0f);
+        test.ReportSuccessIf(t.TransformPoint(v), expected.TransformPoint(v), TEST_MSG("TransformPoint should match the composed matrix."));
+        test.ReportSuccessIf(t.TransformDirection(v), expected.TransformDirection(v), TEST_MSG("TransformDirection should match the composed matrix."));
+        test.ReportSuccessIf(t.InverseTransformPoint(t.TransformPoint(v)), v, TEST_MSG("InverseTransformPoint should undo TransformPoint."));
+
+        // moving a transform with an up to date matrix patches the translation.
+        t.SetPosition(Vector3(4.0f, 5.0f, 6.0f));
+        expected.SetTranslation(Vector3(4.0f, 5.0f, 6.0f));
+        test.ReportSuccessIf(close(t.GetMatrix(), expected), TEST_MSG("SetPosition did not update the cached matrix."));
+        test.ReportSuccessIf(close(t.GetInverseMatrix(), [&]{ Matrix3x4 m = expected; m.MakeInverse(); return m; }()), TEST_MSG("SetPosition did not update the cached inverse."));
+        t.SetRotation(b);
+        test.ReportSuccessIf(close(t.GetMatrix(), Matrix3x4::Translation(Vector3(4.0f, 5.0f, 6.0f)) * Matrix3x4(b) * Matrix3x4::Scale(scale)), TEST_MSG("SetRotation did not update the cached matrix."));
+        test.ReportSuccessIf(close(Transform(t.GetMatrix()).GetMatrix(), t.GetMatrix()), TEST_MSG("decomposing a matrix and composing it again should give the same matrix."));
+
+        // TRS can only hold these exactly when the parent's scale is uniform.
+        Transform parent(Vector3(-3.0f, 1.0f, 0.5f), b, Vector3(2.0f, 2.0f, 2.0f));
+        Transform child(Vector3(0.5f, 0.0f, -1.0f), a, scale);
+        Transform combined = Transform::Combine(parent, child);
+        test.ReportSuccessIf(close(combined.GetMatrix(), parent.GetMatrix() * child.GetMatrix()), TEST_MSG("Combine should match the product of the matrices."));
+        test.ReportSuccessIf(close(Transform::Combine(parent, parent.Inverse()).GetMatrix(), Matrix3x4::Identity), TEST_MSG("a transform combined with its inverse should be the identity."));
+        test.ReportSuccessIf(close(parent.Inverse().GetMatrix(), parent.GetInverseMatrix()), TEST_MSG("Inverse should match the inverse matrix."));
+        Transform::Combine(parent, child, child);
+        test.ReportSuccessIf(close(child.GetMatrix(), combined.GetMatrix()), TEST_MSG("Combine into one of its inputs gave a different result."));
+    });
+}
+
+void TestHierarchy() {
+    test("Hierarchy", []{
+        using xo::Vector3;
+        using xo::Matrix4x4;
+        using xo::Hierarchy;
+        xo::Random random(42);
+        Hierarchy hierarchy;
+        std::vector<Matrix4x4> locals;
+        std::vector<int> parents;
+        auto addNode = [&](int parent) {
+            Matrix4x4 local = Matrix4x4::RotationRadians(Vector3(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f)));
+            local.m03 = random.Range(-1.0f, 1.0f);
+            local.m13 = random.Range(-1.0f, 1.0f);
+            local.m23 = random.Range(-1.0f, 1.0f);
+            locals.push_back(local);
+            parents.push_back(parent);
+            return hierarchy.AddNode(parent, local);
+        };
+        // Parents are always added first, so walking the nodes in order is the same as walking down the tree.
+        auto matchesReference = [&]() {
+            std::vector<Matrix4x4> worlds(locals.size());
+            for (size_t i = 0; i < locals.size(); ++i) {
+                worlds[i] = parents[i] == Hierarchy::NoParent ? locals[i] : worlds[parents[i]] * locals[i];
+                for (int e = 0; e < 16; ++e) {
+                    if (xo::Abs(hierarchy.GetWorld((int)i).m[e] - worlds[i].m[e]) > 0.001f) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        const int count = 3000;
+        bool handlesInOrder = true;
+        for (int i = 0; i < count; ++i) {
+            // a few roots, then mostly short chains with the odd branch back up the tree.
+            int parent = i < 4 ? Hierarchy::NoParent : (random.Range(0, 3) == 0 ? random.Range(0, i - 1) : i - 1 - random.Range(0, 2));
+            handlesInOrder = handlesInOrder && addNode(parent) == i;
+        }
+        test.ReportSuccessIf(handlesInOrder, TEST_MSG("handles should count up from 0."));
+        hierarchy.UpdateWorld();
+        test.ReportSuccessIf(matchesReference(), TEST_MSG("world matrices did not match multiplying down the tree."));
+        test.ReportSuccessIf(hierarchy.GetParent(10), parents[10], TEST_MSG("GetParent should return the parent the node was added with."));
+
+        for (int i = 0; i < 20; ++i) {
+            int node = random.Range(0, count - 1);
+            locals[node] = Matrix4x4::RotationRadians(Vector3(random.Range(-1.0f, 1.0f), 0.5f, 0.25f));
+            hierarchy.SetLocal(node, locals[node]);
+        }
+        hierarchy.UpdateWorld(4);
+        test.ReportSuccessIf(matchesReference(), TEST_MSG("changed subtrees were not updated with four threads."));
+
+        // nodes added later, below any level, keep their handles and the others' through the reordering.
+        for (int i = 0; i < 100; ++i) {
+            addNode(random.Range(0, count - 1));
+        }
+        hierarchy.UpdateWorld(2);
+        test.ReportSuccessIf(matchesReference(), TEST_MSG("nodes added after an update were not placed correctly."));
+
+        // a change below the roots leaves the first level alone.
+        int deep = count - 1;
+        locals[deep] = Matrix4x4::Scale(2.0f, 2.0f, 2.0f);
+        hierarchy.SetLocal(deep, locals[deep]);
+        hierarchy.BeginUpdate();
+        size_t begin, end;
+        hierarchy.GetLevelRange(0, begin, end);
+        test.ReportSuccessIf(begin == end, TEST_MSG("a level above every change should have nothing to update."));
+        for (size_t level = 0; level < hierarchy.GetLevelCount(); ++level) {
+            hierarchy.GetLevelRange(level, begin, end);
+            size_t middle = begin + (end - begin) / 2;
+            hierarchy.UpdateRange(middle, end);
+            hierarchy.UpdateRange(begin, middle);
+        }
+        hierarchy.EndUpdate();
+        test.ReportSuccessIf(matchesReference(), TEST_MSG("updating in steps did not match UpdateWorld."));
+    });
+}
+
+void TestSkinning() {
+    test("Skinning", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::Quaternion;
+        using xo::Skinning;
+        xo::Random random(7);
+        const int boneCount = 12;
+        Matrix3x4 palette[boneCount];
+        Matrix4x4 palette4[boneCount];
+        for (int b = 0; b < boneCount; ++b) {
+            Vector3 axis(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), 1.0f);
+            palette[b] = Matrix3x4(Quaternion::AxisAngleRadians(axis.Normalized(), random.Range(-3.0f, 3.0f)), Vector3(random.Range(-2.0f, 2.0f), float(b), 0.5f));
+            palette4[b] = Matrix4x4(palette[b]);
+        }
+
+        // 4099 is one vertex past a whole chunk, with an odd count for the kernels' tails. Some vertices have
+        // fewer than four bones.
+        const int count = 4099;
+        std::vector<Skinning::Influences> influences(count);
+        std::vector<Vector3> positions(count), normals(count), skinned(count), skinnedNormals(count);
+        for (int i = 0; i < count; ++i) {
+            float weights[4] = { random.Range(0.0f, 1.0f), random.Range(0.0f, 1.0f), i % 3 ? random.Range(0.0f, 1.0f) : 0.0f, i % 2 ? random.Range(0.0f, 1.0f) : 0.0f };
+            float sum = weights[0] + weights[1] + weights[2] + weights[3];
+            for (int k = 0; k < 4; ++k) {
+                influences[i].bones[k] = random.Range(0, boneCount - 1);
+                influences[i].weights[k] = weights[k] / sum;
+            }
+            positions[i].Set(random.Range(-4.0f, 4.0f), random.Range(-4.0f, 4.0f), random.Range(-4.0f, 4.0f));
+            normals[i] = Vector3(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), 1.0f).Normalized();
+        }
+
+        // Each bone transforms the vertex and the results are weighted, as skinning is usually described.
+        auto close = [](const Vector3& a, const Vector3& b) {
+            return xo::Abs(a.x - b.x) <= 1e-4f && xo::Abs(a.y - b.y) <= 1e-4f && xo::Abs(a.z - b.z) <= 1e-4f;
+        };
+        auto matchesReference = [&](const std::vector<Vector3>& outPositions, const std::vector<Vector3>* outNormals) {
+            for (int i = 0; i < count; ++i) {
+                Vector3 p(0.0f), n(0.0f);
+                for (int k = 0; k < 4; ++k) {
+                    const Matrix3x4& bone = palette[influences[i].bones[k]];
+                    p += bone.TransformPoint(positions[i]) * influences[i].weights[k];
+                    n += bone.TransformDirection(normals[i]) * influences[i].weights[k];
+                }
+                if (!close(outPositions[i], p) || (outNormals && !close((*outNormals)[i], n))) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        Skinning::Skin(palette, influences.data(), positions.data(), normals.data(), skinned.data(), skinnedNormals.data(), count);
+        test.ReportSuccessIf(matchesReference(skinned, &skinnedNormals), TEST_MSG("Skin did not match weighting each bone's transform."));
+
+        std::vector<Vector3> skinned4(count), threaded(count), threadedNormals(count);
+        Skinning::Skin(palette4, influences.data(), positions.data(), nullptr, skinned4.data(), nullptr, count);
+        test.ReportSuccessIf(matchesReference(skinned4, nullptr), TEST_MSG("Skin of a Matrix4x4 palette without normals did not match."));
+
+        // every vertex is skinned by the same kernel whichever thread takes it.
+        Skinning::Skin(palette, influences.data(), positions.data(), normals.data(), threaded.data(), threadedNormals.data(), count, 4);
+        bool threadsSame = true;
+        for (int i = 0; i < count; ++i) {
+            threadsSame = threadsSame && threaded[i] == skinned[i] && threadedNormals[i] == skinnedNormals[i];
+        }
+        test.ReportSuccessIf(threadsSame, TEST_MSG("Skin with four threads did not match one thread."));
+
+        std::vector<Vector3> inPlace(positions), inPlaceNormals(normals);
+        Skinning::Skin(palette, influences.data(), inPlace.data(), inPlaceNormals.data(), inPlace.data(), inPlaceNormals.data(), count);
+        bool inPlaceSame = true;
+        for (int i = 0; i < count; ++i) {
+            inPlaceSame = inPlaceSame && inPlace[i] == skinned[i] && inPlaceNormals[i] == skinnedNormals[i];
+        }
+        test.ReportSuccessIf(inPlaceSame, TEST_MSG("Skin in place did not match."));
+    });
+}
+
+void TestDualQuaternion() {
+    test("DualQuaternion", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::Quaternion;
+        using xo::DualQuaternion;
+        using xo::Skinning;
+        auto close = [](const Vector3& a, const Vector3& b) {
+            return xo::Abs(a.x - b.x) <= 1e-4f && xo::Abs(a.y - b.y) <= 1e-4f && xo::Abs(a.z - b.z) <= 1e-4f;
+        };
+        xo::Random random(11);
+        Quaternion ra = Quaternion::AxisAngleRadians(Vector3(1.0f, 2.0f, -1.0f).Normalized(), 1.1f);
+        Quaternion rb = Quaternion::AxisAngleRadians(Vector3(-0.5f, 1.0f, 2.0f).Normalized(), -2.3f);
+        Vector3 ta(1.0f, -2.0f, 3.0f), tb(-0.5f, 0.25f, 4.0f);
+        DualQuaternion a(ra, ta), b(rb, tb);
+        Matrix3x4 ma(ra, ta), mb(rb, tb);
+        Vector3 p(0.3f, -1.7f, 2.2f);
+
+        test.ReportSuccessIf(close(a.GetTranslation(), ta), TEST_MSG("GetTranslation did not give back the translation."));
+        test.ReportSuccessIf(close(a.TransformPoint(p), ma.TransformPoint(p)), TEST_MSG("TransformPoint did not match Matrix3x4::TransformPoint."));
+        test.ReportSuccessIf(close(a.TransformDirection(p), ma.TransformDirection(p)), TEST_MSG("TransformDirection did not match Matrix3x4::TransformDirection."));
+        test.ReportSuccessIf(close((a * b).TransformPoint(p), a.TransformPoint(b.TransformPoint(p))), TEST_MSG("a * b did not transform by b, then a."));
+        test.ReportSuccessIf(close(a.Inverse().TransformPoint(a.TransformPoint(p)), p), TEST_MSG("Inverse did not undo the transform."));
+        test.ReportSuccessIf(close(DualQuaternion(Matrix4x4(ma)).TransformPoint(p), ma.TransformPoint(p)), TEST_MSG("DualQuaternion(Matrix4x4) did not keep the transform."));
+        test.ReportSuccessIf(close(DualQuaternion::Identity.TransformPoint(p), p), TEST_MSG("Identity moved a point."));
+
+        // Scaling both parts, or negating them, is the same transform once normalized.
+        DualQuaternion scaled(Quaternion(ra.x * 3.0f, ra.y * 3.0f, ra.z * 3.0f, ra.w * 3.0f), Quaternion(a.dual.x * 3.0f, a.dual.y * 3.0f, a.dual.z * 3.0f, a.dual.w * 3.0f));
+        test.ReportSuccessIf(close(scaled.Normalized().TransformPoint(p), a.TransformPoint(p)), TEST_MSG("Normalized did not undo a scale."));
+        DualQuaternion negated(Quaternion(-rb.x, -rb.y, -rb.z, -rb.w), Quaternion(-b.dual.x, -b.dual.y, -b.dual.z, -b.dual.w));
+        test.ReportSuccessIf(close(DualQuaternion::Nlerp(a, b, 0.0f).TransformPoint(p), a.TransformPoint(p)), TEST_MSG("Nlerp at 0 was not a."));
+        test.ReportSuccessIf(close(DualQuaternion::Nlerp(a, b, 1.0f).TransformPoint(p), b.TransformPoint(p)), TEST_MSG("Nlerp at 1 was not b."));
+        test.ReportSuccessIf(close(DualQuaternion::Nlerp(a, negated, 0.3f).TransformPoint(p), DualQuaternion::Nlerp(a, b, 0.3f).TransformPoint(p)),
+                             TEST_MSG("Nlerp toward a negated b did not take the same path."));
+
+        // A blend of rigid transforms is rigid, so it keeps the distance between two points.
+        DualQuaternion half = DualQuaternion::Nlerp(a, b, 0.5f);
+        Vector3 q(-1.0f, 0.5f, 0.75f);
+        test.ReportSuccessIf(xo::Abs((half.TransformPoint(p) - half.TransformPoint(q)).Magnitude() - (p - q).Magnitude()) <= 1e-4f,
+                             TEST_MSG("Nlerp did not give a rigid transform."));
+
+        const int boneCount = 12;
+        DualQuaternion palette[boneCount];
+        Matrix3x4 matrices[boneCount];
+        for (int b = 0; b < boneCount; ++b) {
+            Vector3 axis(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), 1.0f);
+            Quaternion rotation = Quaternion::AxisAngleRadians(axis.Normalized(), random.Range(-3.0f, 3.0f));
+            Vector3 translation(random.Range(-2.0f, 2.0f), float(b), 0.5f);
+            palette[b] = DualQuaternion(rotation, translation);
+            matrices[b] = Matrix3x4(rotation, translation);
+            // either sign is the same bone, and the blend must not care which it's given.
+            if (b % 2) {
+                palette[b] = DualQuaternion(Quaternion(-rotation.x, -rotation.y, -rotation.z, -rotation.w), translation);
+            }
+        }
+
+        // 4099 leaves a tail for both the four and eight wide kernels.
+        const int count = 4099;
+        std::vector<Skinning::Influences> influences(count), single(count);
+        std::vector<Vector3> positions(count), normals(count), skinned(count), skinnedNormals(count);
+        for (int i = 0; i < count; ++i) {
+            float weights[4] = { random.Range(0.0f, 1.0f), random.Range(0.0f, 1.0f), i % 3 ? random.Range(0.0f, 1.0f) : 0.0f, i % 2 ? random.Range(0.0f, 1.0f) : 0.0f };
+            float sum = weights[0] + weights[1] + weights[2] + weights[3];
+            for (int k = 0; k < 4; ++k) {
+                influences[i].bones[k] = random.Range(0, boneCount - 1);
+                influences[i].weights[k] = weights[k] / sum;
+                single[i].bones[k] = influences[i].bones[0];
+                single[i].weights[k] = k == 0 ? 1.0f : 0.0f;
+            }
+            positions[i].Set(random.Range(-4.0f, 4.0f), random.Range(-4.0f, 4.0f), random.Range(-4.0f, 4.0f));
+            normals[i] = Vector3(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), 1.0f).Normalized();
+        }
+
+        Skinning::Skin(palette, influences.data(), positions.data(), normals.data(), skinned.data(), skinnedNormals.data(), count);
+        bool matches = true;
+        for (int i = 0; i < count; ++i) {
+            DualQuaternion blended(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+            for (int k = 0; k < 4; ++k) {
+                DualQuaternion bone = palette[influences[i].bones[k]];
+                float weight = influences[i].weights[k];
+                if (Vector4::Dot(Vector4(bone.real), Vector4(palette[influences[i].bones[0]].real)) < 0.0f) {
+                    weight = -weight;
+                }
+                Vector4 r = Vector4(blended.real) + Vector4(bone.real) * weight;
+                Vector4 d = Vector4(blended.dual) + Vector4(bone.dual) * weight;
+                blended = DualQuaternion(Quaternion(r.x, r.y, r.z, r.w), Quaternion(d.x, d.y, d.z, d.w));
+            }
+            blended.Normalize();
+            matches = matches && close(skinned[i], blended.TransformPoint(positions[i])) && close(skinnedNormals[i], blended.TransformDirection(normals[i]));
+        }
+        test.ReportSuccessIf(matches, TEST_MSG("Skin of dual quaternions did not match blending them one vertex at a time."));
+
+        // with one bone per vertex, dual quaternion and matrix skinning are the same transform.
+        std::vector<Vector3> dualSingle(count), matrixSingle(count);
+        Skinning::Skin(palette, single.data(), positions.data(), nullptr, dualSingle.data(), nullptr, count);
+        Skinning::Skin(matrices, single.data(), positions.data(), nullptr, matrixSingle.data(), nullptr, count);
+        bool singleSame = true;
+        for (int i = 0; i < count; ++i) {
+            singleSame = singleSame && close(dualSingle[i], matrixSingle[i]);
+        }
+        test.ReportSuccessIf(singleSame, TEST_MSG("Skin of dual quaternions with one bone did not match the matrices."));
+
+        std::vector<Vector3> threaded(count), threadedNormals(count);
+        Skinning::Skin(palette, influences.data(), positions.data(), normals.data(), threaded.data(), threadedNormals.data(), count, 4);
+        std::vector<Vector3> inPlace(positions), inPlaceNormals(normals);
+        Skinning::Skin(palette, influences.data(), inPlace.data(), inPlaceNormals.data(), inPlace.data(), inPlaceNormals.data(), count);
+        bool same = true;
+        for (int i = 0; i < count; ++i) {
+            same = same && threaded[i] == skinned[i] && threadedNormals[i] == skinnedNormals[i];
+            same = same && inPlace[i] == skinned[i] && inPlaceNormals[i] == skinnedNormals[i];
+        }
+        test.ReportSuccessIf(same, TEST_MSG("Skin of dual quaternions with four threads or in place did not match."));
+    });
+}
+
+void TestHalf() {
+    test("Half", []{
+        using xo::Vector2;
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::FloatToHalf;
+        using xo::HalfToFloat;
+        auto isNaN = [](uint16_t h) { return (h & 0x7c00) == 0x7c00 && (h & 0x03ff) != 0; };
+        auto bitsOf = [](float f) { union { float f; uint32_t u; } bits; bits.f = f; return bits.u; };
+
+        test.ReportSuccessIf(FloatToHalf(1.0f) == 0x3c00, TEST_MSG("1 did not convert to a half."));
+        test.ReportSuccessIf(FloatToHalf(-2.0f) == 0xc000, TEST_MSG("-2 did not convert to a half."));
+        test.ReportSuccessIf(FloatToHalf(-0.0f) == 0x8000, TEST_MSG("-0 lost its sign."));
+        test.ReportSuccessIf(FloatToHalf(65504.0f) == 0x7bff, TEST_MSG("the largest half did not convert."));
+        test.ReportSuccessIf(FloatToHalf(65519.0f) == 0x7bff, TEST_MSG("65519 should round down to the largest half."));
+        test.ReportSuccessIf(FloatToHalf(65520.0f) == 0x7c00, TEST_MSG("65520 should round up to infinity."));
+        test.ReportSuccessIf(FloatToHalf(-std::numeric_limits<float>::infinity()) == 0xfc00, TEST_MSG("-infinity did not convert."));
+        test.ReportSuccessIf(isNaN(FloatToHalf(xo::HexFloat(0x7fc00000u))), TEST_MSG("NaN did not stay NaN."));
+        // ties go to the even mantissa, in both directions.
+        test.ReportSuccessIf(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3c00, TEST_MSG("a tie above 1 should round down to even."));
+        test.ReportSuccessIf(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3c02, TEST_MSG("a tie should round up to even."));
+        // denormals: 2^-24 is the smallest, and half of it is a tie with zero.
+        test.ReportSuccessIf(FloatToHalf(xo::HexFloat(0x33800000u)) == 0x0001, TEST_MSG("2^-24 should be the smallest denormal half."));
+        test.ReportSuccessIf(FloatToHalf(xo::HexFloat(0x33000000u)) == 0x0000, TEST_MSG("2^-25 should round to zero, which is even."));
+        test.ReportSuccessIf(FloatToHalf(xo::HexFloat(0x33c00000u)) == 0x0002, TEST_MSG("3 * 2^-25 should round up to even."));
+        test.ReportSuccessIf(FloatToHalf(xo::HexFloat(0x38800000u)) == 0x0400, TEST_MSG("2^-14 should be the smallest normal half."));
+        test.ReportSuccessIf(HalfToFloat(0x0001) == xo::HexFloat(0x33800000u), TEST_MSG("the smallest denormal half did not widen exactly."));
+
+        // every half widens to a float that converts back to it.
+        std::vector<uint16_t> halves(65536), converted(65536);
+        std::vector<float> floats(65536), widened(65536);
+        bool roundTrips = true;
+        for (int i = 0; i < 65536; ++i) {
+            halves[i] = (uint16_t)i;
+            floats[i] = HalfToFloat(halves[i]);
+            uint16_t h = FloatToHalf(floats[i]);
+            roundTrips = roundTrips && (isNaN(halves[i]) ? isNaN(h) : h == halves[i]);
+        }
+        test.ReportSuccessIf(roundTrips, TEST_MSG("a half did not survive HalfToFloat then FloatToHalf."));
+
+        // The arrays match the single conversions. Floats halfway between halves and a quarter of the way past
+        // them check the vector code's rounding. NaNs only need to stay NaN, since F16C keeps their payloads.
+        std::vector<float> between(65536);
+        for (int i = 0; i < 65536; ++i) {
+            between[i] = xo::HexFloat(bitsOf(floats[i]) + (i % 2 ? 0x1000u : 0x0800u));
+        }
+        // Both the SSE2 and the F16C kernels, where the CPU has F16C.
+        for (xo::SIMDTier tier : { xo::SIMDTier::SSE2, xo::SIMDTier::AVX512 }) {
+            xo::InitDispatch(tier);
+            xo::FromHalf(halves.data(), widened.data(), 65536);
+            xo::ToHalf(between.data(), converted.data(), 65536);
+            bool arraysMatch = true;
+            for (int i = 0; i < 65536; ++i) {
+                uint16_t h = FloatToHalf(between[i]);
+                arraysMatch = arraysMatch && (isNaN(halves[i]) ? widened[i] != widened[i] : widened[i] == floats[i]);
+                arraysMatch = arraysMatch && (isNaN(h) ? isNaN(converted[i]) : converted[i] == h);
+            }
+            test.ReportSuccessIf(arraysMatch, TEST_MSG("ToHalf or FromHalf of floats did not match the single conversions."));
+        }
+        xo::InitDispatch();
+
+        // 37 vectors leave a tail for each kernel, and one more element checks nothing is written past the end.
+        const int count = 37;
+        Vector2 v2[count], w2[count + 1];
+        Vector3 v3[count], w3[count + 1];
+        Vector4 v4[count], w4[count + 1];
+        xo::Half2 h2[count + 1];
+        xo::Half3 h3[count + 1];
+        xo::Half4 h4[count + 1];
+        for (int i = 0; i < count; ++i) {
+            float f = float(i) * 0.37f - 5.0f;
+            v2[i].Set(f, -f * 3.0f);
+            v3[i].Set(f, f * f, 1.0f / (f + 5.5f));
+            v4[i].Set(f, f * 1000.0f, f * 1e-6f, -f);
+        }
+        h2[count].x = h3[count].z = h4[count].w = 0x1234;
+        w2[count].x = w3[count].z = w4[count].w = 12.0f;
+        xo::ToHalf(v2, h2, count);
+        xo::ToHalf(v3, h3, count);
+        xo::ToHalf(v4, h4, count);
+        xo::FromHalf(h2, w2, count);
+        xo::FromHalf(h3, w3, count);
+        xo::FromHalf(h4, w4, count);
+        bool vectorsMatch = true;
+        for (int i = 0; i < count; ++i) {
+            xo::Half2 e2(v2[i]);
+            xo::Half3 e3(v3[i]);
+            xo::Half4 e4(v4[i]);
+            vectorsMatch = vectorsMatch && h2[i].x == e2.x && h2[i].y == e2.y;
+            vectorsMatch = vectorsMatch && h3[i].x == e3.x && h3[i].y == e3.y && h3[i].z == e3.z;
+            vectorsMatch = vectorsMatch && h4[i].x == e4.x && h4[i].y == e4.y && h4[i].z == e4.z && h4[i].w == e4.w;
+            Vector2 u2 = e2;
+            Vector3 u3 = e3;
+            Vector4 u4 = e4;
+            vectorsMatch = vectorsMatch && w2[i].x == u2.x && w2[i].y == u2.y;
+            vectorsMatch = vectorsMatch && w3[i].x == u3.x && w3[i].y == u3.y && w3[i].z == u3.z;
+            vectorsMatch = vectorsMatch && w4[i].x == u4.x && w4[i].y == u4.y && w4[i].z == u4.z && w4[i].w == u4.w;
+        }
+        test.ReportSuccessIf(vectorsMatch, TEST_MSG("ToHalf or FromHalf of vectors did not match Half2, Half3 and Half4."));
+        test.ReportSuccessIf(h2[count].x == 0x1234 && h3[count].z == 0x1234 && h4[count].w == 0x1234, TEST_MSG("ToHalf wrote past the end."));
+        test.ReportSuccessIf(w2[count].x == 12.0f && w3[count].z == 12.0f && w4[count].w == 12.0f, TEST_MSG("FromHalf wrote past the end."));
+        test.ReportSuccessIf(xo::Abs(w4[3].y - v4[3].y) <= xo::Abs(v4[3].y) / 1024.0f, TEST_MSG("a half was not within half precision."));
+    });
+}
+
+void TestVector3Array() {
+    test("Vector3Array", []{
+        using xo::Vector3;
+        using xo::Float3;
+        using xo::Matrix4x4;
+        using xo::Vector3Array;
+        test.ReportSuccessIf(sizeof(Float3) == 12, TEST_MSG("Float3 should be three floats with no padding."));
+
+        // every count up to 13 covers the 4 and 8 wide loops with each tail, and a last element on its own.
+        const int count = 13;
+        Vector3 v[count];
+        for (int i = 0; i < count; ++i) {
+            v[i] = Vector3(float(i) * 1.5f - 4.0f, 2.0f - float(i), 0.25f * float(i * i));
+        }
+        Matrix4x4 m = Matrix4x4::RotationDegrees(10.0f, 50.0f, -30.0f) * Matrix4x4::Translation(3.0f, -1.0f, 2.0f);
+        xo::Matrix3x4 affine(m);
+        bool packs = true, unpacks = true, inBounds = true, transforms = true;
+        for (int n = 0; n <= count; ++n) {
+            Float3 packed[count + 1];
+            Vector3 unpacked[count + 1];
+            packed[n] = Float3(7.0f, 8.0f, 9.0f);
+            unpacked[n] = Vector3(7.0f, 8.0f, 9.0f);
+            xo::Pack(v, packed, n);
+            xo::Unpack(packed, unpacked, n);
+            for (int i = 0; i < n; ++i) {
+                packs = packs && packed[i].x == v[i].x && packed[i].y == v[i].y && packed[i].z == v[i].z;
+                unpacks = unpacks && unpacked[i].x == v[i].x && unpacked[i].y == v[i].y && unpacked[i].z == v[i].z;
+            }
+            inBounds = inBounds && packed[n].x == 7.0f && packed[n].z == 9.0f && unpacked[n] == Vector3(7.0f, 8.0f, 9.0f);
+
+            // Both the SSE2 and the wider kernels, where the CPU has them.
+            for (xo::SIMDTier tier : { xo::SIMDTier::SSE2, xo::SIMDTier::AVX512 }) {
+                xo::InitDispatch(tier);
+                Vector3 points[count], dirs[count];
+                Float3 packedPoints[count + 1], packedDirs[count + 1], affinePoints[count];
+                packedPoints[n] = packedDirs[n] = Float3(7.0f, 8.0f, 9.0f);
+                m.TransformPoints(v, points, n);
+                m.TransformDirections(v, dirs, n);
+                m.TransformPoints(packed, packedPoints, n);
+                m.TransformDirections(packed, packedDirs, n);
+                affine.TransformPoints(packed, affinePoints, n);
+                // in place.
+                m.TransformPoints(packed, packed, n);
+                for (int i = 0; i < n; ++i) {
+                    transforms = transforms && Vector3(packedPoints[i]) == points[i] && Vector3(packedDirs[i]) == dirs[i];
+                    transforms = transforms && Vector3(affinePoints[i]) == points[i] && Vector3(packed[i]) == points[i];
+                }
+                inBounds = inBounds && packedPoints[n].x == 7.0f && packedDirs[n].z == 9.0f;
+                xo::Pack(v, packed, n);
+            }
+            xo::InitDispatch();
+        }
+        test.ReportSuccessIf(packs, TEST_MSG("Pack did not copy x, y and z."));
+        test.ReportSuccessIf(unpacks, TEST_MSG("Unpack did not copy x, y and z."));
+        test.ReportSuccessIf(inBounds, TEST_MSG("an array function wrote past the end."));
+        test.ReportSuccessIf(transforms, TEST_MSG("transforming Float3s did not match transforming Vector3s."));
+
+        Vector3Array a(v, 5);
+        test.ReportSuccessIf(a.GetCount() == 5, TEST_MSG("Vector3Array(const Vector3*, size_t) has the wrong count."));
+        test.ReportSuccessIf(a.Get(4), v[4], TEST_MSG("Vector3Array(const Vector3*, size_t) did not pack the vectors."));
+        a.Add(v[9]);
+        a.Add(v + 5, 4);
+        a.Set(1, Vector3::One);
+        test.ReportSuccessIf(a.GetCount() == 10, TEST_MSG("Add did not grow the array."));
+        test.ReportSuccessIf(a.Get(5), v[9], TEST_MSG("Add(const Vector3&) did not add to the end."));
+        test.ReportSuccessIf(a.Get(9), v[8], TEST_MSG("Add(const Vector3*, size_t) did not add to the end."));
+        test.ReportSuccessIf(a[1].x == 1.0f && a.GetData()[1].z == 1.0f, TEST_MSG("Set did not set the element."));
+        Vector3 range[3];
+        a.Set(6, v, 3);
+        a.Get(6, range, 3);
+        test.ReportSuccessIf(range[0] == v[0] && range[2] == v[2], TEST_MSG("the array forms of Get and Set did not round trip."));
+        a.TransformPoints(m);
+        test.ReportSuccessIf(a.Get(8), affine.TransformPoint(v[2]), TEST_MSG("TransformPoints did not transform every element."));
+        a.Resize(2);
+        test.ReportSuccessIf(a.GetCount() == 2 && a.Get(0) == affine.TransformPoint(v[0]), TEST_MSG("Resize did not keep the first elements."));
+        a.Clear();
+        test.ReportSuccessIf(a.GetCount() == 0, TEST_MSG("Clear did not empty the array."));
+    });
+}
+
+void TestAlignedAllocator() {
+    test("AlignedAllocator", []{
+        using xo::Matrix4x4;
+        auto alignedTo = [](const void* p, uintptr_t align) { return ((uintptr_t)p & (align - 1)) == 0; };
+
+        // each push may reallocate, and every allocation should be aligned.
+        xo::vector<Matrix4x4> matrices;
+        bool aligned = true;
+        for (int i = 0; i < 33; ++i) {
+            matrices.push_back(Matrix4x4::RotationDegrees(float(i), 0.0f, 0.0f));
+            aligned = aligned && xo::IsAligned16(matrices.data());
+        }
+        test.ReportSuccessIf(aligned, TEST_MSG("xo::vector<Matrix4x4> was not 16 byte aligned."));
+        test.ReportSuccessIf(matrices[32][1], Matrix4x4::RotationDegrees(32.0f, 0.0f, 0.0f)[1], TEST_MSG("xo::vector lost an element when it grew."));
+
+        xo::vector<float, 32> avx(13, 1.0f);
+        xo::vector<char, 64> line(3);
+        std::vector<int, xo::AlignedAllocator<int, 64>> ints(5, 7);
+        test.ReportSuccessIf(alignedTo(avx.data(), 32) && avx[12] == 1.0f, TEST_MSG("xo::vector<float, 32> was not 32 byte aligned."));
+        test.ReportSuccessIf(alignedTo(line.data(), 64), TEST_MSG("xo::vector<char, 64> was not 64 byte aligned."));
+        test.ReportSuccessIf(alignedTo(ints.data(), 64) && ints[4] == 7, TEST_MSG("std::vector with an AlignedAllocator was not aligned."));
+
+        // the alignment of the element type wins when it's larger.
+        struct alignas(64) Line { float f[16]; };
+        test.ReportSuccessIf(xo::AlignedAllocator<Line>::Alignment == 64, TEST_MSG("AlignedAllocator should use the alignment of T when it's larger."));
+        xo::vector<Line> lines(2);
+        test.ReportSuccessIf(alignedTo(lines.data(), 64), TEST_MSG("xo::vector of a 64 byte aligned type was not 64 byte aligned."));
+        test.ReportSuccessIf(xo::AlignedAllocator<int, 32>() == xo::AlignedAllocator<float, 32>(), TEST_MSG("AlignedAllocators of the same alignment should compare equal."));
+        test.ReportSuccessIf(xo::AlignedAllocator<int>() != xo::AlignedAllocator<Line>(), TEST_MSG("AlignedAllocators that align differently should not compare equal."));
+    });
+}
+
+void TestFrameArena() {
+    test("FrameArena", []{
+        using xo::Vector3;
+        using xo::Matrix4x4;
+        using xo::FrameArena;
+        auto alignedTo = [](const void* p, uintptr_t align) { return ((uintptr_t)p & (align - 1)) == 0; };
+
+        FrameArena arena(4096);
+        char* bytes = (char*)arena.Allocate(100, 1);
+        Vector3* points = arena.AllocateVector3s(10);
+        Matrix4x4* matrices = arena.AllocateMatrix4x4s(3);
+        float* line = (float*)arena.Allocate(sizeof(float) * 16, 64);
+        test.ReportSuccessIf(bytes && xo::IsAligned16(points) && xo::IsAligned16(matrices) && alignedTo(line, 64), TEST_MSG("an allocation was not aligned."));
+        test.ReportSuccessIf((char*)points >= bytes + 100 && (char*)matrices >= (char*)(points + 10) && (char*)line >= (char*)(matrices + 3), TEST_MSG("allocations overlapped."));
+        for (int i = 0; i < 10; ++i) {
+            points[i] = Vector3(float(i));
+        }
+        matrices[2] = Matrix4x4::Translation(1.0f, 2.0f, 3.0f);
+        test.ReportSuccessIf(points[9], Vector3(9.0f), TEST_MSG("an arena array did not hold its values."));
+        FrameArena::Stats stats = arena.GetStats();
+        test.ReportSuccessIf(stats.allocationCount == 4 && stats.blockCount == 1 && stats.used >= 100 + sizeof(Vector3) * 10 + sizeof(Matrix4x4) * 3 + 64, TEST_MSG("the stats did not count the allocations."));
+
+        // more than a block chains another, and Reset replaces both with one.
+        char* big = (char*)arena.Allocate(10000);
+        big[9999] = 1;
+        stats = arena.GetStats();
+        test.ReportSuccessIf(big && stats.blockCount == 2 && stats.capacity >= 4096 + 10000, TEST_MSG("a large allocation did not chain a block."));
+        size_t frameBytes = stats.used;
+        arena.Reset();
+        stats = arena.GetStats();
+        test.ReportSuccessIf(stats.blockCount == 1 && stats.capacity >= frameBytes, TEST_MSG("Reset did not make one block for the whole frame."));
+        test.ReportSuccessIf(stats.used == 0 && stats.allocationCount == 0 && stats.peak == frameBytes, TEST_MSG("Reset should clear used, and keep the peak."));
+        Vector3* first = arena.AllocateVector3s(10);
+        arena.Allocate(10000);
+        test.ReportSuccessIf(arena.GetStats().blockCount == 1, TEST_MSG("the same frame again should fit the block from Reset."));
+        arena.Reset();
+        test.ReportSuccessIf(arena.AllocateVector3s(10) == first, TEST_MSG("Reset did not start the next frame at the front of the block."));
+        arena.Release();
+        test.ReportSuccessIf(arena.GetStats().capacity == 0 && arena.AllocateMatrix4x4s(2) != nullptr, TEST_MSG("Release did not free the blocks, or the arena was not usable after."));
+
+        FrameArena huge(1 << 20, true);
+        char* hugeBytes = (char*)huge.Allocate(1 << 20);
+        hugeBytes[(1 << 20) - 1] = 1;
+        test.ReportSuccessIf(hugeBytes && huge.GetStats().capacity >= (1 << 20), TEST_MSG("an arena with huge pages did not allocate."));
+
+        FrameArena* other = nullptr;
+        std::thread thread([&other]() { other = &FrameArena::ThreadArena(); });
+        thread.join();
+        test.ReportSuccessIf(&FrameArena::ThreadArena() == &FrameArena::ThreadArena() && other != &FrameArena::ThreadArena(), TEST_MSG("ThreadArena should be one arena per thread."));
+    });
+}
+
 int main() {
 
 #if defined(XO_SSE)
     xo::sse::ThrowNoExceptions();
 #endif
     cout << XO_MATH_COMPILER_INFO << endl;
+    cout << "xo-math batch kernels use simd: " << xo::GetSIMDTierName(xo::GetDispatchTier()) << endl;
 
 #if defined(XO_SSE)
     xo::sse::GetAllMXCSRInfo(cout);
@@ -647,12 +2263,33 @@ int main() {
     cout.precision(12);
     cout << std::fixed;
 
+    TestTrig();
     TestVector2Operators();
     TestVector2Methods();
     TestVector3Operators();
     TestVector3Methods();
     TestVector4Operators();
     TestVector4Methods();
+    TestVector3x4();
+    TestVector4x4();
+    TestMatrix4x4Transform();
+    TestMatrix4x4Multiply();
+    TestRandom();
+    TestVector3Random();
+    TestDispatch();
+    TestVector3x8();
+    TestVector4x8();
+    TestMatrix4x4Inverse();
+    TestMatrix3x4();
+    TestQuaternion();
+    TestTransform();
+    TestHierarchy();
+    TestSkinning();
+    TestDualQuaternion();
+    TestHalf();
+    TestVector3Array();
+    TestAlignedAllocator();
+    TestFrameArena();
 
     auto m = xo::Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f);
 
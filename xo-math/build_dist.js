@@ -10,18 +10,44 @@ var g_SourceInputName = 'xo-math.cpp';
 var g_SourceInputText = null;
 
 var g_IncludeNames = [
+  'AlignedAllocator.h',
   'DetectSIMD.h',
+  'Dispatch.h',
+  'DualQuaternion.h',
+  'DualQuaternionInline.h',
+  'FrameArena.h',
+  'FrameArenaInline.h',
+  'Half.h',
+  'Hierarchy.h',
+  'HierarchyInline.h',
+  'Matrix3x4.h',
+  'Matrix3x4Inline.h',
   'Matrix4x4.h',
   'Matrix4x4Inline.h',
   'Quaternion.h',
   'QuaternionInline.h',
+  'Random.h',
+  'Skinning.h',
   'SSE.h',
+  'Transform.h',
+  'TransformInline.h',
+  'Trig.h',
   'Vector2.h',
   'Vector2Inline.h',
+  'Vector3x4.h',
+  'Vector3x4Inline.h',
   'Vector3.h',
   'Vector3Inline.h',
+  'Vector3Array.h',
+  'Vector3ArrayInline.h',
+  'Vector3x8.h',
+  'Vector3x8Inline.h',
   'Vector4.h',
   'Vector4Inline.h',
+  'Vector4x4.h',
+  'Vector4x4Inline.h',
+  'Vector4x8.h',
+  'Vector4x8Inline.h',
 ];
 var g_IncludesText = [];
 for(var i = 0; i < g_IncludeNames.length; ++i) {
@@ -34,11 +60,22 @@ var g_StraightCopyIncludes = [
 ];
 
 var g_SourcesNames = [
+  'Dispatch.cpp',
+  'DualQuaternion.cpp',
+  'FrameArena.cpp',
+  'Half.cpp',
+  'Hierarchy.cpp',
+  'Matrix3x4.cpp',
   'Matrix4x4.cpp',
   'Quaternion.cpp',
+  'Random.cpp',
+  'Skinning.cpp',
   'SSE.cpp',
+  'Transform.cpp',
+  'Trig.cpp',
   'Vector2.cpp',
   'Vector3.cpp',
+  'Vector3Array.cpp',
   'Vector4.cpp'
 ];
 var g_SourcesText = [];
@@ -67,6 +104,13 @@ function SaveIncludeOutFile() {
         break;
       }
     }
+    // with XO_HEADER_ONLY the header includes the sources as well.
+    for(var j = 0; j < g_SourcesNames.length && !includeFound; ++j) {
+      if(lines[i].indexOf('"../src/' + g_SourcesNames[j] + '"') > 0) {
+        output += 'XOMATH_BEGIN_XO_NS();\n' + g_SourcesText[g_SourcesNames[j]] + 'XOMATH_END_XO_NS();\n';
+        includeFound = true;
+      }
+    }
     if(!includeFound) {
       output += lines[i] + '\n';
     }
@@ -109,6 +153,11 @@ function TrySaveIncludeOutFile() {
       return;
     }
   }
+  for(var i = 0; i < g_SourcesNames.length; ++i) {
+    if(!g_SourcesText[g_SourcesNames[i]]) {
+      return;
+    }
+  }
   SaveIncludeOutFile();
 }
 
@@ -130,6 +179,7 @@ function IncludeLoaded(includeName, text) {
 
 function SourceLoaded(sourceName, text) {
   g_SourcesText[sourceName] = text+'\n';
+  TrySaveIncludeOutFile();
   TrySaveSourceOutFile();
 }
 
@@ -152,6 +202,8 @@ function ReadInclude(name) {
     var split = data.toString().split('\n');
     var txt = '';
 
+    // headers without a namespace, such as DetectSIMD.h, are only preprocessor and are read from the first directive.
+    var hasNamespace = data.toString().indexOf('XOMATH_BEGIN_XO_NS') >= 0;
     var reading = false;
     var optionallyRemoveNextEmptyLine = false;
     for(var i = 0; i < split.length; ++i) {
@@ -207,7 +259,7 @@ function ReadInclude(name) {
           txt += split[i] + '\n';
       }
       else {
-        if(split[i].indexOf('XOMATH_BEGIN_XO_NS') >= 0) {
+        if(split[i].indexOf('XOMATH_BEGIN_XO_NS') >= 0 || (!hasNamespace && split[i].indexOf('#') == 0)) {
           reading = true;
           txt += split[i] + '\n';
         } else if (split[i].indexOf('*/') >= 0) {
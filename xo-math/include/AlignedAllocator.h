@@ -0,0 +1,147 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    // Returns size bytes aligned to align, which is a power of two, or null when out of memory. Up to 16 bytes go
+    // through XO_16ALIGNED_MALLOC, so a user's replacement for it is used by the containers too.
+    _XOINL void* AlignedMalloc(size_t size, size_t align) {
+#if defined(XO_16ALIGNED_MALLOC) && defined(XO_16ALIGNED_FREE)
+        if (align <= 16) {
+            return XO_16ALIGNED_MALLOC(size);
+        }
+#endif
+#if defined(XO_SSE)
+        return _mm_malloc(size, align);
+#else
+        // malloc is only aligned for the fundamental types, so this takes align more bytes, and keeps the pointer
+        // malloc returned in the word before the aligned block for AlignedFree.
+        if (align < sizeof(void*)) {
+            align = sizeof(void*);
+        }
+        void* raw = malloc(size + align);
+        if (!raw) {
+            return nullptr;
+        }
+        void* p = (void*)(((uintptr_t)raw + align) & ~(uintptr_t)(align - 1));
+        ((void**)p)[-1] = raw;
+        return p;
+#endif
+    }
+
+    // Frees p, which AlignedMalloc returned for the same align.
+    _XOINL void AlignedFree(void* p, size_t align) {
+#if defined(XO_16ALIGNED_MALLOC) && defined(XO_16ALIGNED_FREE)
+        if (align <= 16) {
+            XO_16ALIGNED_FREE(p);
+            return;
+        }
+#endif
+#if defined(XO_SSE)
+        _mm_free(p);
+#else
+        (void)align;
+        if (p) {
+            free(((void**)p)[-1]);
+        }
+#endif
+    }
+}
+
+//! @brief A standard library allocator that aligns every allocation to Align bytes.
+//!
+//! _XO_OVERLOAD_NEW_DELETE aligns new and delete of the xo-math types, but before C++17 containers allocate with
+//! std::allocator, which ignores that, and only guarantees the alignment of the fundamental types. Elements can
+//! then be misaligned for the aligned loads xo-math's SSE paths use. Containers that use this allocator, such as
+//! xo::vector, are aligned to Align or to the alignment of T, whichever is larger.
+//!
+//! Align is 16 by default, which goes through XO_16ALIGNED_MALLOC and XO_16ALIGNED_FREE. Use 32 for arrays read
+//! with AVX loads, or 64 to start an array on a cache line, so no element straddles one when the element size
+//! divides 64.
+//! @sa https://en.cppreference.com/w/cpp/named_req/Allocator
+template <typename T, size_t Align = 16>
+class AlignedAllocator {
+public:
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "AlignedAllocator alignment must be a power of two.");
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::true_type is_always_equal;
+
+    //! The std::allocator_traits default can't rebind an allocator with a size_t parameter, so this is given.
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Align> other;
+    };
+
+    //! The alignment of every allocation.
+    static const size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    AlignedAllocator() {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    //! Returns memory for n elements, without constructing them. Throws std::bad_alloc when out of memory.
+    T* allocate(size_t n) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        void* p = xo_internal::AlignedMalloc(n * sizeof(T), Alignment);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return (T*)p;
+    }
+
+    //! Frees memory allocate returned.
+    void deallocate(T* p, size_t) {
+        xo_internal::AlignedFree(p, Alignment);
+    }
+
+    size_t max_size() const {
+        return ~(size_t)0 / sizeof(T);
+    }
+};
+
+//! AlignedAllocators compare equal when they allocate to the same alignment, which is Align or the alignment of
+//! the element type, whichever is larger. Those can free each other's memory, since AlignedFree picks how to free
+//! by that alignment.
+template <typename T, typename U, size_t Align>
+bool operator == (const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) {
+    return AlignedAllocator<T, Align>::Alignment == AlignedAllocator<U, Align>::Alignment;
+}
+template <typename T, typename U, size_t Align>
+bool operator != (const AlignedAllocator<T, Align>& a, const AlignedAllocator<U, Align>& b) {
+    return !(a == b);
+}
+
+//! A std::vector aligned with AlignedAllocator, such as xo::vector<Matrix4x4> or xo::vector<float, 32>.
+template <typename T, size_t Align = 16>
+using vector = std::vector<T, AlignedAllocator<T, Align>>;
+
+XOMATH_END_XO_NS();
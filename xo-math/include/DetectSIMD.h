@@ -51,7 +51,9 @@
 #       define XO_AVX 1
 #       define XO_AVX2 1
 #   endif
-//! @todo add AVX512 for msvc when it exists.
+#   if defined(__AVX512F__)
+#       define XO_AVX512 1
+#   endif
 #elif defined(__clang__) || defined (__GNUC__)
 #   if defined(__SSE__)
 #       define XO_SSE 1
@@ -112,6 +114,42 @@
 #endif
 
 
+// Runtime dispatch. With XO_DISPATCH the batch kernels are also built for instruction sets above what the compiler
+// targets, and the best one the CPU supports is picked at runtime. See Dispatch.h.
+// Define XO_NO_DISPATCH to only build for what the compiler targets.
+// Define XO_NO_AVX512 to leave out the AVX-512 kernels, for hosts where running 512 bit instructions lowers the clock
+// speed by more than the wider kernels gain. InitDispatch(SIMDTier::AVX2) does the same at runtime.
+#if !defined(XO_NO_DISPATCH) && defined(XO_SSE2)
+#   if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#       define XO_DISPATCH 1
+#   endif
+#endif
+
+// _XO_KERNELS_<ISA> is defined when batch kernels for that ISA are built, either because the compiler targets it
+// or for runtime dispatch. _XO_TARGET_<ISA> marks a function as using that ISA. msvc allows any intrinsic without 
+// marking functions.
+#if defined(XO_AVX) || defined(XO_DISPATCH)
+#   define _XO_KERNELS_AVX 1
+#endif
+#if defined(XO_AVX2) || defined(XO_DISPATCH)
+#   define _XO_KERNELS_AVX2 1
+#endif
+#if (defined(XO_AVX512) || defined(XO_DISPATCH)) && !defined(XO_NO_AVX512)
+#   define _XO_KERNELS_AVX512 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   define _XO_TARGET_AVX
+#   define _XO_TARGET_AVX2
+#   define _XO_TARGET_AVX512
+#else
+#   define _XO_TARGET_AVX __attribute__((target("avx")))
+// The AVX2 tier includes F16C, see DetectSIMDTier.
+#   define _XO_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+// The AVX-512 tier needs F, DQ, BW and VL, see DetectSIMDTier.
+#   define _XO_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+#endif
+
 #if defined(_MSC_VER) && !defined(_XO_MATH_OBJ)
 #   pragma message("xo-math simd support: " XO_MATH_HIGHEST_SIMD)
 
@@ -0,0 +1,189 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+// Runtime CPU dispatch.
+//
+// The batch functions (Matrix4x4::TransformPoints, Matrix4x4::MultiplyBatch, the trig array functions and so on)
+// call through a table of kernels. The table is picked by InitDispatch, which runs automatically on the first call
+// to any batch function. A binary compiled for SSE2 will still use the AVX and AVX2 kernels when the CPU and
+// operating system support them, as long as XO_DISPATCH is defined (see DetectSIMD.h).
+//
+// The kernels compiled without XO_DISPATCH are only those the compiler targets, and InitDispatch then picks the
+// highest of them without checking the CPU.
+//
+// The AVX-512 kernels use mask registers for the ends of arrays. AVX-512 includes FMA, so the compiler may fuse 
+// their multiplies and adds, and results can differ from the other tiers in the last bit.
+
+//! SIMD instruction set tiers used by the batch kernels, lowest to highest. Each tier implies those below it.
+enum class SIMDTier {
+    None,   //!< No SIMD, scalar code only.
+    SSE2,
+    AVX,
+    AVX2,
+    AVX512,
+};
+
+//! Returns the highest SIMDTier supported by both the running CPU and the operating system, using cpuid.
+//! Returns SIMDTier::None on platforms without cpuid.
+SIMDTier DetectSIMDTier();
+
+//! Selects the batch kernels for the highest tier that was built, is supported by the CPU, and is no higher than
+//! maxTier.
+//! There's no need to call this, the batch functions call it on first use. Calling it at startup avoids that cost
+//! on the first batch call, and a lower maxTier can force older kernels for testing or comparisons.
+//! It's safe to call from any thread, but calls made while batch functions run on other threads may give those
+//! calls either table.
+void InitDispatch(SIMDTier maxTier = SIMDTier::AVX512);
+
+//! Returns the tier of the kernels selected by InitDispatch, calling it first when it hasn't been yet.
+//! For logging alongside XO_MATH_HIGHEST_SIMD, which is the tier the compiler targets.
+SIMDTier GetDispatchTier();
+
+//! Returns the name of tier, spelled as in XO_MATH_HIGHEST_SIMD. For example "sse2" or "avx2".
+const char* GetSIMDTierName(SIMDTier tier);
+
+namespace xo_internal
+{
+    // The blends of Quaternion::SlerpBatch, NlerpBatch and FastSlerpBatch, which share their kernels.
+    enum class QuaternionBlend {
+        Slerp,
+        Nlerp,
+        FastSlerp,
+    };
+
+    // The baseline kernels, built for what the compiler targets. Without SSE2 these are called directly.
+    void TransformVector3Array(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    void TransformVector4Array(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    void MultiplyBatch(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    void MultiplyIndexedBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    void SinCosArray(const float* f, float* s, float* c, size_t n, bool fast);
+    void DotVector3Array(const Vector3* a, const Vector3* b, float* out, size_t n);
+    void NormalizeVector3Array(const Vector3* in, Vector3* out, size_t n);
+    void RotateVector3Batch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+    void BlendQuaternionBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+    void SkinVertices(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                      const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    void SkinVerticesDualQuaternion(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                    const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    void FloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+    void HalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+    void TransformFloat3Array(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+
+#if defined(XO_SSE2)
+    // The kernels behind the batch functions. One table is built per tier, see Dispatch.cpp.
+    struct DispatchKernels {
+        SIMDTier tier;
+        void (*transformVector3Array)(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+        void (*transformVector4Array)(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+        // aStep and bStep are 1 to step through an array, or 0 to use the same matrix for every product.
+        void (*multiplyBatch)(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+        // out[i] = a[aIndices[i]] * b[i].
+        void (*multiplyIndexedBatch)(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+        // ok may be null, and in may be out.
+        void (*inverseBatch)(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+        // s or c may be null when that output isn't wanted.
+        void (*sinCosArray)(const float* f, float* s, float* c, size_t n, bool fast);
+        void (*dotVector3Array)(const Vector3* a, const Vector3* b, float* out, size_t n);
+        // in may be out.
+        void (*normalizeVector3Array)(const Vector3* in, Vector3* out, size_t n);
+        // out[i] = q[i].Rotate(in[i]). in may be out.
+        void (*rotateVector3Batch)(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+        // out may be a or b.
+        void (*blendQuaternionBatch)(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+        // The rows of bone b are palette[b * boneStride] to palette[b * boneStride + 2]. normals may be null, and
+        // the outputs may be the inputs.
+        void (*skinVertices)(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                             const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+        // As skinVertices, blending the bones as dual quaternions.
+        void (*skinVerticesDualQuaternion)(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                           const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+        // Converts the first components floats of each element, in[i * inStride] onward, to halves packed
+        // components to an element.
+        void (*floatToHalfArray)(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+        // The reverse of floatToHalfArray.
+        void (*halfToFloatArray)(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+        // transformVector3Array on packed points. in may be out.
+        void (*transformFloat3Array)(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+    };
+
+    // Returns the selected table, selecting one first if needed.
+    const DispatchKernels& GetDispatchKernels();
+
+#   if defined(_XO_KERNELS_AVX)
+    // A mask for _mm256_maskload_ps and _mm256_maskstore_ps with the first n of 8 lanes set, for the tail of an array.
+    _XOINL _XO_TARGET_AVX __m256i TailMask(size_t n) {
+        static const int lanes[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+        return _mm256_loadu_si256((const __m256i*)(lanes + 8 - n));
+    }
+
+    // In-lane _MM_TRANSPOSE4_PS, which transposes the low and high 128 bit lanes of v as two separate 4x4s.
+    _XOINL _XO_TARGET_AVX void TransposeLanes4x4(__m256 v[4]) {
+        __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]), t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]), t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        v[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        v[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        v[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        v[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    _XO_TARGET_AVX void TransformVector3ArrayAVX(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    _XO_TARGET_AVX void TransformVector4ArrayAVX(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    _XO_TARGET_AVX void MultiplyBatchAVX(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX void MultiplyIndexedBatchAVX(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX void InverseBatchAVX(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    _XO_TARGET_AVX void DotVector3ArrayAVX(const Vector3* a, const Vector3* b, float* out, size_t n);
+    _XO_TARGET_AVX void NormalizeVector3ArrayAVX(const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX void RotateVector3BatchAVX(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX void BlendQuaternionBatchAVX(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend);
+    _XO_TARGET_AVX void SkinVerticesAVX(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                        const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    _XO_TARGET_AVX void SkinVerticesDualQuaternionAVX(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                      const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n);
+    _XO_TARGET_AVX void TransformFloat3ArrayAVX(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate);
+#   endif
+#   if defined(_XO_KERNELS_AVX2)
+    _XO_TARGET_AVX2 void SinCosArrayAVX2(const float* f, float* s, float* c, size_t n, bool fast);
+    _XO_TARGET_AVX2 void FloatToHalfArrayF16C(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n);
+    _XO_TARGET_AVX2 void HalfToFloatArrayF16C(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n);
+#   endif
+#   if defined(_XO_KERNELS_AVX512)
+    // A mask register with the first n of 16 lanes set, or all of them when n is 16 or more.
+    _XOINL __mmask16 TailMask16(size_t n) {
+        return n >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << n) - 1);
+    }
+
+    _XO_TARGET_AVX512 void TransformVector3ArrayAVX512(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate);
+    _XO_TARGET_AVX512 void TransformVector4ArrayAVX512(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n);
+    _XO_TARGET_AVX512 void MultiplyBatchAVX512(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX512 void MultiplyIndexedBatchAVX512(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    _XO_TARGET_AVX512 void InverseBatchAVX512(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
+    _XO_TARGET_AVX512 void SinCosArrayAVX512(const float* f, float* s, float* c, size_t n, bool fast);
+    _XO_TARGET_AVX512 void DotVector3ArrayAVX512(const Vector3* a, const Vector3* b, float* out, size_t n);
+    _XO_TARGET_AVX512 void NormalizeVector3ArrayAVX512(const Vector3* in, Vector3* out, size_t n);
+    _XO_TARGET_AVX512 void RotateVector3BatchAVX512(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+#   endif
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
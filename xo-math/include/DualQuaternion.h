@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A rotation and translation, as a pair of quaternions: \f$\hat q = q_r + \epsilon q_d\f$.
+//!
+//! The real part is the rotation, and the dual part is \f$\frac{1}{2} t q_r\f$ for the translation t. That's 32
+//! bytes for a rigid transform, where a Matrix4x4 takes 64 and a Matrix3x4 48, and unlike a matrix it can be
+//! blended: a weighted sum of unit dual quaternions, normalized, is still a rigid transform. Blending matrices
+//! instead shrinks the result wherever the rotations disagree. See Skinning::Skin.
+//!
+//! A dual quaternion can't hold a scale. The methods that transform vectors assume the real part is unit length,
+//! which DualQuaternion::Normalize restores.
+//! @sa https://en.wikipedia.org/wiki/Dual_quaternion
+class _XOSIMDALIGN DualQuaternion {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    DualQuaternion(); //!< Performs no initialization.
+    //! Specifies both parts.
+    DualQuaternion(const Quaternion& real, const Quaternion& dual);
+    //! Rotates by rotation, then translates by translation.
+    DualQuaternion(const Quaternion& rotation, const Vector3& translation);
+    //! Takes the rotation and translation of m, which must be a rotation and translation only.
+    explicit DualQuaternion(const class Matrix3x4& m);
+    //! Takes the rotation and translation of m, which must be a rotation and translation only. See
+    //! DualQuaternion(const Matrix3x4&)
+    explicit DualQuaternion(const class Matrix4x4& m);
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Returns the real part, which is the rotation.
+    _XOINL const Quaternion& GetRotation() const;
+    //! Returns the translation, \f$2 q_d q_r^*\f$.
+    _XOINL Vector3 GetTranslation() const;
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for DualQuaternion when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //! @name Operators
+    //! @{
+
+    //! The dual quaternion product, \f$(a_r b_r) + \epsilon (a_r b_d + a_d b_r)\f$. As with Quaternion and the
+    //! matrices, a * b transforms by b first, then a.
+    _XOINL DualQuaternion& operator *= (const DualQuaternion& q);
+    //! See DualQuaternion::operator *=
+    _XOINL DualQuaternion operator * (const DualQuaternion& q) const;
+    _XOINL bool operator == (const DualQuaternion& q) const;
+    _XOINL bool operator != (const DualQuaternion& q) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Rotates, then translates the point v.
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    //! Rotates the direction v. The translation doesn't apply to directions.
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+
+    //! Scales both parts so the real part is unit length, then takes the real part's direction out of the dual
+    //! part, so this is a rigid transform again. Neither changes the translation.
+    DualQuaternion& Normalize();
+    DualQuaternion Normalized() const;
+    //! Sets this to the transform that undoes it, which for a unit dual quaternion is the conjugate of each part.
+    DualQuaternion& MakeInverse();
+    DualQuaternion Inverse() const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Blends a and b linearly and normalizes the result, flipping b when its rotation is in the other hemisphere
+    //! from a's, so the blend takes the shorter way around. The rotation blends as Quaternion::Nlerp, and the
+    //! translation follows it along a screw motion rather than a straight line.
+    static void Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outDualQuaternion);
+    //! @}
+
+    //!> See
+    //! @name Variants
+    //! Variants of other same-name static methods. See their documentation for more details under the
+    //! Static Methods heading.
+    //! @{
+    static DualQuaternion Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t) { DualQuaternion o; Nlerp(a, b, t, o); return o; }
+    //! @}
+
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the contents of dual quaternion q to the provided ostream as its real and dual parts.
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const DualQuaternion& q) {
+        os << "real: " << Vector4(q.real) << " dual: " << Vector4(q.dual);
+        return os;
+    }
+#endif
+    //! @}
+
+    Quaternion real;
+    Quaternion dual;
+
+    //! No rotation and no translation.
+    static const DualQuaternion Identity;
+};
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,79 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+const Quaternion& DualQuaternion::GetRotation() const {
+    return real;
+}
+
+Vector3 DualQuaternion::GetTranslation() const {
+    // The vector part of 2 q_d q_r^*, which is 2 (r_w d - d_w r + r x d) for the vector parts r and d.
+#if defined(XO_SSE)
+    // the w lanes of both terms cancel to zero.
+    __m128 r = real.xmm, d = dual.xmm;
+    __m128 t = _mm_add_ps(
+        _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), d), _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3)), r)),
+        sse::Cross(r, d));
+    return Vector3(_mm_add_ps(t, t));
+#else
+    Vector3 r(real.x, real.y, real.z), d(dual.x, dual.y, dual.z);
+    return (d * real.w - r * dual.w + Vector3::Cross(r, d)) * 2.0f;
+#endif
+}
+
+DualQuaternion& DualQuaternion::operator *= (const DualQuaternion& q) {
+#if defined(XO_SSE)
+    // q may be this, so both products read its parts before either is written.
+    __m128 d = _mm_add_ps(sse::QuaternionMultiply(real.xmm, q.dual.xmm), sse::QuaternionMultiply(dual.xmm, q.real.xmm));
+    real.xmm = sse::QuaternionMultiply(real.xmm, q.real.xmm);
+    dual.xmm = d;
+#else
+    Quaternion a = real * q.dual;
+    Quaternion b = dual * q.real;
+    real *= q.real;
+    dual = Quaternion(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+#endif
+    return *this;
+}
+
+DualQuaternion DualQuaternion::operator * (const DualQuaternion& q) const {
+    return DualQuaternion(*this) *= q;
+}
+
+bool DualQuaternion::operator == (const DualQuaternion& q) const {
+    return real == q.real && dual == q.dual;
+}
+
+bool DualQuaternion::operator != (const DualQuaternion& q) const {
+    return !((*this) == q);
+}
+
+Vector3 DualQuaternion::TransformPoint(const Vector3& v) const {
+    return real.Rotate(v) + GetTranslation();
+}
+
+Vector3 DualQuaternion::TransformDirection(const Vector3& v) const {
+    return real.Rotate(v);
+}
+
+XOMATH_END_XO_NS();
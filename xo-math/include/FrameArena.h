@@ -0,0 +1,133 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A linear arena for scratch arrays that only live for a frame.
+//!
+//! Allocating is a pointer bump, and nothing is freed on its own: Reset takes the whole arena back at once, at the
+//! end of a frame. That's far cheaper than XO_16ALIGNED_MALLOC and a free for each scratch array, and with one arena
+//! per thread (see FrameArena::ThreadArena) there's no lock for threads to contend on, as there can be in malloc.
+//!
+//! Memory comes in blocks. When a frame needs more than the current block has left, another is chained on, and
+//! Reset then replaces the chain with one block big enough for all of it. After the largest frame has been seen,
+//! frames allocate no blocks at all.
+//!
+//! An arena is not thread safe; each thread should use its own.
+class FrameArena {
+public:
+    //! Usage figures, for sizing the arena. See GetStats.
+    struct Stats {
+        size_t used;            //!< Bytes allocated since the last Reset, alignment padding included.
+        size_t peak;            //!< The most that has been used in any frame, this one included.
+        size_t capacity;        //!< Bytes held in blocks, used or not.
+        size_t blockCount;      //!< Blocks held. More than one means this frame has outgrown the first.
+        size_t allocationCount; //!< Allocations since the last Reset.
+        bool hugePages;         //!< True when the blocks are backed by huge pages.
+    };
+
+    //! The block size of FrameArena().
+    static const size_t DefaultBlockSize = 1 << 20;
+
+    //>See
+    //! @name Constructors
+    //! @{
+
+    //! Blocks of DefaultBlockSize, without huge pages. Nothing is allocated until the first Allocate.
+    FrameArena();
+    //! Blocks of at least blockSize bytes. When hugePages is true, blocks are backed by huge pages where the
+    //! platform can give them without special privileges, which is Linux with transparent huge pages. Elsewhere
+    //! they fall back to ordinary blocks, and Stats::hugePages says which was used. Huge pages cut TLB misses on
+    //! large arenas; blocks are rounded up to a whole huge page, so they suit blocks of a few MB or more.
+    explicit FrameArena(size_t blockSize, bool hugePages = false);
+    //! Frees every block. Memory from the arena must not be used after this.
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator = (const FrameArena&) = delete;
+    //! @}
+
+    //! @name Allocation
+    //! @{
+
+    //! Returns size bytes aligned to align, which must be a power of two. Returns null when a new block is needed
+    //! and can't be allocated.
+    _XOINL void* Allocate(size_t size, size_t align = 16);
+    //! Returns an array of n Ts aligned to 16 bytes, or to the alignment of T when that's larger. The elements are
+    //! not constructed, as with the no initialization constructors of Vector3 and Matrix4x4, and never destroyed,
+    //! so T must not need a destructor.
+    template <typename T>
+    _XOINL T* Allocate(size_t n);
+    //! Returns an array of n Vector3s. See Allocate<T>(size_t).
+    _XOINL Vector3* AllocateVector3s(size_t n);
+    //! Returns an array of n Matrix4x4s. See Allocate<T>(size_t).
+    _XOINL Matrix4x4* AllocateMatrix4x4s(size_t n);
+
+    //! Takes back everything allocated, for the next frame. Memory from the arena must not be used after this.
+    //! If the frame needed more than one block, they're replaced by one block big enough for all of them.
+    void Reset();
+    //! Frees every block, such as after a frame much larger than usual. The next Allocate starts a new one.
+    void Release();
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+    Stats GetStats() const;
+    //! @}
+
+    //! @name Static Methods
+    //! @{
+
+    //! Returns the calling thread's arena, which has the default block size. It's made on the thread's first call,
+    //! and its blocks are freed when the thread exits. Each thread should Reset its own arena once a frame.
+    //!
+    //! Where there's no thread_local (Apple clang before Xcode 8, and MSVC before 2013) the arena is never
+    //! destroyed, so its blocks leak when the thread exits. Short lived threads there should call Release before
+    //! they exit, or use a FrameArena of their own.
+    static FrameArena& ThreadArena();
+    //! @}
+
+private:
+    // Each block starts with this header, followed by its memory.
+    struct Block {
+        Block* previous;
+        size_t size;
+        bool pageAligned;
+    };
+
+    // Chains a block with room for size bytes at align, then allocates them from it.
+    void* AllocateFromNewBlock(size_t size, size_t align);
+    Block* NewBlock(size_t size);
+    void FreeBlocks();
+
+    Block* current;
+    char* cursor;
+    char* end;
+    size_t blockSize;
+    size_t used;
+    size_t peak;
+    size_t capacity;
+    size_t blockCount;
+    size_t allocationCount;
+    bool wantHugePages;
+    bool hugePages;
+};
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+void* FrameArena::Allocate(size_t size, size_t align) {
+    char* p = (char*)(((uintptr_t)cursor + (align - 1)) & ~(uintptr_t)(align - 1));
+    // before the first block, cursor and end are both null, so this takes the slow path.
+    if (p > end || size > (size_t)(end - p)) {
+        return AllocateFromNewBlock(size, align);
+    }
+    used += (size_t)(p - cursor) + size;
+    peak = used > peak ? used : peak;
+    ++allocationCount;
+    cursor = p + size;
+    return p;
+}
+
+template <typename T>
+T* FrameArena::Allocate(size_t n) {
+    static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors, so T must not need one.");
+    if (n > ~(size_t)0 / sizeof(T)) {
+        return nullptr;
+    }
+    return (T*)Allocate(n * sizeof(T), alignof(T) > 16 ? alignof(T) : 16);
+}
+
+Vector3* FrameArena::AllocateVector3s(size_t n) {
+    return Allocate<Vector3>(n);
+}
+
+Matrix4x4* FrameArena::AllocateMatrix4x4s(size_t n) {
+    return Allocate<Matrix4x4>(n);
+}
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,81 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Returns the IEEE 754 half precision float nearest to f, with ties to even.
+//!
+//! Halves keep 11 significant bits and a range of about \f$\pm 65504\f$. Anything larger becomes infinity, anything
+//! smaller than about \f$6 \times 10^{-8}\f$ becomes zero, and between \f$6 \times 10^{-5}\f$ and that the result
+//! is a denormal with fewer significant bits. NaN stays NaN. This is the same rounding F16C's conversions use,
+//! so a value converts to the same bits whichever path converts it, NaN payloads aside.
+//! @sa https://en.wikipedia.org/wiki/Half-precision_floating-point_format
+uint16_t FloatToHalf(float f);
+//! Returns the float equal to half h. Every half, denormals included, is exact as a float.
+float HalfToFloat(uint16_t h);
+
+//! @brief Two half precision floats, for storing a Vector2 in 4 bytes rather than 16.
+//!
+//! The Half types are for storage and transfer, such as vertex streams and network snapshots, and have no math of
+//! their own. Convert to the full precision type to work with them, and back to store them. The arrays are
+//! best converted in bulk with ToHalf and FromHalf.
+struct Half2 {
+    Half2() {} //!< Performs no initialization.
+    //! Rounds each element of v as FloatToHalf.
+    explicit Half2(const class Vector2& v);
+    //! Widens each element as HalfToFloat.
+    operator Vector2() const;
+
+    uint16_t x, y;
+};
+
+//! Three half precision floats, for storing a Vector3 in 6 bytes rather than 16. See Half2.
+struct Half3 {
+    Half3() {} //!< Performs no initialization.
+    explicit Half3(const class Vector3& v);
+    operator Vector3() const;
+
+    uint16_t x, y, z;
+};
+
+//! Four half precision floats, for storing a Vector4 in 8 bytes rather than 16. See Half2.
+struct Half4 {
+    Half4() {} //!< Performs no initialization.
+    explicit Half4(const class Vector4& v);
+    operator Vector4() const;
+
+    uint16_t x, y, z, w;
+};
+
+// Array versions. Inputs and outputs need no alignment, and n may be any count. Each element converts exactly as
+// FloatToHalf or HalfToFloat would. With F16C (the AVX2 dispatch tier and above) they take 8 floats per
+// instruction; otherwise they use an SSE2 version of the same rounding, 4 floats at a time.
+// An output must not overlap its input.
+void ToHalf(const float* in, uint16_t* out, size_t n);
+void ToHalf(const Vector2* in, Half2* out, size_t n);
+void ToHalf(const Vector3* in, Half3* out, size_t n);
+void ToHalf(const Vector4* in, Half4* out, size_t n);
+void FromHalf(const uint16_t* in, float* out, size_t n);
+void FromHalf(const Half2* in, Vector2* out, size_t n);
+void FromHalf(const Half3* in, Vector3* out, size_t n);
+void FromHalf(const Half4* in, Vector4* out, size_t n);
+
+XOMATH_END_XO_NS();
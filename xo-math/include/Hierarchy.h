@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A scene hierarchy of local matrices, with world matrices computed a level at a time.
+//!
+//! Nodes are stored in flat arrays ordered by depth, rather than as a tree of pointers. A level is every node at
+//! the same depth, and its world matrices only depend on the level above, so each level is one pass of
+//! Matrix4x4::MultiplyBatch over contiguous arrays, and the nodes of a level can be split between threads.
+//! Siblings are next to each other and the levels are in the order of their parents, so the parents' world
+//! matrices are read mostly in order too.
+//!
+//! SetLocal marks a node as changed. UpdateWorld recomputes the world matrices of changed nodes and everything
+//! below them, and nothing else: levels above the highest change are skipped outright, and within the levels
+//! below it only the change flags of unchanged nodes are read.
+//!
+//! World matrices are \f$W_{parent} L\f$, the same as multiplying down the tree with Matrix4x4::operator *.
+class Hierarchy {
+public:
+    //! The parent given to AddNode for a root node, and returned by GetParent for one.
+    enum : int { NoParent = -1 };
+
+    //>See
+    //! @name Constructors
+    //! @{
+    Hierarchy(); //!< An empty hierarchy.
+    //! @}
+
+    //! @name Building
+    //! @{
+
+    //! Reserves memory for nodeCount nodes, so adding up to that many doesn't reallocate.
+    void Reserve(size_t nodeCount);
+    //! Removes every node.
+    void Clear();
+    //! Adds a node below parent, which must already have been added, or below nothing when parent is NoParent.
+    //! Returns the new node's handle. Handles count up from 0 in the order nodes are added, and stay the same
+    //! however the nodes are stored. Adding nodes reorders the arrays on the next update.
+    int AddNode(int parent, const Matrix4x4& local);
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+    _XOINL size_t GetNodeCount() const;
+    _XOINL int GetParent(int node) const;
+    _XOINL const Matrix4x4& GetLocal(int node) const;
+    //! Sets the local matrix of node, which marks it and everything below it to be updated.
+    _XOINL void SetLocal(int node, const Matrix4x4& local);
+    //! The world matrix of node as of the last update. Nodes added since then have an unspecified world matrix.
+    _XOINL const Matrix4x4& GetWorld(int node) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Updates the world matrices of every changed node and everything below them, using threadCount threads
+    //! including the calling one.
+    //!
+    //! With more than one thread, threadCount - 1 threads are started for the call and wait for each other
+    //! between levels. threadCount is capped at std::thread::hardware_concurrency(). Levels too small to be worth
+    //! splitting are done by the calling thread alone. Starting the threads costs tens of microseconds, so a
+    //! program with its own job system should use the steps below instead.
+    void UpdateWorld(unsigned threadCount = 1);
+    //! @}
+
+    //! @name Update Steps
+    //! UpdateWorld, in steps that can be run by any job system:
+    //! \code
+    //!     hierarchy.BeginUpdate();
+    //!     for (size_t level = 0; level < hierarchy.GetLevelCount(); ++level) {
+    //!         size_t begin, end;
+    //!         hierarchy.GetLevelRange(level, begin, end);
+    //!         // split [begin, end) into any number of ranges, call UpdateRange on each in parallel,
+    //!         // and wait for all of them before the next level.
+    //!     }
+    //!     hierarchy.EndUpdate();
+    //! \endcode
+    //! @{
+
+    //! Orders the arrays by depth if nodes were added since the last update.
+    void BeginUpdate();
+    //! The number of levels, which is one more than the depth of the deepest node. Only up to date after
+    //! BeginUpdate.
+    _XOINL size_t GetLevelCount() const;
+    //! Sets [begin, end) to the range of level that needs updating. The range is empty for levels above the
+    //! highest changed node.
+    void GetLevelRange(size_t level, size_t& begin, size_t& end) const;
+    //! Updates the world matrices of the changed nodes in [begin, end), which must be within one level's range.
+    //! Every range of the level above must be done first. Ranges of the same level may run at the same time.
+    void UpdateRange(size_t begin, size_t end);
+    //! Marks every node as unchanged.
+    void EndUpdate();
+    //! @}
+
+private:
+    static const size_t NothingChanged = ~(size_t)0;
+
+    void Sort();
+
+    // By handle.
+    std::vector<int> parents;
+    std::vector<int> depths;
+    std::vector<int> slots;
+
+    // By slot, which is the order of the levels.
+    std::vector<int> parentSlots;
+    // aligned, for the SSE loads of the updates.
+    vector<Matrix4x4> locals;
+    vector<Matrix4x4> worlds;
+    std::vector<unsigned char> changed;
+
+    // The first slot of each level, then the node count.
+    std::vector<size_t> levels;
+    // The lowest depth with a changed node, or NothingChanged.
+    size_t firstChangedLevel;
+    bool sorted;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
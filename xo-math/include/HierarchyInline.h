@@ -0,0 +1,53 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+size_t Hierarchy::GetNodeCount() const {
+    return parents.size();
+}
+
+int Hierarchy::GetParent(int node) const {
+    return parents[node];
+}
+
+const Matrix4x4& Hierarchy::GetLocal(int node) const {
+    return locals[slots[node]];
+}
+
+void Hierarchy::SetLocal(int node, const Matrix4x4& local) {
+    int slot = slots[node];
+    locals[slot] = local;
+    changed[slot] = 1;
+    if ((size_t)depths[node] < firstChangedLevel) {
+        firstChangedLevel = (size_t)depths[node];
+    }
+}
+
+const Matrix4x4& Hierarchy::GetWorld(int node) const {
+    return worlds[slots[node]];
+}
+
+size_t Hierarchy::GetLevelCount() const {
+    return levels.empty() ? 0 : levels.size() - 1;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
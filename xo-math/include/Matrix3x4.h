@@ -0,0 +1,229 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A compact affine transformation, stored as the top three rows of a Matrix4x4.
+//!
+//! The bottom row of an affine matrix is always \f$\begin{pmatrix}0&0&0&1\end{pmatrix}\f$, so it's left out. That
+//! takes 48 bytes where a Matrix4x4 takes 64, and skips the work the bottom row would need in products and
+//! transforms. Conversions to and from Matrix4x4 keep every element, so long as the Matrix4x4 is affine.
+//!
+//! The upper left 3x3 is the rotation and scale, and the fourth column (the w of each row) is the translation.
+//! @sa https://en.wikipedia.org/wiki/Affine_transformation
+class _XOSIMDALIGN Matrix3x4 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Matrix3x4(); //!< Performs no initialization.
+    explicit Matrix3x4(float m); //!< All elements are set to m.
+    //! specify each element.
+    /*!
+        \f[
+            \begin{bmatrix}
+            m00&m01&m02&m03\\
+            m10&m11&m12&m13\\
+            m20&m21&m22&m23\\
+            0&0&0&1
+            \end{bmatrix}
+        \f]
+    */
+    Matrix3x4(float m00, float m01, float m02, float m03,
+              float m10, float m11, float m12, float m13,
+              float m20, float m21, float m22, float m23);
+    //! Copy constructor, trivial.
+    Matrix3x4(const Matrix3x4& m);
+    //! Specifies each row.
+    Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2);
+    //! Takes the top three rows of m. The bottom row of m is assumed to be \f$\begin{pmatrix}0&0&0&1\end{pmatrix}\f$.
+    explicit Matrix3x4(const class Matrix4x4& m);
+    //! Creates a rotation matrix from quaternion q, such that Quaternion(const Matrix3x4&) gives q back.
+    //! Points are transformed as column vectors, as with Matrix4x4::RotationRadians, so this is the transpose of the
+    //! upper left 3x3 of Matrix4x4(const Quaternion&).
+    explicit Matrix3x4(const class Quaternion& q);
+    //! Creates a matrix that rotates by q, then translates by translation.
+    Matrix3x4(const class Quaternion& q, const Vector3& translation);
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Get a const reference to a row in the matrix.
+    _XOINL const Vector4& GetRow(int i) const;
+    //! Return a column, copied out of the matrix. Column 3 is the translation.
+    _XOINL Vector3 GetColumn(int i) const;
+    //! Returns the fourth column, which is the translation.
+    _XOINL Vector3 GetTranslation() const;
+    //! Sets the fourth column, leaving the rotation and scale as they were.
+    _XOINL Matrix3x4& SetTranslation(const Vector3& t);
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Matrix3x4 when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! Type cast operator. Allows Matrix3x4 to be used implicitly wherever a float* can be.
+    _XOINL operator float*() const { return (float*)this; }
+    //! Extracts a const reference of a row, useful for getting rows by index.
+    _XOINL const Vector4& operator [](int i) const;
+    //! Extracts a reference of a row, useful for setting rows by index.
+    _XOINL Vector4& operator [](int i);
+    //! Extracts a const reference of a value, useful for getting values by index.
+    _XOINL const float& operator ()(int r, int c) const;
+    //! Extracts a reference of a value, useful for setting values by index.
+    _XOINL float& operator ()(int r, int c);
+    //! @}
+
+    //! @name Operators
+    //! @{
+
+    //! The product of two affine matrices, as if both had their bottom row.
+    //!
+    //! The implied bottom row of m only contributes the w of each row of this, so each row of the product takes
+    //! three multiplies rather than four, and there are three rows rather than four.
+    //! @sa https://en.wikipedia.org/wiki/Matrix_multiplication
+    _XOINL Matrix3x4& operator *= (const Matrix3x4& m);
+    //! See Matrix3x4::operator *=
+    _XOINL Matrix3x4 operator * (const Matrix3x4& m) const;
+    //! Vector transformation operator. Transforms vector v by this matrix. The w of the result is v.w.
+    _XOINL Vector4 operator * (const Vector4& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Transforms the point v, which has an implied w of 1 so the translation is applied.
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    //! Transforms the direction v, which has an implied w of 0 so the translation is ignored.
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+
+    //! Transforms n points from in, writing the results to out. See Matrix4x4::TransformPoints
+    const Matrix3x4& TransformPoints(const Vector3* in, Vector3* out, size_t n) const;
+    //! Transforms n directions from in, writing the results to out. See Matrix4x4::TransformDirections
+    const Matrix3x4& TransformDirections(const Vector3* in, Vector3* out, size_t n) const;
+    //! Transforms n points in place. See Matrix3x4::TransformPoints(const Vector3*, Vector3*, size_t) const
+    const Matrix3x4& TransformPoints(Vector3* inOut, size_t n) const;
+    //! Transforms n directions in place. See Matrix3x4::TransformDirections(const Vector3*, Vector3*, size_t) const
+    const Matrix3x4& TransformDirections(Vector3* inOut, size_t n) const;
+    //! Transforms n packed points from in, writing the results to out. See Matrix4x4::TransformPoints(const Float3*, Float3*, size_t) const
+    const Matrix3x4& TransformPoints(const Float3* in, Float3* out, size_t n) const;
+    //! Transforms n packed directions from in, writing the results to out. See Matrix4x4::TransformDirections(const Float3*, Float3*, size_t) const
+    const Matrix3x4& TransformDirections(const Float3* in, Float3* out, size_t n) const;
+
+    //! Gets the determinant of the upper left 3x3, which is also the determinant of the whole affine matrix.
+    float Determinant() const;
+
+    //! Sets this matrix to its inverse, which is also affine.
+    //!
+    //! The upper left 3x3 is inverted from the cross products of its rows, and the translation is the inverted
+    //! 3x3 applied to the negated translation. That's much less work than Matrix4x4::MakeInverse.
+    /*!
+        \f[
+            \begin{bmatrix}
+            A&t\\
+            0&1
+            \end{bmatrix}^{-1}
+            =
+            \begin{bmatrix}
+            A^{-1}&-A^{-1}t\\
+            0&1
+            \end{bmatrix}
+        \f]
+    */
+    void MakeInverse();
+    void GetInverse(Matrix3x4& o) const { o = *this; o.MakeInverse(); }
+    //! Sets this matrix to its inverse, unless the determinant is zero, in which case this is left as is and false is returned.
+    bool TryMakeInverse();
+    bool TryGetInverse(Matrix3x4& o) const { o = *this; return o.TryMakeInverse(); }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Assigns outMatrix to a scale matrix, where each of x y and z scale values are provided by v.
+    static void Scale(const Vector3& v, Matrix3x4& outMatrix);
+    //! Assigns outMatrix to a translation matrix, where each of x y and z are provided by v.
+    static void Translation(const Vector3& v, Matrix3x4& outMatrix);
+    //! @}
+
+    //!> See
+    //! @name Variants
+    //! Variants of other same-name static methods. See their documentation for more details under the
+    //! Static Methods heading.
+    //! @{
+    static Matrix3x4 Scale(const Vector3& v);
+    static Matrix3x4 Translation(const Vector3& v);
+    //! @}
+
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the contents of matrix m to the provided ostream in the form of its three row vectors.
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Matrix3x4& m) {
+        os << "\nrow 0: " << m.r[0] << "\nrow 1: " << m.r[1] << "\nrow 2: " << m.r[2] << "\n";
+        return os;
+    }
+#endif
+    //! @}
+
+    //! Matrix rows
+    union {
+        Vector4 r[3];
+        float m[12];
+        struct {
+            float   m00, m01, m02, m03,
+                    m10, m11, m12, m13,
+                    m20, m21, m22, m23;
+        };
+    };
+
+    static const Matrix3x4
+        /*!
+        \f[
+            \begin{bmatrix}
+            1&0&0&0\\
+            0&1&0&0\\
+            0&0&1&0
+            \end{bmatrix}
+        \f]
+        */
+        Identity,
+        /*!
+        \f[
+            \begin{bmatrix}
+            0&0&0&0\\
+            0&0&0&0\\
+            0&0&0&0
+            \end{bmatrix}
+        \f]
+        */
+        Zero;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,148 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace sse {
+    //! Returns \f$a_x b_0 + a_y b_1 + a_z b_2 + \begin{pmatrix}0&0&0&a_w\end{pmatrix}\f$, which is the row a multiplied by
+    //! the affine matrix with rows b0 to b2. See sse::LinearCombination for the general form.
+    _XOINL __m128 AffineCombination(__m128 a, __m128 b0, __m128 b1, __m128 b2) {
+        const __m128 wMask = _mm_set_ps(HexFloat(0xffffffff), 0.0f, 0.0f, 0.0f);
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm_and_ps(wMask, a)));
+    }
+
+    //! Returns the dot products of v with r0, r1 and r2 in x, y and z, and zero in w. The products are transposed
+    //! so all three sums take the same adds, rather than a horizontal sum each.
+    _XOINL __m128 AffineTransform(__m128 r0, __m128 r1, __m128 r2, __m128 v) {
+        __m128 a = _mm_mul_ps(r0, v);
+        __m128 b = _mm_mul_ps(r1, v);
+        __m128 c = _mm_mul_ps(r2, v);
+        __m128 d = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        return _mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d));
+    }
+}
+#endif
+
+const Vector4& Matrix3x4::GetRow(int i) const {
+    return r[i];
+}
+
+Vector3 Matrix3x4::GetColumn(int i) const {
+    return Vector3(r[0][i], r[1][i], r[2][i]);
+}
+
+Vector3 Matrix3x4::GetTranslation() const {
+    return Vector3(m03, m13, m23);
+}
+
+Matrix3x4& Matrix3x4::SetTranslation(const Vector3& t) {
+    m03 = t.x;
+    m13 = t.y;
+    m23 = t.z;
+    return *this;
+}
+
+const Vector4& Matrix3x4::operator [](int i) const {
+    return r[i];
+}
+
+Vector4& Matrix3x4::operator [](int i) {
+    return r[i];
+}
+
+const float& Matrix3x4::operator ()(int r, int c) const {
+    return this->r[r][c];
+}
+
+float& Matrix3x4::operator ()(int r, int c) {
+    return this->r[r][c];
+}
+
+Matrix3x4& Matrix3x4::operator *= (const Matrix3x4& m) {
+    // As Matrix4x4::operator *=, each row of the product is a linear combination of the rows of m. The bottom
+    // row of m is (0, 0, 0, 1), so its term is just the w of the row of this.
+#if defined(XO_SSE)
+    // m may be this, so its rows are loaded before any are written.
+    __m128 b0 = m.r[0].xmm, b1 = m.r[1].xmm, b2 = m.r[2].xmm;
+    r[0].xmm = sse::AffineCombination(r[0].xmm, b0, b1, b2);
+    r[1].xmm = sse::AffineCombination(r[1].xmm, b0, b1, b2);
+    r[2].xmm = sse::AffineCombination(r[2].xmm, b0, b1, b2);
+#else
+    Matrix3x4 b(m);
+    for (int i = 0; i < 3; ++i) {
+        Vector4 a = r[i];
+        r[i] = (b.r[0] * a.x) + (b.r[1] * a.y) + (b.r[2] * a.z);
+        r[i].w += a.w;
+    }
+#endif
+    return *this;
+}
+
+Matrix3x4 Matrix3x4::operator * (const Matrix3x4& m) const {
+#if defined(XO_SSE)
+    Matrix3x4 o;
+    o.r[0].xmm = sse::AffineCombination(r[0].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    o.r[1].xmm = sse::AffineCombination(r[1].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    o.r[2].xmm = sse::AffineCombination(r[2].xmm, m.r[0].xmm, m.r[1].xmm, m.r[2].xmm);
+    return o;
+#else
+    return Matrix3x4(*this) *= m;
+#endif
+}
+
+Vector4 Matrix3x4::operator * (const Vector4& v) const {
+#if defined(XO_SSE)
+    Vector4 o(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, v.xmm));
+    o.w = v.w;
+    return o;
+#else
+    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), v.w);
+#endif
+}
+
+Vector3 Matrix3x4::TransformPoint(const Vector3& v) const {
+#if defined(XO_SSE)
+    // The w of v's register is unspecified, so it's masked off and replaced with 1 in register, rather than
+    // going through a Vector4 in memory.
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    __m128 p = _mm_or_ps(_mm_and_ps(v.xmm, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+    return Vector3(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, p));
+#else
+    Vector4 p(v, 1.0f);
+    return Vector3((r[0] * p).Sum(), (r[1] * p).Sum(), (r[2] * p).Sum());
+#endif
+}
+
+Vector3 Matrix3x4::TransformDirection(const Vector3& v) const {
+#if defined(XO_SSE)
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    return Vector3(sse::AffineTransform(r[0].xmm, r[1].xmm, r[2].xmm, _mm_and_ps(v.xmm, xyzMask)));
+#else
+    Vector4 d(v, 0.0f);
+    return Vector3((r[0] * d).Sum(), (r[1] * d).Sum(), (r[2] * d).Sum());
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -75,6 +75,8 @@ public:
     Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2);
     //! Creates a rotation matrix from quaternion q.
     Matrix4x4(const class Quaternion& q);
+    //! Copies the rows of affine matrix m, with a bottom row of \f$\begin{pmatrix}0&0&0&1\end{pmatrix}\f$.
+    Matrix4x4(const class Matrix3x4& m);
     //! @}
 
     //! @name Set / Get Methods
@@ -197,9 +199,11 @@ public:
     //! @name Methods
     //! @{
 
-    //! Returns true if the dot between any two columns is 1 or 0.
+    //! Returns true if the dot between any two of the first three columns is 1 or 0, within Vector4::Epsilon.
+    //! Those columns are the axes of the basis, so this is true of a rotation with no scale.
     bool HasOrthonormalBasis() const;
     //! Returns true if this matrix is unitary. A matrix is unitary when the following is true: (m.Transposed() * m) == Identity
+    //! The comparison is within Vector4::Epsilon.
     bool IsUnitary() const;
     //! Gets the determinant of this matrix.
     float Determinant() const;
@@ -210,6 +214,59 @@ public:
     bool TryMakeInverse();
     bool TryGetInverse(Matrix4x4& o) const { o = *this; return o.TryMakeInverse(); }
 
+    //! The ways to invert a matrix, from the fastest to the slowest. The first three expect an affine matrix: one
+    //! with a bottom row of \f$\begin{pmatrix}0&0&0&1\end{pmatrix}\f$ and the translation in the fourth column, as
+    //! with Matrix3x4 and Matrix4x4::TransformPoints.
+    //! Matrix4x4::Translation puts the translation in the bottom row instead, so its matrices are General.
+    enum class InverseMethod {
+        Rigid,                  //!< The upper left 3x3 is a rotation. See Matrix4x4::InverseRigid
+        ScaleRotateTranslate,   //!< The columns of the upper left 3x3 are orthogonal. See Matrix4x4::InverseScaleRotateTranslate
+        Affine,                 //!< Any affine matrix. See Matrix4x4::InverseAffine
+        General                 //!< Anything else. See Matrix4x4::MakeInverse
+    };
+    //! Counts of the methods Matrix4x4::InverseAuto chose. Each caller owns its own, so there's no sharing between
+    //! threads and no cost when they aren't asked for.
+    struct InverseStats {
+        size_t count[4];
+        InverseStats() { Reset(); }
+        void Reset() { count[0] = count[1] = count[2] = count[3] = 0; }
+        //! The number of inverses that took method m.
+        size_t operator [](InverseMethod m) const { return count[(int)m]; }
+        size_t Total() const { return count[0] + count[1] + count[2] + count[3]; }
+    };
+
+    //! Returns the inverse of an affine matrix. The upper left 3x3 is inverted as with Matrix3x4::MakeInverse,
+    //! skipping the work the bottom row would need. The result isn't meaningful for any other matrix.
+    Matrix4x4 InverseAffine() const;
+    //! Returns the inverse of an affine matrix whose upper left 3x3 is a rotation. That's its transpose, with the
+    //! translation rotated by the transpose and negated. The result isn't meaningful for any other matrix.
+    /*!
+        \f[
+            \begin{bmatrix}
+            R&t\\
+            0&1
+            \end{bmatrix}^{-1}
+            =
+            \begin{bmatrix}
+            R^T&-R^Tt\\
+            0&1
+            \end{bmatrix}
+        \f]
+    */
+    Matrix4x4 InverseRigid() const;
+    //! Returns the inverse of an affine matrix built as translate * rotate * scale, where the scale may differ per
+    //! axis. The columns of the upper left 3x3 are orthogonal but not unit length, so its inverse is its transpose
+    //! with each row divided by the squared length of the matching column.
+    //! The result isn't meaningful for any other matrix.
+    Matrix4x4 InverseScaleRotateTranslate() const;
+    //! Finds the fastest of the inverse methods that's valid for this matrix. Being affine is an exact test of the
+    //! bottom row. The columns of the upper left 3x3 have to be orthogonal, and of unit length for Rigid, to a
+    //! relative tolerance of about 1e-5, which is well above the rounding of rotation matrices built in floats.
+    InverseMethod ClassifyInverse() const;
+    //! Returns the inverse by the method ClassifyInverse picks. If stats isn't null, the count of that method in it
+    //! is incremented. Like MakeInverse, the matrix should be invertible.
+    Matrix4x4 InverseAuto(InverseStats* stats = nullptr) const;
+
     //! Sets this matrix as a transpose of itself
     /*!
         \f[
@@ -235,6 +292,34 @@ public:
     //! Transforms vector v in place by this matrix.
     const Matrix4x4& Transform(Vector4& v) const;
 
+    //! Transforms n points from in, writing the results to out. Points have an implied w of 1, so the fourth 
+    //! column of this matrix is applied: out[i] is \f$\begin{pmatrix}x&y&z\end{pmatrix}\f$ of (*this) * Vector4(in[i], 1.0f).
+    //!
+    //! The matrix columns are loaded once for the whole array, making this much faster than calling 
+    //! Matrix4x4::Transform per vector. in and out may be the same array, but must not otherwise overlap.
+    const Matrix4x4& TransformPoints(const Vector3* in, Vector3* out, size_t n) const;
+    //! Transforms n directions from in, writing the results to out. Directions have an implied w of 0, so the 
+    //! fourth column of this matrix is ignored: out[i] is equal to (*this) * in[i].
+    //! in and out may be the same array, but must not otherwise overlap.
+    const Matrix4x4& TransformDirections(const Vector3* in, Vector3* out, size_t n) const;
+    //! Transforms n vectors from in, writing the results to out: out[i] is equal to (*this) * in[i].
+    //! in and out may be the same array, but must not otherwise overlap.
+    const Matrix4x4& TransformVector4s(const Vector4* in, Vector4* out, size_t n) const;
+    //! Transforms n packed points from in, writing the results to out, as TransformPoints does for Vector3s.
+    //!
+    //! Four points are loaded as three registers and shuffled into their xs, ys and zs, so this reads and writes a
+    //! quarter less memory than the Vector3 form, and needs no unpacking first. in and out may be the same array,
+    //! but must not otherwise overlap.
+    const Matrix4x4& TransformPoints(const Float3* in, Float3* out, size_t n) const;
+    //! Transforms n packed directions from in, writing the results to out. See TransformPoints(const Float3*, Float3*, size_t) const
+    const Matrix4x4& TransformDirections(const Float3* in, Float3* out, size_t n) const;
+    //! Transforms n points in place. See Matrix4x4::TransformPoints(const Vector3*, Vector3*, size_t) const
+    const Matrix4x4& TransformPoints(Vector3* inOut, size_t n) const;
+    //! Transforms n directions in place. See Matrix4x4::TransformDirections(const Vector3*, Vector3*, size_t) const
+    const Matrix4x4& TransformDirections(Vector3* inOut, size_t n) const;
+    //! Transforms n vectors in place. See Matrix4x4::TransformVector4s(const Vector4*, Vector4*, size_t) const
+    const Matrix4x4& TransformVector4s(Vector4* inOut, size_t n) const;
+
     //! Returns a copy of this matrix transposed. See Matrix4x4::Transposed
     //! @sa https://en.wikipedia.org/wiki/Transpose
     Matrix4x4 Transposed() const;
@@ -435,6 +520,30 @@ public:
     static void LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& outMatrix);
     //! Assigns outMatrix to a look at matrix, from Vector3::Zero towards direction with up being Vector3::Up.
     static void LookAtFromDirection(const Vector3& direction, Matrix4x4& outMatrix);
+
+    //! Multiplies n pairs of matrices, out[i] = a[i] * b[i].
+    //!
+    //! Each row of a product is computed as a linear combination of the rows of the right hand matrix, and 
+    //! with AVX two matrices are processed per instruction. out may be the same array as a or b, but must not 
+    //! otherwise overlap either of them.
+    //! @sa https://en.wikipedia.org/wiki/Matrix_multiplication
+    static void MultiplyBatch(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    //! Multiplies one matrix by many, out[i] = a * b[i]. Useful for applying a parent or view projection 
+    //! transform on the left of many matrices.
+    static void MultiplyBatch(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    //! Multiplies many matrices by one, out[i] = a[i] * b. Useful for concatenating many world matrices with 
+    //! a single view projection matrix.
+    static void MultiplyBatch(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n);
+    //! Multiplies matrices picked from a by many, out[i] = a[aIndices[i]] * b[i]. Useful for concatenating
+    //! parent world matrices with local matrices, as Hierarchy does. out must not overlap any of the matrices
+    //! of a that are read, or b unless it's the same array.
+    static void MultiplyBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    //! Inverts n matrices from in, writing the inverses to out. Four, eight or sixteen are inverted at once with
+    //! one matrix per SIMD lane, depending on the dispatch tier, so the cofactors don't need a shuffle per
+    //! matrix as MakeInverse does.
+    //! A singular matrix (one whose determinant is zero) is copied to out as is, as TryMakeInverse leaves it, and
+    //! ok[i] is false. Otherwise ok[i] is true. ok may be null. in may be out, but must not otherwise overlap it.
+    static void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n);
     //! @}
 
     //!> See
@@ -21,6 +21,26 @@
 
 XOMATH_BEGIN_XO_NS();
 
+#if defined(XO_SSE)
+namespace sse {
+    //! Returns \f$a_x b_0 + a_y b_1 + a_z b_2 + a_w b_3\f$, which is the row a multiplied by the matrix with rows b0 to b3.
+    _XOINL __m128 LinearCombination(__m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+
+#   if defined(_XO_KERNELS_AVX)
+    //! Two independent sse::LinearCombination, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 LinearCombination(__m256 a, __m256 b0, __m256 b1, __m256 b2, __m256 b3) {
+        return _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+#   endif
+}
+#endif
+
 const Vector4& Matrix4x4::operator [](int i) const {
     return r[i];
 }
@@ -59,13 +79,25 @@ Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
 }
 
 Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
-    auto t = m.Transposed();
-    return (*this) = Matrix4x4(
-        (r[0] * t[0]).Sum(), (r[0] * t[1]).Sum(), (r[0] * t[2]).Sum(), (r[0] * t[3]).Sum(),
-        (r[1] * t[0]).Sum(), (r[1] * t[1]).Sum(), (r[1] * t[2]).Sum(), (r[1] * t[3]).Sum(),
-        (r[2] * t[0]).Sum(), (r[2] * t[1]).Sum(), (r[2] * t[2]).Sum(), (r[2] * t[3]).Sum(),
-        (r[3] * t[0]).Sum(), (r[3] * t[1]).Sum(), (r[3] * t[2]).Sum(), (r[3] * t[3]).Sum()
-    );
+    // Each row of the product is a linear combination of the rows of m, weighted by the same row of this.
+    // This avoids the transpose and 16 horizontal sums of the dot product form.
+    // AVX is left to Matrix4x4::MultiplyBatch. For a lone product, packing two rows into one ymm register 
+    // measured slower than this, as the 256 bit loads stall on the 128 bit row stores that usually precede them.
+#if defined(XO_SSE)
+    // m may be this, so its rows are loaded before any are written.
+    __m128 b0 = m.r[0].xmm, b1 = m.r[1].xmm, b2 = m.r[2].xmm, b3 = m.r[3].xmm;
+    r[0].xmm = sse::LinearCombination(r[0].xmm, b0, b1, b2, b3);
+    r[1].xmm = sse::LinearCombination(r[1].xmm, b0, b1, b2, b3);
+    r[2].xmm = sse::LinearCombination(r[2].xmm, b0, b1, b2, b3);
+    r[3].xmm = sse::LinearCombination(r[3].xmm, b0, b1, b2, b3);
+#else
+    Matrix4x4 b(m);
+    for (int i = 0; i < 4; ++i) {
+        Vector4 a = r[i];
+        r[i] = (b.r[0] * a.x) + (b.r[1] * a.y) + (b.r[2] * a.z) + (b.r[3] * a.w);
+    }
+#endif
+    return *this;
 }
 
 Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
@@ -25,6 +25,7 @@ class _XOSIMDALIGN Quaternion {
 public:
     Quaternion();
     Quaternion(const Matrix4x4& m);
+    Quaternion(const class Matrix3x4& m);
     Quaternion(float x, float y, float z, float w);
 
     _XO_OVERLOAD_NEW_DELETE();
@@ -34,6 +35,8 @@ public:
 
     _XOINL Quaternion& operator *= (const Quaternion& q);
     _XOINL Quaternion operator * (const Quaternion& q) const;
+    //! Returns v rotated by this quaternion. See Quaternion::Rotate
+    _XOINL Vector3 operator * (const Vector3& v) const;
 
     _XOINL bool operator == (const Quaternion& q) const;
     _XOINL bool operator != (const Quaternion& q) const;
@@ -46,6 +49,19 @@ public:
     Quaternion Normalized() const;
     void GetAxisAngleRadians(Vector3& axis, float& radians) const;
 
+    //! Returns v rotated by this quaternion, which should be unit length. This is the same rotation as
+    //! Matrix3x4(const Quaternion&) applied to v, without building the matrix.
+    _XOINL Vector3 Rotate(const Vector3& v) const;
+    //! Rotates n vectors from in, writing the results to out. in may be out.
+    //! The quaternion is converted to a matrix once, so the vectors go through the Matrix4x4::TransformDirections
+    //! kernels, which take fewer operations per vector than Quaternion::Rotate.
+    const Quaternion& Rotate(const Vector3* in, Vector3* out, size_t n) const;
+    //! Rotates n vectors in place. See Quaternion::Rotate(const Vector3*, Vector3*, size_t) const
+    const Quaternion& Rotate(Vector3* inOut, size_t n) const;
+    //! Rotates each in[i] by q[i], writing the results to out[i]. in may be out.
+    //! The batch kernels rotate two or four vectors at a time, picked at runtime. See Dispatch.h
+    static void RotateBatch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n);
+
     static void AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat);
     static void Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
     static void LookAtFromDirection(const Vector3& direction, const Vector3& up, Quaternion& outQuat);
@@ -55,6 +71,21 @@ public:
     static void RotationRadians(const Vector3& v, Quaternion& outQuat);
     static void RotationRadians(float x, float y, float z, Quaternion& outQuat);
     static void Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    //! Blends a and b linearly and normalizes the result, taking the shorter way around. The rotation moves faster
+    //! through the middle than the ends, so it strays from Slerp by up to 0.14 radians for rotations half a turn apart.
+    static void Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    //! An approximate slerp without trig: Nlerp, with t corrected by a polynomial in the cosine of the angle between
+    //! a and b. The result is within 0.0008 radians of the true slerp's rotation, for inputs any angle apart.
+    static void FastSlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+
+    //! Blends a[i] and b[i] by t[i] into out[i] for n quaternions, as Quaternion::Slerp. out may be a or b.
+    //! Four quaternions are blended at once, or eight with AVX, picked at runtime. See Dispatch.h
+    static void SlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
+    //! As Quaternion::SlerpBatch, blending as Quaternion::Nlerp. The normalize uses an approximate reciprocal square
+    //! root with one refinement step, so the results can differ from Nlerp in the last few bits.
+    static void NlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
+    //! As Quaternion::NlerpBatch, blending as Quaternion::FastSlerp.
+    static void FastSlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n);
 
 #define _RET_VARIANT(name) { Quaternion tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
@@ -75,6 +106,8 @@ public:
     static Quaternion RotationRadians(const Vector3& v)                                             _RET_VARIANT_1(RotationRadians, v)
     static Quaternion RotationRadians(float x, float y, float z)                                    _RET_VARIANT_3(RotationRadians, x, y, z)
     static Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Slerp, a, b, t)
+    static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Nlerp, a, b, t)
+    static Quaternion FastSlerp(const Quaternion& a, const Quaternion& b, float t)                  _RET_VARIANT_3(FastSlerp, a, b, t)
 
 #undef _RET_VARIANT
 #undef _RET_VARIANT_END
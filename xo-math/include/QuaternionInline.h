@@ -21,6 +21,37 @@
 
 XOMATH_BEGIN_XO_NS();
 
+#if defined(XO_SSE)
+namespace sse {
+    //! Returns the quaternion product a * b. Each element of a multiplies all of b, with b's elements reordered and
+    //! their signs flipped to suit, so the sixteen products take four multiplies rather than a dot product per element.
+    _XOINL __m128 QuaternionMultiply(__m128 a, __m128 b) {
+        // Lanes are x, y, z, w. _mm_set_ps takes them w first.
+        __m128 bx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f));
+        __m128 by = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f));
+        __m128 bz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), bx)),
+            _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), by), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), bz)));
+    }
+
+    //! As Vector3::Cross. The w of the result is a.w*b.w - b.w*a.w, which is zero.
+    _XOINL __m128 Cross(__m128 a, __m128 b) {
+        __m128 r = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(b, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    //! Returns v rotated by the unit quaternion q, as \f$v + w t + u \times t\f$ with \f$t = 2 u \times v\f$, where
+    //! u is the vector part of q. That's two cross products, where \f$q v q^*\f$ would be two quaternion products.
+    //! @sa https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation#Using_quaternion_as_rotations
+    _XOINL __m128 QuaternionRotate(__m128 q, __m128 v) {
+        __m128 t = Cross(q, v);
+        t = _mm_add_ps(t, t);
+        return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(t, _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)))), Cross(q, t));
+    }
+}
+#endif
+
 float& Quaternion::operator [](int i) { 
   return f[i]; 
 }
@@ -30,12 +61,16 @@ const float& Quaternion::operator [](int i) const {
 }
 
 Quaternion& Quaternion::operator *= (const Quaternion& q) {
-    // TODO: see if there's a cute intrinsic way to do this.
-    _XO_ASSIGN_QUAT(
-      w * q.x + x * q.w + y * q.z - z * q.y,
-      w * q.y - x * q.z + y * q.w + z * q.x,
-      w * q.z + x * q.y - y * q.x + z * q.w,
-      w * q.w - x * q.x - y * q.y - z * q.z);
+#if defined(XO_SSE)
+    xmm = sse::QuaternionMultiply(xmm, q.xmm);
+#else
+    // _XO_ASSIGN_QUAT writes one member at a time, so every component is computed first.
+    float nw = w * q.w - x * q.x - y * q.y - z * q.z;
+    float nx = w * q.x + x * q.w + y * q.z - z * q.y;
+    float ny = w * q.y - x * q.z + y * q.w + z * q.x;
+    float nz = w * q.z + x * q.y - y * q.x + z * q.w;
+    _XO_ASSIGN_QUAT(nw, nx, ny, nz);
+#endif
   return *this;
 }
 
@@ -43,6 +78,22 @@ Quaternion Quaternion::operator * (const Quaternion& q) const {
   return Quaternion(*this) *= q;
 }
 
+Vector3 Quaternion::operator * (const Vector3& v) const {
+    return Rotate(v);
+}
+
+Vector3 Quaternion::Rotate(const Vector3& v) const {
+#if defined(XO_SSE)
+    Vector3 o;
+    o.xmm = sse::QuaternionRotate(xmm, v.xmm);
+    return o;
+#else
+    Vector3 u(x, y, z);
+    Vector3 t = Vector3::Cross(u, v) * 2.0f;
+    return v + t * w + Vector3::Cross(u, t);
+#endif
+}
+
 bool Quaternion::operator == (const Quaternion& q) const {
 #   if defined(XO_SSE)
     return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(q.xmm, xmm)), sse::Epsilon)) & 15) == 15;
@@ -0,0 +1,415 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! A small, fast pseudo random number generator based on xoshiro128+.
+//!
+//! The whole state is 16 bytes, so it's cheap to keep one per thread or per system. Seeding is explicit and
+//! deterministic: two engines given the same seed produce the same sequence on every platform.
+//!
+//! Jump advances the engine by 2^64 steps, which is used to split one seed into non-overlapping streams,
+//! such as one per worker thread. See Random::SeedThread.
+//!
+//! RandomRange and RandomBool use the calling thread's engine, returned by Random::ThreadEngine.
+//! @sa http://xoshiro.di.unimi.it/
+class Random {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    _XOINL Random(); //!< Seeds with Random::DefaultSeed.
+    _XOINL explicit Random(uint64_t seed); //!< Seeds with seed.
+    _XOINL Random(uint64_t seed, uint32_t stream); //!< Seeds with seed, then jumps ahead stream times.
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Resets the state from seed. Any seed (including zero) is valid.
+    _XOINL void Seed(uint64_t seed);
+    //! Advances the state by 2^64 steps. Engines seeded alike and jumped a different number of times
+    //! produce sequences that won't overlap.
+    _XOINL void Jump();
+    //! Returns the next 32 random bits. The lowest few bits are of lower quality, prefer the ranged methods.
+    _XOINL uint32_t Next();
+    //! Returns a float in [0, 1).
+    _XOINL float NextFloat();
+    //! Returns an int in [low, high]. Unbiased.
+    _XOINL int Range(int low, int high);
+    //! Returns a float in [low, high).
+    _XOINL float Range(float low, float high);
+    //! Returns true or false with equal probability.
+    _XOINL bool Bool();
+    //! @}
+
+    //>See
+    //! @name Thread Engines
+    //! @{
+
+    //! Returns the calling thread's engine.
+    //! Each thread's engine is created on first use from Random::DefaultSeed, jumped once more than the
+    //! last thread's engine. Since that depends on which thread gets there first, workers wanting
+    //! reproducible results should call Random::SeedThread with a fixed stream.
+    _XOINL static Random& ThreadEngine();
+    //! Seeds the calling thread's engine with seed, then jumps it ahead stream times. Giving each worker its own
+    //! stream (such as its index) guarantees the workers' sequences don't overlap.
+    _XOINL static void SeedThread(uint64_t seed, uint32_t stream = 0);
+    //! @}
+
+    //! The seed used by Random() and by thread engines that haven't been seeded with Random::SeedThread.
+    static const uint64_t DefaultSeed = 0x9e3779b97f4a7c15ULL;
+
+    uint32_t s[4];
+
+private:
+    // Makes the engine for a new thread. Out of line so the stream counter is shared by everything linked.
+    static Random NewThreadEngine();
+};
+
+#if defined(XO_SSE2)
+//! Four independent Random streams, one per lane of an SSE register.
+//!
+//! Each call produces a value for every lane at once. Lane i is the scalar engine Random(seed, stream*4 + i),
+//! so the lanes never overlap each other, or other Random_x4 created with a different stream.
+class _XOSIMDALIGN Random_x4 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    _XOINL Random_x4(); //!< Seeds with Random::DefaultSeed.
+    _XOINL explicit Random_x4(uint64_t seed, uint32_t stream = 0); //!< Seeds with seed and stream.
+    //! Seeds each lane from values drawn from source. Cheaper than jumping, for short lived engines such as 
+    //! filling an array from Random::ThreadEngine.
+    _XOINL explicit Random_x4(Random& source);
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Seeds each lane as described in the class documentation.
+    _XOINL void Seed(uint64_t seed, uint32_t stream = 0);
+    //! Returns the next 32 random bits of each lane.
+    _XOINL __m128i Next();
+    //! Returns a float in [0, 1) for each lane.
+    _XOINL __m128 NextFloat();
+    //! Returns a float in [low, high) for each lane.
+    _XOINL __m128 Range(float low, float high);
+    //! Returns a float in [low, high) for each lane, with bounds per lane.
+    _XOINL __m128 Range(__m128 low, __m128 high);
+    //! @}
+
+    //! Overloads the new and delete operators for Random_x4 when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+
+    __m128i s[4];
+};
+#endif
+
+#if defined(XO_AVX2)
+//! Eight independent Random streams, one per lane of an AVX register.
+//!
+//! Lane i is the scalar engine Random(seed, stream*8 + i).
+//! @sa Random_x4
+class Random_x8 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    _XOINL Random_x8(); //!< Seeds with Random::DefaultSeed.
+    _XOINL explicit Random_x8(uint64_t seed, uint32_t stream = 0); //!< Seeds with seed and stream.
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Seeds each lane as described in the class documentation.
+    _XOINL void Seed(uint64_t seed, uint32_t stream = 0);
+    //! Returns the next 32 random bits of each lane.
+    _XOINL __m256i Next();
+    //! Returns a float in [0, 1) for each lane.
+    _XOINL __m256 NextFloat();
+    //! Returns a float in [low, high) for each lane.
+    _XOINL __m256 Range(float low, float high);
+    //! Returns a float in [low, high) for each lane, with bounds per lane.
+    _XOINL __m256 Range(__m256 low, __m256 high);
+    //! @}
+
+    //! Overloads the new and delete operators for the 32 byte alignment of the state.
+    _XO_OVERLOAD_NEW_DELETE_32();
+
+    __m256i s[4];
+};
+#endif
+
+////////////////////////////////////////////////////////////////////////// Random
+
+Random::Random() {
+    Seed(DefaultSeed);
+}
+
+Random::Random(uint64_t seed) {
+    Seed(seed);
+}
+
+Random::Random(uint64_t seed, uint32_t stream) {
+    Seed(seed);
+    for (uint32_t i = 0; i < stream; ++i) {
+        Jump();
+    }
+}
+
+void Random::Seed(uint64_t seed) {
+    // splitmix64 spreads the seed over the whole state, and never gives the all zero state xoshiro can't leave.
+    for (int i = 0; i < 4; i += 2) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z = z ^ (z >> 31);
+        s[i] = (uint32_t)z;
+        s[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+void Random::Jump() {
+    static const uint32_t JumpPoly[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    uint32_t t[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 32; ++b) {
+            if (JumpPoly[i] & (1u << b)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            Next();
+        }
+    }
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+    s[3] = t[3];
+}
+
+uint32_t Random::Next() {
+    const uint32_t result = s[0] + s[3];
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+float Random::NextFloat() {
+    // the top 24 bits fill the mantissa exactly.
+    return (float)(Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+int Random::Range(int low, int high) {
+    XO_ASSERT(low <= high, "Random::Range expects low <= high.");
+    const uint32_t span = (uint32_t)high - (uint32_t)low + 1u;
+    if (span == 0) {
+        // low and high cover every int.
+        return (int)Next();
+    }
+    // Lemire's multiply and reject. Takes the high bits of the product, and only divides when a reject is possible.
+    // See: https://arxiv.org/abs/1805.10941
+    uint64_t m = (uint64_t)Next() * span;
+    uint32_t l = (uint32_t)m;
+    if (l < span) {
+        const uint32_t threshold = (0u - span) % span;
+        while (l < threshold) {
+            m = (uint64_t)Next() * span;
+            l = (uint32_t)m;
+        }
+    }
+    return (int)((uint32_t)low + (uint32_t)(m >> 32));
+}
+
+float Random::Range(float low, float high) {
+    return low + (high - low) * NextFloat();
+}
+
+bool Random::Bool() {
+    return (Next() >> 31) != 0;
+}
+
+Random& Random::ThreadEngine() {
+#if defined(_XO_NO_TLS)
+    // thread local objects need a trivial constructor here.
+    static _XOTLS Random* tlsEngine;
+    static _XOTLS char mem[sizeof(Random)];
+    if (!tlsEngine) {
+        tlsEngine = new(mem) Random(NewThreadEngine());
+    }
+    return *tlsEngine;
+#else
+    static _XOTLS Random tlsEngine(NewThreadEngine());
+    return tlsEngine;
+#endif
+}
+
+void Random::SeedThread(uint64_t seed, uint32_t stream) {
+    ThreadEngine() = Random(seed, stream);
+}
+
+////////////////////////////////////////////////////////////////////////// Random_x4
+
+#if defined(XO_SSE2)
+Random_x4::Random_x4() {
+    Seed(Random::DefaultSeed);
+}
+
+Random_x4::Random_x4(uint64_t seed, uint32_t stream) {
+    Seed(seed, stream);
+}
+
+Random_x4::Random_x4(Random& source) {
+    _XOSIMDALIGN uint32_t state[4][4];
+    for (int i = 0; i < 4; ++i) {
+        uint64_t seed = source.Next();
+        Random lane((seed << 32) | source.Next());
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm_load_si128((const __m128i*)state[j]);
+    }
+}
+
+void Random_x4::Seed(uint64_t seed, uint32_t stream) {
+    Random lane(seed, stream * 4);
+    _XOSIMDALIGN uint32_t state[4][4];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+        lane.Jump();
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm_load_si128((const __m128i*)state[j]);
+    }
+}
+
+__m128i Random_x4::Next() {
+    const __m128i result = _mm_add_epi32(s[0], s[3]);
+    const __m128i t = _mm_slli_epi32(s[1], 9);
+    s[2] = _mm_xor_si128(s[2], s[0]);
+    s[3] = _mm_xor_si128(s[3], s[1]);
+    s[1] = _mm_xor_si128(s[1], s[2]);
+    s[0] = _mm_xor_si128(s[0], s[3]);
+    s[2] = _mm_xor_si128(s[2], t);
+    s[3] = _mm_or_si128(_mm_slli_epi32(s[3], 11), _mm_srli_epi32(s[3], 21));
+    return result;
+}
+
+__m128 Random_x4::NextFloat() {
+    return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(Next(), 8)), _mm_set1_ps(1.0f / 16777216.0f));
+}
+
+__m128 Random_x4::Range(float low, float high) {
+    return Range(_mm_set1_ps(low), _mm_set1_ps(high));
+}
+
+__m128 Random_x4::Range(__m128 low, __m128 high) {
+    return _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), NextFloat()));
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////// Random_x8
+
+#if defined(XO_AVX2)
+Random_x8::Random_x8() {
+    Seed(Random::DefaultSeed);
+}
+
+Random_x8::Random_x8(uint64_t seed, uint32_t stream) {
+    Seed(seed, stream);
+}
+
+void Random_x8::Seed(uint64_t seed, uint32_t stream) {
+    Random lane(seed, stream * 8);
+    uint32_t state[4][8];
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            state[j][i] = lane.s[j];
+        }
+        lane.Jump();
+    }
+    for (int j = 0; j < 4; ++j) {
+        s[j] = _mm256_loadu_si256((const __m256i*)state[j]);
+    }
+}
+
+__m256i Random_x8::Next() {
+    const __m256i result = _mm256_add_epi32(s[0], s[3]);
+    const __m256i t = _mm256_slli_epi32(s[1], 9);
+    s[2] = _mm256_xor_si256(s[2], s[0]);
+    s[3] = _mm256_xor_si256(s[3], s[1]);
+    s[1] = _mm256_xor_si256(s[1], s[2]);
+    s[0] = _mm256_xor_si256(s[0], s[3]);
+    s[2] = _mm256_xor_si256(s[2], t);
+    s[3] = _mm256_or_si256(_mm256_slli_epi32(s[3], 11), _mm256_srli_epi32(s[3], 21));
+    return result;
+}
+
+__m256 Random_x8::NextFloat() {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(Next(), 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+
+__m256 Random_x8::Range(float low, float high) {
+    return Range(_mm256_set1_ps(low), _mm256_set1_ps(high));
+}
+
+__m256 Random_x8::Range(__m256 low, __m256 high) {
+    return _mm256_add_ps(low, _mm256_mul_ps(_mm256_sub_ps(high, low), NextFloat()));
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////// Free functions
+
+//! Returns true or false with equal probability, using the calling thread's engine.
+_XOINL
+bool RandomBool() {
+    return Random::ThreadEngine().Bool();
+}
+
+//! Returns an int in [low, high], using the calling thread's engine.
+_XOINL
+int RandomRange(int low, int high) {
+    return Random::ThreadEngine().Range(low, high);
+}
+
+//! Returns a float in [low, high), using the calling thread's engine.
+_XOINL
+float RandomRange(float low, float high) {
+    return Random::ThreadEngine().Range(low, high);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
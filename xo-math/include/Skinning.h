@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Linear blend skinning of vertex positions and normals against a palette of bone matrices.
+//!
+//! Each vertex is moved by up to four bones. The matrices of its bones are blended by its weights into one
+//! affine matrix, which then transforms the position as a point and the normal as a direction:
+//! \f$p' = (\sum_i w_i B_{b_i}) p\f$. That's one blend of three rows per vertex, rather than a transform per
+//! bone per vertex, and it gives the same result since the transform is linear.
+//!
+//! The palette holds the skinning matrix of each bone, which is its current world matrix times the inverse of its
+//! bind pose. Only the top three rows are read, so a palette of Matrix4x4s must be affine, the same as a palette of
+//! Matrix3x4s. The vertices are arrays of the same length, with one Influences per vertex.
+//!
+//! Normals are transformed by the blended matrix itself rather than its inverse transpose, and aren't
+//! renormalized, so they're exact for rotations and translations only. Vector3::Normalize of the output array
+//! corrects their length when bones are scaled or the blend shortens them.
+//! @sa https://en.wikipedia.org/wiki/Skeletal_animation
+class Skinning {
+public:
+    //! The bones that move one vertex, and how much each of them does.
+    struct Influences {
+        //! Indices into the palette. A bone that isn't used should have a weight of 0, but must still be a valid
+        //! index, such as 0.
+        int bones[4];
+        //! The weight of each bone, which should add up to 1.
+        float weights[4];
+    };
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Skins n vertices, writing the moved positions to outPositions and normals to outNormals. normals may be
+    //! null to skin positions alone, in which case outNormals isn't written and may be null too. The outputs may be
+    //! the same arrays as the inputs, but must not otherwise overlap them.
+    //!
+    //! With more than one thread, threadCount - 1 threads are started for the call, and every thread takes chunks
+    //! of a few thousand vertices at a time until there are none left. threadCount is capped at
+    //! std::thread::hardware_concurrency() and at the number of chunks. Starting the threads costs tens of
+    //! microseconds, so a program with its own job system should instead split the arrays into ranges and call
+    //! this with one thread per range.
+    static void Skin(const Matrix3x4* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+    //! See Skinning::Skin. Only the top three rows of each bone's matrix are read.
+    static void Skin(const Matrix4x4* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+    //! Dual quaternion skinning. See Skinning::Skin.
+    //!
+    //! The bones of each vertex are blended as dual quaternions rather than matrices, then normalized, so the
+    //! blended transform is still a rotation and translation. Where bones twist against each other, a blend of
+    //! matrices shrinks the mesh toward the joint, and this doesn't. A bone whose rotation is in the other
+    //! hemisphere from the vertex's first bone is blended negated, which is the same transform, so the blend
+    //! takes the shorter way around. The palette must be unit dual quaternions, and can't hold scale.
+    //! The normals come out unit length if they go in that way.
+    //!
+    //! Vertices are blended four at a time with SSE, or eight with AVX, one vertex per lane.
+    static void Skin(const DualQuaternion* palette, const Influences* influences, const Vector3* positions,
+                     const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount = 1);
+    //! @}
+};
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A position, rotation and scale, composed into a Matrix3x4 only when the matrix is asked for.
+//!
+//! The matrix is \f$T R S\f$: points are scaled, then rotated, then translated. Both the matrix and its inverse are
+//! cached, and a setter only marks them out of date, so a transform that hasn't changed since the last frame costs
+//! a flag test. Moving a transform whose matrix is up to date rewrites the translation in place rather than
+//! composing the whole matrix again. The rotation is assumed to be normalized throughout.
+//!
+//! The caches are updated from const methods, so a Transform must not be read from several threads while its
+//! matrices are out of date.
+//! @sa https://en.wikipedia.org/wiki/Transformation_matrix#Affine_transformations
+class _XOSIMDALIGN Transform {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    //! The identity transform, with its matrices already composed. Unlike the vector and matrix types this is
+    //! initialized, since the cached matrices need to start in a known state.
+    Transform();
+    //! A transform with no scale.
+    Transform(const Vector3& position, const Quaternion& rotation);
+    Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+    //! Takes the translation, the scale from the length of each column and the rotation from the normalized
+    //! columns. m must not have shear, or a negative or zero scale.
+    explicit Transform(const Matrix3x4& m);
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+    _XOINL const Vector3& GetPosition() const;
+    _XOINL const Quaternion& GetRotation() const;
+    _XOINL const Vector3& GetScale() const;
+    _XOINL Transform& SetPosition(const Vector3& position);
+    _XOINL Transform& SetRotation(const Quaternion& rotation);
+    _XOINL Transform& SetScale(const Vector3& scale);
+    _XOINL Transform& Set(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+    //! Returns the composed matrix, composing it first if a component has changed since it was last composed.
+    _XOINL const Matrix3x4& GetMatrix() const;
+    //! Returns the inverse of the composed matrix, composing it first if a component has changed since it was
+    //! last composed. This is exact even with a non-uniform scale. See Transform::ComposeInverseMatrix
+    _XOINL const Matrix3x4& GetInverseMatrix() const;
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Transform when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Scales, rotates and translates the point v, straight from the components. The cached matrix is neither
+    //! used nor updated; for more than a few points, GetMatrix().TransformPoints is faster.
+    Vector3 TransformPoint(const Vector3& v) const;
+    //! Scales and rotates the direction v, straight from the components.
+    Vector3 TransformDirection(const Vector3& v) const;
+    //! Undoes Transform::TransformPoint. Exact with any non-zero scale.
+    Vector3 InverseTransformPoint(const Vector3& v) const;
+
+    //! Sets this to the transform that undoes it: the inverse rotation, the reciprocal scale, and the position
+    //! that takes this transform's position back to the origin.
+    //!
+    //! A TRS transform can only represent \f$(T R S)^{-1} = S^{-1} R^{-1} T^{-1}\f$ when the scale is uniform,
+    //! since only then does \f$S^{-1}\f$ commute with \f$R^{-1}\f$. With a non-uniform scale use
+    //! Transform::GetInverseMatrix, which is always exact.
+    Transform& MakeInverse();
+    Transform Inverse() const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Assigns outTransform to child, placed within parent: applying outTransform is the same as applying child,
+    //! then parent.
+    //!
+    //! The position and rotation are always exact. The scales are multiplied, which is exact when the parent's
+    //! scale is uniform; a non-uniform parent scale on a rotated child would need shear, which TRS can't hold.
+    static void Combine(const Transform& parent, const Transform& child, Transform& outTransform);
+
+    //! Writes \f$T R S\f$ to outMatrix in one pass, without building the translation, rotation and scale matrices
+    //! and multiplying them. The columns of the rotation are scaled and the translation is written as the fourth
+    //! column.
+    static void ComposeMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale, Matrix3x4& outMatrix);
+    //! Writes \f$(T R S)^{-1} = S^{-1} R^T T^{-1}\f$ to outMatrix in one pass: the rows are the columns of the
+    //! rotation divided by the scale, and the translation is those rows applied to the negated position. The
+    //! scale must have no zero components.
+    static void ComposeInverseMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale, Matrix3x4& outMatrix);
+    //! @}
+
+    //!> See
+    //! @name Variants
+    //! Variants of other same-name static methods. See their documentation for more details under the
+    //! Static Methods heading.
+    //! @{
+    static Transform Combine(const Transform& parent, const Transform& child);
+    //! @}
+
+    static const Transform Identity;
+
+private:
+    enum : unsigned {
+        DirtyMatrix = 1,
+        DirtyInverse = 2,
+        DirtyAll = DirtyMatrix | DirtyInverse
+    };
+
+    // Compose the cached matrices and clear their flags. Out of line, so the checks in the getters stay small.
+
+    void UpdateMatrix() const;
+    void UpdateInverseMatrix() const;
+
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    mutable Matrix3x4 matrix;
+    mutable Matrix3x4 inverseMatrix;
+    mutable unsigned dirty;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,81 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+const Vector3& Transform::GetPosition() const {
+    return position;
+}
+
+const Quaternion& Transform::GetRotation() const {
+    return rotation;
+}
+
+const Vector3& Transform::GetScale() const {
+    return scale;
+}
+
+Transform& Transform::SetPosition(const Vector3& position) {
+    this->position = position;
+    // Only the translation column depends on the position, so an up to date matrix is patched rather than
+    // composed again. The inverse's translation depends on everything.
+    if (!(dirty & DirtyMatrix)) {
+        matrix.SetTranslation(position);
+    }
+    dirty |= DirtyInverse;
+    return *this;
+}
+
+Transform& Transform::SetRotation(const Quaternion& rotation) {
+    this->rotation = rotation;
+    dirty = DirtyAll;
+    return *this;
+}
+
+Transform& Transform::SetScale(const Vector3& scale) {
+    this->scale = scale;
+    dirty = DirtyAll;
+    return *this;
+}
+
+Transform& Transform::Set(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+    this->position = position;
+    this->rotation = rotation;
+    this->scale = scale;
+    dirty = DirtyAll;
+    return *this;
+}
+
+const Matrix3x4& Transform::GetMatrix() const {
+    if (dirty & DirtyMatrix) {
+        UpdateMatrix();
+    }
+    return matrix;
+}
+
+const Matrix3x4& Transform::GetInverseMatrix() const {
+    if (dirty & DirtyInverse) {
+        UpdateInverseMatrix();
+    }
+    return inverseMatrix;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
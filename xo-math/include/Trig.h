@@ -0,0 +1,392 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+// Sine and cosine kernels.
+//
+// Both tiers reduce the input to an octant with a Cody-Waite reduction by pi/4, then evaluate a minimax 
+// polynomial for sine or cosine on [-pi/4, pi/4] and pick/sign the result by octant. All lanes take the 
+// same path, so there's no branching per element.
+//
+// Errors below were measured against double precision sin/cos over 20 million evenly spaced inputs.
+//
+// Precise (Sin, Cos, SinCos):
+//      The cephes sinf/cosf polynomials with a three part reduction.
+//      Max error of 2 ulp over |x| <= pi. Max absolute error of 1e-7 over |x| <= 8192, where the ulp error 
+//      grows near the zero crossings (14 ulp over |x| <= 100).
+// Fast (FastSin, FastCos, FastSinCos):
+//      Degree 5 sine and degree 4 cosine polynomials with a two part reduction.
+//      Max absolute error of 1.4e-5 over |x| <= 8192. Max error of 232 ulp over |x| <= pi/4 and 722 ulp 
+//      over |x| <= pi.
+//
+// Beyond |x| of 8192 the reduction loses precision and results should not be relied on.
+// See: http://www.netlib.org/cephes/ and http://gruntthepeon.free.fr/ssemath/
+
+namespace sse {
+#if defined(XO_SSE2)
+    //! Computes the sine and cosine of each lane of x. When fast is true the lower accuracy tier is used.
+    //! fast is expected to be a constant, so the unused tier is compiled out.
+    _XOINL void SinCosKernel(__m128 x, __m128& s, __m128& c, bool fast) {
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+        const __m128i four = _mm_set1_epi32(4);
+
+        __m128 sinSign = _mm_and_ps(x, SignMask);
+        x = _mm_and_ps(x, AbsMask);
+
+        // j is the octant, rounded up to even so that the remainder is in [-pi/4, pi/4].
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(4.0f / PI)));
+        j = _mm_andnot_si128(one, _mm_add_epi32(j, one));
+        __m128 y = _mm_cvtepi32_ps(j);
+
+        // octants 4 to 7 flip the sign of sine, octants 2 to 5 flip the sign of cosine.
+        sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, four), 29)));
+        __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, two), four), 29));
+        // octants 2, 3, 6 and 7 swap the sine and cosine polynomials.
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), two));
+
+        __m128 z, sp, cp;
+        if (fast) {
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.41913398e-4f)));
+            z = _mm_mul_ps(x, x);
+            sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(8.18171306e-3f), z), _mm_set1_ps(-1.66647993e-1f));
+            sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, z), x), x);
+            cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(4.04584523e-2f), z), _mm_set1_ps(-4.99760557e-1f));
+            cp = _mm_add_ps(_mm_mul_ps(cp, z), One);
+        }
+        else {
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm_mul_ps(x, x);
+            sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+            sp = _mm_add_ps(_mm_mul_ps(sp, z), _mm_set1_ps(-1.6666654611e-1f));
+            sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, z), x), x);
+            cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+            cp = _mm_add_ps(_mm_mul_ps(cp, z), _mm_set1_ps(4.166664568298827e-2f));
+            cp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cp, z), z), _mm_sub_ps(One, _mm_mul_ps(z, _mm_set1_ps(0.5f))));
+        }
+
+        s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cp), _mm_andnot_ps(swap, sp)), sinSign);
+        c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sp), _mm_andnot_ps(swap, cp)), cosSign);
+    }
+
+    //! Sine and cosine of each lane. See the precise tier above.
+    _XOINL void SinCos(__m128 x, __m128& s, __m128& c)      { SinCosKernel(x, s, c, false); }
+    //! Sine and cosine of each lane. See the fast tier above.
+    _XOINL void FastSinCos(__m128 x, __m128& s, __m128& c)  { SinCosKernel(x, s, c, true); }
+    _XOINL __m128 Sin(__m128 x)     { __m128 s, c; SinCosKernel(x, s, c, false); return s; }
+    _XOINL __m128 Cos(__m128 x)     { __m128 s, c; SinCosKernel(x, s, c, false); return c; }
+    _XOINL __m128 FastSin(__m128 x) { __m128 s, c; SinCosKernel(x, s, c, true); return s; }
+    _XOINL __m128 FastCos(__m128 x) { __m128 s, c; SinCosKernel(x, s, c, true); return c; }
+#endif
+
+#if defined(_XO_KERNELS_AVX2)
+    //! Eight lane version of sse::SinCosKernel.
+    _XOINL _XO_TARGET_AVX2 void SinCosKernel(__m256 x, __m256& s, __m256& c, bool fast) {
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i two = _mm256_set1_epi32(2);
+        const __m256i four = _mm256_set1_epi32(4);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 oneF = _mm256_set1_ps(1.0f);
+
+        __m256 sinSign = _mm256_and_ps(x, signMask);
+        x = _mm256_andnot_ps(signMask, x);
+
+        __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(4.0f / PI)));
+        j = _mm256_andnot_si256(one, _mm256_add_epi32(j, one));
+        __m256 y = _mm256_cvtepi32_ps(j);
+
+        sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, four), 29)));
+        __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, two), four), 29));
+        __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, two), two));
+
+        __m256 z, sp, cp;
+        if (fast) {
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-2.41913398e-4f)));
+            z = _mm256_mul_ps(x, x);
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(8.18171306e-3f), z), _mm256_set1_ps(-1.66647993e-1f));
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sp, z), x), x);
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(4.04584523e-2f), z), _mm256_set1_ps(-4.99760557e-1f));
+            cp = _mm256_add_ps(_mm256_mul_ps(cp, z), oneF);
+        }
+        else {
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm256_mul_ps(x, x);
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), z), _mm256_set1_ps(8.3321608736e-3f));
+            sp = _mm256_add_ps(_mm256_mul_ps(sp, z), _mm256_set1_ps(-1.6666654611e-1f));
+            sp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sp, z), x), x);
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), z), _mm256_set1_ps(-1.388731625493765e-3f));
+            cp = _mm256_add_ps(_mm256_mul_ps(cp, z), _mm256_set1_ps(4.166664568298827e-2f));
+            cp = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(cp, z), z), _mm256_sub_ps(oneF, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))));
+        }
+
+        s = _mm256_xor_ps(_mm256_blendv_ps(sp, cp, swap), sinSign);
+        c = _mm256_xor_ps(_mm256_blendv_ps(cp, sp, swap), cosSign);
+    }
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+    //! Sixteen lane version of sse::SinCosKernel. The polynomial swap is a mask register rather than a blend mask.
+    _XOINL _XO_TARGET_AVX512 void SinCosKernel(__m512 x, __m512& s, __m512& c, bool fast) {
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i two = _mm512_set1_epi32(2);
+        const __m512i four = _mm512_set1_epi32(4);
+        const __m512 signMask = _mm512_set1_ps(-0.0f);
+        const __m512 oneF = _mm512_set1_ps(1.0f);
+
+        __m512 sinSign = _mm512_and_ps(x, signMask);
+        x = _mm512_andnot_ps(signMask, x);
+
+        __m512i j = _mm512_cvttps_epi32(_mm512_mul_ps(x, _mm512_set1_ps(4.0f / PI)));
+        j = _mm512_andnot_si512(one, _mm512_add_epi32(j, one));
+        __m512 y = _mm512_cvtepi32_ps(j);
+
+        sinSign = _mm512_xor_ps(sinSign, _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_and_si512(j, four), 29)));
+        __m512 cosSign = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_andnot_si512(_mm512_sub_epi32(j, two), four), 29));
+        __mmask16 swap = _mm512_test_epi32_mask(j, two);
+
+        __m512 z, sp, cp;
+        if (fast) {
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-0.78515625f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-2.41913398e-4f)));
+            z = _mm512_mul_ps(x, x);
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(8.18171306e-3f), z), _mm512_set1_ps(-1.66647993e-1f));
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(sp, z), x), x);
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(4.04584523e-2f), z), _mm512_set1_ps(-4.99760557e-1f));
+            cp = _mm512_add_ps(_mm512_mul_ps(cp, z), oneF);
+        }
+        else {
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-0.78515625f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm512_add_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(-3.77489497744594108e-8f)));
+            z = _mm512_mul_ps(x, x);
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(-1.9515295891e-4f), z), _mm512_set1_ps(8.3321608736e-3f));
+            sp = _mm512_add_ps(_mm512_mul_ps(sp, z), _mm512_set1_ps(-1.6666654611e-1f));
+            sp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(sp, z), x), x);
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(2.443315711809948e-5f), z), _mm512_set1_ps(-1.388731625493765e-3f));
+            cp = _mm512_add_ps(_mm512_mul_ps(cp, z), _mm512_set1_ps(4.166664568298827e-2f));
+            cp = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(cp, z), z), _mm512_sub_ps(oneF, _mm512_mul_ps(z, _mm512_set1_ps(0.5f))));
+        }
+
+        s = _mm512_xor_ps(_mm512_mask_blend_ps(swap, sp, cp), sinSign);
+        c = _mm512_xor_ps(_mm512_mask_blend_ps(swap, cp, sp), cosSign);
+    }
+#endif
+
+#if defined(XO_AVX2)
+
+    _XOINL void SinCos(__m256 x, __m256& s, __m256& c)      { SinCosKernel(x, s, c, false); }
+    _XOINL void FastSinCos(__m256 x, __m256& s, __m256& c)  { SinCosKernel(x, s, c, true); }
+    _XOINL __m256 Sin(__m256 x)     { __m256 s, c; SinCosKernel(x, s, c, false); return s; }
+    _XOINL __m256 Cos(__m256 x)     { __m256 s, c; SinCosKernel(x, s, c, false); return c; }
+    _XOINL __m256 FastSin(__m256 x) { __m256 s, c; SinCosKernel(x, s, c, true); return s; }
+    _XOINL __m256 FastCos(__m256 x) { __m256 s, c; SinCosKernel(x, s, c, true); return c; }
+#endif
+}
+
+// A single lane of the precise kernel measured no faster than the C library, so the scalar version stays there.
+_XOINL
+void SinCos(float f, float& s, float& c) { 
+    s = Sin(f);
+    c = Cos(f);
+}
+
+_XOINL
+void FastSinCos(float f, float& s, float& c) {
+    // Scalar version of the fast tier of sse::SinCosKernel.
+    float x = Abs(f);
+    int j = (int)(x * (4.0f / PI));
+    j = (j + 1) & ~1;
+    float y = (float)j;
+    x = (x + y * -0.78515625f) + y * -2.41913398e-4f;
+    float z = x * x;
+    float sp = ((8.18171306e-3f * z - 1.66647993e-1f) * z) * x + x;
+    float cp = (4.04584523e-2f * z - 4.99760557e-1f) * z + 1.0f;
+    bool swap = (j & 2) != 0;
+    s = swap ? cp : sp;
+    c = swap ? sp : cp;
+    if ((j & 4) != 0) {
+        s = -s;
+    }
+    if (f < 0.0f) {
+        s = -s;
+    }
+    if (((j - 2) & 4) == 0) {
+        c = -c;
+    }
+}
+
+_XOINL float FastSin(float f)   { float s, c; FastSinCos(f, s, c); return s; }
+_XOINL float FastCos(float f)   { float s, c; FastSinCos(f, s, c); return c; }
+
+_XOINL
+void Sin_x2(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Sin(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f)));
+    s[0] = t[0];
+    s[1] = t[1];
+#else
+    s[0] = Sin(f[0]);
+    s[1] = Sin(f[1]);
+#endif
+}
+
+_XOINL
+void Sin_x3(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Sin(_mm_setr_ps(f[0], f[1], f[2], 0.0f)));
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+#else
+    s[0] = Sin(f[0]);
+    s[1] = Sin(f[1]);
+    s[2] = Sin(f[2]);
+#endif
+}
+
+_XOINL
+void Sin_x4(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    _mm_store_ps(s, sse::Sin(_mm_load_ps(f)));
+#else
+    s[0] = Sin(f[0]);
+    s[1] = Sin(f[1]);
+    s[2] = Sin(f[2]);
+    s[3] = Sin(f[3]);
+#endif
+}
+
+_XOINL
+void Cos_x2(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Cos(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f)));
+    c[0] = t[0];
+    c[1] = t[1];
+#else
+    c[0] = Cos(f[0]);
+    c[1] = Cos(f[1]);
+#endif
+}
+
+_XOINL
+void Cos_x3(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float t[4];
+    _mm_store_ps(t, sse::Cos(_mm_setr_ps(f[0], f[1], f[2], 0.0f)));
+    c[0] = t[0];
+    c[1] = t[1];
+    c[2] = t[2];
+#else
+    c[0] = Cos(f[0]);
+    c[1] = Cos(f[1]);
+    c[2] = Cos(f[2]);
+#endif
+}
+
+_XOINL
+void Cos_x4(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    _mm_store_ps(c, sse::Cos(_mm_load_ps(f)));
+#else
+    c[0] = Cos(f[0]);
+    c[1] = Cos(f[1]);
+    c[2] = Cos(f[2]);
+    c[3] = Cos(f[3]);
+#endif
+}
+
+_XOINL
+void SinCos_x2(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float ts[4];
+    _XOSIMDALIGN float tc[4];
+    __m128 vs, vc;
+    sse::SinCos(_mm_setr_ps(f[0], f[1], 0.0f, 0.0f), vs, vc);
+    _mm_store_ps(ts, vs);
+    _mm_store_ps(tc, vc);
+    s[0] = ts[0]; c[0] = tc[0];
+    s[1] = ts[1]; c[1] = tc[1];
+#else
+    Sin_x2(f, s);
+    Cos_x2(f, c);
+#endif
+}
+
+_XOINL
+void SinCos_x3(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
+#if defined(XO_SSE2)
+    _XOSIMDALIGN float ts[4];
+    _XOSIMDALIGN float tc[4];
+    __m128 vs, vc;
+    sse::SinCos(_mm_setr_ps(f[0], f[1], f[2], 0.0f), vs, vc);
+    _mm_store_ps(ts, vs);
+    _mm_store_ps(tc, vc);
+    s[0] = ts[0]; c[0] = tc[0];
+    s[1] = ts[1]; c[1] = tc[1];
+    s[2] = ts[2]; c[2] = tc[2];
+#else
+    Sin_x3(f, s);
+    Cos_x3(f, c);
+#endif
+}
+
+_XOINL
+void SinCos_x4(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
+#if defined(XO_SSE2)
+    __m128 vs, vc;
+    sse::SinCos(_mm_load_ps(f), vs, vc);
+    _mm_store_ps(s, vs);
+    _mm_store_ps(c, vc);
+#else
+    Sin_x4(f, s);
+    Cos_x4(f, c);
+#endif
+}
+
+// Array versions. Inputs and outputs need no alignment, outputs may be the same array as the input.
+// n may be any count, the remainder that doesn't fill a register is processed as a partial register.
+void Sin(const float* f, float* s, size_t n);
+void Cos(const float* f, float* c, size_t n);
+void SinCos(const float* f, float* s, float* c, size_t n);
+void FastSin(const float* f, float* s, size_t n);
+void FastCos(const float* f, float* c, size_t n);
+void FastSinCos(const float* f, float* s, float* c, size_t n);
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -305,6 +305,15 @@ public:
     //!
     //! @sa https://en.wikipedia.org/wiki/Dot_product
     static float Dot(const Vector3& a, const Vector3& b);
+    //! Writes the Dot of each pair a[i] and b[i] to outDots[i], for n pairs.
+    //! Runs on the batch kernels, see Dispatch.h.
+    static void Dot(const Vector3* a, const Vector3* b, float* outDots, size_t n);
+    //! Normalizes n vectors from in to out. As with Vector3::Normalize, zero vectors are not handled.
+    //! Runs on the batch kernels, see Dispatch.h. The AVX and AVX-512 kernels use a refined reciprocal square root,
+    //! which may differ from Vector3::Normalize in the last bits.
+    static void Normalize(const Vector3* in, Vector3* out, size_t n);
+    //! Normalizes n vectors in place. See Vector3::Normalize(const Vector3*, Vector3*, size_t)
+    static void Normalize(Vector3* inOut, size_t n);
     
     //! @}
 
@@ -329,7 +338,8 @@ public:
         outVec.Set(RandomRange(-size, size), RandomRange(-size, size), RandomRange(-size, size));
     }
     static void RandomInSphere(float minRadius, float maxRadius, Vector3& outVec) {
-        RandomOnSphere(Sqrt(RandomRange(minRadius, maxRadius)), outVec);
+        // uniform in volume, so the radius is the cube root of a uniform value between the cubed radii.
+        RandomOnSphere(Cbrt(RandomRange(minRadius*minRadius*minRadius, maxRadius*maxRadius*maxRadius)), outVec);
     }
     static void RandomInSphere(float radius, Vector3& outVec) {
         RandomInSphere(0.0f, radius, outVec);
@@ -359,6 +369,30 @@ public:
         RandomOnSphere(1.0f, outVec);
     }
 
+    //! Array versions of the methods above, each assigning n vectors to outVecs. Meant for bulk work such as
+    //! particle emitters.
+    //! With SSE the vectors are made four at a time, from a Random_x4 seeded by the calling thread's engine. 
+    //! The distributions are the same as the single vector versions, but not the exact sequence.
+    static void RandomInCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n);
+    static void RandomInConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n);
+    static void RandomInCube(float size, Vector3* outVecs, size_t n);
+    static void RandomInFanRadians(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n);
+    static void RandomInSphere(float minRadius, float maxRadius, Vector3* outVecs, size_t n);
+    static void RandomOnCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n);
+    static void RandomOnConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n);
+    static void RandomOnCube(float size, Vector3* outVecs, size_t n);
+    static void RandomOnSphere(float radius, Vector3* outVecs, size_t n);
+
+    static void RandomInConeDegrees(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+        RandomInConeRadians(forward, angle * Deg2Rad, outVecs, n);
+    }
+    static void RandomInFanDegrees(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n) {
+        RandomInFanRadians(forward, up, angle * Deg2Rad, outVecs, n);
+    }
+    static void RandomOnConeDegrees(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+        RandomOnConeRadians(forward, angle * Deg2Rad, outVecs, n);
+    }
+
     //! @}
 
 #define _RET_VARIANT(name) { Vector3 tempV; name(
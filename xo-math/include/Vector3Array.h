@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Three tightly packed floats, for storing a Vector3 in 12 bytes rather than 16.
+//!
+//! Vector3 is padded to 16 bytes so it fits a SIMD register, and the padding is a quarter of any array of them.
+//! Float3 leaves it out, for large arrays such as meshes and point clouds where that adds up. Like the Half types
+//! it has no math of its own: convert to a Vector3 to work with one, or use the array functions that take Float3
+//! directly, such as Pack, Unpack and Matrix4x4::TransformPoints(const Float3*, Float3*, size_t) const.
+struct Float3 {
+    Float3() {} //!< Performs no initialization.
+    _XOINL Float3(float x, float y, float z);
+    _XOINL explicit Float3(const class Vector3& v);
+    _XOINL operator Vector3() const;
+
+    float x, y, z;
+};
+
+// Array versions. Inputs and outputs need no alignment, and n may be any count. Both use unaligned 16 byte loads
+// or stores that overlap the next element, except for the last element, so nothing past the end of either array is
+// read or written. An output must not overlap its input.
+
+//! Packs n Vector3s from in to the Float3s of out.
+void Pack(const Vector3* in, Float3* out, size_t n);
+//! Unpacks n Float3s from in to the Vector3s of out. The w of each Vector3 is set to zero.
+void Unpack(const Float3* in, Vector3* out, size_t n);
+
+//! @brief A resizable array of Vector3s, stored packed as Float3s.
+//!
+//! It takes three quarters of the memory of a std::vector<Vector3>. Single elements convert to and from Vector3
+//! with Get and Set; ranges convert in bulk with the array forms of Get and Set, which use Pack and Unpack. The
+//! transforms work on the packed elements directly, without unpacking them first.
+class Vector3Array {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Vector3Array(); //!< An empty array.
+    explicit Vector3Array(size_t n); //!< n elements, without initialization.
+    Vector3Array(const Vector3* v, size_t n); //!< A copy of the n Vector3s of v.
+    //! @}
+
+    //! @name Size
+    //! @{
+    _XOINL size_t GetCount() const;
+    //! Reserves memory for n elements, so growing to that many doesn't reallocate.
+    void Reserve(size_t n);
+    //! Changes the count to n. Any new elements are not initialized.
+    void Resize(size_t n);
+    //! Removes every element.
+    void Clear();
+    //! Adds v to the end.
+    void Add(const Vector3& v);
+    //! Adds the n Vector3s of v to the end.
+    void Add(const Vector3* v, size_t n);
+    //! @}
+
+    //! @name Set / Get Methods
+    //! @{
+    _XOINL Vector3 Get(size_t i) const;
+    _XOINL void Set(size_t i, const Vector3& v);
+    //! Unpacks the n elements from first onward to out.
+    void Get(size_t first, Vector3* out, size_t n) const;
+    //! Packs the n Vector3s of in to the elements from first onward, which must already exist.
+    void Set(size_t first, const Vector3* in, size_t n);
+    //! The packed elements, GetCount() of them.
+    _XOINL Float3* GetData();
+    _XOINL const Float3* GetData() const;
+    _XOINL Float3& operator [](size_t i);
+    _XOINL const Float3& operator [](size_t i) const;
+    //! @}
+
+    //! @name Methods
+    //! @{
+
+    //! Transforms every element as a point by m, in place. See Matrix4x4::TransformPoints
+    void TransformPoints(const class Matrix4x4& m);
+    //! Transforms every element as a direction by m, in place. See Matrix4x4::TransformDirections
+    void TransformDirections(const class Matrix4x4& m);
+    //! @}
+
+private:
+    std::vector<Float3> elements;
+};
+
+XOMATH_END_XO_NS();
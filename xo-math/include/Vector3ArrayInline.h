@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+Float3::Float3(float x, float y, float z) :
+    x(x),
+    y(y),
+    z(z)
+{
+}
+
+Float3::Float3(const Vector3& v) :
+    x(v.x),
+    y(v.y),
+    z(v.z)
+{
+}
+
+Float3::operator Vector3() const {
+    return Vector3(x, y, z);
+}
+
+size_t Vector3Array::GetCount() const {
+    return elements.size();
+}
+
+Vector3 Vector3Array::Get(size_t i) const {
+    return elements[i];
+}
+
+void Vector3Array::Set(size_t i, const Vector3& v) {
+    elements[i] = Float3(v);
+}
+
+Float3* Vector3Array::GetData() {
+    return elements.data();
+}
+
+const Float3* Vector3Array::GetData() const {
+    return elements.data();
+}
+
+Float3& Vector3Array::operator [](size_t i) {
+    return elements[i];
+}
+
+const Float3& Vector3Array::operator [](size_t i) const {
+    return elements[i];
+}
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,460 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3x4::Vector3x4(float f) {
+#if defined(XO_SSE)
+    xmmX = xmmY = xmmZ = _mm_set1_ps(f);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = y[i] = z[i] = f;
+    }
+#endif
+}
+
+Vector3x4::Vector3x4(const Vector3& v) {
+    Set(v);
+}
+
+Vector3x4::Vector3x4(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+    Set(v0, v1, v2, v3);
+}
+
+Vector3x4::Vector3x4(const Vector4& x, const Vector4& y, const Vector4& z) {
+#if defined(XO_SSE)
+    xmmX = x.xmm;
+    xmmY = y.xmm;
+    xmmZ = z.xmm;
+#else
+    for (int i = 0; i < 4; ++i) {
+        this->x[i] = x.f[i];
+        this->y[i] = y.f[i];
+        this->z[i] = z.f[i];
+    }
+#endif
+}
+
+Vector3x4::Vector3x4(const Vector3x4& v) {
+    Set(v);
+}
+
+#if defined(XO_SSE)
+Vector3x4::Vector3x4(const __m128& x, const __m128& y, const __m128& z) :
+    xmmX(x), xmmY(y), xmmZ(z)
+{
+}
+#endif
+
+Vector3x4& Vector3x4::Set(const Vector3& v) {
+#if defined(XO_SSE)
+    xmmX = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(0, 0, 0, 0));
+    xmmY = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(1, 1, 1, 1));
+    xmmZ = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(2, 2, 2, 2));
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::Set(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+#if defined(XO_SSE)
+    // Transpose the four xyzw registers into xxxx, yyyy, zzzz. w is discarded.
+    __m128 t0 = _mm_unpacklo_ps(v0.xmm, v1.xmm);
+    __m128 t1 = _mm_unpacklo_ps(v2.xmm, v3.xmm);
+    __m128 t2 = _mm_unpackhi_ps(v0.xmm, v1.xmm);
+    __m128 t3 = _mm_unpackhi_ps(v2.xmm, v3.xmm);
+    xmmX = _mm_movelh_ps(t0, t1);
+    xmmY = _mm_movehl_ps(t1, t0);
+    xmmZ = _mm_movelh_ps(t2, t3);
+#else
+    SetLane(0, v0);
+    SetLane(1, v1);
+    SetLane(2, v2);
+    SetLane(3, v3);
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::Set(const Vector3x4& v) {
+#if defined(XO_SSE)
+    xmmX = v.xmmX;
+    xmmY = v.xmmY;
+    xmmZ = v.xmmZ;
+#else
+    for (int i = 0; i < 12; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x4& Vector3x4::SetLane(int lane, const Vector3& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    return *this;
+}
+
+Vector3 Vector3x4::GetLane(int lane) const {
+    return Vector3(x[lane], y[lane], z[lane]);
+}
+
+void Vector3x4::Get(Vector3& v0, Vector3& v1, Vector3& v2, Vector3& v3) const {
+#if defined(XO_SSE)
+    // Transpose xxxx, yyyy, zzzz back into four xyz0 registers.
+    __m128 t0 = _mm_unpacklo_ps(xmmX, xmmY);
+    __m128 t1 = _mm_unpackhi_ps(xmmX, xmmY);
+    __m128 t2 = _mm_unpacklo_ps(xmmZ, sse::Zero);
+    __m128 t3 = _mm_unpackhi_ps(xmmZ, sse::Zero);
+    v0.xmm = _mm_movelh_ps(t0, t2);
+    v1.xmm = _mm_movehl_ps(t2, t0);
+    v2.xmm = _mm_movelh_ps(t1, t3);
+    v3.xmm = _mm_movehl_ps(t3, t1);
+#else
+    v0 = GetLane(0);
+    v1 = GetLane(1);
+    v2 = GetLane(2);
+    v3 = GetLane(3);
+#endif
+}
+
+Vector3x4 Vector3x4::Load(const Vector3* v) {
+    return Vector3x4(v[0], v[1], v[2], v[3]);
+}
+
+Vector3x4 Vector3x4::LoadPartial(const Vector3* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector3x4::LoadPartial count must be between 0 and 4.");
+    switch (count) {
+        case 4:  return Vector3x4(v[0], v[1], v[2], v[3]);
+        case 3:  return Vector3x4(v[0], v[1], v[2], Vector3::Zero);
+        case 2:  return Vector3x4(v[0], v[1], Vector3::Zero, Vector3::Zero);
+        case 1:  return Vector3x4(v[0], Vector3::Zero, Vector3::Zero, Vector3::Zero);
+        default: return Vector3x4(0.0f);
+    }
+}
+
+Vector3x4 Vector3x4::LoadSoA(const float* x, const float* y, const float* z) {
+#if defined(XO_SSE)
+    return Vector3x4(_mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z));
+#else
+    Vector3x4 v;
+    for (int i = 0; i < 4; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+    }
+    return v;
+#endif
+}
+
+void Vector3x4::Store(Vector3* v) const {
+    Get(v[0], v[1], v[2], v[3]);
+}
+
+void Vector3x4::StorePartial(Vector3* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector3x4::StorePartial count must be between 0 and 4.");
+    if (count == 4) {
+        Store(v);
+        return;
+    }
+    Vector3 t[4];
+    Get(t[0], t[1], t[2], t[3]);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector3x4::StoreSoA(float* x, float* y, float* z) const {
+#if defined(XO_SSE)
+    _mm_storeu_ps(x, xmmX);
+    _mm_storeu_ps(y, xmmY);
+    _mm_storeu_ps(z, xmmZ);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+    }
+#endif
+}
+
+Vector3x4 Vector3x4::operator -() const {
+#if defined(XO_SSE)
+    return Vector3x4(_mm_xor_ps(xmmX, sse::SignMask), _mm_xor_ps(xmmY, sse::SignMask), _mm_xor_ps(xmmZ, sse::SignMask));
+#else
+    Vector3x4 v;
+    for (int i = 0; i < 12; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_SSE)
+#   define _XO_W3X4_OP_X4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector3x4& v) { \
+        xmmX = sseop(xmmX, v.xmmX); xmmY = sseop(xmmY, v.xmmY); xmmZ = sseop(xmmZ, v.xmmZ); \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_V4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector4& v) { \
+        xmmX = sseop(xmmX, v.xmm); xmmY = sseop(xmmY, v.xmm); xmmZ = sseop(xmmZ, v.xmm); \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_F(op, sseop) \
+    Vector3x4& Vector3x4::operator op (float v) { \
+        __m128 s = _mm_set1_ps(v); \
+        xmmX = sseop(xmmX, s); xmmY = sseop(xmmY, s); xmmZ = sseop(xmmZ, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W3X4_OP_X4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector3x4& v) { \
+        for (int i = 0; i < 12; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_V4(op, sseop) \
+    Vector3x4& Vector3x4::operator op (const Vector4& v) { \
+        for (int i = 0; i < 4; ++i) { x[i] op v.f[i]; y[i] op v.f[i]; z[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X4_OP_F(op, sseop) \
+    Vector3x4& Vector3x4::operator op (float v) { \
+        for (int i = 0; i < 12; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W3X4_OP_X4(+=, _mm_add_ps)
+_XO_W3X4_OP_V4(+=, _mm_add_ps)
+_XO_W3X4_OP_F(+=, _mm_add_ps)
+_XO_W3X4_OP_X4(-=, _mm_sub_ps)
+_XO_W3X4_OP_V4(-=, _mm_sub_ps)
+_XO_W3X4_OP_F(-=, _mm_sub_ps)
+_XO_W3X4_OP_X4(*=, _mm_mul_ps)
+_XO_W3X4_OP_V4(*=, _mm_mul_ps)
+_XO_W3X4_OP_F(*=, _mm_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_SSE)
+_XO_W3X4_OP_X4(/=, _mm_div_ps)
+_XO_W3X4_OP_V4(/=, _mm_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of _mm_rcp_ps vs. _mm_div_ps.
+Vector3x4& Vector3x4::operator /= (const Vector3x4& v) {
+    xmmX = _mm_mul_ps(xmmX, _mm_rcp_ps(v.xmmX));
+    xmmY = _mm_mul_ps(xmmY, _mm_rcp_ps(v.xmmY));
+    xmmZ = _mm_mul_ps(xmmZ, _mm_rcp_ps(v.xmmZ));
+    return *this;
+}
+
+Vector3x4& Vector3x4::operator /= (const Vector4& v) {
+    // one reciprocal for all three elements of each lane.
+    __m128 r = _mm_rcp_ps(v.xmm);
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    return *this;
+}
+#endif
+
+#undef _XO_W3X4_OP_X4
+#undef _XO_W3X4_OP_V4
+#undef _XO_W3X4_OP_F
+
+Vector3x4& Vector3x4::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector3x4& Vector3x4::operator += (const Vector3& v)        { return (*this) += Vector3x4(v); }
+Vector3x4& Vector3x4::operator += (double v)                { return (*this) += float(v); }
+Vector3x4& Vector3x4::operator += (int v)                   { return (*this) += float(v); }
+Vector3x4& Vector3x4::operator -= (const Vector3& v)        { return (*this) -= Vector3x4(v); }
+Vector3x4& Vector3x4::operator -= (double v)                { return (*this) -= float(v); }
+Vector3x4& Vector3x4::operator -= (int v)                   { return (*this) -= float(v); }
+Vector3x4& Vector3x4::operator *= (const Vector3& v)        { return (*this) *= Vector3x4(v); }
+Vector3x4& Vector3x4::operator *= (double v)                { return (*this) *= float(v); }
+Vector3x4& Vector3x4::operator *= (int v)                   { return (*this) *= float(v); }
+Vector3x4& Vector3x4::operator /= (const Vector3& v)        { return (*this) /= Vector3x4(v); }
+Vector3x4& Vector3x4::operator /= (double v)                { return (*this) /= float(v); }
+Vector3x4& Vector3x4::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector3x4 Vector3x4::operator + (const Vector3x4& v) const  { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (const Vector3& v) const    { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (const Vector4& v) const    { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (float v) const             { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (double v) const            { return Vector3x4(*this) += v; }
+Vector3x4 Vector3x4::operator + (int v) const               { return Vector3x4(*this) += v; }
+
+Vector3x4 Vector3x4::operator - (const Vector3x4& v) const  { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (const Vector3& v) const    { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (const Vector4& v) const    { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (float v) const             { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (double v) const            { return Vector3x4(*this) -= v; }
+Vector3x4 Vector3x4::operator - (int v) const               { return Vector3x4(*this) -= v; }
+
+Vector3x4 Vector3x4::operator * (const Vector3x4& v) const  { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (const Vector3& v) const    { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (const Vector4& v) const    { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (float v) const             { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (double v) const            { return Vector3x4(*this) *= v; }
+Vector3x4 Vector3x4::operator * (int v) const               { return Vector3x4(*this) *= v; }
+
+Vector3x4 Vector3x4::operator / (const Vector3x4& v) const  { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (const Vector3& v) const    { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (const Vector4& v) const    { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (float v) const             { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (double v) const            { return Vector3x4(*this) /= v; }
+Vector3x4 Vector3x4::operator / (int v) const               { return Vector3x4(*this) /= v; }
+
+bool Vector3x4::operator == (const Vector3x4& v) const {
+#if defined(XO_SSE)
+    __m128 eq = _mm_and_ps(
+        _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmX, xmmX)), sse::Epsilon),
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmY, xmmY)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmZ, xmmZ)), sse::Epsilon)));
+    return _mm_movemask_ps(eq) == 15;
+#else
+    for (int i = 0; i < 12; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector3::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector3x4::operator != (const Vector3x4& v) const      { return !((*this) == v); }
+
+Vector4 Vector3x4::Magnitude() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_sqrt_ps(MagnitudeSquared().xmm));
+#else
+    Vector4 m = MagnitudeSquared();
+    return Vector4(Sqrt(m.x), Sqrt(m.y), Sqrt(m.z), Sqrt(m.w));
+#endif
+}
+
+Vector4 Vector3x4::Sum() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(xmmX, xmmY), xmmZ));
+#else
+    return Vector4(x[0] + y[0] + z[0], x[1] + y[1] + z[1], x[2] + y[2] + z[2], x[3] + y[3] + z[3]);
+#endif
+}
+
+Vector3x4& Vector3x4::Normalize() {
+#if defined(XO_SSE) && !defined(XO_NO_INVERSE_DIVISION)
+    // _mm_rsqrt_ps has a relative error of 1.5*2^-12, one newton-raphson step brings it close to full precision:
+    //      r' = r * (1.5 - 0.5 * m * r * r)
+    __m128 m = MagnitudeSquared().xmm;
+    __m128 r = _mm_rsqrt_ps(m);
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), _mm_mul_ps(r, r))));
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    return *this;
+#else
+    return (*this) /= Magnitude();
+#endif
+}
+
+Vector3x4& Vector3x4::NormalizeSafe() {
+#if defined(XO_SSE)
+    __m128 nonZero = _mm_cmpgt_ps(MagnitudeSquared().xmm, sse::Zero);
+    Vector3x4 n = Normalized();
+    xmmX = _mm_or_ps(_mm_and_ps(nonZero, n.xmmX), _mm_andnot_ps(nonZero, xmmX));
+    xmmY = _mm_or_ps(_mm_and_ps(nonZero, n.xmmY), _mm_andnot_ps(nonZero, xmmY));
+    xmmZ = _mm_or_ps(_mm_and_ps(nonZero, n.xmmZ), _mm_andnot_ps(nonZero, xmmZ));
+#else
+    Vector4 m = MagnitudeSquared();
+    for (int i = 0; i < 4; ++i) {
+        if (m.f[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m.f[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector3x4::Cross(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    // No shuffles needed in the structure of arrays layout, each element is a plain register.
+    __m128 x = _mm_sub_ps(_mm_mul_ps(a.xmmY, b.xmmZ), _mm_mul_ps(a.xmmZ, b.xmmY));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(a.xmmZ, b.xmmX), _mm_mul_ps(a.xmmX, b.xmmZ));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(a.xmmX, b.xmmY), _mm_mul_ps(a.xmmY, b.xmmX));
+    outVec.xmmX = x;
+    outVec.xmmY = y;
+    outVec.xmmZ = z;
+#else
+    Vector3x4 t;
+    for (int i = 0; i < 4; ++i) {
+        t.x[i] = (a.y[i] * b.z[i]) - (a.z[i] * b.y[i]);
+        t.y[i] = (a.z[i] * b.x[i]) - (a.x[i] * b.z[i]);
+        t.z[i] = (a.x[i] * b.y[i]) - (a.y[i] * b.x[i]);
+    }
+    outVec = t;
+#endif
+}
+
+Vector4 Vector3x4::Dot(const Vector3x4& a, const Vector3x4& b) {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.xmmX, b.xmmX), _mm_mul_ps(a.xmmY, b.xmmY)), _mm_mul_ps(a.xmmZ, b.xmmZ)));
+#else
+    Vector4 d;
+    for (int i = 0; i < 4; ++i) {
+        d.f[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+    }
+    return d;
+#endif
+}
+
+void Vector3x4::Max(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_max_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_max_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_max_ps(a.xmmZ, b.xmmZ);
+#else
+    for (int i = 0; i < 12; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector3x4::Min(const Vector3x4& a, const Vector3x4& b, Vector3x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_min_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_min_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_min_ps(a.xmmZ, b.xmmZ);
+#else
+    for (int i = 0; i < 12; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
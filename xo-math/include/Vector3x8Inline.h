@@ -0,0 +1,486 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3x8::Vector3x8(float f) {
+#if defined(XO_AVX)
+    ymmX = ymmY = ymmZ = _mm256_set1_ps(f);
+#else
+    for (int i = 0; i < 24; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector3x8::Vector3x8(const Vector3& v) {
+    Set(v);
+}
+
+Vector3x8::Vector3x8(const Vector3x4& low, const Vector3x4& high) {
+    Set(low, high);
+}
+
+Vector3x8::Vector3x8(const Vector3x8& v) {
+    Set(v);
+}
+
+#if defined(XO_AVX)
+Vector3x8::Vector3x8(const __m256& x, const __m256& y, const __m256& z) :
+    ymmX(x), ymmY(y), ymmZ(z)
+{
+}
+#endif
+
+Vector3x8& Vector3x8::Set(const Vector3& v) {
+#if defined(XO_AVX)
+    ymmX = _mm256_set1_ps(v.x);
+    ymmY = _mm256_set1_ps(v.y);
+    ymmZ = _mm256_set1_ps(v.z);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::Set(const Vector3x4& low, const Vector3x4& high) {
+#if defined(XO_AVX)
+    ymmX = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmX), high.xmmX, 1);
+    ymmY = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmY), high.xmmY, 1);
+    ymmZ = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmZ), high.xmmZ, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = low.x[i];
+        y[i] = low.y[i];
+        z[i] = low.z[i];
+        x[i + 4] = high.x[i];
+        y[i + 4] = high.y[i];
+        z[i + 4] = high.z[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::Set(const Vector3x8& v) {
+#if defined(XO_AVX)
+    ymmX = v.ymmX;
+    ymmY = v.ymmY;
+    ymmZ = v.ymmZ;
+#else
+    for (int i = 0; i < 24; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::SetLane(int lane, const Vector3& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    return *this;
+}
+
+Vector3 Vector3x8::GetLane(int lane) const {
+    return Vector3(x[lane], y[lane], z[lane]);
+}
+
+void Vector3x8::Get(Vector3x4& low, Vector3x4& high) const {
+#if defined(XO_AVX)
+    low.xmmX = _mm256_castps256_ps128(ymmX);
+    low.xmmY = _mm256_castps256_ps128(ymmY);
+    low.xmmZ = _mm256_castps256_ps128(ymmZ);
+    high.xmmX = _mm256_extractf128_ps(ymmX, 1);
+    high.xmmY = _mm256_extractf128_ps(ymmY, 1);
+    high.xmmZ = _mm256_extractf128_ps(ymmZ, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        low.SetLane(i, GetLane(i));
+        high.SetLane(i, GetLane(i + 4));
+    }
+#endif
+}
+
+Vector3x8 Vector3x8::Load(const Vector3* v) {
+#if defined(XO_AVX)
+    // Vectors i and i+4 share a register, one per 128 bit lane. From there it's the same in-lane 4x4 transpose
+    // as Vector3x4::Set, which leaves vectors 0 to 3 in the low lanes and 4 to 7 in the high lanes. w is discarded.
+    __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[0].xmm), v[4].xmm, 1);
+    __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[1].xmm), v[5].xmm, 1);
+    __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[2].xmm), v[6].xmm, 1);
+    __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[3].xmm), v[7].xmm, 1);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    return Vector3x8(
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+#else
+    Vector3x8 r;
+    for (int i = 0; i < 8; ++i) {
+        r.SetLane(i, v[i]);
+    }
+    return r;
+#endif
+}
+
+Vector3x8 Vector3x8::LoadPartial(const Vector3* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector3x8::LoadPartial count must be between 0 and 8.");
+    if (count == 8) {
+        return Load(v);
+    }
+    Vector3 t[8];
+    for (int i = 0; i < 8; ++i) {
+        t[i] = i < count ? v[i] : Vector3::Zero;
+    }
+    return Load(t);
+}
+
+Vector3x8 Vector3x8::LoadSoA(const float* x, const float* y, const float* z) {
+#if defined(XO_AVX)
+    return Vector3x8(_mm256_loadu_ps(x), _mm256_loadu_ps(y), _mm256_loadu_ps(z));
+#else
+    Vector3x8 v;
+    for (int i = 0; i < 8; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+    }
+    return v;
+#endif
+}
+
+void Vector3x8::Store(Vector3* v) const {
+#if defined(XO_AVX)
+    // The reverse of Load, transposing within each 128 bit lane then splitting the lanes. w is written as zero.
+    __m256 t0 = _mm256_unpacklo_ps(ymmX, ymmY);
+    __m256 t1 = _mm256_unpackhi_ps(ymmX, ymmY);
+    __m256 t2 = _mm256_unpacklo_ps(ymmZ, avx::Zero);
+    __m256 t3 = _mm256_unpackhi_ps(ymmZ, avx::Zero);
+    __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    v[0].xmm = _mm256_castps256_ps128(r0);
+    v[1].xmm = _mm256_castps256_ps128(r1);
+    v[2].xmm = _mm256_castps256_ps128(r2);
+    v[3].xmm = _mm256_castps256_ps128(r3);
+    v[4].xmm = _mm256_extractf128_ps(r0, 1);
+    v[5].xmm = _mm256_extractf128_ps(r1, 1);
+    v[6].xmm = _mm256_extractf128_ps(r2, 1);
+    v[7].xmm = _mm256_extractf128_ps(r3, 1);
+#else
+    for (int i = 0; i < 8; ++i) {
+        v[i] = GetLane(i);
+    }
+#endif
+}
+
+void Vector3x8::StorePartial(Vector3* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector3x8::StorePartial count must be between 0 and 8.");
+    if (count == 8) {
+        Store(v);
+        return;
+    }
+    Vector3 t[8];
+    Store(t);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector3x8::StoreSoA(float* x, float* y, float* z) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(x, ymmX);
+    _mm256_storeu_ps(y, ymmY);
+    _mm256_storeu_ps(z, ymmZ);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+    }
+#endif
+}
+
+Vector3x8 Vector3x8::operator -() const {
+#if defined(XO_AVX)
+    return Vector3x8(_mm256_xor_ps(ymmX, avx::SignMask), _mm256_xor_ps(ymmY, avx::SignMask), _mm256_xor_ps(ymmZ, avx::SignMask));
+#else
+    Vector3x8 v;
+    for (int i = 0; i < 24; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_AVX)
+#   define _XO_W3X8_OP_X8(op, avxop) \
+    Vector3x8& Vector3x8::operator op (const Vector3x8& v) { \
+        ymmX = avxop(ymmX, v.ymmX); ymmY = avxop(ymmY, v.ymmY); ymmZ = avxop(ymmZ, v.ymmZ); \
+        return *this; \
+    }
+#   define _XO_W3X8_OP_F(op, avxop) \
+    Vector3x8& Vector3x8::operator op (float v) { \
+        __m256 s = _mm256_set1_ps(v); \
+        ymmX = avxop(ymmX, s); ymmY = avxop(ymmY, s); ymmZ = avxop(ymmZ, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W3X8_OP_X8(op, avxop) \
+    Vector3x8& Vector3x8::operator op (const Vector3x8& v) { \
+        for (int i = 0; i < 24; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W3X8_OP_F(op, avxop) \
+    Vector3x8& Vector3x8::operator op (float v) { \
+        for (int i = 0; i < 24; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W3X8_OP_X8(+=, _mm256_add_ps)
+_XO_W3X8_OP_F(+=, _mm256_add_ps)
+_XO_W3X8_OP_X8(-=, _mm256_sub_ps)
+_XO_W3X8_OP_F(-=, _mm256_sub_ps)
+_XO_W3X8_OP_X8(*=, _mm256_mul_ps)
+_XO_W3X8_OP_F(*=, _mm256_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_AVX)
+_XO_W3X8_OP_X8(/=, _mm256_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of rcp vs. div, which is much the same for the 256 bit forms.
+Vector3x8& Vector3x8::operator /= (const Vector3x8& v) {
+    ymmX = _mm256_mul_ps(ymmX, _mm256_rcp_ps(v.ymmX));
+    ymmY = _mm256_mul_ps(ymmY, _mm256_rcp_ps(v.ymmY));
+    ymmZ = _mm256_mul_ps(ymmZ, _mm256_rcp_ps(v.ymmZ));
+    return *this;
+}
+#endif
+
+#undef _XO_W3X8_OP_X8
+#undef _XO_W3X8_OP_F
+
+Vector3x8& Vector3x8::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector3x8& Vector3x8::operator += (const Vector3& v)        { return (*this) += Vector3x8(v); }
+Vector3x8& Vector3x8::operator += (double v)                { return (*this) += float(v); }
+Vector3x8& Vector3x8::operator += (int v)                   { return (*this) += float(v); }
+Vector3x8& Vector3x8::operator -= (const Vector3& v)        { return (*this) -= Vector3x8(v); }
+Vector3x8& Vector3x8::operator -= (double v)                { return (*this) -= float(v); }
+Vector3x8& Vector3x8::operator -= (int v)                   { return (*this) -= float(v); }
+Vector3x8& Vector3x8::operator *= (const Vector3& v)        { return (*this) *= Vector3x8(v); }
+Vector3x8& Vector3x8::operator *= (double v)                { return (*this) *= float(v); }
+Vector3x8& Vector3x8::operator *= (int v)                   { return (*this) *= float(v); }
+Vector3x8& Vector3x8::operator /= (const Vector3& v)        { return (*this) /= Vector3x8(v); }
+Vector3x8& Vector3x8::operator /= (double v)                { return (*this) /= float(v); }
+Vector3x8& Vector3x8::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector3x8 Vector3x8::operator + (const Vector3x8& v) const  { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (const Vector3& v) const    { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (float v) const             { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (double v) const            { return Vector3x8(*this) += v; }
+Vector3x8 Vector3x8::operator + (int v) const               { return Vector3x8(*this) += v; }
+
+Vector3x8 Vector3x8::operator - (const Vector3x8& v) const  { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (const Vector3& v) const    { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (float v) const             { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (double v) const            { return Vector3x8(*this) -= v; }
+Vector3x8 Vector3x8::operator - (int v) const               { return Vector3x8(*this) -= v; }
+
+Vector3x8 Vector3x8::operator * (const Vector3x8& v) const  { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (const Vector3& v) const    { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (float v) const             { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (double v) const            { return Vector3x8(*this) *= v; }
+Vector3x8 Vector3x8::operator * (int v) const               { return Vector3x8(*this) *= v; }
+
+Vector3x8 Vector3x8::operator / (const Vector3x8& v) const  { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (const Vector3& v) const    { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (float v) const             { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (double v) const            { return Vector3x8(*this) /= v; }
+Vector3x8 Vector3x8::operator / (int v) const               { return Vector3x8(*this) /= v; }
+
+bool Vector3x8::operator == (const Vector3x8& v) const {
+#if defined(XO_AVX)
+    __m256 eq = _mm256_and_ps(
+        _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmX, ymmX)), avx::Epsilon, _CMP_LT_OQ),
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmY, ymmY)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmZ, ymmZ)), avx::Epsilon, _CMP_LT_OQ)));
+    return _mm256_movemask_ps(eq) == 255;
+#else
+    for (int i = 0; i < 24; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector3::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector3x8::operator != (const Vector3x8& v) const      { return !((*this) == v); }
+
+void Vector3x8::Magnitude(float* outMagnitudes) const {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+    _mm256_storeu_ps(outMagnitudes, _mm256_sqrt_ps(m));
+#else
+    MagnitudeSquared(outMagnitudes);
+    for (int i = 0; i < 8; ++i) {
+        outMagnitudes[i] = Sqrt(outMagnitudes[i]);
+    }
+#endif
+}
+
+void Vector3x8::Sum(float* outSums) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outSums, _mm256_add_ps(_mm256_add_ps(ymmX, ymmY), ymmZ));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outSums[i] = x[i] + y[i] + z[i];
+    }
+#endif
+}
+
+Vector3x8& Vector3x8::Normalize() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+#   if defined(XO_NO_INVERSE_DIVISION)
+    __m256 r = _mm256_div_ps(avx::One, _mm256_sqrt_ps(m));
+#   else
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m256 r = _mm256_rsqrt_ps(m);
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), _mm256_mul_ps(r, r))));
+#   endif
+    ymmX = _mm256_mul_ps(ymmX, r);
+    ymmY = _mm256_mul_ps(ymmY, r);
+    ymmZ = _mm256_mul_ps(ymmZ, r);
+#else
+    float m[8];
+    Magnitude(m);
+    for (int i = 0; i < 8; ++i) {
+        x[i] /= m[i];
+        y[i] /= m[i];
+        z[i] /= m[i];
+    }
+#endif
+    return *this;
+}
+
+Vector3x8& Vector3x8::NormalizeSafe() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)), _mm256_mul_ps(ymmZ, ymmZ));
+    __m256 nonZero = _mm256_cmp_ps(m, avx::Zero, _CMP_GT_OQ);
+    Vector3x8 n = Normalized();
+    ymmX = _mm256_blendv_ps(ymmX, n.ymmX, nonZero);
+    ymmY = _mm256_blendv_ps(ymmY, n.ymmY, nonZero);
+    ymmZ = _mm256_blendv_ps(ymmZ, n.ymmZ, nonZero);
+#else
+    float m[8];
+    MagnitudeSquared(m);
+    for (int i = 0; i < 8; ++i) {
+        if (m[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector3x8::Cross(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    __m256 x = _mm256_sub_ps(_mm256_mul_ps(a.ymmY, b.ymmZ), _mm256_mul_ps(a.ymmZ, b.ymmY));
+    __m256 y = _mm256_sub_ps(_mm256_mul_ps(a.ymmZ, b.ymmX), _mm256_mul_ps(a.ymmX, b.ymmZ));
+    __m256 z = _mm256_sub_ps(_mm256_mul_ps(a.ymmX, b.ymmY), _mm256_mul_ps(a.ymmY, b.ymmX));
+    outVec.ymmX = x;
+    outVec.ymmY = y;
+    outVec.ymmZ = z;
+#else
+    Vector3x8 t;
+    for (int i = 0; i < 8; ++i) {
+        t.x[i] = (a.y[i] * b.z[i]) - (a.z[i] * b.y[i]);
+        t.y[i] = (a.z[i] * b.x[i]) - (a.x[i] * b.z[i]);
+        t.z[i] = (a.x[i] * b.y[i]) - (a.y[i] * b.x[i]);
+    }
+    outVec = t;
+#endif
+}
+
+void Vector3x8::Dot(const Vector3x8& a, const Vector3x8& b, float* outDots) {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outDots, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a.ymmX, b.ymmX), _mm256_mul_ps(a.ymmY, b.ymmY)), _mm256_mul_ps(a.ymmZ, b.ymmZ)));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outDots[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+    }
+#endif
+}
+
+void Vector3x8::Lerp(const Vector3x8& a, const Vector3x8& b, const float* t, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    __m256 vt = _mm256_loadu_ps(t);
+    outVec.ymmX = _mm256_add_ps(a.ymmX, _mm256_mul_ps(_mm256_sub_ps(b.ymmX, a.ymmX), vt));
+    outVec.ymmY = _mm256_add_ps(a.ymmY, _mm256_mul_ps(_mm256_sub_ps(b.ymmY, a.ymmY), vt));
+    outVec.ymmZ = _mm256_add_ps(a.ymmZ, _mm256_mul_ps(_mm256_sub_ps(b.ymmZ, a.ymmZ), vt));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outVec.x[i] = a.x[i] + ((b.x[i] - a.x[i]) * t[i]);
+        outVec.y[i] = a.y[i] + ((b.y[i] - a.y[i]) * t[i]);
+        outVec.z[i] = a.z[i] + ((b.z[i] - a.z[i]) * t[i]);
+    }
+#endif
+}
+
+void Vector3x8::Max(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_max_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_max_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_max_ps(a.ymmZ, b.ymmZ);
+#else
+    for (int i = 0; i < 24; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector3x8::Min(const Vector3x8& a, const Vector3x8& b, Vector3x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_min_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_min_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_min_ps(a.ymmZ, b.ymmZ);
+#else
+    for (int i = 0; i < 24; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
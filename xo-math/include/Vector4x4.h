@@ -0,0 +1,285 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Four four dimensional vectors stored as a structure of arrays.
+//!
+//! Vector4x4 holds the x, y, z and w elements of four vectors in four separate registers, so that every operation 
+//! works on all four vectors at once with no horizontal math.
+//!
+//! Results that are a single scalar per vector (such as Vector4x4::Dot or Vector4x4::Magnitude) are returned 
+//! as a Vector4, where each element holds the result for the vector in the same lane. For the same reason math 
+//! operators taking a Vector4 apply one scalar per lane; construct a Vector4x4 from a Vector4 to apply it to 
+//! every lane instead.
+//!
+//! Use Vector4x4::Load and Vector4x4::Store to move between Vector4 arrays and the wide type in hot loops.
+//! @sa https://en.wikipedia.org/wiki/AOS_and_SOA
+class _XOSIMDALIGN Vector4x4 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Vector4x4() { } //!< Performs no initialization.
+    _XOINL Vector4x4(float f); //!< All elements of all lanes are set to f.
+    _XOINL explicit Vector4x4(const Vector4& v); //!< Every lane is assigned v.
+    _XOINL Vector4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3); //!< Assigns each lane accordingly.
+    _XOINL Vector4x4(const Vector4x4& v); //!< Copy constructor, trivial.
+#if defined(XO_SSE)
+    _XOINL Vector4x4(const __m128& x, const __m128& y, const __m128& z, const __m128& w); //!< Assigns the x, y, z and w registers.
+#endif
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set each. Every lane will be assigned v.
+    _XOINL Vector4x4& Set(const Vector4& v);
+    //! Set all. Each lane will be assigned to the matching input param.
+    _XOINL Vector4x4& Set(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3);
+    //! Set each. Copies vec into this.
+    _XOINL Vector4x4& Set(const Vector4x4& vec);
+    //! Set a single lane to v, leaving the others untouched.
+    _XOINL Vector4x4& SetLane(int lane, const Vector4& v);
+    //! Returns a copy of a single lane.
+    _XOINL Vector4 GetLane(int lane) const;
+    //! Extract all getter. Each lane will be assigned to the matching output param.
+    _XOINL void Get(Vector4& v0, Vector4& v1, Vector4& v2, Vector4& v3) const;
+    //! @}
+
+    //>See
+    //! @name Load / Store Methods
+    //! Moves data between arrays of Vector4 (array of structures) and Vector4x4 (structure of arrays).
+    //! @{
+
+    //! Loads four consecutive vectors from v.
+    _XOINL static Vector4x4 Load(const Vector4* v);
+    //! Loads count (0 to 4) consecutive vectors from v, lanes beyond count are zero. Useful for array tails.
+    _XOINL static Vector4x4 LoadPartial(const Vector4* v, int count);
+    //! Loads the lanes from separate x, y, z and w arrays, each containing at least four floats.
+    _XOINL static Vector4x4 LoadSoA(const float* x, const float* y, const float* z, const float* w);
+    //! Stores all four lanes to four consecutive vectors in v.
+    _XOINL void Store(Vector4* v) const;
+    //! Stores the first count (0 to 4) lanes to consecutive vectors in v. Useful for array tails.
+    _XOINL void StorePartial(Vector4* v, int count) const;
+    //! Stores the lanes to separate x, y, z and w arrays, each with room for at least four floats.
+    _XOINL void StoreSoA(float* x, float* y, float* z, float* w) const;
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Vector4x4 when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! Negate operator. Returns a copy with every element of every lane sign flipped.
+    _XOINL Vector4x4 operator -() const;
+    //! @}
+
+    //>See
+    //! @name Math Operators
+    //! Operates on all same-name elements of every lane. Scalar types apply to every lane equally, while Vector4 
+    //! provides a separate scalar for each lane.
+    //! @sa XO_NO_INVERSE_DIVISION
+    //! @{
+    _XOINL Vector4x4& operator += (const Vector4x4& v);
+    _XOINL Vector4x4& operator += (const Vector4& v);
+    _XOINL Vector4x4& operator += (float v);
+    _XOINL Vector4x4& operator += (double v);
+    _XOINL Vector4x4& operator += (int v);
+    _XOINL Vector4x4& operator -= (const Vector4x4& v);
+    _XOINL Vector4x4& operator -= (const Vector4& v);
+    _XOINL Vector4x4& operator -= (float v);
+    _XOINL Vector4x4& operator -= (double v);
+    _XOINL Vector4x4& operator -= (int v);
+    _XOINL Vector4x4& operator *= (const Vector4x4& v);
+    _XOINL Vector4x4& operator *= (const Vector4& v);
+    _XOINL Vector4x4& operator *= (float v);
+    _XOINL Vector4x4& operator *= (double v);
+    _XOINL Vector4x4& operator *= (int v);
+    _XOINL Vector4x4& operator /= (const Vector4x4& v);
+    _XOINL Vector4x4& operator /= (const Vector4& v);
+    _XOINL Vector4x4& operator /= (float v);
+    _XOINL Vector4x4& operator /= (double v);
+    _XOINL Vector4x4& operator /= (int v);
+    _XOINL Vector4x4 operator + (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator + (const Vector4& v) const;
+    _XOINL Vector4x4 operator + (float v) const;
+    _XOINL Vector4x4 operator + (double v) const;
+    _XOINL Vector4x4 operator + (int v) const;
+    _XOINL Vector4x4 operator - (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator - (const Vector4& v) const;
+    _XOINL Vector4x4 operator - (float v) const;
+    _XOINL Vector4x4 operator - (double v) const;
+    _XOINL Vector4x4 operator - (int v) const;
+    _XOINL Vector4x4 operator * (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator * (const Vector4& v) const;
+    _XOINL Vector4x4 operator * (float v) const;
+    _XOINL Vector4x4 operator * (double v) const;
+    _XOINL Vector4x4 operator * (int v) const;
+    _XOINL Vector4x4 operator / (const Vector4x4& v) const;
+    _XOINL Vector4x4 operator / (const Vector4& v) const;
+    _XOINL Vector4x4 operator / (float v) const;
+    _XOINL Vector4x4 operator / (double v) const;
+    _XOINL Vector4x4 operator / (int v) const;
+    //! @}
+
+    //>See
+    //! @name Comparison Operators
+    //! Vectors are equal when each same name element of every lane has a difference of <= Vector4::Epsilon.
+    //! @{
+    _XOINL bool operator == (const Vector4x4& v) const;
+    _XOINL bool operator != (const Vector4x4& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The length of each lane.
+    //! It's preferred to use Vector4x4::MagnitudeSquared when possible, as Vector4x4::Magnitude requires a call to Sqrt.
+    _XOINL Vector4 Magnitude() const;
+    //! The square length of each lane.
+    _XOINL Vector4 MagnitudeSquared() const {
+        return Dot(*this, *this);
+    }
+    //! The sum of the elements of each lane.
+    //!
+    //! \f$x+y+z+w\f$
+    _XOINL Vector4 Sum() const;
+    //! Normalizes each lane to a Magnitude of 1.
+    //! @sa https://en.wikipedia.org/wiki/Unit_vector
+    _XOINL Vector4x4& Normalize();
+    //! Normalizes each lane to a Magnitude of 1, leaving lanes with a zero magnitude untouched.
+    _XOINL Vector4x4& NormalizeSafe();
+    //! Returns a copy of this with each lane normalized to a Magnitude of 1.
+    Vector4x4 Normalized() const {
+        return Vector4x4(*this).Normalize();
+    }
+    //! Returns a copy of this with each lane normalized, leaving lanes with a zero magnitude untouched.
+    Vector4x4 NormalizedSafe() const {
+        return Vector4x4(*this).NormalizeSafe();
+    }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Returns the dot product of each lane in a and b.
+    //! @sa https://en.wikipedia.org/wiki/Dot_product
+    _XOINL static Vector4 Dot(const Vector4x4& a, const Vector4x4& b);
+    //! Sets outVec to each lane interpolated between a and b by a scalar amount t.
+    //! @sa https://en.wikipedia.org/wiki/Linear_interpolation
+    static void Lerp(const Vector4x4& a, const Vector4x4& b, float t, Vector4x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    //! Sets outVec to each lane interpolated between a and b by the same-lane amount in t.
+    static void Lerp(const Vector4x4& a, const Vector4x4& b, const Vector4& t, Vector4x4& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    //! Set outVec to have elements equal to the max of each element in a and b.
+    _XOINL static void Max(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec);
+    //! Set outVec to have elements equal to the min of each element in a and b.
+    _XOINL static void Min(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec);
+    //! Returns the distance between each lane of a and b.
+    static Vector4 Distance(const Vector4x4& a, const Vector4x4& b) {
+        return (b - a).Magnitude();
+    }
+    //! Returns the square distance between each lane of a and b.
+    static Vector4 DistanceSquared(const Vector4x4& a, const Vector4x4& b) {
+        return (b - a).MagnitudeSquared();
+    }
+    //! @}
+
+#define _RET_VARIANT(name) { Vector4x4 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    //>See
+    //! @name Variants
+    //! Variants of other same-name static methods. See their documentation for more details under the 
+    //! Static Methods heading.
+    //!
+    //! Non static variants replace the first Vector4x4 parameter by 'this' vector.
+    //! Static variants return what would have been the outVec param.
+    //! @{
+    Vector4 Distance(const Vector4x4& v) const                                      _THIS_VARIANT1(Distance, v)
+    Vector4 DistanceSquared(const Vector4x4& v) const                               _THIS_VARIANT1(DistanceSquared, v)
+    Vector4 Dot(const Vector4x4& v) const                                           _THIS_VARIANT1(Dot, v)
+    Vector4x4 Lerp(const Vector4x4& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector4x4 Lerp(const Vector4x4& v, const Vector4& t) const                      _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector4x4 Lerp(const Vector4x4& a, const Vector4x4& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x4 Lerp(const Vector4x4& a, const Vector4x4& b, const Vector4& t) _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x4 Max(const Vector4x4& a, const Vector4x4& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector4x4 Min(const Vector4x4& a, const Vector4x4& b)                    _RET_VARIANT_2(Min, a, b)
+    //! @}
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the contents of each lane to the provided ostream.
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector4x4& v) {
+        for (int i = 0; i < 4; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ", w:" << v.w[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+    //! @}
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector4x4.html#public_members
+    union {
+        struct {
+            float x[4]; //!< The x element of each lane.
+            float y[4]; //!< The y element of each lane.
+            float z[4]; //!< The z element of each lane.
+            float w[4]; //!< The w element of each lane.
+        };
+        float f[16]; //!< ordered as \f$\begin{pmatrix}x_0&x_1&x_2&x_3&y_0&...&w_3\end{pmatrix}\f$
+#if defined(XO_SSE)
+        //! Exists when SSE is in use, one 128 bit xmm register per element.
+        //! @sa https://en.wikipedia.org/wiki/Streaming_SIMD_Extensions
+        struct {
+            __m128 xmmX, xmmY, xmmZ, xmmW;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,433 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+Vector4x4::Vector4x4(float f) {
+#if defined(XO_SSE)
+    xmmX = xmmY = xmmZ = xmmW = _mm_set1_ps(f);
+#else
+    for (int i = 0; i < 16; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector4x4::Vector4x4(const Vector4& v) {
+    Set(v);
+}
+
+Vector4x4::Vector4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3) {
+    Set(v0, v1, v2, v3);
+}
+
+Vector4x4::Vector4x4(const Vector4x4& v) {
+    Set(v);
+}
+
+#if defined(XO_SSE)
+Vector4x4::Vector4x4(const __m128& x, const __m128& y, const __m128& z, const __m128& w) :
+    xmmX(x), xmmY(y), xmmZ(z), xmmW(w)
+{
+}
+#endif
+
+Vector4x4& Vector4x4::Set(const Vector4& v) {
+#if defined(XO_SSE)
+    xmmX = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(0, 0, 0, 0));
+    xmmY = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(1, 1, 1, 1));
+    xmmZ = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(2, 2, 2, 2));
+    xmmW = _mm_shuffle_ps(v.xmm, v.xmm, _MM_SHUFFLE(3, 3, 3, 3));
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+        w[i] = v.w;
+    }
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::Set(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3) {
+#if defined(XO_SSE)
+    xmmX = v0.xmm;
+    xmmY = v1.xmm;
+    xmmZ = v2.xmm;
+    xmmW = v3.xmm;
+    _MM_TRANSPOSE4_PS(xmmX, xmmY, xmmZ, xmmW);
+#else
+    SetLane(0, v0);
+    SetLane(1, v1);
+    SetLane(2, v2);
+    SetLane(3, v3);
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::Set(const Vector4x4& v) {
+#if defined(XO_SSE)
+    xmmX = v.xmmX;
+    xmmY = v.xmmY;
+    xmmZ = v.xmmZ;
+    xmmW = v.xmmW;
+#else
+    for (int i = 0; i < 16; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x4& Vector4x4::SetLane(int lane, const Vector4& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    w[lane] = v.w;
+    return *this;
+}
+
+Vector4 Vector4x4::GetLane(int lane) const {
+    return Vector4(x[lane], y[lane], z[lane], w[lane]);
+}
+
+void Vector4x4::Get(Vector4& v0, Vector4& v1, Vector4& v2, Vector4& v3) const {
+#if defined(XO_SSE)
+    __m128 r0 = xmmX, r1 = xmmY, r2 = xmmZ, r3 = xmmW;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    v0.xmm = r0;
+    v1.xmm = r1;
+    v2.xmm = r2;
+    v3.xmm = r3;
+#else
+    v0 = GetLane(0);
+    v1 = GetLane(1);
+    v2 = GetLane(2);
+    v3 = GetLane(3);
+#endif
+}
+
+Vector4x4 Vector4x4::Load(const Vector4* v) {
+    return Vector4x4(v[0], v[1], v[2], v[3]);
+}
+
+Vector4x4 Vector4x4::LoadPartial(const Vector4* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector4x4::LoadPartial count must be between 0 and 4.");
+    switch (count) {
+        case 4:  return Vector4x4(v[0], v[1], v[2], v[3]);
+        case 3:  return Vector4x4(v[0], v[1], v[2], Vector4::Zero);
+        case 2:  return Vector4x4(v[0], v[1], Vector4::Zero, Vector4::Zero);
+        case 1:  return Vector4x4(v[0], Vector4::Zero, Vector4::Zero, Vector4::Zero);
+        default: return Vector4x4(0.0f);
+    }
+}
+
+Vector4x4 Vector4x4::LoadSoA(const float* x, const float* y, const float* z, const float* w) {
+#if defined(XO_SSE)
+    return Vector4x4(_mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z), _mm_loadu_ps(w));
+#else
+    Vector4x4 v;
+    for (int i = 0; i < 4; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+        v.w[i] = w[i];
+    }
+    return v;
+#endif
+}
+
+void Vector4x4::Store(Vector4* v) const {
+    Get(v[0], v[1], v[2], v[3]);
+}
+
+void Vector4x4::StorePartial(Vector4* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 4, "xo-math Vector4x4::StorePartial count must be between 0 and 4.");
+    if (count == 4) {
+        Store(v);
+        return;
+    }
+    Vector4 t[4];
+    Get(t[0], t[1], t[2], t[3]);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector4x4::StoreSoA(float* x, float* y, float* z, float* w) const {
+#if defined(XO_SSE)
+    _mm_storeu_ps(x, xmmX);
+    _mm_storeu_ps(y, xmmY);
+    _mm_storeu_ps(z, xmmZ);
+    _mm_storeu_ps(w, xmmW);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+        w[i] = this->w[i];
+    }
+#endif
+}
+
+Vector4x4 Vector4x4::operator -() const {
+#if defined(XO_SSE)
+    return Vector4x4(
+        _mm_xor_ps(xmmX, sse::SignMask), 
+        _mm_xor_ps(xmmY, sse::SignMask), 
+        _mm_xor_ps(xmmZ, sse::SignMask), 
+        _mm_xor_ps(xmmW, sse::SignMask));
+#else
+    Vector4x4 v;
+    for (int i = 0; i < 16; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_SSE)
+#   define _XO_W4X4_OP_X4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4x4& v) { \
+        xmmX = sseop(xmmX, v.xmmX); xmmY = sseop(xmmY, v.xmmY); xmmZ = sseop(xmmZ, v.xmmZ); xmmW = sseop(xmmW, v.xmmW); \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_V4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4& v) { \
+        xmmX = sseop(xmmX, v.xmm); xmmY = sseop(xmmY, v.xmm); xmmZ = sseop(xmmZ, v.xmm); xmmW = sseop(xmmW, v.xmm); \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_F(op, sseop) \
+    Vector4x4& Vector4x4::operator op (float v) { \
+        __m128 s = _mm_set1_ps(v); \
+        xmmX = sseop(xmmX, s); xmmY = sseop(xmmY, s); xmmZ = sseop(xmmZ, s); xmmW = sseop(xmmW, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W4X4_OP_X4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4x4& v) { \
+        for (int i = 0; i < 16; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_V4(op, sseop) \
+    Vector4x4& Vector4x4::operator op (const Vector4& v) { \
+        for (int i = 0; i < 4; ++i) { x[i] op v.f[i]; y[i] op v.f[i]; z[i] op v.f[i]; w[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X4_OP_F(op, sseop) \
+    Vector4x4& Vector4x4::operator op (float v) { \
+        for (int i = 0; i < 16; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W4X4_OP_X4(+=, _mm_add_ps)
+_XO_W4X4_OP_V4(+=, _mm_add_ps)
+_XO_W4X4_OP_F(+=, _mm_add_ps)
+_XO_W4X4_OP_X4(-=, _mm_sub_ps)
+_XO_W4X4_OP_V4(-=, _mm_sub_ps)
+_XO_W4X4_OP_F(-=, _mm_sub_ps)
+_XO_W4X4_OP_X4(*=, _mm_mul_ps)
+_XO_W4X4_OP_V4(*=, _mm_mul_ps)
+_XO_W4X4_OP_F(*=, _mm_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_SSE)
+_XO_W4X4_OP_X4(/=, _mm_div_ps)
+_XO_W4X4_OP_V4(/=, _mm_div_ps)
+#else
+// See Vector3::operator/= for the latency and throughput of _mm_rcp_ps vs. _mm_div_ps.
+Vector4x4& Vector4x4::operator /= (const Vector4x4& v) {
+    xmmX = _mm_mul_ps(xmmX, _mm_rcp_ps(v.xmmX));
+    xmmY = _mm_mul_ps(xmmY, _mm_rcp_ps(v.xmmY));
+    xmmZ = _mm_mul_ps(xmmZ, _mm_rcp_ps(v.xmmZ));
+    xmmW = _mm_mul_ps(xmmW, _mm_rcp_ps(v.xmmW));
+    return *this;
+}
+
+Vector4x4& Vector4x4::operator /= (const Vector4& v) {
+    // one reciprocal for all four elements of each lane.
+    __m128 r = _mm_rcp_ps(v.xmm);
+    xmmX = _mm_mul_ps(xmmX, r);
+    xmmY = _mm_mul_ps(xmmY, r);
+    xmmZ = _mm_mul_ps(xmmZ, r);
+    xmmW = _mm_mul_ps(xmmW, r);
+    return *this;
+}
+#endif
+
+#undef _XO_W4X4_OP_X4
+#undef _XO_W4X4_OP_V4
+#undef _XO_W4X4_OP_F
+
+Vector4x4& Vector4x4::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector4x4& Vector4x4::operator += (double v)                { return (*this) += float(v); }
+Vector4x4& Vector4x4::operator += (int v)                   { return (*this) += float(v); }
+Vector4x4& Vector4x4::operator -= (double v)                { return (*this) -= float(v); }
+Vector4x4& Vector4x4::operator -= (int v)                   { return (*this) -= float(v); }
+Vector4x4& Vector4x4::operator *= (double v)                { return (*this) *= float(v); }
+Vector4x4& Vector4x4::operator *= (int v)                   { return (*this) *= float(v); }
+Vector4x4& Vector4x4::operator /= (double v)                { return (*this) /= float(v); }
+Vector4x4& Vector4x4::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector4x4 Vector4x4::operator + (const Vector4x4& v) const  { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (const Vector4& v) const    { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (float v) const             { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (double v) const            { return Vector4x4(*this) += v; }
+Vector4x4 Vector4x4::operator + (int v) const               { return Vector4x4(*this) += v; }
+
+Vector4x4 Vector4x4::operator - (const Vector4x4& v) const  { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (const Vector4& v) const    { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (float v) const             { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (double v) const            { return Vector4x4(*this) -= v; }
+Vector4x4 Vector4x4::operator - (int v) const               { return Vector4x4(*this) -= v; }
+
+Vector4x4 Vector4x4::operator * (const Vector4x4& v) const  { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (const Vector4& v) const    { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (float v) const             { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (double v) const            { return Vector4x4(*this) *= v; }
+Vector4x4 Vector4x4::operator * (int v) const               { return Vector4x4(*this) *= v; }
+
+Vector4x4 Vector4x4::operator / (const Vector4x4& v) const  { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (const Vector4& v) const    { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (float v) const             { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (double v) const            { return Vector4x4(*this) /= v; }
+Vector4x4 Vector4x4::operator / (int v) const               { return Vector4x4(*this) /= v; }
+
+bool Vector4x4::operator == (const Vector4x4& v) const {
+#if defined(XO_SSE)
+    __m128 eq = _mm_and_ps(
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmX, xmmX)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmY, xmmY)), sse::Epsilon)),
+        _mm_and_ps(
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmZ, xmmZ)), sse::Epsilon),
+            _mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmmW, xmmW)), sse::Epsilon)));
+    return _mm_movemask_ps(eq) == 15;
+#else
+    for (int i = 0; i < 16; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector4::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector4x4::operator != (const Vector4x4& v) const      { return !((*this) == v); }
+
+Vector4 Vector4x4::Magnitude() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_sqrt_ps(MagnitudeSquared().xmm));
+#else
+    Vector4 m = MagnitudeSquared();
+    return Vector4(Sqrt(m.x), Sqrt(m.y), Sqrt(m.z), Sqrt(m.w));
+#endif
+}
+
+Vector4 Vector4x4::Sum() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(_mm_add_ps(xmmX, xmmY), _mm_add_ps(xmmZ, xmmW)));
+#else
+    Vector4 s;
+    for (int i = 0; i < 4; ++i) {
+        s.f[i] = x[i] + y[i] + z[i] + w[i];
+    }
+    return s;
+#endif
+}
+
+Vector4x4& Vector4x4::Normalize() {
+#if defined(XO_SSE) && !defined(XO_NO_INVERSE_DIVISION)
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m128 m = MagnitudeSquared().xmm;
+    __m128 r = _mm_rsqrt_ps(m);
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), _mm_mul_ps(r, r))));
+    return (*this) *= Vector4(r);
+#else
+    return (*this) /= Magnitude();
+#endif
+}
+
+Vector4x4& Vector4x4::NormalizeSafe() {
+#if defined(XO_SSE)
+    __m128 nonZero = _mm_cmpgt_ps(MagnitudeSquared().xmm, sse::Zero);
+    Vector4x4 n = Normalized();
+    xmmX = _mm_or_ps(_mm_and_ps(nonZero, n.xmmX), _mm_andnot_ps(nonZero, xmmX));
+    xmmY = _mm_or_ps(_mm_and_ps(nonZero, n.xmmY), _mm_andnot_ps(nonZero, xmmY));
+    xmmZ = _mm_or_ps(_mm_and_ps(nonZero, n.xmmZ), _mm_andnot_ps(nonZero, xmmZ));
+    xmmW = _mm_or_ps(_mm_and_ps(nonZero, n.xmmW), _mm_andnot_ps(nonZero, xmmW));
+#else
+    Vector4 m = MagnitudeSquared();
+    for (int i = 0; i < 4; ++i) {
+        if (m.f[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m.f[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+            w[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+Vector4 Vector4x4::Dot(const Vector4x4& a, const Vector4x4& b) {
+#if defined(XO_SSE)
+    return Vector4(_mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(a.xmmX, b.xmmX), _mm_mul_ps(a.xmmY, b.xmmY)), 
+        _mm_add_ps(_mm_mul_ps(a.xmmZ, b.xmmZ), _mm_mul_ps(a.xmmW, b.xmmW))));
+#else
+    Vector4 d;
+    for (int i = 0; i < 4; ++i) {
+        d.f[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) + (a.w[i] * b.w[i]);
+    }
+    return d;
+#endif
+}
+
+void Vector4x4::Max(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_max_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_max_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_max_ps(a.xmmZ, b.xmmZ);
+    outVec.xmmW = _mm_max_ps(a.xmmW, b.xmmW);
+#else
+    for (int i = 0; i < 16; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector4x4::Min(const Vector4x4& a, const Vector4x4& b, Vector4x4& outVec) {
+#if defined(XO_SSE)
+    outVec.xmmX = _mm_min_ps(a.xmmX, b.xmmX);
+    outVec.xmmY = _mm_min_ps(a.xmmY, b.xmmY);
+    outVec.xmmZ = _mm_min_ps(a.xmmZ, b.xmmZ);
+    outVec.xmmW = _mm_min_ps(a.xmmW, b.xmmW);
+#else
+    for (int i = 0; i < 16; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,279 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Eight four dimensional vectors stored as a structure of arrays.
+//!
+//! The eight lane counterpart of Vector4x4. With AVX the x, y, z and w elements of all eight vectors are each held
+//! in a single 256 bit ymm register. Without AVX the same operations run element by element, so the type is
+//! always available but only worth using in hot loops of AVX builds.
+//!
+//! There is no eight lane scalar type, so results that are a single scalar per vector (such as Vector4x8::Dot
+//! or Vector4x8::Magnitude) are written to an array of eight floats, where each element holds the result for
+//! the vector in the same lane.
+//!
+//! Use Vector4x8::Load and Vector4x8::Store to move between Vector4 arrays and the wide type in hot loops.
+//! @sa Vector4x4, https://en.wikipedia.org/wiki/AOS_and_SOA
+class _XOSIMDALIGN Vector4x8 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Vector4x8() { } //!< Performs no initialization.
+    _XOINL Vector4x8(float f); //!< All elements of all lanes are set to f.
+    _XOINL explicit Vector4x8(const Vector4& v); //!< Every lane is assigned v.
+    _XOINL Vector4x8(const Vector4x4& low, const Vector4x4& high); //!< Lanes 0 to 3 are assigned low and lanes 4 to 7 high.
+    _XOINL Vector4x8(const Vector4x8& v); //!< Copy constructor, trivial.
+#if defined(XO_AVX)
+    _XOINL Vector4x8(const __m256& x, const __m256& y, const __m256& z, const __m256& w); //!< Assigns the x, y, z and w registers.
+#endif
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set each. Every lane will be assigned v.
+    _XOINL Vector4x8& Set(const Vector4& v);
+    //! Set all. Lanes 0 to 3 will be assigned low and lanes 4 to 7 high.
+    _XOINL Vector4x8& Set(const Vector4x4& low, const Vector4x4& high);
+    //! Set each. Copies vec into this.
+    _XOINL Vector4x8& Set(const Vector4x8& vec);
+    //! Set a single lane to v, leaving the others untouched.
+    _XOINL Vector4x8& SetLane(int lane, const Vector4& v);
+    //! Returns a copy of a single lane.
+    _XOINL Vector4 GetLane(int lane) const;
+    //! Extract all getter. Lanes 0 to 3 will be assigned to low and lanes 4 to 7 to high.
+    _XOINL void Get(Vector4x4& low, Vector4x4& high) const;
+    //! @}
+
+    //>See
+    //! @name Load / Store Methods
+    //! Moves data between arrays of Vector4 (array of structures) and Vector4x8 (structure of arrays).
+    //! @{
+
+    //! Loads eight consecutive vectors from v.
+    _XOINL static Vector4x8 Load(const Vector4* v);
+    //! Loads count (0 to 8) consecutive vectors from v, lanes beyond count are zero. Useful for array tails.
+    _XOINL static Vector4x8 LoadPartial(const Vector4* v, int count);
+    //! Loads the lanes from separate x, y, z and w arrays, each containing at least eight floats.
+    _XOINL static Vector4x8 LoadSoA(const float* x, const float* y, const float* z, const float* w);
+    //! Stores all eight lanes to eight consecutive vectors in v.
+    _XOINL void Store(Vector4* v) const;
+    //! Stores the first count (0 to 8) lanes to consecutive vectors in v. Useful for array tails.
+    _XOINL void StorePartial(Vector4* v, int count) const;
+    //! Stores the lanes to separate x, y, z and w arrays, each with room for at least eight floats.
+    _XOINL void StoreSoA(float* x, float* y, float* z, float* w) const;
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Vector4x8 when memory alignment is required (32 bytes with AVX).
+    _XO_OVERLOAD_NEW_DELETE_32();
+    //! Negate operator. Returns a copy with every element of every lane sign flipped.
+    _XOINL Vector4x8 operator -() const;
+    //! @}
+
+    //>See
+    //! @name Math Operators
+    //! Operates on all same-name elements of every lane. Vector4 and scalar types apply to every lane equally.
+    //! @sa XO_NO_INVERSE_DIVISION
+    //! @{
+    _XOINL Vector4x8& operator += (const Vector4x8& v);
+    _XOINL Vector4x8& operator += (const Vector4& v);
+    _XOINL Vector4x8& operator += (float v);
+    _XOINL Vector4x8& operator += (double v);
+    _XOINL Vector4x8& operator += (int v);
+    _XOINL Vector4x8& operator -= (const Vector4x8& v);
+    _XOINL Vector4x8& operator -= (const Vector4& v);
+    _XOINL Vector4x8& operator -= (float v);
+    _XOINL Vector4x8& operator -= (double v);
+    _XOINL Vector4x8& operator -= (int v);
+    _XOINL Vector4x8& operator *= (const Vector4x8& v);
+    _XOINL Vector4x8& operator *= (const Vector4& v);
+    _XOINL Vector4x8& operator *= (float v);
+    _XOINL Vector4x8& operator *= (double v);
+    _XOINL Vector4x8& operator *= (int v);
+    _XOINL Vector4x8& operator /= (const Vector4x8& v);
+    _XOINL Vector4x8& operator /= (const Vector4& v);
+    _XOINL Vector4x8& operator /= (float v);
+    _XOINL Vector4x8& operator /= (double v);
+    _XOINL Vector4x8& operator /= (int v);
+    _XOINL Vector4x8 operator + (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator + (const Vector4& v) const;
+    _XOINL Vector4x8 operator + (float v) const;
+    _XOINL Vector4x8 operator + (double v) const;
+    _XOINL Vector4x8 operator + (int v) const;
+    _XOINL Vector4x8 operator - (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator - (const Vector4& v) const;
+    _XOINL Vector4x8 operator - (float v) const;
+    _XOINL Vector4x8 operator - (double v) const;
+    _XOINL Vector4x8 operator - (int v) const;
+    _XOINL Vector4x8 operator * (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator * (const Vector4& v) const;
+    _XOINL Vector4x8 operator * (float v) const;
+    _XOINL Vector4x8 operator * (double v) const;
+    _XOINL Vector4x8 operator * (int v) const;
+    _XOINL Vector4x8 operator / (const Vector4x8& v) const;
+    _XOINL Vector4x8 operator / (const Vector4& v) const;
+    _XOINL Vector4x8 operator / (float v) const;
+    _XOINL Vector4x8 operator / (double v) const;
+    _XOINL Vector4x8 operator / (int v) const;
+    //! @}
+
+    //>See
+    //! @name Comparison Operators
+    //! Vectors are equal when each same name element of every lane has a difference of <= Vector4::Epsilon.
+    //! @{
+    _XOINL bool operator == (const Vector4x8& v) const;
+    _XOINL bool operator != (const Vector4x8& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! Methods with a float* parameter write one result per lane to its first eight elements.
+    //! @{
+
+    //! The length of each lane.
+    //! It's preferred to use Vector4x8::MagnitudeSquared when possible, as Vector4x8::Magnitude requires a call to Sqrt.
+    _XOINL void Magnitude(float* outMagnitudes) const;
+    //! The square length of each lane.
+    _XOINL void MagnitudeSquared(float* outMagnitudes) const {
+        Dot(*this, *this, outMagnitudes);
+    }
+    //! The sum of the elements of each lane.
+    //!
+    //! \f$x+y+z+w\f$
+    _XOINL void Sum(float* outSums) const;
+    //! Normalizes each lane to a Magnitude of 1.
+    //! @sa https://en.wikipedia.org/wiki/Unit_vector
+    _XOINL Vector4x8& Normalize();
+    //! Normalizes each lane to a Magnitude of 1, leaving lanes with a zero magnitude untouched.
+    _XOINL Vector4x8& NormalizeSafe();
+    //! Returns a copy of this with each lane normalized to a Magnitude of 1.
+    Vector4x8 Normalized() const {
+        return Vector4x8(*this).Normalize();
+    }
+    //! Returns a copy of this with each lane normalized, leaving lanes with a zero magnitude untouched.
+    Vector4x8 NormalizedSafe() const {
+        return Vector4x8(*this).NormalizeSafe();
+    }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Writes the dot product of each lane in a and b to outDots.
+    //! @sa https://en.wikipedia.org/wiki/Dot_product
+    _XOINL static void Dot(const Vector4x8& a, const Vector4x8& b, float* outDots);
+    //! Sets outVec to each lane interpolated between a and b by a scalar amount t.
+    //! @sa https://en.wikipedia.org/wiki/Linear_interpolation
+    static void Lerp(const Vector4x8& a, const Vector4x8& b, float t, Vector4x8& outVec) {
+        outVec = a + ((b - a) * t);
+    }
+    //! Sets outVec to each lane interpolated between a and b by the same-lane amount in t, an array of eight floats.
+    _XOINL static void Lerp(const Vector4x8& a, const Vector4x8& b, const float* t, Vector4x8& outVec);
+    //! Set outVec to have elements equal to the max of each element in a and b.
+    _XOINL static void Max(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec);
+    //! Set outVec to have elements equal to the min of each element in a and b.
+    _XOINL static void Min(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec);
+    //! Writes the distance between each lane of a and b to outDistances.
+    static void Distance(const Vector4x8& a, const Vector4x8& b, float* outDistances) {
+        (b - a).Magnitude(outDistances);
+    }
+    //! Writes the square distance between each lane of a and b to outDistances.
+    static void DistanceSquared(const Vector4x8& a, const Vector4x8& b, float* outDistances) {
+        (b - a).MagnitudeSquared(outDistances);
+    }
+    //! @}
+
+#define _RET_VARIANT(name) { Vector4x8 tempV; name(
+#define _RET_VARIANT_END() tempV); return tempV; }
+#define _RET_VARIANT_2(name, first, second)                  _RET_VARIANT(name) first, second,                _RET_VARIANT_END()
+#define _RET_VARIANT_3(name, first, second, third)           _RET_VARIANT(name) first, second, third,         _RET_VARIANT_END()
+#define _THIS_VARIANT1(name, first)                         { return name(*this, first); }
+#define _THIS_VARIANT2(name, first, second)                 { return name(*this, first, second); }
+
+    //>See
+    //! @name Variants
+    //! Variants of other same-name static methods. See their documentation for more details under the
+    //! Static Methods heading.
+    //!
+    //! Non static variants replace the first Vector4x8 parameter by 'this' vector.
+    //! Static variants return what would have been the outVec param.
+    //! @{
+    Vector4x8 Lerp(const Vector4x8& v, float t) const                               _THIS_VARIANT2(Lerp, v, t)
+    Vector4x8 Lerp(const Vector4x8& v, const float* t) const                        _THIS_VARIANT2(Lerp, v, t)
+
+    static Vector4x8 Lerp(const Vector4x8& a, const Vector4x8& b, float t)          _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x8 Lerp(const Vector4x8& a, const Vector4x8& b, const float* t)   _RET_VARIANT_3(Lerp, a, b, t)
+    static Vector4x8 Max(const Vector4x8& a, const Vector4x8& b)                    _RET_VARIANT_2(Max, a, b)
+    static Vector4x8 Min(const Vector4x8& a, const Vector4x8& b)                    _RET_VARIANT_2(Min, a, b)
+    //! @}
+
+#undef _RET_VARIANT
+#undef _RET_VARIANT_END
+#undef _RET_VARIANT_2
+#undef _RET_VARIANT_3
+#undef _THIS_VARIANT1
+#undef _THIS_VARIANT2
+
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the contents of each lane to the provided ostream.
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Vector4x8& v) {
+        for (int i = 0; i < 8; ++i) {
+            os << (i ? ", " : "[") << "(x:" << v.x[i] << ", y:" << v.y[i] << ", z:" << v.z[i] << ", w:" << v.w[i] << ")";
+        }
+        os << "]";
+        return os;
+    }
+#endif
+    //! @}
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3x8.html#public_members
+    union {
+        struct {
+            float x[8]; //!< The x element of each lane.
+            float y[8]; //!< The y element of each lane.
+            float z[8]; //!< The z element of each lane.
+            float w[8]; //!< The w element of each lane.
+        };
+        float f[32]; //!< ordered as \f$\begin{pmatrix}x_0&x_1&...&x_7&y_0&...&w_7\end{pmatrix}\f$
+#if defined(XO_AVX)
+        //! Exists when AVX is in use, one 256 bit ymm register per element.
+        //! @sa https://en.wikipedia.org/wiki/Advanced_Vector_Extensions
+        struct {
+            __m256 ymmX, ymmY, ymmZ, ymmW;
+        };
+#endif
+    };
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
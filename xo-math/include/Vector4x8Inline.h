@@ -0,0 +1,495 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+Vector4x8::Vector4x8(float f) {
+#if defined(XO_AVX)
+    ymmX = ymmY = ymmZ = ymmW = _mm256_set1_ps(f);
+#else
+    for (int i = 0; i < 32; ++i) {
+        this->f[i] = f;
+    }
+#endif
+}
+
+Vector4x8::Vector4x8(const Vector4& v) {
+    Set(v);
+}
+
+Vector4x8::Vector4x8(const Vector4x4& low, const Vector4x4& high) {
+    Set(low, high);
+}
+
+Vector4x8::Vector4x8(const Vector4x8& v) {
+    Set(v);
+}
+
+#if defined(XO_AVX)
+Vector4x8::Vector4x8(const __m256& x, const __m256& y, const __m256& z, const __m256& w) :
+    ymmX(x), ymmY(y), ymmZ(z), ymmW(w)
+{
+}
+#endif
+
+Vector4x8& Vector4x8::Set(const Vector4& v) {
+#if defined(XO_AVX)
+    ymmX = _mm256_set1_ps(v.x);
+    ymmY = _mm256_set1_ps(v.y);
+    ymmZ = _mm256_set1_ps(v.z);
+    ymmW = _mm256_set1_ps(v.w);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+        w[i] = v.w;
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::Set(const Vector4x4& low, const Vector4x4& high) {
+#if defined(XO_AVX)
+    ymmX = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmX), high.xmmX, 1);
+    ymmY = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmY), high.xmmY, 1);
+    ymmZ = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmZ), high.xmmZ, 1);
+    ymmW = _mm256_insertf128_ps(_mm256_castps128_ps256(low.xmmW), high.xmmW, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        x[i] = low.x[i];
+        y[i] = low.y[i];
+        z[i] = low.z[i];
+        w[i] = low.w[i];
+        x[i + 4] = high.x[i];
+        y[i + 4] = high.y[i];
+        z[i + 4] = high.z[i];
+        w[i + 4] = high.w[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::Set(const Vector4x8& v) {
+#if defined(XO_AVX)
+    ymmX = v.ymmX;
+    ymmY = v.ymmY;
+    ymmZ = v.ymmZ;
+    ymmW = v.ymmW;
+#else
+    for (int i = 0; i < 32; ++i) {
+        f[i] = v.f[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::SetLane(int lane, const Vector4& v) {
+    x[lane] = v.x;
+    y[lane] = v.y;
+    z[lane] = v.z;
+    w[lane] = v.w;
+    return *this;
+}
+
+Vector4 Vector4x8::GetLane(int lane) const {
+    return Vector4(x[lane], y[lane], z[lane], w[lane]);
+}
+
+void Vector4x8::Get(Vector4x4& low, Vector4x4& high) const {
+#if defined(XO_AVX)
+    low.xmmX = _mm256_castps256_ps128(ymmX);
+    low.xmmY = _mm256_castps256_ps128(ymmY);
+    low.xmmZ = _mm256_castps256_ps128(ymmZ);
+    low.xmmW = _mm256_castps256_ps128(ymmW);
+    high.xmmX = _mm256_extractf128_ps(ymmX, 1);
+    high.xmmY = _mm256_extractf128_ps(ymmY, 1);
+    high.xmmZ = _mm256_extractf128_ps(ymmZ, 1);
+    high.xmmW = _mm256_extractf128_ps(ymmW, 1);
+#else
+    for (int i = 0; i < 4; ++i) {
+        low.SetLane(i, GetLane(i));
+        high.SetLane(i, GetLane(i + 4));
+    }
+#endif
+}
+
+Vector4x8 Vector4x8::Load(const Vector4* v) {
+#if defined(XO_AVX)
+    // See Vector3x8::Load, this also keeps w.
+    __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[0].xmm), v[4].xmm, 1);
+    __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[1].xmm), v[5].xmm, 1);
+    __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[2].xmm), v[6].xmm, 1);
+    __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(v[3].xmm), v[7].xmm, 1);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    return Vector4x8(
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+#else
+    Vector4x8 r;
+    for (int i = 0; i < 8; ++i) {
+        r.SetLane(i, v[i]);
+    }
+    return r;
+#endif
+}
+
+Vector4x8 Vector4x8::LoadPartial(const Vector4* v, int count) {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector4x8::LoadPartial count must be between 0 and 8.");
+    if (count == 8) {
+        return Load(v);
+    }
+    Vector4 t[8];
+    for (int i = 0; i < 8; ++i) {
+        t[i] = i < count ? v[i] : Vector4::Zero;
+    }
+    return Load(t);
+}
+
+Vector4x8 Vector4x8::LoadSoA(const float* x, const float* y, const float* z, const float* w) {
+#if defined(XO_AVX)
+    return Vector4x8(_mm256_loadu_ps(x), _mm256_loadu_ps(y), _mm256_loadu_ps(z), _mm256_loadu_ps(w));
+#else
+    Vector4x8 v;
+    for (int i = 0; i < 8; ++i) {
+        v.x[i] = x[i];
+        v.y[i] = y[i];
+        v.z[i] = z[i];
+        v.w[i] = w[i];
+    }
+    return v;
+#endif
+}
+
+void Vector4x8::Store(Vector4* v) const {
+#if defined(XO_AVX)
+    __m256 t0 = _mm256_unpacklo_ps(ymmX, ymmY);
+    __m256 t1 = _mm256_unpackhi_ps(ymmX, ymmY);
+    __m256 t2 = _mm256_unpacklo_ps(ymmZ, ymmW);
+    __m256 t3 = _mm256_unpackhi_ps(ymmZ, ymmW);
+    __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    v[0].xmm = _mm256_castps256_ps128(r0);
+    v[1].xmm = _mm256_castps256_ps128(r1);
+    v[2].xmm = _mm256_castps256_ps128(r2);
+    v[3].xmm = _mm256_castps256_ps128(r3);
+    v[4].xmm = _mm256_extractf128_ps(r0, 1);
+    v[5].xmm = _mm256_extractf128_ps(r1, 1);
+    v[6].xmm = _mm256_extractf128_ps(r2, 1);
+    v[7].xmm = _mm256_extractf128_ps(r3, 1);
+#else
+    for (int i = 0; i < 8; ++i) {
+        v[i] = GetLane(i);
+    }
+#endif
+}
+
+void Vector4x8::StorePartial(Vector4* v, int count) const {
+    XO_ASSERT(count >= 0 && count <= 8, "xo-math Vector4x8::StorePartial count must be between 0 and 8.");
+    if (count == 8) {
+        Store(v);
+        return;
+    }
+    Vector4 t[8];
+    Store(t);
+    for (int i = 0; i < count; ++i) {
+        v[i] = t[i];
+    }
+}
+
+void Vector4x8::StoreSoA(float* x, float* y, float* z, float* w) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(x, ymmX);
+    _mm256_storeu_ps(y, ymmY);
+    _mm256_storeu_ps(z, ymmZ);
+    _mm256_storeu_ps(w, ymmW);
+#else
+    for (int i = 0; i < 8; ++i) {
+        x[i] = this->x[i];
+        y[i] = this->y[i];
+        z[i] = this->z[i];
+        w[i] = this->w[i];
+    }
+#endif
+}
+
+Vector4x8 Vector4x8::operator -() const {
+#if defined(XO_AVX)
+    return Vector4x8(_mm256_xor_ps(ymmX, avx::SignMask), _mm256_xor_ps(ymmY, avx::SignMask),
+                     _mm256_xor_ps(ymmZ, avx::SignMask), _mm256_xor_ps(ymmW, avx::SignMask));
+#else
+    Vector4x8 v;
+    for (int i = 0; i < 32; ++i) {
+        v.f[i] = -f[i];
+    }
+    return v;
+#endif
+}
+
+#if defined(XO_AVX)
+#   define _XO_W4X8_OP_X8(op, avxop) \
+    Vector4x8& Vector4x8::operator op (const Vector4x8& v) { \
+        ymmX = avxop(ymmX, v.ymmX); ymmY = avxop(ymmY, v.ymmY); ymmZ = avxop(ymmZ, v.ymmZ); ymmW = avxop(ymmW, v.ymmW); \
+        return *this; \
+    }
+#   define _XO_W4X8_OP_F(op, avxop) \
+    Vector4x8& Vector4x8::operator op (float v) { \
+        __m256 s = _mm256_set1_ps(v); \
+        ymmX = avxop(ymmX, s); ymmY = avxop(ymmY, s); ymmZ = avxop(ymmZ, s); ymmW = avxop(ymmW, s); \
+        return *this; \
+    }
+#else
+#   define _XO_W4X8_OP_X8(op, avxop) \
+    Vector4x8& Vector4x8::operator op (const Vector4x8& v) { \
+        for (int i = 0; i < 32; ++i) { f[i] op v.f[i]; } \
+        return *this; \
+    }
+#   define _XO_W4X8_OP_F(op, avxop) \
+    Vector4x8& Vector4x8::operator op (float v) { \
+        for (int i = 0; i < 32; ++i) { f[i] op v; } \
+        return *this; \
+    }
+#endif
+
+_XO_W4X8_OP_X8(+=, _mm256_add_ps)
+_XO_W4X8_OP_F(+=, _mm256_add_ps)
+_XO_W4X8_OP_X8(-=, _mm256_sub_ps)
+_XO_W4X8_OP_F(-=, _mm256_sub_ps)
+_XO_W4X8_OP_X8(*=, _mm256_mul_ps)
+_XO_W4X8_OP_F(*=, _mm256_mul_ps)
+
+#if defined(XO_NO_INVERSE_DIVISION) || !defined(XO_AVX)
+_XO_W4X8_OP_X8(/=, _mm256_div_ps)
+#else
+// See Vector3x8::operator/=.
+Vector4x8& Vector4x8::operator /= (const Vector4x8& v) {
+    ymmX = _mm256_mul_ps(ymmX, _mm256_rcp_ps(v.ymmX));
+    ymmY = _mm256_mul_ps(ymmY, _mm256_rcp_ps(v.ymmY));
+    ymmZ = _mm256_mul_ps(ymmZ, _mm256_rcp_ps(v.ymmZ));
+    ymmW = _mm256_mul_ps(ymmW, _mm256_rcp_ps(v.ymmW));
+    return *this;
+}
+#endif
+
+#undef _XO_W4X8_OP_X8
+#undef _XO_W4X8_OP_F
+
+Vector4x8& Vector4x8::operator /= (float v)                 { return (*this) *= (1.0f / v); }
+
+Vector4x8& Vector4x8::operator += (const Vector4& v)        { return (*this) += Vector4x8(v); }
+Vector4x8& Vector4x8::operator += (double v)                { return (*this) += float(v); }
+Vector4x8& Vector4x8::operator += (int v)                   { return (*this) += float(v); }
+Vector4x8& Vector4x8::operator -= (const Vector4& v)        { return (*this) -= Vector4x8(v); }
+Vector4x8& Vector4x8::operator -= (double v)                { return (*this) -= float(v); }
+Vector4x8& Vector4x8::operator -= (int v)                   { return (*this) -= float(v); }
+Vector4x8& Vector4x8::operator *= (const Vector4& v)        { return (*this) *= Vector4x8(v); }
+Vector4x8& Vector4x8::operator *= (double v)                { return (*this) *= float(v); }
+Vector4x8& Vector4x8::operator *= (int v)                   { return (*this) *= float(v); }
+Vector4x8& Vector4x8::operator /= (const Vector4& v)        { return (*this) /= Vector4x8(v); }
+Vector4x8& Vector4x8::operator /= (double v)                { return (*this) /= float(v); }
+Vector4x8& Vector4x8::operator /= (int v)                   { return (*this) /= float(v); }
+
+Vector4x8 Vector4x8::operator + (const Vector4x8& v) const  { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (const Vector4& v) const    { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (float v) const             { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (double v) const            { return Vector4x8(*this) += v; }
+Vector4x8 Vector4x8::operator + (int v) const               { return Vector4x8(*this) += v; }
+
+Vector4x8 Vector4x8::operator - (const Vector4x8& v) const  { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (const Vector4& v) const    { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (float v) const             { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (double v) const            { return Vector4x8(*this) -= v; }
+Vector4x8 Vector4x8::operator - (int v) const               { return Vector4x8(*this) -= v; }
+
+Vector4x8 Vector4x8::operator * (const Vector4x8& v) const  { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (const Vector4& v) const    { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (float v) const             { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (double v) const            { return Vector4x8(*this) *= v; }
+Vector4x8 Vector4x8::operator * (int v) const               { return Vector4x8(*this) *= v; }
+
+Vector4x8 Vector4x8::operator / (const Vector4x8& v) const  { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (const Vector4& v) const    { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (float v) const             { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (double v) const            { return Vector4x8(*this) /= v; }
+Vector4x8 Vector4x8::operator / (int v) const               { return Vector4x8(*this) /= v; }
+
+bool Vector4x8::operator == (const Vector4x8& v) const {
+#if defined(XO_AVX)
+    __m256 eq = _mm256_and_ps(
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmX, ymmX)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmY, ymmY)), avx::Epsilon, _CMP_LT_OQ)),
+        _mm256_and_ps(
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmZ, ymmZ)), avx::Epsilon, _CMP_LT_OQ),
+            _mm256_cmp_ps(avx::Abs(_mm256_sub_ps(v.ymmW, ymmW)), avx::Epsilon, _CMP_LT_OQ)));
+    return _mm256_movemask_ps(eq) == 255;
+#else
+    for (int i = 0; i < 32; ++i) {
+        if (!CloseEnough(f[i], v.f[i], Vector4::Epsilon)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Vector4x8::operator != (const Vector4x8& v) const      { return !((*this) == v); }
+
+void Vector4x8::Magnitude(float* outMagnitudes) const {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+    _mm256_storeu_ps(outMagnitudes, _mm256_sqrt_ps(m));
+#else
+    MagnitudeSquared(outMagnitudes);
+    for (int i = 0; i < 8; ++i) {
+        outMagnitudes[i] = Sqrt(outMagnitudes[i]);
+    }
+#endif
+}
+
+void Vector4x8::Sum(float* outSums) const {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outSums, _mm256_add_ps(_mm256_add_ps(ymmX, ymmY), _mm256_add_ps(ymmZ, ymmW)));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outSums[i] = x[i] + y[i] + z[i] + w[i];
+    }
+#endif
+}
+
+Vector4x8& Vector4x8::Normalize() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+#   if defined(XO_NO_INVERSE_DIVISION)
+    __m256 r = _mm256_div_ps(avx::One, _mm256_sqrt_ps(m));
+#   else
+    // See Vector3x4::Normalize for the newton-raphson step.
+    __m256 r = _mm256_rsqrt_ps(m);
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), _mm256_mul_ps(r, r))));
+#   endif
+    ymmX = _mm256_mul_ps(ymmX, r);
+    ymmY = _mm256_mul_ps(ymmY, r);
+    ymmZ = _mm256_mul_ps(ymmZ, r);
+    ymmW = _mm256_mul_ps(ymmW, r);
+#else
+    float m[8];
+    Magnitude(m);
+    for (int i = 0; i < 8; ++i) {
+        x[i] /= m[i];
+        y[i] /= m[i];
+        z[i] /= m[i];
+        w[i] /= m[i];
+    }
+#endif
+    return *this;
+}
+
+Vector4x8& Vector4x8::NormalizeSafe() {
+#if defined(XO_AVX)
+    __m256 m = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, ymmX), _mm256_mul_ps(ymmY, ymmY)),
+                             _mm256_add_ps(_mm256_mul_ps(ymmZ, ymmZ), _mm256_mul_ps(ymmW, ymmW)));
+    __m256 nonZero = _mm256_cmp_ps(m, avx::Zero, _CMP_GT_OQ);
+    Vector4x8 n = Normalized();
+    ymmX = _mm256_blendv_ps(ymmX, n.ymmX, nonZero);
+    ymmY = _mm256_blendv_ps(ymmY, n.ymmY, nonZero);
+    ymmZ = _mm256_blendv_ps(ymmZ, n.ymmZ, nonZero);
+    ymmW = _mm256_blendv_ps(ymmW, n.ymmW, nonZero);
+#else
+    float m[8];
+    MagnitudeSquared(m);
+    for (int i = 0; i < 8; ++i) {
+        if (m[i] != 0.0f) {
+            float r = 1.0f / Sqrt(m[i]);
+            x[i] *= r;
+            y[i] *= r;
+            z[i] *= r;
+            w[i] *= r;
+        }
+    }
+#endif
+    return *this;
+}
+
+void Vector4x8::Dot(const Vector4x8& a, const Vector4x8& b, float* outDots) {
+#if defined(XO_AVX)
+    _mm256_storeu_ps(outDots, _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(a.ymmX, b.ymmX), _mm256_mul_ps(a.ymmY, b.ymmY)),
+        _mm256_add_ps(_mm256_mul_ps(a.ymmZ, b.ymmZ), _mm256_mul_ps(a.ymmW, b.ymmW))));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outDots[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) + (a.w[i] * b.w[i]);
+    }
+#endif
+}
+
+void Vector4x8::Lerp(const Vector4x8& a, const Vector4x8& b, const float* t, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    __m256 vt = _mm256_loadu_ps(t);
+    outVec.ymmX = _mm256_add_ps(a.ymmX, _mm256_mul_ps(_mm256_sub_ps(b.ymmX, a.ymmX), vt));
+    outVec.ymmY = _mm256_add_ps(a.ymmY, _mm256_mul_ps(_mm256_sub_ps(b.ymmY, a.ymmY), vt));
+    outVec.ymmZ = _mm256_add_ps(a.ymmZ, _mm256_mul_ps(_mm256_sub_ps(b.ymmZ, a.ymmZ), vt));
+    outVec.ymmW = _mm256_add_ps(a.ymmW, _mm256_mul_ps(_mm256_sub_ps(b.ymmW, a.ymmW), vt));
+#else
+    for (int i = 0; i < 8; ++i) {
+        outVec.x[i] = a.x[i] + ((b.x[i] - a.x[i]) * t[i]);
+        outVec.y[i] = a.y[i] + ((b.y[i] - a.y[i]) * t[i]);
+        outVec.z[i] = a.z[i] + ((b.z[i] - a.z[i]) * t[i]);
+        outVec.w[i] = a.w[i] + ((b.w[i] - a.w[i]) * t[i]);
+    }
+#endif
+}
+
+void Vector4x8::Max(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_max_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_max_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_max_ps(a.ymmZ, b.ymmZ);
+    outVec.ymmW = _mm256_max_ps(a.ymmW, b.ymmW);
+#else
+    for (int i = 0; i < 32; ++i) {
+        outVec.f[i] = _XO_MAX(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+void Vector4x8::Min(const Vector4x8& a, const Vector4x8& b, Vector4x8& outVec) {
+#if defined(XO_AVX)
+    outVec.ymmX = _mm256_min_ps(a.ymmX, b.ymmX);
+    outVec.ymmY = _mm256_min_ps(a.ymmY, b.ymmY);
+    outVec.ymmZ = _mm256_min_ps(a.ymmZ, b.ymmZ);
+    outVec.ymmW = _mm256_min_ps(a.ymmW, b.ymmW);
+#else
+    for (int i = 0; i < 32; ++i) {
+        outVec.f[i] = _XO_MIN(a.f[i], b.f[i]);
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
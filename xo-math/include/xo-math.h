@@ -24,14 +24,12 @@
 // TODO:
 //  * Ensure macros are consistently named.
 //  * Support NEON (investigate http://projectne10.github.io/Ne10/ license)
-//  * Add transformation object.
 //  * Move trivial methods to headers, keep only "meaningful" code in *.cpp/*inline.h files
 //  * Use macros to generate variant functions for other classes, like in Vector3.h
 //  * Consider other simpler documentation solution. github pages?
 //  * Consider something like premake or similar for dev project files. Check out https://github.com/bkaradzic/GENie
 //  * Move CI back to travis, include more compiler versions.
 //  * Matrix: finish filling out stubs
-//  * fast sin/cos, sincos, _x2 _x2 _x3
 //  * RNG: https://blogs.unity3d.com/2015/01/07/a-primer-on-repeatable-random-numbers/
 //  * Noise:
 //  * Consider moving all randoms out of types themselves and into a separate file.
@@ -72,12 +70,17 @@
 #endif 
 
 #include <math.h>
+#include <stdlib.h>
 #ifndef XO_NO_OSTREAM
 #   include <ostream>
 #endif
-#include <random>
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
 #if defined(__arm__)
 #   if defined(__ARM_NEON__)
 #       include <arm_neon.h>
@@ -90,9 +93,23 @@
 #           include <arm_neon.h>
 #       else
 #           include <xmmintrin.h>
+#           include <intrin.h>
 #       endif
 #   else
+        // gcc 12 reports its own _mm512_undefined_ps as uninitialized wherever an AVX-512 intrinsic using it is 
+        // inlined. The warning is placed in the intrinsic headers, so it's silenced for them alone.
+#       if defined(__GNUC__) && !defined(__clang__)
+#           pragma GCC diagnostic push
+#           pragma GCC diagnostic ignored "-Wuninitialized"
+#           pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#       endif
 #       include <x86intrin.h>
+#       if defined(__GNUC__) && !defined(__clang__)
+#           pragma GCC diagnostic pop
+#       endif
+#       if defined(__x86_64__) || defined(__i386__)
+#           include <cpuid.h>
+#       endif
 #   endif
 #endif
 
@@ -146,6 +163,23 @@
 #   define _XOINL inline
 #endif
 
+// With XO_HEADER_ONLY the sources are included at the end of this header, so everything they define has to be 
+// allowed to appear in each translation unit. Functions are made inline, and static data members are merged by the 
+// linker.
+#if defined(XO_HEADER_ONLY)
+#   define _XOSRCINL _XOINL
+#   if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#       define _XOSRCDATA inline
+#   elif defined(_MSC_VER)
+#       define _XOSRCDATA __declspec(selectany)
+#   else
+#       define _XOSRCDATA __attribute__((weak))
+#   endif
+#else
+#   define _XOSRCINL
+#   define _XOSRCDATA
+#endif
+
 
 #if (defined(__clang__) && defined(__APPLE__))
 #   define _XOTLS __thread
@@ -155,21 +189,9 @@
 #   define _XOTLS thread_local
 #endif
 
-# define _XO_NO_TLS (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
-
 // apple clang doesn't give us thread_local until xcode 8.
-#if _XO_NO_TLS
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937* tls_engline; \
-        static _XOTLS char mem[sizeof(std::mt19937)];\
-        if(!tls_engline) { \
-            tls_engline = new(mem) std::mt19937((unsigned)clock()); \
-        }
-#    define _XO_TLS_DISTRIBUTION dist(*tls_engline)
-#else
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937 tls_engline((unsigned)clock());
-#    define _XO_TLS_DISTRIBUTION dist(tls_engline)
+#if (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
+#   define _XO_NO_TLS 1
 #endif
 
 XOMATH_BEGIN_XO_NS();
@@ -247,6 +269,30 @@ namespace sse {
 #   define _XO_OVERLOAD_NEW_DELETE()
 #endif
 
+#if defined(XO_AVX)
+namespace avx {
+    static const __m256 AbsMask = _mm256_set1_ps(HexFloat(0x7fffffff));
+    static const __m256 SignMask = _mm256_set1_ps(HexFloat(0x80000000));
+
+    _XOINL __m256 Abs(__m256 v) {
+        return _mm256_and_ps(AbsMask, v);
+    }
+
+    static const __m256 Zero = _mm256_setzero_ps();
+    static const __m256 One = _mm256_set1_ps(1.0f);
+    static const __m256 Epsilon = _mm256_set1_ps(sse::SSEFloatEpsilon);
+}
+
+// AVX types need 32 byte alignment, which is more than XO_16ALIGNED_MALLOC guarantees.
+#define _XO_OVERLOAD_NEW_DELETE_32() \
+     _XOINL static void* operator new (std::size_t size)     { return _mm_malloc(size, 32); } \
+     _XOINL static void* operator new[] (std::size_t size)   { return _mm_malloc(size, 32); } \
+     _XOINL static void operator delete (void* ptr)          { _mm_free(ptr); } \
+     _XOINL static void operator delete[] (void* ptr)        { _mm_free(ptr); }
+#else
+#   define _XO_OVERLOAD_NEW_DELETE_32() _XO_OVERLOAD_NEW_DELETE()
+#endif
+
 #define _XO_MIN(a, b) (a < b ? a : b)
 #define _XO_MAX(a, b) (a > b ? a : b)
 
@@ -265,81 +311,6 @@ _XOINL float ATan(float f)              { return atanf(f); }
 _XOINL float ATan2(float y, float x)    { return atan2f(y, x); } 
 _XOINL float Difference(float x, float y) { return Abs(x-y); }
 
-_XOINL
-void Sin_x2(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-}
-
-_XOINL
-void Sin_x3(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
-}
-
-_XOINL
-void Sin_x4(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
-    s[3] = Sin(f[3]);
-}
-
-_XOINL
-void Cos_x2(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-}
-
-_XOINL
-void Cos_x3(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
-}
-
-_XOINL
-void Cos_x4(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
-    c[3] = Cos(f[3]);
-}
-
-_XOINL
-void SinCos(float f, float& s, float& c) { 
-    s = Sin(f);
-    c = Cos(f);
-}
-
-_XOINL
-void SinCos_x2(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
-    Sin_x2(f, s);
-    Cos_x2(f, c);
-}
-
-_XOINL
-void SinCos_x3(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
-    Sin_x3(f, s);
-    Cos_x3(f, c);
-}
-
-_XOINL
-void SinCos_x4(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
-    Sin_x4(f, s);
-    Cos_x4(f, c);
-}
-
 _XOINL
 bool CloseEnough(float x, float y, float tolerance = FloatEpsilon) {
     return Difference(x, y) * (1.0f/tolerance) <= Min(Abs(x), Abs(y));
@@ -349,27 +320,6 @@ _XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
 _XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
 _XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
 
-_XOINL 
-bool RandomBool() {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(0, 1);
-    return _XO_TLS_DISTRIBUTION == 1;
-}
-
-_XOINL 
-int RandomRange(int low, int high) {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
-
-_XOINL 
-float RandomRange(float low, float high) {
-    _XO_TLS_ENGINE
-    std::uniform_real_distribution<float> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
-
 XOMATH_END_XO_NS();
 
 #if defined(XO_SSE)
@@ -381,20 +331,68 @@ XOMATH_END_XO_NS();
 #endif
 
 ////////////////////////////////////////////////////////////////////////// Module Includes
+#include "AlignedAllocator.h"
+#include "Trig.h"
+#include "Random.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "Half.h"
+#include "Vector3Array.h"
 #include "Matrix4x4.h"
+#include "Matrix3x4.h"
 #include "Quaternion.h"
+#include "DualQuaternion.h"
+#include "Transform.h"
+#include "Hierarchy.h"
+#include "Skinning.h"
+#include "FrameArena.h"
+#include "Vector3x4.h"
+#include "Vector4x4.h"
+#include "Vector3x8.h"
+#include "Vector4x8.h"
+#include "Dispatch.h"
 
 #include "Vector2Inline.h"
 #include "Vector3Inline.h"
 #include "Vector4Inline.h"
 #include "Matrix4x4Inline.h"
+#include "Matrix3x4Inline.h"
 #include "QuaternionInline.h"
+#include "DualQuaternionInline.h"
+#include "TransformInline.h"
+#include "HierarchyInline.h"
+#include "Vector3x4Inline.h"
+#include "Vector4x4Inline.h"
+#include "Vector3x8Inline.h"
+#include "Vector4x8Inline.h"
+#include "Vector3ArrayInline.h"
+#include "FrameArenaInline.h"
 
 #include "SSE.h"
 
+#if defined(XO_HEADER_ONLY) && !defined(_XO_MATH_OBJ)
+#   include "../src/Dispatch.cpp"
+#   include "../src/DualQuaternion.cpp"
+#   include "../src/FrameArena.cpp"
+#   include "../src/Half.cpp"
+#   include "../src/Hierarchy.cpp"
+#   include "../src/Matrix3x4.cpp"
+#   include "../src/Matrix4x4.cpp"
+#   include "../src/Quaternion.cpp"
+#   include "../src/Random.cpp"
+#   include "../src/Skinning.cpp"
+#   include "../src/SSE.cpp"
+#   include "../src/Transform.cpp"
+#   include "../src/Trig.cpp"
+#   include "../src/Vector2.cpp"
+#   include "../src/Vector3.cpp"
+#   include "../src/Vector3Array.cpp"
+#   include "../src/Vector4.cpp"
+// each source defines this for itself.
+#   undef _XO_MATH_OBJ
+#endif
+
 ////////////////////////////////////////////////////////////////////////// Remove internal macros
 
 #if defined(XO_REDEFINABLE)
@@ -413,12 +411,21 @@ XOMATH_END_XO_NS();
 
 #   undef _XOCONSTEXPR
 #   undef _XOINL
+#   undef _XOSRCINL
+#   undef _XOSRCDATA
 #   undef _XOTLS
 
-#   undef _XO_TLS_ENGINE
-#   undef _XO_TLS_DISTRIBUTION
+#   undef _XO_NO_TLS
+
+#   undef _XO_KERNELS_AVX
+#   undef _XO_KERNELS_AVX2
+#   undef _XO_KERNELS_AVX512
+#   undef _XO_TARGET_AVX
+#   undef _XO_TARGET_AVX2
+#   undef _XO_TARGET_AVX512
 
 #   undef _XO_OVERLOAD_NEW_DELETE
+#   undef _XO_OVERLOAD_NEW_DELETE_32
 
 #   undef _XO_MIN
 #   undef _XO_MAX
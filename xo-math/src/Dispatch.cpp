@@ -0,0 +1,242 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+#if defined(XO_DISPATCH)
+    _XOSRCINL void CPUID(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#   if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subleaf);
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = (unsigned)r[i];
+        }
+#   else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#   endif
+    }
+
+    // The register state the operating system saves on a context switch.
+    _XOSRCINL unsigned long long XGETBV() {
+#   if defined(_MSC_VER)
+        return _xgetbv(0);
+#   else
+        unsigned eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((unsigned long long)edx << 32) | eax;
+#   endif
+    }
+#endif
+
+#if defined(XO_SSE2)
+    // The kernels for the highest tier, no higher than tier, that this build has kernels for.
+    // The tables are function statics so that a header only build shares one of each between translation units.
+    _XOSRCINL const DispatchKernels* KernelsForTier(SIMDTier tier) {
+        static const DispatchKernels SSE2Kernels = {
+            SIMDTier::SSE2,
+            TransformVector3Array,
+            TransformVector4Array,
+            MultiplyBatch,
+            MultiplyIndexedBatch,
+            InverseBatch,
+            SinCosArray,
+            DotVector3Array,
+            NormalizeVector3Array,
+            RotateVector3Batch,
+            BlendQuaternionBatch,
+            SkinVertices,
+            SkinVerticesDualQuaternion,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3Array
+        };
+        const DispatchKernels* kernels = &SSE2Kernels;
+        (void)tier;
+#   if defined(_XO_KERNELS_AVX)
+        static const DispatchKernels AVXKernels = {
+            SIMDTier::AVX,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArray,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArray,
+            HalfToFloatArray,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX) {
+            kernels = &AVXKernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX2)
+        static const DispatchKernels AVX2Kernels = {
+            SIMDTier::AVX2,
+            TransformVector3ArrayAVX,
+            TransformVector4ArrayAVX,
+            MultiplyBatchAVX,
+            MultiplyIndexedBatchAVX,
+            InverseBatchAVX,
+            SinCosArrayAVX2,
+            DotVector3ArrayAVX,
+            NormalizeVector3ArrayAVX,
+            RotateVector3BatchAVX,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX2) {
+            kernels = &AVX2Kernels;
+        }
+#   endif
+#   if defined(_XO_KERNELS_AVX512)
+        static const DispatchKernels AVX512Kernels = {
+            SIMDTier::AVX512,
+            TransformVector3ArrayAVX512,
+            TransformVector4ArrayAVX512,
+            MultiplyBatchAVX512,
+            MultiplyIndexedBatchAVX512,
+            InverseBatchAVX512,
+            SinCosArrayAVX512,
+            DotVector3ArrayAVX512,
+            NormalizeVector3ArrayAVX512,
+            RotateVector3BatchAVX512,
+            BlendQuaternionBatchAVX,
+            SkinVerticesAVX,
+            SkinVerticesDualQuaternionAVX,
+            FloatToHalfArrayF16C,
+            HalfToFloatArrayF16C,
+            TransformFloat3ArrayAVX
+        };
+        if (tier >= SIMDTier::AVX512) {
+            kernels = &AVX512Kernels;
+        }
+#   endif
+        return kernels;
+    }
+
+    _XOSRCINL std::atomic<const DispatchKernels*>& SelectedKernels() {
+        static std::atomic<const DispatchKernels*> selected(nullptr);
+        return selected;
+    }
+#endif
+}
+
+_XOSRCINL SIMDTier DetectSIMDTier() {
+#if defined(XO_DISPATCH)
+    unsigned regs[4];
+    xo_internal::CPUID(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return SIMDTier::None;
+    }
+    xo_internal::CPUID(1, 0, regs);
+    if (!(regs[3] & (1u << 26))) {
+        return SIMDTier::None;
+    }
+    // AVX needs the CPU to support it, and the OS to save the ymm registers (xgetbv bits 1 and 2).
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    if (!osxsave || !(regs[2] & (1u << 28)) || (xo_internal::XGETBV() & 0x6) != 0x6) {
+        return SIMDTier::SSE2;
+    }
+    // The AVX2 tier's kernels also use F16C, which every AVX2 CPU has.
+    const bool f16c = (regs[2] & (1u << 29)) != 0;
+    if (maxLeaf < 7) {
+        return SIMDTier::AVX;
+    }
+    xo_internal::CPUID(7, 0, regs);
+    if (!(regs[1] & (1u << 5)) || !f16c) {
+        return SIMDTier::AVX;
+    }
+    // AVX-512 F, DQ, BW and VL, with the OS also saving the opmask and zmm registers (xgetbv bits 5 to 7).
+    const unsigned avx512Bits = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+    if ((regs[1] & avx512Bits) != avx512Bits || (xo_internal::XGETBV() & 0xe6) != 0xe6) {
+        return SIMDTier::AVX2;
+    }
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX512)
+    return SIMDTier::AVX512;
+#elif defined(XO_AVX2)
+    return SIMDTier::AVX2;
+#elif defined(XO_AVX)
+    return SIMDTier::AVX;
+#elif defined(XO_SSE2)
+    return SIMDTier::SSE2;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL void InitDispatch(SIMDTier maxTier) {
+#if defined(XO_SSE2)
+    const SIMDTier cpuTier = DetectSIMDTier();
+    xo_internal::SelectedKernels().store(xo_internal::KernelsForTier(cpuTier < maxTier ? cpuTier : maxTier));
+#else
+    (void)maxTier;
+#endif
+}
+
+_XOSRCINL SIMDTier GetDispatchTier() {
+#if defined(XO_SSE2)
+    return xo_internal::GetDispatchKernels().tier;
+#else
+    return SIMDTier::None;
+#endif
+}
+
+_XOSRCINL const char* GetSIMDTierName(SIMDTier tier) {
+    switch (tier) {
+        case SIMDTier::None:    return "none";
+        case SIMDTier::SSE2:    return "sse2";
+        case SIMDTier::AVX:     return "avx";
+        case SIMDTier::AVX2:    return "avx2";
+        case SIMDTier::AVX512:  return "avx512";
+    }
+    return "unknown";
+}
+
+#if defined(XO_SSE2)
+_XOSRCINL const xo_internal::DispatchKernels& xo_internal::GetDispatchKernels() {
+    const DispatchKernels* kernels = SelectedKernels().load(std::memory_order_relaxed);
+    if (!kernels) {
+        InitDispatch();
+        kernels = SelectedKernels().load();
+    }
+    return *kernels;
+}
+#endif
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,448 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+_XOSRCDATA const DualQuaternion DualQuaternion::Identity(Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL DualQuaternion::DualQuaternion() {
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    real(real),
+    dual(dual)
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector3& translation) :
+    real(rotation)
+{
+    // q_d = t q_r / 2, with t as a quaternion with no w.
+    Quaternion d = Quaternion(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.0f) * rotation;
+    dual = d;
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix3x4& m) :
+    DualQuaternion(Quaternion(m), m.GetTranslation())
+{
+}
+
+_XOSRCINL DualQuaternion::DualQuaternion(const Matrix4x4& m) :
+    DualQuaternion(Matrix3x4(m))
+{
+}
+
+#if defined(XO_SSE)
+namespace xo_internal
+{
+    // The four component dot product of a and b, in every lane.
+    _XOINL __m128 DualQuaternionDot(__m128 a, __m128 b) {
+        __m128 p = _mm_mul_ps(a, b);
+        p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+}
+#endif
+
+_XOSRCINL DualQuaternion& DualQuaternion::Normalize() {
+#if defined(XO_SSE)
+    __m128 r = real.xmm, d = dual.xmm;
+    __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(xo_internal::DualQuaternionDot(r, r)));
+    r = _mm_mul_ps(r, inverseLength);
+    d = _mm_mul_ps(d, inverseLength);
+    // q_d's component along q_r only adds to the w of the translation 2 q_d q_r^*, so it can go.
+    real.xmm = r;
+    dual.xmm = _mm_sub_ps(d, _mm_mul_ps(r, xo_internal::DualQuaternionDot(r, d)));
+#else
+    Vector4 r(real), d(dual);
+    float inverseLength = 1.0f / Sqrt(r.MagnitudeSquared());
+    r *= inverseLength;
+    d *= inverseLength;
+    d -= r * Vector4::Dot(r, d);
+    real = Quaternion(r.x, r.y, r.z, r.w);
+    dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Normalized() const {
+    return DualQuaternion(*this).Normalize();
+}
+
+_XOSRCINL DualQuaternion& DualQuaternion::MakeInverse() {
+    real.MakeConjugate();
+    dual.MakeConjugate();
+    return *this;
+}
+
+_XOSRCINL DualQuaternion DualQuaternion::Inverse() const {
+    return DualQuaternion(*this).MakeInverse();
+}
+
+_XOSRCINL void DualQuaternion::Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outDualQuaternion) {
+#if defined(XO_SSE)
+    // t for b takes the sign of the dot product of the rotations, without a branch.
+    __m128 ta = _mm_set1_ps(1.0f - t);
+    __m128 tb = _mm_xor_ps(_mm_set1_ps(t), _mm_and_ps(xo_internal::DualQuaternionDot(a.real.xmm, b.real.xmm), _mm_set1_ps(-0.0f)));
+    outDualQuaternion.real.xmm = _mm_add_ps(_mm_mul_ps(a.real.xmm, ta), _mm_mul_ps(b.real.xmm, tb));
+    outDualQuaternion.dual.xmm = _mm_add_ps(_mm_mul_ps(a.dual.xmm, ta), _mm_mul_ps(b.dual.xmm, tb));
+#else
+    Vector4 ar(a.real), ad(a.dual), br(b.real), bd(b.dual);
+    float tb = Vector4::Dot(ar, br) < 0.0f ? -t : t;
+    Vector4 r = ar * (1.0f - t) + br * tb;
+    Vector4 d = ad * (1.0f - t) + bd * tb;
+    outDualQuaternion.real = Quaternion(r.x, r.y, r.z, r.w);
+    outDualQuaternion.dual = Quaternion(d.x, d.y, d.z, d.w);
+#endif
+    outDualQuaternion.Normalize();
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four dual quaternions, one per lane, with each register holding one component of all four.
+    struct DualQuaternionLanes {
+        __m128 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Bone k of each of four vertices, one vertex per lane.
+    _XOINL void LoadBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanes& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        o.rx = b0.real.xmm; o.ry = b1.real.xmm; o.rz = b2.real.xmm; o.rw = b3.real.xmm;
+        o.dx = b0.dual.xmm; o.dy = b1.dual.xmm; o.dz = b2.dual.xmm; o.dw = b3.dual.xmm;
+        _MM_TRANSPOSE4_PS(o.rx, o.ry, o.rz, o.rw);
+        _MM_TRANSPOSE4_PS(o.dx, o.dy, o.dz, o.dw);
+    }
+
+    // Adds bone k of four vertices to sum, weighted. The weight is negated where the bone's rotation is in the
+    // other hemisphere from the first bone's, so every bone is blended the shorter way around.
+    _XOINL void AddBoneLanes(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m128 weight, const DualQuaternionLanes& first, DualQuaternionLanes& sum) {
+        DualQuaternionLanes b;
+        LoadBoneLanes(palette, influences, k, b);
+        __m128 cosine = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.rx, first.rx), _mm_mul_ps(b.ry, first.ry)), _mm_add_ps(_mm_mul_ps(b.rz, first.rz), _mm_mul_ps(b.rw, first.rw)));
+        weight = _mm_xor_ps(weight, _mm_and_ps(cosine, _mm_set1_ps(-0.0f)));
+        sum.rx = _mm_add_ps(sum.rx, _mm_mul_ps(b.rx, weight));
+        sum.ry = _mm_add_ps(sum.ry, _mm_mul_ps(b.ry, weight));
+        sum.rz = _mm_add_ps(sum.rz, _mm_mul_ps(b.rz, weight));
+        sum.rw = _mm_add_ps(sum.rw, _mm_mul_ps(b.rw, weight));
+        sum.dx = _mm_add_ps(sum.dx, _mm_mul_ps(b.dx, weight));
+        sum.dy = _mm_add_ps(sum.dy, _mm_mul_ps(b.dy, weight));
+        sum.dz = _mm_add_ps(sum.dz, _mm_mul_ps(b.dz, weight));
+        sum.dw = _mm_add_ps(sum.dw, _mm_mul_ps(b.dw, weight));
+    }
+
+    // sse::QuaternionRotate of x, y and z by the unit quaternion q, one per lane.
+    _XOINL void RotateLanes(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& x, __m128& y, __m128& z) {
+        __m128 tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+        __m128 ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+        __m128 tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+        x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+    }
+
+    // Dual quaternion linear blending of four vertices, one per lane. Each vertex's bones are summed by weight,
+    // then the position is transformed by the sum as DualQuaternion::Normalized then TransformPoint would, with the
+    // normalization folded into the rotation and translation rather than applied to the sum.
+    _XOINL void SkinDualQuaternionFour(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m128 w0 = _mm_loadu_ps(influences[0].weights);
+        __m128 w1 = _mm_loadu_ps(influences[1].weights);
+        __m128 w2 = _mm_loadu_ps(influences[2].weights);
+        __m128 w3 = _mm_loadu_ps(influences[3].weights);
+        _MM_TRANSPOSE4_PS(w0, w1, w2, w3);
+
+        DualQuaternionLanes first, sum;
+        LoadBoneLanes(palette, influences, 0, first);
+        sum.rx = _mm_mul_ps(first.rx, w0);
+        sum.ry = _mm_mul_ps(first.ry, w0);
+        sum.rz = _mm_mul_ps(first.rz, w0);
+        sum.rw = _mm_mul_ps(first.rw, w0);
+        sum.dx = _mm_mul_ps(first.dx, w0);
+        sum.dy = _mm_mul_ps(first.dy, w0);
+        sum.dz = _mm_mul_ps(first.dz, w0);
+        sum.dw = _mm_mul_ps(first.dw, w0);
+        AddBoneLanes(palette, influences, 1, w1, first, sum);
+        AddBoneLanes(palette, influences, 2, w2, first, sum);
+        AddBoneLanes(palette, influences, 3, w3, first, sum);
+
+        // 1 / |q_r|, from an approximate reciprocal square root and one Newton-Raphson step.
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sum.rx, sum.rx), _mm_mul_ps(sum.ry, sum.ry)), _mm_add_ps(_mm_mul_ps(sum.rz, sum.rz), _mm_mul_ps(sum.rw, sum.rw)));
+        __m128 inverseLength = _mm_rsqrt_ps(lengthSquared);
+        inverseLength = _mm_mul_ps(inverseLength, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared), _mm_mul_ps(inverseLength, inverseLength))));
+        __m128 qx = _mm_mul_ps(sum.rx, inverseLength);
+        __m128 qy = _mm_mul_ps(sum.ry, inverseLength);
+        __m128 qz = _mm_mul_ps(sum.rz, inverseLength);
+        __m128 qw = _mm_mul_ps(sum.rw, inverseLength);
+        // DualQuaternion::GetTranslation of the sum, divided by |q_r|^2 for the normalization.
+        __m128 scale = _mm_mul_ps(_mm_set1_ps(2.0f), _mm_mul_ps(inverseLength, inverseLength));
+        __m128 tx = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dx), _mm_mul_ps(sum.dw, sum.rx)), _mm_sub_ps(_mm_mul_ps(sum.ry, sum.dz), _mm_mul_ps(sum.rz, sum.dy))));
+        __m128 ty = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dy), _mm_mul_ps(sum.dw, sum.ry)), _mm_sub_ps(_mm_mul_ps(sum.rz, sum.dx), _mm_mul_ps(sum.rx, sum.dz))));
+        __m128 tz = _mm_mul_ps(scale, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(sum.rw, sum.dz), _mm_mul_ps(sum.dw, sum.rz)), _mm_sub_ps(_mm_mul_ps(sum.rx, sum.dy), _mm_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m128 x = normals[0].xmm, y = normals[1].xmm, z = normals[2].xmm, w = normals[3].xmm;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            RotateLanes(qx, qy, qz, qw, x, y, z);
+            w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            outNormals[0].xmm = x;
+            outNormals[1].xmm = y;
+            outNormals[2].xmm = z;
+            outNormals[3].xmm = w;
+        }
+        __m128 x = positions[0].xmm, y = positions[1].xmm, z = positions[2].xmm, w = positions[3].xmm;
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        RotateLanes(qx, qy, qz, qw, x, y, z);
+        x = _mm_add_ps(x, tx);
+        y = _mm_add_ps(y, ty);
+        z = _mm_add_ps(z, tz);
+        w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        outPositions[0].xmm = x;
+        outPositions[1].xmm = y;
+        outPositions[2].xmm = z;
+        outPositions[3].xmm = w;
+    }
+#endif
+
+    _XOSRCINL void SkinVerticesDualQuaternion(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            SkinDualQuaternionFour(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        if (i < n) {
+            // The rest are padded out to four with the first bone at full weight.
+            Skinning::Influences tailInfluences[4];
+            Vector3 tailPositions[4], tailNormals[4];
+            for (size_t j = 0; j < 4; ++j) {
+                if (i + j < n) {
+                    tailInfluences[j] = influences[i + j];
+                    tailPositions[j] = positions[i + j];
+                    tailNormals[j] = normals ? normals[i + j] : Vector3::Zero;
+                }
+                else {
+                    tailInfluences[j] = influences[i];
+                    tailPositions[j] = Vector3::Zero;
+                    tailNormals[j] = Vector3::Zero;
+                }
+            }
+            SkinDualQuaternionFour(palette, tailInfluences, tailPositions, normals ? tailNormals : nullptr, tailPositions, tailNormals);
+            for (size_t j = 0; i + j < n; ++j) {
+                outPositions[i + j] = tailPositions[j];
+                if (normals) {
+                    outNormals[i + j] = tailNormals[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 first(palette[influence.bones[0]].real);
+            Vector4 r(0.0f), d(0.0f);
+            for (int k = 0; k < 4; ++k) {
+                const DualQuaternion& bone = palette[influence.bones[k]];
+                Vector4 br(bone.real);
+                float weight = Vector4::Dot(br, first) < 0.0f ? -influence.weights[k] : influence.weights[k];
+                r += br * weight;
+                d += Vector4(bone.dual) * weight;
+            }
+            DualQuaternion blended(Quaternion(r.x, r.y, r.z, r.w), Quaternion(d.x, d.y, d.z, d.w));
+            blended.Normalize();
+            if (normals) {
+                outNormals[i] = blended.TransformDirection(normals[i]);
+            }
+            outPositions[i] = blended.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // DualQuaternionLanes for eight vertices, with vertices j and j + 4 in lane j of the low and high halves.
+    struct DualQuaternionLanesAVX {
+        __m256 rx, ry, rz, rw, dx, dy, dz, dw;
+    };
+
+    // Two 128 bit values, in the low and high halves.
+    _XOINL _XO_TARGET_AVX __m256 LanePair(__m128 low, __m128 high) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void LoadBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, DualQuaternionLanesAVX& o) {
+        const DualQuaternion& b0 = palette[influences[0].bones[k]];
+        const DualQuaternion& b1 = palette[influences[1].bones[k]];
+        const DualQuaternion& b2 = palette[influences[2].bones[k]];
+        const DualQuaternion& b3 = palette[influences[3].bones[k]];
+        const DualQuaternion& b4 = palette[influences[4].bones[k]];
+        const DualQuaternion& b5 = palette[influences[5].bones[k]];
+        const DualQuaternion& b6 = palette[influences[6].bones[k]];
+        const DualQuaternion& b7 = palette[influences[7].bones[k]];
+        __m256 r[4] = { LanePair(b0.real.xmm, b4.real.xmm), LanePair(b1.real.xmm, b5.real.xmm), LanePair(b2.real.xmm, b6.real.xmm), LanePair(b3.real.xmm, b7.real.xmm) };
+        __m256 d[4] = { LanePair(b0.dual.xmm, b4.dual.xmm), LanePair(b1.dual.xmm, b5.dual.xmm), LanePair(b2.dual.xmm, b6.dual.xmm), LanePair(b3.dual.xmm, b7.dual.xmm) };
+        TransposeLanes4x4(r);
+        TransposeLanes4x4(d);
+        o.rx = r[0]; o.ry = r[1]; o.rz = r[2]; o.rw = r[3];
+        o.dx = d[0]; o.dy = d[1]; o.dz = d[2]; o.dw = d[3];
+    }
+
+    // AddBoneLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void AddBoneLanesAVX(const DualQuaternion* palette, const Skinning::Influences* influences, int k, __m256 weight,
+                                               const DualQuaternionLanesAVX& first, DualQuaternionLanesAVX& sum) {
+        DualQuaternionLanesAVX b;
+        LoadBoneLanesAVX(palette, influences, k, b);
+        __m256 cosine = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b.rx, first.rx), _mm256_mul_ps(b.ry, first.ry)),
+                                      _mm256_add_ps(_mm256_mul_ps(b.rz, first.rz), _mm256_mul_ps(b.rw, first.rw)));
+        weight = _mm256_xor_ps(weight, _mm256_and_ps(cosine, _mm256_set1_ps(-0.0f)));
+        sum.rx = _mm256_add_ps(sum.rx, _mm256_mul_ps(b.rx, weight));
+        sum.ry = _mm256_add_ps(sum.ry, _mm256_mul_ps(b.ry, weight));
+        sum.rz = _mm256_add_ps(sum.rz, _mm256_mul_ps(b.rz, weight));
+        sum.rw = _mm256_add_ps(sum.rw, _mm256_mul_ps(b.rw, weight));
+        sum.dx = _mm256_add_ps(sum.dx, _mm256_mul_ps(b.dx, weight));
+        sum.dy = _mm256_add_ps(sum.dy, _mm256_mul_ps(b.dy, weight));
+        sum.dz = _mm256_add_ps(sum.dz, _mm256_mul_ps(b.dz, weight));
+        sum.dw = _mm256_add_ps(sum.dw, _mm256_mul_ps(b.dw, weight));
+    }
+
+    // RotateLanes for eight vertices.
+    _XOINL _XO_TARGET_AVX void RotateLanesAVX(__m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256& x, __m256& y, __m256& z) {
+        __m256 tx = _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y));
+        __m256 ty = _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z));
+        __m256 tz = _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x));
+        tx = _mm256_add_ps(tx, tx);
+        ty = _mm256_add_ps(ty, ty);
+        tz = _mm256_add_ps(tz, tz);
+        x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(qw, tx)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+        y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(qw, ty)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+        z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(qw, tz)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+    }
+
+    // SkinDualQuaternionFour for eight vertices. The vertex arrays are read and written 128 bits at a time, four
+    // apart, to match the lanes.
+    _XOINL _XO_TARGET_AVX void SkinDualQuaternionEight(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                       const Vector3* normals, Vector3* outPositions, Vector3* outNormals) {
+        __m256 w[4] = {
+            LanePair(_mm_loadu_ps(influences[0].weights), _mm_loadu_ps(influences[4].weights)),
+            LanePair(_mm_loadu_ps(influences[1].weights), _mm_loadu_ps(influences[5].weights)),
+            LanePair(_mm_loadu_ps(influences[2].weights), _mm_loadu_ps(influences[6].weights)),
+            LanePair(_mm_loadu_ps(influences[3].weights), _mm_loadu_ps(influences[7].weights))
+        };
+        TransposeLanes4x4(w);
+
+        DualQuaternionLanesAVX first, sum;
+        LoadBoneLanesAVX(palette, influences, 0, first);
+        sum.rx = _mm256_mul_ps(first.rx, w[0]);
+        sum.ry = _mm256_mul_ps(first.ry, w[0]);
+        sum.rz = _mm256_mul_ps(first.rz, w[0]);
+        sum.rw = _mm256_mul_ps(first.rw, w[0]);
+        sum.dx = _mm256_mul_ps(first.dx, w[0]);
+        sum.dy = _mm256_mul_ps(first.dy, w[0]);
+        sum.dz = _mm256_mul_ps(first.dz, w[0]);
+        sum.dw = _mm256_mul_ps(first.dw, w[0]);
+        AddBoneLanesAVX(palette, influences, 1, w[1], first, sum);
+        AddBoneLanesAVX(palette, influences, 2, w[2], first, sum);
+        AddBoneLanesAVX(palette, influences, 3, w[3], first, sum);
+
+        __m256 lengthSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sum.rx, sum.rx), _mm256_mul_ps(sum.ry, sum.ry)),
+                                             _mm256_add_ps(_mm256_mul_ps(sum.rz, sum.rz), _mm256_mul_ps(sum.rw, sum.rw)));
+        __m256 inverseLength = _mm256_rsqrt_ps(lengthSquared);
+        inverseLength = _mm256_mul_ps(inverseLength, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                      _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), lengthSquared), _mm256_mul_ps(inverseLength, inverseLength))));
+        __m256 qx = _mm256_mul_ps(sum.rx, inverseLength);
+        __m256 qy = _mm256_mul_ps(sum.ry, inverseLength);
+        __m256 qz = _mm256_mul_ps(sum.rz, inverseLength);
+        __m256 qw = _mm256_mul_ps(sum.rw, inverseLength);
+        __m256 scale = _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(inverseLength, inverseLength));
+        __m256 tx = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dx), _mm256_mul_ps(sum.dw, sum.rx)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.ry, sum.dz), _mm256_mul_ps(sum.rz, sum.dy))));
+        __m256 ty = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dy), _mm256_mul_ps(sum.dw, sum.ry)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rz, sum.dx), _mm256_mul_ps(sum.rx, sum.dz))));
+        __m256 tz = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(sum.rw, sum.dz), _mm256_mul_ps(sum.dw, sum.rz)),
+                                                       _mm256_sub_ps(_mm256_mul_ps(sum.rx, sum.dy), _mm256_mul_ps(sum.ry, sum.dx))));
+
+        if (normals) {
+            __m256 v[4] = {
+                LanePair(normals[0].xmm, normals[4].xmm), LanePair(normals[1].xmm, normals[5].xmm),
+                LanePair(normals[2].xmm, normals[6].xmm), LanePair(normals[3].xmm, normals[7].xmm)
+            };
+            TransposeLanes4x4(v);
+            RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+            v[3] = _mm256_setzero_ps();
+            TransposeLanes4x4(v);
+            outNormals[0].xmm = _mm256_castps256_ps128(v[0]);
+            outNormals[1].xmm = _mm256_castps256_ps128(v[1]);
+            outNormals[2].xmm = _mm256_castps256_ps128(v[2]);
+            outNormals[3].xmm = _mm256_castps256_ps128(v[3]);
+            outNormals[4].xmm = _mm256_extractf128_ps(v[0], 1);
+            outNormals[5].xmm = _mm256_extractf128_ps(v[1], 1);
+            outNormals[6].xmm = _mm256_extractf128_ps(v[2], 1);
+            outNormals[7].xmm = _mm256_extractf128_ps(v[3], 1);
+        }
+        __m256 v[4] = {
+            LanePair(positions[0].xmm, positions[4].xmm), LanePair(positions[1].xmm, positions[5].xmm),
+            LanePair(positions[2].xmm, positions[6].xmm), LanePair(positions[3].xmm, positions[7].xmm)
+        };
+        TransposeLanes4x4(v);
+        RotateLanesAVX(qx, qy, qz, qw, v[0], v[1], v[2]);
+        v[0] = _mm256_add_ps(v[0], tx);
+        v[1] = _mm256_add_ps(v[1], ty);
+        v[2] = _mm256_add_ps(v[2], tz);
+        v[3] = _mm256_setzero_ps();
+        TransposeLanes4x4(v);
+        outPositions[0].xmm = _mm256_castps256_ps128(v[0]);
+        outPositions[1].xmm = _mm256_castps256_ps128(v[1]);
+        outPositions[2].xmm = _mm256_castps256_ps128(v[2]);
+        outPositions[3].xmm = _mm256_castps256_ps128(v[3]);
+        outPositions[4].xmm = _mm256_extractf128_ps(v[0], 1);
+        outPositions[5].xmm = _mm256_extractf128_ps(v[1], 1);
+        outPositions[6].xmm = _mm256_extractf128_ps(v[2], 1);
+        outPositions[7].xmm = _mm256_extractf128_ps(v[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesDualQuaternionAVX(const DualQuaternion* palette, const Skinning::Influences* influences, const Vector3* positions,
+                                                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            SkinDualQuaternionEight(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr);
+        }
+        _mm256_zeroupper();
+        if (i < n) {
+            SkinVerticesDualQuaternion(palette, influences + i, positions + i, normals ? normals + i : nullptr, outPositions + i, normals ? outNormals + i : nullptr, n - i);
+        }
+    }
+}
+#endif
+
+XOMATH_END_XO_NS();
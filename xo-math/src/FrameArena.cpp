@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    // Blocks start on a cache line, and so does the memory after each block's header.
+    _XOCONSTEXPR const size_t ArenaBlockAlign = 64;
+    _XOCONSTEXPR const size_t ArenaHeaderSize = 64;
+    _XOCONSTEXPR const size_t ArenaHugePageSize = 2 * 1024 * 1024;
+
+    // Returns at least size bytes for an arena block, and sets size to how many. When hugePages is true the block
+    // is asked to be backed by huge pages, and hugePages is set to whether that was done. pageAligned is set to
+    // whether the block must be freed with free rather than AlignedFree.
+    _XOSRCINL void* AllocateArenaBlock(size_t& size, bool& hugePages, bool& pageAligned) {
+        pageAligned = false;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages) {
+            // transparent huge pages only back whole, aligned huge pages, so the block is made of them. The
+            // kernel may still use ordinary pages, such as when huge pages are disabled or memory is fragmented.
+            size_t rounded = (size + ArenaHugePageSize - 1) & ~(ArenaHugePageSize - 1);
+            void* p = nullptr;
+            if (posix_memalign(&p, ArenaHugePageSize, rounded) == 0) {
+                hugePages = madvise(p, rounded, MADV_HUGEPAGE) == 0;
+                pageAligned = true;
+                size = rounded;
+                return p;
+            }
+        }
+#endif
+        hugePages = false;
+        return AlignedMalloc(size, ArenaBlockAlign);
+    }
+
+    _XOSRCINL void FreeArenaBlock(void* p, bool pageAligned) {
+        if (pageAligned) {
+            free(p);
+        }
+        else {
+            AlignedFree(p, ArenaBlockAlign);
+        }
+    }
+}
+
+_XOSRCINL FrameArena::FrameArena() :
+    FrameArena(DefaultBlockSize)
+{
+}
+
+_XOSRCINL FrameArena::FrameArena(size_t blockSize, bool hugePages) :
+    current(nullptr),
+    cursor(nullptr),
+    end(nullptr),
+    blockSize(blockSize),
+    used(0),
+    peak(0),
+    capacity(0),
+    blockCount(0),
+    allocationCount(0),
+    wantHugePages(hugePages),
+    hugePages(false)
+{
+}
+
+_XOSRCINL FrameArena::~FrameArena() {
+    FreeBlocks();
+}
+
+_XOSRCINL void* FrameArena::AllocateFromNewBlock(size_t size, size_t align) {
+    // the memory after a header is aligned to ArenaBlockAlign, so only larger alignments need room to pad.
+    size_t padding = align > xo_internal::ArenaBlockAlign ? align : 0;
+    if (size > ~(size_t)0 / 2 || !NewBlock(size + padding)) {
+        return nullptr;
+    }
+    return Allocate(size, align);
+}
+
+_XOSRCINL FrameArena::Block* FrameArena::NewBlock(size_t size) {
+    static_assert(sizeof(Block) <= xo_internal::ArenaHeaderSize, "FrameArena::Block doesn't fit its header.");
+    size_t bytes = xo_internal::ArenaHeaderSize + (size > blockSize ? size : blockSize);
+    bool huge = wantHugePages, pageAligned;
+    void* memory = xo_internal::AllocateArenaBlock(bytes, huge, pageAligned);
+    if (!memory) {
+        return nullptr;
+    }
+    Block* block = (Block*)memory;
+    block->previous = current;
+    block->size = bytes;
+    block->pageAligned = pageAligned;
+    current = block;
+    cursor = (char*)memory + xo_internal::ArenaHeaderSize;
+    end = (char*)memory + bytes;
+    capacity += bytes - xo_internal::ArenaHeaderSize;
+    ++blockCount;
+    hugePages = huge;
+    return block;
+}
+
+_XOSRCINL void FrameArena::FreeBlocks() {
+    while (current) {
+        Block* previous = current->previous;
+        xo_internal::FreeArenaBlock(current, current->pageAligned);
+        current = previous;
+    }
+    cursor = end = nullptr;
+    capacity = 0;
+    blockCount = 0;
+    hugePages = false;
+}
+
+_XOSRCINL void FrameArena::Reset() {
+    if (blockCount > 1) {
+        // one block big enough for the whole frame, so the next frame like it doesn't chain.
+        size_t total = capacity;
+        FreeBlocks();
+        NewBlock(total);
+    }
+    else if (current) {
+        cursor = (char*)current + xo_internal::ArenaHeaderSize;
+    }
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL void FrameArena::Release() {
+    FreeBlocks();
+    used = 0;
+    allocationCount = 0;
+}
+
+_XOSRCINL FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats;
+    stats.used = used;
+    stats.peak = peak;
+    stats.capacity = capacity;
+    stats.blockCount = blockCount;
+    stats.allocationCount = allocationCount;
+    stats.hugePages = hugePages;
+    return stats;
+}
+
+_XOSRCINL FrameArena& FrameArena::ThreadArena() {
+#if defined(_XO_NO_TLS)
+    // thread local objects need a trivial constructor here, so this arena is never destroyed, and its blocks
+    // aren't freed when the thread exits. See the ThreadArena documentation.
+    static _XOTLS FrameArena* tlsArena;
+    static _XOTLS void* mem[(sizeof(FrameArena) + sizeof(void*) - 1) / sizeof(void*)];
+    if (!tlsArena) {
+        tlsArena = new(mem) FrameArena();
+    }
+    return *tlsArena;
+#else
+    static _XOTLS FrameArena tlsArena;
+    return tlsArena;
+#endif
+}
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,374 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    union FloatBits {
+        float f;
+        uint32_t u;
+    };
+}
+
+_XOSRCINL uint16_t FloatToHalf(float f) {
+    xo_internal::FloatBits bits;
+    bits.f = f;
+    const uint32_t sign = bits.u & 0x80000000u;
+    bits.u ^= sign;
+    uint16_t o;
+    if (bits.u >= 0x47800000u) {
+        // 65520 and up rounds to infinity. NaN stays NaN, as a quiet NaN.
+        o = bits.u > 0x7f800000u ? 0x7e00 : 0x7c00;
+    }
+    else if (bits.u < 0x38800000u) {
+        // Below the smallest normal half, so a denormal or zero. Adding 0.5 moves the half's mantissa to the bottom
+        // bits of the float's, and the float add does the rounding.
+        bits.f += 0.5f;
+        o = (uint16_t)(bits.u - 0x3f000000u);
+    }
+    else {
+        // Rebias the exponent from 127 to 15, then round off the low 13 bits of the mantissa with ties to even. A
+        // carry out of the mantissa correctly bumps the exponent, up to infinity.
+        const uint32_t mantissaOdd = (bits.u >> 13) & 1u;
+        bits.u += 0xc8000fffu + mantissaOdd;
+        o = (uint16_t)(bits.u >> 13);
+    }
+    return (uint16_t)(o | (sign >> 16));
+}
+
+_XOSRCINL float HalfToFloat(uint16_t h) {
+    xo_internal::FloatBits o;
+    o.u = (uint32_t)(h & 0x7fff) << 13;
+    const uint32_t exponent = o.u & 0x0f800000u;
+    o.u += 0x38000000u;
+    if (exponent == 0x0f800000u) {
+        // Infinity or NaN, which take the largest exponent.
+        o.u += 0x38000000u;
+    }
+    else if (exponent == 0) {
+        // A denormal. Given the smallest normal exponent it's 2^-14 too big, which a float subtract takes off. Both
+        // operands and the result are normal floats, so the SSE denormal modes don't change it.
+        o.u += 0x00800000u;
+        o.f -= HexFloat(0x38800000u);
+    }
+    o.u |= (uint32_t)(h & 0x8000) << 16;
+    return o.f;
+}
+
+_XOSRCINL Half2::Half2(const Vector2& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y))
+{
+}
+
+_XOSRCINL Half2::operator Vector2() const {
+    return Vector2(HalfToFloat(x), HalfToFloat(y));
+}
+
+_XOSRCINL Half3::Half3(const Vector3& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z))
+{
+}
+
+_XOSRCINL Half3::operator Vector3() const {
+    return Vector3(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z));
+}
+
+_XOSRCINL Half4::Half4(const Vector4& v) :
+    x(FloatToHalf(v.x)),
+    y(FloatToHalf(v.y)),
+    z(FloatToHalf(v.z)),
+    w(FloatToHalf(v.w))
+{
+}
+
+_XOSRCINL Half4::operator Vector4() const {
+    return Vector4(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z), HalfToFloat(w));
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE2)
+    // FloatToHalf of four floats. Each lane holds its half sign extended to 32 bits, so _mm_packs_epi32 narrows
+    // two of these to eight halves without saturating.
+    _XOINL __m128i FloatToHalfSSE2(__m128 f) {
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+        __m128 sign = _mm_and_ps(f, signMask);
+        __m128 absolute = _mm_xor_ps(f, sign);
+        __m128i bits = _mm_castps_si128(absolute);
+        // Without the sign, the bits compare as signed ints in the same order as the floats.
+        __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+        __m128i isDenormal = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+        __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+        __m128i infOrNaN = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+        __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+        // -1 where bit 13 is set, which is subtracted to add it.
+        __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+        __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32((int)0xc8000fffu)), mantissaOdd), 13);
+        __m128i finite = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+        __m128i o = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN));
+        return _mm_or_si128(o, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+
+    // HalfToFloat of four halves, one zero extended in each 32 bit lane.
+    _XOINL __m128 HalfToFloatSSE2(__m128i h) {
+        __m128i magnitude = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, magnitude), 16);
+        __m128i o = _mm_slli_epi32(magnitude, 13);
+        __m128i exponent = _mm_and_si128(o, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_set1_epi32(0x38000000));
+        __m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+        o = _mm_add_epi32(o, _mm_and_si128(isInfOrNaN, _mm_set1_epi32(0x38000000)));
+        __m128i isDenormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+        __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(0x00800000))), _mm_set1_ps(HexFloat(0x38800000u))));
+        o = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, o));
+        return _mm_castsi128_ps(_mm_or_si128(o, sign));
+    }
+#endif
+
+    // The baseline kernels behind ToHalf and FromHalf. Element i's components are in[i * inStride] onward, so
+    // a stride of 4 with 2 or 3 components is a padded Vector2 or Vector3. When the stride is the component count
+    // the arrays are one run of floats. Anything that isn't a whole vector's worth goes through FloatToHalf or
+    // HalfToFloat, which give the same bits as the vector code.
+    _XOSRCINL void FloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i a = FloatToHalfSSE2(_mm_loadu_ps(in + i));
+                __m128i b = FloatToHalfSSE2(_mm_loadu_ps(in + i + 4));
+                _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // Each element's four halves are stored 8 bytes at a time, and the fourth is overwritten by the next
+            // element. The last two elements are left to the loop below so nothing is written past the end.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_packs_epi32(FloatToHalfSSE2(_mm_loadu_ps(in + i * 4)), FloatToHalfSSE2(_mm_loadu_ps(in + i * 4 + 4)));
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm_packs_epi32(FloatToHalfSSE2(ab), FloatToHalfSSE2(cd)));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalf(in[i * inStride + k]);
+            }
+        }
+    }
+
+    // The w of a padded Vector3 is written as zero.
+    _XOSRCINL void HalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+#if defined(XO_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        if (components == 1) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i));
+                _mm_storeu_ps(out + i, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+                _mm_storeu_ps(out + i + 4, HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero)));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // Each load takes the next element's first half as well, which is masked off to give a w of zero.
+            // The last element is left to the loop below so nothing is read past the end.
+            const __m128i xyzMask = _mm_set_epi32(0, 0, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 1 < n; ++i) {
+                __m128i h = _mm_and_si128(_mm_loadl_epi64((const __m128i*)(in + i * 3)), xyzMask);
+                _mm_storeu_ps(out + i * 4, HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128i h = _mm_loadu_si128((const __m128i*)(in + i * 2));
+                __m128 ab = HalfToFloatSSE2(_mm_unpacklo_epi16(h, zero));
+                __m128 cd = HalfToFloatSSE2(_mm_unpackhi_epi16(h, zero));
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloat(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX2)
+namespace xo_internal
+{
+    // F16C's own conversions of one value, for the elements that don't fill a register. They round the same way
+    // as the wide ones, which is the same as FloatToHalf.
+    _XOINL _XO_TARGET_AVX2 uint16_t FloatToHalfF16C(float f) {
+        return (uint16_t)_mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(f), _MM_FROUND_TO_NEAREST_INT), 0);
+    }
+
+    _XOINL _XO_TARGET_AVX2 float HalfToFloatF16C(uint16_t h) {
+        return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(h)));
+    }
+
+    // FloatToHalfArray with F16C, eight floats per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void FloatToHalfArrayF16C(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+        if (inStride == components) {
+            n *= components;
+            inStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+                _mm_storeu_si128((__m128i*)(out + i + 8), _mm256_cvtps_ph(_mm256_loadu_ps(in + i + 8), _MM_FROUND_TO_NEAREST_INT));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        else if (components == 3 && inStride == 4) {
+            // As FloatToHalfArray, with both elements in one conversion.
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i * 4), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storel_epi64((__m128i*)(out + i * 3), h);
+                _mm_storel_epi64((__m128i*)(out + i * 3 + 3), _mm_unpackhi_epi64(h, h));
+            }
+        }
+        else if (components == 2 && inStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4)), (const __m64*)(in + i * 4 + 4));
+                __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + i * 4 + 8)), (const __m64*)(in + i * 4 + 12));
+                __m256 f = _mm256_insertf128_ps(_mm256_castps128_ps256(ab), cd, 1);
+                _mm_storeu_si128((__m128i*)(out + i * 2), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * components + k] = FloatToHalfF16C(in[i * inStride + k]);
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    // HalfToFloatArray with F16C, eight halves per conversion.
+    _XOSRCINL _XO_TARGET_AVX2 void HalfToFloatArrayF16C(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+        if (outStride == components) {
+            n *= components;
+            outStride = components = 1;
+        }
+        size_t i = 0;
+        if (components == 1) {
+            for (; i + 16 <= n; i += 16) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+                _mm256_storeu_ps(out + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i + 8))));
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+            }
+        }
+        else if (components == 3 && outStride == 4) {
+            // As HalfToFloatArray, two elements per conversion. The second load reads into a third element, which
+            // must exist.
+            const __m128i xyzMask = _mm_set_epi32(0x0000ffff, (int)0xffffffffu, 0x0000ffff, (int)0xffffffffu);
+            for (; i + 2 < n; i += 2) {
+                __m128i h = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(in + i * 3)), _mm_loadl_epi64((const __m128i*)(in + i * 3 + 3)));
+                _mm256_storeu_ps(out + i * 4, _mm256_cvtph_ps(_mm_and_si128(h, xyzMask)));
+            }
+        }
+        else if (components == 2 && outStride == 4) {
+            for (; i + 4 <= n; i += 4) {
+                __m256 f = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i * 2)));
+                __m128 ab = _mm256_castps256_ps128(f);
+                __m128 cd = _mm256_extractf128_ps(f, 1);
+                _mm_storel_pi((__m64*)(out + i * 4), ab);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 4), ab);
+                _mm_storel_pi((__m64*)(out + i * 4 + 8), cd);
+                _mm_storeh_pi((__m64*)(out + i * 4 + 12), cd);
+            }
+        }
+        for (; i < n; ++i) {
+            for (size_t k = 0; k < components; ++k) {
+                out[i * outStride + k] = HalfToFloatF16C(in[i * components + k]);
+            }
+            if (components == 3 && outStride == 4) {
+                out[i * 4 + 3] = 0.0f;
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+namespace xo_internal
+{
+    _XOSRCINL void DispatchFloatToHalfArray(const float* in, size_t inStride, uint16_t* out, size_t components, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().floatToHalfArray(in, inStride, out, components, n);
+#else
+        FloatToHalfArray(in, inStride, out, components, n);
+#endif
+    }
+
+    _XOSRCINL void DispatchHalfToFloatArray(const uint16_t* in, size_t components, float* out, size_t outStride, size_t n) {
+#if defined(XO_SSE2)
+        GetDispatchKernels().halfToFloatArray(in, components, out, outStride, n);
+#else
+        HalfToFloatArray(in, components, out, outStride, n);
+#endif
+    }
+}
+
+_XOSRCINL void ToHalf(const float* in, uint16_t* out, size_t n)      { xo_internal::DispatchFloatToHalfArray(in, 1, out, 1, n); }
+_XOSRCINL void ToHalf(const Vector2* in, Half2* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector2) / sizeof(float), (uint16_t*)out, 2, n); }
+_XOSRCINL void ToHalf(const Vector3* in, Half3* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector3) / sizeof(float), (uint16_t*)out, 3, n); }
+_XOSRCINL void ToHalf(const Vector4* in, Half4* out, size_t n)       { xo_internal::DispatchFloatToHalfArray((const float*)in, sizeof(Vector4) / sizeof(float), (uint16_t*)out, 4, n); }
+_XOSRCINL void FromHalf(const uint16_t* in, float* out, size_t n)    { xo_internal::DispatchHalfToFloatArray(in, 1, out, 1, n); }
+_XOSRCINL void FromHalf(const Half2* in, Vector2* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 2, (float*)out, sizeof(Vector2) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half3* in, Vector3* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 3, (float*)out, sizeof(Vector3) / sizeof(float), n); }
+_XOSRCINL void FromHalf(const Half4* in, Vector4* out, size_t n)     { xo_internal::DispatchHalfToFloatArray((const uint16_t*)in, 4, (float*)out, sizeof(Vector4) / sizeof(float), n); }
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,290 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    // Holds each of count threads in Wait until all of them have called it. Levels are short enough that
+    // spinning is cheaper than sleeping on a condition variable.
+    class SpinBarrier {
+    public:
+        explicit SpinBarrier(unsigned count) : count(count), waiting(0), generation(0) {
+        }
+
+        void Wait() {
+            unsigned gen = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                waiting.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            else {
+                while (generation.load(std::memory_order_acquire) == gen) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        const unsigned count;
+        std::atomic<unsigned> waiting;
+        std::atomic<unsigned> generation;
+    };
+
+    // Fewer nodes than this in a level aren't split between threads.
+    _XOSRCINL size_t HierarchyMinNodesPerThread() {
+        return 256;
+    }
+}
+
+_XOSRCINL Hierarchy::Hierarchy() :
+    firstChangedLevel(NothingChanged),
+    sorted(true)
+{
+}
+
+_XOSRCINL void Hierarchy::Reserve(size_t nodeCount) {
+    parents.reserve(nodeCount);
+    depths.reserve(nodeCount);
+    slots.reserve(nodeCount);
+    parentSlots.reserve(nodeCount);
+    locals.reserve(nodeCount);
+    worlds.reserve(nodeCount);
+    changed.reserve(nodeCount);
+}
+
+_XOSRCINL void Hierarchy::Clear() {
+    parents.clear();
+    depths.clear();
+    slots.clear();
+    parentSlots.clear();
+    locals.clear();
+    worlds.clear();
+    changed.clear();
+    levels.clear();
+    firstChangedLevel = NothingChanged;
+    sorted = true;
+}
+
+_XOSRCINL int Hierarchy::AddNode(int parent, const Matrix4x4& local) {
+    XO_ASSERT(parent == NoParent || (parent >= 0 && (size_t)parent < parents.size()), "The parent must be added before its children.");
+    int node = (int)parents.size();
+    int depth = parent == NoParent ? 0 : depths[parent] + 1;
+    parents.push_back(parent);
+    depths.push_back(depth);
+    // Stored at the end until the next update sorts it into its level.
+    slots.push_back((int)locals.size());
+    parentSlots.push_back(NoParent);
+    locals.push_back(local);
+    worlds.push_back(local);
+    changed.push_back(1);
+    if ((size_t)depth < firstChangedLevel) {
+        firstChangedLevel = (size_t)depth;
+    }
+    sorted = false;
+    return node;
+}
+
+_XOSRCINL void Hierarchy::Sort() {
+    const size_t n = parents.size();
+
+    // The children of each node, in the order they were added.
+    std::vector<int> childStart(n + 1, 0);
+    std::vector<int> children(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] != NoParent) {
+            ++childStart[parents[i] + 1];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    {
+        std::vector<int> cursor(childStart.begin(), childStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (parents[i] != NoParent) {
+                children[cursor[parents[i]]++] = (int)i;
+            }
+        }
+    }
+
+    // Breadth first from the roots, which puts each level after the one above it, with siblings together and
+    // in the order of their parents.
+    std::vector<int> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (parents[i] == NoParent) {
+            order.push_back((int)i);
+        }
+    }
+    levels.clear();
+    levels.push_back(0);
+    size_t levelEnd = order.size();
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == levelEnd) {
+            levels.push_back(i);
+            levelEnd = order.size();
+        }
+        int node = order[i];
+        for (int c = childStart[node]; c < childStart[node + 1]; ++c) {
+            order.push_back(children[c]);
+        }
+    }
+    if (n) {
+        levels.push_back(n);
+    }
+
+    std::vector<int> newParentSlots(n);
+    vector<Matrix4x4> newLocals(n);
+    vector<Matrix4x4> newWorlds(n);
+    std::vector<unsigned char> newChanged(n);
+    firstChangedLevel = NothingChanged;
+    for (size_t slot = 0; slot < n; ++slot) {
+        int node = order[slot];
+        int oldSlot = slots[node];
+        newLocals[slot] = locals[oldSlot];
+        newWorlds[slot] = worlds[oldSlot];
+        newChanged[slot] = changed[oldSlot];
+        // The parent comes earlier in the order, so its slot is already set.
+        newParentSlots[slot] = parents[node] == NoParent ? NoParent : slots[parents[node]];
+        slots[node] = (int)slot;
+        if (newChanged[slot] && (size_t)depths[node] < firstChangedLevel) {
+            firstChangedLevel = (size_t)depths[node];
+        }
+    }
+    parentSlots.swap(newParentSlots);
+    locals.swap(newLocals);
+    worlds.swap(newWorlds);
+    changed.swap(newChanged);
+    sorted = true;
+}
+
+_XOSRCINL void Hierarchy::BeginUpdate() {
+    if (!sorted) {
+        Sort();
+    }
+}
+
+_XOSRCINL void Hierarchy::GetLevelRange(size_t level, size_t& begin, size_t& end) const {
+    end = levels[level + 1];
+    begin = level < firstChangedLevel ? end : levels[level];
+}
+
+_XOSRCINL void Hierarchy::UpdateRange(size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (parentSlots[begin] == NoParent) {
+        // The first level, which is only roots.
+        for (size_t i = begin; i < end; ++i) {
+            if (changed[i]) {
+                worlds[i] = locals[i];
+            }
+        }
+        return;
+    }
+    // A node has changed when it or its parent has, and its parent's flag was settled by the level above.
+    // Each run of changed nodes is one batch.
+    size_t i = begin;
+    while (i < end) {
+        while (i < end && !(changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        size_t run = i;
+        while (i < end && (changed[i] |= changed[parentSlots[i]])) {
+            ++i;
+        }
+        if (i > run) {
+            Matrix4x4::MultiplyBatch(worlds.data(), parentSlots.data() + run, locals.data() + run, worlds.data() + run, i - run);
+        }
+    }
+}
+
+_XOSRCINL void Hierarchy::EndUpdate() {
+    if (firstChangedLevel < GetLevelCount()) {
+        std::fill(changed.begin() + levels[firstChangedLevel], changed.end(), (unsigned char)0);
+    }
+    firstChangedLevel = NothingChanged;
+}
+
+_XOSRCINL void Hierarchy::UpdateWorld(unsigned threadCount) {
+    BeginUpdate();
+    const size_t levelCount = GetLevelCount();
+    if (firstChangedLevel >= levelCount) {
+        return;
+    }
+
+    // No more threads than there are cores, or than there's work for.
+    const size_t minNodes = xo_internal::HierarchyMinNodesPerThread();
+    const size_t work = levels[levelCount] - levels[firstChangedLevel];
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (cores && threadCount > cores) {
+        threadCount = cores;
+    }
+    if (threadCount > work / minNodes) {
+        threadCount = (unsigned)(work / minNodes);
+    }
+
+    if (threadCount <= 1) {
+        for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+            size_t begin, end;
+            GetLevelRange(level, begin, end);
+            UpdateRange(begin, end);
+        }
+    }
+    else {
+        xo_internal::SpinBarrier barrier(threadCount);
+        auto run = [this, &barrier, threadCount, levelCount, minNodes](unsigned thread) {
+            for (size_t level = firstChangedLevel; level < levelCount; ++level) {
+                size_t begin, end;
+                GetLevelRange(level, begin, end);
+                size_t count = end - begin;
+                if (count < minNodes * 2) {
+                    if (thread == 0) {
+                        UpdateRange(begin, end);
+                    }
+                }
+                else {
+                    size_t chunk = (count + threadCount - 1) / threadCount;
+                    size_t first = begin + std::min(count, chunk * thread);
+                    size_t last = begin + std::min(count, chunk * (thread + 1));
+                    UpdateRange(first, last);
+                }
+                barrier.Wait();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run, t);
+        }
+        run(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    EndUpdate();
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,214 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                               Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+
+_XOSRCDATA const Matrix3x4 Matrix3x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                           Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+_XOSRCINL Matrix3x4::Matrix3x4() {
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float m) {
+    r[0].Set(m);
+    r[1].Set(m);
+    r[2].Set(m);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2) {
+    r[0].Set(a0, b0, c0, d0);
+    r[1].Set(a1, b1, c1, d1);
+    r[2].Set(a2, b2, c2, d2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2) {
+    r[0].Set(r0);
+    r[1].Set(r1);
+    r[2].Set(r2);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Matrix4x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q) {
+    // Points are transformed as column vectors, so this is the transpose of the upper left 3x3 of
+    // Matrix4x4(const Quaternion&), which is laid out for row vectors.
+    Vector4 v4(q.x, q.y, q.z, q.w);
+    Vector4 q2 = v4 + v4;
+
+    Vector4 qq2 = v4 * q2;
+    Vector4 wq2 = q2 * q.w;
+
+    float xy2 = q.x * q2.y;
+    float xz2 = q.x * q2.z;
+    float yz2 = q.y * q2.z;
+
+    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 - wq2.z,            xz2 + wq2.y,          0.0f);
+    r[1].Set( xy2 + wq2.z,           1.0f - qq2.x - qq2.z,   yz2 - wq2.x,          0.0f);
+    r[2].Set( xz2 - wq2.y,           yz2 + wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
+}
+
+_XOSRCINL Matrix3x4::Matrix3x4(const Quaternion& q, const Vector3& translation) :
+    Matrix3x4(q)
+{
+    SetTranslation(translation);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+    // The batch kernels take the full matrix, which costs one 64 byte copy per array.
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformPoints(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Matrix3x4& Matrix3x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+    Matrix4x4(*this).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL float Matrix3x4::Determinant() const {
+    return Vector3::Dot(Vector3(r[0]), Vector3::Cross(Vector3(r[1]), Vector3(r[2])));
+}
+
+namespace xo_internal
+{
+    // Writes the adjugate of the upper left 3x3 of m, with the translation of the inverse scaled by the same
+    // determinant, to out, and returns the determinant. The adjugate's columns are the cross products of the rows.
+    _XOINL float AffineAdjugate(const Matrix3x4& m, Matrix3x4& out) {
+#if defined(XO_SSE)
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        // the w of each cross product is w*w - w*w, so the translations drop out as zeros.
+        auto cross = [](__m128 a, __m128 b) {
+            return _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+        };
+        __m128 c0 = cross(r1, r2);
+        __m128 c1 = cross(r2, r0);
+        __m128 c2 = cross(r0, r1);
+        // -(adj * t) is the combination of the columns weighted by the translation.
+        __m128 t = sse::LinearCombination(_mm_shuffle_ps(_mm_unpackhi_ps(r0, r1), r2, _MM_SHUFFLE(3, 3, 3, 2)), c0, c1, c2, _mm_setzero_ps());
+        __m128 c3 = _mm_sub_ps(_mm_setzero_ps(), t);
+        float det = Vector4(_mm_mul_ps(r0, c0)).Sum();
+        // the columns become the rows of the inverse, with the translation in w.
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        out.r[0].xmm = c0;
+        out.r[1].xmm = c1;
+        out.r[2].xmm = c2;
+        return det;
+#else
+        Vector3 c0, c1, c2;
+        Vector3::Cross(Vector3(m.r[1]), Vector3(m.r[2]), c0);
+        Vector3::Cross(Vector3(m.r[2]), Vector3(m.r[0]), c1);
+        Vector3::Cross(Vector3(m.r[0]), Vector3(m.r[1]), c2);
+        Vector3 c3 = -(c0 * m.m03 + c1 * m.m13 + c2 * m.m23);
+        // out may be m, so the determinant is taken before any rows are written.
+        float det = Vector3::Dot(Vector3(m.r[0]), c0);
+        out.r[0].Set(c0.x, c1.x, c2.x, c3.x);
+        out.r[1].Set(c0.y, c1.y, c2.y, c3.y);
+        out.r[2].Set(c0.z, c1.z, c2.z, c3.z);
+        return det;
+#endif
+    }
+
+    _XOINL void ScaleAffineAdjugate(Matrix3x4& m, float det) {
+        float s = 1.0f / det;
+        m.r[0] *= s;
+        m.r[1] *= s;
+        m.r[2] *= s;
+    }
+}
+
+_XOSRCINL void Matrix3x4::MakeInverse() {
+    float det = xo_internal::AffineAdjugate(*this, *this);
+    xo_internal::ScaleAffineAdjugate(*this, det);
+}
+
+_XOSRCINL bool Matrix3x4::TryMakeInverse() {
+    Matrix3x4 adj;
+    float det = xo_internal::AffineAdjugate(*this, adj);
+    if (det == 0.0f) {
+        return false;
+    }
+    xo_internal::ScaleAffineAdjugate(adj, det);
+    *this = adj;
+    return true;
+}
+
+_XOSRCINL void Matrix3x4::Scale(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(v.x, 0.0f, 0.0f, 0.0f);
+    outMatrix.r[1].Set(0.0f, v.y, 0.0f, 0.0f);
+    outMatrix.r[2].Set(0.0f, 0.0f, v.z, 0.0f);
+}
+
+_XOSRCINL void Matrix3x4::Translation(const Vector3& v, Matrix3x4& outMatrix) {
+    outMatrix.r[0].Set(1.0f, 0.0f, 0.0f, v.x);
+    outMatrix.r[1].Set(0.0f, 1.0f, 0.0f, v.y);
+    outMatrix.r[2].Set(0.0f, 0.0f, 1.0f, v.z);
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Scale(const Vector3& v) {
+    Matrix3x4 m;
+    Scale(v, m);
+    return m;
+}
+
+_XOSRCINL Matrix3x4 Matrix3x4::Translation(const Vector3& v) {
+    Matrix3x4 m;
+    Translation(v, m);
+    return m;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
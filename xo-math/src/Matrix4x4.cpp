@@ -22,29 +22,29 @@
 #define _XO_MATH_OBJ
 #include "xo-math.h"
 
-#define _XO_ASSERT_MSG(msg) "xo-math Matrix4x4" msg
-
 XOMATH_BEGIN_XO_NS();
 
-const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+#define _XO_ASSERT_MSG(msg) "xo-math Matrix4x4" msg
+
+_XOSRCDATA const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
                                     Vector4(0.0f, 1.0f, 0.0f, 0.0f),
                                     Vector4(0.0f, 0.0f, 1.0f, 0.0f),
                                     Vector4(0.0f, 0.0f, 0.0f, 1.0f));
 
-const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+_XOSRCDATA const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f),
                                Vector4(1.0f, 1.0f, 1.0f, 1.0f));
 
-const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+_XOSRCDATA const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f),
                                 Vector4(0.0f, 0.0f, 0.0f, 0.0f));
 
-Matrix4x4::Matrix4x4() {
+_XOSRCINL Matrix4x4::Matrix4x4() {
 }
 
-Matrix4x4::Matrix4x4(float m)
+_XOSRCINL Matrix4x4::Matrix4x4(float m)
 #if defined(XO_SSE)
 { 
     r[0].xmm = r[1].xmm = r[2].xmm = r[3].xmm = _mm_set_ps1(m);
@@ -58,7 +58,7 @@ Matrix4x4::Matrix4x4(float m)
 }
 #endif
 
-Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
+_XOSRCINL Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
 {
     r[0].Set(a0, b0, c0, d0);
     r[1].Set(a1, b1, c1, d1);
@@ -67,7 +67,7 @@ Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1,
 }
 
 // TODO: couldn't this be faster with just a single copy?
-Matrix4x4::Matrix4x4(const Matrix4x4& m)
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix4x4& m)
 {
 	r[0].Set(m.r[0]);
 	r[1].Set(m.r[1]);
@@ -75,7 +75,7 @@ Matrix4x4::Matrix4x4(const Matrix4x4& m)
 	r[3].Set(m.r[3]);
 }
 
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
 {
 	r[0].Set(r0);
 	r[1].Set(r1);
@@ -83,7 +83,7 @@ Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, co
 	r[3].Set(r3);
 }
 
-Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
+_XOSRCINL Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
 {
 	r[0].Set(r0);
 	r[1].Set(r1);
@@ -91,11 +91,20 @@ Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
 	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-Matrix4x4::Matrix4x4(const class Quaternion& q) {
-    Vector4* v4 = (Vector4*)&q;
-    Vector4 q2 = *v4 + *v4;
+_XOSRCINL Matrix4x4::Matrix4x4(const Matrix3x4& m)
+{
+	r[0].Set(m.r[0]);
+	r[1].Set(m.r[1]);
+	r[2].Set(m.r[2]);
+	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+_XOSRCINL Matrix4x4::Matrix4x4(const class Quaternion& q) {
+    // A copy rather than a cast pointer, which the compiler may assume can't alias q.
+    Vector4 v4(q);
+    Vector4 q2 = v4 + v4;
 
-    Vector4 qq2 = (*v4) * q2;
+    Vector4 qq2 = v4 * q2;
     Vector4 wq2 = q2 * q.w;
 
     float xy2 = q.x * q2.y;
@@ -108,15 +117,15 @@ Matrix4x4::Matrix4x4(const class Quaternion& q) {
     r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-const Vector4& Matrix4x4::GetRow(int i) const {
+_XOSRCINL const Vector4& Matrix4x4::GetRow(int i) const {
     return r[i];
 }
 
-Vector4 Matrix4x4::GetColumn(int i) const {
+_XOSRCINL Vector4 Matrix4x4::GetColumn(int i) const {
     return Vector4(r[0][i], r[1][i], r[2][i], r[3][i]);
 }
 
-namespace
+namespace xo_internal
 {
 #if defined(XO_SSE)
     _XOINL void EarlyInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
@@ -214,6 +223,77 @@ namespace
         _mm_storel_pi((__m64*)(m + 12), minor3);
         _mm_storeh_pi((__m64*)(m + 14), minor3);
     }
+
+#   if defined(XO_AVX)
+    _XOINL __m256 RowPair(__m128 lo, __m128 hi) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    // The cofactor expansion of EarlyInverse, regrouped for AVX.
+    // EarlyInverse forms six products of row pairs, and builds each minor from two terms per product. Expanding 
+    // those terms, every pair of terms reduces to a row times d = swap(t) - t, where t is the product with 
+    // neighbouring elements swapped and swap exchanges the two halves of the register. With dN from the Nth 
+    // product, and rNs being rN with its halves swapped:
+    //      minor0 =  r1*d1  - r3*d2  - r2s*d3
+    //      minor1 = -r0s*d1 + r2s*d5 - r3*d6
+    //      minor2 =  r0s*d3 + r3*d4  - r1*d5
+    //      minor3 =  r0s*d2 - r2s*d4 + r1*d6
+    // Two products or minors share each 256 bit register, for 9 multiplies where EarlyInverse has 30 of half the width.
+    // Rows 0 and 1 of the inverse (before the division by the determinant) are written to minors01, and rows 2 
+    // and 3 to minors23. Returns the determinant in every element.
+    _XOINL __m128 InverseMinorsAVX(const float m[16], __m256& minors01, __m256& minors23) {
+        // Loads the transpose as EarlyInverse does, which leaves row1 and row3 with their halves swapped.
+        __m128 tmp1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m)), (const __m64*)(m + 4));
+        __m128 row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 8)), (const __m64*)(m + 12));
+        __m128 row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(m + 2)), (const __m64*)(m + 6));
+        __m128 row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 10)), (const __m64*)(m + 14));
+        __m128 row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+        __m128 row0s = _mm_shuffle_ps(row0, row0, 0x4E);
+        __m128 row1s = _mm_shuffle_ps(row1, row1, 0x4E);
+        __m128 row2s = _mm_shuffle_ps(row2, row2, 0x4E);
+
+        // products 1 and 4, 2 and 5, 3 and 6.
+        __m256 d14 = _mm256_mul_ps(RowPair(row2, row0), RowPair(row3, row1));
+        __m256 d25 = _mm256_mul_ps(RowPair(row1, row0), RowPair(row2, row3));
+        __m256 d36 = _mm256_mul_ps(RowPair(row1s, row0), RowPair(row3, row2s));
+        d14 = _mm256_shuffle_ps(d14, d14, 0xB1);
+        d25 = _mm256_shuffle_ps(d25, d25, 0xB1);
+        d36 = _mm256_shuffle_ps(d36, d36, 0xB1);
+        d14 = _mm256_sub_ps(_mm256_shuffle_ps(d14, d14, 0x4E), d14);
+        d25 = _mm256_sub_ps(_mm256_shuffle_ps(d25, d25, 0x4E), d25);
+        d36 = _mm256_sub_ps(_mm256_shuffle_ps(d36, d36, 0x4E), d36);
+
+        const __m256 negateHigh = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+        __m256 r1r0s = RowPair(row1, row0s);
+        __m256 r3r2s = RowPair(row3, row2s);
+        __m256 d11 = _mm256_permute2f128_ps(d14, d14, 0x00);
+        __m256 d44 = _mm256_permute2f128_ps(d14, d14, 0x11);
+        __m256 d52 = _mm256_permute2f128_ps(d25, d25, 0x01);
+        minors01 = _mm256_sub_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r1r0s, d11), _mm256_mul_ps(r3r2s, d25))),
+            _mm256_mul_ps(RowPair(row2s, row3), d36));
+        minors23 = _mm256_add_ps(
+            _mm256_xor_ps(negateHigh, _mm256_sub_ps(_mm256_mul_ps(r3r2s, d44), _mm256_mul_ps(r1r0s, d52))),
+            _mm256_mul_ps(RowPair(row0s, row1), d36));
+
+        __m128 det = _mm_mul_ps(row0, _mm256_castps256_ps128(minors01));
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        return _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+    }
+
+    // See LateInverse.
+    _XOINL void ScaleInverseAVX(__m128 det, __m256 minors01, __m256 minors23, float m[16]) {
+        __m128 r = _mm_rcp_ps(det);
+        r = _mm_sub_ps(_mm_add_ps(r, r), _mm_mul_ps(det, _mm_mul_ps(r, r)));
+        __m256 scale = RowPair(r, r);
+        _mm256_storeu_ps(m, _mm256_mul_ps(minors01, scale));
+        _mm256_storeu_ps(m + 8, _mm256_mul_ps(minors23, scale));
+    }
+#   endif
 #else
     _XOINL void EarlyInverse(float tmp[12], float src[16], float& det, float m[16])
     {
@@ -301,46 +381,286 @@ namespace
 #endif
 }
 
-void Matrix4x4::MakeInverse() {
-#if defined(XO_SSE)
+_XOSRCINL void Matrix4x4::MakeInverse() {
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+#elif defined(XO_SSE)
     __m128 minor0, minor1, minor2, minor3;
     __m128 row0, row1, row2, row3;
     __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
 #else
     float tmp[12]; // temp array for pairs
     float src[16]; // array of transpose source matrix
     float det; // determinant
-    EarlyInverse(tmp, src, det, m);
-    LateInverse(det, m);
+    xo_internal::EarlyInverse(tmp, src, det, m);
+    xo_internal::LateInverse(det, m);
 #endif
 }
 
-bool Matrix4x4::TryMakeInverse()
+_XOSRCINL bool Matrix4x4::TryMakeInverse()
 {
-#if defined(XO_SSE)
+#if defined(XO_AVX)
+    __m256 minors01, minors23;
+    __m128 det = xo_internal::InverseMinorsAVX(m, minors01, minors23);
+    if (_mm_cvtss_f32(det) == 0.0f)
+        return false;
+    xo_internal::ScaleInverseAVX(det, minors01, minors23, m);
+    return true;
+#elif defined(XO_SSE)
     __m128 minor0, minor1, minor2, minor3;
     __m128 row0, row1, row2, row3;
     __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    xo_internal::EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
     if (_mm_cvtss_f32(det) == 0.0f)
         return false;
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    xo_internal::LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
     return true;
 #else
     float tmp[12]; // temp array for pairs
     float src[16]; // array of transpose source matrix
     float det; // determinant
-    EarlyInverse(tmp, src, det, m);
+    // EarlyInverse writes the cofactors over its matrix, so a singular matrix is only left as is by working on a copy.
+    Matrix4x4 o(*this);
+    xo_internal::EarlyInverse(tmp, src, det, o.m);
     if (det == 0.0f)
         return false;
-    LateInverse(det, m);
+    xo_internal::LateInverse(det, o.m);
+    *this = o;
+    return true;
+#endif
+}
+
+namespace xo_internal
+{
+    // Relative tolerances for Matrix4x4::ClassifyInverse. Two columns are orthogonal when the square of their dot
+    // is within InverseOrthogonalTolerance of the product of their squared lengths, which is a cosine of about 1e-5.
+    // A column is unit length when its squared length is within InverseUnitTolerance of 1.
+    _XOCONSTEXPR const float InverseOrthogonalTolerance = 1e-10f;
+    _XOCONSTEXPR const float InverseUnitTolerance = 2e-5f;
+
+    // Gets the squared lengths of the first three columns of m in lengths, and the dots c0.c1, c1.c2 and c2.c0 in
+    // dots. The w of both is zero. The columns are down the rows, so the rows are multiplied lane by lane: each
+    // row by itself for the lengths, and by itself rotated one lane for the dots.
+#if defined(XO_SSE)
+    _XOINL void ColumnGram(const Matrix4x4& m, __m128& lengths, __m128& dots) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0 = _mm_and_ps(m.r[0].xmm, xyzMask), r1 = _mm_and_ps(m.r[1].xmm, xyzMask), r2 = _mm_and_ps(m.r[2].xmm, xyzMask);
+        __m128 s0 = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s1 = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 s2 = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1));
+        lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2));
+        dots = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, s0), _mm_mul_ps(r1, s1)), _mm_mul_ps(r2, s2));
+    }
+#else
+    _XOINL void ColumnGram(const Matrix4x4& m, Vector4& lengths, Vector4& dots) {
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        lengths.Set(c0.MagnitudeSquared(), c1.MagnitudeSquared(), c2.MagnitudeSquared(), 0.0f);
+        dots.Set(Vector3::Dot(c0, c1), Vector3::Dot(c1, c2), Vector3::Dot(c2, c0), 0.0f);
+    }
+#endif
+
+    // Inverts an affine matrix whose upper left 3x3 has orthogonal columns. Row i of the inverse 3x3 is column i
+    // divided by its squared length, which is 1 when scaled is false, and the translation is that 3x3 applied to
+    // the negated translation. out may be m.
+    _XOINL void InverseOrthogonal(const Matrix4x4& m, Matrix4x4& out, bool scaled) {
+#if defined(XO_SSE)
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        const __m128 wOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        __m128 r0 = m.r[0].xmm, r1 = m.r[1].xmm, r2 = m.r[2].xmm;
+        __m128 tx = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 ty = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 tz = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_and_ps(r0, xyzMask);
+        r1 = _mm_and_ps(r1, xyzMask);
+        r2 = _mm_and_ps(r2, xyzMask);
+        if (scaled) {
+            // the squared lengths of all three columns at once. w is made 1 so its reciprocal stays finite.
+            __m128 lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_add_ps(_mm_mul_ps(r2, r2), wOne));
+            __m128 inv = _mm_div_ps(sse::One, lengths);
+            r0 = _mm_mul_ps(r0, inv);
+            r1 = _mm_mul_ps(r1, inv);
+            r2 = _mm_mul_ps(r2, inv);
+        }
+        // once transposed r0 to r2 are the columns of the inverse 3x3, so the translation is their combination.
+        __m128 t = _mm_sub_ps(wOne, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, tx), _mm_mul_ps(r1, ty)), _mm_mul_ps(r2, tz)));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, t);
+        out.r[0].xmm = r0;
+        out.r[1].xmm = r1;
+        out.r[2].xmm = r2;
+        out.r[3].xmm = t;
+#else
+        Vector3 c0(m.m00, m.m10, m.m20), c1(m.m01, m.m11, m.m21), c2(m.m02, m.m12, m.m22);
+        Vector3 t(m.m03, m.m13, m.m23);
+        if (scaled) {
+            c0 *= 1.0f / c0.MagnitudeSquared();
+            c1 *= 1.0f / c1.MagnitudeSquared();
+            c2 *= 1.0f / c2.MagnitudeSquared();
+        }
+        out.r[0].Set(c0, -Vector3::Dot(c0, t));
+        out.r[1].Set(c1, -Vector3::Dot(c1, t));
+        out.r[2].Set(c2, -Vector3::Dot(c2, t));
+        out.r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+#endif
+    }
+}
+
+_XOSRCINL bool Matrix4x4::HasOrthonormalBasis() const {
+    // CloseEnough is relative, which nothing passes against 0, so these are absolute differences.
+#if defined(XO_SSE)
+    __m128 l, d;
+    xo_internal::ColumnGram(*this, l, d);
+    Vector4 lengths(l), dots(d);
+#else
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+#endif
+    return Abs(dots.x) <= Vector4::Epsilon && Abs(dots.y) <= Vector4::Epsilon && Abs(dots.z) <= Vector4::Epsilon &&
+           Abs(lengths.x - 1.0f) <= Vector4::Epsilon && Abs(lengths.y - 1.0f) <= Vector4::Epsilon && Abs(lengths.z - 1.0f) <= Vector4::Epsilon;
+}
+
+_XOSRCINL bool Matrix4x4::IsUnitary() const {
+    // Element (i, j) of the transpose times this is the dot of columns i and j.
+    for (int i = 0; i < 4; ++i) {
+        Vector4 ci = GetColumn(i);
+        for (int j = i; j < 4; ++j) {
+            if (Abs(Vector4::Dot(ci, GetColumn(j)) - (i == j ? 1.0f : 0.0f)) > Vector4::Epsilon) {
+                return false;
+            }
+        }
+    }
     return true;
+}
+
+_XOSRCINL float Matrix4x4::Determinant() const {
+    // Laplace expansion by the 2x2 minors of the top two rows and their complements in the bottom two.
+    float s0 = m00 * m11 - m10 * m01;
+    float s1 = m00 * m12 - m10 * m02;
+    float s2 = m00 * m13 - m10 * m03;
+    float s3 = m01 * m12 - m11 * m02;
+    float s4 = m01 * m13 - m11 * m03;
+    float s5 = m02 * m13 - m12 * m03;
+    float c5 = m22 * m33 - m32 * m23;
+    float c4 = m21 * m33 - m31 * m23;
+    float c3 = m21 * m32 - m31 * m22;
+    float c2 = m20 * m33 - m30 * m23;
+    float c1 = m20 * m32 - m30 * m22;
+    float c0 = m20 * m31 - m30 * m21;
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAffine() const {
+#if defined(XO_SSE)
+    // As Matrix3x4::MakeInverse, the columns of the adjugate are the cross products of the rows. The determinant
+    // goes in the w of the translation column, so once transposed and divided by the determinant, the bottom row
+    // comes out as (0, 0, 0, 1).
+    __m128 r0 = r[0].xmm, r1 = r[1].xmm, r2 = r[2].xmm;
+    auto cross = [](__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+    };
+    __m128 c0 = cross(r1, r2);
+    __m128 c1 = cross(r2, r0);
+    __m128 c2 = cross(r0, r1);
+    // the w of each cross product is zero, so the w of r0 drops out of the determinant.
+    __m128 det = _mm_mul_ps(r0, c0);
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+    det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128 t = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3))),
+        _mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)))),
+        _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+    __m128 c3 = _mm_sub_ps(_mm_and_ps(det, _mm_set_ps(HexFloat(0xffffffff), 0.0f, 0.0f, 0.0f)), t);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 inv = _mm_div_ps(sse::One, det);
+    Matrix4x4 o;
+    o.r[0].xmm = _mm_mul_ps(c0, inv);
+    o.r[1].xmm = _mm_mul_ps(c1, inv);
+    o.r[2].xmm = _mm_mul_ps(c2, inv);
+    o.r[3].xmm = _mm_mul_ps(c3, inv);
+    return o;
+#else
+    Matrix3x4 affine(*this);
+    affine.MakeInverse();
+    return Matrix4x4(affine);
 #endif
 }
 
-Matrix4x4& Matrix4x4::Transpose() {
+_XOSRCINL Matrix4x4 Matrix4x4::InverseRigid() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, false);
+    return o;
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseScaleRotateTranslate() const {
+    Matrix4x4 o;
+    xo_internal::InverseOrthogonal(*this, o, true);
+    return o;
+}
+
+_XOSRCINL Matrix4x4::InverseMethod Matrix4x4::ClassifyInverse() const {
+#if defined(XO_SSE)
+    if (_mm_movemask_ps(_mm_cmpeq_ps(r[3].xmm, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f))) != 0xf) {
+        return InverseMethod::General;
+    }
+    __m128 l, dots;
+    xo_internal::ColumnGram(*this, l, dots);
+    // the product of each length with the next lane's matches the pair in the same lane of dots.
+    __m128 limit = _mm_mul_ps(_mm_mul_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1))), _mm_set1_ps(xo_internal::InverseOrthogonalTolerance));
+    // w is zero in both, so it always passes.
+    if (_mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dots, dots), limit)) != 0xf) {
+        return InverseMethod::Affine;
+    }
+    __m128 unitError = _mm_and_ps(sse::AbsMask, _mm_sub_ps(l, sse::One));
+    if ((_mm_movemask_ps(_mm_cmple_ps(unitError, _mm_set1_ps(xo_internal::InverseUnitTolerance))) & 0x7) != 0x7) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
+#else
+    if (m30 != 0.0f || m31 != 0.0f || m32 != 0.0f || m33 != 1.0f) {
+        return InverseMethod::General;
+    }
+    Vector4 lengths, dots;
+    xo_internal::ColumnGram(*this, lengths, dots);
+    if (dots.x * dots.x > lengths.x * lengths.y * xo_internal::InverseOrthogonalTolerance ||
+        dots.y * dots.y > lengths.y * lengths.z * xo_internal::InverseOrthogonalTolerance ||
+        dots.z * dots.z > lengths.z * lengths.x * xo_internal::InverseOrthogonalTolerance) {
+        return InverseMethod::Affine;
+    }
+    if (Abs(lengths.x - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.y - 1.0f) > xo_internal::InverseUnitTolerance ||
+        Abs(lengths.z - 1.0f) > xo_internal::InverseUnitTolerance) {
+        return InverseMethod::ScaleRotateTranslate;
+    }
+    return InverseMethod::Rigid;
+#endif
+}
+
+_XOSRCINL Matrix4x4 Matrix4x4::InverseAuto(InverseStats* stats) const {
+    InverseMethod method = ClassifyInverse();
+    if (stats) {
+        stats->count[(int)method]++;
+    }
+    // every path writes to the one matrix, so it can be returned without a copy.
+    Matrix4x4 o;
+    if (method == InverseMethod::Rigid || method == InverseMethod::ScaleRotateTranslate) {
+        xo_internal::InverseOrthogonal(*this, o, method == InverseMethod::ScaleRotateTranslate);
+    }
+    else if (method == InverseMethod::Affine) {
+        o = InverseAffine();
+    }
+    else {
+        o = *this;
+        o.MakeInverse();
+    }
+    return o;
+}
+
+_XOSRCINL Matrix4x4& Matrix4x4::Transpose() {
 #if defined(XO_SSE)
     _MM_TRANSPOSE4_PS(r[0].xmm, r[1].xmm, r[2].xmm, r[3].xmm);
 #else
@@ -361,57 +681,841 @@ Matrix4x4& Matrix4x4::Transpose() {
     return *this;
 }
 
-Matrix4x4 Matrix4x4::Transposed() const {
+_XOSRCINL Matrix4x4 Matrix4x4::Transposed() const {
     Matrix4x4 m(*this);
     return m.Transpose();
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
     v = (*this) * Vector4(v);
     return *this;
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
+_XOSRCINL const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
     v = (*this) * v;
     return *this;
 }
 
-void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
+namespace xo_internal
+{
+    // Computes out[i] = c0*x + c1*y + c2*z + c3 for each vector, where cN is the Nth column of the matrix.
+    // Rather than a horizontal dot product per row, each element of the vector is broadcast and multiplied 
+    // against a whole column. The columns are transposed out of the matrix once, before the loop.
+    // When translate is false c3 is left as zero, so the fourth column isn't applied.
+    _XOSRCINL void TransformVector3Array(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+#if defined(XO_SSE)
+        // transposing with a zero fourth row keeps the w lane of every result at zero.
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), c3));
+        }
+#else
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + tx;
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + ty;
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + tz;
+        }
+#endif
+    }
+
+    // See TransformVector3Array, this is the same with a w element and fourth column.
+    _XOSRCINL void TransformVector4Array(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+#if defined(XO_SSE)
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        for (size_t i = 0; i < n; ++i) {
+            __m128 v = in[i].xmm;
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+            out[i].xmm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_add_ps(_mm_mul_ps(c2, z), _mm_mul_ps(c3, w)));
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z, w = in[i].w;
+            out[i].x = (m.m00 * x) + (m.m01 * y) + (m.m02 * z) + (m.m03 * w);
+            out[i].y = (m.m10 * x) + (m.m11 * y) + (m.m12 * z) + (m.m13 * w);
+            out[i].z = (m.m20 * x) + (m.m21 * y) + (m.m22 * z) + (m.m23 * w);
+            out[i].w = (m.m30 * x) + (m.m31 * y) + (m.m32 * z) + (m.m33 * w);
+        }
+#endif
+    }
+
+    _XOSRCINL void MultiplyBatch(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i * aStep] * b[i * bStep];
+        }
+    }
+
+    _XOSRCINL void MultiplyIndexedBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[aIndices[i]] * b[i];
+        }
+    }
+
+#if defined(XO_SSE)
+    // Inverts four matrices at once, with element k of all four in a[k], so the cofactors need no shuffles, only
+    // the transposes in and out. The expansion is by the 2x2 minors of the top and bottom pairs of rows, as
+    // Matrix4x4::Determinant. A matrix with a determinant of zero is left as it was, as TryMakeInverse leaves it,
+    // and reported false in ok when ok isn't null. in may be out.
+    _XOINL void InverseFour(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m128 a[16], b[16];
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = in[0].r[r].xmm, m1 = in[1].r[r].xmm, m2 = in[2].r[r].xmm, m3 = in[3].r[r].xmm;
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            a[r * 4 + 0] = m0;
+            a[r * 4 + 1] = m1;
+            a[r * 4 + 2] = m2;
+            a[r * 4 + 3] = m3;
+        }
+        __m128 s0 = _mm_sub_ps(_mm_mul_ps(a[0], a[5]), _mm_mul_ps(a[4], a[1]));
+        __m128 s1 = _mm_sub_ps(_mm_mul_ps(a[0], a[6]), _mm_mul_ps(a[4], a[2]));
+        __m128 s2 = _mm_sub_ps(_mm_mul_ps(a[0], a[7]), _mm_mul_ps(a[4], a[3]));
+        __m128 s3 = _mm_sub_ps(_mm_mul_ps(a[1], a[6]), _mm_mul_ps(a[5], a[2]));
+        __m128 s4 = _mm_sub_ps(_mm_mul_ps(a[1], a[7]), _mm_mul_ps(a[5], a[3]));
+        __m128 s5 = _mm_sub_ps(_mm_mul_ps(a[2], a[7]), _mm_mul_ps(a[6], a[3]));
+        __m128 c5 = _mm_sub_ps(_mm_mul_ps(a[10], a[15]), _mm_mul_ps(a[14], a[11]));
+        __m128 c4 = _mm_sub_ps(_mm_mul_ps(a[9], a[15]), _mm_mul_ps(a[13], a[11]));
+        __m128 c3 = _mm_sub_ps(_mm_mul_ps(a[9], a[14]), _mm_mul_ps(a[13], a[10]));
+        __m128 c2 = _mm_sub_ps(_mm_mul_ps(a[8], a[15]), _mm_mul_ps(a[12], a[11]));
+        __m128 c1 = _mm_sub_ps(_mm_mul_ps(a[8], a[14]), _mm_mul_ps(a[12], a[10]));
+        __m128 c0 = _mm_sub_ps(_mm_mul_ps(a[8], a[13]), _mm_mul_ps(a[12], a[9]));
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(s0, c5), _mm_mul_ps(s1, c4)), _mm_mul_ps(s2, c3)), _mm_add_ps(_mm_sub_ps(_mm_mul_ps(s3, c2), _mm_mul_ps(s4, c1)), _mm_mul_ps(s5, c0)));
+        b[0] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[5], c5), _mm_mul_ps(a[6], c4)), _mm_mul_ps(a[7], c3));
+        b[1] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[2], c4), _mm_mul_ps(a[1], c5)), _mm_mul_ps(a[3], c3));
+        b[2] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[13], s5), _mm_mul_ps(a[14], s4)), _mm_mul_ps(a[15], s3));
+        b[3] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[10], s4), _mm_mul_ps(a[9], s5)), _mm_mul_ps(a[11], s3));
+        b[4] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[6], c2), _mm_mul_ps(a[4], c5)), _mm_mul_ps(a[7], c1));
+        b[5] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c5), _mm_mul_ps(a[2], c2)), _mm_mul_ps(a[3], c1));
+        b[6] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[14], s2), _mm_mul_ps(a[12], s5)), _mm_mul_ps(a[15], s1));
+        b[7] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s5), _mm_mul_ps(a[10], s2)), _mm_mul_ps(a[11], s1));
+        b[8] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[4], c4), _mm_mul_ps(a[5], c2)), _mm_mul_ps(a[7], c0));
+        b[9] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[1], c2), _mm_mul_ps(a[0], c4)), _mm_mul_ps(a[3], c0));
+        b[10] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[12], s4), _mm_mul_ps(a[13], s2)), _mm_mul_ps(a[15], s0));
+        b[11] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[9], s2), _mm_mul_ps(a[8], s4)), _mm_mul_ps(a[11], s0));
+        b[12] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[5], c1), _mm_mul_ps(a[4], c3)), _mm_mul_ps(a[6], c0));
+        b[13] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], c3), _mm_mul_ps(a[1], c1)), _mm_mul_ps(a[2], c0));
+        b[14] = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a[13], s1), _mm_mul_ps(a[12], s3)), _mm_mul_ps(a[14], s0));
+        b[15] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[8], s3), _mm_mul_ps(a[9], s1)), _mm_mul_ps(a[10], s0));
+        __m128 invertible = _mm_cmpneq_ps(det, _mm_setzero_ps());
+        __m128 inv = _mm_div_ps(sse::One, det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm_or_ps(_mm_and_ps(invertible, _mm_mul_ps(b[k], inv)), _mm_andnot_ps(invertible, a[k]));
+        }
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = b[r * 4 + 0], m1 = b[r * 4 + 1], m2 = b[r * 4 + 2], m3 = b[r * 4 + 3];
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            out[0].r[r].xmm = m0;
+            out[1].r[r].xmm = m1;
+            out[2].r[r].xmm = m2;
+            out[3].r[r].xmm = m3;
+        }
+        if (ok) {
+            int bits = _mm_movemask_ps(invertible);
+            for (int j = 0; j < 4; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+#endif
+
+    _XOSRCINL void InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            InverseFour(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            // the last few are padded out with identities, so nothing past the end is read or written.
+            Matrix4x4 tail[4];
+            bool tailOk[4];
+            for (size_t j = 0; j < 4; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseFour(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            Matrix4x4 m = in[i];
+            bool invertible = m.TryMakeInverse();
+            out[i] = m;
+            if (ok) {
+                ok[i] = invertible;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row i of lo in the low 128 bit lane and row i of hi in the high lane.
+    _XOINL _XO_TARGET_AVX __m256 LoadRowPair(const Matrix4x4& lo, const Matrix4x4& hi, int i) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.r[i].xmm), hi.r[i].xmm, 1);
+    }
+
+    _XOINL _XO_TARGET_AVX void StoreRowPair(Matrix4x4& lo, Matrix4x4& hi, int i, __m256 v) {
+        lo.r[i].xmm = _mm256_castps256_ps128(v);
+        hi.r[i].xmm = _mm256_extractf128_ps(v, 1);
+    }
+
+    // Multiplies two matrices at once, one per 128 bit lane. aN and bN are row N of the left and right hand.
+    // All rows are passed in before any are stored, so the outputs may alias either input.
+    _XOINL _XO_TARGET_AVX void MultiplyPair(__m256 a0, __m256 a1, __m256 a2, __m256 a3, 
+                                            __m256 b0, __m256 b1, __m256 b2, __m256 b3, 
+                                            Matrix4x4& outLo, Matrix4x4& outHi) 
+    {
+        StoreRowPair(outLo, outHi, 0, sse::LinearCombination(a0, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 1, sse::LinearCombination(a1, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 2, sse::LinearCombination(a2, b0, b1, b2, b3));
+        StoreRowPair(outLo, outHi, 3, sse::LinearCombination(a3, b0, b1, b2, b3));
+    }
+
+    // Two vectors in v, transformed by the columns c0 to c3 of the matrix. The w of each vector is ignored and 1 is used.
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector3(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 TransformPairVector4(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+        __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), _mm256_mul_ps(c3, w)));
+    }
+
+    // The same matrix in both lanes, for the side of MultiplyBatchAVX with a step of 0.
+    _XOINL _XO_TARGET_AVX void BroadcastRows(const Matrix4x4& m, __m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+        r0 = _mm256_broadcast_ps(&m.r[0].xmm);
+        r1 = _mm256_broadcast_ps(&m.r[1].xmm);
+        r2 = _mm256_broadcast_ps(&m.r[2].xmm);
+        r3 = _mm256_broadcast_ps(&m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Two vectors per register, one in each 128 bit lane. _mm256_shuffle_ps shuffles within each lane.
+    // Eight vectors per pass, then the last few through masked loads and stores.
+    _XOSRCINL _XO_TARGET_AVX void TransformVector3ArrayAVX(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector3(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector3(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector3(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void TransformVector4ArrayAVX(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m256 wc0 = _mm256_broadcast_ps(&c0);
+        __m256 wc1 = _mm256_broadcast_ps(&c1);
+        __m256 wc2 = _mm256_broadcast_ps(&c2);
+        __m256 wc3 = _mm256_broadcast_ps(&c3);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, v0));
+            _mm256_storeu_ps(out[i+2].f, TransformPairVector4(wc0, wc1, wc2, wc3, v1));
+            _mm256_storeu_ps(out[i+4].f, TransformPairVector4(wc0, wc1, wc2, wc3, v2));
+            _mm256_storeu_ps(out[i+6].f, TransformPairVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, TransformPairVector4(wc0, wc1, wc2, wc3, _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void MultiplyBatchAVX(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        __m256 a0, a1, a2, a3, b0, b1, b2, b3;
+        if (aStep == 0) {
+            BroadcastRows(*a, a0, a1, a2, a3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(a0, a1, a2, a3,
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        else if (bStep == 0) {
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             b0, b1, b2, b3,
+                             out[i], out[i+1]);
+            }
+        }
+        else {
+            for (; i + 2 <= n; i += 2) {
+                MultiplyPair(LoadRowPair(a[i], a[i+1], 0), LoadRowPair(a[i], a[i+1], 1), 
+                             LoadRowPair(a[i], a[i+1], 2), LoadRowPair(a[i], a[i+1], 3),
+                             LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                             LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                             out[i], out[i+1]);
+            }
+        }
+        if (i < n) {
+            // The last odd product goes through the same pair kernel, with its high lane thrown away.
+            const Matrix4x4& la = a[i * aStep];
+            const Matrix4x4& lb = b[i * bStep];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(lb, lb, 0), LoadRowPair(lb, lb, 1), LoadRowPair(lb, lb, 2), LoadRowPair(lb, lb, 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // As MultiplyBatchAVX, with the left hand rows of each pair gathered from wherever the indices point.
+    _XOSRCINL _XO_TARGET_AVX void MultiplyIndexedBatchAVX(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const Matrix4x4& a0 = a[aIndices[i]];
+            const Matrix4x4& a1 = a[aIndices[i+1]];
+            MultiplyPair(LoadRowPair(a0, a1, 0), LoadRowPair(a0, a1, 1), LoadRowPair(a0, a1, 2), LoadRowPair(a0, a1, 3),
+                         LoadRowPair(b[i], b[i+1], 0), LoadRowPair(b[i], b[i+1], 1), 
+                         LoadRowPair(b[i], b[i+1], 2), LoadRowPair(b[i], b[i+1], 3),
+                         out[i], out[i+1]);
+        }
+        if (i < n) {
+            const Matrix4x4& la = a[aIndices[i]];
+            Matrix4x4 unused;
+            MultiplyPair(LoadRowPair(la, la, 0), LoadRowPair(la, la, 1), LoadRowPair(la, la, 2), LoadRowPair(la, la, 3),
+                         LoadRowPair(b[i], b[i], 0), LoadRowPair(b[i], b[i], 1), LoadRowPair(b[i], b[i], 2), LoadRowPair(b[i], b[i], 3),
+                         out[i], unused);
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 8x8 transpose: interleave pairs of rows, then pairs of pairs, then swap the 128 bit lanes.
+    _XOINL _XO_TARGET_AVX void Transpose8x8(__m256 v[8]) {
+        __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]), t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]), t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        __m256 t4 = _mm256_unpacklo_ps(v[4], v[5]), t5 = _mm256_unpackhi_ps(v[4], v[5]);
+        __m256 t6 = _mm256_unpacklo_ps(v[6], v[7]), t7 = _mm256_unpackhi_ps(v[6], v[7]);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        v[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+        v[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+        v[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+        v[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+        v[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+        v[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+        v[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+        v[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+    }
+
+    // See InverseFour. Each register holds two rows of a matrix, so the eight matrices are two 8x8 transposes.
+    _XOINL _XO_TARGET_AVX void InverseEight(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        // the loads and stores are written out so the arrays stay in registers rather than on the stack.
+        __m256 a[16] = {
+            _mm256_loadu_ps(in[0].m), _mm256_loadu_ps(in[1].m), _mm256_loadu_ps(in[2].m), _mm256_loadu_ps(in[3].m),
+            _mm256_loadu_ps(in[4].m), _mm256_loadu_ps(in[5].m), _mm256_loadu_ps(in[6].m), _mm256_loadu_ps(in[7].m),
+            _mm256_loadu_ps(in[0].m + 8), _mm256_loadu_ps(in[1].m + 8), _mm256_loadu_ps(in[2].m + 8), _mm256_loadu_ps(in[3].m + 8),
+            _mm256_loadu_ps(in[4].m + 8), _mm256_loadu_ps(in[5].m + 8), _mm256_loadu_ps(in[6].m + 8), _mm256_loadu_ps(in[7].m + 8)
+        };
+        __m256 b[16];
+        Transpose8x8(a);
+        Transpose8x8(a + 8);
+        __m256 s0 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[5]), _mm256_mul_ps(a[4], a[1]));
+        __m256 s1 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[6]), _mm256_mul_ps(a[4], a[2]));
+        __m256 s2 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[7]), _mm256_mul_ps(a[4], a[3]));
+        __m256 s3 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[6]), _mm256_mul_ps(a[5], a[2]));
+        __m256 s4 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[7]), _mm256_mul_ps(a[5], a[3]));
+        __m256 s5 = _mm256_sub_ps(_mm256_mul_ps(a[2], a[7]), _mm256_mul_ps(a[6], a[3]));
+        __m256 c5 = _mm256_sub_ps(_mm256_mul_ps(a[10], a[15]), _mm256_mul_ps(a[14], a[11]));
+        __m256 c4 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[15]), _mm256_mul_ps(a[13], a[11]));
+        __m256 c3 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[14]), _mm256_mul_ps(a[13], a[10]));
+        __m256 c2 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[15]), _mm256_mul_ps(a[12], a[11]));
+        __m256 c1 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[14]), _mm256_mul_ps(a[12], a[10]));
+        __m256 c0 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[13]), _mm256_mul_ps(a[12], a[9]));
+        __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s0, c5), _mm256_mul_ps(s1, c4)), _mm256_mul_ps(s2, c3)), _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(s3, c2), _mm256_mul_ps(s4, c1)), _mm256_mul_ps(s5, c0)));
+        b[0] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c5), _mm256_mul_ps(a[6], c4)), _mm256_mul_ps(a[7], c3));
+        b[1] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[2], c4), _mm256_mul_ps(a[1], c5)), _mm256_mul_ps(a[3], c3));
+        b[2] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s5), _mm256_mul_ps(a[14], s4)), _mm256_mul_ps(a[15], s3));
+        b[3] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[10], s4), _mm256_mul_ps(a[9], s5)), _mm256_mul_ps(a[11], s3));
+        b[4] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[6], c2), _mm256_mul_ps(a[4], c5)), _mm256_mul_ps(a[7], c1));
+        b[5] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c5), _mm256_mul_ps(a[2], c2)), _mm256_mul_ps(a[3], c1));
+        b[6] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[14], s2), _mm256_mul_ps(a[12], s5)), _mm256_mul_ps(a[15], s1));
+        b[7] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s5), _mm256_mul_ps(a[10], s2)), _mm256_mul_ps(a[11], s1));
+        b[8] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[4], c4), _mm256_mul_ps(a[5], c2)), _mm256_mul_ps(a[7], c0));
+        b[9] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[1], c2), _mm256_mul_ps(a[0], c4)), _mm256_mul_ps(a[3], c0));
+        b[10] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[12], s4), _mm256_mul_ps(a[13], s2)), _mm256_mul_ps(a[15], s0));
+        b[11] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[9], s2), _mm256_mul_ps(a[8], s4)), _mm256_mul_ps(a[11], s0));
+        b[12] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[5], c1), _mm256_mul_ps(a[4], c3)), _mm256_mul_ps(a[6], c0));
+        b[13] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[0], c3), _mm256_mul_ps(a[1], c1)), _mm256_mul_ps(a[2], c0));
+        b[14] = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a[13], s1), _mm256_mul_ps(a[12], s3)), _mm256_mul_ps(a[14], s0));
+        b[15] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a[8], s3), _mm256_mul_ps(a[9], s1)), _mm256_mul_ps(a[10], s0));
+        __m256 invertible = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm256_blendv_ps(a[k], _mm256_mul_ps(b[k], inv), invertible);
+        }
+        Transpose8x8(b);
+        Transpose8x8(b + 8);
+        for (int j = 0; j < 8; ++j) {
+            _mm256_storeu_ps(out[j].m, b[j]);
+            _mm256_storeu_ps(out[j].m + 8, b[j + 8]);
+        }
+        if (ok) {
+            int bits = _mm256_movemask_ps(invertible);
+            for (int j = 0; j < 8; ++j) {
+                ok[j] = ((bits >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void InverseBatchAVX(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            InverseEight(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[8];
+            bool tailOk[8];
+            for (size_t j = 0; j < 8; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseEight(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // Four vectors in v, one per 128 bit lane, transformed by the columns c0 to c3 of the matrix.
+    // The w of each vector is ignored and c3 is added, so c3 is zero for directions.
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector3(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), c3));
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 TransformQuadVector4(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) {
+        __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m512 w = _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c1, y)), _mm512_add_ps(_mm512_mul_ps(c2, z), _mm512_mul_ps(c3, w)));
+    }
+
+    // One whole matrix per register, a row per 128 bit lane. Row i of the product is the linear combination of 
+    // the rows b0 to b3, weighted by row i of a, so each lane broadcasts its own elements of a.
+    // Grouped as sse::LinearCombination, so the results match the narrower kernels exactly.
+    _XOINL _XO_TARGET_AVX512 __m512 MultiplyWhole(__m512 a, __m512 b0, __m512 b1, __m512 b2, __m512 b3) {
+        return _mm512_add_ps(
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm512_add_ps(_mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(2, 2, 2, 2)), b2), _mm512_mul_ps(_mm512_permute_ps(a, _MM_SHUFFLE(3, 3, 3, 3)), b3)));
+    }
+
+    _XOINL _XO_TARGET_AVX512 void BroadcastRows(const Matrix4x4& m, __m512& r0, __m512& r1, __m512& r2, __m512& r3) {
+        r0 = _mm512_broadcast_f32x4(m.r[0].xmm);
+        r1 = _mm512_broadcast_f32x4(m.r[1].xmm);
+        r2 = _mm512_broadcast_f32x4(m.r[2].xmm);
+        r3 = _mm512_broadcast_f32x4(m.r[3].xmm);
+    }
+}
+
+namespace xo_internal
+{
+    // Four vectors per register. Sixteen vectors per pass, then four at a time, then the last few through a mask
+    // register.
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector3ArrayAVX512(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n, bool translate) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!translate) {
+            c3 = _mm_setzero_ps();
+        }
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector3(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector3(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void TransformVector4ArrayAVX512(const Matrix4x4& m, const Vector4* in, Vector4* out, size_t n) {
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = m.r[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m512 wc0 = _mm512_broadcast_f32x4(c0);
+        __m512 wc1 = _mm512_broadcast_f32x4(c1);
+        __m512 wc2 = _mm512_broadcast_f32x4(c2);
+        __m512 wc3 = _mm512_broadcast_f32x4(c3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v0));
+            _mm512_storeu_ps(out[i+4].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v1));
+            _mm512_storeu_ps(out[i+8].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v2));
+            _mm512_storeu_ps(out[i+12].f, TransformQuadVector4(wc0, wc1, wc2, wc3, v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, TransformQuadVector4(wc0, wc1, wc2, wc3, _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // A matrix is one register, so there's no tail. Each product is loaded before it's stored, so out may alias
+    // either input.
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyBatchAVX512(const Matrix4x4* a, size_t aStep, const Matrix4x4* b, size_t bStep, Matrix4x4* out, size_t n) {
+        size_t i = 0;
+        if (bStep == 0) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(*b, b0, b1, b2, b3);
+            for (; i + 2 <= n; i += 2) {
+                __m512 p0 = MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3);
+                __m512 p1 = MultiplyWhole(_mm512_loadu_ps(a[i+1].m), b0, b1, b2, b3);
+                _mm512_storeu_ps(out[i].m, p0);
+                _mm512_storeu_ps(out[i+1].m, p1);
+            }
+            if (i < n) {
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[i].m), b0, b1, b2, b3));
+            }
+        }
+        else {
+            __m512 wa = _mm512_loadu_ps(a->m);
+            for (; i < n; ++i) {
+                __m512 b0, b1, b2, b3;
+                const Matrix4x4& mb = b[i];
+                BroadcastRows(mb, b0, b1, b2, b3);
+                if (aStep != 0) {
+                    wa = _mm512_loadu_ps(a[i].m);
+                }
+                _mm512_storeu_ps(out[i].m, MultiplyWhole(wa, b0, b1, b2, b3));
+            }
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void MultiplyIndexedBatchAVX512(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            __m512 b0, b1, b2, b3;
+            BroadcastRows(b[i], b0, b1, b2, b3);
+            _mm512_storeu_ps(out[i].m, MultiplyWhole(_mm512_loadu_ps(a[aIndices[i]].m), b0, b1, b2, b3));
+        }
+        _mm256_zeroupper();
+    }
+
+    // The standard 16x16 transpose: interleave pairs of rows, then pairs of pairs, then two rounds of moving
+    // 128 bit lanes between registers.
+    _XOINL _XO_TARGET_AVX512 void Transpose16x16(__m512 v[16]) {
+        __m512 t[16], u[16];
+        for (int i = 0; i < 16; i += 2) {
+            t[i] = _mm512_unpacklo_ps(v[i], v[i + 1]);
+            t[i + 1] = _mm512_unpackhi_ps(v[i], v[i + 1]);
+        }
+        for (int i = 0; i < 16; i += 4) {
+            u[i] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 1] = _mm512_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            u[i + 2] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 3] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+        for (int i = 0; i < 16; i += 8) {
+            for (int j = 0; j < 4; ++j) {
+                t[i + j] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(2, 0, 2, 0));
+                t[i + j + 4] = _mm512_shuffle_f32x4(u[i + j], u[i + j + 4], _MM_SHUFFLE(3, 1, 3, 1));
+            }
+        }
+        for (int j = 0; j < 8; ++j) {
+            v[j] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(2, 0, 2, 0));
+            v[j + 8] = _mm512_shuffle_f32x4(t[j], t[j + 8], _MM_SHUFFLE(3, 1, 3, 1));
+        }
+    }
+
+    // See InverseFour. Each register holds a whole matrix, so the sixteen matrices are one 16x16 transpose.
+    _XOINL _XO_TARGET_AVX512 void InverseSixteen(const Matrix4x4* in, Matrix4x4* out, bool* ok) {
+        __m512 a[16], b[16];
+        for (int j = 0; j < 16; ++j) {
+            a[j] = _mm512_loadu_ps(in[j].m);
+        }
+        Transpose16x16(a);
+        __m512 s0 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[5]), _mm512_mul_ps(a[4], a[1]));
+        __m512 s1 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[6]), _mm512_mul_ps(a[4], a[2]));
+        __m512 s2 = _mm512_sub_ps(_mm512_mul_ps(a[0], a[7]), _mm512_mul_ps(a[4], a[3]));
+        __m512 s3 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[6]), _mm512_mul_ps(a[5], a[2]));
+        __m512 s4 = _mm512_sub_ps(_mm512_mul_ps(a[1], a[7]), _mm512_mul_ps(a[5], a[3]));
+        __m512 s5 = _mm512_sub_ps(_mm512_mul_ps(a[2], a[7]), _mm512_mul_ps(a[6], a[3]));
+        __m512 c5 = _mm512_sub_ps(_mm512_mul_ps(a[10], a[15]), _mm512_mul_ps(a[14], a[11]));
+        __m512 c4 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[15]), _mm512_mul_ps(a[13], a[11]));
+        __m512 c3 = _mm512_sub_ps(_mm512_mul_ps(a[9], a[14]), _mm512_mul_ps(a[13], a[10]));
+        __m512 c2 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[15]), _mm512_mul_ps(a[12], a[11]));
+        __m512 c1 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[14]), _mm512_mul_ps(a[12], a[10]));
+        __m512 c0 = _mm512_sub_ps(_mm512_mul_ps(a[8], a[13]), _mm512_mul_ps(a[12], a[9]));
+        __m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s0, c5), _mm512_mul_ps(s1, c4)), _mm512_mul_ps(s2, c3)), _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(s3, c2), _mm512_mul_ps(s4, c1)), _mm512_mul_ps(s5, c0)));
+        b[0] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c5), _mm512_mul_ps(a[6], c4)), _mm512_mul_ps(a[7], c3));
+        b[1] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[2], c4), _mm512_mul_ps(a[1], c5)), _mm512_mul_ps(a[3], c3));
+        b[2] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s5), _mm512_mul_ps(a[14], s4)), _mm512_mul_ps(a[15], s3));
+        b[3] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[10], s4), _mm512_mul_ps(a[9], s5)), _mm512_mul_ps(a[11], s3));
+        b[4] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[6], c2), _mm512_mul_ps(a[4], c5)), _mm512_mul_ps(a[7], c1));
+        b[5] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c5), _mm512_mul_ps(a[2], c2)), _mm512_mul_ps(a[3], c1));
+        b[6] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[14], s2), _mm512_mul_ps(a[12], s5)), _mm512_mul_ps(a[15], s1));
+        b[7] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s5), _mm512_mul_ps(a[10], s2)), _mm512_mul_ps(a[11], s1));
+        b[8] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[4], c4), _mm512_mul_ps(a[5], c2)), _mm512_mul_ps(a[7], c0));
+        b[9] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[1], c2), _mm512_mul_ps(a[0], c4)), _mm512_mul_ps(a[3], c0));
+        b[10] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[12], s4), _mm512_mul_ps(a[13], s2)), _mm512_mul_ps(a[15], s0));
+        b[11] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[9], s2), _mm512_mul_ps(a[8], s4)), _mm512_mul_ps(a[11], s0));
+        b[12] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[5], c1), _mm512_mul_ps(a[4], c3)), _mm512_mul_ps(a[6], c0));
+        b[13] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[0], c3), _mm512_mul_ps(a[1], c1)), _mm512_mul_ps(a[2], c0));
+        b[14] = _mm512_sub_ps(_mm512_sub_ps(_mm512_mul_ps(a[13], s1), _mm512_mul_ps(a[12], s3)), _mm512_mul_ps(a[14], s0));
+        b[15] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(a[8], s3), _mm512_mul_ps(a[9], s1)), _mm512_mul_ps(a[10], s0));
+        __mmask16 invertible = _mm512_cmp_ps_mask(det, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+        __m512 inv = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+        for (int k = 0; k < 16; ++k) {
+            b[k] = _mm512_mask_blend_ps(invertible, a[k], _mm512_mul_ps(b[k], inv));
+        }
+        Transpose16x16(b);
+        for (int j = 0; j < 16; ++j) {
+            _mm512_storeu_ps(out[j].m, b[j]);
+        }
+        if (ok) {
+            for (int j = 0; j < 16; ++j) {
+                ok[j] = ((invertible >> j) & 1) != 0;
+            }
+        }
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void InverseBatchAVX512(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            InverseSixteen(in + i, out + i, ok ? ok + i : nullptr);
+        }
+        if (i < n) {
+            Matrix4x4 tail[16];
+            bool tailOk[16];
+            for (size_t j = 0; j < 16; ++j) {
+                tail[j] = i + j < n ? in[i + j] : Matrix4x4::Identity;
+            }
+            InverseSixteen(tail, tail, tailOk);
+            for (size_t j = 0; i + j < n; ++j) {
+                out[i + j] = tail[j];
+                if (ok) {
+                    ok[i + j] = tailOk[j];
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Vector3* in, Vector3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformVector3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, true);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, true);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(const Float3* in, Float3* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformFloat3Array(*this, in, out, n, false);
+#else
+    xo_internal::TransformFloat3Array(*this, in, out, n, false);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(const Vector4* in, Vector4* out, size_t n) const {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().transformVector4Array(*this, in, out, n);
+#else
+    xo_internal::TransformVector4Array(*this, in, out, n);
+#endif
+    return *this;
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformPoints(Vector3* inOut, size_t n) const {
+    return TransformPoints(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformDirections(Vector3* inOut, size_t n) const {
+    return TransformDirections(inOut, inOut, n);
+}
+
+_XOSRCINL const Matrix4x4& Matrix4x4::TransformVector4s(Vector4* inOut, size_t n) const {
+    return TransformVector4s(inOut, inOut, n);
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(&a, 0, b, 1, out, n);
+#else
+    xo_internal::MultiplyBatch(&a, 0, b, 1, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyBatch(a, 1, &b, 0, out, n);
+#else
+    xo_internal::MultiplyBatch(a, 1, &b, 0, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::MultiplyBatch(const Matrix4x4* a, const int* aIndices, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().multiplyIndexedBatch(a, aIndices, b, out, n);
+#else
+    xo_internal::MultiplyIndexedBatch(a, aIndices, b, out, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::InverseBatch(const Matrix4x4* in, Matrix4x4* out, bool* ok, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().inverseBatch(in, out, ok, n);
+#else
+    xo_internal::InverseBatch(in, out, ok, n);
+#endif
+}
+
+_XOSRCINL void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
     m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, xyz,  0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, xyz,  0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
     m[0].Set(x,    0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, y,    0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, z,    0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
     m[0].Set(v.x,  0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, v.y,  0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, v.z,  0.0f);
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
     m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
     m[3].Set(x,    y,    z,    1.0f);
 }
 
-void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
     m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
     m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
     m[3].Set(v,                1.0f);
 }
 
-void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
 
     SinCos(radians, sinr, cosr);
@@ -421,7 +1525,7 @@ void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
  
-void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
     SinCos(radians, sinr, cosr);
     m[0].Set(cosr, 0.0f,-sinr, 0.0f);
@@ -430,7 +1534,7 @@ void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
     float sinr, cosr;
     SinCos(radians, sinr, cosr);
     m[0].Set(cosr,-sinr, 0.0f, 0.0f);
@@ -439,7 +1543,7 @@ void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
     m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
     _XOSIMDALIGN float c[4];
     _XOSIMDALIGN float s[4];
     Vector4 v(x, y, z, 0.0f);
@@ -451,7 +1555,7 @@ void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
     m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
 }
 
-void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
     _XOSIMDALIGN float c[4];
     _XOSIMDALIGN float s[4];
     SinCos_x4(v.f, s, c);
@@ -462,7 +1566,7 @@ void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
     m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
 }
 
-void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
     float s, c;
     SinCos(radians, s, c);
     float t = 1.0f - c;
@@ -477,19 +1581,19 @@ void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m)
         );
 }
 
-void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
     RotationXRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
     RotationYRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
     RotationZRadians(degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
     Matrix4x4 m0, m1, m2;
     RotationXDegrees(x, m0);
     RotationYDegrees(y, m1);
@@ -497,7 +1601,7 @@ void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
     m = m0 * m1 * m2;
 }
 
-void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
     Matrix4x4 m0, m1, m2;
     RotationXDegrees(v.x, m0);
     RotationYDegrees(v.y, m1);
@@ -506,11 +1610,11 @@ void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
 }
 
 
-void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
     AxisAngleRadians(a, degrees * Deg2Rad, m);
 }
 
-void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
     XO_ASSERT(w != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Width (w) should not be zero."));
     XO_ASSERT(h != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Height (h) should not be zero."));
     m = Matrix4x4(
@@ -521,7 +1625,7 @@ void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matri
         );
 }
  
-void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
     XO_ASSERT(n != f, _XO_ASSERT_MSG("::PerspectiveProjectionRadians Near (n) and far (f) values should not be equal."));
     m = Matrix4x4(
             ATan(fovx/2.0f),   0.0f,               0.0f,               0.0f,
@@ -531,11 +1635,11 @@ void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, fl
         );
 }
 
-void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
+_XOSRCINL void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
     Matrix4x4::PerspectiveProjectionRadians(fovx * Deg2Rad, fovy * Deg2Rad, n, f, outMatrix);
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
     Vector3 zAxis = (to - from).Normalized();
     Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
     Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
@@ -547,11 +1651,11 @@ void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const
         );
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
     LookAtFromPosition(from, to, Vector3::Up, m);
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
     Vector3 zAxis = direction.Normalized();
     Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
     Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
@@ -563,149 +1667,151 @@ void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up,
         );
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
+_XOSRCINL void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
     LookAtFromDirection(direction, Vector3::Up, m);
 }
 
-Matrix4x4 Matrix4x4::Scale(float xyz) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float xyz) {
     Matrix4x4 m;
     Scale(xyz, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
     Matrix4x4 m;
     Scale(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
     Matrix4x4 m;
     Scale(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
     Matrix4x4 m;
     Translation(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
     Matrix4x4 m;
     Translation(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
     Matrix4x4 m;
     RotationXRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
     Matrix4x4 m;
     RotationYRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
     Matrix4x4 m;
     RotationZRadians(radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
     Matrix4x4 m;
     RotationRadians(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
     Matrix4x4 m;
     RotationRadians(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
     Matrix4x4 m;
     AxisAngleRadians(axis, radians, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
     Matrix4x4 m;
     RotationXDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
     Matrix4x4 m;
     RotationYDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
     Matrix4x4 m;
     RotationZDegrees(degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
     Matrix4x4 m;
     RotationDegrees(x, y, z, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
+_XOSRCINL Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
     Matrix4x4 m;
     RotationDegrees(v, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
+_XOSRCINL Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
     Matrix4x4 m;
     AxisAngleDegrees(axis, degrees, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
     Matrix4x4 m;
     OrthographicProjection(w, h, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
     Matrix4x4 m;
     PerspectiveProjectionRadians(fovx, fovy, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
+_XOSRCINL Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
     Matrix4x4 m;
     PerspectiveProjectionDegrees(fovx, fovy, n, f, m);
     return m;
 }
 
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
     Matrix4x4 m;
     LookAtFromPosition(from, to, up, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
     Matrix4x4 m;
     LookAtFromPosition(from, to, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
     Matrix4x4 m;
     LookAtFromDirection(direction, up, m);
     return m;
 }
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
+_XOSRCINL Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
     Matrix4x4 m;
     LookAtFromDirection(direction, m);
     return m;
 }
 
+#undef _XO_ASSERT_MSG
+
 XOMATH_END_XO_NS();
\ No newline at end of file
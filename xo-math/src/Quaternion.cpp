@@ -26,20 +26,20 @@ XOMATH_BEGIN_XO_NS();
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+_XOSRCDATA const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
 #   else
-const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
+_XOSRCDATA const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
 #   endif
 #endif
 
-const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
-const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
 
 namespace xo_internal
 {
     _XOINL float QuaternionSquareSum(const Quaternion& q)
     {
-#if defined(XO_SSE)
+#if defined(XO_SSE3)
         __m128 square = _mm_mul_ps(q.xmm, q.xmm);
         square = _mm_hadd_ps(square, square);
         square = _mm_hadd_ps(square, square);
@@ -50,11 +50,72 @@ namespace xo_internal
     }
 }
 
-Quaternion::Quaternion()
+_XOSRCINL Quaternion::Quaternion()
+{
+}
+
+_XOSRCINL Quaternion::Quaternion(const Matrix3x4& mat)
 {
+    // The rotation is taken from the columns, which are the transformed axes, so a scale applied before the
+    // rotation divides out.
+    Vector3 xAxis = mat.GetColumn(0);
+    Vector3 yAxis = mat.GetColumn(1);
+    Vector3 zAxis = mat.GetColumn(2);
+
+    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
+
+    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
+    {
+        _XO_ASSIGN_QUAT(1.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    xAxis /= scale.x;
+    yAxis /= scale.y;
+    zAxis /= scale.z;
+
+    // With the axes as columns, m[r][c] is axis c's component r.
+    float trace = xAxis.x + yAxis.y + zAxis.z;
+
+    if (trace > 0.0f)
+    {
+        float s = 0.5f / Sqrt(trace + 1.0f);
+        _XO_ASSIGN_QUAT(
+            0.25f / s,
+            (yAxis.z - zAxis.y) * s,
+            (zAxis.x - xAxis.z) * s,
+            (xAxis.y - yAxis.x) * s);
+    }
+    else if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (yAxis.z - zAxis.y) * s,
+            0.25f / s,
+            (yAxis.x + xAxis.y) * s,
+            (zAxis.x + xAxis.z) * s);
+    }
+    else if (yAxis.y > zAxis.z)
+    {
+        float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+        _XO_ASSIGN_QUAT(
+            (zAxis.x - xAxis.z) * s,
+            (yAxis.x + xAxis.y) * s,
+            0.25f / s,
+            (zAxis.y + yAxis.z) * s);
+    }
+    else
+    {
+        float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+        _XO_ASSIGN_QUAT(
+            (xAxis.y - yAxis.x) * s,
+            (zAxis.x + xAxis.z) * s,
+            (zAxis.y + yAxis.z) * s,
+            0.25f / s);
+    }
 }
 
-Quaternion::Quaternion(const Matrix4x4& mat)
+_XOSRCINL Quaternion::Quaternion(const Matrix4x4& mat)
 {
     Vector3 xAxis(mat[0]);
     Vector3 yAxis(mat[1]);
@@ -132,7 +193,7 @@ Quaternion::Quaternion(const Matrix4x4& mat)
     }
 }
 
-Quaternion::Quaternion(float x, float y, float z, float w) :
+_XOSRCINL Quaternion::Quaternion(float x, float y, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, y, x))
 #else
@@ -141,12 +202,12 @@ Quaternion::Quaternion(float x, float y, float z, float w) :
 {
 }
 
-Quaternion Quaternion::Inverse() const
+_XOSRCINL Quaternion Quaternion::Inverse() const
 {
     return Quaternion(*this).MakeInverse();
 }
 
-Quaternion& Quaternion::MakeInverse()
+_XOSRCINL Quaternion& Quaternion::MakeInverse()
 {
     float magnitude = xo_internal::QuaternionSquareSum(*this);
 
@@ -164,12 +225,12 @@ Quaternion& Quaternion::MakeInverse()
     return *this;
 }
 
-Quaternion Quaternion::Normalized() const
+_XOSRCINL Quaternion Quaternion::Normalized() const
 {
     return Quaternion(*this).Normalize();
 }
 
-Quaternion& Quaternion::Normalize()
+_XOSRCINL Quaternion& Quaternion::Normalize()
 {
     float magnitude = xo_internal::QuaternionSquareSum(*this);
     if (CloseEnough(magnitude, 1.0f, Epsilon))
@@ -187,18 +248,18 @@ Quaternion& Quaternion::Normalize()
     return *this;
 }
 
-Quaternion Quaternion::Conjugate() const
+_XOSRCINL Quaternion Quaternion::Conjugate() const
 {
     return Quaternion(*this).MakeConjugate();
 }
 
-Quaternion& Quaternion::MakeConjugate()
+_XOSRCINL Quaternion& Quaternion::MakeConjugate()
 {
     _XO_ASSIGN_QUAT(w, -x, -y, -z);
     return *this;
 }
 
-void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
+_XOSRCINL void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
 {
     Quaternion q = Normalized();
 
@@ -214,12 +275,12 @@ void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
     radians = (2.0f * ACos(q.w));
 }
 
-void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
+_XOSRCINL void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
 {
     RotationRadians(Vector3(x, y, z), outQuat);
 }
 
-void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
+_XOSRCINL void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
 {
     Vector3 hv = v * 0.5f;
     _XOSIMDALIGN float s[3];
@@ -233,37 +294,37 @@ void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
                       c[0] * c[1] * s[2] - s[0] * s[1] * c[2]);
 }
 
-void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
+_XOSRCINL void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
 {
-    float hr = radians * 0.5f;
-    float sr = Sin(hr);
+    float sr, cr;
+    SinCos(radians * 0.5f, sr, cr);
 
     Vector3 n = axis.Normalized();
     n *= sr;
-    _XO_ASSIGN_QUAT_Q(outQuat, Cos(radians), n.x, n.y, n.z);
+    _XO_ASSIGN_QUAT_Q(outQuat, cr, n.x, n.y, n.z);
 }
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
 {
     LookAtFromDirection(to - from, up, outQuat);
 }
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+_XOSRCINL void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
 {
     LookAtFromPosition(from, to, Vector3::Up, outQuat);
 }
 
-void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
 {
     // Todo
 }
 
-void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
+_XOSRCINL void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
 {
     LookAtFromDirection(direction, Vector3::Up, outQuat);
 }
 
-void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+_XOSRCINL void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
 {
     //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
 
@@ -369,7 +430,7 @@ void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quater
     }
 }
 
-void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+_XOSRCINL void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
 {
     Vector4& vq = (Vector4&)outQuat;
     const Vector4& va = a;
@@ -378,4 +439,470 @@ void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quatern
     vq = va + (vb - va) * t;
 }
 
+_XOSRCINL void Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // b is negated when it's in the other hemisphere from a, so the blend takes the shorter way around.
+    float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    float wa = 1.0f - t;
+    float wb = cosTheta < 0.0f ? -t : t;
+    float x = wa * a.x + wb * b.x;
+    float y = wa * a.y + wb * b.y;
+    float z = wa * a.z + wb * b.z;
+    float w = wa * a.w + wb * b.w;
+    float s = 1.0f / Sqrt(x * x + y * y + z * z + w * w);
+    _XO_ASSIGN_QUAT_Q(outQuat, w * s, x * s, y * s, z * s);
+}
+
+_XOSRCINL void Quaternion::FastSlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    // Arseny Kapoulkine's onlerp: http://zeux.io/2015/07/23/approximating-slerp/
+    // Nlerp moves fastest through the middle of the arc. t is bent by a cubic whose coefficient is fit to the angle 
+    // between a and b, which evens the speed out.
+    float d = Abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+    float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float c = t - 0.5f;
+    float k = A * c * c + B;
+    Nlerp(a, b, t + t * c * (t - 1.0f) * k, outQuat);
+}
+
+_XOSRCINL void Quaternion::SlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Slerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::NlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::Nlerp);
+#endif
+}
+
+_XOSRCINL void Quaternion::FastSlerpBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().blendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#else
+    xo_internal::BlendQuaternionBatch(a, b, t, out, n, xo_internal::QuaternionBlend::FastSlerp);
+#endif
+}
+
+namespace xo_internal
+{
+    _XOSRCINL void RotateVector3Batch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = q[i].Rotate(in[i]);
+        }
+    }
+
+#if defined(XO_SSE)
+    // Quaternion::Slerp, Nlerp or FastSlerp of four pairs of quaternions, one pair per lane. a and b hold the x, y, z
+    // and w of the four, and the results are written over a.
+    _XOINL void BlendFour(__m128 a[4], const __m128 b[4], __m128 t, QuaternionBlend blend)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 cosTheta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+        __m128 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m128 alpha = _mm_sub_ps(_mm_and_ps(_mm_cmpge_ps(cosTheta, _mm_setzero_ps()), _mm_set1_ps(2.0f)), one);
+            __m128 halfY = _mm_add_ps(one, _mm_mul_ps(alpha, cosTheta));
+            __m128 f2b = _mm_sub_ps(t, half);
+            __m128 u = _mm_andnot_ps(signMask, f2b);
+            __m128 f2a = _mm_sub_ps(u, f2b);
+            f2b = _mm_add_ps(f2b, u);
+            u = _mm_add_ps(u, u);
+            __m128 f1 = _mm_sub_ps(one, u);
+            __m128 halfSecHalfTheta = _mm_sub_ps(_mm_set1_ps(1.09f), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(0.476537f), _mm_mul_ps(_mm_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm_mul_ps(halfSecHalfTheta, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m128 versHalfTheta = _mm_sub_ps(one, _mm_mul_ps(halfY, halfSecHalfTheta));
+            __m128 sqNotU = _mm_mul_ps(f1, f1);
+            __m128 ratio2 = _mm_mul_ps(_mm_set1_ps(0.0000440917108f), versHalfTheta);
+            __m128 ratio1 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqNotU, _mm_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, one)), versHalfTheta));
+            __m128 sqU = _mm_mul_ps(u, u);
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.00158730159f), _mm_mul_ps(_mm_sub_ps(sqU, _mm_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm_add_ps(_mm_set1_ps(0.0333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(_mm_set1_ps(-0.333333333f), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm_mul_ps(f1, _mm_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm_mul_ps(alpha, _mm_add_ps(f1, _mm_mul_ps(f2a, ratio2)));
+            wb = _mm_add_ps(f1, _mm_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m128 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m128 d = _mm_andnot_ps(signMask, cosTheta);
+                __m128 A = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+                __m128 B = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+                __m128 c = _mm_sub_ps(t, half);
+                __m128 k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(A, c), c), B);
+                s = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, c), _mm_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm_sub_ps(one, s);
+            wb = _mm_xor_ps(s, _mm_and_ps(cosTheta, signMask));
+        }
+        __m128 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm_add_ps(_mm_mul_ps(wa, a[i]), _mm_mul_ps(wb, b[i]));
+        }
+        __m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_add_ps(_mm_mul_ps(r[2], r[2]), _mm_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m128 scale = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, sq));
+            const __m128 epsilon = _mm_set1_ps(sse::SSEFloatEpsilon);
+            __m128 same = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[0], b[0])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[1], b[1])), epsilon)),
+                _mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[2], b[2])), epsilon), _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(a[3], b[3])), epsilon)));
+            __m128 takeB = _mm_cmpeq_ps(t, one);
+            __m128 takeA = _mm_andnot_ps(takeB, _mm_or_ps(same, _mm_cmpeq_ps(t, _mm_setzero_ps())));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m128 v = _mm_mul_ps(r[i], scale);
+                v = _mm_or_ps(_mm_and_ps(takeB, b[i]), _mm_andnot_ps(takeB, v));
+                a[i] = _mm_or_ps(_mm_and_ps(takeA, a[i]), _mm_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m128 scale = _mm_rsqrt_ps(sq);
+            scale = _mm_mul_ps(scale, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(half, sq), _mm_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Four quaternions from each of a, b and t, blended into out.
+    _XOINL void BlendQuaternionsFour(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m128 qa[4] = { a[0].xmm, a[1].xmm, a[2].xmm, a[3].xmm };
+        __m128 qb[4] = { b[0].xmm, b[1].xmm, b[2].xmm, b[3].xmm };
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        _MM_TRANSPOSE4_PS(qb[0], qb[1], qb[2], qb[3]);
+        BlendFour(qa, qb, _mm_loadu_ps(t), blend);
+        _MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+        out[0].xmm = qa[0];
+        out[1].xmm = qa[1];
+        out[2].xmm = qa[2];
+        out[3].xmm = qa[3];
+    }
+#endif
+
+    _XOSRCINL void BlendQuaternionBatch(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+#if defined(XO_SSE)
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            BlendQuaternionsFour(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            // The last few are padded out with identities to a whole group.
+            Quaternion ta[4], tb[4], tout[4];
+            float tt[4];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsFour(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+#else
+        for (size_t i = 0; i < n; ++i)
+        {
+            switch (blend)
+            {
+            case QuaternionBlend::Slerp:
+                Quaternion::Slerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::Nlerp:
+                Quaternion::Nlerp(a[i], b[i], t[i], out[i]);
+                break;
+            case QuaternionBlend::FastSlerp:
+                Quaternion::FastSlerp(a[i], b[i], t[i], out[i]);
+                break;
+            }
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 CrossPair(__m256 a, __m256 b)
+    {
+        __m256 r = _mm256_sub_ps(_mm256_mul_ps(a, _mm256_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm256_mul_ps(b, _mm256_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm256_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL _XO_TARGET_AVX __m256 RotatePair(__m256 q, __m256 v)
+    {
+        __m256 t = CrossPair(q, v);
+        t = _mm256_add_ps(t, t);
+        return _mm256_add_ps(_mm256_add_ps(v, _mm256_mul_ps(t, _mm256_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossPair(q, t));
+    }
+
+    // Eight vectors per pass, then pairs, then a masked load and store for the last one.
+    _XOSRCINL _XO_TARGET_AVX void RotateVector3BatchAVX(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 v0 = RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f));
+            __m256 v1 = RotatePair(_mm256_loadu_ps(q[i+2].f), _mm256_loadu_ps(in[i+2].f));
+            __m256 v2 = RotatePair(_mm256_loadu_ps(q[i+4].f), _mm256_loadu_ps(in[i+4].f));
+            __m256 v3 = RotatePair(_mm256_loadu_ps(q[i+6].f), _mm256_loadu_ps(in[i+6].f));
+            _mm256_storeu_ps(out[i].f, v0);
+            _mm256_storeu_ps(out[i+2].f, v1);
+            _mm256_storeu_ps(out[i+4].f, v2);
+            _mm256_storeu_ps(out[i+6].f, v3);
+        }
+        for (; i + 2 <= n; i += 2)
+        {
+            _mm256_storeu_ps(out[i].f, RotatePair(_mm256_loadu_ps(q[i].f), _mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n)
+        {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, RotatePair(_mm256_maskload_ps(q[i].f, mask), _mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+
+    // BlendFour on eight pairs of quaternions.
+    _XOINL _XO_TARGET_AVX void BlendEight(__m256 a[4], const __m256 b[4], __m256 t, QuaternionBlend blend)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 cosTheta = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])), _mm256_add_ps(_mm256_mul_ps(a[2], b[2]), _mm256_mul_ps(a[3], b[3])));
+        __m256 wa, wb;
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Quaternion::Slerp step for step, with the fold as a mask. alpha is 1 or -1.
+            __m256 alpha = _mm256_sub_ps(_mm256_and_ps(_mm256_cmp_ps(cosTheta, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_set1_ps(2.0f)), one);
+            __m256 halfY = _mm256_add_ps(one, _mm256_mul_ps(alpha, cosTheta));
+            __m256 f2b = _mm256_sub_ps(t, half);
+            __m256 u = _mm256_andnot_ps(signMask, f2b);
+            __m256 f2a = _mm256_sub_ps(u, f2b);
+            f2b = _mm256_add_ps(f2b, u);
+            u = _mm256_add_ps(u, u);
+            __m256 f1 = _mm256_sub_ps(one, u);
+            __m256 halfSecHalfTheta = _mm256_sub_ps(_mm256_set1_ps(1.09f), _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(0.476537f), _mm256_mul_ps(_mm256_set1_ps(0.0903321f), halfY)), halfY));
+            halfSecHalfTheta = _mm256_mul_ps(halfSecHalfTheta, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+            __m256 versHalfTheta = _mm256_sub_ps(one, _mm256_mul_ps(halfY, halfSecHalfTheta));
+            __m256 sqNotU = _mm256_mul_ps(f1, f1);
+            __m256 ratio2 = _mm256_mul_ps(_mm256_set1_ps(0.0000440917108f), versHalfTheta);
+            __m256 ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqNotU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio1 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio1, _mm256_sub_ps(sqNotU, one)), versHalfTheta));
+            __m256 sqU = _mm256_mul_ps(u, u);
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.00158730159f), _mm256_mul_ps(_mm256_sub_ps(sqU, _mm256_set1_ps(16.0f)), ratio2));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(0.0333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(9.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(_mm256_set1_ps(-0.333333333f), _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, _mm256_set1_ps(4.0f))), versHalfTheta));
+            ratio2 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratio2, _mm256_sub_ps(sqU, one)), versHalfTheta));
+            f1 = _mm256_mul_ps(f1, _mm256_mul_ps(ratio1, halfSecHalfTheta));
+            wa = _mm256_mul_ps(alpha, _mm256_add_ps(f1, _mm256_mul_ps(f2a, ratio2)));
+            wb = _mm256_add_ps(f1, _mm256_mul_ps(f2b, ratio2));
+        }
+        else
+        {
+            __m256 s = t;
+            if (blend == QuaternionBlend::FastSlerp)
+            {
+                // See Quaternion::FastSlerp.
+                __m256 d = _mm256_andnot_ps(signMask, cosTheta);
+                __m256 A = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(d, _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(d, _mm256_set1_ps(1.43519f)))))));
+                __m256 B = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(d, _mm256_set1_ps(0.215638f)))));
+                __m256 c = _mm256_sub_ps(t, half);
+                __m256 k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(A, c), c), B);
+                s = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, c), _mm256_sub_ps(t, one)), k));
+            }
+            // b is negated where it's in the other hemisphere from a, so the blend takes the shorter way around.
+            wa = _mm256_sub_ps(one, s);
+            wb = _mm256_xor_ps(s, _mm256_and_ps(cosTheta, signMask));
+        }
+        __m256 r[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            r[i] = _mm256_add_ps(_mm256_mul_ps(wa, a[i]), _mm256_mul_ps(wb, b[i]));
+        }
+        __m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], r[0]), _mm256_mul_ps(r[1], r[1])), _mm256_add_ps(_mm256_mul_ps(r[2], r[2]), _mm256_mul_ps(r[3], r[3])));
+        if (blend == QuaternionBlend::Slerp)
+        {
+            // Slerp's own length correction, then its special cases: a where t is 0 or a equals b, and b where t is 1.
+            __m256 scale = _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half, sq));
+            const __m256 epsilon = _mm256_set1_ps(sse::SSEFloatEpsilon);
+            __m256 same = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[0], b[0])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[1], b[1])), epsilon, _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[2], b[2])), epsilon, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(a[3], b[3])), epsilon, _CMP_LT_OQ)));
+            __m256 takeB = _mm256_cmp_ps(t, one, _CMP_EQ_OQ);
+            __m256 takeA = _mm256_andnot_ps(takeB, _mm256_or_ps(same, _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_EQ_OQ)));
+            for (int i = 0; i < 4; ++i)
+            {
+                __m256 v = _mm256_mul_ps(r[i], scale);
+                v = _mm256_or_ps(_mm256_and_ps(takeB, b[i]), _mm256_andnot_ps(takeB, v));
+                a[i] = _mm256_or_ps(_mm256_and_ps(takeA, a[i]), _mm256_andnot_ps(takeA, v));
+            }
+        }
+        else
+        {
+            // One Newton-Raphson step on the approximate reciprocal square root.
+            __m256 scale = _mm256_rsqrt_ps(sq);
+            scale = _mm256_mul_ps(scale, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(half, sq), _mm256_mul_ps(scale, scale))));
+            for (int i = 0; i < 4; ++i)
+            {
+                a[i] = _mm256_mul_ps(r[i], scale);
+            }
+        }
+    }
+
+    // Register k holds quaternion k in its low lane and k + 4 in its high lane, so after the in-lane transpose the
+    // lanes of each element are in order, and line up with t.
+    _XOINL _XO_TARGET_AVX void BlendQuaternionsEight(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, QuaternionBlend blend)
+    {
+        __m256 qa[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[0].xmm), a[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[1].xmm), a[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(a[2].xmm), a[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(a[3].xmm), a[7].xmm, 1)
+        };
+        __m256 qb[4] = {
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[0].xmm), b[4].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[1].xmm), b[5].xmm, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(b[2].xmm), b[6].xmm, 1), _mm256_insertf128_ps(_mm256_castps128_ps256(b[3].xmm), b[7].xmm, 1)
+        };
+        TransposeLanes4x4(qa);
+        TransposeLanes4x4(qb);
+        BlendEight(qa, qb, _mm256_loadu_ps(t), blend);
+        TransposeLanes4x4(qa);
+        out[0].xmm = _mm256_castps256_ps128(qa[0]);
+        out[1].xmm = _mm256_castps256_ps128(qa[1]);
+        out[2].xmm = _mm256_castps256_ps128(qa[2]);
+        out[3].xmm = _mm256_castps256_ps128(qa[3]);
+        out[4].xmm = _mm256_extractf128_ps(qa[0], 1);
+        out[5].xmm = _mm256_extractf128_ps(qa[1], 1);
+        out[6].xmm = _mm256_extractf128_ps(qa[2], 1);
+        out[7].xmm = _mm256_extractf128_ps(qa[3], 1);
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void BlendQuaternionBatchAVX(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t n, QuaternionBlend blend)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            BlendQuaternionsEight(a + i, b + i, t + i, out + i, blend);
+        }
+        if (i < n)
+        {
+            Quaternion ta[8], tb[8], tout[8];
+            float tt[8];
+            for (size_t j = 0; j < 8; ++j)
+            {
+                ta[j] = i + j < n ? a[i + j] : Quaternion::Identity;
+                tb[j] = i + j < n ? b[i + j] : Quaternion::Identity;
+                tt[j] = i + j < n ? t[i + j] : 0.0f;
+            }
+            BlendQuaternionsEight(ta, tb, tt, tout, blend);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                out[i + j] = tout[j];
+            }
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // sse::Cross and sse::QuaternionRotate, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX512 __m512 CrossQuad(__m512 a, __m512 b)
+    {
+        __m512 r = _mm512_sub_ps(_mm512_mul_ps(a, _mm512_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1))), _mm512_mul_ps(b, _mm512_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm512_permute_ps(r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 RotateQuad(__m512 q, __m512 v)
+    {
+        __m512 t = CrossQuad(q, v);
+        t = _mm512_add_ps(t, t);
+        return _mm512_add_ps(_mm512_add_ps(v, _mm512_mul_ps(t, _mm512_permute_ps(q, _MM_SHUFFLE(3, 3, 3, 3)))), CrossQuad(q, t));
+    }
+
+    // Sixteen vectors per pass. The last passes mask their loads and stores, so there's no scalar remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void RotateVector3BatchAVX512(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m512 v0 = RotateQuad(_mm512_loadu_ps(q[i].f), _mm512_loadu_ps(in[i].f));
+            __m512 v1 = RotateQuad(_mm512_loadu_ps(q[i+4].f), _mm512_loadu_ps(in[i+4].f));
+            __m512 v2 = RotateQuad(_mm512_loadu_ps(q[i+8].f), _mm512_loadu_ps(in[i+8].f));
+            __m512 v3 = RotateQuad(_mm512_loadu_ps(q[i+12].f), _mm512_loadu_ps(in[i+12].f));
+            _mm512_storeu_ps(out[i].f, v0);
+            _mm512_storeu_ps(out[i+4].f, v1);
+            _mm512_storeu_ps(out[i+8].f, v2);
+            _mm512_storeu_ps(out[i+12].f, v3);
+        }
+        for (; i < n; i += 4)
+        {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, RotateQuad(_mm512_maskz_loadu_ps(mask, q[i].f), _mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL const Quaternion& Quaternion::Rotate(const Vector3* in, Vector3* out, size_t n) const
+{
+    // Matrix3x4(const Quaternion&) rotates column vectors, as Rotate does.
+    Matrix4x4(Matrix3x4(*this)).TransformDirections(in, out, n);
+    return *this;
+}
+
+_XOSRCINL const Quaternion& Quaternion::Rotate(Vector3* inOut, size_t n) const
+{
+    return Rotate(inOut, inOut, n);
+}
+
+_XOSRCINL void Quaternion::RotateBatch(const Quaternion* q, const Vector3* in, Vector3* out, size_t n)
+{
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().rotateVector3Batch(q, in, out, n);
+#else
+    xo_internal::RotateVector3Batch(q, in, out, n);
+#endif
+}
+
 XOMATH_END_XO_NS();
\ No newline at end of file
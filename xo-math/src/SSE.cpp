@@ -28,29 +28,33 @@ XOMATH_BEGIN_XO_NS();
 #if defined(XO_SSE)
 namespace sse {
 
-    volatile _XOTLS unsigned LastKnownControlWord = 0;
+    // A function static so that a header only build keeps one per thread, rather than one per translation unit.
+    _XOSRCINL volatile unsigned& LastKnownControlWord() {
+        static _XOTLS volatile unsigned controlWord = 0;
+        return controlWord;
+    }
 
-    void UpdateControlWord() {
-        LastKnownControlWord = _mm_getcsr();
+    _XOSRCINL void UpdateControlWord() {
+        LastKnownControlWord() = _mm_getcsr();
     }
 
-    void SetControlWord(unsigned control) {
-        _mm_setcsr(LastKnownControlWord = control);
+    _XOSRCINL void SetControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() = control);
     }
 
-    void SetControlWordAddative(unsigned control) {
-        _mm_setcsr(LastKnownControlWord |= control);
+    _XOSRCINL void SetControlWordAddative(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() |= control);
     }
 
-    void RemoveControlWord(unsigned control) {
-        _mm_setcsr(LastKnownControlWord &= ~control);
+    _XOSRCINL void RemoveControlWord(unsigned control) {
+        _mm_setcsr(LastKnownControlWord() &= ~control);
     }
 
-    bool HasControlFlagBeenSet(unsigned flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasControlFlagBeenSet(unsigned flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        if((LastKnownControlWord & flags) == flags) {
+        if((LastKnownControlWord() & flags) == flags) {
             if(thenFlush) {
                 RemoveControlWord(flags);
             }
@@ -59,35 +63,35 @@ namespace sse {
         return false;
     }
 
-    bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasControlFlagBeenSet(mxcsr::Flags flags, bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet((unsigned)flags, withUpdate, thenFlush);
     }
 
-    bool HasInvalidOperationExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasInvalidOperationExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::InvalidOperation, withUpdate, thenFlush);
     }
 
-    bool HasDenormalExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasDenormalExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Denormal, withUpdate, thenFlush);
     }
 
-    bool HasDivideByZeroExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasDivideByZeroExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::DivideByZero, withUpdate, thenFlush);
     }
 
-    bool HasOverflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasOverflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Overflow, withUpdate, thenFlush);
     }
 
-    bool HasUnderflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasUnderflowExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Underflow, withUpdate, thenFlush);
     }
 
-    bool HasPrecisionExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
+    _XOSRCINL bool HasPrecisionExceptionOccured(bool withUpdate/*= false*/, bool thenFlush/*= false*/) {
         return HasControlFlagBeenSet(mxcsr::Flags::Precision, withUpdate, thenFlush);
     }
 
-    void SetControlMask(unsigned mask, bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetControlMask(unsigned mask, bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -99,46 +103,46 @@ namespace sse {
         }
     }
 
-    void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetControlMask(mxcsr::Masks mask, bool value, bool withUpdate/*= false*/) {
         SetControlMask((unsigned)mask, value, withUpdate);
     }
 
-    bool GetControlMask(unsigned mask, bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetControlMask(unsigned mask, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & mask) == mask;
+        return (LastKnownControlWord() & mask) == mask;
     }
 
-    bool GetControlMask(mxcsr::Masks mask, bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetControlMask(mxcsr::Masks mask, bool withUpdate/*= false*/) {
         return GetControlMask((unsigned)mask, withUpdate);
     }
 
-    void SetInvalidOperationExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetInvalidOperationExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::InvalidOperation, value, withUpdate);
     }
 
-    void SetDenormalExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDenormalExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Denormal, value, withUpdate);
     }
 
-    void SetDivideByZeroExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDivideByZeroExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::DivideByZero, value, withUpdate);
     }
 
-    void SetOverflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetOverflowExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Overflow, value, withUpdate);
     }
 
-    void SetUnderflowExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetUnderflowExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Underflow, value, withUpdate);
     }
 
-    void SetPrecisionExceptionMask(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetPrecisionExceptionMask(bool value, bool withUpdate/*= false*/) {
         SetControlMask(mxcsr::Masks::Precision, value, withUpdate);
     }
 
-    void ThrowAllExceptions(bool withUpdate/*= false*/) {
+    _XOSRCINL void ThrowAllExceptions(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -150,7 +154,7 @@ namespace sse {
         SetPrecisionExceptionMask(false);
     }
 
-    void ThrowNoExceptions(bool withUpdate/*= false*/) {
+    _XOSRCINL void ThrowNoExceptions(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -162,38 +166,38 @@ namespace sse {
         SetPrecisionExceptionMask(true);
     }
 
-    bool GetInvalidOperationExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetInvalidOperationExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::InvalidOperation, withUpdate);
     }
 
-    bool GetDenormalExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetDenormalExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Denormal, withUpdate);
     }
 
-    bool GetDivideByZeroExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetDivideByZeroExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::DivideByZero, withUpdate);
     }
 
-    bool GetOverflowExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetOverflowExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Overflow, withUpdate);
     }
 
-    bool GetUnderflowExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetUnderflowExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Underflow, withUpdate);
     }
 
-    bool GetPrecisionExceptionMask(bool withUpdate/*= false*/) {
+    _XOSRCINL bool GetPrecisionExceptionMask(bool withUpdate/*= false*/) {
         return GetControlMask(mxcsr::Masks::Precision, withUpdate);
     }
 
-    mxcsr::Rounding GetRoundingMode(bool withUpdate/*= false*/) {
+    _XOSRCINL mxcsr::Rounding GetRoundingMode(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (mxcsr::Rounding)(LastKnownControlWord & (unsigned)mxcsr::Rounding::Bits);
+        return (mxcsr::Rounding)(LastKnownControlWord() & (unsigned)mxcsr::Rounding::Bits);
     }
 
-    void SetRoundingMode(unsigned mode, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetRoundingMode(unsigned mode, bool withUpdate/*= false*/) {
         mode &= (unsigned)mxcsr::Rounding::Bits;
         if(withUpdate) {
             UpdateControlWord();
@@ -201,18 +205,18 @@ namespace sse {
         SetControlWordAddative(mode);
     }
 
-    void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetRoundingMode(mxcsr::Rounding mode, bool withUpdate/*= false*/) {
         SetRoundingMode((unsigned)mode, withUpdate);
     }
 
-    bool HasDenormalsAreZeroSet(bool withUpdate/*= false*/) {
+    _XOSRCINL bool HasDenormalsAreZeroSet(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & (unsigned)mxcsr::DAZ::DenormalsAreZero) == (unsigned)mxcsr::DAZ::DenormalsAreZero;
+        return (LastKnownControlWord() & (unsigned)mxcsr::DAZ::DenormalsAreZero) == (unsigned)mxcsr::DAZ::DenormalsAreZero;
     }
 
-    void SetDenormalsAreZero(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetDenormalsAreZero(bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -224,14 +228,14 @@ namespace sse {
         }
     }
 
-    bool HasFlushToZeroSet(bool withUpdate/*= false*/) {
+    _XOSRCINL bool HasFlushToZeroSet(bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
-        return (LastKnownControlWord & (unsigned)mxcsr::FZ::FlushToZero) == (unsigned)mxcsr::FZ::FlushToZero;
+        return (LastKnownControlWord() & (unsigned)mxcsr::FZ::FlushToZero) == (unsigned)mxcsr::FZ::FlushToZero;
     }
 
-    void SetFlushToZero(bool value, bool withUpdate/*= false*/) {
+    _XOSRCINL void SetFlushToZero(bool value, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -243,7 +247,7 @@ namespace sse {
         }
     }
 
-    void GetAllMXCSRInfo(std::ostream& os, bool withUpdate/*= false*/) {
+    _XOSRCINL void GetAllMXCSRInfo(std::ostream& os, bool withUpdate/*= false*/) {
         if(withUpdate) {
             UpdateControlWord();
         }
@@ -0,0 +1,248 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // The rows of the four bones of influence, blended by its weights into the rows of one affine matrix.
+    _XOINL void BlendBoneRows(const Vector4* palette, size_t boneStride, const Skinning::Influences& influence, __m128& r0, __m128& r1, __m128& r2) {
+        const Vector4* b0 = palette + influence.bones[0] * boneStride;
+        const Vector4* b1 = palette + influence.bones[1] * boneStride;
+        const Vector4* b2 = palette + influence.bones[2] * boneStride;
+        const Vector4* b3 = palette + influence.bones[3] * boneStride;
+        __m128 w = _mm_loadu_ps(influence.weights);
+        __m128 w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 w3 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[0].xmm, w0), _mm_mul_ps(b1[0].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[0].xmm, w2), _mm_mul_ps(b3[0].xmm, w3)));
+        r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[1].xmm, w0), _mm_mul_ps(b1[1].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[1].xmm, w2), _mm_mul_ps(b3[1].xmm, w3)));
+        r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0[2].xmm, w0), _mm_mul_ps(b1[2].xmm, w1)), _mm_add_ps(_mm_mul_ps(b2[2].xmm, w2), _mm_mul_ps(b3[2].xmm, w3)));
+    }
+
+    // Skins vertex i. The position and normal are read before either output is written, so the outputs may be
+    // the inputs.
+    _XOINL void SkinVertex(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                           const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t i) {
+        const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+        __m128 r0, r1, r2;
+        BlendBoneRows(palette, boneStride, influences[i], r0, r1, r2);
+        __m128 p = _mm_or_ps(_mm_and_ps(positions[i].xmm, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+        if (normals) {
+            __m128 d = _mm_and_ps(normals[i].xmm, xyzMask);
+            outNormals[i].xmm = sse::AffineTransform(r0, r1, r2, d);
+        }
+        outPositions[i].xmm = sse::AffineTransform(r0, r1, r2, p);
+    }
+#endif
+
+    _XOSRCINL void SkinVertices(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+#if defined(XO_SSE)
+        for (size_t i = 0; i < n; ++i) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+#else
+        for (size_t i = 0; i < n; ++i) {
+            const Skinning::Influences& influence = influences[i];
+            Vector4 r[3];
+            for (int k = 0; k < 3; ++k) {
+                r[k] = palette[influence.bones[0] * boneStride + k] * influence.weights[0] +
+                       palette[influence.bones[1] * boneStride + k] * influence.weights[1] +
+                       palette[influence.bones[2] * boneStride + k] * influence.weights[2] +
+                       palette[influence.bones[3] * boneStride + k] * influence.weights[3];
+            }
+            Matrix3x4 m(r[0], r[1], r[2]);
+            if (normals) {
+                outNormals[i] = m.TransformDirection(normals[i]);
+            }
+            outPositions[i] = m.TransformPoint(positions[i]);
+        }
+#endif
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // Row k of bones a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX __m256 BoneRowPair(const Vector4* a, const Vector4* b, int k) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(a[k].xmm), b[k].xmm, 1);
+    }
+
+    // BlendBoneRows for vertices a and b, in the low and high lanes.
+    _XOINL _XO_TARGET_AVX void BlendBoneRowsPair(const Vector4* palette, size_t boneStride, const Skinning::Influences& a, const Skinning::Influences& b,
+                                                 __m256& r0, __m256& r1, __m256& r2) {
+        const Vector4* a0 = palette + a.bones[0] * boneStride;
+        const Vector4* a1 = palette + a.bones[1] * boneStride;
+        const Vector4* a2 = palette + a.bones[2] * boneStride;
+        const Vector4* a3 = palette + a.bones[3] * boneStride;
+        const Vector4* b0 = palette + b.bones[0] * boneStride;
+        const Vector4* b1 = palette + b.bones[1] * boneStride;
+        const Vector4* b2 = palette + b.bones[2] * boneStride;
+        const Vector4* b3 = palette + b.bones[3] * boneStride;
+        __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a.weights)), _mm_loadu_ps(b.weights), 1);
+        __m256 w0 = _mm256_permute_ps(w, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 w1 = _mm256_permute_ps(w, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 w2 = _mm256_permute_ps(w, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 w3 = _mm256_permute_ps(w, _MM_SHUFFLE(3, 3, 3, 3));
+        r0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 0), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 0), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 0), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 0), w3)));
+        r1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 1), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 1), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 1), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 1), w3)));
+        r2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(BoneRowPair(a0, b0, 2), w0), _mm256_mul_ps(BoneRowPair(a1, b1, 2), w1)),
+                           _mm256_add_ps(_mm256_mul_ps(BoneRowPair(a2, b2, 2), w2), _mm256_mul_ps(BoneRowPair(a3, b3, 2), w3)));
+    }
+
+    // sse::AffineTransform, one per 128 bit lane.
+    _XOINL _XO_TARGET_AVX __m256 AffineTransformPair(__m256 r0, __m256 r1, __m256 r2, __m256 v) {
+        __m256 t[4] = { _mm256_mul_ps(r0, v), _mm256_mul_ps(r1, v), _mm256_mul_ps(r2, v), _mm256_setzero_ps() };
+        TransposeLanes4x4(t);
+        return _mm256_add_ps(_mm256_add_ps(t[0], t[1]), _mm256_add_ps(t[2], t[3]));
+    }
+
+    // Two vertices per pass, which are next to each other in each array, so their positions and normals are one
+    // load and store each.
+    _XOSRCINL _XO_TARGET_AVX void SkinVerticesAVX(const Vector4* palette, size_t boneStride, const Skinning::Influences* influences, const Vector3* positions,
+                                                  const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n) {
+        const __m256 one = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256 r0, r1, r2;
+            BlendBoneRowsPair(palette, boneStride, influences[i], influences[i + 1], r0, r1, r2);
+            // w of each position is replaced with 1, and of each normal with 0.
+            __m256 p = _mm256_blend_ps(_mm256_loadu_ps(positions[i].f), one, 0x88);
+            if (normals) {
+                __m256 d = _mm256_blend_ps(_mm256_loadu_ps(normals[i].f), _mm256_setzero_ps(), 0x88);
+                _mm256_storeu_ps(outNormals[i].f, AffineTransformPair(r0, r1, r2, d));
+            }
+            _mm256_storeu_ps(outPositions[i].f, AffineTransformPair(r0, r1, r2, p));
+        }
+        if (i < n) {
+            SkinVertex(palette, boneStride, influences, positions, normals, outPositions, outNormals, i);
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+namespace xo_internal
+{
+    // Vertices are handed to threads this many at a time.
+    _XOSRCINL size_t SkinningChunkSize() {
+        return 4096;
+    }
+
+    // The bones, as rows of matrices boneStride apart, or as dual quaternions when dualQuaternions isn't null.
+    struct SkinPalette {
+        const Vector4* matrices;
+        size_t boneStride;
+        const DualQuaternion* dualQuaternions;
+    };
+
+    _XOSRCINL void SkinRange(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                             const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t begin, size_t end) {
+        if (begin >= end) {
+            return;
+        }
+        const Vector3* rangeNormals = normals ? normals + begin : nullptr;
+        Vector3* rangeOutNormals = normals ? outNormals + begin : nullptr;
+#if defined(XO_SSE2)
+        const DispatchKernels& kernels = GetDispatchKernels();
+        if (palette.dualQuaternions) {
+            kernels.skinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            kernels.skinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#else
+        if (palette.dualQuaternions) {
+            SkinVerticesDualQuaternion(palette.dualQuaternions, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+        else {
+            SkinVertices(palette.matrices, palette.boneStride, influences + begin, positions + begin, rangeNormals, outPositions + begin, rangeOutNormals, end - begin);
+        }
+#endif
+    }
+
+    _XOSRCINL void Skin(const SkinPalette& palette, const Skinning::Influences* influences, const Vector3* positions,
+                        const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+        // No more threads than there are cores, or than there are chunks.
+        const size_t chunk = SkinningChunkSize();
+        const size_t chunks = (n + chunk - 1) / chunk;
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores && threadCount > cores) {
+            threadCount = cores;
+        }
+        if (threadCount > chunks) {
+            threadCount = (unsigned)chunks;
+        }
+
+        if (threadCount <= 1) {
+            SkinRange(palette, influences, positions, normals, outPositions, outNormals, 0, n);
+            return;
+        }
+
+        // Each thread takes the next chunk until there are none left, so a thread that gets descheduled holds up
+        // one chunk rather than a whole share of the arrays.
+        std::atomic<size_t> next(0);
+        auto run = [&]() {
+            for (size_t begin = next.fetch_add(chunk, std::memory_order_relaxed); begin < n; begin = next.fetch_add(chunk, std::memory_order_relaxed)) {
+                SkinRange(palette, influences, positions, normals, outPositions, outNormals, begin, std::min(n, begin + chunk));
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(run);
+        }
+        run();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+_XOSRCINL void Skinning::Skin(const Matrix3x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 3, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const Matrix4x4* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { palette->r, 4, nullptr };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+_XOSRCINL void Skinning::Skin(const DualQuaternion* palette, const Influences* influences, const Vector3* positions,
+                              const Vector3* normals, Vector3* outPositions, Vector3* outNormals, size_t n, unsigned threadCount) {
+    xo_internal::SkinPalette bones = { nullptr, 0, palette };
+    xo_internal::Skin(bones, influences, positions, normals, outPositions, outNormals, n, threadCount);
+}
+
+XOMATH_END_XO_NS();
@@ -0,0 +1,145 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+_XOSRCDATA const Transform Transform::Identity;
+
+_XOSRCINL Transform::Transform() :
+    position(0.0f, 0.0f, 0.0f),
+    rotation(0.0f, 0.0f, 0.0f, 1.0f),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(0)
+{
+    // Both matrices of the identity are the identity, so they're written here rather than composed, and
+    // Transform::Identity can be read from any thread without updating anything.
+    matrix.r[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    matrix.r[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    matrix.r[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    inverseMatrix = matrix;
+}
+
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation) :
+    position(position),
+    rotation(rotation),
+    scale(1.0f, 1.0f, 1.0f),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL Transform::Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale) :
+    position(position),
+    rotation(rotation),
+    scale(scale),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL Transform::Transform(const Matrix3x4& m) :
+    position(m.GetTranslation()),
+    rotation(m),
+    scale(m.GetColumn(0).Magnitude(), m.GetColumn(1).Magnitude(), m.GetColumn(2).Magnitude()),
+    dirty(DirtyAll)
+{
+}
+
+_XOSRCINL void Transform::UpdateMatrix() const {
+    ComposeMatrix(position, rotation, scale, matrix);
+    dirty &= ~DirtyMatrix;
+}
+
+_XOSRCINL void Transform::UpdateInverseMatrix() const {
+    ComposeInverseMatrix(position, rotation, scale, inverseMatrix);
+    dirty &= ~DirtyInverse;
+}
+
+_XOSRCINL Vector3 Transform::TransformPoint(const Vector3& v) const {
+    return rotation.Rotate(v * scale) + position;
+}
+
+_XOSRCINL Vector3 Transform::TransformDirection(const Vector3& v) const {
+    return rotation.Rotate(v * scale);
+}
+
+_XOSRCINL Vector3 Transform::InverseTransformPoint(const Vector3& v) const {
+    // Vector3 division may use the approximate reciprocal, which would leave the result off in the fourth digit.
+    Vector3 inverseScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    return rotation.Conjugate().Rotate(v - position) * inverseScale;
+}
+
+_XOSRCINL Transform& Transform::MakeInverse() {
+    rotation.MakeConjugate();
+    scale.Set(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    position = -(rotation.Rotate(position) * scale);
+    dirty = DirtyAll;
+    return *this;
+}
+
+_XOSRCINL Transform Transform::Inverse() const {
+    return Transform(*this).MakeInverse();
+}
+
+_XOSRCINL void Transform::Combine(const Transform& parent, const Transform& child, Transform& outTransform) {
+    // outTransform may be either input, so nothing is written until everything is read.
+    Vector3 position = parent.TransformPoint(child.position);
+    Quaternion rotation = parent.rotation * child.rotation;
+    Vector3 scale = parent.scale * child.scale;
+    outTransform.Set(position, rotation, scale);
+}
+
+_XOSRCINL void Transform::ComposeMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    // The rotation of Matrix3x4(q), with each column multiplied by its scale.
+    outMatrix.r[0].Set((1.0f - (yy + zz)) * scale.x, (xy - wz) * scale.y,          (xz + wy) * scale.z,          position.x);
+    outMatrix.r[1].Set((xy + wz) * scale.x,          (1.0f - (xx + zz)) * scale.y, (yz - wx) * scale.z,          position.y);
+    outMatrix.r[2].Set((xz - wy) * scale.x,          (yz + wx) * scale.y,          (1.0f - (xx + yy)) * scale.z, position.z);
+}
+
+_XOSRCINL void Transform::ComposeInverseMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix3x4& outMatrix) {
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+    float sx = 1.0f / scale.x, sy = 1.0f / scale.y, sz = 1.0f / scale.z;
+
+    // The rows are the columns of the rotation, each divided by its scale.
+    Vector3 r0((1.0f - (yy + zz)) * sx, (xy + wz) * sx,          (xz - wy) * sx);
+    Vector3 r1((xy - wz) * sy,          (1.0f - (xx + zz)) * sy, (yz + wx) * sy);
+    Vector3 r2((xz + wy) * sz,          (yz - wx) * sz,          (1.0f - (xx + yy)) * sz);
+    outMatrix.r[0].Set(r0.x, r0.y, r0.z, -Vector3::Dot(r0, position));
+    outMatrix.r[1].Set(r1.x, r1.y, r1.z, -Vector3::Dot(r1, position));
+    outMatrix.r[2].Set(r2.x, r2.y, r2.z, -Vector3::Dot(r2, position));
+}
+
+_XOSRCINL Transform Transform::Combine(const Transform& parent, const Transform& child) {
+    Transform t;
+    Combine(parent, child, t);
+    return t;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
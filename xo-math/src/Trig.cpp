@@ -0,0 +1,151 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace xo_internal
+{
+    // The baseline kernel behind the array versions. s or c may be null when that output isn't wanted.
+    // With SSE2 it goes four at a time, then the remainder is copied through a partial register so the tail gets 
+    // the exact same results as the rest.
+    _XOSRCINL void SinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+#if defined(XO_SSE2)
+        for (; i + 4 <= n; i += 4) {
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            _XOSIMDALIGN float t[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            _XOSIMDALIGN float ts[4];
+            _XOSIMDALIGN float tc[4];
+            size_t remaining = n - i;
+            for (size_t k = 0; k < remaining; ++k) {
+                t[k] = f[i + k];
+            }
+            __m128 vs, vc;
+            sse::SinCosKernel(_mm_load_ps(t), vs, vc, fast);
+            _mm_store_ps(ts, vs);
+            _mm_store_ps(tc, vc);
+            for (size_t k = 0; k < remaining; ++k) {
+                if (s) {
+                    s[i + k] = ts[k];
+                }
+                if (c) {
+                    c[i + k] = tc[k];
+                }
+            }
+        }
+#else
+        for (; i < n; ++i) {
+            float vs, vc;
+            if (fast) {
+                FastSinCos(f[i], vs, vc);
+            }
+            else {
+                SinCos(f[i], vs, vc);
+            }
+            if (s) {
+                s[i] = vs;
+            }
+            if (c) {
+                c[i] = vc;
+            }
+        }
+#endif
+    }
+
+#if defined(_XO_KERNELS_AVX2)
+    // Eight at a time, with a masked load and store for the last few.
+    _XOSRCINL _XO_TARGET_AVX2 void SinCosArrayAVX2(const float* f, float* s, float* c, size_t n, bool fast) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_loadu_ps(f + i), vs, vc, fast);
+            if (s) {
+                _mm256_storeu_ps(s + i, vs);
+            }
+            if (c) {
+                _mm256_storeu_ps(c + i, vc);
+            }
+        }
+        if (i < n) {
+            __m256i mask = TailMask(n - i);
+            __m256 vs, vc;
+            sse::SinCosKernel(_mm256_maskload_ps(f + i, mask), vs, vc, fast);
+            if (s) {
+                _mm256_maskstore_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm256_maskstore_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
+    }
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+    // Sixteen at a time. The last few use a mask register, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void SinCosArrayAVX512(const float* f, float* s, float* c, size_t n, bool fast) {
+        for (size_t i = 0; i < n; i += 16) {
+            __mmask16 mask = TailMask16(n - i);
+            __m512 vs, vc;
+            sse::SinCosKernel(_mm512_maskz_loadu_ps(mask, f + i), vs, vc, fast);
+            if (s) {
+                _mm512_mask_storeu_ps(s + i, mask, vs);
+            }
+            if (c) {
+                _mm512_mask_storeu_ps(c + i, mask, vc);
+            }
+        }
+        _mm256_zeroupper();
+    }
+#endif
+}
+
+namespace xo_internal
+{
+    _XOSRCINL void DispatchSinCosArray(const float* f, float* s, float* c, size_t n, bool fast) {
+#if defined(XO_SSE2)
+        xo_internal::GetDispatchKernels().sinCosArray(f, s, c, n, fast);
+#else
+        xo_internal::SinCosArray(f, s, c, n, fast);
+#endif
+    }
+}
+
+_XOSRCINL void Sin(const float* f, float* s, size_t n)                    { xo_internal::DispatchSinCosArray(f, s, nullptr, n, false); }
+_XOSRCINL void Cos(const float* f, float* c, size_t n)                    { xo_internal::DispatchSinCosArray(f, nullptr, c, n, false); }
+_XOSRCINL void SinCos(const float* f, float* s, float* c, size_t n)       { xo_internal::DispatchSinCosArray(f, s, c, n, false); }
+_XOSRCINL void FastSin(const float* f, float* s, size_t n)                { xo_internal::DispatchSinCosArray(f, s, nullptr, n, true); }
+_XOSRCINL void FastCos(const float* f, float* c, size_t n)                { xo_internal::DispatchSinCosArray(f, nullptr, c, n, true); }
+_XOSRCINL void FastSinCos(const float* f, float* s, float* c, size_t n)   { xo_internal::DispatchSinCosArray(f, s, c, n, true); }
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -25,58 +25,58 @@
 XOMATH_BEGIN_XO_NS();
 
 #if defined(_XONOCONSTEXPR)
-const float Vector2::Epsilon = FloatEpsilon * 2.0f;
+_XOSRCDATA const float Vector2::Epsilon = FloatEpsilon * 2.0f;
 #endif
 
-const Vector2 Vector2::UnitX(1.0f, 0.0f);
-const Vector2 Vector2::UnitY(0.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::UnitX(1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::UnitY(0.0f, 1.0f);
 
-const Vector2 Vector2::Up(0.0f, 1.0f);
-const Vector2 Vector2::Down(0.0f, -1.0f);
-const Vector2 Vector2::Left(-1.0f, 0.0f);
-const Vector2 Vector2::Right(1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::Up(0.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Down(0.0f, -1.0f);
+_XOSRCDATA const Vector2 Vector2::Left(-1.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::Right(1.0f, 0.0f);
 
-const Vector2 Vector2::One(1.0f, 1.0f);
-const Vector2 Vector2::Zero(0.0f, 0.0f);
+_XOSRCDATA const Vector2 Vector2::One(1.0f, 1.0f);
+_XOSRCDATA const Vector2 Vector2::Zero(0.0f, 0.0f);
 
-Vector2::Vector2(float v) : x(v), y(v) {
+_XOSRCINL Vector2::Vector2(float v) : x(v), y(v) {
 }
 
-Vector2::Vector2(float x, float y) : x(x), y(y) {
+_XOSRCINL Vector2::Vector2(float x, float y) : x(x), y(y) {
 }
 
-Vector2::Vector2(const Vector2& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const Vector2& v) : x(v.x), y(v.y) {
 }
 
-Vector2::Vector2(const class Vector3& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const class Vector3& v) : x(v.x), y(v.y) {
 }
 
-Vector2::Vector2(const class Vector4& v) : x(v.x), y(v.y) {
+_XOSRCINL Vector2::Vector2(const class Vector4& v) : x(v.x), y(v.y) {
 }
 
-Vector2& Vector2::Set(float x, float y) {
+_XOSRCINL Vector2& Vector2::Set(float x, float y) {
     this->x = x;
     this->y = y;
     return *this;
 }
 
-Vector2& Vector2::Set(float v) {
+_XOSRCINL Vector2& Vector2::Set(float v) {
     x = v;
     y = v;
     return *this;
 }
 
-Vector2& Vector2::Set(const Vector2& v) {
+_XOSRCINL Vector2& Vector2::Set(const Vector2& v) {
     x = v.x;
     y = v.y;
     return *this;
 }
 
-void Vector2::Get(float& x, float& y) const {
+_XOSRCINL void Vector2::Get(float& x, float& y) const {
     x = this->x;
     y = this->y;
 }
-void Vector2::Get(float* f) const {
+_XOSRCINL void Vector2::Get(float* f) const {
     f[0] = this->x;
     f[1] = this->y;
 }
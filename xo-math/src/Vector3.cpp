@@ -26,55 +26,55 @@ XOMATH_BEGIN_XO_NS();
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Vector3::Epsilon = sse::SSEFloatEpsilon * 3.0f;
+_XOSRCDATA const float Vector3::Epsilon = sse::SSEFloatEpsilon * 3.0f;
 #   else
-const float Vector3::Epsilon = FloatEpsilon * 3.0f;
+_XOSRCDATA const float Vector3::Epsilon = FloatEpsilon * 3.0f;
 #   endif
 #endif
 
 #if defined(XO_SSE2)
-const __m128 Vector3::MASK = _mm_castsi128_ps(_mm_set_epi32(0, 0xffffffff, 0xffffffff, 0xffffffff));
+_XOSRCDATA const __m128 Vector3::MASK = _mm_castsi128_ps(_mm_set_epi32(0, 0xffffffff, 0xffffffff, 0xffffffff));
 #elif defined(XO_SSE)
-const __m128 Vector3::MASK = {-1, -1, -1, 0};
+_XOSRCDATA const __m128 Vector3::MASK = {-1, -1, -1, 0};
 #endif
 
-const Vector3 Vector3::Origin(0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Origin(0.0f, 0.0f, 0.0f);
 
-const Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
-const Vector3 Vector3::UnitY(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::UnitZ(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitY(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::UnitZ(0.0f, 0.0f, 1.0f);
 
-const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
-const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
 
 #if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Up(0.0f, 0.0f, 1.0f);
-const Vector3 Vector3::Down(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, 0.0f, -1.0f);
 #elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
 #endif
 
 #if defined(XO_SPACE_LEFTHAND)
 #   if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Forward(0.0f, -1.0f, 0.0f);
-const Vector3 Vector3::Backward(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 1.0f, 0.0f);
 #   elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
-const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
 #   endif
 #elif defined(XO_SPACE_RIGHTHAND)
 #   if defined(XO_SPACE_ZUP)
-const Vector3 Vector3::Forward(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::Backward(0.0f, -1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, -1.0f, 0.0f);
 #   elif defined(XO_SPACE_YUP)
-const Vector3 Vector3::Forward(0.0f, 0.0f, -1.0f);
-const Vector3 Vector3::Backward(0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Forward(0.0f, 0.0f, -1.0f);
+_XOSRCDATA const Vector3 Vector3::Backward(0.0f, 0.0f, 1.0f);
 #   endif
 #endif
 
-const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
-const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 
 #if defined(XO_SSE)
 
@@ -96,7 +96,7 @@ const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 
 #endif
 
-Vector3::Vector3(float f) :
+_XOSRCINL Vector3::Vector3(float f) :
 #if defined(XO_SSE)
     xmm(_mm_set1_ps(f))
 #elif defined(XO_NEON)
@@ -107,7 +107,7 @@ Vector3::Vector3(float f) :
 {
 }
 
-Vector3::Vector3(float x, float y, float z) :
+_XOSRCINL Vector3::Vector3(float x, float y, float z) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, z, y, x))
 #else
@@ -116,7 +116,7 @@ Vector3::Vector3(float x, float y, float z) :
 {
 }
 
-Vector3::Vector3(const Vector3& vec) :
+_XOSRCINL Vector3::Vector3(const Vector3& vec) :
 #if defined(XO_SSE)
     xmm(vec)
 #else
@@ -126,13 +126,13 @@ Vector3::Vector3(const Vector3& vec) :
 }
 
 #if defined(XO_SSE)
-Vector3::Vector3(const __m128& vec) : 
+_XOSRCINL Vector3::Vector3(const __m128& vec) : 
     xmm(vec)
 {
 }
 #endif
 
-Vector3::Vector3(const class Vector2& v) :
+_XOSRCINL Vector3::Vector3(const class Vector2& v) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, 0.0f, v.y, v.x))
 #else
@@ -141,7 +141,7 @@ Vector3::Vector3(const class Vector2& v) :
 {
 }
 
-Vector3::Vector3(const class Vector4& v) :
+_XOSRCINL Vector3::Vector3(const class Vector4& v) :
 #if defined(XO_SSE)
     xmm(v.xmm)
 #else
@@ -150,7 +150,7 @@ Vector3::Vector3(const class Vector4& v) :
 {
 }
 
-Vector3& Vector3::Set(float x, float y, float z) {
+_XOSRCINL Vector3& Vector3::Set(float x, float y, float z) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(0.0f, z, y, x);
 #else
@@ -161,7 +161,7 @@ Vector3& Vector3::Set(float x, float y, float z) {
     return *this;
 }
 
-Vector3& Vector3::Set(float f) {
+_XOSRCINL Vector3& Vector3::Set(float f) {
 #if defined(XO_SSE)
     xmm = _mm_set1_ps(f);
 #else
@@ -172,7 +172,7 @@ Vector3& Vector3::Set(float f) {
     return *this;
 }
 
-Vector3& Vector3::Set(const Vector3& vec) {
+_XOSRCINL Vector3& Vector3::Set(const Vector3& vec) {
 #if defined(XO_SSE)
     xmm = vec.xmm;
 #else
@@ -184,19 +184,19 @@ Vector3& Vector3::Set(const Vector3& vec) {
 }
 
 #if defined(XO_SSE)
-Vector3& Vector3::Set(const __m128& vec) {
+_XOSRCINL Vector3& Vector3::Set(const __m128& vec) {
     xmm = vec;
     return *this;
 }
 #endif
 
-void Vector3::Get(float& x, float& y, float &z) const {
+_XOSRCINL void Vector3::Get(float& x, float& y, float &z) const {
     x = this->x;
     y = this->y;
     z = this->z;
 }
 
-void Vector3::Get(float* f) const {
+_XOSRCINL void Vector3::Get(float* f) const {
 #if defined(XO_SSE)
     _mm_store_ps(f, xmm);
 #elif defined(XO_NEON)
@@ -208,7 +208,7 @@ void Vector3::Get(float* f) const {
 #endif
 }
 
-Vector3 Vector3::ZYX() const {
+_XOSRCINL Vector3 Vector3::ZYX() const {
 #if defined(XO_SSE)
     // todo: constexpr shuffle int
     return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_W, IDX_X, IDX_Y, IDX_Z)));
@@ -217,7 +217,7 @@ Vector3 Vector3::ZYX() const {
 #endif
 }
 
-float Vector3::Sum() const {
+_XOSRCINL float Vector3::Sum() const {
 #if defined(XO_SSE3)
     __m128 x = _mm_and_ps(xmm, MASK);
     x = _mm_hadd_ps(x, x);
@@ -228,26 +228,212 @@ float Vector3::Sum() const {
 #endif
 }
 
-Vector3& Vector3::Normalize() {
+_XOSRCINL Vector3& Vector3::Normalize() {
     return (*this) /= Magnitude();
 }
 
-Vector3& Vector3::NormalizeSafe() {
+_XOSRCINL Vector3& Vector3::NormalizeSafe() {
     float magnitude = MagnitudeSquared();
     if (magnitude == 0.0f)
         return *this;
     return *this /= Sqrt(magnitude);
 }
  
-float Vector3::Dot(const Vector3& a, const Vector3& b) {
+_XOSRCINL float Vector3::Dot(const Vector3& a, const Vector3& b) {
 #if defined(XO_SSE4_1)
     return _mm_cvtss_f32(_mm_dp_ps(a, b, 0x7f));
 #else
     return (a * b).Sum();
 #endif
 }
+
+namespace xo_internal
+{
+    _XOSRCINL void DotVector3Array(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = Vector3::Dot(a[i], b[i]);
+        }
+    }
+
+    _XOSRCINL void NormalizeVector3Array(const Vector3* in, Vector3* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = in[i].Normalized();
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // x, y and z of two vectors, with w cleared.
+    _XOINL _XO_TARGET_AVX __m256 MaskXYZPair(__m256 v) {
+        return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0)));
+    }
+
+    // p0 to p3 hold the products of eight vectors, two per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX __m256 SumXYZEight(__m256 p0, __m256 p1, __m256 p2, __m256 p3) {
+        // Each 128 bit lane sums on its own, the low lanes holding vectors 0, 2, 4 and 6 and the high lanes 1, 3, 5 
+        // and 7. Interleaving the halves puts them back in order.
+        __m256 h = _mm256_hadd_ps(_mm256_hadd_ps(MaskXYZPair(p0), MaskXYZPair(p1)), _mm256_hadd_ps(MaskXYZPair(p2), MaskXYZPair(p3)));
+        __m128 lo = _mm256_castps256_ps128(h);
+        __m128 hi = _mm256_extractf128_ps(h, 1);
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(lo, hi)), _mm_unpackhi_ps(lo, hi), 1);
+    }
+
+    // Two vectors divided by their magnitudes. The reciprocal square root is refined with a Newton-Raphson step.
+    _XOINL _XO_TARGET_AVX __m256 NormalizePair(__m256 v) {
+        __m256 sq = MaskXYZPair(_mm256_mul_ps(v, v));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m256 r = _mm256_rsqrt_ps(sq);
+        r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), sq), _mm256_mul_ps(r, r))));
+        return _mm256_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Eight vectors per pass, with masked loads and stores for the last few.
+    _XOSRCINL _XO_TARGET_AVX void DotVector3ArrayAVX(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(out + i, SumXYZEight(
+                _mm256_mul_ps(_mm256_loadu_ps(a[i].f), _mm256_loadu_ps(b[i].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+2].f), _mm256_loadu_ps(b[i+2].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+4].f), _mm256_loadu_ps(b[i+4].f)),
+                _mm256_mul_ps(_mm256_loadu_ps(a[i+6].f), _mm256_loadu_ps(b[i+6].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m256 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 2 ? rest - k * 2 : 0;
+                __m256i mask = TailMask((count < 2 ? count : 2) * 4);
+                p[k] = _mm256_mul_ps(_mm256_maskload_ps(a[i].f + k * 8, mask), _mm256_maskload_ps(b[i].f + k * 8, mask));
+            }
+            _mm256_maskstore_ps(out + i, TailMask(rest), SumXYZEight(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX void NormalizeVector3ArrayAVX(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(in[i].f);
+            __m256 v1 = _mm256_loadu_ps(in[i+2].f);
+            __m256 v2 = _mm256_loadu_ps(in[i+4].f);
+            __m256 v3 = _mm256_loadu_ps(in[i+6].f);
+            _mm256_storeu_ps(out[i].f, NormalizePair(v0));
+            _mm256_storeu_ps(out[i+2].f, NormalizePair(v1));
+            _mm256_storeu_ps(out[i+4].f, NormalizePair(v2));
+            _mm256_storeu_ps(out[i+6].f, NormalizePair(v3));
+        }
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_ps(out[i].f, NormalizePair(_mm256_loadu_ps(in[i].f)));
+        }
+        if (i < n) {
+            __m256i mask = TailMask(4);
+            _mm256_maskstore_ps(out[i].f, mask, NormalizePair(_mm256_maskload_ps(in[i].f, mask)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+#if defined(_XO_KERNELS_AVX512)
+namespace xo_internal
+{
+    // The sum of x, y and z of each of four vectors, in all four elements of its 128 bit lane. w is ignored.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZQuad(__m512 p) {
+        p = _mm512_maskz_mov_ps(0x7777, p);
+        p = _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm512_add_ps(p, _mm512_permute_ps(p, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // p0 to p3 hold the products of sixteen vectors, four per register. Returns the sums of x, y and z of each, in order.
+    _XOINL _XO_TARGET_AVX512 __m512 SumXYZSixteen(__m512 p0, __m512 p1, __m512 p2, __m512 p3) {
+        __m512 t = _mm512_mask_blend_ps(0x2222, SumXYZQuad(p0), SumXYZQuad(p1));
+        t = _mm512_mask_blend_ps(0x4444, t, SumXYZQuad(p2));
+        t = _mm512_mask_blend_ps(0x8888, t, SumXYZQuad(p3));
+        // Lane j of t now holds the sums of vectors j, 4+j, 8+j and 12+j.
+        return _mm512_permutexvar_ps(_mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15), t);
+    }
+
+    _XOINL _XO_TARGET_AVX512 __m512 NormalizeQuad(__m512 v) {
+        __m512 sq = SumXYZQuad(_mm512_mul_ps(v, v));
+        __m512 r = _mm512_rsqrt14_ps(sq);
+        r = _mm512_mul_ps(r, _mm512_sub_ps(_mm512_set1_ps(1.5f), _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), sq), _mm512_mul_ps(r, r))));
+        return _mm512_mul_ps(v, r);
+    }
+}
+
+namespace xo_internal
+{
+    // Sixteen vectors per pass. The last pass masks its loads and stores, so there's no remainder loop.
+    _XOSRCINL _XO_TARGET_AVX512 void DotVector3ArrayAVX512(const Vector3* a, const Vector3* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_ps(out + i, SumXYZSixteen(
+                _mm512_mul_ps(_mm512_loadu_ps(a[i].f), _mm512_loadu_ps(b[i].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+4].f), _mm512_loadu_ps(b[i+4].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+8].f), _mm512_loadu_ps(b[i+8].f)),
+                _mm512_mul_ps(_mm512_loadu_ps(a[i+12].f), _mm512_loadu_ps(b[i+12].f))));
+        }
+        if (i < n) {
+            const size_t rest = n - i;
+            __m512 p[4];
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t count = rest > k * 4 ? rest - k * 4 : 0;
+                __mmask16 mask = TailMask16(count * 4);
+                p[k] = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a[i].f + k * 16), _mm512_maskz_loadu_ps(mask, b[i].f + k * 16));
+            }
+            _mm512_mask_storeu_ps(out + i, TailMask16(rest), SumXYZSixteen(p[0], p[1], p[2], p[3]));
+        }
+        _mm256_zeroupper();
+    }
+
+    _XOSRCINL _XO_TARGET_AVX512 void NormalizeVector3ArrayAVX512(const Vector3* in, Vector3* out, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(in[i].f);
+            __m512 v1 = _mm512_loadu_ps(in[i+4].f);
+            __m512 v2 = _mm512_loadu_ps(in[i+8].f);
+            __m512 v3 = _mm512_loadu_ps(in[i+12].f);
+            _mm512_storeu_ps(out[i].f, NormalizeQuad(v0));
+            _mm512_storeu_ps(out[i+4].f, NormalizeQuad(v1));
+            _mm512_storeu_ps(out[i+8].f, NormalizeQuad(v2));
+            _mm512_storeu_ps(out[i+12].f, NormalizeQuad(v3));
+        }
+        for (; i < n; i += 4) {
+            __mmask16 mask = TailMask16((n - i) * 4);
+            _mm512_mask_storeu_ps(out[i].f, mask, NormalizeQuad(_mm512_maskz_loadu_ps(mask, in[i].f)));
+        }
+        _mm256_zeroupper();
+    }
+}
+#endif
+
+_XOSRCINL void Vector3::Dot(const Vector3* a, const Vector3* b, float* outDots, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().dotVector3Array(a, b, outDots, n);
+#else
+    xo_internal::DotVector3Array(a, b, outDots, n);
+#endif
+}
+
+_XOSRCINL void Vector3::Normalize(const Vector3* in, Vector3* out, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::GetDispatchKernels().normalizeVector3Array(in, out, n);
+#else
+    xo_internal::NormalizeVector3Array(in, out, n);
+#endif
+}
+
+_XOSRCINL void Vector3::Normalize(Vector3* inOut, size_t n) {
+    Normalize(inOut, inOut, n);
+}
  
-void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
+_XOSRCINL void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
 #if defined(XO_SSE)
     // todo: multi-compiler constexpr
     constexpr int m3021 = _MM_SHUFFLE(3, 0, 2, 1);
@@ -260,78 +446,303 @@ void Vector3::Cross(const Vector3& a, const Vector3& b, Vector3& outVec) {
 #endif
 }
 
-void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
+_XOSRCINL void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
     // Rodrigues' rotation formula
     // https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
     Vector3 axv;
-    float sinAng = Sin(angle);
-    float cosAng = Cos(angle);
+    float sinAng, cosAng;
+    SinCos(angle, sinAng, cosAng);
     Vector3::Cross(axis, v, axv);
     float adv = Vector3::Dot(axis, v);
     outVec.Set(v * cosAng + axv * sinAng + axis * adv * (1.0f - cosAng));
 }
 
-float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
+_XOSRCINL float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
     Vector3 cross;
     Vector3::Cross(a, b, cross);
     cross *= cross;
     return ATan2(Sqrt(cross.Sum()), Vector3::Dot(a, b));
 }
 
-void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, RandomRange(0.0f, angle*0.5f), outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+namespace xo_internal
+{
+    // A unit vector perpendicular to v, from crossing it with preferred. fallback is used when v is (nearly) parallel 
+    // to preferred.
+    _XOSRCINL Vector3 RandomBasisPerpendicular(const Vector3& v, const Vector3& preferred, const Vector3& fallback) {
+        Vector3 cross;
+        Vector3::Cross(v, preferred, cross);
+        if (cross.MagnitudeSquared() <= Vector3::Epsilon) {
+            Vector3::Cross(v, fallback, cross);
+        }
+        return cross.Normalized();
+    }
+
+#if defined(XO_SSE2)
+    // Shared loop for the array versions of the random methods. next returns the following four vectors, the last 
+    // of which may be partially stored.
+    template <typename NextFunc>
+    _XOSRCINL void FillRandomVector3s(Vector3* outVecs, size_t n, NextFunc next) {
+        Random_x4 rng(Random::ThreadEngine());
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            next(rng).Store(outVecs + i);
+        }
+        if (i < n) {
+            next(rng).StorePartial(outVecs + i, (int)(n - i));
+        }
+    }
+
+    _XOSRCINL __m128 RandomSelect(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Four directions uniform on the unit sphere. z is uniform in [-1, 1] along with an angle around z, which is 
+    // uniform over the sphere by Archimedes' hat-box theorem and unlike Marsaglia's method doesn't need to reject.
+    _XOSRCINL Vector3x4 RandomSphereDirections(Random_x4& rng) {
+        __m128 z = rng.Range(-1.0f, 1.0f);
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 r = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sse::One, _mm_mul_ps(z, z)), sse::Zero));
+        return Vector3x4(_mm_mul_ps(r, c), _mm_mul_ps(r, s), z);
+    }
+
+    // Cube root of each lane of x >= 0. Thirds the exponent through the bit pattern for an estimate within a few 
+    // percent, then refines it with three Newton steps.
+    _XOSRCINL __m128 RandomCbrt(__m128 x) {
+        const __m128 third = _mm_set1_ps(1.0f / 3.0f);
+        __m128i bits = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), third));
+        __m128 y = _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(0x2a5137a0)));
+        for (int i = 0; i < 3; ++i) {
+            y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), third);
+        }
+        return y;
+    }
+#endif
 }
 
-void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, angle*0.5f, outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, rng.Range(0.0f, angle*0.5f), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), rng.Range(0.0f, TAU), outVec);
+}
+
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left);
+    Vector3::RotateRadians(forward, axis, angle*0.5f, outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
 }
 
-void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
     // Marsaglia's method: https://projecteuclid.org/download/pdf_1/euclid.aoms/1177692644
+    Random& rng = Random::ThreadEngine();
     float x1, x2, x12, x22;
-    x1 = RandomRange(-1.0f, 1.0f);
-    x2 = RandomRange(-1.0f, 1.0f);
-    x12 = Square(x1);
-    x22 = Square(x1);
+    do {
+        x1 = rng.Range(-1.0f, 1.0f);
+        x2 = rng.Range(-1.0f, 1.0f);
+        x12 = Square(x1);
+        x22 = Square(x2);
+    } while (x12 + x22 >= 1.0f);
+    float s = 2.0f * Sqrt(1.0f - x12 - x22);
     outVec.Set(
-        2.0f * x1 * Sqrt(1.0f - x12 - x22),
-        2.0f * x2 * Sqrt(1.0f - x12 - x22),
+        x1 * s,
+        x2 * s,
         1.0f - (2.0f * (x12 + x22))
         );
     outVec *= radius;
 }
 
-void Vector3::RandomOnCube(float size, Vector3& outVec) {
-    switch (RandomRange(0, 5)) {
-        case 0: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),                size);         break;
-        case 1: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),               -size);         break;
-        case 2: outVec.Set(RandomRange(-size, size),                 size,          RandomRange(-size, size));  break;
-        case 3: outVec.Set(RandomRange(-size, size),                -size,          RandomRange(-size, size));  break;
-        case 4: outVec.Set(             size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-        case 5: outVec.Set(            -size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    switch (rng.Range(0, 5)) {
+        case 0: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),                size);       break;
+        case 1: outVec.Set(rng.Range(-size, size),  rng.Range(-size, size),               -size);       break;
+        case 2: outVec.Set(rng.Range(-size, size),               size,          rng.Range(-size, size));  break;
+        case 3: outVec.Set(rng.Range(-size, size),              -size,          rng.Range(-size, size));  break;
+        case 4: outVec.Set(             size,           rng.Range(-size, size), rng.Range(-size, size));  break;
+        case 5: outVec.Set(            -size,           rng.Range(-size, size), rng.Range(-size, size));  break;
     }
 }
 
-void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
-    outVec *= Sqrt(RandomRange(0.0f, 1.0f)) * radius;
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Random& rng = Random::ThreadEngine();
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), rng.Range(0.0f, TAU), outVec);
+    outVec *= Sqrt(rng.NextFloat()) * radius;
 }
 
-void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
-    Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
+    Vector3 cross = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward);
+    Vector3::RotateRadians(cross, up.Normalized(), Random::ThreadEngine().Range(0.0f, TAU), outVec);
     outVec *= radius;
 }
 
+_XOSRCINL void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // rotating a perpendicular a around up by t gives a*cos(t) + b*sin(t), where b is up cross a.
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a), b4(b);
+    const __m128 r = _mm_set1_ps(radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        __m128 scale = _mm_mul_ps(_mm_sqrt_ps(rng.NextFloat()), r);
+        return a4 * Vector4(_mm_mul_ps(c, scale)) + b4 * Vector4(_mm_mul_ps(s, scale));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    Vector3 a = xo_internal::RandomBasisPerpendicular(up, Vector3::Right, Vector3::Forward), b;
+    Vector3::Cross(up.Normalized(), a, b);
+    const Vector3x4 a4(a * radius), b4(b * radius);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(0.0f, TAU), s, c);
+        return a4 * Vector4(c) + b4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCircle(up, radius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Tilting forward by a toward p, then spinning it around forward by b gives:
+    // forward*cos(a) + p*sin(a)*cos(b) + q*sin(a)*sin(b), where p and q are perpendicular to forward.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    const Vector3x4 f4(forward), p4(p), q4(q);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sa, ca, sb, cb;
+        sse::SinCos(rng.Range(0.0f, halfAngle), sa, ca);
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 * Vector4(ca) + p4 * Vector4(_mm_mul_ps(sa, cb)) + q4 * Vector4(_mm_mul_ps(sa, sb));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // The same as RandomInConeRadians, with the tilt fixed at the edge of the cone.
+    Vector3 axis = xo_internal::RandomBasisPerpendicular(forward, Vector3::Up, Vector3::Left), p, q;
+    Vector3::Cross(axis, forward, p);
+    Vector3::Cross(forward.Normalized(), p, q);
+    float sa, ca;
+    SinCos(angle * 0.5f, sa, ca);
+    const Vector3x4 f4(forward * ca), p4(p * sa), q4(q * sa);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 sb, cb;
+        sse::SinCos(rng.Range(0.0f, TAU), sb, cb);
+        return f4 + p4 * Vector4(cb) + q4 * Vector4(sb);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnConeRadians(forward, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInFanRadians(const Vector3& forward, const Vector3& up, float angle, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Rodrigues' rotation formula, split into the parts scaled by 1, cos(t) and sin(t).
+    Vector3 along = up * Vector3::Dot(up, forward), side;
+    Vector3::Cross(up, forward, side);
+    const Vector3x4 along4(along), perp4(forward - along), side4(side);
+    const float halfAngle = angle * 0.5f;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 s, c;
+        sse::SinCos(rng.Range(-halfAngle, halfAngle), s, c);
+        return along4 + perp4 * Vector4(c) + side4 * Vector4(s);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInFanRadians(forward, up, angle, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 x = rng.Range(-size, size);
+        __m128 y = rng.Range(-size, size);
+        __m128 z = rng.Range(-size, size);
+        return Vector3x4(x, y, z);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInCube(size, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnCube(float size, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    // Faces are numbered as in the single vector version: 0 and 1 are +z and -z, 2 and 3 are +y and -y, 
+    // 4 and 5 are +x and -x.
+    const __m128 sizeVec = _mm_set1_ps(size);
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 face = _mm_mul_ps(rng.NextFloat(), _mm_set1_ps(6.0f));
+        __m128i faceIndex = _mm_cvttps_epi32(face);
+        __m128 side = _mm_xor_ps(sizeVec, _mm_castsi128_ps(_mm_slli_epi32(faceIndex, 31)));
+        __m128 zFace = _mm_cmplt_ps(face, _mm_set1_ps(2.0f));
+        __m128 xFace = _mm_cmpge_ps(face, _mm_set1_ps(4.0f));
+        __m128 yFace = _mm_andnot_ps(_mm_or_ps(xFace, zFace), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        __m128 u = rng.Range(-size, size);
+        __m128 v = rng.Range(-size, size);
+        return Vector3x4(
+            xo_internal::RandomSelect(xFace, side, u),
+            xo_internal::RandomSelect(yFace, side, xo_internal::RandomSelect(xFace, u, v)),
+            xo_internal::RandomSelect(zFace, side, v));
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnCube(size, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomInSphere(float minRadius, float maxRadius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    const float minCubed = minRadius*minRadius*minRadius;
+    const float maxCubed = maxRadius*maxRadius*maxRadius;
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        __m128 r = xo_internal::RandomCbrt(rng.Range(minCubed, maxCubed));
+        return xo_internal::RandomSphereDirections(rng) * Vector4(r);
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomInSphere(minRadius, maxRadius, outVecs[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Vector3::RandomOnSphere(float radius, Vector3* outVecs, size_t n) {
+#if defined(XO_SSE2)
+    xo_internal::FillRandomVector3s(outVecs, n, [&](Random_x4& rng) -> Vector3x4 {
+        return xo_internal::RandomSphereDirections(rng) * radius;
+    });
+#else
+    for (size_t i = 0; i < n; ++i) {
+        RandomOnSphere(radius, outVecs[i]);
+    }
+#endif
+}
 
 
 #undef IDX_X
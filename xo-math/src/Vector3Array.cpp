@@ -0,0 +1,220 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+_XOSRCINL void Pack(const Vector3* in, Float3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each store writes the w of in[i] over out[i + 1].x, which the next store then replaces. The last element's
+    // store would write past the end of out, so it's split into 8 and 4 bytes.
+    for (; i + 1 < n; ++i) {
+        _mm_storeu_ps(&out[i].x, in[i].xmm);
+    }
+    _mm_storel_pi((__m64*)&out[i].x, in[i].xmm);
+    _mm_store_ss(&out[i].z, _mm_movehl_ps(in[i].xmm, in[i].xmm));
+#else
+    for (; i < n; ++i) {
+        out[i] = Float3(in[i]);
+    }
+#endif
+}
+
+_XOSRCINL void Unpack(const Float3* in, Vector3* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Each load takes x of the next element too, which is masked off. The last element's load would read past the
+    // end of in, so it's split into 8 and 4 bytes.
+    const __m128 xyzMask = _mm_set_ps(0.0f, HexFloat(0xffffffff), HexFloat(0xffffffff), HexFloat(0xffffffff));
+    for (; i + 1 < n; ++i) {
+        out[i].xmm = _mm_and_ps(_mm_loadu_ps(&in[i].x), xyzMask);
+    }
+    out[i].xmm = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&in[i].x), _mm_load_ss(&in[i].z));
+#else
+    for (; i < n; ++i) {
+        out[i] = in[i];
+    }
+#endif
+}
+
+namespace xo_internal
+{
+#if defined(XO_SSE)
+    // Four packed points are exactly three registers, which shuffle into the xs, ys and zs of all four.
+    _XOINL void LoadFloat3x4(const Float3* p, __m128& x, __m128& y, __m128& z) {
+        __m128 a = _mm_loadu_ps(&p[0].x); // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(&p[1].y); // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(&p[2].z); // z2 x3 y3 z3
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x4.
+    _XOINL void StoreFloat3x4(Float3* p, __m128 x, __m128 y, __m128 z) {
+        _mm_storeu_ps(&p[0].x, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[1].y, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&p[2].z, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    // Transforms four points per pass, as their xs, ys and zs from LoadFloat3x4. Every element of the matrix is
+    // broadcast before the loop, so a pass is nine multiplies and nine adds, with no shuffles between them. The
+    // last few points are done one at a time, adding in the same order so they round the same way.
+    _XOSRCINL void TransformFloat3Array(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        float tx = translate ? m.m03 : 0.0f;
+        float ty = translate ? m.m13 : 0.0f;
+        float tz = translate ? m.m23 : 0.0f;
+        size_t i = 0;
+#if defined(XO_SSE)
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02), m03 = _mm_set1_ps(tx);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12), m13 = _mm_set1_ps(ty);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22), m23 = _mm_set1_ps(tz);
+        for (; i + 4 <= n; i += 4) {
+            __m128 x, y, z;
+            LoadFloat3x4(in + i, x, y, z);
+            StoreFloat3x4(out + i,
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), m03)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), m13)),
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), m23)));
+        }
+#endif
+        for (; i < n; ++i) {
+            float x = in[i].x, y = in[i].y, z = in[i].z;
+            out[i].x = ((m.m00 * x) + (m.m01 * y)) + ((m.m02 * z) + tx);
+            out[i].y = ((m.m10 * x) + (m.m11 * y)) + ((m.m12 * z) + ty);
+            out[i].z = ((m.m20 * x) + (m.m21 * y)) + ((m.m22 * z) + tz);
+        }
+    }
+}
+
+#if defined(_XO_KERNELS_AVX)
+namespace xo_internal
+{
+    // LoadFloat3x4 for eight points, four in each 128 bit lane. Eight points are 96 bytes, loaded as three registers
+    // and permuted so each lane holds the same three registers the SSE version loads, then shuffled the same way.
+    _XOINL _XO_TARGET_AVX void LoadFloat3x8(const Float3* p, __m256& x, __m256& y, __m256& z) {
+        __m256 m0 = _mm256_loadu_ps(&p[0].x);
+        __m256 m1 = _mm256_loadu_ps(&p[2].z);
+        __m256 m2 = _mm256_loadu_ps(&p[5].y);
+        __m256 a = _mm256_permute2f128_ps(m0, m1, 0x30);
+        __m256 b = _mm256_permute2f128_ps(m0, m2, 0x21);
+        __m256 c = _mm256_permute2f128_ps(m1, m2, 0x30);
+        x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // The reverse of LoadFloat3x8.
+    _XOINL _XO_TARGET_AVX void StoreFloat3x8(Float3* p, __m256 x, __m256 y, __m256 z) {
+        __m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm256_storeu_ps(&p[0].x, _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(&p[2].z, _mm256_permute2f128_ps(a, c, 0x12));
+        _mm256_storeu_ps(&p[5].y, _mm256_permute2f128_ps(b, c, 0x31));
+    }
+
+    // TransformFloat3Array eight points at a time, leaving the last few to it.
+    _XOSRCINL _XO_TARGET_AVX void TransformFloat3ArrayAVX(const Matrix4x4& m, const Float3* in, Float3* out, size_t n, bool translate) {
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+        const __m256 m03 = _mm256_set1_ps(translate ? m.m03 : 0.0f);
+        const __m256 m13 = _mm256_set1_ps(translate ? m.m13 : 0.0f);
+        const __m256 m23 = _mm256_set1_ps(translate ? m.m23 : 0.0f);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 x, y, z;
+            LoadFloat3x8(in + i, x, y, z);
+            StoreFloat3x8(out + i,
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_add_ps(_mm256_mul_ps(m02, z), m03)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_add_ps(_mm256_mul_ps(m12, z), m13)),
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_add_ps(_mm256_mul_ps(m22, z), m23)));
+        }
+        _mm256_zeroupper();
+        TransformFloat3Array(m, in + i, out + i, n - i, translate);
+    }
+}
+#endif
+
+_XOSRCINL Vector3Array::Vector3Array() {
+}
+
+_XOSRCINL Vector3Array::Vector3Array(size_t n) :
+    elements(n)
+{
+}
+
+_XOSRCINL Vector3Array::Vector3Array(const Vector3* v, size_t n) :
+    elements(n)
+{
+    Pack(v, elements.data(), n);
+}
+
+_XOSRCINL void Vector3Array::Reserve(size_t n) {
+    elements.reserve(n);
+}
+
+_XOSRCINL void Vector3Array::Resize(size_t n) {
+    elements.resize(n);
+}
+
+_XOSRCINL void Vector3Array::Clear() {
+    elements.clear();
+}
+
+_XOSRCINL void Vector3Array::Add(const Vector3& v) {
+    elements.push_back(Float3(v));
+}
+
+_XOSRCINL void Vector3Array::Add(const Vector3* v, size_t n) {
+    size_t first = elements.size();
+    elements.resize(first + n);
+    Pack(v, elements.data() + first, n);
+}
+
+_XOSRCINL void Vector3Array::Get(size_t first, Vector3* out, size_t n) const {
+    Unpack(elements.data() + first, out, n);
+}
+
+_XOSRCINL void Vector3Array::Set(size_t first, const Vector3* in, size_t n) {
+    Pack(in, elements.data() + first, n);
+}
+
+_XOSRCINL void Vector3Array::TransformPoints(const Matrix4x4& m) {
+    m.TransformPoints(elements.data(), elements.data(), elements.size());
+}
+
+_XOSRCINL void Vector3Array::TransformDirections(const Matrix4x4& m) {
+    m.TransformDirections(elements.data(), elements.data(), elements.size());
+}
+
+XOMATH_END_XO_NS();
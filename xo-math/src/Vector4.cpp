@@ -26,29 +26,29 @@ XOMATH_BEGIN_XO_NS();
 
 #if defined(_XONOCONSTEXPR)
 #   if defined(XO_SSE)
-const float Vector4::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+_XOSRCDATA const float Vector4::Epsilon = sse::SSEFloatEpsilon * 4.0f;
 #   else
-const float Vector4::Epsilon = FloatEpsilon * 4.0f;
+_XOSRCDATA const float Vector4::Epsilon = FloatEpsilon * 4.0f;
 #   endif
 #endif
 
-const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
-const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
+_XOSRCDATA const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
 
-const Vector4 Vector4::UnitX(1.0f, 0.0f, 0.0f, 0.0f);
-const Vector4 Vector4::UnitY(0.0f, 1.0f, 0.0f, 0.0f);
-const Vector4 Vector4::UnitZ(0.0f, 0.0f, 1.0f, 0.0f);
-const Vector4 Vector4::UnitW(0.0f, 0.0f, 0.0f, 1.0f);
+_XOSRCDATA const Vector4 Vector4::UnitX(1.0f, 0.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitY(0.0f, 1.0f, 0.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitZ(0.0f, 0.0f, 1.0f, 0.0f);
+_XOSRCDATA const Vector4 Vector4::UnitW(0.0f, 0.0f, 0.0f, 1.0f);
 
 #define IDX_X 0
 #define IDX_Y 1
 #define IDX_Z 2
 #define IDX_W 3
 
-Vector4::Vector4() {
+_XOSRCINL Vector4::Vector4() {
 }
 
-Vector4::Vector4(float f) :
+_XOSRCINL Vector4::Vector4(float f) :
 #if defined(XO_SSE)
     xmm(_mm_set1_ps(f))
 {
@@ -59,7 +59,7 @@ Vector4::Vector4(float f) :
 }
 #endif
 
-Vector4::Vector4(float x, float y, float z, float w) :
+_XOSRCINL Vector4::Vector4(float x, float y, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, y, x))
 {
@@ -69,7 +69,7 @@ Vector4::Vector4(float x, float y, float z, float w) :
 {
 }
 #endif
-Vector4::Vector4(const Vector4& vec) :
+_XOSRCINL Vector4::Vector4(const Vector4& vec) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
@@ -82,13 +82,13 @@ Vector4::Vector4(const Vector4& vec) :
 
 
 #if defined(XO_SSE)
-Vector4::Vector4(const __m128& vec) : 
+_XOSRCINL Vector4::Vector4(const __m128& vec) : 
     xmm(vec)
 {
 }
 #endif
 
-Vector4::Vector4(const class Vector2& vec) :
+_XOSRCINL Vector4::Vector4(const class Vector2& vec) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(0.0f, 0.0f, vec.y, vec.x)) 
 {
@@ -99,7 +99,7 @@ Vector4::Vector4(const class Vector2& vec) :
 }
 #endif
 
-Vector4::Vector4(const class Vector2& vec, float z, float w) :
+_XOSRCINL Vector4::Vector4(const class Vector2& vec, float z, float w) :
 #if defined(XO_SSE)
     xmm(_mm_set_ps(w, z, vec.y, vec.x))
 {
@@ -110,7 +110,7 @@ Vector4::Vector4(const class Vector2& vec, float z, float w) :
 }
 #endif
 
-Vector4::Vector4(const class Vector3& vec) :
+_XOSRCINL Vector4::Vector4(const class Vector3& vec) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
@@ -121,12 +121,12 @@ Vector4::Vector4(const class Vector3& vec) :
 }
 #endif
 
-Vector4::Vector4(const class Vector3& vec, float w) :
+_XOSRCINL Vector4::Vector4(const class Vector3& vec, float w) :
 #if defined(XO_SSE)
     xmm(vec.xmm)
 {
     //! @todo there's likely an sse way to do this.
-    w = w;
+    this->w = w;
 }
 #else
     x(vec.x), y(vec.y), z(vec.z), w(w)
@@ -134,7 +134,7 @@ Vector4::Vector4(const class Vector3& vec, float w) :
 }
 #endif
 
-Vector4::Vector4(const class Quaternion& q) :
+_XOSRCINL Vector4::Vector4(const class Quaternion& q) :
 #if defined(XO_SSE)
     xmm(q.xmm)
 #else
@@ -143,7 +143,7 @@ Vector4::Vector4(const class Quaternion& q) :
 {
 }
 
-Vector4& Vector4::Set(float x, float y, float z, float w) {
+_XOSRCINL Vector4& Vector4::Set(float x, float y, float z, float w) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(w, z, y, x);
 #else
@@ -155,7 +155,7 @@ Vector4& Vector4::Set(float x, float y, float z, float w) {
     return *this;
 }
 
-Vector4& Vector4::Set(float f) {
+_XOSRCINL Vector4& Vector4::Set(float f) {
 #if defined(XO_SSE)
     xmm = _mm_set1_ps(f);
 #else
@@ -167,7 +167,7 @@ Vector4& Vector4::Set(float f) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector4& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector4& vec) {
 #if defined(XO_SSE)
     xmm = vec.xmm;
 #else
@@ -179,7 +179,7 @@ Vector4& Vector4::Set(const Vector4& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector2& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(0.0f, 0.0f, vec.y, vec.x);
 #else
@@ -191,7 +191,7 @@ Vector4& Vector4::Set(const Vector2& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
+_XOSRCINL Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
 #if defined(XO_SSE)
     xmm = _mm_set_ps(w, z, vec.y, vec.x);
 #else
@@ -203,7 +203,7 @@ Vector4& Vector4::Set(const Vector2& vec, float z, float w) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector3& vec) {
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec) {
 #if defined(XO_SSE)
     // TODO: mask with xmm, don't just break out w
     this->xmm = vec.xmm;
@@ -217,7 +217,7 @@ Vector4& Vector4::Set(const Vector3& vec) {
     return *this;
 }
 
-Vector4& Vector4::Set(const Vector3& vec, float w) {
+_XOSRCINL Vector4& Vector4::Set(const Vector3& vec, float w) {
 #if defined(XO_SSE)
     // todo: consider masking here.
     this->xmm = vec.xmm;
@@ -232,20 +232,20 @@ Vector4& Vector4::Set(const Vector3& vec, float w) {
 }
 
 #if defined(XO_SSE)
-Vector4& Vector4::Set(const __m128& vec) {
+_XOSRCINL Vector4& Vector4::Set(const __m128& vec) {
     xmm = vec;
     return *this;
 }
 #endif
 
-void Vector4::Get(float& x, float& y, float& z, float& w) const {
+_XOSRCINL void Vector4::Get(float& x, float& y, float& z, float& w) const {
     x = this->x;
     y = this->y;
     z = this->z;
     w = this->w;
 }
 
-void Vector4::Get(float* f) const {
+_XOSRCINL void Vector4::Get(float* f) const {
 #if defined(XO_SSE)
     _mm_store_ps(f, xmm);
 #else
@@ -256,8 +256,8 @@ void Vector4::Get(float* f) const {
 #endif
 }
  
-float Vector4::Sum() const {
-#if defined(XO_SSE)
+_XOSRCINL float Vector4::Sum() const {
+#if defined(XO_SSE3)
     __m128 s = _mm_hadd_ps(xmm, xmm);
     return _mm_cvtss_f32(_mm_hadd_ps(s, s));
 #else
@@ -265,14 +265,14 @@ float Vector4::Sum() const {
 #endif
 }
 
-Vector4& Vector4::NormalizeSafe() {
+_XOSRCINL Vector4& Vector4::NormalizeSafe() {
     float magnitude = MagnitudeSquared();
     if (magnitude == 0.0f)
         return *this;
     return *this /= Sqrt(magnitude);
 }
 
-float Vector4::Dot(const Vector4& a, const Vector4& b) {
+_XOSRCINL float Vector4::Dot(const Vector4& a, const Vector4& b) {
 #if defined(XO_SSE4)
     return _mm_cvtss_f32(_mm_dp_ps(a.xmm, b.xmm, 0xff));
 #else
@@ -280,4 +280,9 @@ float Vector4::Dot(const Vector4& a, const Vector4& b) {
 #endif
 }
 
+#undef IDX_X
+#undef IDX_Y
+#undef IDX_Z
+#undef IDX_W
+
 XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,382 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench.h
+//
+//  A public domain single header file micro-benchmark module. C++11 or newer required.
+//
+//  STREET CRED
+//    Inspired by Sean Barrett's stb. https://github.com/nothings
+//
+//  LICENSE
+//
+//   This software is dual-licensed to the public domain and under the following
+//   license: you are granted a perpetual, irrevocable license to copy, modify,
+//   publish, and distribute this file as you see fit.
+//////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+#include "xo-perf.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench
+//////////////////////////////////////////////////////////////////////////////////////////
+// Like Test, this micro-benchmark module is an exersize in minimalism.
+// Each case is a function of an index that returns a value. The index cycles through
+// [0, inputCount) so cases can read from pre-filled input arrays, and every return value is
+// passed through Bench::DoNotOptimize so the compiler can't throw the work away.
+//
+// A case is run for a few warmup repetitions that are thrown away, then timed for each
+// remaining repetition. Each repetition calls the function opsPerRepetition times, and the
+// reported numbers are nanoseconds per call: min, p10, median, p90, max and mean.
+// Cases that process a whole array per call can pass itemsPerCall to report per item instead.
+// Where PerfCounters are available, the timed repetitions are also counted, and each counter
+// is reported per call alongside the times.
+// Example below.
+//////////////////////////////////////////////////////////////////////////////////////////
+/*
+ Bench bench;
+ static float a[1024], b[1024];
+ bench("float add", [](size_t i) { return a[i] + b[i]; });
+ bench.Print(std::cout);
+ // Write the results so a later run can be compared against them.
+ std::ofstream file("base.json");
+ bench.WriteJSON(file);
+ // Later... count the cases that got more than 5% slower.
+ std::vector<Bench::Result> base, current;
+ if(Bench::ReadJSON("base.json", base) && Bench::ReadJSON("current.json", current))
+   return Bench::Compare(base, current, 0.05, std::cout) > 0 ? -1 : 0;
+*/
+//////////////////////////////////////////////////////////////////////////////////////////
+class Bench {
+  typedef std::chrono::steady_clock TClock;
+  typedef std::chrono::duration<double, std::nano> TNanoseconds;
+
+public:
+  struct Options {
+    Options() :
+      warmup(3),
+      repetitions(31),
+      opsPerRepetition(4096),
+      inputCount(1024)
+    {
+    }
+    int warmup;               // repetitions run before timing starts, and thrown away.
+    int repetitions;          // timed repetitions, each one is a sample.
+    size_t opsPerRepetition;  // calls to the case per repetition.
+    size_t inputCount;        // the index passed to a case cycles through [0, inputCount).
+    std::string filter;       // when not empty, only cases with this text in their name run.
+  };
+
+  struct Result {
+    std::string name;
+    double min, p10, median, p90, max, mean; // nanoseconds per call, or per item
+    int repetitions;
+    size_t opsPerRepetition;
+    PerfCounters::Sample counters; // per call, or per item
+  };
+
+  Bench() { }
+  explicit Bench(const Options& options) : m_Options(options) { }
+
+  // Adds a line to the config block of the json output, such as the compiler or simd level.
+  void SetConfig(const char* key, const std::string& value);
+  const PerfCounters& GetCounters() const;
+  // The options the following cases run with. Cases that take far longer per call than the rest can lower
+  // opsPerRepetition around themselves, and put it back after.
+  Options& GetOptions();
+
+  template<typename TFunc>
+  void operator ()(const char* caseName, TFunc func, size_t itemsPerCall = 1);
+
+  const std::vector<Result>& GetResults() const;
+  void Print(std::ostream& os) const;
+  void WriteJSON(std::ostream& os) const;
+
+  // Reads results written by WriteJSON. Returns false if the file couldn't be opened.
+  static bool ReadJSON(const char* path, std::vector<Result>& outResults);
+  // Prints each case found in both runs with its change in median, and returns the number of
+  // cases that got slower by more than threshold (0.05 is 5%). Changes smaller than
+  // noiseFloorNs are never reported, as the fastest cases are near the timer's resolution.
+  static int Compare(const std::vector<Result>& base, const std::vector<Result>& current,
+                     double threshold, std::ostream& os, double noiseFloorNs = 0.05);
+
+  // Forces value to be computed, without the cost of writing it anywhere.
+  template<typename T>
+  static void DoNotOptimize(const T& value);
+
+private:
+  void Record(const char* caseName, std::vector<double>& samples, const PerfCounters::Sample& counters);
+  static std::string Escape(const std::string& s);
+  static bool ParseString(const std::string& line, const char* key, std::string& out);
+  static bool ParseNumber(const std::string& line, const char* key, double& out);
+
+  Options m_Options;
+  std::vector<Result> m_Results;
+  PerfCounters m_Counters;
+  std::vector<std::pair<std::string, std::string> > m_Config;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench
+//////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void Bench::DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#endif
+}
+
+template<typename TFunc>
+void Bench::operator ()(const char* caseName, TFunc func, size_t itemsPerCall) {
+  if(!m_Options.filter.empty() && std::strstr(caseName, m_Options.filter.c_str()) == nullptr)
+    return;
+  const size_t ops = m_Options.opsPerRepetition > 0 ? m_Options.opsPerRepetition : 1;
+  const size_t inputs = m_Options.inputCount > 0 ? m_Options.inputCount : 1;
+  const double items = double(ops) * double(itemsPerCall > 0 ? itemsPerCall : 1);
+  std::vector<double> samples;
+  samples.reserve(m_Options.repetitions);
+
+  for(int r = 0; r < m_Options.warmup + m_Options.repetitions; ++r) {
+    if(r == m_Options.warmup)
+      m_Counters.Start();
+    size_t index = 0;
+    TClock::time_point start = TClock::now();
+    for(size_t i = 0; i < ops; ++i) {
+      DoNotOptimize(func(index));
+      if(++index == inputs)
+        index = 0;
+    }
+    TClock::time_point end = TClock::now();
+    if(r >= m_Options.warmup)
+      samples.push_back(TNanoseconds(end - start).count() / items);
+  }
+  PerfCounters::Sample counters = m_Counters.Stop();
+  for(int c = 0; c < PerfCounters::Count; ++c)
+    counters.value[c] /= items * double(m_Options.repetitions > 0 ? m_Options.repetitions : 1);
+  Record(caseName, samples, counters);
+}
+
+void Bench::SetConfig(const char* key, const std::string& value) {
+  for(auto& kv : m_Config) {
+    if(kv.first == key) {
+      kv.second = value;
+      return;
+    }
+  }
+  m_Config.push_back(std::make_pair(std::string(key), value));
+}
+
+const PerfCounters& Bench::GetCounters() const {
+  return m_Counters;
+}
+
+Bench::Options& Bench::GetOptions() {
+  return m_Options;
+}
+
+void Bench::Record(const char* caseName, std::vector<double>& samples, const PerfCounters::Sample& counters) {
+  Result result;
+  result.name = caseName;
+  result.counters = counters;
+  result.repetitions = (int)samples.size();
+  result.opsPerRepetition = m_Options.opsPerRepetition;
+  result.min = result.p10 = result.median = result.p90 = result.max = result.mean = 0.0;
+  if(!samples.empty()) {
+    std::sort(samples.begin(), samples.end());
+    // nearest rank percentiles, which are exact samples rather than interpolated ones.
+    auto percentile = [&samples](double p) {
+      size_t rank = (size_t)(p * double(samples.size() - 1) + 0.5);
+      return samples[rank];
+    };
+    double sum = 0.0;
+    for(double s : samples)
+      sum += s;
+    result.min = samples.front();
+    result.p10 = percentile(0.1);
+    result.median = percentile(0.5);
+    result.p90 = percentile(0.9);
+    result.max = samples.back();
+    result.mean = sum / double(samples.size());
+  }
+  m_Results.push_back(result);
+
+  char line[256];
+  int length = std::snprintf(line, sizeof(line), "%-48s %9.3f ns/op  (p10 %.3f, p90 %.3f)",
+                             caseName, result.median, result.p10, result.p90);
+  if(counters.valid[PerfCounters::Cycles] && length > 0 && length < (int)sizeof(line))
+    std::snprintf(line + length, sizeof(line) - length, "  %.2f cycles, ipc %.2f",
+                  counters.value[PerfCounters::Cycles], counters.IPC());
+  std::cout << line << "\n";
+}
+
+const std::vector<Bench::Result>& Bench::GetResults() const {
+  return m_Results;
+}
+
+void Bench::Print(std::ostream& os) const {
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-48s %9s %9s %9s %9s %9s %9s\n",
+                "case", "min", "p10", "median", "p90", "max", "mean");
+  os << line;
+  for(const Result& r : m_Results) {
+    std::snprintf(line, sizeof(line), "%-48s %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f",
+                  r.name.c_str(), r.min, r.p10, r.median, r.p90, r.max, r.mean);
+    os << line;
+    for(int c = 0; c < PerfCounters::Count; ++c) {
+      if(r.counters.valid[c]) {
+        std::snprintf(line, sizeof(line), "  %s %.3f", PerfCounters::Name((PerfCounters::Counter)c), r.counters.value[c]);
+        os << line;
+      }
+    }
+    if(r.counters.valid[PerfCounters::Cycles] && r.counters.valid[PerfCounters::Instructions]) {
+      std::snprintf(line, sizeof(line), "  ipc %.2f", r.counters.IPC());
+      os << line;
+    }
+    os << "\n";
+  }
+}
+
+std::string Bench::Escape(const std::string& s) {
+  std::string out;
+  for(char c : s) {
+    if(c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+void Bench::WriteJSON(std::ostream& os) const {
+  // One result per line. ReadJSON relies on this layout rather than being a full json parser.
+  os << "{\n  \"config\": {";
+  for(size_t i = 0; i < m_Config.size(); ++i) {
+    os << (i ? ",\n" : "\n") << "    \"" << Escape(m_Config[i].first) << "\": \""
+       << Escape(m_Config[i].second) << "\"";
+  }
+  os << "\n  },\n  \"results\": [";
+  char numbers[512];
+  for(size_t i = 0; i < m_Results.size(); ++i) {
+    const Result& r = m_Results[i];
+    std::snprintf(numbers, sizeof(numbers),
+                  "\"ns_per_op\": %.4f, \"min\": %.4f, \"p10\": %.4f, \"median\": %.4f, \"p90\": %.4f, "
+                  "\"max\": %.4f, \"mean\": %.4f, \"repetitions\": %d, \"ops_per_repetition\": %lu",
+                  r.median, r.min, r.p10, r.median, r.p90, r.max, r.mean, r.repetitions,
+                  (unsigned long)r.opsPerRepetition);
+    os << (i ? ",\n" : "\n") << "    {\"name\": \"" << Escape(r.name) << "\", " << numbers;
+    for(int c = 0; c < PerfCounters::Count; ++c) {
+      if(r.counters.valid[c]) {
+        std::snprintf(numbers, sizeof(numbers), ", \"%s\": %.4f", PerfCounters::Name((PerfCounters::Counter)c), r.counters.value[c]);
+        os << numbers;
+      }
+    }
+    if(r.counters.valid[PerfCounters::Cycles] && r.counters.valid[PerfCounters::Instructions]) {
+      std::snprintf(numbers, sizeof(numbers), ", \"ipc\": %.4f", r.counters.IPC());
+      os << numbers;
+    }
+    os << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+bool Bench::ParseString(const std::string& line, const char* key, std::string& out) {
+  std::string pattern = std::string("\"") + key + "\": \"";
+  size_t at = line.find(pattern);
+  if(at == std::string::npos)
+    return false;
+  out.clear();
+  for(size_t i = at + pattern.size(); i < line.size(); ++i) {
+    if(line[i] == '\\' && i + 1 < line.size())
+      out += line[++i];
+    else if(line[i] == '"')
+      return true;
+    else
+      out += line[i];
+  }
+  return false;
+}
+
+bool Bench::ParseNumber(const std::string& line, const char* key, double& out) {
+  std::string pattern = std::string("\"") + key + "\": ";
+  size_t at = line.find(pattern);
+  if(at == std::string::npos)
+    return false;
+  out = std::strtod(line.c_str() + at + pattern.size(), nullptr);
+  return true;
+}
+
+bool Bench::ReadJSON(const char* path, std::vector<Result>& outResults) {
+  std::ifstream file(path);
+  if(!file)
+    return false;
+  outResults.clear();
+  std::string line;
+  while(std::getline(file, line)) {
+    Result r;
+    double repetitions = 0.0, ops = 0.0;
+    if(!ParseString(line, "name", r.name) || !ParseNumber(line, "median", r.median))
+      continue;
+    ParseNumber(line, "min", r.min);
+    ParseNumber(line, "p10", r.p10);
+    ParseNumber(line, "p90", r.p90);
+    ParseNumber(line, "max", r.max);
+    ParseNumber(line, "mean", r.mean);
+    ParseNumber(line, "repetitions", repetitions);
+    ParseNumber(line, "ops_per_repetition", ops);
+    r.repetitions = (int)repetitions;
+    r.opsPerRepetition = (size_t)ops;
+    for(int c = 0; c < PerfCounters::Count; ++c)
+      r.counters.valid[c] = ParseNumber(line, PerfCounters::Name((PerfCounters::Counter)c), r.counters.value[c]);
+    outResults.push_back(r);
+  }
+  return true;
+}
+
+int Bench::Compare(const std::vector<Result>& base, const std::vector<Result>& current,
+                   double threshold, std::ostream& os, double noiseFloorNs) {
+  int regressions = 0, improvements = 0;
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-48s %10s %10s %8s\n", "case", "base", "current", "change");
+  os << line;
+  for(const Result& cur : current) {
+    auto found = std::find_if(base.begin(), base.end(), [&cur](const Result& b) { return b.name == cur.name; });
+    if(found == base.end())
+      continue;
+    const double delta = cur.median - found->median;
+    const double change = found->median > 0.0 ? delta / found->median : 0.0;
+    const char* flag = "";
+    if(std::abs(delta) > noiseFloorNs) {
+      if(change > threshold) {
+        flag = "  REGRESSION";
+        regressions++;
+      }
+      else if(change < -threshold) {
+        flag = "  IMPROVED";
+        improvements++;
+      }
+    }
+    std::snprintf(line, sizeof(line), "%-48s %10.3f %10.3f %+7.1f%%%s\n",
+                  cur.name.c_str(), found->median, cur.median, change * 100.0, flag);
+    os << line;
+  }
+  os << regressions << " regressed. " << improvements << " improved. (threshold "
+     << threshold * 100.0 << "%)\n";
+  return regressions;
+}
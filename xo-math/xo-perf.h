@@ -0,0 +1,263 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+// Perf.h
+//
+//  A public domain single header file hardware performance counter module. C++11 or
+//  newer required. Counters are read through perf_event_open, so they are linux only.
+//
+//  STREET CRED
+//    Inspired by Sean Barrett's stb. https://github.com/nothings
+//
+//  LICENSE
+//
+//   This software is dual-licensed to the public domain and under the following
+//   license: you are granted a perpetual, irrevocable license to copy, modify,
+//   publish, and distribute this file as you see fit.
+//////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   if defined(__x86_64__) || defined(__i386__)
+#       include <cpuid.h>
+#   endif
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PerfCounters
+//////////////////////////////////////////////////////////////////////////////////////////
+// Counts what the cpu did between Start and Stop, for the calling thread in user mode.
+//
+// Each counter is opened on its own, so the ones the cpu, kernel or container don't allow
+// are simply missing from the sample rather than failing the rest. Virtual machines and
+// containers commonly allow none of them, in which case Available returns false and
+// Status says why. Set the environment variable XO_PERF=0 to skip counters entirely.
+//
+// FP assists have no generic perf event, so they're read with a raw event on Intel cpus:
+// FP_ASSIST.ANY up to Skylake, and ASSISTS.FP from Ice Lake on. XO_PERF_FP_ASSIST can be set
+// to a raw event in hex (such as 0x1eca) to override it on other models.
+//
+// When the kernel has to share the counters between more events than the cpu has, each
+// count is scaled up by the fraction of time it was actually counting.
+// Example below.
+//////////////////////////////////////////////////////////////////////////////////////////
+/*
+ PerfCounters counters;
+ if(!counters.Available())
+   std::cout << "no counters: " << counters.Status() << std::endl;
+ counters.Start();
+ DoWork();
+ PerfCounters::Sample sample = counters.Stop();
+ if(sample.valid[PerfCounters::Cycles])
+   std::cout << sample.value[PerfCounters::Cycles] << " cycles, ipc " << sample.IPC() << std::endl;
+*/
+//////////////////////////////////////////////////////////////////////////////////////////
+class PerfCounters {
+public:
+  enum Counter {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1DMisses,    // level 1 data cache read misses.
+    LLCMisses,    // last level cache misses.
+    FPAssists,    // microcode assists for floating point, such as denormal inputs or outputs.
+    Count
+  };
+
+  struct Sample {
+    Sample() {
+      for(int i = 0; i < Count; ++i) {
+        value[i] = 0.0;
+        valid[i] = false;
+      }
+    }
+    // Instructions per cycle, or zero when either counter is missing.
+    double IPC() const {
+      return valid[Cycles] && valid[Instructions] && value[Cycles] > 0.0 ? value[Instructions] / value[Cycles] : 0.0;
+    }
+    double value[Count];
+    bool valid[Count];
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // True when at least one counter could be opened.
+  bool Available() const;
+  // Which counters are open, or why none are.
+  const std::string& Status() const;
+
+  void Start();
+  Sample Stop();
+
+  // Short lowercase name for the counter, as used in json output.
+  static const char* Name(Counter counter);
+
+private:
+  int m_Fds[Count];
+  std::string m_Status;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PerfCounters
+//////////////////////////////////////////////////////////////////////////////////////////
+#if defined(__linux__)
+namespace xo_perf_internal {
+  inline int Open(unsigned type, unsigned long long config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  // The raw FP assist event for this cpu, or zero if there isn't a known one.
+  inline unsigned long long FPAssistEvent() {
+    if(const char* env = std::getenv("XO_PERF_FP_ASSIST"))
+      return std::strtoull(env, nullptr, 16);
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned a, b, c, d;
+    if(!__get_cpuid(0, &a, &b, &c, &d) || b != 0x756e6547 || d != 0x49656e69 || c != 0x6c65746e)
+      return 0; // not GenuineIntel
+    __get_cpuid(1, &a, &b, &c, &d);
+    const unsigned family = (a >> 8) & 0xf;
+    const unsigned model = ((a >> 4) & 0xf) | (((a >> 16) & 0xf) << 4);
+    if(family != 6)
+      return 0;
+    // Ice Lake and later cores moved it to ASSISTS.FP (event 0xc1, umask 0x02).
+    static const unsigned newer[] = { 0x6a, 0x6c, 0x7d, 0x7e, 0x8c, 0x8d, 0x8f, 0x97, 0x9a, 0xa7,
+                                      0xaa, 0xac, 0xad, 0xae, 0xb7, 0xba, 0xbf, 0xc5, 0xc6, 0xcf };
+    for(unsigned m : newer) {
+      if(m == model)
+        return 0x02c1;
+    }
+    // FP_ASSIST.ANY (event 0xca, umask 0x1e), Sandy Bridge to Skylake.
+    return 0x1eca;
+#else
+    return 0;
+#endif
+  }
+}
+
+PerfCounters::PerfCounters() {
+  for(int i = 0; i < Count; ++i)
+    m_Fds[i] = -1;
+  const char* env = std::getenv("XO_PERF");
+  if(env && std::strcmp(env, "0") == 0) {
+    m_Status = "disabled by XO_PERF=0";
+    return;
+  }
+  const unsigned long long l1dReadMiss = PERF_COUNT_HW_CACHE_L1D |
+                                         (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  m_Fds[Cycles] = xo_perf_internal::Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  m_Fds[Instructions] = xo_perf_internal::Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  m_Fds[BranchMisses] = xo_perf_internal::Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  m_Fds[L1DMisses] = xo_perf_internal::Open(PERF_TYPE_HW_CACHE, l1dReadMiss);
+  m_Fds[LLCMisses] = xo_perf_internal::Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  if(unsigned long long fpAssist = xo_perf_internal::FPAssistEvent())
+    m_Fds[FPAssists] = xo_perf_internal::Open(PERF_TYPE_RAW, fpAssist);
+
+  if(!Available()) {
+    const int error = errno;
+    m_Status = std::string("perf_event_open failed: ") + std::strerror(error);
+    if(error == EACCES || error == EPERM)
+      m_Status += " (see /proc/sys/kernel/perf_event_paranoid)";
+    else if(error == ENOENT || error == EOPNOTSUPP)
+      m_Status += " (no hardware counters, common in virtual machines and containers)";
+    return;
+  }
+  for(int i = 0; i < Count; ++i) {
+    if(m_Fds[i] >= 0) {
+      m_Status += m_Status.empty() ? "" : " ";
+      m_Status += Name((Counter)i);
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for(int i = 0; i < Count; ++i) {
+    if(m_Fds[i] >= 0)
+      close(m_Fds[i]);
+  }
+}
+
+void PerfCounters::Start() {
+  for(int i = 0; i < Count; ++i) {
+    if(m_Fds[i] >= 0) {
+      ioctl(m_Fds[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_Fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+PerfCounters::Sample PerfCounters::Stop() {
+  Sample sample;
+  for(int i = 0; i < Count; ++i) {
+    if(m_Fds[i] >= 0)
+      ioctl(m_Fds[i], PERF_EVENT_IOC_DISABLE, 0);
+  }
+  for(int i = 0; i < Count; ++i) {
+    unsigned long long data[3]; // value, time enabled, time running
+    if(m_Fds[i] < 0 || read(m_Fds[i], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0)
+      continue;
+    sample.value[i] = double(data[0]) * (double(data[1]) / double(data[2]));
+    sample.valid[i] = true;
+  }
+  return sample;
+}
+#else
+PerfCounters::PerfCounters() : m_Status("perf counters are only read on linux") {
+  for(int i = 0; i < Count; ++i)
+    m_Fds[i] = -1;
+}
+
+PerfCounters::~PerfCounters() {
+}
+
+void PerfCounters::Start() {
+}
+
+PerfCounters::Sample PerfCounters::Stop() {
+  return Sample();
+}
+#endif
+
+bool PerfCounters::Available() const {
+  for(int i = 0; i < Count; ++i) {
+    if(m_Fds[i] >= 0)
+      return true;
+  }
+  return false;
+}
+
+const std::string& PerfCounters::Status() const {
+  return m_Status;
+}
+
+const char* PerfCounters::Name(Counter counter) {
+  switch(counter) {
+    case Cycles:        return "cycles";
+    case Instructions:  return "instructions";
+    case BranchMisses:  return "branch_misses";
+    case L1DMisses:     return "l1d_misses";
+    case LLCMisses:     return "llc_misses";
+    case FPAssists:     return "fp_assists";
+    case Count:         break;
+  }
+  return "unknown";
+}
@@ -22,6 +22,8 @@
 #include <chrono>
 #include <ctime>
 
+#include "xo-perf.h"
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Test
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -60,7 +62,8 @@ public:
   Test() :
     m_CurrentSuccess(0),
     m_CurrentFailure(0),
-    m_TotalFailure(0)
+    m_TotalFailure(0),
+    m_ReportedCounters(false)
   {
   }
 
@@ -86,6 +89,8 @@ private:
   int m_CurrentSuccess;
   int m_CurrentFailure;
   int m_TotalFailure;
+  bool m_ReportedCounters;
+  PerfCounters m_Counters;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -161,13 +166,28 @@ void Test::operator ()(const char* testName, TTestFunc func) {
   std::cout << "========== \"" << testName << "\" test started ==========\n";
   m_CurrentSuccess = m_CurrentFailure = 0;
 
+  if(!m_ReportedCounters) {
+    // only once, as most tests run the same either way.
+    std::cout << "perf counters: " << m_Counters.Status() << "\n";
+    m_ReportedCounters = true;
+  }
+
+  m_Counters.Start();
   start = std::chrono::system_clock::now();
   func();
   end = std::chrono::system_clock::now();
+  PerfCounters::Sample counters = m_Counters.Stop();
   TDuration seconds = end-start;
 
   std::cout << m_CurrentSuccess << " passed. " << m_CurrentFailure;
-  std::cout << " failed. took (" << seconds.count() << ") seconds. \n\n";
+  std::cout << " failed. took (" << seconds.count() << ") seconds. \n";
+  for(int i = 0; i < PerfCounters::Count; ++i) {
+    if(counters.valid[i])
+      std::cout << PerfCounters::Name((PerfCounters::Counter)i) << ": " << (unsigned long long)counters.value[i] << " ";
+  }
+  if(counters.valid[PerfCounters::Cycles] && counters.valid[PerfCounters::Instructions])
+    std::cout << "ipc: " << counters.IPC();
+  std::cout << "\n";
 }
 
 int Test::GetTotalFailures() const {